@@ -88,6 +88,8 @@ TEST_NAMES = \
 	test_pressure \
 	test_task \
 	TestOverwritingRingBuffer \
+	TestSPSCRingBuffer \
+	TestNMEAOutputQueue \
 	TestDateTime TestRoughTime TestWrapClock \
 	TestMathTables \
 	TestAngle TestUnits TestEarth TestSunEphemeris \
@@ -95,11 +97,12 @@ TEST_NAMES = \
 	TestAllocatedGrid \
 	TestRadixTree TestGeoBounds TestGeoClip \
 	TestLogger TestGRecord TestDriver TestClimbAvCalc \
-	TestWaypointReader TestThermalBase \
-	TestFlarmNet \
+	TestWaypointReader TestWaypointCache TestThermalBase \
+	TestFlarmNet TestFlarmTraffic \
 	TestColorRamp TestGeoPoint TestDiffFilter \
 	TestFileUtil TestPolars TestCSVLine TestGlidePolar \
-	test_replay_task TestProjection TestFlatPoint TestFlatLine TestFlatGeoPoint \
+	test_replay_task test_bestcruisetrack \
+	TestProjection TestFlatPoint TestFlatLine TestFlatGeoPoint \
 	TestMacCready TestOrderedTask TestAATPoint \
 	TestPlanes \
 	TestTaskPoint \
@@ -109,6 +112,7 @@ TEST_NAMES = \
 	TestAirspaceParser \
 	TestMETARParser \
 	TestIGCParser \
+	TestIGCIndex \
 	TestByteOrder \
 	TestByteOrder2 \
 	TestStrings TestUTF8 \
@@ -135,6 +139,22 @@ TEST_OVERWRITING_RING_BUFFER_SOURCES = \
 TEST_OVERWRITING_RING_BUFFER_DEPENDS = MATH
 $(eval $(call link-program,TestOverwritingRingBuffer,TEST_OVERWRITING_RING_BUFFER))
 
+TEST_SPSC_RING_BUFFER_SOURCES = \
+	$(TEST_SRC_DIR)/tap.c \
+	$(TEST_SRC_DIR)/TestSPSCRingBuffer.cpp
+TEST_SPSC_RING_BUFFER_DEPENDS = THREAD OS UTIL
+$(eval $(call link-program,TestSPSCRingBuffer,TEST_SPSC_RING_BUFFER))
+
+TEST_NMEA_OUTPUT_QUEUE_SOURCES = \
+	$(SRC)/Device/Util/NMEAOutputQueue.cpp \
+	$(SRC)/Device/Port/NullPort.cpp \
+	$(SRC)/Device/Port/Port.cpp \
+	$(SRC)/Operation/Operation.cpp \
+	$(TEST_SRC_DIR)/tap.c \
+	$(TEST_SRC_DIR)/TestNMEAOutputQueue.cpp
+TEST_NMEA_OUTPUT_QUEUE_DEPENDS = THREAD OS UTIL
+$(eval $(call link-program,TestNMEAOutputQueue,TEST_NMEA_OUTPUT_QUEUE))
+
 TEST_IGC_PARSER_SOURCES = \
 	$(SRC)/IGC/IGCParser.cpp \
 	$(TEST_SRC_DIR)/tap.c \
@@ -142,6 +162,23 @@ TEST_IGC_PARSER_SOURCES = \
 TEST_IGC_PARSER_DEPENDS = MATH UTIL
 $(eval $(call link-program,TestIGCParser,TEST_IGC_PARSER))
 
+TEST_IGC_INDEX_SOURCES = \
+	$(SRC)/IGC/IGCParser.cpp \
+	$(SRC)/IGC/IGCIndex.cpp \
+	$(SRC)/Replay/IgcReplay.cpp \
+	$(SRC)/NMEA/Info.cpp \
+	$(SRC)/NMEA/ExternalSettings.cpp \
+	$(SRC)/NMEA/Attitude.cpp \
+	$(SRC)/NMEA/Acceleration.cpp \
+	$(SRC)/NMEA/SwitchState.cpp \
+	$(SRC)/Atmosphere/AirDensity.cpp \
+	$(SRC)/Units/Descriptor.cpp \
+	$(SRC)/Units/System.cpp \
+	$(TEST_SRC_DIR)/tap.c \
+	$(TEST_SRC_DIR)/TestIGCIndex.cpp
+TEST_IGC_INDEX_DEPENDS = IO OS GEO MATH UTIL TIME
+$(eval $(call link-program,TestIGCIndex,TEST_IGC_INDEX))
+
 TEST_BYTE_ORDER_SOURCES = \
 	$(TEST_SRC_DIR)/tap.c \
 	$(TEST_SRC_DIR)/TestByteOrder.cpp
@@ -321,6 +358,7 @@ TEST_REPLAY_TASK_SOURCES = \
 	$(SRC)/Atmosphere/AirDensity.cpp \
 	$(SRC)/Atmosphere/Pressure.cpp \
 	$(SRC)/IGC/IGCParser.cpp \
+	$(SRC)/IGC/IGCIndex.cpp \
 	$(SRC)/Replay/IgcReplay.cpp \
 	$(SRC)/Replay/TaskAutoPilot.cpp \
 	$(SRC)/Units/Descriptor.cpp \
@@ -363,13 +401,49 @@ $(eval $(call link-program,TestGeoBounds,TEST_GEO_BOUNDS))
 TEST_FLARM_NET_SOURCES = \
 	$(SRC)/FLARM/FlarmNetReader.cpp \
 	$(SRC)/FLARM/FlarmId.cpp \
-	$(SRC)/FLARM/FlarmNetRecord.cpp \
 	$(SRC)/FLARM/FlarmNetDatabase.cpp \
 	$(TEST_SRC_DIR)/tap.c \
 	$(TEST_SRC_DIR)/TestFlarmNet.cpp
 TEST_FLARM_NET_DEPENDS = IO OS MATH UTIL
 $(eval $(call link-program,TestFlarmNet,TEST_FLARM_NET))
 
+TEST_FLARM_TRAFFIC_SOURCES = \
+	$(SRC)/Device/Port/NullPort.cpp \
+	$(SRC)/Device/Port/Port.cpp \
+	$(SRC)/Device/Util/LineSplitter.cpp \
+	$(SRC)/Device/Util/NMEAWriter.cpp \
+	$(SRC)/Device/Driver/FLARM/BinaryProtocol.cpp \
+	$(SRC)/Device/Driver/FLARM/CRC16.cpp \
+	$(SRC)/Device/Parser.cpp \
+	$(SRC)/FLARM/FlarmComputer.cpp \
+	$(SRC)/FLARM/FlarmCalculations.cpp \
+	$(SRC)/FLARM/FlarmDetails.cpp \
+	$(SRC)/FLARM/Global.cpp \
+	$(SRC)/FLARM/TrafficDatabases.cpp \
+	$(SRC)/FLARM/NameDatabase.cpp \
+	$(SRC)/FLARM/FlarmNetDatabase.cpp \
+	$(SRC)/FLARM/Traffic.cpp \
+	$(SRC)/FLARM/FlarmId.cpp \
+	$(SRC)/FLARM/List.cpp \
+	$(SRC)/Computer/ClimbAverageCalculator.cpp \
+	$(SRC)/NMEA/Info.cpp \
+	$(SRC)/NMEA/Attitude.cpp \
+	$(SRC)/NMEA/Acceleration.cpp \
+	$(SRC)/NMEA/ExternalSettings.cpp \
+	$(SRC)/NMEA/SwitchState.cpp \
+	$(SRC)/NMEA/InputLine.cpp \
+	$(SRC)/NMEA/Checksum.cpp \
+	$(SRC)/Units/Descriptor.cpp \
+	$(SRC)/Units/System.cpp \
+	$(SRC)/Atmosphere/Pressure.cpp \
+	$(SRC)/Atmosphere/AirDensity.cpp \
+	$(SRC)/Operation/Operation.cpp \
+	$(TEST_SRC_DIR)/FakeGeoid.cpp \
+	$(TEST_SRC_DIR)/tap.c \
+	$(TEST_SRC_DIR)/TestFlarmTraffic.cpp
+TEST_FLARM_TRAFFIC_DEPENDS = DRIVER GEO MATH IO OS THREAD UTIL TIME
+$(eval $(call link-program,TestFlarmTraffic,TEST_FLARM_TRAFFIC))
+
 TEST_GEO_CLIP_SOURCES = \
 	$(TEST_SRC_DIR)/tap.c \
 	$(TEST_SRC_DIR)/TestGeoClip.cpp
@@ -662,6 +736,27 @@ TEST_WAY_POINT_FILE_SOURCES = \
 TEST_WAY_POINT_FILE_DEPENDS = WAYPOINT GEO MATH IO UTIL ZZIP OS THREAD
 $(eval $(call link-program,TestWaypointReader,TEST_WAY_POINT_FILE))
 
+TEST_WAYPOINT_CACHE_SOURCES = \
+	$(SRC)/Units/Descriptor.cpp \
+	$(SRC)/Units/System.cpp \
+	$(SRC)/Waypoint/WaypointFileType.cpp \
+	$(SRC)/Waypoint/WaypointReaderBase.cpp \
+	$(SRC)/Waypoint/WaypointReader.cpp \
+	$(SRC)/Waypoint/WaypointReaderWinPilot.cpp \
+	$(SRC)/Waypoint/WaypointReaderSeeYou.cpp \
+	$(SRC)/Waypoint/WaypointReaderZander.cpp \
+	$(SRC)/Waypoint/WaypointReaderFS.cpp \
+	$(SRC)/Waypoint/WaypointReaderOzi.cpp \
+	$(SRC)/Waypoint/WaypointReaderCompeGPS.cpp \
+	$(SRC)/Waypoint/WaypointCache.cpp \
+	$(SRC)/Operation/Operation.cpp \
+	$(SRC)/RadioFrequency.cpp \
+	$(TEST_SRC_DIR)/FakeTerrain.cpp \
+	$(TEST_SRC_DIR)/tap.c \
+	$(TEST_SRC_DIR)/TestWaypointCache.cpp
+TEST_WAYPOINT_CACHE_DEPENDS = WAYPOINT GEO MATH IO UTIL ZZIP OS THREAD
+$(eval $(call link-program,TestWaypointCache,TEST_WAYPOINT_CACHE))
+
 TEST_TRACE_SOURCES = \
 	$(TEST_SRC_DIR)/tap.c \
 	$(SRC)/Engine/Trace/Point.cpp \
@@ -696,6 +791,15 @@ DEBUG_PROGRAM_NAMES = \
 	FlightPath \
 	BenchmarkProjection \
 	BenchmarkFAITriangleSector \
+	BenchmarkObservationZones \
+	BenchmarkRasterIntersection \
+	BenchmarkSeqLock \
+	BenchmarkNMEAParser \
+	BenchmarkFlarmTraffic \
+	BenchmarkReplay \
+	BenchmarkTaskDijkstra \
+	BenchmarkTaskClone \
+	BenchmarkTaskEngine \
 	DumpTextFile DumpTextZip DumpTextInflate WriteTextFile RunTextWriter \
 	DumpHexColor \
 	RunXMLParser \
@@ -755,7 +859,8 @@ DEBUG_PROGRAM_NAMES = \
 ifeq ($(TARGET),UNIX)
 DEBUG_PROGRAM_NAMES += \
 	AnalyseFlight \
-	FeedFlyNetData
+	FeedFlyNetData \
+	BenchmarkIOLoop
 endif
 
 ifeq ($(TARGET),PC)
@@ -787,6 +892,7 @@ DEBUG_REPLAY_SOURCES = \
 	$(SRC)/Device/Util/NMEAReader.cpp \
 	$(SRC)/Device/Config.cpp \
 	$(SRC)/IGC/IGCParser.cpp \
+	$(SRC)/IGC/IGCIndex.cpp \
 	$(SRC)/IGC/Generator.cpp \
 	$(SRC)/Units/Descriptor.cpp \
 	$(SRC)/Units/System.cpp \
@@ -839,6 +945,82 @@ DEBUG_REPLAY_LDADD = \
 	$(THREAD_LIBS) \
 	$(OS_LIBS)
 
+GLIDE_COMPUTER_SOURCES = \
+	$(SRC)/Engine/Util/Gradient.cpp \
+	$(SRC)/Engine/Trace/Point.cpp \
+	$(SRC)/Engine/Trace/Trace.cpp \
+	$(SRC)/Engine/Trace/Vector.cpp \
+	$(SRC)/NMEA/Aircraft.cpp \
+	$(SRC)/Task/ProtectedTaskManager.cpp \
+	$(SRC)/Task/ProtectedRoutePlanner.cpp \
+	$(SRC)/Task/RoutePlannerGlue.cpp \
+	$(SRC)/RadioFrequency.cpp \
+	$(SRC)/Atmosphere/CuSonde.cpp \
+	$(SRC)/Computer/Wind/CirclingWind.cpp \
+	$(SRC)/Computer/Wind/Store.cpp \
+	$(SRC)/Computer/Wind/MeasurementList.cpp \
+	$(SRC)/Computer/Wind/WindEKF.cpp \
+	$(SRC)/Computer/Wind/WindEKFGlue.cpp \
+	$(SRC)/Units/Units.cpp \
+	$(SRC)/Units/Settings.cpp \
+	$(SRC)/Formatter/Units.cpp \
+	$(SRC)/Formatter/UserUnits.cpp \
+	$(SRC)/Formatter/TimeFormatter.cpp \
+	$(SRC)/Formatter/GeoPointFormatter.cpp \
+	$(SRC)/Computer/ThermalLocator.cpp \
+	$(SRC)/Computer/ThermalBase.cpp \
+	$(SRC)/Computer/ThermalBandComputer.cpp \
+	$(SRC)/Computer/GlideRatioCalculator.cpp \
+	$(SRC)/Computer/AutoQNH.cpp \
+	$(SRC)/Computer/CirclingComputer.cpp \
+	$(SRC)/Computer/Wind/Computer.cpp \
+	$(SRC)/Computer/Wind/Settings.cpp \
+	$(SRC)/Computer/ContestComputer.cpp \
+	$(SRC)/Computer/TraceComputer.cpp \
+	$(SRC)/Computer/WarningComputer.cpp \
+	$(SRC)/Computer/LiftDatabaseComputer.cpp \
+	$(SRC)/Computer/AverageVarioComputer.cpp \
+	$(SRC)/Computer/GlideRatioComputer.cpp \
+	$(SRC)/Computer/GlideComputer.cpp \
+	$(SRC)/Computer/GlideComputerBlackboard.cpp \
+	$(SRC)/Computer/TaskComputer.cpp \
+	$(SRC)/Computer/RouteComputer.cpp \
+	$(SRC)/Computer/GlideComputerAirData.cpp \
+	$(SRC)/Computer/StatsComputer.cpp \
+	$(SRC)/Computer/GlideComputerInterface.cpp \
+	$(SRC)/Computer/LogComputer.cpp \
+	$(SRC)/Computer/CuComputer.cpp \
+	$(SRC)/Audio/Settings.cpp \
+	$(SRC)/Audio/VarioSettings.cpp \
+	$(SRC)/Audio/VegaVoiceSettings.cpp \
+	$(SRC)/Computer/Settings.cpp \
+	$(SRC)/TeamCode/TeamCode.cpp \
+	$(SRC)/TeamCode/Settings.cpp \
+	$(SRC)/Logger/Settings.cpp \
+	$(SRC)/Tracking/TrackingSettings.cpp \
+	$(SRC)/Audio/VegaVoice.cpp \
+	$(SRC)/Airspace/ActivePredicate.cpp \
+	$(SRC)/Airspace/ProtectedAirspaceWarningManager.cpp \
+	$(SRC)/Airspace/AirspaceVisibility.cpp \
+	$(SRC)/Airspace/AirspaceComputerSettings.cpp \
+	$(SRC)/Math/SunEphemeris.cpp \
+	$(TEST_SRC_DIR)/FakeLogFile.cpp \
+	$(SRC)/FlightStatistics.cpp \
+	$(SRC)/LocalPath.cpp \
+	$(SRC)/Task/Serialiser.cpp \
+	$(SRC)/Task/Deserialiser.cpp \
+	$(SRC)/Task/TaskFile.cpp \
+	$(SRC)/Task/TaskFileXCSoar.cpp \
+	$(SRC)/Task/TaskFileSeeYou.cpp \
+	$(SRC)/Task/TaskFileIGC.cpp \
+	$(SRC)/Waypoint/WaypointReaderBase.cpp \
+	$(SRC)/Waypoint/WaypointReaderSeeYou.cpp \
+	$(SRC)/XML/Node.cpp \
+	$(SRC)/XML/Parser.cpp \
+	$(SRC)/XML/Writer.cpp \
+	$(SRC)/XML/DataNode.cpp \
+	$(SRC)/XML/DataNodeXML.cpp
+
 BENCHMARK_PROJECTION_SOURCES = \
 	$(SRC)/Projection/Projection.cpp \
 	$(TEST_SRC_DIR)/BenchmarkProjection.cpp
@@ -853,6 +1035,118 @@ BENCHMARK_FAI_TRIANGLE_SECTOR_SOURCES = \
 BENCHMARK_FAI_TRIANGLE_SECTOR_DEPENDS = GEO MATH
 $(eval $(call link-program,BenchmarkFAITriangleSector,BENCHMARK_FAI_TRIANGLE_SECTOR))
 
+BENCHMARK_OBSERVATION_ZONES_SOURCES = \
+	$(TEST_SRC_DIR)/BenchmarkObservationZones.cpp
+BENCHMARK_OBSERVATION_ZONES_DEPENDS = TASK GEO MATH OS UTIL
+$(eval $(call link-program,BenchmarkObservationZones,BENCHMARK_OBSERVATION_ZONES))
+
+BENCHMARK_RASTER_INTERSECTION_SOURCES = \
+	$(TEST_SRC_DIR)/BenchmarkRasterIntersection.cpp
+BENCHMARK_RASTER_INTERSECTION_DEPENDS = TERRAIN IO ZZIP OS GEO MATH UTIL
+$(eval $(call link-program,BenchmarkRasterIntersection,BENCHMARK_RASTER_INTERSECTION))
+
+BENCHMARK_SEQ_LOCK_SOURCES = \
+	$(TEST_SRC_DIR)/BenchmarkSeqLock.cpp
+BENCHMARK_SEQ_LOCK_DEPENDS = THREAD OS UTIL
+$(eval $(call link-program,BenchmarkSeqLock,BENCHMARK_SEQ_LOCK))
+
+BENCHMARK_NMEA_PARSER_SOURCES = \
+	$(SRC)/Device/Util/LineSplitter.cpp \
+	$(SRC)/Device/Parser.cpp \
+	$(SRC)/FLARM/Traffic.cpp \
+	$(SRC)/FLARM/FlarmId.cpp \
+	$(SRC)/NMEA/Info.cpp \
+	$(SRC)/NMEA/Attitude.cpp \
+	$(SRC)/NMEA/Acceleration.cpp \
+	$(SRC)/NMEA/ExternalSettings.cpp \
+	$(SRC)/NMEA/SwitchState.cpp \
+	$(SRC)/NMEA/InputLine.cpp \
+	$(SRC)/NMEA/Checksum.cpp \
+	$(SRC)/FLARM/List.cpp \
+	$(SRC)/Units/Descriptor.cpp \
+	$(SRC)/Units/System.cpp \
+	$(SRC)/Atmosphere/Pressure.cpp \
+	$(SRC)/Atmosphere/AirDensity.cpp \
+	$(TEST_SRC_DIR)/FakeGeoid.cpp \
+	$(TEST_SRC_DIR)/BenchmarkNMEAParser.cpp
+BENCHMARK_NMEA_PARSER_DEPENDS = DRIVER GEO MATH IO OS UTIL TIME
+$(eval $(call link-program,BenchmarkNMEAParser,BENCHMARK_NMEA_PARSER))
+
+BENCHMARK_FLARM_TRAFFIC_SOURCES = \
+	$(SRC)/Device/Port/NullPort.cpp \
+	$(SRC)/Device/Port/Port.cpp \
+	$(SRC)/Device/Util/LineSplitter.cpp \
+	$(SRC)/Device/Util/NMEAWriter.cpp \
+	$(SRC)/Device/Driver/FLARM/BinaryProtocol.cpp \
+	$(SRC)/Device/Driver/FLARM/CRC16.cpp \
+	$(SRC)/Device/Parser.cpp \
+	$(SRC)/FLARM/FlarmComputer.cpp \
+	$(SRC)/FLARM/FlarmCalculations.cpp \
+	$(SRC)/FLARM/FlarmDetails.cpp \
+	$(SRC)/FLARM/Global.cpp \
+	$(SRC)/FLARM/TrafficDatabases.cpp \
+	$(SRC)/FLARM/NameDatabase.cpp \
+	$(SRC)/FLARM/FlarmNetDatabase.cpp \
+	$(SRC)/FLARM/Traffic.cpp \
+	$(SRC)/FLARM/FlarmId.cpp \
+	$(SRC)/FLARM/List.cpp \
+	$(SRC)/Computer/ClimbAverageCalculator.cpp \
+	$(SRC)/NMEA/Info.cpp \
+	$(SRC)/NMEA/Attitude.cpp \
+	$(SRC)/NMEA/Acceleration.cpp \
+	$(SRC)/NMEA/ExternalSettings.cpp \
+	$(SRC)/NMEA/SwitchState.cpp \
+	$(SRC)/NMEA/InputLine.cpp \
+	$(SRC)/NMEA/Checksum.cpp \
+	$(SRC)/Units/Descriptor.cpp \
+	$(SRC)/Units/System.cpp \
+	$(SRC)/Atmosphere/Pressure.cpp \
+	$(SRC)/Atmosphere/AirDensity.cpp \
+	$(SRC)/Operation/Operation.cpp \
+	$(TEST_SRC_DIR)/FakeGeoid.cpp \
+	$(TEST_SRC_DIR)/BenchmarkFlarmTraffic.cpp
+BENCHMARK_FLARM_TRAFFIC_DEPENDS = DRIVER GEO MATH IO OS THREAD UTIL TIME
+$(eval $(call link-program,BenchmarkFlarmTraffic,BENCHMARK_FLARM_TRAFFIC))
+
+BENCHMARK_REPLAY_SOURCES = \
+	$(DEBUG_REPLAY_SOURCES) \
+	$(GLIDE_COMPUTER_SOURCES) \
+	$(SRC)/Replay/IgcReplay.cpp \
+	$(SRC)/Replay/FastReplay.cpp \
+	$(SRC)/Operation/ConsoleOperationEnvironment.cpp \
+	$(TEST_SRC_DIR)/ConsoleJobRunner.cpp \
+	$(TEST_SRC_DIR)/BenchmarkReplay.cpp
+BENCHMARK_REPLAY_DEPENDS = DRIVER TERRAIN IO OS THREAD CONTEST TASK ROUTE GLIDE WAYPOINT AIRSPACE JASPER ZZIP UTIL GEO MATH TIME
+$(eval $(call link-program,BenchmarkReplay,BENCHMARK_REPLAY))
+
+BENCHMARK_IO_LOOP_SOURCES = \
+	$(SRC)/OS/LogError.cpp \
+	$(TEST_SRC_DIR)/FakeLogFile.cpp \
+	$(TEST_SRC_DIR)/BenchmarkIOLoop.cpp
+BENCHMARK_IO_LOOP_DEPENDS = PORT ASYNC OS THREAD UTIL
+$(eval $(call link-program,BenchmarkIOLoop,BENCHMARK_IO_LOOP))
+
+$(eval $(call link-harness-program,BenchmarkTaskDijkstra))
+
+$(eval $(call link-harness-program,BenchmarkTaskClone))
+
+BENCHMARK_TASK_ENGINE_SOURCES = \
+	$(SRC)/Engine/Trace/Point.cpp \
+	$(SRC)/Engine/Trace/Trace.cpp \
+	$(SRC)/Engine/Trace/Vector.cpp \
+	$(SRC)/Engine/Navigation/Aircraft.cpp \
+	$(SRC)/Engine/Util/Gradient.cpp \
+	$(SRC)/NMEA/FlyingState.cpp \
+	$(SRC)/Atmosphere/AirDensity.cpp \
+	$(SRC)/Atmosphere/Pressure.cpp \
+	$(SRC)/Formatter/AirspaceFormatter.cpp \
+	$(SRC)/JSON/Writer.cpp \
+	$(TEST_SRC_DIR)/FakeTerrain.cpp \
+	$(TEST_SRC_DIR)/BenchmarkTaskEngine.cpp
+BENCHMARK_TASK_ENGINE_LDADD = $(TEST1_LDADD)
+BENCHMARK_TASK_ENGINE_LDLIBS = $(TEST1_LDLIBS)
+$(eval $(call link-program,BenchmarkTaskEngine,BENCHMARK_TASK_ENGINE))
+
 DUMP_TEXT_FILE_SOURCES = \
 	$(TEST_SRC_DIR)/DumpTextFile.cpp
 DUMP_TEXT_FILE_DEPENDS = IO OS ZZIP UTIL
@@ -1814,6 +2108,7 @@ RUN_MAP_WINDOW_SOURCES = \
 	$(SRC)/Waypoint/LastUsed.cpp \
 	$(SRC)/Waypoint/WaypointFileType.cpp \
 	$(SRC)/Waypoint/WaypointGlue.cpp \
+	$(SRC)/Waypoint/WaypointCache.cpp \
 	$(SRC)/Waypoint/WaypointReader.cpp \
 	$(SRC)/Waypoint/WaypointReaderBase.cpp \
 	$(SRC)/Waypoint/WaypointReaderOzi.cpp \
@@ -2136,33 +2431,9 @@ $(eval $(call link-program,RunJobDialog,RUN_JOB_DIALOG))
 
 RUN_ANALYSIS_SOURCES = \
 	$(DEBUG_REPLAY_SOURCES) \
-	$(SRC)/Engine/Util/Gradient.cpp \
-	$(SRC)/Engine/Trace/Point.cpp \
-	$(SRC)/Engine/Trace/Trace.cpp \
-	$(SRC)/Engine/Trace/Vector.cpp \
-	$(SRC)/NMEA/Aircraft.cpp \
+	$(GLIDE_COMPUTER_SOURCES) \
 	$(SRC)/UIUtil/GestureManager.cpp \
-	$(SRC)/Task/Serialiser.cpp \
-	$(SRC)/Task/Deserialiser.cpp \
-	$(SRC)/Task/ProtectedTaskManager.cpp \
-	$(SRC)/Task/ProtectedRoutePlanner.cpp \
-	$(SRC)/Task/RoutePlannerGlue.cpp \
-	$(SRC)/Task/TaskFile.cpp \
-	$(SRC)/Task/TaskFileXCSoar.cpp \
-	$(SRC)/Task/TaskFileSeeYou.cpp \
-	$(SRC)/Task/TaskFileIGC.cpp \
-	$(SRC)/Task/Serialiser.cpp \
-	$(SRC)/Task/Deserialiser.cpp \
-	$(SRC)/Waypoint/WaypointReaderBase.cpp \
-	$(SRC)/Waypoint/WaypointReaderSeeYou.cpp \
-	$(SRC)/RadioFrequency.cpp \
 	$(SRC)/Math/Screen.cpp \
-	$(SRC)/Atmosphere/CuSonde.cpp \
-	$(SRC)/Computer/Wind/CirclingWind.cpp \
-	$(SRC)/Computer/Wind/Store.cpp \
-	$(SRC)/Computer/Wind/MeasurementList.cpp \
-	$(SRC)/Computer/Wind/WindEKF.cpp \
-	$(SRC)/Computer/Wind/WindEKFGlue.cpp \
 	$(SRC)/Projection/Projection.cpp \
 	$(SRC)/Projection/WindowProjection.cpp \
 	$(SRC)/Projection/MapWindowProjection.cpp \
@@ -2175,14 +2446,7 @@ RUN_ANALYSIS_SOURCES = \
 	$(SRC)/Renderer/AircraftRenderer.cpp \
 	$(SRC)/Renderer/TrailRenderer.cpp \
 	$(SRC)/MapWindow/MapCanvas.cpp \
-	$(SRC)/Units/Units.cpp \
-	$(SRC)/Units/Settings.cpp \
-	$(SRC)/Formatter/Units.cpp \
-	$(SRC)/Formatter/UserUnits.cpp \
 	$(SRC)/Formatter/HexColor.cpp \
-	$(SRC)/Formatter/TimeFormatter.cpp \
-	$(SRC)/Formatter/GeoPointFormatter.cpp \
-	$(SRC)/LocalPath.cpp \
 	$(MORE_SCREEN_SOURCES) \
 	$(SRC)/Screen/Ramp.cpp \
 	$(SRC)/Screen/UnitSymbol.cpp \
@@ -2215,11 +2479,6 @@ RUN_ANALYSIS_SOURCES = \
 	$(SRC)/Profile/Profile.cpp \
 	$(SRC)/Profile/ProfileKeys.cpp \
 	$(SRC)/Profile/FontConfig.cpp \
-	$(SRC)/XML/Node.cpp \
-	$(SRC)/XML/Parser.cpp \
-	$(SRC)/XML/Writer.cpp \
-	$(SRC)/XML/DataNode.cpp \
-	$(SRC)/XML/DataNodeXML.cpp \
 	$(SRC)/Dialogs/XML.cpp \
 	$(SRC)/Dialogs/Inflate.cpp \
 	$(SRC)/Dialogs/dlgAnalysis.cpp \
@@ -2230,7 +2489,6 @@ RUN_ANALYSIS_SOURCES = \
 	$(SRC)/CrossSection/TerrainXSRenderer.cpp \
 	$(SRC)/CrossSection/CrossSectionRenderer.cpp \
 	$(SRC)/CrossSection/CrossSectionWindow.cpp \
-	$(SRC)/FlightStatistics.cpp \
 	$(SRC)/Renderer/AirspacePreviewRenderer.cpp \
 	$(SRC)/Renderer/FlightStatisticsRenderer.cpp \
 	$(SRC)/Renderer/BarographRenderer.cpp \
@@ -2239,56 +2497,19 @@ RUN_ANALYSIS_SOURCES = \
 	$(SRC)/Renderer/ThermalBandRenderer.cpp \
 	$(SRC)/Renderer/WindChartRenderer.cpp \
 	$(SRC)/Renderer/CuRenderer.cpp \
-	$(SRC)/Computer/ThermalLocator.cpp \
-	$(SRC)/Computer/ThermalBase.cpp \
-	$(SRC)/Computer/ThermalBandComputer.cpp \
-	$(SRC)/Computer/GlideRatioCalculator.cpp \
-	$(SRC)/Computer/AutoQNH.cpp \
-	$(SRC)/Computer/CirclingComputer.cpp \
-	$(SRC)/Computer/Wind/Computer.cpp \
-	$(SRC)/Computer/Wind/Settings.cpp \
-	$(SRC)/Computer/ContestComputer.cpp \
-	$(SRC)/Computer/TraceComputer.cpp \
-	$(SRC)/Computer/WarningComputer.cpp \
-	$(SRC)/Computer/LiftDatabaseComputer.cpp \
-	$(SRC)/Computer/AverageVarioComputer.cpp \
-	$(SRC)/Computer/GlideRatioComputer.cpp \
-	$(SRC)/Computer/GlideComputer.cpp \
-	$(SRC)/Computer/GlideComputerBlackboard.cpp \
-	$(SRC)/Computer/TaskComputer.cpp \
-	$(SRC)/Computer/RouteComputer.cpp \
-	$(SRC)/Computer/GlideComputerAirData.cpp \
-	$(SRC)/Computer/StatsComputer.cpp \
-	$(SRC)/Computer/GlideComputerInterface.cpp \
-	$(SRC)/Computer/LogComputer.cpp \
-	$(SRC)/Computer/CuComputer.cpp \
-	$(SRC)/Audio/Settings.cpp \
-	$(SRC)/Audio/VarioSettings.cpp \
-	$(SRC)/Audio/VegaVoiceSettings.cpp \
 	$(SRC)/UISettings.cpp \
 	$(SRC)/DisplaySettings.cpp \
 	$(SRC)/PageSettings.cpp \
 	$(SRC)/InfoBoxes/InfoBoxSettings.cpp \
 	$(SRC)/Gauge/VarioSettings.cpp \
 	$(SRC)/Gauge/TrafficSettings.cpp \
-	$(SRC)/Computer/Settings.cpp \
-	$(SRC)/TeamCode/TeamCode.cpp \
-	$(SRC)/TeamCode/Settings.cpp \
-	$(SRC)/Logger/Settings.cpp \
-	$(SRC)/Tracking/TrackingSettings.cpp \
 	$(SRC)/IGC/IGCParser.cpp \
 	$(SRC)/MapSettings.cpp \
 	$(SRC)/Blackboard/InterfaceBlackboard.cpp \
-	$(SRC)/Audio/VegaVoice.cpp \
 	$(SRC)/Engine/Navigation/TraceHistory.cpp \
-	$(SRC)/Airspace/ActivePredicate.cpp \
-	$(SRC)/Airspace/ProtectedAirspaceWarningManager.cpp \
 	$(SRC)/Airspace/AirspaceParser.cpp \
 	$(SRC)/Airspace/AirspaceGlue.cpp \
-	$(SRC)/Airspace/AirspaceVisibility.cpp \
-	$(SRC)/Airspace/AirspaceComputerSettings.cpp \
 	$(SRC)/Renderer/AirspaceRendererSettings.cpp \
-	$(SRC)/Math/SunEphemeris.cpp \
 	$(SRC)/IO/ConfiguredFile.cpp \
 	$(SRC)/Operation/Operation.cpp \
 	$(SRC)/Operation/ProxyOperationEnvironment.cpp \
@@ -2298,7 +2519,6 @@ RUN_ANALYSIS_SOURCES = \
 	$(TEST_SRC_DIR)/FakeListPicker.cpp \
 	$(TEST_SRC_DIR)/FakeHelpDialog.cpp \
 	$(TEST_SRC_DIR)/FakeLanguage.cpp \
-	$(TEST_SRC_DIR)/FakeLogFile.cpp \
 	$(TEST_SRC_DIR)/Fonts.cpp \
 	$(TEST_SRC_DIR)/RunAnalysis.cpp
 RUN_ANALYSIS_DEPENDS = TERRAIN DRIVER PROFILE FORM WIDGET SCREEN EVENT RESOURCE ASYNC IO DATA_FIELD OS THREAD CONTEST TASK ROUTE GLIDE WAYPOINT ROUTE AIRSPACE ZZIP UTIL GEO MATH TIME
@@ -2395,6 +2615,7 @@ RUN_TASK_EDITOR_DIALOG_SOURCES = \
 	$(SRC)/Formatter/Units.cpp \
 	$(SRC)/Waypoint/WaypointFileType.cpp \
 	$(SRC)/Waypoint/WaypointGlue.cpp \
+	$(SRC)/Waypoint/WaypointCache.cpp \
 	$(SRC)/Waypoint/WaypointReaderBase.cpp \
 	$(SRC)/Waypoint/WaypointReader.cpp \
 	$(SRC)/Waypoint/WaypointReaderOzi.cpp \
@@ -2519,7 +2740,6 @@ $(eval $(call link-program,DumpTaskFile,DUMP_TASK_FILE))
 DUMP_FLARM_NET_SOURCES = \
 	$(SRC)/FLARM/FlarmNetReader.cpp \
 	$(SRC)/FLARM/FlarmId.cpp \
-	$(SRC)/FLARM/FlarmNetRecord.cpp \
 	$(SRC)/FLARM/FlarmNetDatabase.cpp \
 	$(TEST_SRC_DIR)/DumpFlarmNet.cpp
 DUMP_FLARM_NET_DEPENDS = IO OS MATH UTIL
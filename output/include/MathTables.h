@@ -0,0 +1,20620 @@
+#ifdef FIXED_MATH
+const int SINETABLE[4096] = {
+  0,
+  411774,
+  823548,
+  1235320,
+  1647088,
+  2058853,
+  2470614,
+  2882368,
+  3294115,
+  3705855,
+  4117586,
+  4529308,
+  4941018,
+  5352718,
+  5764404,
+  6176077,
+  6587735,
+  6999378,
+  7411005,
+  7822614,
+  8234204,
+  8645775,
+  9057326,
+  9468856,
+  9880363,
+  10291847,
+  10703307,
+  11114742,
+  11526150,
+  11937531,
+  12348885,
+  12760209,
+  13171503,
+  13582766,
+  13993997,
+  14405196,
+  14816360,
+  15227490,
+  15638583,
+  16049640,
+  16460659,
+  16871640,
+  17282580,
+  17693480,
+  18104339,
+  18515155,
+  18925927,
+  19336654,
+  19747337,
+  20157972,
+  20568561,
+  20979101,
+  21389591,
+  21800031,
+  22210420,
+  22620757,
+  23031040,
+  23441269,
+  23851443,
+  24261561,
+  24671622,
+  25081625,
+  25491569,
+  25901452,
+  26311275,
+  26721036,
+  27130734,
+  27540368,
+  27949938,
+  28359441,
+  28768878,
+  29178247,
+  29587548,
+  29996779,
+  30405939,
+  30815028,
+  31224044,
+  31632987,
+  32041855,
+  32450648,
+  32859365,
+  33268004,
+  33676565,
+  34085047,
+  34493448,
+  34901769,
+  35310007,
+  35718162,
+  36126233,
+  36534219,
+  36942120,
+  37349933,
+  37757658,
+  38165295,
+  38572841,
+  38980297,
+  39387661,
+  39794933,
+  40202111,
+  40609194,
+  41016182,
+  41423073,
+  41829866,
+  42236562,
+  42643158,
+  43049653,
+  43456047,
+  43862339,
+  44268528,
+  44674613,
+  45080592,
+  45486466,
+  45892232,
+  46297890,
+  46703440,
+  47108879,
+  47514208,
+  47919425,
+  48324529,
+  48729520,
+  49134395,
+  49539155,
+  49943799,
+  50348325,
+  50752733,
+  51157021,
+  51561188,
+  51965235,
+  52369159,
+  52772960,
+  53176637,
+  53580188,
+  53983614,
+  54386912,
+  54790083,
+  55193124,
+  55596036,
+  55998817,
+  56401466,
+  56803983,
+  57206365,
+  57608614,
+  58010726,
+  58412702,
+  58814541,
+  59216241,
+  59617802,
+  60019223,
+  60420502,
+  60821639,
+  61222633,
+  61623483,
+  62024188,
+  62424747,
+  62825159,
+  63225424,
+  63625539,
+  64025505,
+  64425320,
+  64824984,
+  65224495,
+  65623852,
+  66023056,
+  66422103,
+  66820995,
+  67219729,
+  67618305,
+  68016722,
+  68414979,
+  68813075,
+  69211009,
+  69608780,
+  70006387,
+  70403830,
+  70801107,
+  71198217,
+  71595160,
+  71991935,
+  72388539,
+  72784974,
+  73181237,
+  73577328,
+  73973246,
+  74368990,
+  74764559,
+  75159952,
+  75555168,
+  75950207,
+  76345066,
+  76739746,
+  77134246,
+  77528564,
+  77922699,
+  78316651,
+  78710419,
+  79104002,
+  79497398,
+  79890608,
+  80283629,
+  80676462,
+  81069104,
+  81461556,
+  81853816,
+  82245884,
+  82637758,
+  83029438,
+  83420922,
+  83812210,
+  84203301,
+  84594193,
+  84984887,
+  85375380,
+  85765673,
+  86155764,
+  86545652,
+  86935336,
+  87324816,
+  87714091,
+  88103159,
+  88492019,
+  88880672,
+  89269115,
+  89657348,
+  90045371,
+  90433181,
+  90820779,
+  91208162,
+  91595332,
+  91982285,
+  92369023,
+  92755543,
+  93141844,
+  93527927,
+  93913789,
+  94299431,
+  94684850,
+  95070047,
+  95455020,
+  95839768,
+  96224291,
+  96608588,
+  96992657,
+  97376498,
+  97760110,
+  98143491,
+  98526642,
+  98909561,
+  99292247,
+  99674700,
+  100056918,
+  100438900,
+  100820647,
+  101202156,
+  101583426,
+  101964458,
+  102345250,
+  102725801,
+  103106110,
+  103486177,
+  103866000,
+  104245579,
+  104624913,
+  105004000,
+  105382840,
+  105761432,
+  106139776,
+  106517869,
+  106895712,
+  107273304,
+  107650643,
+  108027729,
+  108404560,
+  108781136,
+  109157457,
+  109533520,
+  109909326,
+  110284873,
+  110660161,
+  111035188,
+  111409954,
+  111784458,
+  112158699,
+  112532676,
+  112906388,
+  113279835,
+  113653014,
+  114025927,
+  114398571,
+  114770946,
+  115143051,
+  115514885,
+  115886447,
+  116257736,
+  116628752,
+  116999493,
+  117369960,
+  117740150,
+  118110062,
+  118479697,
+  118849053,
+  119218130,
+  119586926,
+  119955440,
+  120323673,
+  120691622,
+  121059287,
+  121426667,
+  121793762,
+  122160570,
+  122527090,
+  122893322,
+  123259265,
+  123624918,
+  123990280,
+  124355351,
+  124720128,
+  125084613,
+  125448802,
+  125812697,
+  126176296,
+  126539598,
+  126902601,
+  127265307,
+  127627713,
+  127989818,
+  128351623,
+  128713125,
+  129074324,
+  129435220,
+  129795811,
+  130156097,
+  130516077,
+  130875749,
+  131235113,
+  131594169,
+  131952915,
+  132311350,
+  132669475,
+  133027287,
+  133384785,
+  133741970,
+  134098841,
+  134455396,
+  134811634,
+  135167555,
+  135523158,
+  135878442,
+  136233407,
+  136588051,
+  136942373,
+  137296374,
+  137650051,
+  138003404,
+  138356433,
+  138709136,
+  139061512,
+  139413562,
+  139765283,
+  140116675,
+  140467738,
+  140818470,
+  141168871,
+  141518940,
+  141868675,
+  142218077,
+  142567144,
+  142915876,
+  143264271,
+  143612330,
+  143960050,
+  144307431,
+  144654473,
+  145001175,
+  145347536,
+  145693554,
+  146039230,
+  146384561,
+  146729549,
+  147074191,
+  147418487,
+  147762436,
+  148106038,
+  148449291,
+  148792195,
+  149134748,
+  149476951,
+  149818802,
+  150160300,
+  150501445,
+  150842236,
+  151182672,
+  151522752,
+  151862476,
+  152201842,
+  152540851,
+  152879500,
+  153217789,
+  153555718,
+  153893286,
+  154230491,
+  154567334,
+  154903813,
+  155239927,
+  155575676,
+  155911059,
+  156246075,
+  156580724,
+  156915004,
+  157248914,
+  157582455,
+  157915625,
+  158248423,
+  158580849,
+  158912902,
+  159244581,
+  159575885,
+  159906814,
+  160237366,
+  160567542,
+  160897339,
+  161226758,
+  161555798,
+  161884457,
+  162212735,
+  162540632,
+  162868146,
+  163195277,
+  163522024,
+  163848386,
+  164174363,
+  164499953,
+  164825157,
+  165149972,
+  165474399,
+  165798436,
+  166122084,
+  166445340,
+  166768205,
+  167090677,
+  167412756,
+  167734441,
+  168055732,
+  168376627,
+  168697125,
+  169017227,
+  169336931,
+  169656237,
+  169975144,
+  170293650,
+  170611756,
+  170929460,
+  171246762,
+  171563661,
+  171880157,
+  172196248,
+  172511933,
+  172827213,
+  173142086,
+  173456552,
+  173770610,
+  174084258,
+  174397498,
+  174710326,
+  175022744,
+  175334749,
+  175646343,
+  175957522,
+  176268288,
+  176578639,
+  176888575,
+  177198094,
+  177507196,
+  177815881,
+  178124147,
+  178431994,
+  178739421,
+  179046428,
+  179353013,
+  179659176,
+  179964917,
+  180270234,
+  180575127,
+  180879594,
+  181183637,
+  181487253,
+  181790442,
+  182093203,
+  182395535,
+  182697439,
+  182998912,
+  183299955,
+  183600567,
+  183900746,
+  184200493,
+  184499806,
+  184798686,
+  185097130,
+  185395139,
+  185692711,
+  185989847,
+  186286545,
+  186582805,
+  186878625,
+  187174006,
+  187468946,
+  187763446,
+  188057503,
+  188351118,
+  188644290,
+  188937018,
+  189229301,
+  189521139,
+  189812531,
+  190103476,
+  190393974,
+  190684024,
+  190973625,
+  191262777,
+  191551479,
+  191839730,
+  192127530,
+  192414878,
+  192701772,
+  192988214,
+  193274201,
+  193559734,
+  193844811,
+  194129431,
+  194413595,
+  194697302,
+  194980551,
+  195263340,
+  195545670,
+  195827540,
+  196108950,
+  196389897,
+  196670383,
+  196950406,
+  197229965,
+  197509061,
+  197787691,
+  198065856,
+  198343555,
+  198620788,
+  198897553,
+  199173850,
+  199449678,
+  199725037,
+  199999926,
+  200274344,
+  200548291,
+  200821767,
+  201094769,
+  201367299,
+  201639354,
+  201910935,
+  202182041,
+  202452672,
+  202722825,
+  202992502,
+  203261701,
+  203530422,
+  203798664,
+  204066427,
+  204333709,
+  204600510,
+  204866830,
+  205132668,
+  205398023,
+  205662895,
+  205927283,
+  206191186,
+  206454605,
+  206717537,
+  206979983,
+  207241942,
+  207503413,
+  207764396,
+  208024890,
+  208284895,
+  208544409,
+  208803433,
+  209061965,
+  209320006,
+  209577553,
+  209834608,
+  210091169,
+  210347236,
+  210602807,
+  210857883,
+  211112463,
+  211366547,
+  211620132,
+  211873220,
+  212125809,
+  212377899,
+  212629490,
+  212880580,
+  213131169,
+  213381256,
+  213630842,
+  213879925,
+  214128504,
+  214376580,
+  214624151,
+  214871217,
+  215117778,
+  215363832,
+  215609379,
+  215854420,
+  216098952,
+  216342976,
+  216586490,
+  216829496,
+  217071990,
+  217313974,
+  217555447,
+  217796408,
+  218036856,
+  218276791,
+  218516213,
+  218755120,
+  218993513,
+  219231390,
+  219468752,
+  219705597,
+  219941925,
+  220177735,
+  220413028,
+  220647801,
+  220882056,
+  221115791,
+  221349005,
+  221581699,
+  221813871,
+  222045521,
+  222276649,
+  222507254,
+  222737335,
+  222966892,
+  223195924,
+  223424431,
+  223652413,
+  223879868,
+  224106796,
+  224333197,
+  224559070,
+  224784415,
+  225009231,
+  225233517,
+  225457273,
+  225680499,
+  225903194,
+  226125357,
+  226346988,
+  226568086,
+  226788652,
+  227008683,
+  227228181,
+  227447143,
+  227665571,
+  227883463,
+  228100818,
+  228317637,
+  228533919,
+  228749663,
+  228964868,
+  229179535,
+  229393663,
+  229607251,
+  229820298,
+  230032805,
+  230244770,
+  230456194,
+  230667075,
+  230877413,
+  231087209,
+  231296460,
+  231505167,
+  231713330,
+  231920947,
+  232128019,
+  232334544,
+  232540522,
+  232745954,
+  232950837,
+  233155173,
+  233358960,
+  233562198,
+  233764886,
+  233967024,
+  234168612,
+  234369648,
+  234570133,
+  234770066,
+  234969447,
+  235168275,
+  235366549,
+  235564270,
+  235761436,
+  235958047,
+  236154104,
+  236349604,
+  236544548,
+  236738936,
+  236932767,
+  237126040,
+  237318755,
+  237510912,
+  237702510,
+  237893548,
+  238084027,
+  238273946,
+  238463304,
+  238652100,
+  238840335,
+  239028009,
+  239215119,
+  239401667,
+  239587651,
+  239773072,
+  239957929,
+  240142220,
+  240325947,
+  240509108,
+  240691704,
+  240873733,
+  241055195,
+  241236089,
+  241416417,
+  241596176,
+  241775367,
+  241953988,
+  242132041,
+  242309523,
+  242486436,
+  242662778,
+  242838548,
+  243013748,
+  243188375,
+  243362431,
+  243535914,
+  243708823,
+  243881159,
+  244052922,
+  244224110,
+  244394723,
+  244564761,
+  244734224,
+  244903111,
+  245071421,
+  245239155,
+  245406312,
+  245572892,
+  245738893,
+  245904316,
+  246069161,
+  246233427,
+  246397113,
+  246560219,
+  246722745,
+  246884691,
+  247046056,
+  247206839,
+  247367041,
+  247526660,
+  247685698,
+  247844152,
+  248002023,
+  248159311,
+  248316014,
+  248472134,
+  248627668,
+  248782618,
+  248936982,
+  249090760,
+  249243953,
+  249396558,
+  249548577,
+  249700009,
+  249850853,
+  250001109,
+  250150777,
+  250299857,
+  250448347,
+  250596248,
+  250743559,
+  250890281,
+  251036411,
+  251181952,
+  251326901,
+  251471259,
+  251615025,
+  251758199,
+  251900780,
+  252042769,
+  252184165,
+  252324967,
+  252465175,
+  252604790,
+  252743810,
+  252882235,
+  253020066,
+  253157301,
+  253293940,
+  253429983,
+  253565430,
+  253700280,
+  253834533,
+  253968189,
+  254101247,
+  254233708,
+  254365570,
+  254496833,
+  254627498,
+  254757564,
+  254887030,
+  255015896,
+  255144162,
+  255271828,
+  255398893,
+  255525357,
+  255651220,
+  255776482,
+  255901141,
+  256025198,
+  256148653,
+  256271505,
+  256393755,
+  256515400,
+  256636443,
+  256756881,
+  256876715,
+  256995945,
+  257114569,
+  257232589,
+  257350004,
+  257466813,
+  257583016,
+  257698613,
+  257813604,
+  257927988,
+  258041765,
+  258154935,
+  258267497,
+  258379452,
+  258490799,
+  258601537,
+  258711667,
+  258821188,
+  258930101,
+  259038403,
+  259146097,
+  259253180,
+  259359654,
+  259465517,
+  259570769,
+  259675411,
+  259779442,
+  259882862,
+  259985670,
+  260087866,
+  260189450,
+  260290422,
+  260390781,
+  260490528,
+  260589662,
+  260688182,
+  260786089,
+  260883383,
+  260980063,
+  261076128,
+  261171579,
+  261266416,
+  261360638,
+  261454244,
+  261547236,
+  261639612,
+  261731373,
+  261822517,
+  261913046,
+  262002958,
+  262092254,
+  262180932,
+  262268994,
+  262356439,
+  262443267,
+  262529477,
+  262615069,
+  262700043,
+  262784399,
+  262868137,
+  262951256,
+  263033757,
+  263115638,
+  263196900,
+  263277543,
+  263357567,
+  263436971,
+  263515755,
+  263593918,
+  263671462,
+  263748385,
+  263824688,
+  263900369,
+  263975430,
+  264049870,
+  264123688,
+  264196884,
+  264269459,
+  264341413,
+  264412744,
+  264483453,
+  264553539,
+  264623003,
+  264691845,
+  264760063,
+  264827659,
+  264894631,
+  264960980,
+  265026706,
+  265091808,
+  265156286,
+  265220140,
+  265283370,
+  265345976,
+  265407958,
+  265469315,
+  265530047,
+  265590155,
+  265649637,
+  265708494,
+  265766727,
+  265824333,
+  265881315,
+  265937670,
+  265993400,
+  266048504,
+  266102982,
+  266156834,
+  266210059,
+  266262659,
+  266314631,
+  266365977,
+  266416696,
+  266466788,
+  266516253,
+  266565091,
+  266613302,
+  266660885,
+  266707841,
+  266754170,
+  266799870,
+  266844943,
+  266889388,
+  266933205,
+  266976394,
+  267018954,
+  267060886,
+  267102190,
+  267142865,
+  267182912,
+  267222330,
+  267261119,
+  267299279,
+  267336811,
+  267373713,
+  267409986,
+  267445630,
+  267480644,
+  267515029,
+  267548785,
+  267581911,
+  267614407,
+  267646274,
+  267677511,
+  267708118,
+  267738095,
+  267767442,
+  267796159,
+  267824246,
+  267851702,
+  267878529,
+  267904725,
+  267930290,
+  267955225,
+  267979530,
+  268003204,
+  268026247,
+  268048660,
+  268070442,
+  268091593,
+  268112113,
+  268132003,
+  268151261,
+  268169889,
+  268187885,
+  268205250,
+  268221985,
+  268238088,
+  268253559,
+  268268400,
+  268282610,
+  268296188,
+  268309134,
+  268321450,
+  268333134,
+  268344187,
+  268354608,
+  268364397,
+  268373556,
+  268382082,
+  268389978,
+  268397241,
+  268403873,
+  268409874,
+  268415243,
+  268419980,
+  268424086,
+  268427560,
+  268430402,
+  268432613,
+  268434192,
+  268435140,
+  268435456,
+  268435140,
+  268434192,
+  268432613,
+  268430402,
+  268427560,
+  268424086,
+  268419980,
+  268415243,
+  268409874,
+  268403873,
+  268397241,
+  268389978,
+  268382082,
+  268373556,
+  268364397,
+  268354608,
+  268344187,
+  268333134,
+  268321450,
+  268309134,
+  268296188,
+  268282610,
+  268268400,
+  268253559,
+  268238088,
+  268221985,
+  268205250,
+  268187885,
+  268169889,
+  268151261,
+  268132003,
+  268112113,
+  268091593,
+  268070442,
+  268048660,
+  268026247,
+  268003204,
+  267979530,
+  267955225,
+  267930290,
+  267904725,
+  267878529,
+  267851702,
+  267824246,
+  267796159,
+  267767442,
+  267738095,
+  267708118,
+  267677511,
+  267646274,
+  267614407,
+  267581911,
+  267548785,
+  267515029,
+  267480644,
+  267445630,
+  267409986,
+  267373713,
+  267336811,
+  267299279,
+  267261119,
+  267222330,
+  267182912,
+  267142865,
+  267102190,
+  267060886,
+  267018954,
+  266976394,
+  266933205,
+  266889388,
+  266844943,
+  266799870,
+  266754170,
+  266707841,
+  266660885,
+  266613302,
+  266565091,
+  266516253,
+  266466788,
+  266416696,
+  266365977,
+  266314631,
+  266262659,
+  266210059,
+  266156834,
+  266102982,
+  266048504,
+  265993400,
+  265937670,
+  265881315,
+  265824333,
+  265766727,
+  265708494,
+  265649637,
+  265590155,
+  265530047,
+  265469315,
+  265407958,
+  265345976,
+  265283370,
+  265220140,
+  265156286,
+  265091808,
+  265026706,
+  264960980,
+  264894631,
+  264827659,
+  264760063,
+  264691845,
+  264623003,
+  264553539,
+  264483453,
+  264412744,
+  264341413,
+  264269459,
+  264196884,
+  264123688,
+  264049870,
+  263975430,
+  263900369,
+  263824688,
+  263748385,
+  263671462,
+  263593918,
+  263515755,
+  263436971,
+  263357567,
+  263277543,
+  263196900,
+  263115638,
+  263033757,
+  262951256,
+  262868137,
+  262784399,
+  262700043,
+  262615069,
+  262529477,
+  262443267,
+  262356439,
+  262268994,
+  262180932,
+  262092254,
+  262002958,
+  261913046,
+  261822517,
+  261731373,
+  261639612,
+  261547236,
+  261454244,
+  261360638,
+  261266416,
+  261171579,
+  261076128,
+  260980063,
+  260883383,
+  260786089,
+  260688182,
+  260589662,
+  260490528,
+  260390781,
+  260290422,
+  260189450,
+  260087866,
+  259985670,
+  259882862,
+  259779442,
+  259675411,
+  259570769,
+  259465517,
+  259359654,
+  259253180,
+  259146097,
+  259038403,
+  258930101,
+  258821188,
+  258711667,
+  258601537,
+  258490799,
+  258379452,
+  258267497,
+  258154935,
+  258041765,
+  257927988,
+  257813604,
+  257698613,
+  257583016,
+  257466813,
+  257350004,
+  257232589,
+  257114569,
+  256995945,
+  256876715,
+  256756881,
+  256636443,
+  256515400,
+  256393755,
+  256271505,
+  256148653,
+  256025198,
+  255901141,
+  255776482,
+  255651220,
+  255525357,
+  255398893,
+  255271828,
+  255144162,
+  255015896,
+  254887030,
+  254757564,
+  254627498,
+  254496833,
+  254365570,
+  254233708,
+  254101247,
+  253968189,
+  253834533,
+  253700280,
+  253565430,
+  253429983,
+  253293940,
+  253157301,
+  253020066,
+  252882235,
+  252743810,
+  252604790,
+  252465175,
+  252324967,
+  252184165,
+  252042769,
+  251900780,
+  251758199,
+  251615025,
+  251471259,
+  251326901,
+  251181952,
+  251036411,
+  250890281,
+  250743559,
+  250596248,
+  250448347,
+  250299857,
+  250150777,
+  250001109,
+  249850853,
+  249700009,
+  249548577,
+  249396558,
+  249243953,
+  249090760,
+  248936982,
+  248782618,
+  248627668,
+  248472134,
+  248316014,
+  248159311,
+  248002023,
+  247844152,
+  247685698,
+  247526660,
+  247367041,
+  247206839,
+  247046056,
+  246884691,
+  246722745,
+  246560219,
+  246397113,
+  246233427,
+  246069161,
+  245904316,
+  245738893,
+  245572892,
+  245406312,
+  245239155,
+  245071421,
+  244903111,
+  244734224,
+  244564761,
+  244394723,
+  244224110,
+  244052922,
+  243881159,
+  243708823,
+  243535914,
+  243362431,
+  243188375,
+  243013748,
+  242838548,
+  242662778,
+  242486436,
+  242309523,
+  242132041,
+  241953988,
+  241775367,
+  241596176,
+  241416417,
+  241236089,
+  241055195,
+  240873733,
+  240691704,
+  240509108,
+  240325947,
+  240142220,
+  239957929,
+  239773072,
+  239587651,
+  239401667,
+  239215119,
+  239028009,
+  238840335,
+  238652100,
+  238463304,
+  238273946,
+  238084027,
+  237893548,
+  237702510,
+  237510912,
+  237318755,
+  237126040,
+  236932767,
+  236738936,
+  236544548,
+  236349604,
+  236154104,
+  235958047,
+  235761436,
+  235564270,
+  235366549,
+  235168275,
+  234969447,
+  234770066,
+  234570133,
+  234369648,
+  234168612,
+  233967024,
+  233764886,
+  233562198,
+  233358960,
+  233155173,
+  232950837,
+  232745954,
+  232540522,
+  232334544,
+  232128019,
+  231920947,
+  231713330,
+  231505167,
+  231296460,
+  231087209,
+  230877413,
+  230667075,
+  230456194,
+  230244770,
+  230032805,
+  229820298,
+  229607251,
+  229393663,
+  229179535,
+  228964868,
+  228749663,
+  228533919,
+  228317637,
+  228100818,
+  227883463,
+  227665571,
+  227447143,
+  227228181,
+  227008683,
+  226788652,
+  226568086,
+  226346988,
+  226125357,
+  225903194,
+  225680499,
+  225457273,
+  225233517,
+  225009231,
+  224784415,
+  224559070,
+  224333197,
+  224106796,
+  223879868,
+  223652413,
+  223424431,
+  223195924,
+  222966892,
+  222737335,
+  222507254,
+  222276649,
+  222045521,
+  221813871,
+  221581699,
+  221349005,
+  221115791,
+  220882056,
+  220647801,
+  220413028,
+  220177735,
+  219941925,
+  219705597,
+  219468752,
+  219231390,
+  218993513,
+  218755120,
+  218516213,
+  218276791,
+  218036856,
+  217796408,
+  217555447,
+  217313974,
+  217071990,
+  216829496,
+  216586490,
+  216342976,
+  216098952,
+  215854420,
+  215609379,
+  215363832,
+  215117778,
+  214871217,
+  214624151,
+  214376580,
+  214128504,
+  213879925,
+  213630842,
+  213381256,
+  213131169,
+  212880580,
+  212629490,
+  212377899,
+  212125809,
+  211873220,
+  211620132,
+  211366547,
+  211112463,
+  210857883,
+  210602807,
+  210347236,
+  210091169,
+  209834608,
+  209577553,
+  209320006,
+  209061965,
+  208803433,
+  208544409,
+  208284895,
+  208024890,
+  207764396,
+  207503413,
+  207241942,
+  206979983,
+  206717537,
+  206454605,
+  206191186,
+  205927283,
+  205662895,
+  205398023,
+  205132668,
+  204866830,
+  204600510,
+  204333709,
+  204066427,
+  203798664,
+  203530422,
+  203261701,
+  202992502,
+  202722825,
+  202452672,
+  202182041,
+  201910935,
+  201639354,
+  201367299,
+  201094769,
+  200821767,
+  200548291,
+  200274344,
+  199999926,
+  199725037,
+  199449678,
+  199173850,
+  198897553,
+  198620788,
+  198343555,
+  198065856,
+  197787691,
+  197509061,
+  197229965,
+  196950406,
+  196670383,
+  196389897,
+  196108950,
+  195827540,
+  195545670,
+  195263340,
+  194980551,
+  194697302,
+  194413595,
+  194129431,
+  193844811,
+  193559734,
+  193274201,
+  192988214,
+  192701772,
+  192414878,
+  192127530,
+  191839730,
+  191551479,
+  191262777,
+  190973625,
+  190684024,
+  190393974,
+  190103476,
+  189812531,
+  189521139,
+  189229301,
+  188937018,
+  188644290,
+  188351118,
+  188057503,
+  187763446,
+  187468946,
+  187174006,
+  186878625,
+  186582805,
+  186286545,
+  185989847,
+  185692711,
+  185395139,
+  185097130,
+  184798686,
+  184499806,
+  184200493,
+  183900746,
+  183600567,
+  183299955,
+  182998912,
+  182697439,
+  182395535,
+  182093203,
+  181790442,
+  181487253,
+  181183637,
+  180879594,
+  180575127,
+  180270234,
+  179964917,
+  179659176,
+  179353013,
+  179046428,
+  178739421,
+  178431994,
+  178124147,
+  177815881,
+  177507196,
+  177198094,
+  176888575,
+  176578639,
+  176268288,
+  175957522,
+  175646343,
+  175334749,
+  175022744,
+  174710326,
+  174397498,
+  174084258,
+  173770610,
+  173456552,
+  173142086,
+  172827213,
+  172511933,
+  172196248,
+  171880157,
+  171563661,
+  171246762,
+  170929460,
+  170611756,
+  170293650,
+  169975144,
+  169656237,
+  169336931,
+  169017227,
+  168697125,
+  168376627,
+  168055732,
+  167734441,
+  167412756,
+  167090677,
+  166768205,
+  166445340,
+  166122084,
+  165798436,
+  165474399,
+  165149972,
+  164825157,
+  164499953,
+  164174363,
+  163848386,
+  163522024,
+  163195277,
+  162868146,
+  162540632,
+  162212735,
+  161884457,
+  161555798,
+  161226758,
+  160897339,
+  160567542,
+  160237366,
+  159906814,
+  159575885,
+  159244581,
+  158912902,
+  158580849,
+  158248423,
+  157915625,
+  157582455,
+  157248914,
+  156915004,
+  156580724,
+  156246075,
+  155911059,
+  155575676,
+  155239927,
+  154903813,
+  154567334,
+  154230491,
+  153893286,
+  153555718,
+  153217789,
+  152879500,
+  152540851,
+  152201842,
+  151862476,
+  151522752,
+  151182672,
+  150842236,
+  150501445,
+  150160300,
+  149818802,
+  149476951,
+  149134748,
+  148792195,
+  148449291,
+  148106038,
+  147762436,
+  147418487,
+  147074191,
+  146729549,
+  146384561,
+  146039230,
+  145693554,
+  145347536,
+  145001175,
+  144654473,
+  144307431,
+  143960050,
+  143612330,
+  143264271,
+  142915876,
+  142567144,
+  142218077,
+  141868675,
+  141518940,
+  141168871,
+  140818470,
+  140467738,
+  140116675,
+  139765283,
+  139413562,
+  139061512,
+  138709136,
+  138356433,
+  138003404,
+  137650051,
+  137296374,
+  136942373,
+  136588051,
+  136233407,
+  135878442,
+  135523158,
+  135167555,
+  134811634,
+  134455396,
+  134098841,
+  133741970,
+  133384785,
+  133027287,
+  132669475,
+  132311350,
+  131952915,
+  131594169,
+  131235113,
+  130875749,
+  130516077,
+  130156097,
+  129795811,
+  129435220,
+  129074324,
+  128713125,
+  128351623,
+  127989818,
+  127627713,
+  127265307,
+  126902601,
+  126539598,
+  126176296,
+  125812697,
+  125448802,
+  125084613,
+  124720128,
+  124355351,
+  123990280,
+  123624918,
+  123259265,
+  122893322,
+  122527090,
+  122160570,
+  121793762,
+  121426667,
+  121059287,
+  120691622,
+  120323673,
+  119955440,
+  119586926,
+  119218130,
+  118849053,
+  118479697,
+  118110062,
+  117740150,
+  117369960,
+  116999493,
+  116628752,
+  116257736,
+  115886447,
+  115514885,
+  115143051,
+  114770946,
+  114398571,
+  114025927,
+  113653014,
+  113279835,
+  112906388,
+  112532676,
+  112158699,
+  111784458,
+  111409954,
+  111035188,
+  110660161,
+  110284873,
+  109909326,
+  109533520,
+  109157457,
+  108781136,
+  108404560,
+  108027729,
+  107650643,
+  107273304,
+  106895712,
+  106517869,
+  106139776,
+  105761432,
+  105382840,
+  105004000,
+  104624913,
+  104245579,
+  103866000,
+  103486177,
+  103106110,
+  102725801,
+  102345250,
+  101964458,
+  101583426,
+  101202156,
+  100820647,
+  100438900,
+  100056918,
+  99674700,
+  99292247,
+  98909561,
+  98526642,
+  98143491,
+  97760110,
+  97376498,
+  96992657,
+  96608588,
+  96224291,
+  95839768,
+  95455020,
+  95070047,
+  94684850,
+  94299431,
+  93913789,
+  93527927,
+  93141844,
+  92755543,
+  92369023,
+  91982285,
+  91595332,
+  91208162,
+  90820779,
+  90433181,
+  90045371,
+  89657348,
+  89269115,
+  88880672,
+  88492019,
+  88103159,
+  87714091,
+  87324816,
+  86935336,
+  86545652,
+  86155764,
+  85765673,
+  85375380,
+  84984887,
+  84594193,
+  84203301,
+  83812210,
+  83420922,
+  83029438,
+  82637758,
+  82245884,
+  81853816,
+  81461556,
+  81069104,
+  80676462,
+  80283629,
+  79890608,
+  79497398,
+  79104002,
+  78710419,
+  78316651,
+  77922699,
+  77528564,
+  77134246,
+  76739746,
+  76345066,
+  75950207,
+  75555168,
+  75159952,
+  74764559,
+  74368990,
+  73973246,
+  73577328,
+  73181237,
+  72784974,
+  72388539,
+  71991935,
+  71595160,
+  71198217,
+  70801107,
+  70403830,
+  70006387,
+  69608780,
+  69211009,
+  68813075,
+  68414979,
+  68016722,
+  67618305,
+  67219729,
+  66820995,
+  66422103,
+  66023056,
+  65623852,
+  65224495,
+  64824984,
+  64425320,
+  64025505,
+  63625539,
+  63225424,
+  62825159,
+  62424747,
+  62024188,
+  61623483,
+  61222633,
+  60821639,
+  60420502,
+  60019223,
+  59617802,
+  59216241,
+  58814541,
+  58412702,
+  58010726,
+  57608614,
+  57206365,
+  56803983,
+  56401466,
+  55998817,
+  55596036,
+  55193124,
+  54790083,
+  54386912,
+  53983614,
+  53580188,
+  53176637,
+  52772960,
+  52369159,
+  51965235,
+  51561188,
+  51157021,
+  50752733,
+  50348325,
+  49943799,
+  49539155,
+  49134395,
+  48729520,
+  48324529,
+  47919425,
+  47514208,
+  47108879,
+  46703440,
+  46297890,
+  45892232,
+  45486466,
+  45080592,
+  44674613,
+  44268528,
+  43862339,
+  43456047,
+  43049653,
+  42643158,
+  42236562,
+  41829866,
+  41423073,
+  41016182,
+  40609194,
+  40202111,
+  39794933,
+  39387661,
+  38980297,
+  38572841,
+  38165295,
+  37757658,
+  37349933,
+  36942120,
+  36534219,
+  36126233,
+  35718162,
+  35310007,
+  34901769,
+  34493448,
+  34085047,
+  33676565,
+  33268004,
+  32859365,
+  32450648,
+  32041855,
+  31632987,
+  31224044,
+  30815028,
+  30405939,
+  29996779,
+  29587548,
+  29178247,
+  28768878,
+  28359441,
+  27949938,
+  27540368,
+  27130734,
+  26721036,
+  26311275,
+  25901452,
+  25491569,
+  25081625,
+  24671622,
+  24261561,
+  23851443,
+  23441269,
+  23031040,
+  22620757,
+  22210420,
+  21800031,
+  21389591,
+  20979101,
+  20568561,
+  20157972,
+  19747337,
+  19336654,
+  18925927,
+  18515155,
+  18104339,
+  17693480,
+  17282580,
+  16871640,
+  16460659,
+  16049640,
+  15638583,
+  15227490,
+  14816360,
+  14405196,
+  13993997,
+  13582766,
+  13171503,
+  12760209,
+  12348885,
+  11937531,
+  11526150,
+  11114742,
+  10703307,
+  10291847,
+  9880363,
+  9468856,
+  9057326,
+  8645775,
+  8234204,
+  7822614,
+  7411005,
+  6999378,
+  6587735,
+  6176077,
+  5764404,
+  5352718,
+  4941018,
+  4529308,
+  4117586,
+  3705855,
+  3294115,
+  2882368,
+  2470614,
+  2058853,
+  1647088,
+  1235320,
+  823548,
+  411774,
+  0,
+  -411774,
+  -823548,
+  -1235320,
+  -1647088,
+  -2058853,
+  -2470614,
+  -2882368,
+  -3294115,
+  -3705855,
+  -4117586,
+  -4529308,
+  -4941018,
+  -5352718,
+  -5764404,
+  -6176077,
+  -6587735,
+  -6999378,
+  -7411005,
+  -7822614,
+  -8234204,
+  -8645775,
+  -9057326,
+  -9468856,
+  -9880363,
+  -10291847,
+  -10703307,
+  -11114742,
+  -11526150,
+  -11937531,
+  -12348885,
+  -12760209,
+  -13171503,
+  -13582766,
+  -13993997,
+  -14405196,
+  -14816360,
+  -15227490,
+  -15638583,
+  -16049640,
+  -16460659,
+  -16871640,
+  -17282580,
+  -17693480,
+  -18104339,
+  -18515155,
+  -18925927,
+  -19336654,
+  -19747337,
+  -20157972,
+  -20568561,
+  -20979101,
+  -21389591,
+  -21800031,
+  -22210420,
+  -22620757,
+  -23031040,
+  -23441269,
+  -23851443,
+  -24261561,
+  -24671622,
+  -25081625,
+  -25491569,
+  -25901452,
+  -26311275,
+  -26721036,
+  -27130734,
+  -27540368,
+  -27949938,
+  -28359441,
+  -28768878,
+  -29178247,
+  -29587548,
+  -29996779,
+  -30405939,
+  -30815028,
+  -31224044,
+  -31632987,
+  -32041855,
+  -32450648,
+  -32859365,
+  -33268004,
+  -33676565,
+  -34085047,
+  -34493448,
+  -34901769,
+  -35310007,
+  -35718162,
+  -36126233,
+  -36534219,
+  -36942120,
+  -37349933,
+  -37757658,
+  -38165295,
+  -38572841,
+  -38980297,
+  -39387661,
+  -39794933,
+  -40202111,
+  -40609194,
+  -41016182,
+  -41423073,
+  -41829866,
+  -42236562,
+  -42643158,
+  -43049653,
+  -43456047,
+  -43862339,
+  -44268528,
+  -44674613,
+  -45080592,
+  -45486466,
+  -45892232,
+  -46297890,
+  -46703440,
+  -47108879,
+  -47514208,
+  -47919425,
+  -48324529,
+  -48729520,
+  -49134395,
+  -49539155,
+  -49943799,
+  -50348325,
+  -50752733,
+  -51157021,
+  -51561188,
+  -51965235,
+  -52369159,
+  -52772960,
+  -53176637,
+  -53580188,
+  -53983614,
+  -54386912,
+  -54790083,
+  -55193124,
+  -55596036,
+  -55998817,
+  -56401466,
+  -56803983,
+  -57206365,
+  -57608614,
+  -58010726,
+  -58412702,
+  -58814541,
+  -59216241,
+  -59617802,
+  -60019223,
+  -60420502,
+  -60821639,
+  -61222633,
+  -61623483,
+  -62024188,
+  -62424747,
+  -62825159,
+  -63225424,
+  -63625539,
+  -64025505,
+  -64425320,
+  -64824984,
+  -65224495,
+  -65623852,
+  -66023056,
+  -66422103,
+  -66820995,
+  -67219729,
+  -67618305,
+  -68016722,
+  -68414979,
+  -68813075,
+  -69211009,
+  -69608780,
+  -70006387,
+  -70403830,
+  -70801107,
+  -71198217,
+  -71595160,
+  -71991935,
+  -72388539,
+  -72784974,
+  -73181237,
+  -73577328,
+  -73973246,
+  -74368990,
+  -74764559,
+  -75159952,
+  -75555168,
+  -75950207,
+  -76345066,
+  -76739746,
+  -77134246,
+  -77528564,
+  -77922699,
+  -78316651,
+  -78710419,
+  -79104002,
+  -79497398,
+  -79890608,
+  -80283629,
+  -80676462,
+  -81069104,
+  -81461556,
+  -81853816,
+  -82245884,
+  -82637758,
+  -83029438,
+  -83420922,
+  -83812210,
+  -84203301,
+  -84594193,
+  -84984887,
+  -85375380,
+  -85765673,
+  -86155764,
+  -86545652,
+  -86935336,
+  -87324816,
+  -87714091,
+  -88103159,
+  -88492019,
+  -88880672,
+  -89269115,
+  -89657348,
+  -90045371,
+  -90433181,
+  -90820779,
+  -91208162,
+  -91595332,
+  -91982285,
+  -92369023,
+  -92755543,
+  -93141844,
+  -93527927,
+  -93913789,
+  -94299431,
+  -94684850,
+  -95070047,
+  -95455020,
+  -95839768,
+  -96224291,
+  -96608588,
+  -96992657,
+  -97376498,
+  -97760110,
+  -98143491,
+  -98526642,
+  -98909561,
+  -99292247,
+  -99674700,
+  -100056918,
+  -100438900,
+  -100820647,
+  -101202156,
+  -101583426,
+  -101964458,
+  -102345250,
+  -102725801,
+  -103106110,
+  -103486177,
+  -103866000,
+  -104245579,
+  -104624913,
+  -105004000,
+  -105382840,
+  -105761432,
+  -106139776,
+  -106517869,
+  -106895712,
+  -107273304,
+  -107650643,
+  -108027729,
+  -108404560,
+  -108781136,
+  -109157457,
+  -109533520,
+  -109909326,
+  -110284873,
+  -110660161,
+  -111035188,
+  -111409954,
+  -111784458,
+  -112158699,
+  -112532676,
+  -112906388,
+  -113279835,
+  -113653014,
+  -114025927,
+  -114398571,
+  -114770946,
+  -115143051,
+  -115514885,
+  -115886447,
+  -116257736,
+  -116628752,
+  -116999493,
+  -117369960,
+  -117740150,
+  -118110062,
+  -118479697,
+  -118849053,
+  -119218130,
+  -119586926,
+  -119955440,
+  -120323673,
+  -120691622,
+  -121059287,
+  -121426667,
+  -121793762,
+  -122160570,
+  -122527090,
+  -122893322,
+  -123259265,
+  -123624918,
+  -123990280,
+  -124355351,
+  -124720128,
+  -125084613,
+  -125448802,
+  -125812697,
+  -126176296,
+  -126539598,
+  -126902601,
+  -127265307,
+  -127627713,
+  -127989818,
+  -128351623,
+  -128713125,
+  -129074324,
+  -129435220,
+  -129795811,
+  -130156097,
+  -130516077,
+  -130875749,
+  -131235113,
+  -131594169,
+  -131952915,
+  -132311350,
+  -132669475,
+  -133027287,
+  -133384785,
+  -133741970,
+  -134098841,
+  -134455396,
+  -134811634,
+  -135167555,
+  -135523158,
+  -135878442,
+  -136233407,
+  -136588051,
+  -136942373,
+  -137296374,
+  -137650051,
+  -138003404,
+  -138356433,
+  -138709136,
+  -139061512,
+  -139413562,
+  -139765283,
+  -140116675,
+  -140467738,
+  -140818470,
+  -141168871,
+  -141518940,
+  -141868675,
+  -142218077,
+  -142567144,
+  -142915876,
+  -143264271,
+  -143612330,
+  -143960050,
+  -144307431,
+  -144654473,
+  -145001175,
+  -145347536,
+  -145693554,
+  -146039230,
+  -146384561,
+  -146729549,
+  -147074191,
+  -147418487,
+  -147762436,
+  -148106038,
+  -148449291,
+  -148792195,
+  -149134748,
+  -149476951,
+  -149818802,
+  -150160300,
+  -150501445,
+  -150842236,
+  -151182672,
+  -151522752,
+  -151862476,
+  -152201842,
+  -152540851,
+  -152879500,
+  -153217789,
+  -153555718,
+  -153893286,
+  -154230491,
+  -154567334,
+  -154903813,
+  -155239927,
+  -155575676,
+  -155911059,
+  -156246075,
+  -156580724,
+  -156915004,
+  -157248914,
+  -157582455,
+  -157915625,
+  -158248423,
+  -158580849,
+  -158912902,
+  -159244581,
+  -159575885,
+  -159906814,
+  -160237366,
+  -160567542,
+  -160897339,
+  -161226758,
+  -161555798,
+  -161884457,
+  -162212735,
+  -162540632,
+  -162868146,
+  -163195277,
+  -163522024,
+  -163848386,
+  -164174363,
+  -164499953,
+  -164825157,
+  -165149972,
+  -165474399,
+  -165798436,
+  -166122084,
+  -166445340,
+  -166768205,
+  -167090677,
+  -167412756,
+  -167734441,
+  -168055732,
+  -168376627,
+  -168697125,
+  -169017227,
+  -169336931,
+  -169656237,
+  -169975144,
+  -170293650,
+  -170611756,
+  -170929460,
+  -171246762,
+  -171563661,
+  -171880157,
+  -172196248,
+  -172511933,
+  -172827213,
+  -173142086,
+  -173456552,
+  -173770610,
+  -174084258,
+  -174397498,
+  -174710326,
+  -175022744,
+  -175334749,
+  -175646343,
+  -175957522,
+  -176268288,
+  -176578639,
+  -176888575,
+  -177198094,
+  -177507196,
+  -177815881,
+  -178124147,
+  -178431994,
+  -178739421,
+  -179046428,
+  -179353013,
+  -179659176,
+  -179964917,
+  -180270234,
+  -180575127,
+  -180879594,
+  -181183637,
+  -181487253,
+  -181790442,
+  -182093203,
+  -182395535,
+  -182697439,
+  -182998912,
+  -183299955,
+  -183600567,
+  -183900746,
+  -184200493,
+  -184499806,
+  -184798686,
+  -185097130,
+  -185395139,
+  -185692711,
+  -185989847,
+  -186286545,
+  -186582805,
+  -186878625,
+  -187174006,
+  -187468946,
+  -187763446,
+  -188057503,
+  -188351118,
+  -188644290,
+  -188937018,
+  -189229301,
+  -189521139,
+  -189812531,
+  -190103476,
+  -190393974,
+  -190684024,
+  -190973625,
+  -191262777,
+  -191551479,
+  -191839730,
+  -192127530,
+  -192414878,
+  -192701772,
+  -192988214,
+  -193274201,
+  -193559734,
+  -193844811,
+  -194129431,
+  -194413595,
+  -194697302,
+  -194980551,
+  -195263340,
+  -195545670,
+  -195827540,
+  -196108950,
+  -196389897,
+  -196670383,
+  -196950406,
+  -197229965,
+  -197509061,
+  -197787691,
+  -198065856,
+  -198343555,
+  -198620788,
+  -198897553,
+  -199173850,
+  -199449678,
+  -199725037,
+  -199999926,
+  -200274344,
+  -200548291,
+  -200821767,
+  -201094769,
+  -201367299,
+  -201639354,
+  -201910935,
+  -202182041,
+  -202452672,
+  -202722825,
+  -202992502,
+  -203261701,
+  -203530422,
+  -203798664,
+  -204066427,
+  -204333709,
+  -204600510,
+  -204866830,
+  -205132668,
+  -205398023,
+  -205662895,
+  -205927283,
+  -206191186,
+  -206454605,
+  -206717537,
+  -206979983,
+  -207241942,
+  -207503413,
+  -207764396,
+  -208024890,
+  -208284895,
+  -208544409,
+  -208803433,
+  -209061965,
+  -209320006,
+  -209577553,
+  -209834608,
+  -210091169,
+  -210347236,
+  -210602807,
+  -210857883,
+  -211112463,
+  -211366547,
+  -211620132,
+  -211873220,
+  -212125809,
+  -212377899,
+  -212629490,
+  -212880580,
+  -213131169,
+  -213381256,
+  -213630842,
+  -213879925,
+  -214128504,
+  -214376580,
+  -214624151,
+  -214871217,
+  -215117778,
+  -215363832,
+  -215609379,
+  -215854420,
+  -216098952,
+  -216342976,
+  -216586490,
+  -216829496,
+  -217071990,
+  -217313974,
+  -217555447,
+  -217796408,
+  -218036856,
+  -218276791,
+  -218516213,
+  -218755120,
+  -218993513,
+  -219231390,
+  -219468752,
+  -219705597,
+  -219941925,
+  -220177735,
+  -220413028,
+  -220647801,
+  -220882056,
+  -221115791,
+  -221349005,
+  -221581699,
+  -221813871,
+  -222045521,
+  -222276649,
+  -222507254,
+  -222737335,
+  -222966892,
+  -223195924,
+  -223424431,
+  -223652413,
+  -223879868,
+  -224106796,
+  -224333197,
+  -224559070,
+  -224784415,
+  -225009231,
+  -225233517,
+  -225457273,
+  -225680499,
+  -225903194,
+  -226125357,
+  -226346988,
+  -226568086,
+  -226788652,
+  -227008683,
+  -227228181,
+  -227447143,
+  -227665571,
+  -227883463,
+  -228100818,
+  -228317637,
+  -228533919,
+  -228749663,
+  -228964868,
+  -229179535,
+  -229393663,
+  -229607251,
+  -229820298,
+  -230032805,
+  -230244770,
+  -230456194,
+  -230667075,
+  -230877413,
+  -231087209,
+  -231296460,
+  -231505167,
+  -231713330,
+  -231920947,
+  -232128019,
+  -232334544,
+  -232540522,
+  -232745954,
+  -232950837,
+  -233155173,
+  -233358960,
+  -233562198,
+  -233764886,
+  -233967024,
+  -234168612,
+  -234369648,
+  -234570133,
+  -234770066,
+  -234969447,
+  -235168275,
+  -235366549,
+  -235564270,
+  -235761436,
+  -235958047,
+  -236154104,
+  -236349604,
+  -236544548,
+  -236738936,
+  -236932767,
+  -237126040,
+  -237318755,
+  -237510912,
+  -237702510,
+  -237893548,
+  -238084027,
+  -238273946,
+  -238463304,
+  -238652100,
+  -238840335,
+  -239028009,
+  -239215119,
+  -239401667,
+  -239587651,
+  -239773072,
+  -239957929,
+  -240142220,
+  -240325947,
+  -240509108,
+  -240691704,
+  -240873733,
+  -241055195,
+  -241236089,
+  -241416417,
+  -241596176,
+  -241775367,
+  -241953988,
+  -242132041,
+  -242309523,
+  -242486436,
+  -242662778,
+  -242838548,
+  -243013748,
+  -243188375,
+  -243362431,
+  -243535914,
+  -243708823,
+  -243881159,
+  -244052922,
+  -244224110,
+  -244394723,
+  -244564761,
+  -244734224,
+  -244903111,
+  -245071421,
+  -245239155,
+  -245406312,
+  -245572892,
+  -245738893,
+  -245904316,
+  -246069161,
+  -246233427,
+  -246397113,
+  -246560219,
+  -246722745,
+  -246884691,
+  -247046056,
+  -247206839,
+  -247367041,
+  -247526660,
+  -247685698,
+  -247844152,
+  -248002023,
+  -248159311,
+  -248316014,
+  -248472134,
+  -248627668,
+  -248782618,
+  -248936982,
+  -249090760,
+  -249243953,
+  -249396558,
+  -249548577,
+  -249700009,
+  -249850853,
+  -250001109,
+  -250150777,
+  -250299857,
+  -250448347,
+  -250596248,
+  -250743559,
+  -250890281,
+  -251036411,
+  -251181952,
+  -251326901,
+  -251471259,
+  -251615025,
+  -251758199,
+  -251900780,
+  -252042769,
+  -252184165,
+  -252324967,
+  -252465175,
+  -252604790,
+  -252743810,
+  -252882235,
+  -253020066,
+  -253157301,
+  -253293940,
+  -253429983,
+  -253565430,
+  -253700280,
+  -253834533,
+  -253968189,
+  -254101247,
+  -254233708,
+  -254365570,
+  -254496833,
+  -254627498,
+  -254757564,
+  -254887030,
+  -255015896,
+  -255144162,
+  -255271828,
+  -255398893,
+  -255525357,
+  -255651220,
+  -255776482,
+  -255901141,
+  -256025198,
+  -256148653,
+  -256271505,
+  -256393755,
+  -256515400,
+  -256636443,
+  -256756881,
+  -256876715,
+  -256995945,
+  -257114569,
+  -257232589,
+  -257350004,
+  -257466813,
+  -257583016,
+  -257698613,
+  -257813604,
+  -257927988,
+  -258041765,
+  -258154935,
+  -258267497,
+  -258379452,
+  -258490799,
+  -258601537,
+  -258711667,
+  -258821188,
+  -258930101,
+  -259038403,
+  -259146097,
+  -259253180,
+  -259359654,
+  -259465517,
+  -259570769,
+  -259675411,
+  -259779442,
+  -259882862,
+  -259985670,
+  -260087866,
+  -260189450,
+  -260290422,
+  -260390781,
+  -260490528,
+  -260589662,
+  -260688182,
+  -260786089,
+  -260883383,
+  -260980063,
+  -261076128,
+  -261171579,
+  -261266416,
+  -261360638,
+  -261454244,
+  -261547236,
+  -261639612,
+  -261731373,
+  -261822517,
+  -261913046,
+  -262002958,
+  -262092254,
+  -262180932,
+  -262268994,
+  -262356439,
+  -262443267,
+  -262529477,
+  -262615069,
+  -262700043,
+  -262784399,
+  -262868137,
+  -262951256,
+  -263033757,
+  -263115638,
+  -263196900,
+  -263277543,
+  -263357567,
+  -263436971,
+  -263515755,
+  -263593918,
+  -263671462,
+  -263748385,
+  -263824688,
+  -263900369,
+  -263975430,
+  -264049870,
+  -264123688,
+  -264196884,
+  -264269459,
+  -264341413,
+  -264412744,
+  -264483453,
+  -264553539,
+  -264623003,
+  -264691845,
+  -264760063,
+  -264827659,
+  -264894631,
+  -264960980,
+  -265026706,
+  -265091808,
+  -265156286,
+  -265220140,
+  -265283370,
+  -265345976,
+  -265407958,
+  -265469315,
+  -265530047,
+  -265590155,
+  -265649637,
+  -265708494,
+  -265766727,
+  -265824333,
+  -265881315,
+  -265937670,
+  -265993400,
+  -266048504,
+  -266102982,
+  -266156834,
+  -266210059,
+  -266262659,
+  -266314631,
+  -266365977,
+  -266416696,
+  -266466788,
+  -266516253,
+  -266565091,
+  -266613302,
+  -266660885,
+  -266707841,
+  -266754170,
+  -266799870,
+  -266844943,
+  -266889388,
+  -266933205,
+  -266976394,
+  -267018954,
+  -267060886,
+  -267102190,
+  -267142865,
+  -267182912,
+  -267222330,
+  -267261119,
+  -267299279,
+  -267336811,
+  -267373713,
+  -267409986,
+  -267445630,
+  -267480644,
+  -267515029,
+  -267548785,
+  -267581911,
+  -267614407,
+  -267646274,
+  -267677511,
+  -267708118,
+  -267738095,
+  -267767442,
+  -267796159,
+  -267824246,
+  -267851702,
+  -267878529,
+  -267904725,
+  -267930290,
+  -267955225,
+  -267979530,
+  -268003204,
+  -268026247,
+  -268048660,
+  -268070442,
+  -268091593,
+  -268112113,
+  -268132003,
+  -268151261,
+  -268169889,
+  -268187885,
+  -268205250,
+  -268221985,
+  -268238088,
+  -268253559,
+  -268268400,
+  -268282610,
+  -268296188,
+  -268309134,
+  -268321450,
+  -268333134,
+  -268344187,
+  -268354608,
+  -268364397,
+  -268373556,
+  -268382082,
+  -268389978,
+  -268397241,
+  -268403873,
+  -268409874,
+  -268415243,
+  -268419980,
+  -268424086,
+  -268427560,
+  -268430402,
+  -268432613,
+  -268434192,
+  -268435140,
+  -268435456,
+  -268435140,
+  -268434192,
+  -268432613,
+  -268430402,
+  -268427560,
+  -268424086,
+  -268419980,
+  -268415243,
+  -268409874,
+  -268403873,
+  -268397241,
+  -268389978,
+  -268382082,
+  -268373556,
+  -268364397,
+  -268354608,
+  -268344187,
+  -268333134,
+  -268321450,
+  -268309134,
+  -268296188,
+  -268282610,
+  -268268400,
+  -268253559,
+  -268238088,
+  -268221985,
+  -268205250,
+  -268187885,
+  -268169889,
+  -268151261,
+  -268132003,
+  -268112113,
+  -268091593,
+  -268070442,
+  -268048660,
+  -268026247,
+  -268003204,
+  -267979530,
+  -267955225,
+  -267930290,
+  -267904725,
+  -267878529,
+  -267851702,
+  -267824246,
+  -267796159,
+  -267767442,
+  -267738095,
+  -267708118,
+  -267677511,
+  -267646274,
+  -267614407,
+  -267581911,
+  -267548785,
+  -267515029,
+  -267480644,
+  -267445630,
+  -267409986,
+  -267373713,
+  -267336811,
+  -267299279,
+  -267261119,
+  -267222330,
+  -267182912,
+  -267142865,
+  -267102190,
+  -267060886,
+  -267018954,
+  -266976394,
+  -266933205,
+  -266889388,
+  -266844943,
+  -266799870,
+  -266754170,
+  -266707841,
+  -266660885,
+  -266613302,
+  -266565091,
+  -266516253,
+  -266466788,
+  -266416696,
+  -266365977,
+  -266314631,
+  -266262659,
+  -266210059,
+  -266156834,
+  -266102982,
+  -266048504,
+  -265993400,
+  -265937670,
+  -265881315,
+  -265824333,
+  -265766727,
+  -265708494,
+  -265649637,
+  -265590155,
+  -265530047,
+  -265469315,
+  -265407958,
+  -265345976,
+  -265283370,
+  -265220140,
+  -265156286,
+  -265091808,
+  -265026706,
+  -264960980,
+  -264894631,
+  -264827659,
+  -264760063,
+  -264691845,
+  -264623003,
+  -264553539,
+  -264483453,
+  -264412744,
+  -264341413,
+  -264269459,
+  -264196884,
+  -264123688,
+  -264049870,
+  -263975430,
+  -263900369,
+  -263824688,
+  -263748385,
+  -263671462,
+  -263593918,
+  -263515755,
+  -263436971,
+  -263357567,
+  -263277543,
+  -263196900,
+  -263115638,
+  -263033757,
+  -262951256,
+  -262868137,
+  -262784399,
+  -262700043,
+  -262615069,
+  -262529477,
+  -262443267,
+  -262356439,
+  -262268994,
+  -262180932,
+  -262092254,
+  -262002958,
+  -261913046,
+  -261822517,
+  -261731373,
+  -261639612,
+  -261547236,
+  -261454244,
+  -261360638,
+  -261266416,
+  -261171579,
+  -261076128,
+  -260980063,
+  -260883383,
+  -260786089,
+  -260688182,
+  -260589662,
+  -260490528,
+  -260390781,
+  -260290422,
+  -260189450,
+  -260087866,
+  -259985670,
+  -259882862,
+  -259779442,
+  -259675411,
+  -259570769,
+  -259465517,
+  -259359654,
+  -259253180,
+  -259146097,
+  -259038403,
+  -258930101,
+  -258821188,
+  -258711667,
+  -258601537,
+  -258490799,
+  -258379452,
+  -258267497,
+  -258154935,
+  -258041765,
+  -257927988,
+  -257813604,
+  -257698613,
+  -257583016,
+  -257466813,
+  -257350004,
+  -257232589,
+  -257114569,
+  -256995945,
+  -256876715,
+  -256756881,
+  -256636443,
+  -256515400,
+  -256393755,
+  -256271505,
+  -256148653,
+  -256025198,
+  -255901141,
+  -255776482,
+  -255651220,
+  -255525357,
+  -255398893,
+  -255271828,
+  -255144162,
+  -255015896,
+  -254887030,
+  -254757564,
+  -254627498,
+  -254496833,
+  -254365570,
+  -254233708,
+  -254101247,
+  -253968189,
+  -253834533,
+  -253700280,
+  -253565430,
+  -253429983,
+  -253293940,
+  -253157301,
+  -253020066,
+  -252882235,
+  -252743810,
+  -252604790,
+  -252465175,
+  -252324967,
+  -252184165,
+  -252042769,
+  -251900780,
+  -251758199,
+  -251615025,
+  -251471259,
+  -251326901,
+  -251181952,
+  -251036411,
+  -250890281,
+  -250743559,
+  -250596248,
+  -250448347,
+  -250299857,
+  -250150777,
+  -250001109,
+  -249850853,
+  -249700009,
+  -249548577,
+  -249396558,
+  -249243953,
+  -249090760,
+  -248936982,
+  -248782618,
+  -248627668,
+  -248472134,
+  -248316014,
+  -248159311,
+  -248002023,
+  -247844152,
+  -247685698,
+  -247526660,
+  -247367041,
+  -247206839,
+  -247046056,
+  -246884691,
+  -246722745,
+  -246560219,
+  -246397113,
+  -246233427,
+  -246069161,
+  -245904316,
+  -245738893,
+  -245572892,
+  -245406312,
+  -245239155,
+  -245071421,
+  -244903111,
+  -244734224,
+  -244564761,
+  -244394723,
+  -244224110,
+  -244052922,
+  -243881159,
+  -243708823,
+  -243535914,
+  -243362431,
+  -243188375,
+  -243013748,
+  -242838548,
+  -242662778,
+  -242486436,
+  -242309523,
+  -242132041,
+  -241953988,
+  -241775367,
+  -241596176,
+  -241416417,
+  -241236089,
+  -241055195,
+  -240873733,
+  -240691704,
+  -240509108,
+  -240325947,
+  -240142220,
+  -239957929,
+  -239773072,
+  -239587651,
+  -239401667,
+  -239215119,
+  -239028009,
+  -238840335,
+  -238652100,
+  -238463304,
+  -238273946,
+  -238084027,
+  -237893548,
+  -237702510,
+  -237510912,
+  -237318755,
+  -237126040,
+  -236932767,
+  -236738936,
+  -236544548,
+  -236349604,
+  -236154104,
+  -235958047,
+  -235761436,
+  -235564270,
+  -235366549,
+  -235168275,
+  -234969447,
+  -234770066,
+  -234570133,
+  -234369648,
+  -234168612,
+  -233967024,
+  -233764886,
+  -233562198,
+  -233358960,
+  -233155173,
+  -232950837,
+  -232745954,
+  -232540522,
+  -232334544,
+  -232128019,
+  -231920947,
+  -231713330,
+  -231505167,
+  -231296460,
+  -231087209,
+  -230877413,
+  -230667075,
+  -230456194,
+  -230244770,
+  -230032805,
+  -229820298,
+  -229607251,
+  -229393663,
+  -229179535,
+  -228964868,
+  -228749663,
+  -228533919,
+  -228317637,
+  -228100818,
+  -227883463,
+  -227665571,
+  -227447143,
+  -227228181,
+  -227008683,
+  -226788652,
+  -226568086,
+  -226346988,
+  -226125357,
+  -225903194,
+  -225680499,
+  -225457273,
+  -225233517,
+  -225009231,
+  -224784415,
+  -224559070,
+  -224333197,
+  -224106796,
+  -223879868,
+  -223652413,
+  -223424431,
+  -223195924,
+  -222966892,
+  -222737335,
+  -222507254,
+  -222276649,
+  -222045521,
+  -221813871,
+  -221581699,
+  -221349005,
+  -221115791,
+  -220882056,
+  -220647801,
+  -220413028,
+  -220177735,
+  -219941925,
+  -219705597,
+  -219468752,
+  -219231390,
+  -218993513,
+  -218755120,
+  -218516213,
+  -218276791,
+  -218036856,
+  -217796408,
+  -217555447,
+  -217313974,
+  -217071990,
+  -216829496,
+  -216586490,
+  -216342976,
+  -216098952,
+  -215854420,
+  -215609379,
+  -215363832,
+  -215117778,
+  -214871217,
+  -214624151,
+  -214376580,
+  -214128504,
+  -213879925,
+  -213630842,
+  -213381256,
+  -213131169,
+  -212880580,
+  -212629490,
+  -212377899,
+  -212125809,
+  -211873220,
+  -211620132,
+  -211366547,
+  -211112463,
+  -210857883,
+  -210602807,
+  -210347236,
+  -210091169,
+  -209834608,
+  -209577553,
+  -209320006,
+  -209061965,
+  -208803433,
+  -208544409,
+  -208284895,
+  -208024890,
+  -207764396,
+  -207503413,
+  -207241942,
+  -206979983,
+  -206717537,
+  -206454605,
+  -206191186,
+  -205927283,
+  -205662895,
+  -205398023,
+  -205132668,
+  -204866830,
+  -204600510,
+  -204333709,
+  -204066427,
+  -203798664,
+  -203530422,
+  -203261701,
+  -202992502,
+  -202722825,
+  -202452672,
+  -202182041,
+  -201910935,
+  -201639354,
+  -201367299,
+  -201094769,
+  -200821767,
+  -200548291,
+  -200274344,
+  -199999926,
+  -199725037,
+  -199449678,
+  -199173850,
+  -198897553,
+  -198620788,
+  -198343555,
+  -198065856,
+  -197787691,
+  -197509061,
+  -197229965,
+  -196950406,
+  -196670383,
+  -196389897,
+  -196108950,
+  -195827540,
+  -195545670,
+  -195263340,
+  -194980551,
+  -194697302,
+  -194413595,
+  -194129431,
+  -193844811,
+  -193559734,
+  -193274201,
+  -192988214,
+  -192701772,
+  -192414878,
+  -192127530,
+  -191839730,
+  -191551479,
+  -191262777,
+  -190973625,
+  -190684024,
+  -190393974,
+  -190103476,
+  -189812531,
+  -189521139,
+  -189229301,
+  -188937018,
+  -188644290,
+  -188351118,
+  -188057503,
+  -187763446,
+  -187468946,
+  -187174006,
+  -186878625,
+  -186582805,
+  -186286545,
+  -185989847,
+  -185692711,
+  -185395139,
+  -185097130,
+  -184798686,
+  -184499806,
+  -184200493,
+  -183900746,
+  -183600567,
+  -183299955,
+  -182998912,
+  -182697439,
+  -182395535,
+  -182093203,
+  -181790442,
+  -181487253,
+  -181183637,
+  -180879594,
+  -180575127,
+  -180270234,
+  -179964917,
+  -179659176,
+  -179353013,
+  -179046428,
+  -178739421,
+  -178431994,
+  -178124147,
+  -177815881,
+  -177507196,
+  -177198094,
+  -176888575,
+  -176578639,
+  -176268288,
+  -175957522,
+  -175646343,
+  -175334749,
+  -175022744,
+  -174710326,
+  -174397498,
+  -174084258,
+  -173770610,
+  -173456552,
+  -173142086,
+  -172827213,
+  -172511933,
+  -172196248,
+  -171880157,
+  -171563661,
+  -171246762,
+  -170929460,
+  -170611756,
+  -170293650,
+  -169975144,
+  -169656237,
+  -169336931,
+  -169017227,
+  -168697125,
+  -168376627,
+  -168055732,
+  -167734441,
+  -167412756,
+  -167090677,
+  -166768205,
+  -166445340,
+  -166122084,
+  -165798436,
+  -165474399,
+  -165149972,
+  -164825157,
+  -164499953,
+  -164174363,
+  -163848386,
+  -163522024,
+  -163195277,
+  -162868146,
+  -162540632,
+  -162212735,
+  -161884457,
+  -161555798,
+  -161226758,
+  -160897339,
+  -160567542,
+  -160237366,
+  -159906814,
+  -159575885,
+  -159244581,
+  -158912902,
+  -158580849,
+  -158248423,
+  -157915625,
+  -157582455,
+  -157248914,
+  -156915004,
+  -156580724,
+  -156246075,
+  -155911059,
+  -155575676,
+  -155239927,
+  -154903813,
+  -154567334,
+  -154230491,
+  -153893286,
+  -153555718,
+  -153217789,
+  -152879500,
+  -152540851,
+  -152201842,
+  -151862476,
+  -151522752,
+  -151182672,
+  -150842236,
+  -150501445,
+  -150160300,
+  -149818802,
+  -149476951,
+  -149134748,
+  -148792195,
+  -148449291,
+  -148106038,
+  -147762436,
+  -147418487,
+  -147074191,
+  -146729549,
+  -146384561,
+  -146039230,
+  -145693554,
+  -145347536,
+  -145001175,
+  -144654473,
+  -144307431,
+  -143960050,
+  -143612330,
+  -143264271,
+  -142915876,
+  -142567144,
+  -142218077,
+  -141868675,
+  -141518940,
+  -141168871,
+  -140818470,
+  -140467738,
+  -140116675,
+  -139765283,
+  -139413562,
+  -139061512,
+  -138709136,
+  -138356433,
+  -138003404,
+  -137650051,
+  -137296374,
+  -136942373,
+  -136588051,
+  -136233407,
+  -135878442,
+  -135523158,
+  -135167555,
+  -134811634,
+  -134455396,
+  -134098841,
+  -133741970,
+  -133384785,
+  -133027287,
+  -132669475,
+  -132311350,
+  -131952915,
+  -131594169,
+  -131235113,
+  -130875749,
+  -130516077,
+  -130156097,
+  -129795811,
+  -129435220,
+  -129074324,
+  -128713125,
+  -128351623,
+  -127989818,
+  -127627713,
+  -127265307,
+  -126902601,
+  -126539598,
+  -126176296,
+  -125812697,
+  -125448802,
+  -125084613,
+  -124720128,
+  -124355351,
+  -123990280,
+  -123624918,
+  -123259265,
+  -122893322,
+  -122527090,
+  -122160570,
+  -121793762,
+  -121426667,
+  -121059287,
+  -120691622,
+  -120323673,
+  -119955440,
+  -119586926,
+  -119218130,
+  -118849053,
+  -118479697,
+  -118110062,
+  -117740150,
+  -117369960,
+  -116999493,
+  -116628752,
+  -116257736,
+  -115886447,
+  -115514885,
+  -115143051,
+  -114770946,
+  -114398571,
+  -114025927,
+  -113653014,
+  -113279835,
+  -112906388,
+  -112532676,
+  -112158699,
+  -111784458,
+  -111409954,
+  -111035188,
+  -110660161,
+  -110284873,
+  -109909326,
+  -109533520,
+  -109157457,
+  -108781136,
+  -108404560,
+  -108027729,
+  -107650643,
+  -107273304,
+  -106895712,
+  -106517869,
+  -106139776,
+  -105761432,
+  -105382840,
+  -105004000,
+  -104624913,
+  -104245579,
+  -103866000,
+  -103486177,
+  -103106110,
+  -102725801,
+  -102345250,
+  -101964458,
+  -101583426,
+  -101202156,
+  -100820647,
+  -100438900,
+  -100056918,
+  -99674700,
+  -99292247,
+  -98909561,
+  -98526642,
+  -98143491,
+  -97760110,
+  -97376498,
+  -96992657,
+  -96608588,
+  -96224291,
+  -95839768,
+  -95455020,
+  -95070047,
+  -94684850,
+  -94299431,
+  -93913789,
+  -93527927,
+  -93141844,
+  -92755543,
+  -92369023,
+  -91982285,
+  -91595332,
+  -91208162,
+  -90820779,
+  -90433181,
+  -90045371,
+  -89657348,
+  -89269115,
+  -88880672,
+  -88492019,
+  -88103159,
+  -87714091,
+  -87324816,
+  -86935336,
+  -86545652,
+  -86155764,
+  -85765673,
+  -85375380,
+  -84984887,
+  -84594193,
+  -84203301,
+  -83812210,
+  -83420922,
+  -83029438,
+  -82637758,
+  -82245884,
+  -81853816,
+  -81461556,
+  -81069104,
+  -80676462,
+  -80283629,
+  -79890608,
+  -79497398,
+  -79104002,
+  -78710419,
+  -78316651,
+  -77922699,
+  -77528564,
+  -77134246,
+  -76739746,
+  -76345066,
+  -75950207,
+  -75555168,
+  -75159952,
+  -74764559,
+  -74368990,
+  -73973246,
+  -73577328,
+  -73181237,
+  -72784974,
+  -72388539,
+  -71991935,
+  -71595160,
+  -71198217,
+  -70801107,
+  -70403830,
+  -70006387,
+  -69608780,
+  -69211009,
+  -68813075,
+  -68414979,
+  -68016722,
+  -67618305,
+  -67219729,
+  -66820995,
+  -66422103,
+  -66023056,
+  -65623852,
+  -65224495,
+  -64824984,
+  -64425320,
+  -64025505,
+  -63625539,
+  -63225424,
+  -62825159,
+  -62424747,
+  -62024188,
+  -61623483,
+  -61222633,
+  -60821639,
+  -60420502,
+  -60019223,
+  -59617802,
+  -59216241,
+  -58814541,
+  -58412702,
+  -58010726,
+  -57608614,
+  -57206365,
+  -56803983,
+  -56401466,
+  -55998817,
+  -55596036,
+  -55193124,
+  -54790083,
+  -54386912,
+  -53983614,
+  -53580188,
+  -53176637,
+  -52772960,
+  -52369159,
+  -51965235,
+  -51561188,
+  -51157021,
+  -50752733,
+  -50348325,
+  -49943799,
+  -49539155,
+  -49134395,
+  -48729520,
+  -48324529,
+  -47919425,
+  -47514208,
+  -47108879,
+  -46703440,
+  -46297890,
+  -45892232,
+  -45486466,
+  -45080592,
+  -44674613,
+  -44268528,
+  -43862339,
+  -43456047,
+  -43049653,
+  -42643158,
+  -42236562,
+  -41829866,
+  -41423073,
+  -41016182,
+  -40609194,
+  -40202111,
+  -39794933,
+  -39387661,
+  -38980297,
+  -38572841,
+  -38165295,
+  -37757658,
+  -37349933,
+  -36942120,
+  -36534219,
+  -36126233,
+  -35718162,
+  -35310007,
+  -34901769,
+  -34493448,
+  -34085047,
+  -33676565,
+  -33268004,
+  -32859365,
+  -32450648,
+  -32041855,
+  -31632987,
+  -31224044,
+  -30815028,
+  -30405939,
+  -29996779,
+  -29587548,
+  -29178247,
+  -28768878,
+  -28359441,
+  -27949938,
+  -27540368,
+  -27130734,
+  -26721036,
+  -26311275,
+  -25901452,
+  -25491569,
+  -25081625,
+  -24671622,
+  -24261561,
+  -23851443,
+  -23441269,
+  -23031040,
+  -22620757,
+  -22210420,
+  -21800031,
+  -21389591,
+  -20979101,
+  -20568561,
+  -20157972,
+  -19747337,
+  -19336654,
+  -18925927,
+  -18515155,
+  -18104339,
+  -17693480,
+  -17282580,
+  -16871640,
+  -16460659,
+  -16049640,
+  -15638583,
+  -15227490,
+  -14816360,
+  -14405196,
+  -13993997,
+  -13582766,
+  -13171503,
+  -12760209,
+  -12348885,
+  -11937531,
+  -11526150,
+  -11114742,
+  -10703307,
+  -10291847,
+  -9880363,
+  -9468856,
+  -9057326,
+  -8645775,
+  -8234204,
+  -7822614,
+  -7411005,
+  -6999378,
+  -6587735,
+  -6176077,
+  -5764404,
+  -5352718,
+  -4941018,
+  -4529308,
+  -4117586,
+  -3705855,
+  -3294115,
+  -2882368,
+  -2470614,
+  -2058853,
+  -1647088,
+  -1235320,
+  -823548,
+  -411774,
+#else
+const fixed SINETABLE[4096] = {
+  fixed(0.00000000000000000000e+00),
+  fixed(1.53398018628476550014e-03),
+  fixed(3.06795676296597614324e-03),
+  fixed(4.60192612044857049525e-03),
+  fixed(6.13588464915447526909e-03),
+  fixed(7.66982873953109701298e-03),
+  fixed(9.20375478205981943647e-03),
+  fixed(1.07376591672644905451e-02),
+  fixed(1.22715382857199253874e-02),
+  fixed(1.38053885280603905877e-02),
+  fixed(1.53392062849881001541e-02),
+  fixed(1.68729879472817104191e-02),
+  fixed(1.84067299058048201854e-02),
+  fixed(1.99404285515144413798e-02),
+  fixed(2.14740802754695078725e-02),
+  fixed(2.30076814688393686825e-02),
+  fixed(2.45412285229122881236e-02),
+  fixed(2.60747178291039008458e-02),
+  fixed(2.76081457789657397361e-02),
+  fixed(2.91415087641937221863e-02),
+  fixed(3.06748031766366259510e-02),
+  fixed(3.22080254083045858238e-02),
+  fixed(3.37411718513775799044e-02),
+  fixed(3.52742388982139470910e-02),
+  fixed(3.68072229413588317137e-02),
+  fixed(3.83401203735526940886e-02),
+  fixed(3.98729275877398106620e-02),
+  fixed(4.14056409770767394618e-02),
+  fixed(4.29382569349408202419e-02),
+  fixed(4.44707718549386676887e-02),
+  fixed(4.60031821309146229937e-02),
+  fixed(4.75354841569593025707e-02),
+  fixed(4.90676743274180149346e-02),
+  fixed(5.05997490368992816623e-02),
+  fixed(5.21317046802833236607e-02),
+  fixed(5.36635376527305196781e-02),
+  fixed(5.51952443496899342046e-02),
+  fixed(5.67268211669077482284e-02),
+  fixed(5.82582645004357524421e-02),
+  fixed(5.97895707466398682040e-02),
+  fixed(6.13207363022085782944e-02),
+  fixed(6.28517575641614062443e-02),
+  fixed(6.43826309298574650519e-02),
+  fixed(6.59133527970038046728e-02),
+  fixed(6.74439195636640509424e-02),
+  fixed(6.89743276282667461263e-02),
+  fixed(7.05045733896138560048e-02),
+  fixed(7.20346532468893324674e-02),
+  fixed(7.35645635996674263080e-02),
+  fixed(7.50943008479213053308e-02),
+  fixed(7.66238613920314920458e-02),
+  fixed(7.81532416327942319745e-02),
+  fixed(7.96824379714301256339e-02),
+  fixed(8.12114468095924413316e-02),
+  fixed(8.27402645493756916384e-02),
+  fixed(8.42688875933240710836e-02),
+  fixed(8.57973123444398938497e-02),
+  fixed(8.73255352061920592233e-02),
+  fixed(8.88535525825246003118e-02),
+  fixed(9.03813608778649829611e-02),
+  fixed(9.19089564971327238618e-02),
+  fixed(9.34363358457477866104e-02),
+  fixed(9.49634953296389916488e-02),
+  fixed(9.64904313552525927378e-02),
+  fixed(9.80171403295606036288e-02),
+  fixed(9.95436186600693190263e-02),
+  fixed(1.01069862754827821671e-01),
+  fixed(1.02595869022436281259e-01),
+  fixed(1.04121633872054586423e-01),
+  fixed(1.05647153713410615894e-01),
+  fixed(1.07172424956808842733e-01),
+  fixed(1.08697444013138716512e-01),
+  fixed(1.10222207293883059376e-01),
+  fixed(1.11746711211126587004e-01),
+  fixed(1.13270952177564346308e-01),
+  fixed(1.14794926606510083733e-01),
+  fixed(1.16318630911904752345e-01),
+  fixed(1.17842061508324977281e-01),
+  fixed(1.19365214810991354666e-01),
+  fixed(1.20888087235777083595e-01),
+  fixed(1.22410675199216195663e-01),
+  fixed(1.23932975118512159196e-01),
+  fixed(1.25454983411546233674e-01),
+  fixed(1.26976696496885865795e-01),
+  fixed(1.28498110793793168805e-01),
+  fixed(1.30019222722233346312e-01),
+  fixed(1.31540028702883116107e-01),
+  fixed(1.33060525157139064589e-01),
+  fixed(1.34580708507126167728e-01),
+  fixed(1.36100575175706201003e-01),
+  fixed(1.37620121586486038323e-01),
+  fixed(1.39139344163826200740e-01),
+  fixed(1.40658239332849210879e-01),
+  fixed(1.42176803519448030633e-01),
+  fixed(1.43695033150294471103e-01),
+  fixed(1.45212924652847463758e-01),
+  fixed(1.46730474455361747932e-01),
+  fixed(1.48247678986896030962e-01),
+  fixed(1.49764534677321509148e-01),
+  fixed(1.51281037957330222188e-01),
+  fixed(1.52797185258443435352e-01),
+  fixed(1.54312973013020104940e-01),
+  fixed(1.55828397654265232708e-01),
+  fixed(1.57343455616238248052e-01),
+  fixed(1.58858143333861445701e-01),
+  fixed(1.60372457242928284638e-01),
+  fixed(1.61886393780111825791e-01),
+  fixed(1.63399949382973225243e-01),
+  fixed(1.64913120489969922122e-01),
+  fixed(1.66425903540464104058e-01),
+  fixed(1.67938294974731172626e-01),
+  fixed(1.69450291233967959004e-01),
+  fixed(1.70961888760301217172e-01),
+  fixed(1.72473083996795950590e-01),
+  fixed(1.73983873387463822136e-01),
+  fixed(1.75494253377271425265e-01),
+  fixed(1.77004220412148749464e-01),
+  fixed(1.78513770938997506921e-01),
+  fixed(1.80022901405699514710e-01),
+  fixed(1.81531608261124965953e-01),
+  fixed(1.83039887955140950782e-01),
+  fixed(1.84547736938619616476e-01),
+  fixed(1.86055151663446632915e-01),
+  fixed(1.87562128582529602516e-01),
+  fixed(1.89068664149806192620e-01),
+  fixed(1.90574754820252739718e-01),
+  fixed(1.92080397049892437344e-01),
+  fixed(1.93585587295803607244e-01),
+  fixed(1.95090322016128248084e-01),
+  fixed(1.96594597670080223351e-01),
+  fixed(1.98098410717953560267e-01),
+  fixed(1.99601757621130970755e-01),
+  fixed(2.01104634842091900548e-01),
+  fixed(2.02607038844421133428e-01),
+  fixed(2.04108966092816868088e-01),
+  fixed(2.05610413053099239100e-01),
+  fixed(2.07111376192218560321e-01),
+  fixed(2.08611851978263485030e-01),
+  fixed(2.10111836880469610156e-01),
+  fixed(2.11611327369227553152e-01),
+  fixed(2.13110319916091361936e-01),
+  fixed(2.14608810993786758292e-01),
+  fixed(2.16106797076219520060e-01),
+  fixed(2.17604274638483641269e-01),
+  fixed(2.19101240156869797593e-01),
+  fixed(2.20597690108873506487e-01),
+  fixed(2.22093620973203509372e-01),
+  fixed(2.23589029229789987285e-01),
+  fixed(2.25083911359792832041e-01),
+  fixed(2.26578263845610000660e-01),
+  fixed(2.28072083170885731018e-01),
+  fixed(2.29565365820518868523e-01),
+  fixed(2.31058108280671109513e-01),
+  fixed(2.32550307038775244672e-01),
+  fixed(2.34041958583543430183e-01),
+  fixed(2.35533059404975486650e-01),
+  fixed(2.37023605994367198013e-01),
+  fixed(2.38513594844318416177e-01),
+  fixed(2.40003022448741498707e-01),
+  fixed(2.41491885302869330188e-01),
+  fixed(2.42980179903263870944e-01),
+  fixed(2.44467902747824150644e-01),
+  fixed(2.45955050335794594973e-01),
+  fixed(2.47441619167773269039e-01),
+  fixed(2.48927605745720148533e-01),
+  fixed(2.50413006572965224361e-01),
+  fixed(2.51897818154216968090e-01),
+  fixed(2.53382036995570159021e-01),
+  fixed(2.54865659604514571690e-01),
+  fixed(2.56348682489942913953e-01),
+  fixed(2.57831102162158987134e-01),
+  fixed(2.59312915132886234737e-01),
+  fixed(2.60794117915275514008e-01),
+  fixed(2.62274707023913589143e-01),
+  fixed(2.63754678974831346938e-01),
+  fixed(2.65234030285511790392e-01),
+  fixed(2.66712757474898365384e-01),
+  fixed(2.68190857063403176319e-01),
+  fixed(2.69668325572915090760e-01),
+  fixed(2.71145159526808010586e-01),
+  fixed(2.72621355449948976624e-01),
+  fixed(2.74096909868706384295e-01),
+  fixed(2.75571819310958143756e-01),
+  fixed(2.77046080306099895552e-01),
+  fixed(2.78519689385053059727e-01),
+  fixed(2.79992643080273218015e-01),
+  fixed(2.81464937925757940906e-01),
+  fixed(2.82936570457055391881e-01),
+  fixed(2.84407537211271876920e-01),
+  fixed(2.85877834727080615274e-01),
+  fixed(2.87347459544729511016e-01),
+  fixed(2.88816408206049479723e-01),
+  fixed(2.90284677254462331053e-01),
+  fixed(2.91752263234989261953e-01),
+  fixed(2.93219162694258628221e-01),
+  fixed(2.94685372180514326690e-01),
+  fixed(2.96150888243623788831e-01),
+  fixed(2.97615707435086196408e-01),
+  fixed(2.99079826308040475080e-01),
+  fixed(3.00543241417273454541e-01),
+  fixed(3.02005949319228084171e-01),
+  fixed(3.03467946572011315620e-01),
+  fixed(3.04929229735402373969e-01),
+  fixed(3.06389795370860917867e-01),
+  fixed(3.07849640041534866608e-01),
+  fixed(3.09308760312268726800e-01),
+  fixed(3.10767152749611474949e-01),
+  fixed(3.12224813921824884133e-01),
+  fixed(3.13681740398891517607e-01),
+  fixed(3.15137928752522444853e-01),
+  fixed(3.16593375556165845808e-01),
+  fixed(3.18048077385014948959e-01),
+  fixed(3.19502030816015691883e-01),
+  fixed(3.20955232427875214452e-01),
+  fixed(3.22407678801069852437e-01),
+  fixed(3.23859366517852853562e-01),
+  fixed(3.25310292162262926219e-01),
+  fixed(3.26760452320131733472e-01),
+  fixed(3.28209843579092497290e-01),
+  fixed(3.29658462528587492546e-01),
+  fixed(3.31106305759876429207e-01),
+  fixed(3.32553369866044223890e-01),
+  fixed(3.33999651442009382052e-01),
+  fixed(3.35445147084531603010e-01),
+  fixed(3.36889853392220051109e-01),
+  fixed(3.38333766965541127281e-01),
+  fixed(3.39776884406826851226e-01),
+  fixed(3.41219202320282355423e-01),
+  fixed(3.42660717311994378331e-01),
+  fixed(3.44101425989938813910e-01),
+  fixed(3.45541324963989093799e-01),
+  fixed(3.46980410845923681329e-01),
+  fixed(3.48418680249434564722e-01),
+  fixed(3.49856129790134917634e-01),
+  fixed(3.51292756085567092761e-01),
+  fixed(3.52728555755210726463e-01),
+  fixed(3.54163525420490343798e-01),
+  fixed(3.55597661704783851722e-01),
+  fixed(3.57030961233429977586e-01),
+  fixed(3.58463420633736540299e-01),
+  fixed(3.59895036534988110866e-01),
+  fixed(3.61325805568454283545e-01),
+  fixed(3.62755724367397225372e-01),
+  fixed(3.64184789567079891803e-01),
+  fixed(3.65612997804773853794e-01),
+  fixed(3.67040345719767180377e-01),
+  fixed(3.68466829953372321249e-01),
+  fixed(3.69892447148934100376e-01),
+  fixed(3.71317193951837543064e-01),
+  fixed(3.72741067009515758546e-01),
+  fixed(3.74164062971457933582e-01),
+  fixed(3.75586178489217215049e-01),
+  fixed(3.77007410216418259452e-01),
+  fixed(3.78427754808765559602e-01),
+  fixed(3.79847208924051160661e-01),
+  fixed(3.81265769222162376195e-01),
+  fixed(3.82683432365089781779e-01),
+  fixed(3.84100195016935042069e-01),
+  fixed(3.85516053843918848898e-01),
+  fixed(3.86931005514388581812e-01),
+  fixed(3.88345046698826246168e-01),
+  fixed(3.89758174069856411226e-01),
+  fixed(3.91170384302253870690e-01),
+  fixed(3.92581674072951469778e-01),
+  fixed(3.93992040061048098831e-01),
+  fixed(3.95401478947816353848e-01),
+  fixed(3.96809987416710308050e-01),
+  fixed(3.98217562153373560996e-01),
+  fixed(3.99624199845646788098e-01),
+  fixed(4.01029897183575623210e-01),
+  fixed(4.02434650859418430180e-01),
+  fixed(4.03838457567654074420e-01),
+  fixed(4.05241314004989860997e-01),
+  fixed(4.06643216870369028637e-01),
+  fixed(4.08044162864978687821e-01),
+  fixed(4.09444148692257592348e-01),
+  fixed(4.10843171057903910892e-01),
+  fixed(4.12241226669882887546e-01),
+  fixed(4.13638312238434502355e-01),
+  fixed(4.15034424476081631461e-01),
+  fixed(4.16429560097637152527e-01),
+  fixed(4.17823715820212271410e-01),
+  fixed(4.19216888363223905145e-01),
+  fixed(4.20609074448402509017e-01),
+  fixed(4.22000270799799681587e-01),
+  fixed(4.23390474143796047279e-01),
+  fixed(4.24779681209108805895e-01),
+  fixed(4.26167888726799615196e-01),
+  fixed(4.27555093430282084910e-01),
+  fixed(4.28941292055329492783e-01),
+  fixed(4.30326481340082611649e-01),
+  fixed(4.31710658025057258946e-01),
+  fixed(4.33093818853151957260e-01),
+  fixed(4.34475960569655650367e-01),
+  fixed(4.35857079922255474802e-01),
+  fixed(4.37237173661044087325e-01),
+  fixed(4.38616238538527658530e-01),
+  fixed(4.39994271309633255829e-01),
+  fixed(4.41371268731716670519e-01),
+  fixed(4.42747227564570022817e-01),
+  fixed(4.44122144570429200350e-01),
+  fixed(4.45496016513981740736e-01),
+  fixed(4.46868840162374159064e-01),
+  fixed(4.48240612285219885980e-01),
+  fixed(4.49611329654606539652e-01),
+  fixed(4.50980989045103863866e-01),
+  fixed(4.52349587233770888961e-01),
+  fixed(4.53717121000163869926e-01),
+  fixed(4.55083587126343835916e-01),
+  fixed(4.56448982396883917723e-01),
+  fixed(4.57813303598877174849e-01),
+  fixed(4.59176547521944089514e-01),
+  fixed(4.60538710958240005144e-01),
+  fixed(4.61899790702462731407e-01),
+  fixed(4.63259783551860149231e-01),
+  fixed(4.64618686306237815842e-01),
+  fixed(4.65976495767966181205e-01),
+  fixed(4.67333208741988415102e-01),
+  fixed(4.68688822035827901136e-01),
+  fixed(4.70043332459595619710e-01),
+  fixed(4.71396736825997642040e-01),
+  fixed(4.72749031950342790687e-01),
+  fixed(4.74100214650549967033e-01),
+  fixed(4.75450281747155867329e-01),
+  fixed(4.76799230063322088125e-01),
+  fixed(4.78147056424843008848e-01),
+  fixed(4.79493757660153008260e-01),
+  fixed(4.80839330600333958454e-01),
+  fixed(4.82183772079122718868e-01),
+  fixed(4.83527078932918741305e-01),
+  fixed(4.84869248000791064346e-01),
+  fixed(4.86210276124486417970e-01),
+  fixed(4.87550160148435995922e-01),
+  fixed(4.88888896919763171756e-01),
+  fixed(4.90226483288291159379e-01),
+  fixed(4.91562916106549896433e-01),
+  fixed(4.92898192229784037899e-01),
+  fixed(4.94232308515959672945e-01),
+  fixed(4.95565261825772540583e-01),
+  fixed(4.96897049022654468953e-01),
+  fixed(4.98227666972781868537e-01),
+  fixed(4.99557112545081838384e-01),
+  fixed(5.00885382611240714823e-01),
+  fixed(5.02212474045710788317e-01),
+  fixed(5.03538383725717575423e-01),
+  fixed(5.04863108531267590351e-01),
+  fixed(5.06186645345155228348e-01),
+  fixed(5.07508991052970870328e-01),
+  fixed(5.08830142543106989095e-01),
+  fixed(5.10150096706766809085e-01),
+  fixed(5.11468850437970301570e-01),
+  fixed(5.12786400633562955420e-01),
+  fixed(5.14102744193221661284e-01),
+  fixed(5.15417878019462927242e-01),
+  fixed(5.16731799017649873207e-01),
+  fixed(5.18044504095999336357e-01),
+  fixed(5.19355990165589642693e-01),
+  fixed(5.20666254140367157355e-01),
+  fixed(5.21975292937154389250e-01),
+  fixed(5.23283103475656430348e-01),
+  fixed(5.24589682678468949284e-01),
+  fixed(5.25895027471084630655e-01),
+  fixed(5.27199134781901279645e-01),
+  fixed(5.28502001542228483366e-01),
+  fixed(5.29803624686294605262e-01),
+  fixed(5.31104001151255000757e-01),
+  fixed(5.32403127877197901441e-01),
+  fixed(5.33701001807152963785e-01),
+  fixed(5.34997619887097153324e-01),
+  fixed(5.36292979065963182350e-01),
+  fixed(5.37587076295645394097e-01),
+  fixed(5.38879908531008422479e-01),
+  fixed(5.40171472729892854225e-01),
+  fixed(5.41461765853123444536e-01),
+  fixed(5.42750784864515889439e-01),
+  fixed(5.44038526730883820193e-01),
+  fixed(5.45324988422046463832e-01),
+  fixed(5.46610166910834860410e-01),
+  fixed(5.47894059173100189675e-01),
+  fixed(5.49176662187719655250e-01),
+  fixed(5.50457972936604811309e-01),
+  fixed(5.51737988404707335732e-01),
+  fixed(5.53016705580027467803e-01),
+  fixed(5.54294121453620003415e-01),
+  fixed(5.55570233019602177649e-01),
+  fixed(5.56845037275160104073e-01),
+  fixed(5.58118531220556102213e-01),
+  fixed(5.59390711859136136042e-01),
+  fixed(5.60661576197336031235e-01),
+  fixed(5.61931121244689468774e-01),
+  fixed(5.63199344013834091172e-01),
+  fixed(5.64466241520519496078e-01),
+  fixed(5.65731810783613120464e-01),
+  fixed(5.66996048825108678315e-01),
+  fixed(5.68258952670131489704e-01),
+  fixed(5.69520519346947140527e-01),
+  fixed(5.70780745886967255665e-01),
+  fixed(5.72039629324757048501e-01),
+  fixed(5.73297166698042204303e-01),
+  fixed(5.74553355047715763604e-01),
+  fixed(5.75808191417845338655e-01),
+  fixed(5.77061672855679441696e-01),
+  fixed(5.78313796411655589580e-01),
+  fixed(5.79564559139405632848e-01),
+  fixed(5.80813958095764526490e-01),
+  fixed(5.82061990340775436970e-01),
+  fixed(5.83308652937698290941e-01),
+  fixed(5.84553942953015326367e-01),
+  fixed(5.85797857456438864077e-01),
+  fixed(5.87040393520917969106e-01),
+  fixed(5.88281548222645223056e-01),
+  fixed(5.89521318641063940547e-01),
+  fixed(5.90759701858874164415e-01),
+  fixed(5.91996694962040992394e-01),
+  fixed(5.93232295039799795155e-01),
+  fixed(5.94466499184664431965e-01),
+  fixed(5.95699304492433356906e-01),
+  fixed(5.96930708062196502262e-01),
+  fixed(5.98160706996342272923e-01),
+  fixed(5.99389298400564540792e-01),
+  fixed(6.00616479383868973052e-01),
+  fixed(6.01842247058580026575e-01),
+  fixed(6.03066598540348164370e-01),
+  fixed(6.04289530948155961809e-01),
+  fixed(6.05511041404325545123e-01),
+  fixed(6.06731127034524475583e-01),
+  fixed(6.07949784967773632083e-01),
+  fixed(6.09167012336453206345e-01),
+  fixed(6.10382806276309475280e-01),
+  fixed(6.11597163926461906414e-01),
+  fixed(6.12810082429409708205e-01),
+  fixed(6.14021558931038380358e-01),
+  fixed(6.15231590580626819253e-01),
+  fixed(6.16440174530853646218e-01),
+  fixed(6.17647307937803868860e-01),
+  fixed(6.18852987960976319570e-01),
+  fixed(6.20057211763289095607e-01),
+  fixed(6.21259976511087552709e-01),
+  fixed(6.22461279374149967225e-01),
+  fixed(6.23661117525694530528e-01),
+  fixed(6.24859488142386343412e-01),
+  fixed(6.26056388404343522325e-01),
+  fixed(6.27251815495144082746e-01),
+  fixed(6.28445766601832711551e-01),
+  fixed(6.29638238914926984258e-01),
+  fixed(6.30829229628424470455e-01),
+  fixed(6.32018735939809062074e-01),
+  fixed(6.33206755050057190637e-01),
+  fixed(6.34393284163645487794e-01),
+  fixed(6.35578320488556114398e-01),
+  fixed(6.36761861236284198995e-01),
+  fixed(6.37943903621844055074e-01),
+  fixed(6.39124444863775731385e-01),
+  fixed(6.40303482184151673273e-01),
+  fixed(6.41481012808583161977e-01),
+  fixed(6.42657033966226864941e-01),
+  fixed(6.43831542889791386131e-01),
+  fixed(6.45004536815543927375e-01),
+  fixed(6.46176012983316283567e-01),
+  fixed(6.47345968636512059113e-01),
+  fixed(6.48514401022112441098e-01),
+  fixed(6.49681307390683193681e-01),
+  fixed(6.50846684996380875354e-01),
+  fixed(6.52010531096959500275e-01),
+  fixed(6.53172842953776755515e-01),
+  fixed(6.54333617831800440356e-01),
+  fixed(6.55492852999615349674e-01),
+  fixed(6.56650545729428936070e-01),
+  fixed(6.57806693297078637350e-01),
+  fixed(6.58961292982037316612e-01),
+  fixed(6.60114342067420478699e-01),
+  fixed(6.61265837839992265401e-01),
+  fixed(6.62415777590171783729e-01),
+  fixed(6.63564158612039767249e-01),
+  fixed(6.64710978203344793336e-01),
+  fixed(6.65856233665509722464e-01),
+  fixed(6.66999922303637471366e-01),
+  fixed(6.68142041426518451530e-01),
+  fixed(6.69282588346636009291e-01),
+  fixed(6.70421560380173087168e-01),
+  fixed(6.71558954847018330092e-01),
+  fixed(6.72694769070772857766e-01),
+  fixed(6.73829000378756037826e-01),
+  fixed(6.74961646102011925130e-01),
+  fixed(6.76092703575315923104e-01),
+  fixed(6.77222170137180334848e-01),
+  fixed(6.78350043129861468572e-01),
+  fixed(6.79476319899364966659e-01),
+  fixed(6.80600997795453022121e-01),
+  fixed(6.81724074171649707665e-01),
+  fixed(6.82845546385248081123e-01),
+  fixed(6.83965411797315403497e-01),
+  fixed(6.85083667772700355414e-01),
+  fixed(6.86200311680038588236e-01),
+  fixed(6.87315340891759052333e-01),
+  fixed(6.88428752784090436379e-01),
+  fixed(6.89540544737066829484e-01),
+  fixed(6.90650714134534604582e-01),
+  fixed(6.91759258364157747501e-01),
+  fixed(6.92866174817424629317e-01),
+  fixed(6.93971460889654001569e-01),
+  fixed(6.95075113980000880431e-01),
+  fixed(6.96177131491462986013e-01),
+  fixed(6.97277510830886515514e-01),
+  fixed(6.98376249408972915589e-01),
+  fixed(6.99473344640283767326e-01),
+  fixed(7.00568793943248335765e-01),
+  fixed(7.01662594740168454877e-01),
+  fixed(7.02754744457225299925e-01),
+  fixed(7.03845240524484938582e-01),
+  fixed(7.04934080375904881244e-01),
+  fixed(7.06021261449339743166e-01),
+  fixed(7.07106781186547461715e-01),
+  fixed(7.08190637033195291572e-01),
+  fixed(7.09272826438865577892e-01),
+  fixed(7.10353346857062306619e-01),
+  fixed(7.11432195745216433558e-01),
+  fixed(7.12509370564692323669e-01),
+  fixed(7.13584868780793524223e-01),
+  fixed(7.14658687862768982058e-01),
+  fixed(7.15730825283818594684e-01),
+  fixed(7.16801278521099538565e-01),
+  fixed(7.17870045055731709205e-01),
+  fixed(7.18937122372804382486e-01),
+  fixed(7.20002507961381654766e-01),
+  fixed(7.21066199314508105012e-01),
+  fixed(7.22128193929215345115e-01),
+  fixed(7.23188489306527348965e-01),
+  fixed(7.24247082951466891743e-01),
+  fixed(7.25303972373060656942e-01),
+  fixed(7.26359155084346008735e-01),
+  fixed(7.27412628602375765929e-01),
+  fixed(7.28464390448225196373e-01),
+  fixed(7.29514438146996901935e-01),
+  fixed(7.30562769227827590868e-01),
+  fixed(7.31609381223892518697e-01),
+  fixed(7.32654271672412815697e-01),
+  fixed(7.33697438114660260844e-01),
+  fixed(7.34738878095963388049e-01),
+  fixed(7.35778589165713481357e-01),
+  fixed(7.36816568877369793000e-01),
+  fixed(7.37852814788465982687e-01),
+  fixed(7.38887324460615113608e-01),
+  fixed(7.39920095459516091729e-01),
+  fixed(7.40951125354959105884e-01),
+  fixed(7.41980411720830956845e-01),
+  fixed(7.43007952135121718662e-01),
+  fixed(7.44033744179929179552e-01),
+  fixed(7.45057785441465947329e-01),
+  fixed(7.46080073510063779274e-01),
+  fixed(7.47100605980180132448e-01),
+  fixed(7.48119380450403492766e-01),
+  fixed(7.49136394523459259176e-01),
+  fixed(7.50151645806214961709e-01),
+  fixed(7.51165131909686367706e-01),
+  fixed(7.52176850449042699864e-01),
+  fixed(7.53186799043612409399e-01),
+  fixed(7.54194975316889171246e-01),
+  fixed(7.55201376896536547001e-01),
+  fixed(7.56206001414394535232e-01),
+  fixed(7.57208846506484456462e-01),
+  fixed(7.58209909813015281443e-01),
+  fixed(7.59209188978387961022e-01),
+  fixed(7.60206681651202420547e-01),
+  fixed(7.61202385484261778714e-01),
+  fixed(7.62196298134578897887e-01),
+  fixed(7.63188417263381269073e-01),
+  fixed(7.64178740536116674065e-01),
+  fixed(7.65167265622458958596e-01),
+  fixed(7.66153990196312806304e-01),
+  fixed(7.67138911935820400068e-01),
+  fixed(7.68122028523365307784e-01),
+  fixed(7.69103337645579587800e-01),
+  fixed(7.70082836993347896737e-01),
+  fixed(7.71060524261813706737e-01),
+  fixed(7.72036397150384412491e-01),
+  fixed(7.73010453362736993377e-01),
+  fixed(7.73982690606822787416e-01),
+  fixed(7.74953106594873819546e-01),
+  fixed(7.75921699043407575580e-01),
+  fixed(7.76888465673232442299e-01),
+  fixed(7.77853404209453036522e-01),
+  fixed(7.78816512381475867244e-01),
+  fixed(7.79777787923014442661e-01),
+  fixed(7.80737228572094377199e-01),
+  fixed(7.81694832071059386713e-01),
+  fixed(7.82650596166575729384e-01),
+  fixed(7.83604518609638200921e-01),
+  fixed(7.84556597155575241587e-01),
+  fixed(7.85506829564053932202e-01),
+  fixed(7.86455213599085767306e-01),
+  fixed(7.87401747029031318093e-01),
+  fixed(7.88346427626606227612e-01),
+  fixed(7.89289253168885651668e-01),
+  fixed(7.90230221437310031973e-01),
+  fixed(7.91169330217690092155e-01),
+  fixed(7.92106577300212388870e-01),
+  fixed(7.93041960479443641674e-01),
+  fixed(7.93975477554337172315e-01),
+  fixed(7.94907126328237012558e-01),
+  fixed(7.95836904608883455303e-01),
+  fixed(7.96764810208418716719e-01),
+  fixed(7.97690840943391044071e-01),
+  fixed(7.98614994634760821945e-01),
+  fixed(7.99537269107905013144e-01),
+  fixed(8.00457662192622709796e-01),
+  fixed(8.01376171723140129366e-01),
+  fixed(8.02292795538115721676e-01),
+  fixed(8.03207531480644831845e-01),
+  fixed(8.04120377398265695490e-01),
+  fixed(8.05031331142963657577e-01),
+  fixed(8.05940390571176279444e-01),
+  fixed(8.06847553543799222986e-01),
+  fixed(8.07752817926190358477e-01),
+  fixed(8.08656181588174982622e-01),
+  fixed(8.09557642404051258644e-01),
+  fixed(8.10457198252594768206e-01),
+  fixed(8.11354847017063729453e-01),
+  fixed(8.12250586585203881995e-01),
+  fixed(8.13144414849253593935e-01),
+  fixed(8.14036329705948302760e-01),
+  fixed(8.14926329056526621564e-01),
+  fixed(8.15814410806733780746e-01),
+  fixed(8.16700572866827845253e-01),
+  fixed(8.17584813151583711388e-01),
+  fixed(8.18467129580298657920e-01),
+  fixed(8.19347520076796898003e-01),
+  fixed(8.20225982569434686198e-01),
+  fixed(8.21102514991104648345e-01),
+  fixed(8.21977115279241554724e-01),
+  fixed(8.22849781375826316854e-01),
+  fixed(8.23720511227391316567e-01),
+  fixed(8.24589302785025290987e-01),
+  fixed(8.25456154004377440359e-01),
+  fixed(8.26321062845663423246e-01),
+  fixed(8.27184027273669020275e-01),
+  fixed(8.28045045257755796264e-01),
+  fixed(8.28904114771864874989e-01),
+  fixed(8.29761233794523045404e-01),
+  fixed(8.30616400308846203338e-01),
+  fixed(8.31469612302545235671e-01),
+  fixed(8.32320867767929684078e-01),
+  fixed(8.33170164701913185112e-01),
+  fixed(8.34017501106018133150e-01),
+  fixed(8.34862874986380010256e-01),
+  fixed(8.35706284353752604233e-01),
+  fixed(8.36547727223511894401e-01),
+  fixed(8.37387201615661935783e-01),
+  fixed(8.38224705554837967725e-01),
+  fixed(8.39060237070312631147e-01),
+  fixed(8.39893794195999410235e-01),
+  fixed(8.40725374970458072532e-01),
+  fixed(8.41554977436898332677e-01),
+  fixed(8.42382599643185958627e-01),
+  fixed(8.43208239641845436196e-01),
+  fixed(8.44031895490066408350e-01),
+  fixed(8.44853565249707005869e-01),
+  fixed(8.45673246987299065403e-01),
+  fixed(8.46490938774052015248e-01),
+  fixed(8.47306638685858315441e-01),
+  fixed(8.48120344803297121494e-01),
+  fixed(8.48932055211639613468e-01),
+  fixed(8.49741768000852437659e-01),
+  fixed(8.50549481265603368740e-01),
+  fixed(8.51355193105265195541e-01),
+  fixed(8.52158901623919828872e-01),
+  fixed(8.52960604930363630594e-01),
+  fixed(8.53760301138111299402e-01),
+  fixed(8.54557988365400533759e-01),
+  fixed(8.55353664735196028701e-01),
+  fixed(8.56147328375194471839e-01),
+  fixed(8.56938977417828651184e-01),
+  fixed(8.57728610000272118086e-01),
+  fixed(8.58516224264442739944e-01),
+  fixed(8.59301818357008362348e-01),
+  fixed(8.60085390429390139744e-01),
+  fixed(8.60866938637767309395e-01),
+  fixed(8.61646461143081299205e-01),
+  fixed(8.62423956111040501682e-01),
+  fixed(8.63199421712124159711e-01),
+  fixed(8.63972856121586696432e-01),
+  fixed(8.64744257519462378170e-01),
+  fixed(8.65513624090568978175e-01),
+  fixed(8.66280954024512994671e-01),
+  fixed(8.67046245515692648453e-01),
+  fixed(8.67809496763303211964e-01),
+  fixed(8.68570705971340895069e-01),
+  fixed(8.69329871348606730841e-01),
+  fixed(8.70086991108711349519e-01),
+  fixed(8.70842063470078864285e-01),
+  fixed(8.71595086655951090115e-01),
+  fixed(8.72346058894391540584e-01),
+  fixed(8.73094978418290090794e-01),
+  fixed(8.73841843465366752142e-01),
+  fixed(8.74586652278176113207e-01),
+  fixed(8.75329403104110781442e-01),
+  fixed(8.76070094195406601223e-01),
+  fixed(8.76808723809145762473e-01),
+  fixed(8.77545290207261241555e-01),
+  fixed(8.78279791656541464206e-01),
+  fixed(8.79012226428633414166e-01),
+  fixed(8.79742592800047407131e-01),
+  fixed(8.80470889052160754495e-01),
+  fixed(8.81197113471221982195e-01),
+  fixed(8.81921264348354938534e-01),
+  fixed(8.82643339979562790987e-01),
+  fixed(8.83363338665731578914e-01),
+  fixed(8.84081258712634987518e-01),
+  fixed(8.84797098430937789537e-01),
+  fixed(8.85510856136199953070e-01),
+  fixed(8.86222530148880638379e-01),
+  fixed(8.86932118794342083667e-01),
+  fixed(8.87639620402853934955e-01),
+  fixed(8.88345033309596243676e-01),
+  fixed(8.89048355854664573705e-01),
+  fixed(8.89749586383072887941e-01),
+  fixed(8.90448723244757878170e-01),
+  fixed(8.91145764794583183921e-01),
+  fixed(8.91840709392342723127e-01),
+  fixed(8.92533555402764688935e-01),
+  fixed(8.93224301195515324459e-01),
+  fixed(8.93912945145203252650e-01),
+  fixed(8.94599485631382584927e-01),
+  fixed(8.95283921038557584104e-01),
+  fixed(8.95966249756185106889e-01),
+  fixed(8.96646470178680154994e-01),
+  fixed(8.97324580705418317628e-01),
+  fixed(8.98000579740739879320e-01),
+  fixed(8.98674465693953816725e-01),
+  fixed(8.99346236979341462359e-01),
+  fixed(9.00015892016160279354e-01),
+  fixed(9.00683429228646859066e-01),
+  fixed(9.01348847046022028096e-01),
+  fixed(9.02012143902493068737e-01),
+  fixed(9.02673318237258826002e-01),
+  fixed(9.03332368494511817048e-01),
+  fixed(9.03989293123443338196e-01),
+  fixed(9.04644090578246240497e-01),
+  fixed(9.05296759318118815507e-01),
+  fixed(9.05947297807268459024e-01),
+  fixed(9.06595704514915334826e-01),
+  fixed(9.07241977915295927382e-01),
+  fixed(9.07886116487666150476e-01),
+  fixed(9.08528118716306121172e-01),
+  fixed(9.09167983090522269229e-01),
+  fixed(9.09805708104652222090e-01),
+  fixed(9.10441292258067136345e-01),
+  fixed(9.11074734055176249647e-01),
+  fixed(9.11706032005429878318e-01),
+  fixed(9.12335184623322748010e-01),
+  fixed(9.12962190428398101538e-01),
+  fixed(9.13587047945250807501e-01),
+  fixed(9.14209755703530690951e-01),
+  fixed(9.14830312237946086107e-01),
+  fixed(9.15448716088267833157e-01),
+  fixed(9.16064965799331609730e-01),
+  fixed(9.16679059921042704850e-01),
+  fixed(9.17290997008377906319e-01),
+  fixed(9.17900775621390385695e-01),
+  fixed(9.18508394325212251807e-01),
+  fixed(9.19113851690057770405e-01),
+  fixed(9.19717146291227360955e-01),
+  fixed(9.20318276709110483225e-01),
+  fixed(9.20917241529189523064e-01),
+  fixed(9.21514039342041901826e-01),
+  fixed(9.22108668743345072372e-01),
+  fixed(9.22701128333878517473e-01),
+  fixed(9.23291416719527635593e-01),
+  fixed(9.23879532511286738483e-01),
+  fixed(9.24465474325262603905e-01),
+  fixed(9.25049240782677584249e-01),
+  fixed(9.25630830509872715162e-01),
+  fixed(9.26210242138311268256e-01),
+  fixed(9.26787474304581748719e-01),
+  fixed(9.27362525650401114952e-01),
+  fixed(9.27935394822617887201e-01),
+  fixed(9.28506080473215478222e-01),
+  fixed(9.29074581259315745996e-01),
+  fixed(9.29640895843181325198e-01),
+  fixed(9.30205022892219068886e-01),
+  fixed(9.30766961078983712241e-01),
+  fixed(9.31326709081180426075e-01),
+  fixed(9.31884265581668147505e-01),
+  fixed(9.32439629268462355505e-01),
+  fixed(9.32992798834738845670e-01),
+  fixed(9.33543772978836172705e-01),
+  fixed(9.34092550404258870067e-01),
+  fixed(9.34639129819680780642e-01),
+  fixed(9.35183509938947499229e-01),
+  fixed(9.35725689481080369347e-01),
+  fixed(9.36265667170278259590e-01),
+  fixed(9.36803441735921560429e-01),
+  fixed(9.37339011912574959773e-01),
+  fixed(9.37872376439989885455e-01),
+  fixed(9.38403534063108057950e-01),
+  fixed(9.38932483532064487974e-01),
+  fixed(9.39459223602189918978e-01),
+  fixed(9.39983753034013935768e-01),
+  fixed(9.40506070593268295177e-01),
+  fixed(9.41026175050889257534e-01),
+  fixed(9.41544065183020806309e-01),
+  fixed(9.42059739771017312648e-01),
+  fixed(9.42573197601446866045e-01),
+  fixed(9.43084437466093494784e-01),
+  fixed(9.43593458161960385588e-01),
+  fixed(9.44100258491272659178e-01),
+  fixed(9.44604837261480256849e-01),
+  fixed(9.45107193285260605009e-01),
+  fixed(9.45607325380521279712e-01),
+  fixed(9.46105232370403337328e-01),
+  fixed(9.46600913083283534988e-01),
+  fixed(9.47094366352777217166e-01),
+  fixed(9.47585591017741091235e-01),
+  fixed(9.48074585922276225070e-01),
+  fixed(9.48561349915730267490e-01),
+  fixed(9.49045881852700556891e-01),
+  fixed(9.49528180593036674750e-01),
+  fixed(9.50008245001842999145e-01),
+  fixed(9.50486073949481702350e-01),
+  fixed(9.50961666311575082311e-01),
+  fixed(9.51435020969008338199e-01),
+  fixed(9.51906136807932234944e-01),
+  fixed(9.52375012719765878799e-01),
+  fixed(9.52841647601198715734e-01),
+  fixed(9.53306040354193751085e-01),
+  fixed(9.53768189885990325116e-01),
+  fixed(9.54228095109105667326e-01),
+  fixed(9.54685754941338338142e-01),
+  fixed(9.55141168305770671410e-01),
+  fixed(9.55594334130771105862e-01),
+  fixed(9.56045251349996405565e-01),
+  fixed(9.56493918902394990589e-01),
+  fixed(9.56940335732208935404e-01),
+  fixed(9.57384500788975856267e-01),
+  fixed(9.57826413027532908018e-01),
+  fixed(9.58266071408017672262e-01),
+  fixed(9.58703474895871599060e-01),
+  fixed(9.59138622461841894307e-01),
+  fixed(9.59571513081984517335e-01),
+  fixed(9.60002145737665846248e-01),
+  fixed(9.60430519415565786545e-01),
+  fixed(9.60856633107679658501e-01),
+  fixed(9.61280485811320639655e-01),
+  fixed(9.61702076529122540371e-01),
+  fixed(9.62121404269041580193e-01),
+  fixed(9.62538468044359163400e-01),
+  fixed(9.62953266873683877414e-01),
+  fixed(9.63365799780954046305e-01),
+  fixed(9.63776065795439840223e-01),
+  fixed(9.64184063951745717880e-01),
+  fixed(9.64589793289812647004e-01),
+  fixed(9.64993252854920324779e-01),
+  fixed(9.65394441697689398296e-01),
+  fixed(9.65793358874083573973e-01),
+  fixed(9.66190003445412615157e-01),
+  fixed(9.66584374478333119285e-01),
+  fixed(9.66976471044852070591e-01),
+  fixed(9.67366292222328505446e-01),
+  fixed(9.67753837093475510756e-01),
+  fixed(9.68139104746362333387e-01),
+  fixed(9.68522094274417266746e-01),
+  fixed(9.68902804776428872024e-01),
+  fixed(9.69281235356548531712e-01),
+  fixed(9.69657385124292447998e-01),
+  fixed(9.70031253194543974239e-01),
+  fixed(9.70402838687555502339e-01),
+  fixed(9.70772140728950350130e-01),
+  fixed(9.71139158449725092837e-01),
+  fixed(9.71503890986251783524e-01),
+  fixed(9.71866337480279396388e-01),
+  fixed(9.72226497078936269247e-01),
+  fixed(9.72584368934732212963e-01),
+  fixed(9.72939952205560065757e-01),
+  fixed(9.73293246054698246716e-01),
+  fixed(9.73644249650811866026e-01),
+  fixed(9.73992962167955833586e-01),
+  fixed(9.74339382785575858215e-01),
+  fixed(9.74683510688510668096e-01),
+  fixed(9.75025345066994120202e-01),
+  fixed(9.75364885116656865627e-01),
+  fixed(9.75702130038528570033e-01),
+  fixed(9.76037079039039023876e-01),
+  fixed(9.76369731330021140003e-01),
+  fixed(9.76700086128711841837e-01),
+  fixed(9.77028142657754394840e-01),
+  fixed(9.77353900145199960825e-01),
+  fixed(9.77677357824509929429e-01),
+  fixed(9.77998514934557139355e-01),
+  fixed(9.78317370719627654729e-01),
+  fixed(9.78633924429423096569e-01),
+  fixed(9.78948175319062197097e-01),
+  fixed(9.79260122649082020985e-01),
+  fixed(9.79569765685440518865e-01),
+  fixed(9.79877103699517637558e-01),
+  fixed(9.80182135968117318470e-01),
+  fixed(9.80484861773469384971e-01),
+  fixed(9.80785280403230430579e-01),
+  fixed(9.81083391150486594512e-01),
+  fixed(9.81379193313754560890e-01),
+  fixed(9.81672686196983113049e-01),
+  fixed(9.81963869109555242964e-01),
+  fixed(9.82252741366289372493e-01),
+  fixed(9.82539302287441240757e-01),
+  fixed(9.82823551198705236409e-01),
+  fixed(9.83105487431216285010e-01),
+  fixed(9.83385110321551181300e-01),
+  fixed(9.83662419211730254531e-01),
+  fixed(9.83937413449218922779e-01),
+  fixed(9.84210092386929025210e-01),
+  fixed(9.84480455383220931509e-01),
+  fixed(9.84748501801904208008e-01),
+  fixed(9.85014231012239838137e-01),
+  fixed(9.85277642388941221618e-01),
+  fixed(9.85538735312176061854e-01),
+  fixed(9.85797509167567365118e-01),
+  fixed(9.86053963346195438966e-01),
+  fixed(9.86308097244598669384e-01),
+  fixed(9.86559910264775408173e-01),
+  fixed(9.86809401814185416235e-01),
+  fixed(9.87056571305750973799e-01),
+  fixed(9.87301418157858434732e-01),
+  fixed(9.87543941794359225739e-01),
+  fixed(9.87784141644572177832e-01),
+  fixed(9.88022017143283526330e-01),
+  fixed(9.88257567730749464374e-01),
+  fixed(9.88490792852696587012e-01),
+  fixed(9.88721691960323778581e-01),
+  fixed(9.88950264510302989862e-01),
+  fixed(9.89176509964781014439e-01),
+  fixed(9.89400427791380376874e-01),
+  fixed(9.89622017463200776000e-01),
+  fixed(9.89841278458820528208e-01),
+  fixed(9.90058210262297122561e-01),
+  fixed(9.90272812363169108174e-01),
+  fixed(9.90485084256456982388e-01),
+  fixed(9.90695025442664634063e-01),
+  fixed(9.90902635427780009714e-01),
+  fixed(9.91107913723276778839e-01),
+  fixed(9.91310859846115444149e-01),
+  fixed(9.91511473318743896677e-01),
+  fixed(9.91709753669099525197e-01),
+  fixed(9.91905700430609327256e-01),
+  fixed(9.92099313142191796544e-01),
+  fixed(9.92290591348257366988e-01),
+  fixed(9.92479534598709967064e-01),
+  fixed(9.92666142448948018995e-01),
+  fixed(9.92850414459865104888e-01),
+  fixed(9.93032350197851410023e-01),
+  fixed(9.93211949234794500008e-01),
+  fixed(9.93389211148080653047e-01),
+  fixed(9.93564135520595304030e-01),
+  fixed(9.93736721940724598845e-01),
+  fixed(9.93906970002356060512e-01),
+  fixed(9.94074879304879366337e-01),
+  fixed(9.94240449453187902229e-01),
+  fixed(9.94403680057679095761e-01),
+  fixed(9.94564570734255415374e-01),
+  fixed(9.94723121104325702646e-01),
+  fixed(9.94879330794805616378e-01),
+  fixed(9.95033199438118631797e-01),
+  fixed(9.95184726672196817709e-01),
+  fixed(9.95333912140482279796e-01),
+  fixed(9.95480755491926938561e-01),
+  fixed(9.95625256380994305694e-01),
+  fixed(9.95767414467659817134e-01),
+  fixed(9.95907229417411721251e-01),
+  fixed(9.96044700901251967018e-01),
+  fixed(9.96179828595696870153e-01),
+  fixed(9.96312612182778001291e-01),
+  fixed(9.96443051350042630077e-01),
+  fixed(9.96571145790554835386e-01),
+  fixed(9.96696895202896060439e-01),
+  fixed(9.96820299291165667910e-01),
+  fixed(9.96941357764982161171e-01),
+  fixed(9.97060070339482962254e-01),
+  fixed(9.97176436735326188199e-01),
+  fixed(9.97290456678690206971e-01),
+  fixed(9.97402129901275302792e-01),
+  fixed(9.97511456140303454099e-01),
+  fixed(9.97618435138519554783e-01),
+  fixed(9.97723066644191636243e-01),
+  fixed(9.97825350411111644533e-01),
+  fixed(9.97925286198595995479e-01),
+  fixed(9.98022873771486240813e-01),
+  fixed(9.98118112900149179190e-01),
+  fixed(9.98211003360478188462e-01),
+  fixed(9.98301544933892892608e-01),
+  fixed(9.98389737407340160935e-01),
+  fixed(9.98475580573294774211e-01),
+  fixed(9.98559074229759313646e-01),
+  fixed(9.98640218180265271108e-01),
+  fixed(9.98719012233872938111e-01),
+  fixed(9.98795456205172405006e-01),
+  fixed(9.98869549914283560987e-01),
+  fixed(9.98941293186856871245e-01),
+  fixed(9.99010685854073376966e-01),
+  fixed(9.99077727752645361470e-01),
+  fixed(9.99142418724816905318e-01),
+  fixed(9.99204758618363886313e-01),
+  fixed(9.99264747286594423592e-01),
+  fixed(9.99322384588349543755e-01),
+  fixed(9.99377670388002847801e-01),
+  fixed(9.99430604555461732375e-01),
+  fixed(9.99481186966166945673e-01),
+  fixed(9.99529417501093142562e-01),
+  fixed(9.99575296046749217638e-01),
+  fixed(9.99618822495178638299e-01),
+  fixed(9.99659996743959222698e-01),
+  fixed(9.99698818696204249967e-01),
+  fixed(9.99735288260561683060e-01),
+  fixed(9.99769405351215278976e-01),
+  fixed(9.99801169887884255694e-01),
+  fixed(9.99830581795823403191e-01),
+  fixed(9.99857641005823860603e-01),
+  fixed(9.99882347454212561111e-01),
+  fixed(9.99904701082852898075e-01),
+  fixed(9.99924701839144502991e-01),
+  fixed(9.99942349676023911620e-01),
+  fixed(9.99957644551963897861e-01),
+  fixed(9.99970586430974139880e-01),
+  fixed(9.99981175282601109089e-01),
+  fixed(9.99989411081928403213e-01),
+  fixed(9.99995293809576191180e-01),
+  fixed(9.99998823451701879250e-01),
+  fixed(1.00000000000000000000e+00),
+  fixed(9.99998823451701879250e-01),
+  fixed(9.99995293809576191180e-01),
+  fixed(9.99989411081928403213e-01),
+  fixed(9.99981175282601109089e-01),
+  fixed(9.99970586430974139880e-01),
+  fixed(9.99957644551963897861e-01),
+  fixed(9.99942349676023911620e-01),
+  fixed(9.99924701839144502991e-01),
+  fixed(9.99904701082852898075e-01),
+  fixed(9.99882347454212561111e-01),
+  fixed(9.99857641005823860603e-01),
+  fixed(9.99830581795823403191e-01),
+  fixed(9.99801169887884255694e-01),
+  fixed(9.99769405351215278976e-01),
+  fixed(9.99735288260561683060e-01),
+  fixed(9.99698818696204249967e-01),
+  fixed(9.99659996743959222698e-01),
+  fixed(9.99618822495178638299e-01),
+  fixed(9.99575296046749217638e-01),
+  fixed(9.99529417501093142562e-01),
+  fixed(9.99481186966166945673e-01),
+  fixed(9.99430604555461732375e-01),
+  fixed(9.99377670388002847801e-01),
+  fixed(9.99322384588349543755e-01),
+  fixed(9.99264747286594423592e-01),
+  fixed(9.99204758618363886313e-01),
+  fixed(9.99142418724816905318e-01),
+  fixed(9.99077727752645361470e-01),
+  fixed(9.99010685854073376966e-01),
+  fixed(9.98941293186856871245e-01),
+  fixed(9.98869549914283560987e-01),
+  fixed(9.98795456205172405006e-01),
+  fixed(9.98719012233872938111e-01),
+  fixed(9.98640218180265271108e-01),
+  fixed(9.98559074229759313646e-01),
+  fixed(9.98475580573294774211e-01),
+  fixed(9.98389737407340160935e-01),
+  fixed(9.98301544933892892608e-01),
+  fixed(9.98211003360478188462e-01),
+  fixed(9.98118112900149179190e-01),
+  fixed(9.98022873771486240813e-01),
+  fixed(9.97925286198595995479e-01),
+  fixed(9.97825350411111644533e-01),
+  fixed(9.97723066644191636243e-01),
+  fixed(9.97618435138519554783e-01),
+  fixed(9.97511456140303454099e-01),
+  fixed(9.97402129901275302792e-01),
+  fixed(9.97290456678690206971e-01),
+  fixed(9.97176436735326188199e-01),
+  fixed(9.97060070339482962254e-01),
+  fixed(9.96941357764982161171e-01),
+  fixed(9.96820299291165778932e-01),
+  fixed(9.96696895202896060439e-01),
+  fixed(9.96571145790554835386e-01),
+  fixed(9.96443051350042630077e-01),
+  fixed(9.96312612182778001291e-01),
+  fixed(9.96179828595696870153e-01),
+  fixed(9.96044700901251967018e-01),
+  fixed(9.95907229417411721251e-01),
+  fixed(9.95767414467659817134e-01),
+  fixed(9.95625256380994305694e-01),
+  fixed(9.95480755491926938561e-01),
+  fixed(9.95333912140482279796e-01),
+  fixed(9.95184726672196928732e-01),
+  fixed(9.95033199438118631797e-01),
+  fixed(9.94879330794805616378e-01),
+  fixed(9.94723121104325702646e-01),
+  fixed(9.94564570734255415374e-01),
+  fixed(9.94403680057679095761e-01),
+  fixed(9.94240449453187902229e-01),
+  fixed(9.94074879304879477360e-01),
+  fixed(9.93906970002356060512e-01),
+  fixed(9.93736721940724598845e-01),
+  fixed(9.93564135520595304030e-01),
+  fixed(9.93389211148080653047e-01),
+  fixed(9.93211949234794500008e-01),
+  fixed(9.93032350197851410023e-01),
+  fixed(9.92850414459865104888e-01),
+  fixed(9.92666142448948018995e-01),
+  fixed(9.92479534598709967064e-01),
+  fixed(9.92290591348257366988e-01),
+  fixed(9.92099313142191796544e-01),
+  fixed(9.91905700430609327256e-01),
+  fixed(9.91709753669099525197e-01),
+  fixed(9.91511473318744007699e-01),
+  fixed(9.91310859846115444149e-01),
+  fixed(9.91107913723276889861e-01),
+  fixed(9.90902635427780009714e-01),
+  fixed(9.90695025442664634063e-01),
+  fixed(9.90485084256456982388e-01),
+  fixed(9.90272812363169108174e-01),
+  fixed(9.90058210262297122561e-01),
+  fixed(9.89841278458820528208e-01),
+  fixed(9.89622017463200887022e-01),
+  fixed(9.89400427791380376874e-01),
+  fixed(9.89176509964781014439e-01),
+  fixed(9.88950264510302989862e-01),
+  fixed(9.88721691960323778581e-01),
+  fixed(9.88490792852696698034e-01),
+  fixed(9.88257567730749464374e-01),
+  fixed(9.88022017143283526330e-01),
+  fixed(9.87784141644572177832e-01),
+  fixed(9.87543941794359336761e-01),
+  fixed(9.87301418157858434732e-01),
+  fixed(9.87056571305750973799e-01),
+  fixed(9.86809401814185527257e-01),
+  fixed(9.86559910264775519195e-01),
+  fixed(9.86308097244598669384e-01),
+  fixed(9.86053963346195438966e-01),
+  fixed(9.85797509167567476140e-01),
+  fixed(9.85538735312176061854e-01),
+  fixed(9.85277642388941221618e-01),
+  fixed(9.85014231012239838137e-01),
+  fixed(9.84748501801904208008e-01),
+  fixed(9.84480455383220931509e-01),
+  fixed(9.84210092386929025210e-01),
+  fixed(9.83937413449218922779e-01),
+  fixed(9.83662419211730254531e-01),
+  fixed(9.83385110321551181300e-01),
+  fixed(9.83105487431216285010e-01),
+  fixed(9.82823551198705347431e-01),
+  fixed(9.82539302287441240757e-01),
+  fixed(9.82252741366289372493e-01),
+  fixed(9.81963869109555242964e-01),
+  fixed(9.81672686196983113049e-01),
+  fixed(9.81379193313754560890e-01),
+  fixed(9.81083391150486705534e-01),
+  fixed(9.80785280403230430579e-01),
+  fixed(9.80484861773469384971e-01),
+  fixed(9.80182135968117429492e-01),
+  fixed(9.79877103699517637558e-01),
+  fixed(9.79569765685440518865e-01),
+  fixed(9.79260122649082132007e-01),
+  fixed(9.78948175319062197097e-01),
+  fixed(9.78633924429423207592e-01),
+  fixed(9.78317370719627654729e-01),
+  fixed(9.77998514934557139355e-01),
+  fixed(9.77677357824509929429e-01),
+  fixed(9.77353900145200071847e-01),
+  fixed(9.77028142657754394840e-01),
+  fixed(9.76700086128711841837e-01),
+  fixed(9.76369731330021140003e-01),
+  fixed(9.76037079039039134898e-01),
+  fixed(9.75702130038528570033e-01),
+  fixed(9.75364885116656976649e-01),
+  fixed(9.75025345066994120202e-01),
+  fixed(9.74683510688510668096e-01),
+  fixed(9.74339382785575858215e-01),
+  fixed(9.73992962167955833586e-01),
+  fixed(9.73644249650811977048e-01),
+  fixed(9.73293246054698246716e-01),
+  fixed(9.72939952205560176779e-01),
+  fixed(9.72584368934732212963e-01),
+  fixed(9.72226497078936380269e-01),
+  fixed(9.71866337480279396388e-01),
+  fixed(9.71503890986251783524e-01),
+  fixed(9.71139158449725092837e-01),
+  fixed(9.70772140728950350130e-01),
+  fixed(9.70402838687555502339e-01),
+  fixed(9.70031253194543974239e-01),
+  fixed(9.69657385124292447998e-01),
+  fixed(9.69281235356548531712e-01),
+  fixed(9.68902804776428872024e-01),
+  fixed(9.68522094274417377768e-01),
+  fixed(9.68139104746362444409e-01),
+  fixed(9.67753837093475510756e-01),
+  fixed(9.67366292222328505446e-01),
+  fixed(9.66976471044852070591e-01),
+  fixed(9.66584374478333119285e-01),
+  fixed(9.66190003445412615157e-01),
+  fixed(9.65793358874083684995e-01),
+  fixed(9.65394441697689398296e-01),
+  fixed(9.64993252854920435801e-01),
+  fixed(9.64589793289812758026e-01),
+  fixed(9.64184063951745828902e-01),
+  fixed(9.63776065795439840223e-01),
+  fixed(9.63365799780954046305e-01),
+  fixed(9.62953266873683877414e-01),
+  fixed(9.62538468044359163400e-01),
+  fixed(9.62121404269041580193e-01),
+  fixed(9.61702076529122540371e-01),
+  fixed(9.61280485811320639655e-01),
+  fixed(9.60856633107679658501e-01),
+  fixed(9.60430519415565897567e-01),
+  fixed(9.60002145737665846248e-01),
+  fixed(9.59571513081984517335e-01),
+  fixed(9.59138622461842005329e-01),
+  fixed(9.58703474895871599060e-01),
+  fixed(9.58266071408017672262e-01),
+  fixed(9.57826413027532908018e-01),
+  fixed(9.57384500788975967289e-01),
+  fixed(9.56940335732208935404e-01),
+  fixed(9.56493918902395101611e-01),
+  fixed(9.56045251349996516588e-01),
+  fixed(9.55594334130771105862e-01),
+  fixed(9.55141168305770671410e-01),
+  fixed(9.54685754941338338142e-01),
+  fixed(9.54228095109105667326e-01),
+  fixed(9.53768189885990325116e-01),
+  fixed(9.53306040354193862107e-01),
+  fixed(9.52841647601198715734e-01),
+  fixed(9.52375012719765878799e-01),
+  fixed(9.51906136807932345967e-01),
+  fixed(9.51435020969008338199e-01),
+  fixed(9.50961666311575082311e-01),
+  fixed(9.50486073949481813372e-01),
+  fixed(9.50008245001842999145e-01),
+  fixed(9.49528180593036674750e-01),
+  fixed(9.49045881852700667913e-01),
+  fixed(9.48561349915730378513e-01),
+  fixed(9.48074585922276225070e-01),
+  fixed(9.47585591017741202258e-01),
+  fixed(9.47094366352777217166e-01),
+  fixed(9.46600913083283534988e-01),
+  fixed(9.46105232370403448350e-01),
+  fixed(9.45607325380521390734e-01),
+  fixed(9.45107193285260605009e-01),
+  fixed(9.44604837261480256849e-01),
+  fixed(9.44100258491272659178e-01),
+  fixed(9.43593458161960385588e-01),
+  fixed(9.43084437466093494784e-01),
+  fixed(9.42573197601446866045e-01),
+  fixed(9.42059739771017423671e-01),
+  fixed(9.41544065183020806309e-01),
+  fixed(9.41026175050889257534e-01),
+  fixed(9.40506070593268295177e-01),
+  fixed(9.39983753034014046790e-01),
+  fixed(9.39459223602189918978e-01),
+  fixed(9.38932483532064487974e-01),
+  fixed(9.38403534063108168972e-01),
+  fixed(9.37872376439989885455e-01),
+  fixed(9.37339011912574959773e-01),
+  fixed(9.36803441735921560429e-01),
+  fixed(9.36265667170278259590e-01),
+  fixed(9.35725689481080369347e-01),
+  fixed(9.35183509938947610252e-01),
+  fixed(9.34639129819680780642e-01),
+  fixed(9.34092550404258981089e-01),
+  fixed(9.33543772978836283727e-01),
+  fixed(9.32992798834738845670e-01),
+  fixed(9.32439629268462355505e-01),
+  fixed(9.31884265581668147505e-01),
+  fixed(9.31326709081180537098e-01),
+  fixed(9.30766961078983712241e-01),
+  fixed(9.30205022892219068886e-01),
+  fixed(9.29640895843181325198e-01),
+  fixed(9.29074581259315745996e-01),
+  fixed(9.28506080473215589244e-01),
+  fixed(9.27935394822617887201e-01),
+  fixed(9.27362525650401114952e-01),
+  fixed(9.26787474304581748719e-01),
+  fixed(9.26210242138311379279e-01),
+  fixed(9.25630830509872826184e-01),
+  fixed(9.25049240782677695272e-01),
+  fixed(9.24465474325262603905e-01),
+  fixed(9.23879532511286738483e-01),
+  fixed(9.23291416719527746615e-01),
+  fixed(9.22701128333878517473e-01),
+  fixed(9.22108668743345183394e-01),
+  fixed(9.21514039342042012848e-01),
+  fixed(9.20917241529189523064e-01),
+  fixed(9.20318276709110594247e-01),
+  fixed(9.19717146291227360955e-01),
+  fixed(9.19113851690057770405e-01),
+  fixed(9.18508394325212251807e-01),
+  fixed(9.17900775621390496717e-01),
+  fixed(9.17290997008378017341e-01),
+  fixed(9.16679059921042704850e-01),
+  fixed(9.16064965799331720753e-01),
+  fixed(9.15448716088267833157e-01),
+  fixed(9.14830312237946197129e-01),
+  fixed(9.14209755703530690951e-01),
+  fixed(9.13587047945250807501e-01),
+  fixed(9.12962190428398212561e-01),
+  fixed(9.12335184623322859032e-01),
+  fixed(9.11706032005429878318e-01),
+  fixed(9.11074734055176360670e-01),
+  fixed(9.10441292258067247367e-01),
+  fixed(9.09805708104652333112e-01),
+  fixed(9.09167983090522491274e-01),
+  fixed(9.08528118716306121172e-01),
+  fixed(9.07886116487666150476e-01),
+  fixed(9.07241977915295927382e-01),
+  fixed(9.06595704514915334826e-01),
+  fixed(9.05947297807268570047e-01),
+  fixed(9.05296759318118815507e-01),
+  fixed(9.04644090578246129475e-01),
+  fixed(9.03989293123443449218e-01),
+  fixed(9.03332368494511817048e-01),
+  fixed(9.02673318237258826002e-01),
+  fixed(9.02012143902493290781e-01),
+  fixed(9.01348847046022028096e-01),
+  fixed(9.00683429228646859066e-01),
+  fixed(9.00015892016160279354e-01),
+  fixed(8.99346236979341573381e-01),
+  fixed(8.98674465693953927747e-01),
+  fixed(8.98000579740739879320e-01),
+  fixed(8.97324580705418317628e-01),
+  fixed(8.96646470178680266017e-01),
+  fixed(8.95966249756185217912e-01),
+  fixed(8.95283921038557473082e-01),
+  fixed(8.94599485631382806972e-01),
+  fixed(8.93912945145203252650e-01),
+  fixed(8.93224301195515213436e-01),
+  fixed(8.92533555402764688935e-01),
+  fixed(8.91840709392342723127e-01),
+  fixed(8.91145764794583405966e-01),
+  fixed(8.90448723244757989193e-01),
+  fixed(8.89749586383072776918e-01),
+  fixed(8.89048355854664684728e-01),
+  fixed(8.88345033309596354698e-01),
+  fixed(8.87639620402853934955e-01),
+  fixed(8.86932118794342305712e-01),
+  fixed(8.86222530148880638379e-01),
+  fixed(8.85510856136199842048e-01),
+  fixed(8.84797098430937900559e-01),
+  fixed(8.84081258712634987518e-01),
+  fixed(8.83363338665731689936e-01),
+  fixed(8.82643339979562902009e-01),
+  fixed(8.81921264348355049556e-01),
+  fixed(8.81197113471222204240e-01),
+  fixed(8.80470889052160865518e-01),
+  fixed(8.79742592800047407131e-01),
+  fixed(8.79012226428633525188e-01),
+  fixed(8.78279791656541575229e-01),
+  fixed(8.77545290207261241555e-01),
+  fixed(8.76808723809145762473e-01),
+  fixed(8.76070094195406601223e-01),
+  fixed(8.75329403104111003486e-01),
+  fixed(8.74586652278176224229e-01),
+  fixed(8.73841843465366863164e-01),
+  fixed(8.73094978418290201816e-01),
+  fixed(8.72346058894391540584e-01),
+  fixed(8.71595086655950979093e-01),
+  fixed(8.70842063470078975307e-01),
+  fixed(8.70086991108711460541e-01),
+  fixed(8.69329871348606730841e-01),
+  fixed(8.68570705971341006091e-01),
+  fixed(8.67809496763303211964e-01),
+  fixed(8.67046245515692759476e-01),
+  fixed(8.66280954024513105693e-01),
+  fixed(8.65513624090569089198e-01),
+  fixed(8.64744257519462489192e-01),
+  fixed(8.63972856121586807454e-01),
+  fixed(8.63199421712124159711e-01),
+  fixed(8.62423956111040612704e-01),
+  fixed(8.61646461143081299205e-01),
+  fixed(8.60866938637767198372e-01),
+  fixed(8.60085390429390250766e-01),
+  fixed(8.59301818357008362348e-01),
+  fixed(8.58516224264442961989e-01),
+  fixed(8.57728610000272118086e-01),
+  fixed(8.56938977417828762206e-01),
+  fixed(8.56147328375194582861e-01),
+  fixed(8.55353664735196028701e-01),
+  fixed(8.54557988365400533759e-01),
+  fixed(8.53760301138111521446e-01),
+  fixed(8.52960604930363741616e-01),
+  fixed(8.52158901623919717849e-01),
+  fixed(8.51355193105265195541e-01),
+  fixed(8.50549481265603479763e-01),
+  fixed(8.49741768000852659704e-01),
+  fixed(8.48932055211639724490e-01),
+  fixed(8.48120344803297232517e-01),
+  fixed(8.47306638685858537485e-01),
+  fixed(8.46490938774052126270e-01),
+  fixed(8.45673246987299065403e-01),
+  fixed(8.44853565249707227913e-01),
+  fixed(8.44031895490066408350e-01),
+  fixed(8.43208239641845436196e-01),
+  fixed(8.42382599643185958627e-01),
+  fixed(8.41554977436898443699e-01),
+  fixed(8.40725374970458183554e-01),
+  fixed(8.39893794195999632279e-01),
+  fixed(8.39060237070312631147e-01),
+  fixed(8.38224705554838189769e-01),
+  fixed(8.37387201615661935783e-01),
+  fixed(8.36547727223512005423e-01),
+  fixed(8.35706284353752715255e-01),
+  fixed(8.34862874986380121278e-01),
+  fixed(8.34017501106018022128e-01),
+  fixed(8.33170164701913296135e-01),
+  fixed(8.32320867767929684078e-01),
+  fixed(8.31469612302545457716e-01),
+  fixed(8.30616400308846314360e-01),
+  fixed(8.29761233794523045404e-01),
+  fixed(8.28904114771865097033e-01),
+  fixed(8.28045045257755796264e-01),
+  fixed(8.27184027273669131297e-01),
+  fixed(8.26321062845663645291e-01),
+  fixed(8.25456154004377551381e-01),
+  fixed(8.24589302785025179965e-01),
+  fixed(8.23720511227391538611e-01),
+  fixed(8.22849781375826316854e-01),
+  fixed(8.21977115279241443702e-01),
+  fixed(8.21102514991104759368e-01),
+  fixed(8.20225982569434686198e-01),
+  fixed(8.19347520076797120048e-01),
+  fixed(8.18467129580298768943e-01),
+  fixed(8.17584813151583711388e-01),
+  fixed(8.16700572866827956275e-01),
+  fixed(8.15814410806733780746e-01),
+  fixed(8.14926329056526510541e-01),
+  fixed(8.14036329705948524804e-01),
+  fixed(8.13144414849253593935e-01),
+  fixed(8.12250586585203881995e-01),
+  fixed(8.11354847017063840475e-01),
+  fixed(8.10457198252594768206e-01),
+  fixed(8.09557642404051480689e-01),
+  fixed(8.08656181588175093644e-01),
+  fixed(8.07752817926190358477e-01),
+  fixed(8.06847553543799445031e-01),
+  fixed(8.05940390571176390466e-01),
+  fixed(8.05031331142963546554e-01),
+  fixed(8.04120377398265806512e-01),
+  fixed(8.03207531480644942867e-01),
+  fixed(8.02292795538115610654e-01),
+  fixed(8.01376171723140351411e-01),
+  fixed(8.00457662192622820818e-01),
+  fixed(7.99537269107905235188e-01),
+  fixed(7.98614994634760932968e-01),
+  fixed(7.97690840943391044071e-01),
+  fixed(7.96764810208418938764e-01),
+  fixed(7.95836904608883566326e-01),
+  fixed(7.94907126328236901536e-01),
+  fixed(7.93975477554337283337e-01),
+  fixed(7.93041960479443641674e-01),
+  fixed(7.92106577300212277848e-01),
+  fixed(7.91169330217690314200e-01),
+  fixed(7.90230221437310031973e-01),
+  fixed(7.89289253168885873713e-01),
+  fixed(7.88346427626606338634e-01),
+  fixed(7.87401747029031318093e-01),
+  fixed(7.86455213599085878329e-01),
+  fixed(7.85506829564054043225e-01),
+  fixed(7.84556597155575130564e-01),
+  fixed(7.83604518609638311943e-01),
+  fixed(7.82650596166575729384e-01),
+  fixed(7.81694832071059275691e-01),
+  fixed(7.80737228572094599244e-01),
+  fixed(7.79777787923014442661e-01),
+  fixed(7.78816512381476089288e-01),
+  fixed(7.77853404209453147544e-01),
+  fixed(7.76888465673232442299e-01),
+  fixed(7.75921699043407797625e-01),
+  fixed(7.74953106594873930568e-01),
+  fixed(7.73982690606822787416e-01),
+  fixed(7.73010453362737104399e-01),
+  fixed(7.72036397150384523513e-01),
+  fixed(7.71060524261813706737e-01),
+  fixed(7.70082836993348007759e-01),
+  fixed(7.69103337645579587800e-01),
+  fixed(7.68122028523365529828e-01),
+  fixed(7.67138911935820511090e-01),
+  fixed(7.66153990196312917327e-01),
+  fixed(7.65167265622459069618e-01),
+  fixed(7.64178740536116785087e-01),
+  fixed(7.63188417263381269073e-01),
+  fixed(7.62196298134579008909e-01),
+  fixed(7.61202385484261889737e-01),
+  fixed(7.60206681651202309524e-01),
+  fixed(7.59209188978388183067e-01),
+  fixed(7.58209909813015281443e-01),
+  fixed(7.57208846506484678507e-01),
+  fixed(7.56206001414394535232e-01),
+  fixed(7.55201376896536547001e-01),
+  fixed(7.54194975316889282269e-01),
+  fixed(7.53186799043612520421e-01),
+  fixed(7.52176850449042699864e-01),
+  fixed(7.51165131909686589751e-01),
+  fixed(7.50151645806215072732e-01),
+  fixed(7.49136394523459259176e-01),
+  fixed(7.48119380450403714811e-01),
+  fixed(7.47100605980180132448e-01),
+  fixed(7.46080073510064001319e-01),
+  fixed(7.45057785441466058352e-01),
+  fixed(7.44033744179929290574e-01),
+  fixed(7.43007952135121829684e-01),
+  fixed(7.41980411720831067868e-01),
+  fixed(7.40951125354958994862e-01),
+  fixed(7.39920095459516313774e-01),
+  fixed(7.38887324460615224631e-01),
+  fixed(7.37852814788465871665e-01),
+  fixed(7.36816568877370015045e-01),
+  fixed(7.35778589165713481357e-01),
+  fixed(7.34738878095963610093e-01),
+  fixed(7.33697438114660371866e-01),
+  fixed(7.32654271672412815697e-01),
+  fixed(7.31609381223892740742e-01),
+  fixed(7.30562769227827590868e-01),
+  fixed(7.29514438146997012957e-01),
+  fixed(7.28464390448225307395e-01),
+  fixed(7.27412628602375765929e-01),
+  fixed(7.26359155084345897713e-01),
+  fixed(7.25303972373060878986e-01),
+  fixed(7.24247082951466891743e-01),
+  fixed(7.23188489306527571010e-01),
+  fixed(7.22128193929215456137e-01),
+  fixed(7.21066199314508105012e-01),
+  fixed(7.20002507961381765789e-01),
+  fixed(7.18937122372804493509e-01),
+  fixed(7.17870045055731709205e-01),
+  fixed(7.16801278521099649588e-01),
+  fixed(7.15730825283818705707e-01),
+  fixed(7.14658687862768982058e-01),
+  fixed(7.13584868780793746268e-01),
+  fixed(7.12509370564692323669e-01),
+  fixed(7.11432195745216655602e-01),
+  fixed(7.10353346857062417641e-01),
+  fixed(7.09272826438865577892e-01),
+  fixed(7.08190637033195513617e-01),
+  fixed(7.07106781186547572737e-01),
+  fixed(7.06021261449339743166e-01),
+  fixed(7.04934080375905103288e-01),
+  fixed(7.03845240524485049605e-01),
+  fixed(7.02754744457225188903e-01),
+  fixed(7.01662594740168676921e-01),
+  fixed(7.00568793943248335765e-01),
+  fixed(6.99473344640283989371e-01),
+  fixed(6.98376249408972915589e-01),
+  fixed(6.97277510830886515514e-01),
+  fixed(6.96177131491463097035e-01),
+  fixed(6.95075113980000991454e-01),
+  fixed(6.93971460889654001569e-01),
+  fixed(6.92866174817424851362e-01),
+  fixed(6.91759258364157858523e-01),
+  fixed(6.90650714134534604582e-01),
+  fixed(6.89540544737067051528e-01),
+  fixed(6.88428752784090436379e-01),
+  fixed(6.87315340891759274378e-01),
+  fixed(6.86200311680038699258e-01),
+  fixed(6.85083667772700355414e-01),
+  fixed(6.83965411797315625542e-01),
+  fixed(6.82845546385248192145e-01),
+  fixed(6.81724074171649707665e-01),
+  fixed(6.80600997795453244166e-01),
+  fixed(6.79476319899365077681e-01),
+  fixed(6.78350043129861357549e-01),
+  fixed(6.77222170137180556893e-01),
+  fixed(6.76092703575315923104e-01),
+  fixed(6.74961646102012258197e-01),
+  fixed(6.73829000378756148848e-01),
+  fixed(6.72694769070772857766e-01),
+  fixed(6.71558954847018552137e-01),
+  fixed(6.70421560380173198190e-01),
+  fixed(6.69282588346636009291e-01),
+  fixed(6.68142041426518673575e-01),
+  fixed(6.66999922303637582388e-01),
+  fixed(6.65856233665509611441e-01),
+  fixed(6.64710978203345015380e-01),
+  fixed(6.63564158612039767249e-01),
+  fixed(6.62415777590172005773e-01),
+  fixed(6.61265837839992376423e-01),
+  fixed(6.60114342067420478699e-01),
+  fixed(6.58961292982037538657e-01),
+  fixed(6.57806693297078748373e-01),
+  fixed(6.56650545729429047093e-01),
+  fixed(6.55492852999615571719e-01),
+  fixed(6.54333617831800551379e-01),
+  fixed(6.53172842953776644492e-01),
+  fixed(6.52010531096959722319e-01),
+  fixed(6.50846684996380986377e-01),
+  fixed(6.49681307390683415726e-01),
+  fixed(6.48514401022112552120e-01),
+  fixed(6.47345968636512059113e-01),
+  fixed(6.46176012983316616634e-01),
+  fixed(6.45004536815544038397e-01),
+  fixed(6.43831542889791386131e-01),
+  fixed(6.42657033966227086985e-01),
+  fixed(6.41481012808583161977e-01),
+  fixed(6.40303482184151562251e-01),
+  fixed(6.39124444863775842407e-01),
+  fixed(6.37943903621844055074e-01),
+  fixed(6.36761861236284421039e-01),
+  fixed(6.35578320488556225420e-01),
+  fixed(6.34393284163645487794e-01),
+  fixed(6.33206755050057412681e-01),
+  fixed(6.32018735939809062074e-01),
+  fixed(6.30829229628424470455e-01),
+  fixed(6.29638238914927206302e-01),
+  fixed(6.28445766601832711551e-01),
+  fixed(6.27251815495144082746e-01),
+  fixed(6.26056388404343633347e-01),
+  fixed(6.24859488142386343412e-01),
+  fixed(6.23661117525694863595e-01),
+  fixed(6.22461279374150078247e-01),
+  fixed(6.21259976511087552709e-01),
+  fixed(6.20057211763289428674e-01),
+  fixed(6.18852987960976430593e-01),
+  fixed(6.17647307937803868860e-01),
+  fixed(6.16440174530853757240e-01),
+  fixed(6.15231590580626930276e-01),
+  fixed(6.14021558931038380358e-01),
+  fixed(6.12810082429409819227e-01),
+  fixed(6.11597163926461906414e-01),
+  fixed(6.10382806276309697324e-01),
+  fixed(6.09167012336453317367e-01),
+  fixed(6.07949784967773632083e-01),
+  fixed(6.06731127034524697628e-01),
+  fixed(6.05511041404325656146e-01),
+  fixed(6.04289530948155961809e-01),
+  fixed(6.03066598540348386415e-01),
+  fixed(6.01842247058580137598e-01),
+  fixed(6.00616479383868862030e-01),
+  fixed(5.99389298400564651814e-01),
+  fixed(5.98160706996342383945e-01),
+  fixed(5.96930708062196724306e-01),
+  fixed(5.95699304492433467928e-01),
+  fixed(5.94466499184664431965e-01),
+  fixed(5.93232295039800017200e-01),
+  fixed(5.91996694962040992394e-01),
+  fixed(5.90759701858874164415e-01),
+  fixed(5.89521318641064051569e-01),
+  fixed(5.88281548222645334079e-01),
+  fixed(5.87040393520917969106e-01),
+  fixed(5.85797857456438975099e-01),
+  fixed(5.84553942953015326367e-01),
+  fixed(5.83308652937698512986e-01),
+  fixed(5.82061990340775659014e-01),
+  fixed(5.80813958095764526490e-01),
+  fixed(5.79564559139405965915e-01),
+  fixed(5.78313796411655700602e-01),
+  fixed(5.77061672855679441696e-01),
+  fixed(5.75808191417845449678e-01),
+  fixed(5.74553355047715874626e-01),
+  fixed(5.73297166698042093280e-01),
+  fixed(5.72039629324757270545e-01),
+  fixed(5.70780745886967255665e-01),
+  fixed(5.69520519346947473593e-01),
+  fixed(5.68258952670131711749e-01),
+  fixed(5.66996048825108678315e-01),
+  fixed(5.65731810783613453530e-01),
+  fixed(5.64466241520519496078e-01),
+  fixed(5.63199344013834091172e-01),
+  fixed(5.61931121244689579797e-01),
+  fixed(5.60661576197336142258e-01),
+  fixed(5.59390711859136025019e-01),
+  fixed(5.58118531220556324257e-01),
+  fixed(5.56845037275160104073e-01),
+  fixed(5.55570233019602177649e-01),
+  fixed(5.54294121453620225459e-01),
+  fixed(5.53016705580027578826e-01),
+  fixed(5.51737988404707668799e-01),
+  fixed(5.50457972936604922332e-01),
+  fixed(5.49176662187719655250e-01),
+  fixed(5.47894059173100411719e-01),
+  fixed(5.46610166910834971432e-01),
+  fixed(5.45324988422046352810e-01),
+  fixed(5.44038526730884042237e-01),
+  fixed(5.42750784864515889439e-01),
+  fixed(5.41461765853123333514e-01),
+  fixed(5.40171472729892965248e-01),
+  fixed(5.38879908531008422479e-01),
+  fixed(5.37587076295645727164e-01),
+  fixed(5.36292979065963293372e-01),
+  fixed(5.34997619887097153324e-01),
+  fixed(5.33701001807153185830e-01),
+  fixed(5.32403127877198012463e-01),
+  fixed(5.31104001151254889734e-01),
+  fixed(5.29803624686294827306e-01),
+  fixed(5.28502001542228483366e-01),
+  fixed(5.27199134781901279645e-01),
+  fixed(5.25895027471084852699e-01),
+  fixed(5.24589682678468949284e-01),
+  fixed(5.23283103475656652392e-01),
+  fixed(5.21975292937154500272e-01),
+  fixed(5.20666254140367157355e-01),
+  fixed(5.19355990165589753715e-01),
+  fixed(5.18044504095999447379e-01),
+  fixed(5.16731799017649762185e-01),
+  fixed(5.15417878019463149286e-01),
+  fixed(5.14102744193221772306e-01),
+  fixed(5.12786400633562955420e-01),
+  fixed(5.11468850437970523615e-01),
+  fixed(5.10150096706766809085e-01),
+  fixed(5.08830142543107322162e-01),
+  fixed(5.07508991052970981350e-01),
+  fixed(5.06186645345155228348e-01),
+  fixed(5.04863108531267701373e-01),
+  fixed(5.03538383725717686445e-01),
+  fixed(5.02212474045710677295e-01),
+  fixed(5.00885382611240936868e-01),
+  fixed(4.99557112545081949406e-01),
+  fixed(4.98227666972781757515e-01),
+  fixed(4.96897049022654690997e-01),
+  fixed(4.95565261825772540583e-01),
+  fixed(4.94232308515960006012e-01),
+  fixed(4.92898192229784148921e-01),
+  fixed(4.91562916106549896433e-01),
+  fixed(4.90226483288291381424e-01),
+  fixed(4.88888896919763282778e-01),
+  fixed(4.87550160148435884899e-01),
+  fixed(4.86210276124486584504e-01),
+  fixed(4.84869248000791119857e-01),
+  fixed(4.83527078932918630283e-01),
+  fixed(4.82183772079122885401e-01),
+  fixed(4.80839330600333958454e-01),
+  fixed(4.79493757660153285816e-01),
+  fixed(4.78147056424843175382e-01),
+  fixed(4.76799230063322088125e-01),
+  fixed(4.75450281747156089374e-01),
+  fixed(4.74100214650550078055e-01),
+  fixed(4.72749031950342735175e-01),
+  fixed(4.71396736825997864084e-01),
+  fixed(4.70043332459595675221e-01),
+  fixed(4.68688822035827845625e-01),
+  fixed(4.67333208741988581636e-01),
+  fixed(4.65976495767966181205e-01),
+  fixed(4.64618686306238093398e-01),
+  fixed(4.63259783551860315765e-01),
+  fixed(4.61899790702462731407e-01),
+  fixed(4.60538710958240227189e-01),
+  fixed(4.59176547521944200536e-01),
+  fixed(4.57813303598877174849e-01),
+  fixed(4.56448982396884139767e-01),
+  fixed(4.55083587126343891427e-01),
+  fixed(4.53717121000163758904e-01),
+  fixed(4.52349587233771055494e-01),
+  fixed(4.50980989045103863866e-01),
+  fixed(4.49611329654606872719e-01),
+  fixed(4.48240612285220052513e-01),
+  fixed(4.46868840162374159064e-01),
+  fixed(4.45496016513981962781e-01),
+  fixed(4.44122144570429311372e-01),
+  fixed(4.42747227564569967306e-01),
+  fixed(4.41371268731716892564e-01),
+  fixed(4.39994271309633311340e-01),
+  fixed(4.38616238538527547508e-01),
+  fixed(4.37237173661044253858e-01),
+  fixed(4.35857079922255530313e-01),
+  fixed(4.34475960569655983434e-01),
+  fixed(4.33093818853152068282e-01),
+  fixed(4.31710658025057258946e-01),
+  fixed(4.30326481340082889204e-01),
+  fixed(4.28941292055329603805e-01),
+  fixed(4.27555093430282029399e-01),
+  fixed(4.26167888726799837240e-01),
+  fixed(4.24779681209108861406e-01),
+  fixed(4.23390474143795936257e-01),
+  fixed(4.22000270799799848120e-01),
+  fixed(4.20609074448402564528e-01),
+  fixed(4.19216888363224238212e-01),
+  fixed(4.17823715820212437944e-01),
+  fixed(4.16429560097637152527e-01),
+  fixed(4.15034424476081853506e-01),
+  fixed(4.13638312238434613377e-01),
+  fixed(4.12241226669882832034e-01),
+  fixed(4.10843171057904132937e-01),
+  fixed(4.09444148692257647859e-01),
+  fixed(4.08044162864978576799e-01),
+  fixed(4.06643216870369195171e-01),
+  fixed(4.05241314004989916508e-01),
+  fixed(4.03838457567654407487e-01),
+  fixed(4.02434650859418596713e-01),
+  fixed(4.01029897183575623210e-01),
+  fixed(3.99624199845647065654e-01),
+  fixed(3.98217562153373672018e-01),
+  fixed(3.96809987416710252539e-01),
+  fixed(3.95401478947816520382e-01),
+  fixed(3.93992040061048154342e-01),
+  fixed(3.92581674072951414267e-01),
+  fixed(3.91170384302254037223e-01),
+  fixed(3.89758174069856466737e-01),
+  fixed(3.88345046698826579235e-01),
+  fixed(3.86931005514388748345e-01),
+  fixed(3.85516053843918848898e-01),
+  fixed(3.84100195016935319625e-01),
+  fixed(3.82683432365089892802e-01),
+  fixed(3.81265769222162320684e-01),
+  fixed(3.79847208924051382706e-01),
+  fixed(3.78427754808765670624e-01),
+  fixed(3.77007410216418148430e-01),
+  fixed(3.75586178489217381582e-01),
+  fixed(3.74164062971458044604e-01),
+  fixed(3.72741067009516091613e-01),
+  fixed(3.71317193951837709598e-01),
+  fixed(3.69892447148934100376e-01),
+  fixed(3.68466829953372598805e-01),
+  fixed(3.67040345719767291399e-01),
+  fixed(3.65612997804773798283e-01),
+  fixed(3.64184789567080113848e-01),
+  fixed(3.62755724367397280883e-01),
+  fixed(3.61325805568454172523e-01),
+  fixed(3.59895036534988332910e-01),
+  fixed(3.58463420633736595811e-01),
+  fixed(3.57030961233430310653e-01),
+  fixed(3.55597661704784018255e-01),
+  fixed(3.54163525420490399309e-01),
+  fixed(3.52728555755210948508e-01),
+  fixed(3.51292756085567203783e-01),
+  fixed(3.49856129790134862123e-01),
+  fixed(3.48418680249434786766e-01),
+  fixed(3.46980410845923736840e-01),
+  fixed(3.45541324963988982777e-01),
+  fixed(3.44101425989939035954e-01),
+  fixed(3.42660717311994433842e-01),
+  fixed(3.41219202320282688490e-01),
+  fixed(3.39776884406827017759e-01),
+  fixed(3.38333766965541182792e-01),
+  fixed(3.36889853392220328665e-01),
+  fixed(3.35445147084531714032e-01),
+  fixed(3.33999651442009382052e-01),
+  fixed(3.32553369866044445935e-01),
+  fixed(3.31106305759876484718e-01),
+  fixed(3.29658462528587437035e-01),
+  fixed(3.28209843579092719335e-01),
+  fixed(3.26760452320131844495e-01),
+  fixed(3.25310292162263259286e-01),
+  fixed(3.23859366517853020095e-01),
+  fixed(3.22407678801069852437e-01),
+  fixed(3.20955232427875492007e-01),
+  fixed(3.19502030816015802905e-01),
+  fixed(3.18048077385014893448e-01),
+  fixed(3.16593375556166067852e-01),
+  fixed(3.15137928752522500364e-01),
+  fixed(3.13681740398891406585e-01),
+  fixed(3.12224813921825106178e-01),
+  fixed(3.10767152749611530460e-01),
+  fixed(3.09308760312269004356e-01),
+  fixed(3.07849640041535033141e-01),
+  fixed(3.06389795370860917867e-01),
+  fixed(3.04929229735402651524e-01),
+  fixed(3.03467946572011426642e-01),
+  fixed(3.02005949319228028660e-01),
+  fixed(3.00543241417273676586e-01),
+  fixed(2.99079826308040530591e-01),
+  fixed(2.97615707435086140897e-01),
+  fixed(2.96150888243624010876e-01),
+  fixed(2.94685372180514382201e-01),
+  fixed(2.93219162694258961288e-01),
+  fixed(2.91752263234989428486e-01),
+  fixed(2.90284677254462386564e-01),
+  fixed(2.88816408206049757279e-01),
+  fixed(2.87347459544729622039e-01),
+  fixed(2.85877834727080559762e-01),
+  fixed(2.84407537211272098965e-01),
+  fixed(2.82936570457055447392e-01),
+  fixed(2.81464937925757885395e-01),
+  fixed(2.79992643080273440059e-01),
+  fixed(2.78519689385053170749e-01),
+  fixed(2.77046080306100228619e-01),
+  fixed(2.75571819310958310290e-01),
+  fixed(2.74096909868706384295e-01),
+  fixed(2.72621355449949254179e-01),
+  fixed(2.71145159526808121608e-01),
+  fixed(2.69668325572915090760e-01),
+  fixed(2.68190857063403398364e-01),
+  fixed(2.66712757474898476406e-01),
+  fixed(2.65234030285511734881e-01),
+  fixed(2.63754678974831568983e-01),
+  fixed(2.62274707023913700166e-01),
+  fixed(2.60794117915275847075e-01),
+  fixed(2.59312915132886401270e-01),
+  fixed(2.57831102162158987134e-01),
+  fixed(2.56348682489943191509e-01),
+  fixed(2.54865659604514682712e-01),
+  fixed(2.53382036995570103510e-01),
+  fixed(2.51897818154217190134e-01),
+  fixed(2.50413006572965335383e-01),
+  fixed(2.48927605745720093022e-01),
+  fixed(2.47441619167773491084e-01),
+  fixed(2.45955050335794650485e-01),
+  fixed(2.44467902747824483711e-01),
+  fixed(2.42980179903264065233e-01),
+  fixed(2.41491885302869357943e-01),
+  fixed(2.40003022448741776262e-01),
+  fixed(2.38513594844318554955e-01),
+  fixed(2.37023605994367170258e-01),
+  fixed(2.35533059404975736451e-01),
+  fixed(2.34041958583543513450e-01),
+  fixed(2.32550307038775161406e-01),
+  fixed(2.31058108280671331558e-01),
+  fixed(2.29565365820518924034e-01),
+  fixed(2.28072083170886064085e-01),
+  fixed(2.26578263845610167193e-01),
+  fixed(2.25083911359792832041e-01),
+  fixed(2.23589029229790292597e-01),
+  fixed(2.22093620973203648150e-01),
+  fixed(2.20597690108873506487e-01),
+  fixed(2.19101240156870047393e-01),
+  fixed(2.17604274638483724535e-01),
+  fixed(2.16106797076219436793e-01),
+  fixed(2.14608810993786980337e-01),
+  fixed(2.13110319916091417447e-01),
+  fixed(2.11611327369227886219e-01),
+  fixed(2.10111836880469804445e-01),
+  fixed(2.08611851978263512786e-01),
+  fixed(2.07111376192218837877e-01),
+  fixed(2.05610413053099377878e-01),
+  fixed(2.04108966092816840332e-01),
+  fixed(2.02607038844421383228e-01),
+  fixed(2.01104634842092011571e-01),
+  fixed(1.99601757621130915243e-01),
+  fixed(1.98098410717953810067e-01),
+  fixed(1.96594597670080278862e-01),
+  fixed(1.95090322016128608906e-01),
+  fixed(1.93585587295803801533e-01),
+  fixed(1.92080397049892465100e-01),
+  fixed(1.90574754820253072785e-01),
+  fixed(1.89068664149806359154e-01),
+  fixed(1.87562128582529574761e-01),
+  fixed(1.86055151663446910471e-01),
+  fixed(1.84547736938619699743e-01),
+  fixed(1.83039887955140895270e-01),
+  fixed(1.81531608261125215753e-01),
+  fixed(1.80022901405699570221e-01),
+  fixed(1.78513770938997423654e-01),
+  fixed(1.77004220412148943753e-01),
+  fixed(1.75494253377271453020e-01),
+  fixed(1.73983873387464127447e-01),
+  fixed(1.72473083996796117123e-01),
+  fixed(1.70961888760301217172e-01),
+  fixed(1.69450291233968208804e-01),
+  fixed(1.67938294974731283649e-01),
+  fixed(1.66425903540464048547e-01),
+  fixed(1.64913120489970144167e-01),
+  fixed(1.63399949382973280754e-01),
+  fixed(1.61886393780111742524e-01),
+  fixed(1.60372457242928451171e-01),
+  fixed(1.58858143333861473456e-01),
+  fixed(1.57343455616238553363e-01),
+  fixed(1.55828397654265371486e-01),
+  fixed(1.54312973013020077184e-01),
+  fixed(1.52797185258443685152e-01),
+  fixed(1.51281037957330305455e-01),
+  fixed(1.49764534677321453637e-01),
+  fixed(1.48247678986896253006e-01),
+  fixed(1.46730474455361803443e-01),
+  fixed(1.45212924652847352736e-01),
+  fixed(1.43695033150294637636e-01),
+  fixed(1.42176803519448086144e-01),
+  fixed(1.40658239332849543946e-01),
+  fixed(1.39139344163826339518e-01),
+  fixed(1.37620121586486038323e-01),
+  fixed(1.36100575175706478559e-01),
+  fixed(1.34580708507126278750e-01),
+  fixed(1.33060525157139009078e-01),
+  fixed(1.31540028702883338152e-01),
+  fixed(1.30019222722233429579e-01),
+  fixed(1.28498110793793085538e-01),
+  fixed(1.26976696496886060084e-01),
+  fixed(1.25454983411546261429e-01),
+  fixed(1.23932975118512478385e-01),
+  fixed(1.22410675199216348319e-01),
+  fixed(1.20888087235777055839e-01),
+  fixed(1.19365214810991632222e-01),
+  fixed(1.17842061508325088304e-01),
+  fixed(1.16318630911904710712e-01),
+  fixed(1.14794926606510305778e-01),
+  fixed(1.13270952177564415697e-01),
+  fixed(1.11746711211126503738e-01),
+  fixed(1.10222207293883239787e-01),
+  fixed(1.08697444013138744268e-01),
+  fixed(1.07172424956809161922e-01),
+  fixed(1.05647153713410754672e-01),
+  fixed(1.04121633872054572545e-01),
+  fixed(1.02595869022436558815e-01),
+  fixed(1.01069862754827932694e-01),
+  fixed(9.95436186600692773929e-02),
+  fixed(9.80171403295608256734e-02),
+  fixed(9.64904313552526621267e-02),
+  fixed(9.49634953296389083821e-02),
+  fixed(9.34363358457479670216e-02),
+  fixed(9.19089564971327516174e-02),
+  fixed(9.03813608778652882725e-02),
+  fixed(8.88535525825247529674e-02),
+  fixed(8.73255352061920592233e-02),
+  fixed(8.57973123444401575277e-02),
+  fixed(8.42688875933241821059e-02),
+  fixed(8.27402645493756361272e-02),
+  fixed(8.12114468095926633762e-02),
+  fixed(7.96824379714301950228e-02),
+  fixed(7.81532416327941487078e-02),
+  fixed(7.66238613920316863348e-02),
+  fixed(7.50943008479213469641e-02),
+  fixed(7.35645635996677316193e-02),
+  fixed(7.20346532468894712453e-02),
+  fixed(7.05045733896138560048e-02),
+  fixed(6.89743276282670236821e-02),
+  fixed(6.74439195636641758425e-02),
+  fixed(6.59133527970037630395e-02),
+  fixed(6.43826309298577009743e-02),
+  fixed(6.28517575641614895110e-02),
+  fixed(6.13207363022084880888e-02),
+  fixed(5.97895707466400694319e-02),
+  fixed(5.82582645004357940755e-02),
+  fixed(5.67268211669080674175e-02),
+  fixed(5.51952443496900937991e-02),
+  fixed(5.36635376527305196781e-02),
+  fixed(5.21317046802835942776e-02),
+  fixed(5.05997490368993926846e-02),
+  fixed(4.90676743274179663623e-02),
+  fixed(4.75354841569595384931e-02),
+  fixed(4.60031821309147062604e-02),
+  fixed(4.44707718549385844220e-02),
+  fixed(4.29382569349410214699e-02),
+  fixed(4.14056409770767741563e-02),
+  fixed(3.98729275877401298511e-02),
+  fixed(3.83401203735528536831e-02),
+  fixed(3.68072229413588317137e-02),
+  fixed(3.52742388982142315856e-02),
+  fixed(3.37411718513777048045e-02),
+  fixed(3.22080254083045441904e-02),
+  fixed(3.06748031766368653428e-02),
+  fixed(2.91415087641938019836e-02),
+  fixed(2.76081457789656599389e-02),
+  fixed(2.60747178291040986042e-02),
+  fixed(2.45412285229123262875e-02),
+  fixed(2.30076814688396948105e-02),
+  fixed(2.14740802754696674670e-02),
+  fixed(1.99404285515144379104e-02),
+  fixed(1.84067299058051012106e-02),
+  fixed(1.68729879472818353192e-02),
+  fixed(1.53392062849880602554e-02),
+  fixed(1.38053885280606317143e-02),
+  fixed(1.22715382857200069194e-02),
+  fixed(1.07376591672644107478e-02),
+  fixed(9.20375478206002066439e-03),
+  fixed(7.66982873953113777898e-03),
+  fixed(6.13588464915479879502e-03),
+  fixed(4.60192612044873269189e-03),
+  fixed(3.06795676296597701060e-03),
+  fixed(1.53398018628504934427e-03),
+  fixed(1.22464679914735320717e-16),
+  fixed(-1.53398018628480431458e-03),
+  fixed(-3.06795676296573241459e-03),
+  fixed(-4.60192612044848809588e-03),
+  fixed(-6.13588464915455419901e-03),
+  fixed(-7.66982873953089318297e-03),
+  fixed(-9.20375478205977606838e-03),
+  fixed(-1.07376591672641661518e-02),
+  fixed(-1.22715382857197623234e-02),
+  fixed(-1.38053885280603871183e-02),
+  fixed(-1.53392062849878156594e-02),
+  fixed(-1.68729879472815889885e-02),
+  fixed(-1.84067299058048583493e-02),
+  fixed(-1.99404285515141915797e-02),
+  fixed(-2.14740802754694211363e-02),
+  fixed(-2.30076814688394484798e-02),
+  fixed(-2.45412285229120799568e-02),
+  fixed(-2.60747178291038557429e-02),
+  fixed(-2.76081457789654136081e-02),
+  fixed(-2.91415087641935556528e-02),
+  fixed(-3.06748031766366190121e-02),
+  fixed(-3.22080254083042943902e-02),
+  fixed(-3.37411718513774550043e-02),
+  fixed(-3.52742388982139817855e-02),
+  fixed(-3.68072229413585819136e-02),
+  fixed(-3.83401203735526108218e-02),
+  fixed(-3.98729275877398869898e-02),
+  fixed(-4.14056409770765312950e-02),
+  fixed(-4.29382569349407786086e-02),
+  fixed(-4.44707718549383346218e-02),
+  fixed(-4.60031821309144564602e-02),
+  fixed(-4.75354841569592956319e-02),
+  fixed(-4.90676743274177235010e-02),
+  fixed(-5.05997490368991498233e-02),
+  fixed(-5.21317046802833514163e-02),
+  fixed(-5.36635376527302768168e-02),
+  fixed(-5.51952443496898509379e-02),
+  fixed(-5.67268211669078176174e-02),
+  fixed(-5.82582645004355512142e-02),
+  fixed(-5.97895707466398265706e-02),
+  fixed(-6.13207363022082452275e-02),
+  fixed(-6.28517575641612397108e-02),
+  fixed(-6.43826309298574511741e-02),
+  fixed(-6.59133527970035271171e-02),
+  fixed(-6.74439195636639260423e-02),
+  fixed(-6.89743276282667738819e-02),
+  fixed(-7.05045733896136062047e-02),
+  fixed(-7.20346532468892353229e-02),
+  fixed(-7.35645635996674956969e-02),
+  fixed(-7.50943008479210971640e-02),
+  fixed(-7.66238613920314365346e-02),
+  fixed(-7.81532416327938989076e-02),
+  fixed(-7.96824379714299452226e-02),
+  fixed(-8.12114468095924274538e-02),
+  fixed(-8.27402645493754002048e-02),
+  fixed(-8.42688875933239323057e-02),
+  fixed(-8.57973123444399216053e-02),
+  fixed(-8.73255352061918094231e-02),
+  fixed(-8.88535525825245031672e-02),
+  fixed(-9.03813608778650523501e-02),
+  fixed(-9.19089564971325156950e-02),
+  fixed(-9.34363358457477310992e-02),
+  fixed(-9.49634953296386585819e-02),
+  fixed(-9.64904313552524123265e-02),
+  fixed(-9.80171403295605897510e-02),
+  fixed(-9.95436186600690414705e-02),
+  fixed(-1.01069862754827682894e-01),
+  fixed(-1.02595869022436309015e-01),
+  fixed(-1.04121633872054322745e-01),
+  fixed(-1.05647153713410518749e-01),
+  fixed(-1.07172424956808912122e-01),
+  fixed(-1.08697444013138494467e-01),
+  fixed(-1.10222207293883003865e-01),
+  fixed(-1.11746711211126253938e-01),
+  fixed(-1.13270952177564165897e-01),
+  fixed(-1.14794926606510069855e-01),
+  fixed(-1.16318630911904474790e-01),
+  fixed(-1.17842061508324838504e-01),
+  fixed(-1.19365214810991382421e-01),
+  fixed(-1.20888087235776819917e-01),
+  fixed(-1.22410675199216098519e-01),
+  fixed(-1.23932975118512228585e-01),
+  fixed(-1.25454983411546011629e-01),
+  fixed(-1.26976696496885810284e-01),
+  fixed(-1.28498110793792835738e-01),
+  fixed(-1.30019222722233179779e-01),
+  fixed(-1.31540028702883088352e-01),
+  fixed(-1.33060525157138759278e-01),
+  fixed(-1.34580708507126056706e-01),
+  fixed(-1.36100575175706228759e-01),
+  fixed(-1.37620121586485788523e-01),
+  fixed(-1.39139344163826117473e-01),
+  fixed(-1.40658239332849294145e-01),
+  fixed(-1.42176803519447836344e-01),
+  fixed(-1.43695033150294387836e-01),
+  fixed(-1.45212924652847130691e-01),
+  fixed(-1.46730474455361581398e-01),
+  fixed(-1.48247678986896030962e-01),
+  fixed(-1.49764534677321203837e-01),
+  fixed(-1.51281037957330083410e-01),
+  fixed(-1.52797185258443435352e-01),
+  fixed(-1.54312973013019827384e-01),
+  fixed(-1.55828397654265121686e-01),
+  fixed(-1.57343455616238303563e-01),
+  fixed(-1.58858143333861223656e-01),
+  fixed(-1.60372457242928201371e-01),
+  fixed(-1.61886393780111492724e-01),
+  fixed(-1.63399949382973058709e-01),
+  fixed(-1.64913120489969894367e-01),
+  fixed(-1.66425903540463826502e-01),
+  fixed(-1.67938294974731033848e-01),
+  fixed(-1.69450291233967986759e-01),
+  fixed(-1.70961888760300967371e-01),
+  fixed(-1.72473083996795867323e-01),
+  fixed(-1.73983873387463877647e-01),
+  fixed(-1.75494253377271203220e-01),
+  fixed(-1.77004220412148693953e-01),
+  fixed(-1.78513770938997173854e-01),
+  fixed(-1.80022901405699348176e-01),
+  fixed(-1.81531608261124965953e-01),
+  fixed(-1.83039887955140645470e-01),
+  fixed(-1.84547736938619477698e-01),
+  fixed(-1.86055151663446660670e-01),
+  fixed(-1.87562128582529324961e-01),
+  fixed(-1.89068664149806109354e-01),
+  fixed(-1.90574754820252822984e-01),
+  fixed(-1.92080397049892215300e-01),
+  fixed(-1.93585587295803551733e-01),
+  fixed(-1.95090322016128359106e-01),
+  fixed(-1.96594597670080029062e-01),
+  fixed(-1.98098410717953560267e-01),
+  fixed(-1.99601757621130665443e-01),
+  fixed(-2.01104634842091761771e-01),
+  fixed(-2.02607038844421133428e-01),
+  fixed(-2.04108966092816618287e-01),
+  fixed(-2.05610413053099155833e-01),
+  fixed(-2.07111376192218588077e-01),
+  fixed(-2.08611851978263262986e-01),
+  fixed(-2.10111836880469554645e-01),
+  fixed(-2.11611327369227664175e-01),
+  fixed(-2.13110319916091195402e-01),
+  fixed(-2.14608810993786730537e-01),
+  fixed(-2.16106797076219214748e-01),
+  fixed(-2.17604274638483474735e-01),
+  fixed(-2.19101240156869797593e-01),
+  fixed(-2.20597690108873256687e-01),
+  fixed(-2.22093620973203426106e-01),
+  fixed(-2.23589029229790042796e-01),
+  fixed(-2.25083911359792609996e-01),
+  fixed(-2.26578263845609917393e-01),
+  fixed(-2.28072083170885814285e-01),
+  fixed(-2.29565365820518701989e-01),
+  fixed(-2.31058108280671081758e-01),
+  fixed(-2.32550307038774939361e-01),
+  fixed(-2.34041958583543263650e-01),
+  fixed(-2.35533059404975514406e-01),
+  fixed(-2.37023605994366948213e-01),
+  fixed(-2.38513594844318332910e-01),
+  fixed(-2.40003022448741526462e-01),
+  fixed(-2.41491885302869108143e-01),
+  fixed(-2.42980179903263815433e-01),
+  fixed(-2.44467902747824261667e-01),
+  fixed(-2.45955050335794428440e-01),
+  fixed(-2.47441619167773269039e-01),
+  fixed(-2.48927605745719870978e-01),
+  fixed(-2.50413006572965113339e-01),
+  fixed(-2.51897818154216968090e-01),
+  fixed(-2.53382036995569881466e-01),
+  fixed(-2.54865659604514460668e-01),
+  fixed(-2.56348682489942913953e-01),
+  fixed(-2.57831102162158765090e-01),
+  fixed(-2.59312915132886179226e-01),
+  fixed(-2.60794117915275625030e-01),
+  fixed(-2.62274707023913422610e-01),
+  fixed(-2.63754678974831346938e-01),
+  fixed(-2.65234030285511512837e-01),
+  fixed(-2.66712757474898254362e-01),
+  fixed(-2.68190857063403176319e-01),
+  fixed(-2.69668325572914813204e-01),
+  fixed(-2.71145159526807899564e-01),
+  fixed(-2.72621355449949032135e-01),
+  fixed(-2.74096909868706162250e-01),
+  fixed(-2.75571819310958088245e-01),
+  fixed(-2.77046080306100006574e-01),
+  fixed(-2.78519689385052893194e-01),
+  fixed(-2.79992643080273218015e-01),
+  fixed(-2.81464937925757663351e-01),
+  fixed(-2.82936570457055169836e-01),
+  fixed(-2.84407537211271821409e-01),
+  fixed(-2.85877834727080337718e-01),
+  fixed(-2.87347459544729399994e-01),
+  fixed(-2.88816408206049535234e-01),
+  fixed(-2.90284677254462109008e-01),
+  fixed(-2.91752263234989206442e-01),
+  fixed(-2.93219162694258739243e-01),
+  fixed(-2.94685372180514160156e-01),
+  fixed(-2.96150888243623788831e-01),
+  fixed(-2.97615707435085918853e-01),
+  fixed(-2.99079826308040308547e-01),
+  fixed(-3.00543241417273454541e-01),
+  fixed(-3.02005949319227806615e-01),
+  fixed(-3.03467946572011204598e-01),
+  fixed(-3.04929229735402429480e-01),
+  fixed(-3.06389795370860695822e-01),
+  fixed(-3.07849640041534811097e-01),
+  fixed(-3.09308760312268782311e-01),
+  fixed(-3.10767152749611308415e-01),
+  fixed(-3.12224813921824884133e-01),
+  fixed(-3.13681740398891184540e-01),
+  fixed(-3.15137928752522222808e-01),
+  fixed(-3.16593375556165845808e-01),
+  fixed(-3.18048077385014671403e-01),
+  fixed(-3.19502030816015580861e-01),
+  fixed(-3.20955232427875269963e-01),
+  fixed(-3.22407678801069630392e-01),
+  fixed(-3.23859366517852798051e-01),
+  fixed(-3.25310292162262981730e-01),
+  fixed(-3.26760452320131566939e-01),
+  fixed(-3.28209843579092497290e-01),
+  fixed(-3.29658462528587214990e-01),
+  fixed(-3.31106305759876262673e-01),
+  fixed(-3.32553369866044223890e-01),
+  fixed(-3.33999651442009104496e-01),
+  fixed(-3.35445147084531491988e-01),
+  fixed(-3.36889853392220106620e-01),
+  fixed(-3.38333766965540905236e-01),
+  fixed(-3.39776884406826795715e-01),
+  fixed(-3.41219202320282466445e-01),
+  fixed(-3.42660717311994211798e-01),
+  fixed(-3.44101425989938813910e-01),
+  fixed(-3.45541324963988760732e-01),
+  fixed(-3.46980410845923514795e-01),
+  fixed(-3.48418680249434564722e-01),
+  fixed(-3.49856129790134640078e-01),
+  fixed(-3.51292756085566981739e-01),
+  fixed(-3.52728555755210726463e-01),
+  fixed(-3.54163525420490121753e-01),
+  fixed(-3.55597661704783796210e-01),
+  fixed(-3.57030961233430088608e-01),
+  fixed(-3.58463420633736373766e-01),
+  fixed(-3.59895036534988110866e-01),
+  fixed(-3.61325805568453950478e-01),
+  fixed(-3.62755724367397058838e-01),
+  fixed(-3.64184789567079891803e-01),
+  fixed(-3.65612997804773576238e-01),
+  fixed(-3.67040345719767069355e-01),
+  fixed(-3.68466829953372376760e-01),
+  fixed(-3.69892447148933878331e-01),
+  fixed(-3.71317193951837432042e-01),
+  fixed(-3.72741067009515869568e-01),
+  fixed(-3.74164062971457822560e-01),
+  fixed(-3.75586178489217159537e-01),
+  fixed(-3.77007410216417926385e-01),
+  fixed(-3.78427754808765393069e-01),
+  fixed(-3.79847208924051160661e-01),
+  fixed(-3.81265769222162098639e-01),
+  fixed(-3.82683432365089670757e-01),
+  fixed(-3.84100195016935097581e-01),
+  fixed(-3.85516053843918626853e-01),
+  fixed(-3.86931005514388526301e-01),
+  fixed(-3.88345046698826357190e-01),
+  fixed(-3.89758174069856244692e-01),
+  fixed(-3.91170384302253815179e-01),
+  fixed(-3.92581674072951192223e-01),
+  fixed(-3.93992040061047932298e-01),
+  fixed(-3.95401478947816298337e-01),
+  fixed(-3.96809987416710030494e-01),
+  fixed(-3.98217562153373449974e-01),
+  fixed(-3.99624199845646843610e-01),
+  fixed(-4.01029897183575401165e-01),
+  fixed(-4.02434650859418374669e-01),
+  fixed(-4.03838457567654185443e-01),
+  fixed(-4.05241314004989694464e-01),
+  fixed(-4.06643216870368973126e-01),
+  fixed(-4.08044162864978354754e-01),
+  fixed(-4.09444148692257425814e-01),
+  fixed(-4.10843171057903910892e-01),
+  fixed(-4.12241226669882609990e-01),
+  fixed(-4.13638312238434391332e-01),
+  fixed(-4.15034424476081631461e-01),
+  fixed(-4.16429560097636930482e-01),
+  fixed(-4.17823715820212215899e-01),
+  fixed(-4.19216888363224016167e-01),
+  fixed(-4.20609074448402342483e-01),
+  fixed(-4.22000270799799626076e-01),
+  fixed(-4.23390474143795714213e-01),
+  fixed(-4.24779681209108639361e-01),
+  fixed(-4.26167888726799615196e-01),
+  fixed(-4.27555093430281807354e-01),
+  fixed(-4.28941292055329381760e-01),
+  fixed(-4.30326481340082667160e-01),
+  fixed(-4.31710658025057036902e-01),
+  fixed(-4.33093818853151846238e-01),
+  fixed(-4.34475960569655761390e-01),
+  fixed(-4.35857079922255308269e-01),
+  fixed(-4.37237173661044031814e-01),
+  fixed(-4.38616238538527325463e-01),
+  fixed(-4.39994271309633089295e-01),
+  fixed(-4.41371268731716670519e-01),
+  fixed(-4.42747227564569745262e-01),
+  fixed(-4.44122144570429089327e-01),
+  fixed(-4.45496016513981740736e-01),
+  fixed(-4.46868840162373937019e-01),
+  fixed(-4.48240612285219830468e-01),
+  fixed(-4.49611329654606650674e-01),
+  fixed(-4.50980989045103641821e-01),
+  fixed(-4.52349587233770833450e-01),
+  fixed(-4.53717121000163536859e-01),
+  fixed(-4.55083587126343669382e-01),
+  fixed(-4.56448982396883917723e-01),
+  fixed(-4.57813303598876952805e-01),
+  fixed(-4.59176547521943978492e-01),
+  fixed(-4.60538710958240060656e-01),
+  fixed(-4.61899790702462509362e-01),
+  fixed(-4.63259783551860093720e-01),
+  fixed(-4.64618686306237871353e-01),
+  fixed(-4.65976495767965959161e-01),
+  fixed(-4.67333208741988359591e-01),
+  fixed(-4.68688822035827623580e-01),
+  fixed(-4.70043332459595453177e-01),
+  fixed(-4.71396736825997642040e-01),
+  fixed(-4.72749031950342513131e-01),
+  fixed(-4.74100214650549856010e-01),
+  fixed(-4.75450281747155922840e-01),
+  fixed(-4.76799230063321866080e-01),
+  fixed(-4.78147056424842953337e-01),
+  fixed(-4.79493757660153063771e-01),
+  fixed(-4.80839330600333736410e-01),
+  fixed(-4.82183772079122663357e-01),
+  fixed(-4.83527078932918408238e-01),
+  fixed(-4.84869248000790953324e-01),
+  fixed(-4.86210276124486362459e-01),
+  fixed(-4.87550160148435662855e-01),
+  fixed(-4.88888896919763060733e-01),
+  fixed(-4.90226483288291159379e-01),
+  fixed(-4.91562916106549729900e-01),
+  fixed(-4.92898192229783926877e-01),
+  fixed(-4.94232308515959783968e-01),
+  fixed(-4.95565261825772318538e-01),
+  fixed(-4.96897049022654468953e-01),
+  fixed(-4.98227666972781535470e-01),
+  fixed(-4.99557112545081727362e-01),
+  fixed(-5.00885382611240714823e-01),
+  fixed(-5.02212474045710566273e-01),
+  fixed(-5.03538383725717464401e-01),
+  fixed(-5.04863108531267590351e-01),
+  fixed(-5.06186645345155006304e-01),
+  fixed(-5.07508991052970759306e-01),
+  fixed(-5.08830142543107100117e-01),
+  fixed(-5.10150096706766587040e-01),
+  fixed(-5.11468850437970301570e-01),
+  fixed(-5.12786400633562733375e-01),
+  fixed(-5.14102744193221550262e-01),
+  fixed(-5.15417878019462927242e-01),
+  fixed(-5.16731799017649651162e-01),
+  fixed(-5.18044504095999225335e-01),
+  fixed(-5.19355990165589642693e-01),
+  fixed(-5.20666254140366935310e-01),
+  fixed(-5.21975292937154278228e-01),
+  fixed(-5.23283103475656430348e-01),
+  fixed(-5.24589682678468727239e-01),
+  fixed(-5.25895027471084630655e-01),
+  fixed(-5.27199134781901057600e-01),
+  fixed(-5.28502001542228261322e-01),
+  fixed(-5.29803624686294605262e-01),
+  fixed(-5.31104001151254667690e-01),
+  fixed(-5.32403127877197790419e-01),
+  fixed(-5.33701001807152963785e-01),
+  fixed(-5.34997619887096931279e-01),
+  fixed(-5.36292979065963071328e-01),
+  fixed(-5.37587076295645505120e-01),
+  fixed(-5.38879908531008200434e-01),
+  fixed(-5.40171472729892854225e-01),
+  fixed(-5.41461765853123222492e-01),
+  fixed(-5.42750784864515778416e-01),
+  fixed(-5.44038526730883820193e-01),
+  fixed(-5.45324988422046130765e-01),
+  fixed(-5.46610166910834749388e-01),
+  fixed(-5.47894059173100189675e-01),
+  fixed(-5.49176662187719544228e-01),
+  fixed(-5.50457972936604700287e-01),
+  fixed(-5.51737988404707446755e-01),
+  fixed(-5.53016705580027356781e-01),
+  fixed(-5.54294121453620003415e-01),
+  fixed(-5.55570233019601955604e-01),
+  fixed(-5.56845037275159882029e-01),
+  fixed(-5.58118531220556102213e-01),
+  fixed(-5.59390711859135802975e-01),
+  fixed(-5.60661576197335920213e-01),
+  fixed(-5.61931121244689357752e-01),
+  fixed(-5.63199344013833869127e-01),
+  fixed(-5.64466241520519385055e-01),
+  fixed(-5.65731810783613231486e-01),
+  fixed(-5.66996048825108456271e-01),
+  fixed(-5.68258952670131489704e-01),
+  fixed(-5.69520519346947251549e-01),
+  fixed(-5.70780745886967144642e-01),
+  fixed(-5.72039629324757048501e-01),
+  fixed(-5.73297166698041982258e-01),
+  fixed(-5.74553355047715652582e-01),
+  fixed(-5.75808191417845338655e-01),
+  fixed(-5.77061672855679330674e-01),
+  fixed(-5.78313796411655478558e-01),
+  fixed(-5.79564559139405743871e-01),
+  fixed(-5.80813958095764304446e-01),
+  fixed(-5.82061990340775436970e-01),
+  fixed(-5.83308652937698401963e-01),
+  fixed(-5.84553942953015104322e-01),
+  fixed(-5.85797857456438864077e-01),
+  fixed(-5.87040393520917747061e-01),
+  fixed(-5.88281548222645112034e-01),
+  fixed(-5.89521318641063940547e-01),
+  fixed(-5.90759701858873942371e-01),
+  fixed(-5.91996694962040881371e-01),
+  fixed(-5.93232295039799795155e-01),
+  fixed(-5.94466499184664209920e-01),
+  fixed(-5.95699304492433245883e-01),
+  fixed(-5.96930708062196502262e-01),
+  fixed(-5.98160706996342161901e-01),
+  fixed(-5.99389298400564540792e-01),
+  fixed(-6.00616479383868639985e-01),
+  fixed(-6.01842247058579915553e-01),
+  fixed(-6.03066598540348164370e-01),
+  fixed(-6.04289530948155850787e-01),
+  fixed(-6.05511041404325434101e-01),
+  fixed(-6.06731127034524475583e-01),
+  fixed(-6.07949784967773410038e-01),
+  fixed(-6.09167012336453095322e-01),
+  fixed(-6.10382806276309475280e-01),
+  fixed(-6.11597163926461795391e-01),
+  fixed(-6.12810082429409708205e-01),
+  fixed(-6.14021558931038158313e-01),
+  fixed(-6.15231590580626708231e-01),
+  fixed(-6.16440174530853646218e-01),
+  fixed(-6.17647307937803646816e-01),
+  fixed(-6.18852987960976208548e-01),
+  fixed(-6.20057211763289206630e-01),
+  fixed(-6.21259976511087441686e-01),
+  fixed(-6.22461279374149856203e-01),
+  fixed(-6.23661117525694641550e-01),
+  fixed(-6.24859488142386232390e-01),
+  fixed(-6.26056388404343522325e-01),
+  fixed(-6.27251815495143860701e-01),
+  fixed(-6.28445766601832600529e-01),
+  fixed(-6.29638238914926984258e-01),
+  fixed(-6.30829229628424248411e-01),
+  fixed(-6.32018735939808951052e-01),
+  fixed(-6.33206755050057301659e-01),
+  fixed(-6.34393284163645265750e-01),
+  fixed(-6.35578320488556114398e-01),
+  fixed(-6.36761861236284310017e-01),
+  fixed(-6.37943903621843944052e-01),
+  fixed(-6.39124444863775731385e-01),
+  fixed(-6.40303482184151451229e-01),
+  fixed(-6.41481012808583050955e-01),
+  fixed(-6.42657033966226864941e-01),
+  fixed(-6.43831542889791275108e-01),
+  fixed(-6.45004536815543816353e-01),
+  fixed(-6.46176012983316394589e-01),
+  fixed(-6.47345968636511837069e-01),
+  fixed(-6.48514401022112330075e-01),
+  fixed(-6.49681307390683193681e-01),
+  fixed(-6.50846684996380764332e-01),
+  fixed(-6.52010531096959500275e-01),
+  fixed(-6.53172842953776533470e-01),
+  fixed(-6.54333617831800329334e-01),
+  fixed(-6.55492852999615349674e-01),
+  fixed(-6.56650545729428825048e-01),
+  fixed(-6.57806693297078526328e-01),
+  fixed(-6.58961292982037316612e-01),
+  fixed(-6.60114342067420256654e-01),
+  fixed(-6.61265837839992154379e-01),
+  fixed(-6.62415777590171783729e-01),
+  fixed(-6.63564158612039656227e-01),
+  fixed(-6.64710978203344793336e-01),
+  fixed(-6.65856233665509389397e-01),
+  fixed(-6.66999922303637360343e-01),
+  fixed(-6.68142041426518451530e-01),
+  fixed(-6.69282588346635787246e-01),
+  fixed(-6.70421560380172976146e-01),
+  fixed(-6.71558954847018441114e-01),
+  fixed(-6.72694769070772746744e-01),
+  fixed(-6.73829000378755926803e-01),
+  fixed(-6.74961646102012036152e-01),
+  fixed(-6.76092703575315812081e-01),
+  fixed(-6.77222170137180334848e-01),
+  fixed(-6.78350043129861246527e-01),
+  fixed(-6.79476319899364855637e-01),
+  fixed(-6.80600997795453022121e-01),
+  fixed(-6.81724074171649596643e-01),
+  fixed(-6.82845546385247970100e-01),
+  fixed(-6.83965411797315403497e-01),
+  fixed(-6.85083667772700133369e-01),
+  fixed(-6.86200311680038477213e-01),
+  fixed(-6.87315340891759163355e-01),
+  fixed(-6.88428752784090325356e-01),
+  fixed(-6.89540544737066829484e-01),
+  fixed(-6.90650714134534382538e-01),
+  fixed(-6.91759258364157636478e-01),
+  fixed(-6.92866174817424629317e-01),
+  fixed(-6.93971460889653779525e-01),
+  fixed(-6.95075113980000769409e-01),
+  fixed(-6.96177131491462986013e-01),
+  fixed(-6.97277510830886404491e-01),
+  fixed(-6.98376249408972804567e-01),
+  fixed(-6.99473344640283878348e-01),
+  fixed(-7.00568793943248224743e-01),
+  fixed(-7.01662594740168454877e-01),
+  fixed(-7.02754744457225077880e-01),
+  fixed(-7.03845240524484827560e-01),
+  fixed(-7.04934080375904881244e-01),
+  fixed(-7.06021261449339521121e-01),
+  fixed(-7.07106781186547461715e-01),
+  fixed(-7.08190637033195291572e-01),
+  fixed(-7.09272826438865466869e-01),
+  fixed(-7.10353346857062306619e-01),
+  fixed(-7.11432195745216433558e-01),
+  fixed(-7.12509370564692212646e-01),
+  fixed(-7.13584868780793524223e-01),
+  fixed(-7.14658687862768760013e-01),
+  fixed(-7.15730825283818483662e-01),
+  fixed(-7.16801278521099538565e-01),
+  fixed(-7.17870045055731487160e-01),
+  fixed(-7.18937122372804382486e-01),
+  fixed(-7.20002507961381654766e-01),
+  fixed(-7.21066199314507882967e-01),
+  fixed(-7.22128193929215234093e-01),
+  fixed(-7.23188489306527459988e-01),
+  fixed(-7.24247082951466780720e-01),
+  fixed(-7.25303972373060656942e-01),
+  fixed(-7.26359155084345675668e-01),
+  fixed(-7.27412628602375654907e-01),
+  fixed(-7.28464390448225196373e-01),
+  fixed(-7.29514438146996790913e-01),
+  fixed(-7.30562769227827479845e-01),
+  fixed(-7.31609381223892518697e-01),
+  fixed(-7.32654271672412593652e-01),
+  fixed(-7.33697438114660149822e-01),
+  fixed(-7.34738878095963499071e-01),
+  fixed(-7.35778589165713370335e-01),
+  fixed(-7.36816568877369793000e-01),
+  fixed(-7.37852814788465760643e-01),
+  fixed(-7.38887324460615002586e-01),
+  fixed(-7.39920095459516091729e-01),
+  fixed(-7.40951125354958883840e-01),
+  fixed(-7.41980411720830956845e-01),
+  fixed(-7.43007952135121718662e-01),
+  fixed(-7.44033744179929068530e-01),
+  fixed(-7.45057785441465836307e-01),
+  fixed(-7.46080073510063779274e-01),
+  fixed(-7.47100605980180021426e-01),
+  fixed(-7.48119380450403492766e-01),
+  fixed(-7.49136394523459037131e-01),
+  fixed(-7.50151645806214961709e-01),
+  fixed(-7.51165131909686367706e-01),
+  fixed(-7.52176850449042477820e-01),
+  fixed(-7.53186799043612409399e-01),
+  fixed(-7.54194975316889171246e-01),
+  fixed(-7.55201376896536324956e-01),
+  fixed(-7.56206001414394424209e-01),
+  fixed(-7.57208846506484234418e-01),
+  fixed(-7.58209909813015170421e-01),
+  fixed(-7.59209188978387961022e-01),
+  fixed(-7.60206681651202420547e-01),
+  fixed(-7.61202385484262000759e-01),
+  fixed(-7.62196298134578564820e-01),
+  fixed(-7.63188417263381047029e-01),
+  fixed(-7.64178740536116563042e-01),
+  fixed(-7.65167265622458958596e-01),
+  fixed(-7.66153990196313028349e-01),
+  fixed(-7.67138911935820067001e-01),
+  fixed(-7.68122028523365085739e-01),
+  fixed(-7.69103337645579476778e-01),
+  fixed(-7.70082836993347896737e-01),
+  fixed(-7.71060524261813817759e-01),
+  fixed(-7.72036397150384634536e-01),
+  fixed(-7.73010453362736660310e-01),
+  fixed(-7.73982690606822565371e-01),
+  fixed(-7.74953106594873819546e-01),
+  fixed(-7.75921699043407575580e-01),
+  fixed(-7.76888465673232553321e-01),
+  fixed(-7.77853404209452703455e-01),
+  fixed(-7.78816512381475645199e-01),
+  fixed(-7.79777787923014331639e-01),
+  fixed(-7.80737228572094377199e-01),
+  fixed(-7.81694832071059497736e-01),
+  fixed(-7.82650596166575840407e-01),
+  fixed(-7.83604518609637978876e-01),
+  fixed(-7.84556597155575019542e-01),
+  fixed(-7.85506829564053821180e-01),
+  fixed(-7.86455213599085767306e-01),
+  fixed(-7.87401747029031429115e-01),
+  fixed(-7.88346427626605894545e-01),
+  fixed(-7.89289253168885429623e-01),
+  fixed(-7.90230221437309920951e-01),
+  fixed(-7.91169330217690092155e-01),
+  fixed(-7.92106577300212388870e-01),
+  fixed(-7.93041960479443863719e-01),
+  fixed(-7.93975477554336839248e-01),
+  fixed(-7.94907126328236790513e-01),
+  fixed(-7.95836904608883455303e-01),
+  fixed(-7.96764810208418716719e-01),
+  fixed(-7.97690840943391155093e-01),
+  fixed(-7.98614994634760488879e-01),
+  fixed(-7.99537269107904791099e-01),
+  fixed(-8.00457662192622598774e-01),
+  fixed(-8.01376171723140129366e-01),
+  fixed(-8.02292795538115721676e-01),
+  fixed(-8.03207531480645053890e-01),
+  fixed(-8.04120377398265473445e-01),
+  fixed(-8.05031331142963435532e-01),
+  fixed(-8.05940390571176168422e-01),
+  fixed(-8.06847553543799222986e-01),
+  fixed(-8.07752817926190469500e-01),
+  fixed(-8.08656181588174649555e-01),
+  fixed(-8.09557642404051036600e-01),
+  fixed(-8.10457198252594657184e-01),
+  fixed(-8.11354847017063729453e-01),
+  fixed(-8.12250586585203993018e-01),
+  fixed(-8.13144414849253704958e-01),
+  fixed(-8.14036329705948080715e-01),
+  fixed(-8.14926329056526399519e-01),
+  fixed(-8.15814410806733669723e-01),
+  fixed(-8.16700572866827734231e-01),
+  fixed(-8.17584813151583822410e-01),
+  fixed(-8.18467129580298324854e-01),
+  fixed(-8.19347520076796675959e-01),
+  fixed(-8.20225982569434464153e-01),
+  fixed(-8.21102514991104648345e-01),
+  fixed(-8.21977115279241554724e-01),
+  fixed(-8.22849781375826427876e-01),
+  fixed(-8.23720511227391094522e-01),
+  fixed(-8.24589302785025068943e-01),
+  fixed(-8.25456154004377440359e-01),
+  fixed(-8.26321062845663423246e-01),
+  fixed(-8.27184027273669242319e-01),
+  fixed(-8.28045045257755463197e-01),
+  fixed(-8.28904114771864652944e-01),
+  fixed(-8.29761233794522934382e-01),
+  fixed(-8.30616400308846203338e-01),
+  fixed(-8.31469612302545235671e-01),
+  fixed(-8.32320867767929795100e-01),
+  fixed(-8.33170164701912852045e-01),
+  fixed(-8.34017501106017911106e-01),
+  fixed(-8.34862874986380010256e-01),
+  fixed(-8.35706284353752604233e-01),
+  fixed(-8.36547727223512116446e-01),
+  fixed(-8.37387201615661602716e-01),
+  fixed(-8.38224705554837856702e-01),
+  fixed(-8.39060237070312520125e-01),
+  fixed(-8.39893794195999410235e-01),
+  fixed(-8.40725374970458072532e-01),
+  fixed(-8.41554977436898554721e-01),
+  fixed(-8.42382599643185625560e-01),
+  fixed(-8.43208239641845214152e-01),
+  fixed(-8.44031895490066297327e-01),
+  fixed(-8.44853565249707005869e-01),
+  fixed(-8.45673246987299176425e-01),
+  fixed(-8.46490938774051793203e-01),
+  fixed(-8.47306638685858093396e-01),
+  fixed(-8.48120344803297121494e-01),
+  fixed(-8.48932055211639613468e-01),
+  fixed(-8.49741768000852548681e-01),
+  fixed(-8.50549481265603590785e-01),
+  fixed(-8.51355193105264862474e-01),
+  fixed(-8.52158901623919606827e-01),
+  fixed(-8.52960604930363519571e-01),
+  fixed(-8.53760301138111410424e-01),
+  fixed(-8.54557988365400644781e-01),
+  fixed(-8.55353664735195695634e-01),
+  fixed(-8.56147328375194249794e-01),
+  fixed(-8.56938977417828540162e-01),
+  fixed(-8.57728610000272007063e-01),
+  fixed(-8.58516224264442850966e-01),
+  fixed(-8.59301818357008473370e-01),
+  fixed(-8.60085390429389917699e-01),
+  fixed(-8.60866938637767087350e-01),
+  fixed(-8.61646461143081188183e-01),
+  fixed(-8.62423956111040501682e-01),
+  fixed(-8.63199421712124270734e-01),
+  fixed(-8.63972856121586474387e-01),
+  fixed(-8.64744257519462156125e-01),
+  fixed(-8.65513624090568978175e-01),
+  fixed(-8.66280954024512883649e-01),
+  fixed(-8.67046245515692648453e-01),
+  fixed(-8.67809496763303322986e-01),
+  fixed(-8.68570705971340673024e-01),
+  fixed(-8.69329871348606619819e-01),
+  fixed(-8.70086991108711349519e-01),
+  fixed(-8.70842063470078864285e-01),
+  fixed(-8.71595086655951090115e-01),
+  fixed(-8.72346058894391207517e-01),
+  fixed(-8.73094978418289868749e-01),
+  fixed(-8.73841843465366752142e-01),
+  fixed(-8.74586652278176113207e-01),
+  fixed(-8.75329403104110892464e-01),
+  fixed(-8.76070094195406712245e-01),
+  fixed(-8.76808723809145429406e-01),
+  fixed(-8.77545290207261130533e-01),
+  fixed(-8.78279791656541464206e-01),
+  fixed(-8.79012226428633414166e-01),
+  fixed(-8.79742592800047518153e-01),
+  fixed(-8.80470889052160532451e-01),
+  fixed(-8.81197113471221871173e-01),
+  fixed(-8.81921264348354938534e-01),
+  fixed(-8.82643339979562679964e-01),
+  fixed(-8.83363338665731578914e-01),
+  fixed(-8.84081258712635098540e-01),
+  fixed(-8.84797098430937567493e-01),
+  fixed(-8.85510856136199731026e-01),
+  fixed(-8.86222530148880527356e-01),
+  fixed(-8.86932118794342194690e-01),
+  fixed(-8.87639620402854045977e-01),
+  fixed(-8.88345033309596021631e-01),
+  fixed(-8.89048355854664351661e-01),
+  fixed(-8.89749586383072665896e-01),
+  fixed(-8.90448723244757878170e-01),
+  fixed(-8.91145764794583294943e-01),
+  fixed(-8.91840709392342834150e-01),
+  fixed(-8.92533555402764355868e-01),
+  fixed(-8.93224301195515213436e-01),
+  fixed(-8.93912945145203141628e-01),
+  fixed(-8.94599485631382695949e-01),
+  fixed(-8.95283921038557584104e-01),
+  fixed(-8.95966249756184884845e-01),
+  fixed(-8.96646470178680043972e-01),
+  fixed(-8.97324580705418206605e-01),
+  fixed(-8.98000579740739768297e-01),
+  fixed(-8.98674465693953816725e-01),
+  fixed(-8.99346236979341684403e-01),
+  fixed(-9.00015892016159946287e-01),
+  fixed(-9.00683429228646748044e-01),
+  fixed(-9.01348847046021917073e-01),
+  fixed(-9.02012143902493179759e-01),
+  fixed(-9.02673318237258826002e-01),
+  fixed(-9.03332368494511595003e-01),
+  fixed(-9.03989293123443116151e-01),
+  fixed(-9.04644090578246129475e-01),
+  fixed(-9.05296759318118704485e-01),
+  fixed(-9.05947297807268459024e-01),
+  fixed(-9.06595704514915445849e-01),
+  fixed(-9.07241977915295594315e-01),
+  fixed(-9.07886116487666039454e-01),
+  fixed(-9.08528118716306010150e-01),
+  fixed(-9.09167983090522380252e-01),
+  fixed(-9.09805708104652333112e-01),
+  fixed(-9.10441292258066914300e-01),
+  fixed(-9.11074734055176138625e-01),
+  fixed(-9.11706032005429767295e-01),
+  fixed(-9.12335184623322748010e-01),
+  fixed(-9.12962190428398212561e-01),
+  fixed(-9.13587047945250918524e-01),
+  fixed(-9.14209755703530468907e-01),
+  fixed(-9.14830312237945975085e-01),
+  fixed(-9.15448716088267722135e-01),
+  fixed(-9.16064965799331720753e-01),
+  fixed(-9.16679059921042704850e-01),
+  fixed(-9.17290997008377684274e-01),
+  fixed(-9.17900775621390274672e-01),
+  fixed(-9.18508394325212140785e-01),
+  fixed(-9.19113851690057659383e-01),
+  fixed(-9.19717146291227360955e-01),
+  fixed(-9.20318276709110594247e-01),
+  fixed(-9.20917241529189301019e-01),
+  fixed(-9.21514039342041790803e-01),
+  fixed(-9.22108668743345072372e-01),
+  fixed(-9.22701128333878517473e-01),
+  fixed(-9.23291416719527635593e-01),
+  fixed(-9.23879532511286516439e-01),
+  fixed(-9.24465474325262492883e-01),
+  fixed(-9.25049240782677473227e-01),
+  fixed(-9.25630830509872715162e-01),
+  fixed(-9.26210242138311379279e-01),
+  fixed(-9.26787474304581859741e-01),
+  fixed(-9.27362525650400892907e-01),
+  fixed(-9.27935394822617665156e-01),
+  fixed(-9.28506080473215478222e-01),
+  fixed(-9.29074581259315745996e-01),
+  fixed(-9.29640895843181325198e-01),
+  fixed(-9.30205022892219179909e-01),
+  fixed(-9.30766961078983601219e-01),
+  fixed(-9.31326709081180315053e-01),
+  fixed(-9.31884265581668036482e-01),
+  fixed(-9.32439629268462355505e-01),
+  fixed(-9.32992798834738956693e-01),
+  fixed(-9.33543772978835950660e-01),
+  fixed(-9.34092550404258759045e-01),
+  fixed(-9.34639129819680669620e-01),
+  fixed(-9.35183509938947610252e-01),
+  fixed(-9.35725689481080369347e-01),
+  fixed(-9.36265667170278370612e-01),
+  fixed(-9.36803441735921449407e-01),
+  fixed(-9.37339011912574848751e-01),
+  fixed(-9.37872376439989774433e-01),
+  fixed(-9.38403534063108168972e-01),
+  fixed(-9.38932483532064598997e-01),
+  fixed(-9.39459223602189696933e-01),
+  fixed(-9.39983753034013824745e-01),
+  fixed(-9.40506070593268295177e-01),
+  fixed(-9.41026175050889257534e-01),
+  fixed(-9.41544065183020806309e-01),
+  fixed(-9.42059739771017423671e-01),
+  fixed(-9.42573197601446755023e-01),
+  fixed(-9.43084437466093383762e-01),
+  fixed(-9.43593458161960274566e-01),
+  fixed(-9.44100258491272659178e-01),
+  fixed(-9.44604837261480367872e-01),
+  fixed(-9.45107193285260382964e-01),
+  fixed(-9.45607325380521168690e-01),
+  fixed(-9.46105232370403337328e-01),
+  fixed(-9.46600913083283534988e-01),
+  fixed(-9.47094366352777217166e-01),
+  fixed(-9.47585591017741202258e-01),
+  fixed(-9.48074585922276114047e-01),
+  fixed(-9.48561349915730156468e-01),
+  fixed(-9.49045881852700556891e-01),
+  fixed(-9.49528180593036674750e-01),
+  fixed(-9.50008245001843110167e-01),
+  fixed(-9.50486073949481591328e-01),
+  fixed(-9.50961666311574971289e-01),
+  fixed(-9.51435020969008338199e-01),
+  fixed(-9.51906136807932345967e-01),
+  fixed(-9.52375012719765878799e-01),
+  fixed(-9.52841647601198715734e-01),
+  fixed(-9.53306040354193751085e-01),
+  fixed(-9.53768189885990214094e-01),
+  fixed(-9.54228095109105556304e-01),
+  fixed(-9.54685754941338338142e-01),
+  fixed(-9.55141168305770782432e-01),
+  fixed(-9.55594334130770883817e-01),
+  fixed(-9.56045251349996294543e-01),
+  fixed(-9.56493918902394990589e-01),
+  fixed(-9.56940335732208824382e-01),
+  fixed(-9.57384500788975967289e-01),
+  fixed(-9.57826413027533019040e-01),
+  fixed(-9.58266071408017561239e-01),
+  fixed(-9.58703474895871488037e-01),
+  fixed(-9.59138622461841894307e-01),
+  fixed(-9.59571513081984517335e-01),
+  fixed(-9.60002145737665957270e-01),
+  fixed(-9.60430519415565675523e-01),
+  fixed(-9.60856633107679547479e-01),
+  fixed(-9.61280485811320528633e-01),
+  fixed(-9.61702076529122540371e-01),
+  fixed(-9.62121404269041580193e-01),
+  fixed(-9.62538468044359274423e-01),
+  fixed(-9.62953266873683766391e-01),
+  fixed(-9.63365799780953935283e-01),
+  fixed(-9.63776065795439840223e-01),
+  fixed(-9.64184063951745828902e-01),
+  fixed(-9.64589793289812758026e-01),
+  fixed(-9.64993252854920213757e-01),
+  fixed(-9.65394441697689287274e-01),
+  fixed(-9.65793358874083573973e-01),
+  fixed(-9.66190003445412504135e-01),
+  fixed(-9.66584374478333119285e-01),
+  fixed(-9.66976471044852181613e-01),
+  fixed(-9.67366292222328394423e-01),
+  fixed(-9.67753837093475399733e-01),
+  fixed(-9.68139104746362333387e-01),
+  fixed(-9.68522094274417266746e-01),
+  fixed(-9.68902804776428872024e-01),
+  fixed(-9.69281235356548309667e-01),
+  fixed(-9.69657385124292336975e-01),
+  fixed(-9.70031253194543974239e-01),
+  fixed(-9.70402838687555502339e-01),
+  fixed(-9.70772140728950350130e-01),
+  fixed(-9.71139158449725203859e-01),
+  fixed(-9.71503890986251672501e-01),
+  fixed(-9.71866337480279285366e-01),
+  fixed(-9.72226497078936269247e-01),
+  fixed(-9.72584368934732212963e-01),
+  fixed(-9.72939952205560176779e-01),
+  fixed(-9.73293246054698135694e-01),
+  fixed(-9.73644249650811866026e-01),
+  fixed(-9.73992962167955833586e-01),
+  fixed(-9.74339382785575858215e-01),
+  fixed(-9.74683510688510668096e-01),
+  fixed(-9.75025345066994231225e-01),
+  fixed(-9.75364885116656865627e-01),
+  fixed(-9.75702130038528459011e-01),
+  fixed(-9.76037079039039023876e-01),
+  fixed(-9.76369731330021140003e-01),
+  fixed(-9.76700086128711841837e-01),
+  fixed(-9.77028142657754283817e-01),
+  fixed(-9.77353900145199960825e-01),
+  fixed(-9.77677357824509929429e-01),
+  fixed(-9.77998514934557028333e-01),
+  fixed(-9.78317370719627654729e-01),
+  fixed(-9.78633924429423207592e-01),
+  fixed(-9.78948175319062086075e-01),
+  fixed(-9.79260122649082020985e-01),
+  fixed(-9.79569765685440518865e-01),
+  fixed(-9.79877103699517637558e-01),
+  fixed(-9.80182135968117429492e-01),
+  fixed(-9.80484861773469273949e-01),
+  fixed(-9.80785280403230319557e-01),
+  fixed(-9.81083391150486594512e-01),
+  fixed(-9.81379193313754560890e-01),
+  fixed(-9.81672686196983113049e-01),
+  fixed(-9.81963869109555353987e-01),
+  fixed(-9.82252741366289372493e-01),
+  fixed(-9.82539302287441240757e-01),
+  fixed(-9.82823551198705236409e-01),
+  fixed(-9.83105487431216285010e-01),
+  fixed(-9.83385110321551292323e-01),
+  fixed(-9.83662419211730143509e-01),
+  fixed(-9.83937413449218811756e-01),
+  fixed(-9.84210092386929025210e-01),
+  fixed(-9.84480455383220931509e-01),
+  fixed(-9.84748501801904208008e-01),
+  fixed(-9.85014231012239838137e-01),
+  fixed(-9.85277642388941110596e-01),
+  fixed(-9.85538735312176061854e-01),
+  fixed(-9.85797509167567365118e-01),
+  fixed(-9.86053963346195438966e-01),
+  fixed(-9.86308097244598669384e-01),
+  fixed(-9.86559910264775408173e-01),
+  fixed(-9.86809401814185416235e-01),
+  fixed(-9.87056571305750973799e-01),
+  fixed(-9.87301418157858323710e-01),
+  fixed(-9.87543941794359336761e-01),
+  fixed(-9.87784141644572177832e-01),
+  fixed(-9.88022017143283526330e-01),
+  fixed(-9.88257567730749464374e-01),
+  fixed(-9.88490792852696587012e-01),
+  fixed(-9.88721691960323778581e-01),
+  fixed(-9.88950264510302989862e-01),
+  fixed(-9.89176509964780903417e-01),
+  fixed(-9.89400427791380265852e-01),
+  fixed(-9.89622017463200776000e-01),
+  fixed(-9.89841278458820528208e-01),
+  fixed(-9.90058210262297122561e-01),
+  fixed(-9.90272812363169108174e-01),
+  fixed(-9.90485084256456982388e-01),
+  fixed(-9.90695025442664634063e-01),
+  fixed(-9.90902635427780009714e-01),
+  fixed(-9.91107913723276889861e-01),
+  fixed(-9.91310859846115444149e-01),
+  fixed(-9.91511473318743896677e-01),
+  fixed(-9.91709753669099525197e-01),
+  fixed(-9.91905700430609327256e-01),
+  fixed(-9.92099313142191796544e-01),
+  fixed(-9.92290591348257366988e-01),
+  fixed(-9.92479534598710078086e-01),
+  fixed(-9.92666142448947907972e-01),
+  fixed(-9.92850414459865104888e-01),
+  fixed(-9.93032350197851410023e-01),
+  fixed(-9.93211949234794500008e-01),
+  fixed(-9.93389211148080653047e-01),
+  fixed(-9.93564135520595304030e-01),
+  fixed(-9.93736721940724598845e-01),
+  fixed(-9.93906970002356060512e-01),
+  fixed(-9.94074879304879366337e-01),
+  fixed(-9.94240449453187902229e-01),
+  fixed(-9.94403680057679095761e-01),
+  fixed(-9.94564570734255415374e-01),
+  fixed(-9.94723121104325702646e-01),
+  fixed(-9.94879330794805616378e-01),
+  fixed(-9.95033199438118631797e-01),
+  fixed(-9.95184726672196928732e-01),
+  fixed(-9.95333912140482168773e-01),
+  fixed(-9.95480755491926938561e-01),
+  fixed(-9.95625256380994305694e-01),
+  fixed(-9.95767414467659817134e-01),
+  fixed(-9.95907229417411721251e-01),
+  fixed(-9.96044700901251967018e-01),
+  fixed(-9.96179828595696870153e-01),
+  fixed(-9.96312612182778001291e-01),
+  fixed(-9.96443051350042630077e-01),
+  fixed(-9.96571145790554835386e-01),
+  fixed(-9.96696895202896060439e-01),
+  fixed(-9.96820299291165667910e-01),
+  fixed(-9.96941357764982050149e-01),
+  fixed(-9.97060070339482962254e-01),
+  fixed(-9.97176436735326077176e-01),
+  fixed(-9.97290456678690206971e-01),
+  fixed(-9.97402129901275302792e-01),
+  fixed(-9.97511456140303454099e-01),
+  fixed(-9.97618435138519554783e-01),
+  fixed(-9.97723066644191636243e-01),
+  fixed(-9.97825350411111644533e-01),
+  fixed(-9.97925286198595995479e-01),
+  fixed(-9.98022873771486129790e-01),
+  fixed(-9.98118112900149179190e-01),
+  fixed(-9.98211003360478188462e-01),
+  fixed(-9.98301544933892781586e-01),
+  fixed(-9.98389737407340160935e-01),
+  fixed(-9.98475580573294774211e-01),
+  fixed(-9.98559074229759313646e-01),
+  fixed(-9.98640218180265160086e-01),
+  fixed(-9.98719012233872938111e-01),
+  fixed(-9.98795456205172405006e-01),
+  fixed(-9.98869549914283560987e-01),
+  fixed(-9.98941293186856871245e-01),
+  fixed(-9.99010685854073265943e-01),
+  fixed(-9.99077727752645361470e-01),
+  fixed(-9.99142418724816905318e-01),
+  fixed(-9.99204758618363886313e-01),
+  fixed(-9.99264747286594423592e-01),
+  fixed(-9.99322384588349432732e-01),
+  fixed(-9.99377670388002847801e-01),
+  fixed(-9.99430604555461732375e-01),
+  fixed(-9.99481186966166945673e-01),
+  fixed(-9.99529417501093142562e-01),
+  fixed(-9.99575296046749217638e-01),
+  fixed(-9.99618822495178638299e-01),
+  fixed(-9.99659996743959222698e-01),
+  fixed(-9.99698818696204249967e-01),
+  fixed(-9.99735288260561683060e-01),
+  fixed(-9.99769405351215278976e-01),
+  fixed(-9.99801169887884255694e-01),
+  fixed(-9.99830581795823403191e-01),
+  fixed(-9.99857641005823860603e-01),
+  fixed(-9.99882347454212561111e-01),
+  fixed(-9.99904701082852898075e-01),
+  fixed(-9.99924701839144502991e-01),
+  fixed(-9.99942349676023911620e-01),
+  fixed(-9.99957644551963897861e-01),
+  fixed(-9.99970586430974139880e-01),
+  fixed(-9.99981175282601109089e-01),
+  fixed(-9.99989411081928403213e-01),
+  fixed(-9.99995293809576191180e-01),
+  fixed(-9.99998823451701879250e-01),
+  fixed(-1.00000000000000000000e+00),
+  fixed(-9.99998823451701879250e-01),
+  fixed(-9.99995293809576191180e-01),
+  fixed(-9.99989411081928403213e-01),
+  fixed(-9.99981175282601109089e-01),
+  fixed(-9.99970586430974139880e-01),
+  fixed(-9.99957644551963897861e-01),
+  fixed(-9.99942349676023911620e-01),
+  fixed(-9.99924701839144502991e-01),
+  fixed(-9.99904701082852898075e-01),
+  fixed(-9.99882347454212561111e-01),
+  fixed(-9.99857641005823860603e-01),
+  fixed(-9.99830581795823403191e-01),
+  fixed(-9.99801169887884255694e-01),
+  fixed(-9.99769405351215278976e-01),
+  fixed(-9.99735288260561683060e-01),
+  fixed(-9.99698818696204249967e-01),
+  fixed(-9.99659996743959222698e-01),
+  fixed(-9.99618822495178638299e-01),
+  fixed(-9.99575296046749217638e-01),
+  fixed(-9.99529417501093142562e-01),
+  fixed(-9.99481186966166945673e-01),
+  fixed(-9.99430604555461732375e-01),
+  fixed(-9.99377670388002847801e-01),
+  fixed(-9.99322384588349543755e-01),
+  fixed(-9.99264747286594534614e-01),
+  fixed(-9.99204758618363886313e-01),
+  fixed(-9.99142418724816905318e-01),
+  fixed(-9.99077727752645361470e-01),
+  fixed(-9.99010685854073376966e-01),
+  fixed(-9.98941293186856871245e-01),
+  fixed(-9.98869549914283560987e-01),
+  fixed(-9.98795456205172405006e-01),
+  fixed(-9.98719012233872938111e-01),
+  fixed(-9.98640218180265271108e-01),
+  fixed(-9.98559074229759313646e-01),
+  fixed(-9.98475580573294774211e-01),
+  fixed(-9.98389737407340160935e-01),
+  fixed(-9.98301544933892892608e-01),
+  fixed(-9.98211003360478188462e-01),
+  fixed(-9.98118112900149179190e-01),
+  fixed(-9.98022873771486240813e-01),
+  fixed(-9.97925286198595995479e-01),
+  fixed(-9.97825350411111644533e-01),
+  fixed(-9.97723066644191636243e-01),
+  fixed(-9.97618435138519554783e-01),
+  fixed(-9.97511456140303454099e-01),
+  fixed(-9.97402129901275302792e-01),
+  fixed(-9.97290456678690206971e-01),
+  fixed(-9.97176436735326188199e-01),
+  fixed(-9.97060070339482962254e-01),
+  fixed(-9.96941357764982161171e-01),
+  fixed(-9.96820299291165667910e-01),
+  fixed(-9.96696895202896060439e-01),
+  fixed(-9.96571145790554835386e-01),
+  fixed(-9.96443051350042630077e-01),
+  fixed(-9.96312612182778001291e-01),
+  fixed(-9.96179828595696870153e-01),
+  fixed(-9.96044700901252078040e-01),
+  fixed(-9.95907229417411721251e-01),
+  fixed(-9.95767414467659817134e-01),
+  fixed(-9.95625256380994305694e-01),
+  fixed(-9.95480755491926938561e-01),
+  fixed(-9.95333912140482279796e-01),
+  fixed(-9.95184726672196928732e-01),
+  fixed(-9.95033199438118631797e-01),
+  fixed(-9.94879330794805616378e-01),
+  fixed(-9.94723121104325702646e-01),
+  fixed(-9.94564570734255415374e-01),
+  fixed(-9.94403680057679095761e-01),
+  fixed(-9.94240449453188013251e-01),
+  fixed(-9.94074879304879477360e-01),
+  fixed(-9.93906970002356060512e-01),
+  fixed(-9.93736721940724598845e-01),
+  fixed(-9.93564135520595304030e-01),
+  fixed(-9.93389211148080764069e-01),
+  fixed(-9.93211949234794611030e-01),
+  fixed(-9.93032350197851410023e-01),
+  fixed(-9.92850414459865104888e-01),
+  fixed(-9.92666142448948018995e-01),
+  fixed(-9.92479534598710078086e-01),
+  fixed(-9.92290591348257366988e-01),
+  fixed(-9.92099313142191796544e-01),
+  fixed(-9.91905700430609327256e-01),
+  fixed(-9.91709753669099525197e-01),
+  fixed(-9.91511473318743896677e-01),
+  fixed(-9.91310859846115444149e-01),
+  fixed(-9.91107913723276889861e-01),
+  fixed(-9.90902635427780009714e-01),
+  fixed(-9.90695025442664634063e-01),
+  fixed(-9.90485084256456982388e-01),
+  fixed(-9.90272812363169219196e-01),
+  fixed(-9.90058210262297122561e-01),
+  fixed(-9.89841278458820528208e-01),
+  fixed(-9.89622017463200887022e-01),
+  fixed(-9.89400427791380376874e-01),
+  fixed(-9.89176509964780903417e-01),
+  fixed(-9.88950264510303100884e-01),
+  fixed(-9.88721691960323778581e-01),
+  fixed(-9.88490792852696698034e-01),
+  fixed(-9.88257567730749464374e-01),
+  fixed(-9.88022017143283526330e-01),
+  fixed(-9.87784141644572288854e-01),
+  fixed(-9.87543941794359336761e-01),
+  fixed(-9.87301418157858434732e-01),
+  fixed(-9.87056571305751084822e-01),
+  fixed(-9.86809401814185416235e-01),
+  fixed(-9.86559910264775408173e-01),
+  fixed(-9.86308097244598780406e-01),
+  fixed(-9.86053963346195549988e-01),
+  fixed(-9.85797509167567476140e-01),
+  fixed(-9.85538735312176061854e-01),
+  fixed(-9.85277642388941221618e-01),
+  fixed(-9.85014231012239949159e-01),
+  fixed(-9.84748501801904319031e-01),
+  fixed(-9.84480455383220931509e-01),
+  fixed(-9.84210092386929136232e-01),
+  fixed(-9.83937413449218922779e-01),
+  fixed(-9.83662419211730254531e-01),
+  fixed(-9.83385110321551292323e-01),
+  fixed(-9.83105487431216396033e-01),
+  fixed(-9.82823551198705347431e-01),
+  fixed(-9.82539302287441240757e-01),
+  fixed(-9.82252741366289372493e-01),
+  fixed(-9.81963869109555353987e-01),
+  fixed(-9.81672686196983224072e-01),
+  fixed(-9.81379193313754671912e-01),
+  fixed(-9.81083391150486705534e-01),
+  fixed(-9.80785280403230430579e-01),
+  fixed(-9.80484861773469273949e-01),
+  fixed(-9.80182135968117540514e-01),
+  fixed(-9.79877103699517748581e-01),
+  fixed(-9.79569765685440629888e-01),
+  fixed(-9.79260122649082020985e-01),
+  fixed(-9.78948175319062197097e-01),
+  fixed(-9.78633924429423318614e-01),
+  fixed(-9.78317370719627765752e-01),
+  fixed(-9.77998514934557139355e-01),
+  fixed(-9.77677357824510040452e-01),
+  fixed(-9.77353900145199960825e-01),
+  fixed(-9.77028142657754283817e-01),
+  fixed(-9.76700086128711952860e-01),
+  fixed(-9.76369731330021251026e-01),
+  fixed(-9.76037079039039134898e-01),
+  fixed(-9.75702130038528570033e-01),
+  fixed(-9.75364885116656976649e-01),
+  fixed(-9.75025345066994231225e-01),
+  fixed(-9.74683510688510779119e-01),
+  fixed(-9.74339382785575969237e-01),
+  fixed(-9.73992962167955944608e-01),
+  fixed(-9.73644249650811866026e-01),
+  fixed(-9.73293246054698135694e-01),
+  fixed(-9.72939952205560287801e-01),
+  fixed(-9.72584368934732323986e-01),
+  fixed(-9.72226497078936380269e-01),
+  fixed(-9.71866337480279396388e-01),
+  fixed(-9.71503890986251783524e-01),
+  fixed(-9.71139158449725314881e-01),
+  fixed(-9.70772140728950461153e-01),
+  fixed(-9.70402838687555502339e-01),
+  fixed(-9.70031253194543974239e-01),
+  fixed(-9.69657385124292447998e-01),
+  fixed(-9.69281235356548420690e-01),
+  fixed(-9.68902804776428983047e-01),
+  fixed(-9.68522094274417377768e-01),
+  fixed(-9.68139104746362444409e-01),
+  fixed(-9.67753837093475510756e-01),
+  fixed(-9.67366292222328505446e-01),
+  fixed(-9.66976471044852292636e-01),
+  fixed(-9.66584374478333230307e-01),
+  fixed(-9.66190003445412615157e-01),
+  fixed(-9.65793358874083684995e-01),
+  fixed(-9.65394441697689398296e-01),
+  fixed(-9.64993252854920324779e-01),
+  fixed(-9.64589793289812869048e-01),
+  fixed(-9.64184063951745939924e-01),
+  fixed(-9.63776065795439951245e-01),
+  fixed(-9.63365799780954046305e-01),
+  fixed(-9.62953266873683877414e-01),
+  fixed(-9.62538468044359385445e-01),
+  fixed(-9.62121404269041691215e-01),
+  fixed(-9.61702076529122651394e-01),
+  fixed(-9.61280485811320639655e-01),
+  fixed(-9.60856633107679658501e-01),
+  fixed(-9.60430519415565786545e-01),
+  fixed(-9.60002145737666068293e-01),
+  fixed(-9.59571513081984628357e-01),
+  fixed(-9.59138622461842005329e-01),
+  fixed(-9.58703474895871599060e-01),
+  fixed(-9.58266071408017672262e-01),
+  fixed(-9.57826413027533019040e-01),
+  fixed(-9.57384500788976078312e-01),
+  fixed(-9.56940335732208935404e-01),
+  fixed(-9.56493918902395101611e-01),
+  fixed(-9.56045251349996405565e-01),
+  fixed(-9.55594334130770994840e-01),
+  fixed(-9.55141168305770893454e-01),
+  fixed(-9.54685754941338449164e-01),
+  fixed(-9.54228095109105667326e-01),
+  fixed(-9.53768189885990325116e-01),
+  fixed(-9.53306040354193862107e-01),
+  fixed(-9.52841647601198826756e-01),
+  fixed(-9.52375012719765989821e-01),
+  fixed(-9.51906136807932456989e-01),
+  fixed(-9.51435020969008449221e-01),
+  fixed(-9.50961666311575082311e-01),
+  fixed(-9.50486073949481702350e-01),
+  fixed(-9.50008245001843221189e-01),
+  fixed(-9.49528180593036785773e-01),
+  fixed(-9.49045881852700667913e-01),
+  fixed(-9.48561349915730267490e-01),
+  fixed(-9.48074585922276225070e-01),
+  fixed(-9.47585591017741313280e-01),
+  fixed(-9.47094366352777328188e-01),
+  fixed(-9.46600913083283646010e-01),
+  fixed(-9.46105232370403448350e-01),
+  fixed(-9.45607325380521279712e-01),
+  fixed(-9.45107193285260493987e-01),
+  fixed(-9.44604837261480478894e-01),
+  fixed(-9.44100258491272770200e-01),
+  fixed(-9.43593458161960385588e-01),
+  fixed(-9.43084437466093494784e-01),
+  fixed(-9.42573197601446866045e-01),
+  fixed(-9.42059739771017534693e-01),
+  fixed(-9.41544065183020917331e-01),
+  fixed(-9.41026175050889368556e-01),
+  fixed(-9.40506070593268406199e-01),
+  fixed(-9.39983753034013935768e-01),
+  fixed(-9.39459223602189807956e-01),
+  fixed(-9.38932483532064710019e-01),
+  fixed(-9.38403534063108279994e-01),
+  fixed(-9.37872376439989885455e-01),
+  fixed(-9.37339011912574959773e-01),
+  fixed(-9.36803441735921560429e-01),
+  fixed(-9.36265667170278481635e-01),
+  fixed(-9.35725689481080480370e-01),
+  fixed(-9.35183509938947721274e-01),
+  fixed(-9.34639129819680780642e-01),
+  fixed(-9.34092550404258870067e-01),
+  fixed(-9.33543772978836172705e-01),
+  fixed(-9.32992798834739067715e-01),
+  fixed(-9.32439629268462577549e-01),
+  fixed(-9.31884265581668147505e-01),
+  fixed(-9.31326709081180537098e-01),
+  fixed(-9.30766961078983712241e-01),
+  fixed(-9.30205022892219290931e-01),
+  fixed(-9.29640895843181436220e-01),
+  fixed(-9.29074581259315968040e-01),
+  fixed(-9.28506080473215589244e-01),
+  fixed(-9.27935394822617887201e-01),
+  fixed(-9.27362525650401003929e-01),
+  fixed(-9.26787474304581970763e-01),
+  fixed(-9.26210242138311490301e-01),
+  fixed(-9.25630830509872826184e-01),
+  fixed(-9.25049240782677584249e-01),
+  fixed(-9.24465474325262603905e-01),
+  fixed(-9.23879532511286627461e-01),
+  fixed(-9.23291416719527857637e-01),
+  fixed(-9.22701128333878739518e-01),
+  fixed(-9.22108668743345183394e-01),
+  fixed(-9.21514039342041901826e-01),
+  fixed(-9.20917241529189412041e-01),
+  fixed(-9.20318276709110816292e-01),
+  fixed(-9.19717146291227471977e-01),
+  fixed(-9.19113851690057881427e-01),
+  fixed(-9.18508394325212251807e-01),
+  fixed(-9.17900775621390385695e-01),
+  fixed(-9.17290997008377795296e-01),
+  fixed(-9.16679059921042815873e-01),
+  fixed(-9.16064965799331831775e-01),
+  fixed(-9.15448716088267833157e-01),
+  fixed(-9.14830312237946197129e-01),
+  fixed(-9.14209755703530579929e-01),
+  fixed(-9.13587047945251029546e-01),
+  fixed(-9.12962190428398323583e-01),
+  fixed(-9.12335184623322859032e-01),
+  fixed(-9.11706032005429878318e-01),
+  fixed(-9.11074734055176249647e-01),
+  fixed(-9.10441292258067136345e-01),
+  fixed(-9.09805708104652444135e-01),
+  fixed(-9.09167983090522491274e-01),
+  fixed(-9.08528118716306232194e-01),
+  fixed(-9.07886116487666261499e-01),
+  fixed(-9.07241977915295816359e-01),
+  fixed(-9.06595704514915556871e-01),
+  fixed(-9.05947297807268681069e-01),
+  fixed(-9.05296759318118926529e-01),
+  fixed(-9.04644090578246240497e-01),
+  fixed(-9.03989293123443338196e-01),
+  fixed(-9.03332368494511706025e-01),
+  fixed(-9.02673318237259048047e-01),
+  fixed(-9.02012143902493290781e-01),
+  fixed(-9.01348847046022139118e-01),
+  fixed(-9.00683429228646859066e-01),
+  fixed(-9.00015892016160168332e-01),
+  fixed(-8.99346236979341795426e-01),
+  fixed(-8.98674465693954038770e-01),
+  fixed(-8.98000579740739990342e-01),
+  fixed(-8.97324580705418317628e-01),
+  fixed(-8.96646470178680154994e-01),
+  fixed(-8.95966249756184995867e-01),
+  fixed(-8.95283921038557695127e-01),
+  fixed(-8.94599485631382806972e-01),
+  fixed(-8.93912945145203363673e-01),
+  fixed(-8.93224301195515324459e-01),
+  fixed(-8.92533555402764577913e-01),
+  fixed(-8.91840709392342945172e-01),
+  fixed(-8.91145764794583405966e-01),
+  fixed(-8.90448723244757989193e-01),
+  fixed(-8.89749586383072887941e-01),
+  fixed(-8.89048355854664573705e-01),
+  fixed(-8.88345033309596243676e-01),
+  fixed(-8.87639620402854157000e-01),
+  fixed(-8.86932118794342305712e-01),
+  fixed(-8.86222530148880749401e-01),
+  fixed(-8.85510856136199953070e-01),
+  fixed(-8.84797098430937678515e-01),
+  fixed(-8.84081258712635320585e-01),
+  fixed(-8.83363338665731800958e-01),
+  fixed(-8.82643339979562902009e-01),
+  fixed(-8.81921264348355049556e-01),
+  fixed(-8.81197113471221982195e-01),
+  fixed(-8.80470889052160643473e-01),
+  fixed(-8.79742592800047629176e-01),
+  fixed(-8.79012226428633636210e-01),
+  fixed(-8.78279791656541575229e-01),
+  fixed(-8.77545290207261352577e-01),
+  fixed(-8.76808723809145651451e-01),
+  fixed(-8.76070094195406934290e-01),
+  fixed(-8.75329403104111003486e-01),
+  fixed(-8.74586652278176224229e-01),
+  fixed(-8.73841843465366863164e-01),
+  fixed(-8.73094978418290090794e-01),
+  fixed(-8.72346058894391429561e-01),
+  fixed(-8.71595086655951312160e-01),
+  fixed(-8.70842063470079086329e-01),
+  fixed(-8.70086991108711460541e-01),
+  fixed(-8.69329871348606730841e-01),
+  fixed(-8.68570705971340784046e-01),
+  fixed(-8.67809496763303545031e-01),
+  fixed(-8.67046245515692870498e-01),
+  fixed(-8.66280954024513105693e-01),
+  fixed(-8.65513624090569089198e-01),
+  fixed(-8.64744257519462378170e-01),
+  fixed(-8.63972856121586585409e-01),
+  fixed(-8.63199421712124381756e-01),
+  fixed(-8.62423956111040723727e-01),
+  fixed(-8.61646461143081410228e-01),
+  fixed(-8.60866938637767309395e-01),
+  fixed(-8.60085390429390139744e-01),
+  fixed(-8.59301818357008695415e-01),
+  fixed(-8.58516224264442961989e-01),
+  fixed(-8.57728610000272229108e-01),
+  fixed(-8.56938977417828762206e-01),
+  fixed(-8.56147328375194471839e-01),
+  fixed(-8.55353664735195917679e-01),
+  fixed(-8.54557988365400755804e-01),
+  fixed(-8.53760301138111521446e-01),
+  fixed(-8.52960604930363741616e-01),
+  fixed(-8.52158901623919828872e-01),
+  fixed(-8.51355193105265084519e-01),
+  fixed(-8.50549481265603701807e-01),
+  fixed(-8.49741768000852659704e-01),
+  fixed(-8.48932055211639724490e-01),
+  fixed(-8.48120344803297343539e-01),
+  fixed(-8.47306638685858315441e-01),
+  fixed(-8.46490938774052015248e-01),
+  fixed(-8.45673246987299287447e-01),
+  fixed(-8.44853565249707227913e-01),
+  fixed(-8.44031895490066519372e-01),
+  fixed(-8.43208239641845436196e-01),
+  fixed(-8.42382599643185847604e-01),
+  fixed(-8.41554977436898776766e-01),
+  fixed(-8.40725374970458294577e-01),
+  fixed(-8.39893794195999632279e-01),
+  fixed(-8.39060237070312742169e-01),
+  fixed(-8.38224705554837967725e-01),
+  fixed(-8.37387201615661824761e-01),
+  fixed(-8.36547727223512227468e-01),
+  fixed(-8.35706284353752715255e-01),
+  fixed(-8.34862874986380121278e-01),
+  fixed(-8.34017501106018133150e-01),
+  fixed(-8.33170164701913074090e-01),
+  fixed(-8.32320867767930017145e-01),
+  fixed(-8.31469612302545457716e-01),
+  fixed(-8.30616400308846425382e-01),
+  fixed(-8.29761233794523156426e-01),
+  fixed(-8.28904114771864874989e-01),
+  fixed(-8.28045045257755685242e-01),
+  fixed(-8.27184027273669353342e-01),
+  fixed(-8.26321062845663645291e-01),
+  fixed(-8.25456154004377662403e-01),
+  fixed(-8.24589302785025290987e-01),
+  fixed(-8.23720511227391316567e-01),
+  fixed(-8.22849781375826649921e-01),
+  fixed(-8.21977115279241776769e-01),
+  fixed(-8.21102514991104870390e-01),
+  fixed(-8.20225982569434686198e-01),
+  fixed(-8.19347520076796898003e-01),
+  fixed(-8.18467129580298546898e-01),
+  fixed(-8.17584813151584044455e-01),
+  fixed(-8.16700572866827956275e-01),
+  fixed(-8.15814410806733891768e-01),
+  fixed(-8.14926329056526621564e-01),
+  fixed(-8.14036329705948302760e-01),
+  fixed(-8.13144414849253927002e-01),
+  fixed(-8.12250586585204215062e-01),
+  fixed(-8.11354847017063951498e-01),
+  fixed(-8.10457198252594879229e-01),
+  fixed(-8.09557642404051258644e-01),
+  fixed(-8.08656181588174871600e-01),
+  fixed(-8.07752817926190691544e-01),
+  fixed(-8.06847553543799445031e-01),
+  fixed(-8.05940390571176390466e-01),
+  fixed(-8.05031331142963657577e-01),
+  fixed(-8.04120377398265695490e-01),
+  fixed(-8.03207531480645275934e-01),
+  fixed(-8.02292795538115943721e-01),
+  fixed(-8.01376171723140351411e-01),
+  fixed(-8.00457662192622820818e-01),
+  fixed(-7.99537269107905013144e-01),
+  fixed(-7.98614994634760710923e-01),
+  fixed(-7.97690840943391377138e-01),
+  fixed(-7.96764810208418938764e-01),
+  fixed(-7.95836904608883677348e-01),
+  fixed(-7.94907126328237012558e-01),
+  fixed(-7.93975477554337061292e-01),
+  fixed(-7.93041960479444085763e-01),
+  fixed(-7.92106577300212610915e-01),
+  fixed(-7.91169330217690314200e-01),
+  fixed(-7.90230221437310142996e-01),
+  fixed(-7.89289253168885651668e-01),
+  fixed(-7.88346427626606116590e-01),
+  fixed(-7.87401747029031762182e-01),
+  fixed(-7.86455213599085989351e-01),
+  fixed(-7.85506829564054043225e-01),
+  fixed(-7.84556597155575241587e-01),
+  fixed(-7.83604518609638200921e-01),
+  fixed(-7.82650596166576062451e-01),
+  fixed(-7.81694832071059719780e-01),
+  fixed(-7.80737228572094599244e-01),
+  fixed(-7.79777787923014553684e-01),
+  fixed(-7.78816512381475978266e-01),
+  fixed(-7.77853404209452925500e-01),
+  fixed(-7.76888465673232775366e-01),
+  fixed(-7.75921699043407797625e-01),
+  fixed(-7.74953106594874041591e-01),
+  fixed(-7.73982690606822787416e-01),
+  fixed(-7.73010453362736882355e-01),
+  fixed(-7.72036397150384856580e-01),
+  fixed(-7.71060524261814039804e-01),
+  fixed(-7.70082836993348118781e-01),
+  fixed(-7.69103337645579698822e-01),
+  fixed(-7.68122028523365418806e-01),
+  fixed(-7.67138911935820289045e-01),
+  fixed(-7.66153990196313250394e-01),
+  fixed(-7.65167265622459180641e-01),
+  fixed(-7.64178740536116896109e-01),
+  fixed(-7.63188417263381269073e-01),
+  fixed(-7.62196298134578897887e-01),
+  fixed(-7.61202385484262222803e-01),
+  fixed(-7.60206681651202753613e-01),
+  fixed(-7.59209188978388183067e-01),
+  fixed(-7.58209909813015392466e-01),
+  fixed(-7.57208846506484567485e-01),
+  fixed(-7.56206001414394424209e-01),
+  fixed(-7.55201376896536880068e-01),
+  fixed(-7.54194975316889393291e-01),
+  fixed(-7.53186799043612631444e-01),
+  fixed(-7.52176850449042699864e-01),
+  fixed(-7.51165131909686367706e-01),
+  fixed(-7.50151645806215405798e-01),
+  fixed(-7.49136394523459592243e-01),
+  fixed(-7.48119380450403714811e-01),
+  fixed(-7.47100605980180243471e-01),
+  fixed(-7.46080073510063779274e-01),
+  fixed(-7.45057785441465836307e-01),
+  fixed(-7.44033744179929623641e-01),
+  fixed(-7.43007952135121940707e-01),
+  fixed(-7.41980411720831178890e-01),
+  fixed(-7.40951125354959105884e-01),
+  fixed(-7.39920095459516091729e-01),
+  fixed(-7.38887324460615557697e-01),
+  fixed(-7.37852814788466315754e-01),
+  fixed(-7.36816568877370015045e-01),
+  fixed(-7.35778589165713592379e-01),
+  fixed(-7.34738878095963388049e-01),
+  fixed(-7.33697438114660149822e-01),
+  fixed(-7.32654271672413148764e-01),
+  fixed(-7.31609381223892851764e-01),
+  fixed(-7.30562769227827701890e-01),
+  fixed(-7.29514438146997012957e-01),
+  fixed(-7.28464390448225085350e-01),
+  fixed(-7.27412628602376210019e-01),
+  fixed(-7.26359155084346341802e-01),
+  fixed(-7.25303972373060990009e-01),
+  fixed(-7.24247082951467002765e-01),
+  fixed(-7.23188489306527348965e-01),
+  fixed(-7.22128193929215234093e-01),
+  fixed(-7.21066199314508438079e-01),
+  fixed(-7.20002507961381876811e-01),
+  fixed(-7.18937122372804604531e-01),
+  fixed(-7.17870045055731820227e-01),
+  fixed(-7.16801278521099427543e-01),
+  fixed(-7.15730825283819038773e-01),
+  fixed(-7.14658687862769315124e-01),
+  fixed(-7.13584868780793746268e-01),
+  fixed(-7.12509370564692434691e-01),
+  fixed(-7.11432195745216433558e-01),
+  fixed(-7.10353346857062195596e-01),
+  fixed(-7.09272826438866021981e-01),
+  fixed(-7.08190637033195624639e-01),
+  fixed(-7.07106781186547683760e-01),
+  fixed(-7.06021261449339854188e-01),
+  fixed(-7.04934080375904881244e-01),
+  fixed(-7.03845240524485382672e-01),
+  fixed(-7.02754744457225632992e-01),
+  fixed(-7.01662594740168676921e-01),
+  fixed(-7.00568793943248446787e-01),
+  fixed(-6.99473344640283767326e-01),
+  fixed(-6.98376249408972693544e-01),
+  fixed(-6.97277510830886959603e-01),
+  fixed(-6.96177131491463208057e-01),
+  fixed(-6.95075113980000991454e-01),
+  fixed(-6.93971460889654001569e-01),
+  fixed(-6.92866174817424629317e-01),
+  fixed(-6.91759258364158191590e-01),
+  fixed(-6.90650714134534937649e-01),
+  fixed(-6.89540544737067162551e-01),
+  fixed(-6.88428752784090547401e-01),
+  fixed(-6.87315340891759052333e-01),
+  fixed(-6.86200311680038477213e-01),
+  fixed(-6.85083667772700799503e-01),
+  fixed(-6.83965411797315736564e-01),
+  fixed(-6.82845546385248192145e-01),
+  fixed(-6.81724074171649818688e-01),
+  fixed(-6.80600997795453022121e-01),
+  fixed(-6.79476319899365521771e-01),
+  fixed(-6.78350043129861801638e-01),
+  fixed(-6.77222170137180667915e-01),
+  fixed(-6.76092703575316034126e-01),
+  fixed(-6.74961646102012036152e-01),
+  fixed(-6.73829000378755926803e-01),
+  fixed(-6.72694769070773301856e-01),
+  fixed(-6.71558954847018663159e-01),
+  fixed(-6.70421560380173309213e-01),
+  fixed(-6.69282588346636120313e-01),
+  fixed(-6.68142041426518451530e-01),
+  fixed(-6.66999922303638026477e-01),
+  fixed(-6.65856233665510055530e-01),
+  fixed(-6.64710978203345126403e-01),
+  fixed(-6.63564158612039878271e-01),
+  fixed(-6.62415777590171783729e-01),
+  fixed(-6.61265837839992043357e-01),
+  fixed(-6.60114342067420922788e-01),
+  fixed(-6.58961292982037649679e-01),
+  fixed(-6.57806693297078859395e-01),
+  fixed(-6.56650545729429047093e-01),
+  fixed(-6.55492852999615349674e-01),
+  fixed(-6.54333617831800995468e-01),
+  fixed(-6.53172842953777088582e-01),
+  fixed(-6.52010531096959722319e-01),
+  fixed(-6.50846684996380986377e-01),
+  fixed(-6.49681307390683193681e-01),
+  fixed(-6.48514401022112330075e-01),
+  fixed(-6.47345968636512503203e-01),
+  fixed(-6.46176012983316616634e-01),
+  fixed(-6.45004536815544149420e-01),
+  fixed(-6.43831542889791497153e-01),
+  fixed(-6.42657033966226753918e-01),
+  fixed(-6.41481012808583606066e-01),
+  fixed(-6.40303482184152006340e-01),
+  fixed(-6.39124444863775953429e-01),
+  fixed(-6.37943903621844166096e-01),
+  fixed(-6.36761861236284198995e-01),
+  fixed(-6.35578320488556003376e-01),
+  fixed(-6.34393284163645931883e-01),
+  fixed(-6.33206755050057523704e-01),
+  fixed(-6.32018735939809173097e-01),
+  fixed(-6.30829229628424581477e-01),
+  fixed(-6.29638238914926984258e-01),
+  fixed(-6.28445766601833155640e-01),
+  fixed(-6.27251815495144526835e-01),
+  fixed(-6.26056388404343744369e-01),
+  fixed(-6.24859488142386454435e-01),
+  fixed(-6.23661117525694530528e-01),
+  fixed(-6.22461279374149856203e-01),
+  fixed(-6.21259976511087996798e-01),
+  fixed(-6.20057211763289539697e-01),
+  fixed(-6.18852987960976541615e-01),
+  fixed(-6.17647307937803979883e-01),
+  fixed(-6.16440174530853535195e-01),
+  fixed(-6.15231590580627374365e-01),
+  fixed(-6.14021558931038824447e-01),
+  fixed(-6.12810082429409930249e-01),
+  fixed(-6.11597163926462017436e-01),
+  fixed(-6.10382806276309475280e-01),
+  fixed(-6.09167012336453095322e-01),
+  fixed(-6.07949784967774076172e-01),
+  fixed(-6.06731127034524808650e-01),
+  fixed(-6.05511041404325656146e-01),
+  fixed(-6.04289530948156072832e-01),
+  fixed(-6.03066598540348164370e-01),
+  fixed(-6.01842247058580581687e-01),
+  fixed(-6.00616479383869306119e-01),
+  fixed(-5.99389298400564762836e-01),
+  fixed(-5.98160706996342383945e-01),
+  fixed(-5.96930708062196502262e-01),
+  fixed(-5.95699304492433245883e-01),
+  fixed(-5.94466499184664876054e-01),
+  fixed(-5.93232295039800128222e-01),
+  fixed(-5.91996694962041103416e-01),
+  fixed(-5.90759701858874275437e-01),
+  fixed(-5.89521318641063829524e-01),
+  fixed(-5.88281548222645778168e-01),
+  fixed(-5.87040393520918413195e-01),
+  fixed(-5.85797857456439086121e-01),
+  fixed(-5.84553942953015437389e-01),
+  fixed(-5.83308652937698290941e-01),
+  fixed(-5.82061990340775436970e-01),
+  fixed(-5.80813958095764970579e-01),
+  fixed(-5.79564559139406076937e-01),
+  fixed(-5.78313796411655811625e-01),
+  fixed(-5.77061672855679552718e-01),
+  fixed(-5.75808191417845227633e-01),
+  fixed(-5.74553355047716318715e-01),
+  fixed(-5.73297166698042648392e-01),
+  fixed(-5.72039629324757381568e-01),
+  fixed(-5.70780745886967366687e-01),
+  fixed(-5.69520519346947140527e-01),
+  fixed(-5.68258952670131378682e-01),
+  fixed(-5.66996048825109122404e-01),
+  fixed(-5.65731810783613564553e-01),
+  fixed(-5.64466241520519607100e-01),
+  fixed(-5.63199344013834202194e-01),
+  fixed(-5.61931121244689357752e-01),
+  fixed(-5.60661576197336586347e-01),
+  fixed(-5.59390711859136469108e-01),
+  fixed(-5.58118531220556435279e-01),
+  fixed(-5.56845037275160215096e-01),
+  fixed(-5.55570233019602177649e-01),
+  fixed(-5.54294121453620003415e-01),
+  fixed(-5.53016705580028022915e-01),
+  fixed(-5.51737988404707779821e-01),
+  fixed(-5.50457972936605033354e-01),
+  fixed(-5.49176662187719766273e-01),
+  fixed(-5.47894059173100078652e-01),
+  fixed(-5.46610166910835415521e-01),
+  fixed(-5.45324988422046796899e-01),
+  fixed(-5.44038526730884153260e-01),
+  fixed(-5.42750784864516000461e-01),
+  fixed(-5.41461765853123444536e-01),
+  fixed(-5.40171472729892743203e-01),
+  fixed(-5.38879908531008866568e-01),
+  fixed(-5.37587076295645838186e-01),
+  fixed(-5.36292979065963404395e-01),
+  fixed(-5.34997619887097264346e-01),
+  fixed(-5.33701001807152852763e-01),
+  fixed(-5.32403127877198567575e-01),
+  fixed(-5.31104001151255444846e-01),
+  fixed(-5.29803624686294938329e-01),
+  fixed(-5.28502001542228594388e-01),
+  fixed(-5.27199134781901390667e-01),
+  fixed(-5.25895027471084519632e-01),
+  fixed(-5.24589682678469393373e-01),
+  fixed(-5.23283103475656763415e-01),
+  fixed(-5.21975292937154500272e-01),
+  fixed(-5.20666254140367268377e-01),
+  fixed(-5.19355990165589531671e-01),
+  fixed(-5.18044504095999891469e-01),
+  fixed(-5.16731799017650317296e-01),
+  fixed(-5.15417878019463260308e-01),
+  fixed(-5.14102744193221883329e-01),
+  fixed(-5.12786400633563066442e-01),
+  fixed(-5.11468850437970301570e-01),
+  fixed(-5.10150096706767253174e-01),
+  fixed(-5.08830142543107433184e-01),
+  fixed(-5.07508991052971092373e-01),
+  fixed(-5.06186645345155339371e-01),
+  fixed(-5.04863108531267479329e-01),
+  fixed(-5.03538383725718130535e-01),
+  fixed(-5.02212474045711232407e-01),
+  fixed(-5.00885382611241047890e-01),
+  fixed(-4.99557112545082004917e-01),
+  fixed(-4.98227666972781868537e-01),
+  fixed(-4.96897049022654413442e-01),
+  fixed(-4.95565261825773040183e-01),
+  fixed(-4.94232308515960117035e-01),
+  fixed(-4.92898192229784259943e-01),
+  fixed(-4.91562916106550007456e-01),
+  fixed(-4.90226483288291103868e-01),
+  fixed(-4.88888896919763726867e-01),
+  fixed(-4.87550160148436384500e-01),
+  fixed(-4.86210276124486695526e-01),
+  fixed(-4.84869248000791230879e-01),
+  fixed(-4.83527078932918741305e-01),
+  fixed(-4.82183772079122607845e-01),
+  fixed(-4.80839330600334458055e-01),
+  fixed(-4.79493757660153396838e-01),
+  fixed(-4.78147056424843286404e-01),
+  fixed(-4.76799230063322199147e-01),
+  fixed(-4.75450281747155811818e-01),
+  fixed(-4.74100214650550577655e-01),
+  fixed(-4.72749031950343234776e-01),
+  fixed(-4.71396736825997919595e-01),
+  fixed(-4.70043332459595786244e-01),
+  fixed(-4.68688822035827956647e-01),
+  fixed(-4.67333208741988304080e-01),
+  fixed(-4.65976495767966680805e-01),
+  fixed(-4.64618686306238204420e-01),
+  fixed(-4.63259783551860426787e-01),
+  fixed(-4.61899790702462842429e-01),
+  fixed(-4.60538710958239949633e-01),
+  fixed(-4.59176547521944700136e-01),
+  fixed(-4.57813303598877674450e-01),
+  fixed(-4.56448982396884250790e-01),
+  fixed(-4.55083587126344002449e-01),
+  fixed(-4.53717121000163869926e-01),
+  fixed(-4.52349587233770722428e-01),
+  fixed(-4.50980989045104363466e-01),
+  fixed(-4.49611329654606983741e-01),
+  fixed(-4.48240612285220163535e-01),
+  fixed(-4.46868840162374270086e-01),
+  fixed(-4.45496016513981685225e-01),
+  fixed(-4.44122144570429810972e-01),
+  fixed(-4.42747227564570466907e-01),
+  fixed(-4.41371268731717003586e-01),
+  fixed(-4.39994271309633422362e-01),
+  fixed(-4.38616238538527658530e-01),
+  fixed(-4.37237173661043976303e-01),
+  fixed(-4.35857079922256029914e-01),
+  fixed(-4.34475960569656094457e-01),
+  fixed(-4.33093818853152179305e-01),
+  fixed(-4.31710658025057369969e-01),
+  fixed(-4.30326481340082556137e-01),
+  fixed(-4.28941292055330103405e-01),
+  fixed(-4.27555093430282528999e-01),
+  fixed(-4.26167888726799948262e-01),
+  fixed(-4.24779681209108972428e-01),
+  fixed(-4.23390474143796047279e-01),
+  fixed(-4.22000270799799570565e-01),
+  fixed(-4.20609074448403064128e-01),
+  fixed(-4.19216888363224349234e-01),
+  fixed(-4.17823715820212548966e-01),
+  fixed(-4.16429560097637263549e-01),
+  fixed(-4.15034424476081575950e-01),
+  fixed(-4.13638312238435168489e-01),
+  fixed(-4.12241226669883331635e-01),
+  fixed(-4.10843171057904243959e-01),
+  fixed(-4.09444148692257814393e-01),
+  fixed(-4.08044162864978687821e-01),
+  fixed(-4.06643216870368862104e-01),
+  fixed(-4.05241314004990416109e-01),
+  fixed(-4.03838457567654518510e-01),
+  fixed(-4.02434650859418707736e-01),
+  fixed(-4.01029897183575734232e-01),
+  fixed(-3.99624199845646788098e-01),
+  fixed(-3.98217562153374227130e-01),
+  fixed(-3.96809987416710807651e-01),
+  fixed(-3.95401478947816631404e-01),
+  fixed(-3.93992040061048265365e-01),
+  fixed(-3.92581674072951525289e-01),
+  fixed(-3.91170384302253759667e-01),
+  fixed(-3.89758174069857021848e-01),
+  fixed(-3.88345046698826690257e-01),
+  fixed(-3.86931005514388859368e-01),
+  fixed(-3.85516053843918959920e-01),
+  fixed(-3.84100195016934986558e-01),
+  fixed(-3.82683432365090392402e-01),
+  fixed(-3.81265769222162820284e-01),
+  fixed(-3.79847208924051493728e-01),
+  fixed(-3.78427754808765781647e-01),
+  fixed(-3.77007410216418259452e-01),
+  fixed(-3.75586178489217104026e-01),
+  fixed(-3.74164062971458544204e-01),
+  fixed(-3.72741067009516202635e-01),
+  fixed(-3.71317193951837820620e-01),
+  fixed(-3.69892447148934211398e-01),
+  fixed(-3.68466829953372265738e-01),
+  fixed(-3.67040345719767013843e-01),
+  fixed(-3.65612997804774353394e-01),
+  fixed(-3.64184789567080224870e-01),
+  fixed(-3.62755724367397391905e-01),
+  fixed(-3.61325805568454283545e-01),
+  fixed(-3.59895036534987999843e-01),
+  fixed(-3.58463420633737095411e-01),
+  fixed(-3.57030961233430421675e-01),
+  fixed(-3.55597661704784129277e-01),
+  fixed(-3.54163525420490510331e-01),
+  fixed(-3.52728555755210670952e-01),
+  fixed(-3.51292756085566926227e-01),
+  fixed(-3.49856129790135417235e-01),
+  fixed(-3.48418680249434897789e-01),
+  fixed(-3.46980410845923847862e-01),
+  fixed(-3.45541324963989093799e-01),
+  fixed(-3.44101425989938702887e-01),
+  fixed(-3.42660717311994933443e-01),
+  fixed(-3.41219202320282799512e-01),
+  fixed(-3.39776884406827128782e-01),
+  fixed(-3.38333766965541293814e-01),
+  fixed(-3.36889853392219995598e-01),
+  fixed(-3.35445147084531436477e-01),
+  fixed(-3.33999651442009881652e-01),
+  fixed(-3.32553369866044556957e-01),
+  fixed(-3.31106305759876595740e-01),
+  fixed(-3.29658462528587548057e-01),
+  fixed(-3.28209843579092386268e-01),
+  fixed(-3.26760452320132344095e-01),
+  fixed(-3.25310292162263370308e-01),
+  fixed(-3.23859366517853131118e-01),
+  fixed(-3.22407678801069963459e-01),
+  fixed(-3.20955232427875214452e-01),
+  fixed(-3.19502030816015469838e-01),
+  fixed(-3.18048077385015448559e-01),
+  fixed(-3.16593375556166234386e-01),
+  fixed(-3.15137928752522611386e-01),
+  fixed(-3.13681740398891517607e-01),
+  fixed(-3.12224813921824828622e-01),
+  fixed(-3.10767152749612085572e-01),
+  fixed(-3.09308760312269170889e-01),
+  fixed(-3.07849640041535144164e-01),
+  fixed(-3.06389795370861084400e-01),
+  fixed(-3.04929229735402373969e-01),
+  fixed(-3.03467946572011093576e-01),
+  fixed(-3.02005949319228583771e-01),
+  fixed(-3.00543241417273787608e-01),
+  fixed(-2.99079826308040641614e-01),
+  fixed(-2.97615707435086251920e-01),
+  fixed(-2.96150888243623733320e-01),
+  fixed(-2.94685372180514937313e-01),
+  fixed(-2.93219162694259072310e-01),
+  fixed(-2.91752263234989539509e-01),
+  fixed(-2.90284677254462497586e-01),
+  fixed(-2.88816408206049424212e-01),
+  fixed(-2.87347459544729344483e-01),
+  fixed(-2.85877834727081114874e-01),
+  fixed(-2.84407537211272209987e-01),
+  fixed(-2.82936570457055558414e-01),
+  fixed(-2.81464937925758051929e-01),
+  fixed(-2.79992643080273106992e-01),
+  fixed(-2.78519689385053670350e-01),
+  fixed(-2.77046080306100339641e-01),
+  fixed(-2.75571819310958421312e-01),
+  fixed(-2.74096909868706495317e-01),
+  fixed(-2.72621355449948976624e-01),
+  fixed(-2.71145159526807844053e-01),
+  fixed(-2.69668325572915590360e-01),
+  fixed(-2.68190857063403564897e-01),
+  fixed(-2.66712757474898587429e-01),
+  fixed(-2.65234030285511845904e-01),
+  fixed(-2.63754678974831291427e-01),
+  fixed(-2.62274707023914199766e-01),
+  fixed(-2.60794117915275958097e-01),
+  fixed(-2.59312915132886512293e-01),
+  fixed(-2.57831102162159153668e-01),
+  fixed(-2.56348682489942858442e-01),
+  fixed(-2.54865659604514405157e-01),
+  fixed(-2.53382036995570658622e-01),
+  fixed(-2.51897818154217301156e-01),
+  fixed(-2.50413006572965446406e-01),
+  fixed(-2.48927605745720204045e-01),
+  fixed(-2.47441619167773185772e-01),
+  fixed(-2.45955050335795205596e-01),
+  fixed(-2.44467902747824594734e-01),
+  fixed(-2.42980179903264176255e-01),
+  fixed(-2.41491885302869468966e-01),
+  fixed(-2.40003022448741443196e-01),
+  fixed(-2.38513594844318249644e-01),
+  fixed(-2.37023605994367725369e-01),
+  fixed(-2.35533059404975875228e-01),
+  fixed(-2.34041958583543624473e-01),
+  fixed(-2.32550307038775300184e-01),
+  fixed(-2.31058108280670998491e-01),
+  fixed(-2.29565365820519479145e-01),
+  fixed(-2.28072083170886175107e-01),
+  fixed(-2.26578263845610278215e-01),
+  fixed(-2.25083911359792970819e-01),
+  fixed(-2.23589029229789959530e-01),
+  fixed(-2.22093620973203342839e-01),
+  fixed(-2.20597690108874061599e-01),
+  fixed(-2.19101240156870158415e-01),
+  fixed(-2.17604274638483835558e-01),
+  fixed(-2.16106797076219547815e-01),
+  fixed(-2.14608810993786675025e-01),
+  fixed(-2.13110319916091972559e-01),
+  fixed(-2.11611327369228024997e-01),
+  fixed(-2.10111836880469915467e-01),
+  fixed(-2.08611851978263623808e-01),
+  fixed(-2.07111376192218532566e-01),
+  fixed(-2.05610413053099072567e-01),
+  fixed(-2.04108966092817395444e-01),
+  fixed(-2.02607038844421494250e-01),
+  fixed(-2.01104634842092122593e-01),
+  fixed(-1.99601757621131026266e-01),
+  fixed(-1.98098410717953477000e-01),
+  fixed(-1.96594597670080833973e-01),
+  fixed(-1.95090322016128719929e-01),
+  fixed(-1.93585587295803912555e-01),
+  fixed(-1.92080397049892576122e-01),
+  fixed(-1.90574754820252739718e-01),
+  fixed(-1.89068664149806026087e-01),
+  fixed(-1.87562128582530129872e-01),
+  fixed(-1.86055151663447021493e-01),
+  fixed(-1.84547736938619838520e-01),
+  fixed(-1.83039887955141006293e-01),
+  fixed(-1.81531608261124882686e-01),
+  fixed(-1.80022901405700125332e-01),
+  fixed(-1.78513770938997978766e-01),
+  fixed(-1.77004220412149054775e-01),
+  fixed(-1.75494253377271564043e-01),
+  fixed(-1.73983873387463794380e-01),
+  fixed(-1.72473083996795784056e-01),
+  fixed(-1.70961888760301772283e-01),
+  fixed(-1.69450291233968347582e-01),
+  fixed(-1.67938294974731394671e-01),
+  fixed(-1.66425903540464187325e-01),
+  fixed(-1.64913120489969811100e-01),
+  fixed(-1.63399949382973863621e-01),
+  fixed(-1.61886393780112297636e-01),
+  fixed(-1.60372457242928562193e-01),
+  fixed(-1.58858143333861584479e-01),
+  fixed(-1.57343455616238248052e-01),
+  fixed(-1.55828397654265066175e-01),
+  fixed(-1.54312973013020632296e-01),
+  fixed(-1.52797185258443796174e-01),
+  fixed(-1.51281037957330444232e-01),
+  fixed(-1.49764534677321592415e-01),
+  fixed(-1.48247678986895947695e-01),
+  fixed(-1.46730474455362386310e-01),
+  fixed(-1.45212924652847935603e-01),
+  fixed(-1.43695033150294748658e-01),
+  fixed(-1.42176803519448197166e-01),
+  fixed(-1.40658239332849210879e-01),
+  fixed(-1.39139344163826034206e-01),
+  fixed(-1.37620121586486593435e-01),
+  fixed(-1.36100575175706589581e-01),
+  fixed(-1.34580708507126417528e-01),
+  fixed(-1.33060525157139120100e-01),
+  fixed(-1.31540028702883005085e-01),
+  fixed(-1.30019222722233984690e-01),
+  fixed(-1.28498110793793640649e-01),
+  fixed(-1.26976696496886171106e-01),
+  fixed(-1.25454983411546372452e-01),
+  fixed(-1.23932975118512159196e-01),
+  fixed(-1.22410675199216029130e-01),
+  fixed(-1.20888087235777624828e-01),
+  fixed(-1.19365214810991757122e-01),
+  fixed(-1.17842061508325199326e-01),
+  fixed(-1.16318630911904835612e-01),
+  fixed(-1.14794926606509986589e-01),
+  fixed(-1.13270952177564970809e-01),
+  fixed(-1.11746711211127058849e-01),
+  fixed(-1.10222207293883364687e-01),
+  fixed(-1.08697444013138869168e-01),
+  fixed(-1.07172424956808842733e-01),
+  fixed(-1.05647153713410435483e-01),
+  fixed(-1.04121633872055127656e-01),
+  fixed(-1.02595869022436683715e-01),
+  fixed(-1.01069862754828057594e-01),
+  fixed(-9.95436186600694022930e-02),
+  fixed(-9.80171403295605064843e-02),
+  fixed(-9.64904313552532311160e-02),
+  fixed(-9.49634953296394773714e-02),
+  fixed(-9.34363358457480919217e-02),
+  fixed(-9.19089564971328765175e-02),
+  fixed(-9.03813608778649690834e-02),
+  fixed(-8.88535525825244199005e-02),
+  fixed(-8.73255352061926282126e-02),
+  fixed(-8.57973123444402824278e-02),
+  fixed(-8.42688875933243070060e-02),
+  fixed(-8.27402645493757610273e-02),
+  fixed(-8.12114468095923441870e-02),
+  fixed(-7.96824379714307501343e-02),
+  fixed(-7.81532416327947176971e-02),
+  fixed(-7.66238613920318112349e-02),
+  fixed(-7.50943008479214718642e-02),
+  fixed(-7.35645635996674124302e-02),
+  fixed(-7.20346532468891520562e-02),
+  fixed(-7.05045733896144249941e-02),
+  fixed(-6.89743276282671347044e-02),
+  fixed(-6.74439195636642868648e-02),
+  fixed(-6.59133527970038879396e-02),
+  fixed(-6.43826309298573679074e-02),
+  fixed(-6.28517575641620585003e-02),
+  fixed(-6.13207363022090570781e-02),
+  fixed(-5.97895707466401873931e-02),
+  fixed(-5.82582645004359120366e-02),
+  fixed(-5.67268211669077412895e-02),
+  fixed(-5.51952443496897746100e-02),
+  fixed(-5.36635376527310817285e-02),
+  fixed(-5.21317046802837191777e-02),
+  fixed(-5.05997490368995175847e-02),
+  fixed(-4.90676743274180912624e-02),
+  fixed(-4.75354841569592193040e-02),
+  fixed(-4.60031821309152683108e-02),
+  fixed(-4.44707718549391464724e-02),
+  fixed(-4.29382569349411394311e-02),
+  fixed(-4.14056409770768990564e-02),
+  fixed(-3.98729275877398106620e-02),
+  fixed(-3.83401203735525344940e-02),
+  fixed(-3.68072229413593937641e-02),
+  fixed(-3.52742388982143495468e-02),
+  fixed(-3.37411718513778227657e-02),
+  fixed(-3.22080254083046621516e-02),
+  fixed(-3.06748031766365426842e-02),
+  fixed(-2.91415087641943675034e-02),
+  fixed(-2.76081457789662254587e-02),
+  fixed(-2.60747178291042200349e-02),
+  fixed(-2.45412285229124477182e-02),
+  fixed(-2.30076814688393721520e-02),
+  fixed(-2.14740802754693448084e-02),
+  fixed(-1.99404285515150034303e-02),
+  fixed(-1.84067299058052261107e-02),
+  fixed(-1.68729879472819567499e-02),
+  fixed(-1.53392062849881816861e-02),
+  fixed(-1.38053885280603107905e-02),
+  fixed(-1.22715382857205724393e-02),
+  fixed(-1.07376591672649762677e-02),
+  fixed(-9.20375478206014382976e-03),
+  fixed(-7.66982873953126094435e-03),
+  fixed(-6.13588464915447700382e-03),
+  fixed(-4.60192612044841090069e-03),
+  fixed(-3.06795676296654383150e-03),
+  fixed(-1.53398018628517185911e-03),
+#endif
+};
+const short ISINETABLE[4096] = {
+  0,
+  2,
+  3,
+  5,
+  6,
+  8,
+  9,
+  11,
+  13,
+  14,
+  16,
+  17,
+  19,
+  20,
+  22,
+  24,
+  25,
+  27,
+  28,
+  30,
+  31,
+  33,
+  35,
+  36,
+  38,
+  39,
+  41,
+  42,
+  44,
+  46,
+  47,
+  49,
+  50,
+  52,
+  53,
+  55,
+  57,
+  58,
+  60,
+  61,
+  63,
+  64,
+  66,
+  67,
+  69,
+  71,
+  72,
+  74,
+  75,
+  77,
+  78,
+  80,
+  82,
+  83,
+  85,
+  86,
+  88,
+  89,
+  91,
+  93,
+  94,
+  96,
+  97,
+  99,
+  100,
+  102,
+  103,
+  105,
+  107,
+  108,
+  110,
+  111,
+  113,
+  114,
+  116,
+  118,
+  119,
+  121,
+  122,
+  124,
+  125,
+  127,
+  128,
+  130,
+  132,
+  133,
+  135,
+  136,
+  138,
+  139,
+  141,
+  142,
+  144,
+  146,
+  147,
+  149,
+  150,
+  152,
+  153,
+  155,
+  156,
+  158,
+  160,
+  161,
+  163,
+  164,
+  166,
+  167,
+  169,
+  170,
+  172,
+  174,
+  175,
+  177,
+  178,
+  180,
+  181,
+  183,
+  184,
+  186,
+  187,
+  189,
+  191,
+  192,
+  194,
+  195,
+  197,
+  198,
+  200,
+  201,
+  203,
+  204,
+  206,
+  207,
+  209,
+  211,
+  212,
+  214,
+  215,
+  217,
+  218,
+  220,
+  221,
+  223,
+  224,
+  226,
+  227,
+  229,
+  230,
+  232,
+  234,
+  235,
+  237,
+  238,
+  240,
+  241,
+  243,
+  244,
+  246,
+  247,
+  249,
+  250,
+  252,
+  253,
+  255,
+  256,
+  258,
+  259,
+  261,
+  263,
+  264,
+  266,
+  267,
+  269,
+  270,
+  272,
+  273,
+  275,
+  276,
+  278,
+  279,
+  281,
+  282,
+  284,
+  285,
+  287,
+  288,
+  290,
+  291,
+  293,
+  294,
+  296,
+  297,
+  299,
+  300,
+  302,
+  303,
+  305,
+  306,
+  308,
+  309,
+  311,
+  312,
+  314,
+  315,
+  317,
+  318,
+  320,
+  321,
+  323,
+  324,
+  326,
+  327,
+  329,
+  330,
+  332,
+  333,
+  335,
+  336,
+  338,
+  339,
+  341,
+  342,
+  343,
+  345,
+  346,
+  348,
+  349,
+  351,
+  352,
+  354,
+  355,
+  357,
+  358,
+  360,
+  361,
+  363,
+  364,
+  366,
+  367,
+  369,
+  370,
+  371,
+  373,
+  374,
+  376,
+  377,
+  379,
+  380,
+  382,
+  383,
+  385,
+  386,
+  388,
+  389,
+  390,
+  392,
+  393,
+  395,
+  396,
+  398,
+  399,
+  401,
+  402,
+  403,
+  405,
+  406,
+  408,
+  409,
+  411,
+  412,
+  414,
+  415,
+  416,
+  418,
+  419,
+  421,
+  422,
+  424,
+  425,
+  426,
+  428,
+  429,
+  431,
+  432,
+  434,
+  435,
+  436,
+  438,
+  439,
+  441,
+  442,
+  443,
+  445,
+  446,
+  448,
+  449,
+  451,
+  452,
+  453,
+  455,
+  456,
+  458,
+  459,
+  460,
+  462,
+  463,
+  465,
+  466,
+  467,
+  469,
+  470,
+  472,
+  473,
+  474,
+  476,
+  477,
+  479,
+  480,
+  481,
+  483,
+  484,
+  485,
+  487,
+  488,
+  490,
+  491,
+  492,
+  494,
+  495,
+  497,
+  498,
+  499,
+  501,
+  502,
+  503,
+  505,
+  506,
+  507,
+  509,
+  510,
+  512,
+  513,
+  514,
+  516,
+  517,
+  518,
+  520,
+  521,
+  522,
+  524,
+  525,
+  526,
+  528,
+  529,
+  530,
+  532,
+  533,
+  535,
+  536,
+  537,
+  539,
+  540,
+  541,
+  543,
+  544,
+  545,
+  547,
+  548,
+  549,
+  550,
+  552,
+  553,
+  554,
+  556,
+  557,
+  558,
+  560,
+  561,
+  562,
+  564,
+  565,
+  566,
+  568,
+  569,
+  570,
+  572,
+  573,
+  574,
+  575,
+  577,
+  578,
+  579,
+  581,
+  582,
+  583,
+  584,
+  586,
+  587,
+  588,
+  590,
+  591,
+  592,
+  593,
+  595,
+  596,
+  597,
+  599,
+  600,
+  601,
+  602,
+  604,
+  605,
+  606,
+  607,
+  609,
+  610,
+  611,
+  613,
+  614,
+  615,
+  616,
+  618,
+  619,
+  620,
+  621,
+  623,
+  624,
+  625,
+  626,
+  628,
+  629,
+  630,
+  631,
+  632,
+  634,
+  635,
+  636,
+  637,
+  639,
+  640,
+  641,
+  642,
+  644,
+  645,
+  646,
+  647,
+  648,
+  650,
+  651,
+  652,
+  653,
+  654,
+  656,
+  657,
+  658,
+  659,
+  660,
+  662,
+  663,
+  664,
+  665,
+  666,
+  668,
+  669,
+  670,
+  671,
+  672,
+  674,
+  675,
+  676,
+  677,
+  678,
+  679,
+  681,
+  682,
+  683,
+  684,
+  685,
+  687,
+  688,
+  689,
+  690,
+  691,
+  692,
+  693,
+  695,
+  696,
+  697,
+  698,
+  699,
+  700,
+  702,
+  703,
+  704,
+  705,
+  706,
+  707,
+  708,
+  709,
+  711,
+  712,
+  713,
+  714,
+  715,
+  716,
+  717,
+  719,
+  720,
+  721,
+  722,
+  723,
+  724,
+  725,
+  726,
+  727,
+  729,
+  730,
+  731,
+  732,
+  733,
+  734,
+  735,
+  736,
+  737,
+  738,
+  739,
+  741,
+  742,
+  743,
+  744,
+  745,
+  746,
+  747,
+  748,
+  749,
+  750,
+  751,
+  752,
+  753,
+  755,
+  756,
+  757,
+  758,
+  759,
+  760,
+  761,
+  762,
+  763,
+  764,
+  765,
+  766,
+  767,
+  768,
+  769,
+  770,
+  771,
+  772,
+  773,
+  774,
+  775,
+  776,
+  777,
+  778,
+  779,
+  780,
+  782,
+  783,
+  784,
+  785,
+  786,
+  787,
+  788,
+  789,
+  790,
+  791,
+  792,
+  793,
+  794,
+  795,
+  796,
+  797,
+  798,
+  798,
+  799,
+  800,
+  801,
+  802,
+  803,
+  804,
+  805,
+  806,
+  807,
+  808,
+  809,
+  810,
+  811,
+  812,
+  813,
+  814,
+  815,
+  816,
+  817,
+  818,
+  819,
+  820,
+  821,
+  822,
+  822,
+  823,
+  824,
+  825,
+  826,
+  827,
+  828,
+  829,
+  830,
+  831,
+  832,
+  833,
+  834,
+  834,
+  835,
+  836,
+  837,
+  838,
+  839,
+  840,
+  841,
+  842,
+  843,
+  843,
+  844,
+  845,
+  846,
+  847,
+  848,
+  849,
+  850,
+  851,
+  851,
+  852,
+  853,
+  854,
+  855,
+  856,
+  857,
+  857,
+  858,
+  859,
+  860,
+  861,
+  862,
+  863,
+  863,
+  864,
+  865,
+  866,
+  867,
+  868,
+  868,
+  869,
+  870,
+  871,
+  872,
+  873,
+  873,
+  874,
+  875,
+  876,
+  877,
+  878,
+  878,
+  879,
+  880,
+  881,
+  882,
+  882,
+  883,
+  884,
+  885,
+  885,
+  886,
+  887,
+  888,
+  889,
+  889,
+  890,
+  891,
+  892,
+  893,
+  893,
+  894,
+  895,
+  896,
+  896,
+  897,
+  898,
+  899,
+  899,
+  900,
+  901,
+  902,
+  902,
+  903,
+  904,
+  905,
+  905,
+  906,
+  907,
+  907,
+  908,
+  909,
+  910,
+  910,
+  911,
+  912,
+  913,
+  913,
+  914,
+  915,
+  915,
+  916,
+  917,
+  917,
+  918,
+  919,
+  920,
+  920,
+  921,
+  922,
+  922,
+  923,
+  924,
+  924,
+  925,
+  926,
+  926,
+  927,
+  928,
+  928,
+  929,
+  930,
+  930,
+  931,
+  932,
+  932,
+  933,
+  934,
+  934,
+  935,
+  936,
+  936,
+  937,
+  937,
+  938,
+  939,
+  939,
+  940,
+  941,
+  941,
+  942,
+  942,
+  943,
+  944,
+  944,
+  945,
+  945,
+  946,
+  947,
+  947,
+  948,
+  948,
+  949,
+  950,
+  950,
+  951,
+  951,
+  952,
+  953,
+  953,
+  954,
+  954,
+  955,
+  955,
+  956,
+  957,
+  957,
+  958,
+  958,
+  959,
+  959,
+  960,
+  960,
+  961,
+  961,
+  962,
+  963,
+  963,
+  964,
+  964,
+  965,
+  965,
+  966,
+  966,
+  967,
+  967,
+  968,
+  968,
+  969,
+  969,
+  970,
+  970,
+  971,
+  971,
+  972,
+  972,
+  973,
+  973,
+  974,
+  974,
+  975,
+  975,
+  976,
+  976,
+  977,
+  977,
+  978,
+  978,
+  979,
+  979,
+  979,
+  980,
+  980,
+  981,
+  981,
+  982,
+  982,
+  983,
+  983,
+  983,
+  984,
+  984,
+  985,
+  985,
+  986,
+  986,
+  986,
+  987,
+  987,
+  988,
+  988,
+  989,
+  989,
+  989,
+  990,
+  990,
+  991,
+  991,
+  991,
+  992,
+  992,
+  993,
+  993,
+  993,
+  994,
+  994,
+  994,
+  995,
+  995,
+  996,
+  996,
+  996,
+  997,
+  997,
+  997,
+  998,
+  998,
+  998,
+  999,
+  999,
+  999,
+  1000,
+  1000,
+  1000,
+  1001,
+  1001,
+  1001,
+  1002,
+  1002,
+  1002,
+  1003,
+  1003,
+  1003,
+  1004,
+  1004,
+  1004,
+  1005,
+  1005,
+  1005,
+  1006,
+  1006,
+  1006,
+  1006,
+  1007,
+  1007,
+  1007,
+  1008,
+  1008,
+  1008,
+  1008,
+  1009,
+  1009,
+  1009,
+  1009,
+  1010,
+  1010,
+  1010,
+  1010,
+  1011,
+  1011,
+  1011,
+  1011,
+  1012,
+  1012,
+  1012,
+  1012,
+  1013,
+  1013,
+  1013,
+  1013,
+  1014,
+  1014,
+  1014,
+  1014,
+  1014,
+  1015,
+  1015,
+  1015,
+  1015,
+  1016,
+  1016,
+  1016,
+  1016,
+  1016,
+  1016,
+  1017,
+  1017,
+  1017,
+  1017,
+  1017,
+  1018,
+  1018,
+  1018,
+  1018,
+  1018,
+  1018,
+  1019,
+  1019,
+  1019,
+  1019,
+  1019,
+  1019,
+  1020,
+  1020,
+  1020,
+  1020,
+  1020,
+  1020,
+  1020,
+  1020,
+  1021,
+  1021,
+  1021,
+  1021,
+  1021,
+  1021,
+  1021,
+  1021,
+  1022,
+  1022,
+  1022,
+  1022,
+  1022,
+  1022,
+  1022,
+  1022,
+  1022,
+  1022,
+  1023,
+  1023,
+  1023,
+  1023,
+  1023,
+  1023,
+  1023,
+  1023,
+  1023,
+  1023,
+  1023,
+  1023,
+  1023,
+  1023,
+  1023,
+  1024,
+  1024,
+  1024,
+  1024,
+  1024,
+  1024,
+  1024,
+  1024,
+  1024,
+  1024,
+  1024,
+  1024,
+  1024,
+  1024,
+  1024,
+  1024,
+  1024,
+  1024,
+  1024,
+  1024,
+  1024,
+  1024,
+  1024,
+  1024,
+  1024,
+  1024,
+  1024,
+  1024,
+  1024,
+  1024,
+  1024,
+  1024,
+  1024,
+  1024,
+  1024,
+  1024,
+  1024,
+  1024,
+  1024,
+  1024,
+  1024,
+  1023,
+  1023,
+  1023,
+  1023,
+  1023,
+  1023,
+  1023,
+  1023,
+  1023,
+  1023,
+  1023,
+  1023,
+  1023,
+  1023,
+  1023,
+  1022,
+  1022,
+  1022,
+  1022,
+  1022,
+  1022,
+  1022,
+  1022,
+  1022,
+  1022,
+  1021,
+  1021,
+  1021,
+  1021,
+  1021,
+  1021,
+  1021,
+  1021,
+  1020,
+  1020,
+  1020,
+  1020,
+  1020,
+  1020,
+  1020,
+  1020,
+  1019,
+  1019,
+  1019,
+  1019,
+  1019,
+  1019,
+  1018,
+  1018,
+  1018,
+  1018,
+  1018,
+  1018,
+  1017,
+  1017,
+  1017,
+  1017,
+  1017,
+  1016,
+  1016,
+  1016,
+  1016,
+  1016,
+  1016,
+  1015,
+  1015,
+  1015,
+  1015,
+  1014,
+  1014,
+  1014,
+  1014,
+  1014,
+  1013,
+  1013,
+  1013,
+  1013,
+  1012,
+  1012,
+  1012,
+  1012,
+  1011,
+  1011,
+  1011,
+  1011,
+  1010,
+  1010,
+  1010,
+  1010,
+  1009,
+  1009,
+  1009,
+  1009,
+  1008,
+  1008,
+  1008,
+  1008,
+  1007,
+  1007,
+  1007,
+  1006,
+  1006,
+  1006,
+  1006,
+  1005,
+  1005,
+  1005,
+  1004,
+  1004,
+  1004,
+  1003,
+  1003,
+  1003,
+  1002,
+  1002,
+  1002,
+  1001,
+  1001,
+  1001,
+  1000,
+  1000,
+  1000,
+  999,
+  999,
+  999,
+  998,
+  998,
+  998,
+  997,
+  997,
+  997,
+  996,
+  996,
+  996,
+  995,
+  995,
+  994,
+  994,
+  994,
+  993,
+  993,
+  993,
+  992,
+  992,
+  991,
+  991,
+  991,
+  990,
+  990,
+  989,
+  989,
+  989,
+  988,
+  988,
+  987,
+  987,
+  986,
+  986,
+  986,
+  985,
+  985,
+  984,
+  984,
+  983,
+  983,
+  983,
+  982,
+  982,
+  981,
+  981,
+  980,
+  980,
+  979,
+  979,
+  979,
+  978,
+  978,
+  977,
+  977,
+  976,
+  976,
+  975,
+  975,
+  974,
+  974,
+  973,
+  973,
+  972,
+  972,
+  971,
+  971,
+  970,
+  970,
+  969,
+  969,
+  968,
+  968,
+  967,
+  967,
+  966,
+  966,
+  965,
+  965,
+  964,
+  964,
+  963,
+  963,
+  962,
+  961,
+  961,
+  960,
+  960,
+  959,
+  959,
+  958,
+  958,
+  957,
+  957,
+  956,
+  955,
+  955,
+  954,
+  954,
+  953,
+  953,
+  952,
+  951,
+  951,
+  950,
+  950,
+  949,
+  948,
+  948,
+  947,
+  947,
+  946,
+  945,
+  945,
+  944,
+  944,
+  943,
+  942,
+  942,
+  941,
+  941,
+  940,
+  939,
+  939,
+  938,
+  937,
+  937,
+  936,
+  936,
+  935,
+  934,
+  934,
+  933,
+  932,
+  932,
+  931,
+  930,
+  930,
+  929,
+  928,
+  928,
+  927,
+  926,
+  926,
+  925,
+  924,
+  924,
+  923,
+  922,
+  922,
+  921,
+  920,
+  920,
+  919,
+  918,
+  917,
+  917,
+  916,
+  915,
+  915,
+  914,
+  913,
+  913,
+  912,
+  911,
+  910,
+  910,
+  909,
+  908,
+  907,
+  907,
+  906,
+  905,
+  905,
+  904,
+  903,
+  902,
+  902,
+  901,
+  900,
+  899,
+  899,
+  898,
+  897,
+  896,
+  896,
+  895,
+  894,
+  893,
+  893,
+  892,
+  891,
+  890,
+  889,
+  889,
+  888,
+  887,
+  886,
+  885,
+  885,
+  884,
+  883,
+  882,
+  882,
+  881,
+  880,
+  879,
+  878,
+  878,
+  877,
+  876,
+  875,
+  874,
+  873,
+  873,
+  872,
+  871,
+  870,
+  869,
+  868,
+  868,
+  867,
+  866,
+  865,
+  864,
+  863,
+  863,
+  862,
+  861,
+  860,
+  859,
+  858,
+  857,
+  857,
+  856,
+  855,
+  854,
+  853,
+  852,
+  851,
+  851,
+  850,
+  849,
+  848,
+  847,
+  846,
+  845,
+  844,
+  843,
+  843,
+  842,
+  841,
+  840,
+  839,
+  838,
+  837,
+  836,
+  835,
+  834,
+  834,
+  833,
+  832,
+  831,
+  830,
+  829,
+  828,
+  827,
+  826,
+  825,
+  824,
+  823,
+  822,
+  822,
+  821,
+  820,
+  819,
+  818,
+  817,
+  816,
+  815,
+  814,
+  813,
+  812,
+  811,
+  810,
+  809,
+  808,
+  807,
+  806,
+  805,
+  804,
+  803,
+  802,
+  801,
+  800,
+  799,
+  798,
+  798,
+  797,
+  796,
+  795,
+  794,
+  793,
+  792,
+  791,
+  790,
+  789,
+  788,
+  787,
+  786,
+  785,
+  784,
+  783,
+  782,
+  780,
+  779,
+  778,
+  777,
+  776,
+  775,
+  774,
+  773,
+  772,
+  771,
+  770,
+  769,
+  768,
+  767,
+  766,
+  765,
+  764,
+  763,
+  762,
+  761,
+  760,
+  759,
+  758,
+  757,
+  756,
+  755,
+  753,
+  752,
+  751,
+  750,
+  749,
+  748,
+  747,
+  746,
+  745,
+  744,
+  743,
+  742,
+  741,
+  739,
+  738,
+  737,
+  736,
+  735,
+  734,
+  733,
+  732,
+  731,
+  730,
+  729,
+  727,
+  726,
+  725,
+  724,
+  723,
+  722,
+  721,
+  720,
+  719,
+  717,
+  716,
+  715,
+  714,
+  713,
+  712,
+  711,
+  709,
+  708,
+  707,
+  706,
+  705,
+  704,
+  703,
+  702,
+  700,
+  699,
+  698,
+  697,
+  696,
+  695,
+  693,
+  692,
+  691,
+  690,
+  689,
+  688,
+  687,
+  685,
+  684,
+  683,
+  682,
+  681,
+  679,
+  678,
+  677,
+  676,
+  675,
+  674,
+  672,
+  671,
+  670,
+  669,
+  668,
+  666,
+  665,
+  664,
+  663,
+  662,
+  660,
+  659,
+  658,
+  657,
+  656,
+  654,
+  653,
+  652,
+  651,
+  650,
+  648,
+  647,
+  646,
+  645,
+  644,
+  642,
+  641,
+  640,
+  639,
+  637,
+  636,
+  635,
+  634,
+  632,
+  631,
+  630,
+  629,
+  628,
+  626,
+  625,
+  624,
+  623,
+  621,
+  620,
+  619,
+  618,
+  616,
+  615,
+  614,
+  613,
+  611,
+  610,
+  609,
+  607,
+  606,
+  605,
+  604,
+  602,
+  601,
+  600,
+  599,
+  597,
+  596,
+  595,
+  593,
+  592,
+  591,
+  590,
+  588,
+  587,
+  586,
+  584,
+  583,
+  582,
+  581,
+  579,
+  578,
+  577,
+  575,
+  574,
+  573,
+  572,
+  570,
+  569,
+  568,
+  566,
+  565,
+  564,
+  562,
+  561,
+  560,
+  558,
+  557,
+  556,
+  554,
+  553,
+  552,
+  550,
+  549,
+  548,
+  547,
+  545,
+  544,
+  543,
+  541,
+  540,
+  539,
+  537,
+  536,
+  535,
+  533,
+  532,
+  530,
+  529,
+  528,
+  526,
+  525,
+  524,
+  522,
+  521,
+  520,
+  518,
+  517,
+  516,
+  514,
+  513,
+  512,
+  510,
+  509,
+  507,
+  506,
+  505,
+  503,
+  502,
+  501,
+  499,
+  498,
+  497,
+  495,
+  494,
+  492,
+  491,
+  490,
+  488,
+  487,
+  485,
+  484,
+  483,
+  481,
+  480,
+  479,
+  477,
+  476,
+  474,
+  473,
+  472,
+  470,
+  469,
+  467,
+  466,
+  465,
+  463,
+  462,
+  460,
+  459,
+  458,
+  456,
+  455,
+  453,
+  452,
+  451,
+  449,
+  448,
+  446,
+  445,
+  443,
+  442,
+  441,
+  439,
+  438,
+  436,
+  435,
+  434,
+  432,
+  431,
+  429,
+  428,
+  426,
+  425,
+  424,
+  422,
+  421,
+  419,
+  418,
+  416,
+  415,
+  414,
+  412,
+  411,
+  409,
+  408,
+  406,
+  405,
+  403,
+  402,
+  401,
+  399,
+  398,
+  396,
+  395,
+  393,
+  392,
+  390,
+  389,
+  388,
+  386,
+  385,
+  383,
+  382,
+  380,
+  379,
+  377,
+  376,
+  374,
+  373,
+  371,
+  370,
+  369,
+  367,
+  366,
+  364,
+  363,
+  361,
+  360,
+  358,
+  357,
+  355,
+  354,
+  352,
+  351,
+  349,
+  348,
+  346,
+  345,
+  343,
+  342,
+  341,
+  339,
+  338,
+  336,
+  335,
+  333,
+  332,
+  330,
+  329,
+  327,
+  326,
+  324,
+  323,
+  321,
+  320,
+  318,
+  317,
+  315,
+  314,
+  312,
+  311,
+  309,
+  308,
+  306,
+  305,
+  303,
+  302,
+  300,
+  299,
+  297,
+  296,
+  294,
+  293,
+  291,
+  290,
+  288,
+  287,
+  285,
+  284,
+  282,
+  281,
+  279,
+  278,
+  276,
+  275,
+  273,
+  272,
+  270,
+  269,
+  267,
+  266,
+  264,
+  263,
+  261,
+  259,
+  258,
+  256,
+  255,
+  253,
+  252,
+  250,
+  249,
+  247,
+  246,
+  244,
+  243,
+  241,
+  240,
+  238,
+  237,
+  235,
+  234,
+  232,
+  230,
+  229,
+  227,
+  226,
+  224,
+  223,
+  221,
+  220,
+  218,
+  217,
+  215,
+  214,
+  212,
+  211,
+  209,
+  207,
+  206,
+  204,
+  203,
+  201,
+  200,
+  198,
+  197,
+  195,
+  194,
+  192,
+  191,
+  189,
+  187,
+  186,
+  184,
+  183,
+  181,
+  180,
+  178,
+  177,
+  175,
+  174,
+  172,
+  170,
+  169,
+  167,
+  166,
+  164,
+  163,
+  161,
+  160,
+  158,
+  156,
+  155,
+  153,
+  152,
+  150,
+  149,
+  147,
+  146,
+  144,
+  142,
+  141,
+  139,
+  138,
+  136,
+  135,
+  133,
+  132,
+  130,
+  128,
+  127,
+  125,
+  124,
+  122,
+  121,
+  119,
+  118,
+  116,
+  114,
+  113,
+  111,
+  110,
+  108,
+  107,
+  105,
+  103,
+  102,
+  100,
+  99,
+  97,
+  96,
+  94,
+  93,
+  91,
+  89,
+  88,
+  86,
+  85,
+  83,
+  82,
+  80,
+  78,
+  77,
+  75,
+  74,
+  72,
+  71,
+  69,
+  67,
+  66,
+  64,
+  63,
+  61,
+  60,
+  58,
+  57,
+  55,
+  53,
+  52,
+  50,
+  49,
+  47,
+  46,
+  44,
+  42,
+  41,
+  39,
+  38,
+  36,
+  35,
+  33,
+  31,
+  30,
+  28,
+  27,
+  25,
+  24,
+  22,
+  20,
+  19,
+  17,
+  16,
+  14,
+  13,
+  11,
+  9,
+  8,
+  6,
+  5,
+  3,
+  2,
+  0,
+  -2,
+  -3,
+  -5,
+  -6,
+  -8,
+  -9,
+  -11,
+  -13,
+  -14,
+  -16,
+  -17,
+  -19,
+  -20,
+  -22,
+  -24,
+  -25,
+  -27,
+  -28,
+  -30,
+  -31,
+  -33,
+  -35,
+  -36,
+  -38,
+  -39,
+  -41,
+  -42,
+  -44,
+  -46,
+  -47,
+  -49,
+  -50,
+  -52,
+  -53,
+  -55,
+  -57,
+  -58,
+  -60,
+  -61,
+  -63,
+  -64,
+  -66,
+  -67,
+  -69,
+  -71,
+  -72,
+  -74,
+  -75,
+  -77,
+  -78,
+  -80,
+  -82,
+  -83,
+  -85,
+  -86,
+  -88,
+  -89,
+  -91,
+  -93,
+  -94,
+  -96,
+  -97,
+  -99,
+  -100,
+  -102,
+  -103,
+  -105,
+  -107,
+  -108,
+  -110,
+  -111,
+  -113,
+  -114,
+  -116,
+  -118,
+  -119,
+  -121,
+  -122,
+  -124,
+  -125,
+  -127,
+  -128,
+  -130,
+  -132,
+  -133,
+  -135,
+  -136,
+  -138,
+  -139,
+  -141,
+  -142,
+  -144,
+  -146,
+  -147,
+  -149,
+  -150,
+  -152,
+  -153,
+  -155,
+  -156,
+  -158,
+  -160,
+  -161,
+  -163,
+  -164,
+  -166,
+  -167,
+  -169,
+  -170,
+  -172,
+  -174,
+  -175,
+  -177,
+  -178,
+  -180,
+  -181,
+  -183,
+  -184,
+  -186,
+  -187,
+  -189,
+  -191,
+  -192,
+  -194,
+  -195,
+  -197,
+  -198,
+  -200,
+  -201,
+  -203,
+  -204,
+  -206,
+  -207,
+  -209,
+  -211,
+  -212,
+  -214,
+  -215,
+  -217,
+  -218,
+  -220,
+  -221,
+  -223,
+  -224,
+  -226,
+  -227,
+  -229,
+  -230,
+  -232,
+  -234,
+  -235,
+  -237,
+  -238,
+  -240,
+  -241,
+  -243,
+  -244,
+  -246,
+  -247,
+  -249,
+  -250,
+  -252,
+  -253,
+  -255,
+  -256,
+  -258,
+  -259,
+  -261,
+  -263,
+  -264,
+  -266,
+  -267,
+  -269,
+  -270,
+  -272,
+  -273,
+  -275,
+  -276,
+  -278,
+  -279,
+  -281,
+  -282,
+  -284,
+  -285,
+  -287,
+  -288,
+  -290,
+  -291,
+  -293,
+  -294,
+  -296,
+  -297,
+  -299,
+  -300,
+  -302,
+  -303,
+  -305,
+  -306,
+  -308,
+  -309,
+  -311,
+  -312,
+  -314,
+  -315,
+  -317,
+  -318,
+  -320,
+  -321,
+  -323,
+  -324,
+  -326,
+  -327,
+  -329,
+  -330,
+  -332,
+  -333,
+  -335,
+  -336,
+  -338,
+  -339,
+  -341,
+  -342,
+  -343,
+  -345,
+  -346,
+  -348,
+  -349,
+  -351,
+  -352,
+  -354,
+  -355,
+  -357,
+  -358,
+  -360,
+  -361,
+  -363,
+  -364,
+  -366,
+  -367,
+  -369,
+  -370,
+  -371,
+  -373,
+  -374,
+  -376,
+  -377,
+  -379,
+  -380,
+  -382,
+  -383,
+  -385,
+  -386,
+  -388,
+  -389,
+  -390,
+  -392,
+  -393,
+  -395,
+  -396,
+  -398,
+  -399,
+  -401,
+  -402,
+  -403,
+  -405,
+  -406,
+  -408,
+  -409,
+  -411,
+  -412,
+  -414,
+  -415,
+  -416,
+  -418,
+  -419,
+  -421,
+  -422,
+  -424,
+  -425,
+  -426,
+  -428,
+  -429,
+  -431,
+  -432,
+  -434,
+  -435,
+  -436,
+  -438,
+  -439,
+  -441,
+  -442,
+  -443,
+  -445,
+  -446,
+  -448,
+  -449,
+  -451,
+  -452,
+  -453,
+  -455,
+  -456,
+  -458,
+  -459,
+  -460,
+  -462,
+  -463,
+  -465,
+  -466,
+  -467,
+  -469,
+  -470,
+  -472,
+  -473,
+  -474,
+  -476,
+  -477,
+  -479,
+  -480,
+  -481,
+  -483,
+  -484,
+  -485,
+  -487,
+  -488,
+  -490,
+  -491,
+  -492,
+  -494,
+  -495,
+  -497,
+  -498,
+  -499,
+  -501,
+  -502,
+  -503,
+  -505,
+  -506,
+  -507,
+  -509,
+  -510,
+  -512,
+  -513,
+  -514,
+  -516,
+  -517,
+  -518,
+  -520,
+  -521,
+  -522,
+  -524,
+  -525,
+  -526,
+  -528,
+  -529,
+  -530,
+  -532,
+  -533,
+  -535,
+  -536,
+  -537,
+  -539,
+  -540,
+  -541,
+  -543,
+  -544,
+  -545,
+  -547,
+  -548,
+  -549,
+  -550,
+  -552,
+  -553,
+  -554,
+  -556,
+  -557,
+  -558,
+  -560,
+  -561,
+  -562,
+  -564,
+  -565,
+  -566,
+  -568,
+  -569,
+  -570,
+  -572,
+  -573,
+  -574,
+  -575,
+  -577,
+  -578,
+  -579,
+  -581,
+  -582,
+  -583,
+  -584,
+  -586,
+  -587,
+  -588,
+  -590,
+  -591,
+  -592,
+  -593,
+  -595,
+  -596,
+  -597,
+  -599,
+  -600,
+  -601,
+  -602,
+  -604,
+  -605,
+  -606,
+  -607,
+  -609,
+  -610,
+  -611,
+  -613,
+  -614,
+  -615,
+  -616,
+  -618,
+  -619,
+  -620,
+  -621,
+  -623,
+  -624,
+  -625,
+  -626,
+  -628,
+  -629,
+  -630,
+  -631,
+  -632,
+  -634,
+  -635,
+  -636,
+  -637,
+  -639,
+  -640,
+  -641,
+  -642,
+  -644,
+  -645,
+  -646,
+  -647,
+  -648,
+  -650,
+  -651,
+  -652,
+  -653,
+  -654,
+  -656,
+  -657,
+  -658,
+  -659,
+  -660,
+  -662,
+  -663,
+  -664,
+  -665,
+  -666,
+  -668,
+  -669,
+  -670,
+  -671,
+  -672,
+  -674,
+  -675,
+  -676,
+  -677,
+  -678,
+  -679,
+  -681,
+  -682,
+  -683,
+  -684,
+  -685,
+  -687,
+  -688,
+  -689,
+  -690,
+  -691,
+  -692,
+  -693,
+  -695,
+  -696,
+  -697,
+  -698,
+  -699,
+  -700,
+  -702,
+  -703,
+  -704,
+  -705,
+  -706,
+  -707,
+  -708,
+  -709,
+  -711,
+  -712,
+  -713,
+  -714,
+  -715,
+  -716,
+  -717,
+  -719,
+  -720,
+  -721,
+  -722,
+  -723,
+  -724,
+  -725,
+  -726,
+  -727,
+  -729,
+  -730,
+  -731,
+  -732,
+  -733,
+  -734,
+  -735,
+  -736,
+  -737,
+  -738,
+  -739,
+  -741,
+  -742,
+  -743,
+  -744,
+  -745,
+  -746,
+  -747,
+  -748,
+  -749,
+  -750,
+  -751,
+  -752,
+  -753,
+  -755,
+  -756,
+  -757,
+  -758,
+  -759,
+  -760,
+  -761,
+  -762,
+  -763,
+  -764,
+  -765,
+  -766,
+  -767,
+  -768,
+  -769,
+  -770,
+  -771,
+  -772,
+  -773,
+  -774,
+  -775,
+  -776,
+  -777,
+  -778,
+  -779,
+  -780,
+  -782,
+  -783,
+  -784,
+  -785,
+  -786,
+  -787,
+  -788,
+  -789,
+  -790,
+  -791,
+  -792,
+  -793,
+  -794,
+  -795,
+  -796,
+  -797,
+  -798,
+  -798,
+  -799,
+  -800,
+  -801,
+  -802,
+  -803,
+  -804,
+  -805,
+  -806,
+  -807,
+  -808,
+  -809,
+  -810,
+  -811,
+  -812,
+  -813,
+  -814,
+  -815,
+  -816,
+  -817,
+  -818,
+  -819,
+  -820,
+  -821,
+  -822,
+  -822,
+  -823,
+  -824,
+  -825,
+  -826,
+  -827,
+  -828,
+  -829,
+  -830,
+  -831,
+  -832,
+  -833,
+  -834,
+  -834,
+  -835,
+  -836,
+  -837,
+  -838,
+  -839,
+  -840,
+  -841,
+  -842,
+  -843,
+  -843,
+  -844,
+  -845,
+  -846,
+  -847,
+  -848,
+  -849,
+  -850,
+  -851,
+  -851,
+  -852,
+  -853,
+  -854,
+  -855,
+  -856,
+  -857,
+  -857,
+  -858,
+  -859,
+  -860,
+  -861,
+  -862,
+  -863,
+  -863,
+  -864,
+  -865,
+  -866,
+  -867,
+  -868,
+  -868,
+  -869,
+  -870,
+  -871,
+  -872,
+  -873,
+  -873,
+  -874,
+  -875,
+  -876,
+  -877,
+  -878,
+  -878,
+  -879,
+  -880,
+  -881,
+  -882,
+  -882,
+  -883,
+  -884,
+  -885,
+  -885,
+  -886,
+  -887,
+  -888,
+  -889,
+  -889,
+  -890,
+  -891,
+  -892,
+  -893,
+  -893,
+  -894,
+  -895,
+  -896,
+  -896,
+  -897,
+  -898,
+  -899,
+  -899,
+  -900,
+  -901,
+  -902,
+  -902,
+  -903,
+  -904,
+  -905,
+  -905,
+  -906,
+  -907,
+  -907,
+  -908,
+  -909,
+  -910,
+  -910,
+  -911,
+  -912,
+  -913,
+  -913,
+  -914,
+  -915,
+  -915,
+  -916,
+  -917,
+  -917,
+  -918,
+  -919,
+  -920,
+  -920,
+  -921,
+  -922,
+  -922,
+  -923,
+  -924,
+  -924,
+  -925,
+  -926,
+  -926,
+  -927,
+  -928,
+  -928,
+  -929,
+  -930,
+  -930,
+  -931,
+  -932,
+  -932,
+  -933,
+  -934,
+  -934,
+  -935,
+  -936,
+  -936,
+  -937,
+  -937,
+  -938,
+  -939,
+  -939,
+  -940,
+  -941,
+  -941,
+  -942,
+  -942,
+  -943,
+  -944,
+  -944,
+  -945,
+  -945,
+  -946,
+  -947,
+  -947,
+  -948,
+  -948,
+  -949,
+  -950,
+  -950,
+  -951,
+  -951,
+  -952,
+  -953,
+  -953,
+  -954,
+  -954,
+  -955,
+  -955,
+  -956,
+  -957,
+  -957,
+  -958,
+  -958,
+  -959,
+  -959,
+  -960,
+  -960,
+  -961,
+  -961,
+  -962,
+  -963,
+  -963,
+  -964,
+  -964,
+  -965,
+  -965,
+  -966,
+  -966,
+  -967,
+  -967,
+  -968,
+  -968,
+  -969,
+  -969,
+  -970,
+  -970,
+  -971,
+  -971,
+  -972,
+  -972,
+  -973,
+  -973,
+  -974,
+  -974,
+  -975,
+  -975,
+  -976,
+  -976,
+  -977,
+  -977,
+  -978,
+  -978,
+  -979,
+  -979,
+  -979,
+  -980,
+  -980,
+  -981,
+  -981,
+  -982,
+  -982,
+  -983,
+  -983,
+  -983,
+  -984,
+  -984,
+  -985,
+  -985,
+  -986,
+  -986,
+  -986,
+  -987,
+  -987,
+  -988,
+  -988,
+  -989,
+  -989,
+  -989,
+  -990,
+  -990,
+  -991,
+  -991,
+  -991,
+  -992,
+  -992,
+  -993,
+  -993,
+  -993,
+  -994,
+  -994,
+  -994,
+  -995,
+  -995,
+  -996,
+  -996,
+  -996,
+  -997,
+  -997,
+  -997,
+  -998,
+  -998,
+  -998,
+  -999,
+  -999,
+  -999,
+  -1000,
+  -1000,
+  -1000,
+  -1001,
+  -1001,
+  -1001,
+  -1002,
+  -1002,
+  -1002,
+  -1003,
+  -1003,
+  -1003,
+  -1004,
+  -1004,
+  -1004,
+  -1005,
+  -1005,
+  -1005,
+  -1006,
+  -1006,
+  -1006,
+  -1006,
+  -1007,
+  -1007,
+  -1007,
+  -1008,
+  -1008,
+  -1008,
+  -1008,
+  -1009,
+  -1009,
+  -1009,
+  -1009,
+  -1010,
+  -1010,
+  -1010,
+  -1010,
+  -1011,
+  -1011,
+  -1011,
+  -1011,
+  -1012,
+  -1012,
+  -1012,
+  -1012,
+  -1013,
+  -1013,
+  -1013,
+  -1013,
+  -1014,
+  -1014,
+  -1014,
+  -1014,
+  -1014,
+  -1015,
+  -1015,
+  -1015,
+  -1015,
+  -1016,
+  -1016,
+  -1016,
+  -1016,
+  -1016,
+  -1016,
+  -1017,
+  -1017,
+  -1017,
+  -1017,
+  -1017,
+  -1018,
+  -1018,
+  -1018,
+  -1018,
+  -1018,
+  -1018,
+  -1019,
+  -1019,
+  -1019,
+  -1019,
+  -1019,
+  -1019,
+  -1020,
+  -1020,
+  -1020,
+  -1020,
+  -1020,
+  -1020,
+  -1020,
+  -1020,
+  -1021,
+  -1021,
+  -1021,
+  -1021,
+  -1021,
+  -1021,
+  -1021,
+  -1021,
+  -1022,
+  -1022,
+  -1022,
+  -1022,
+  -1022,
+  -1022,
+  -1022,
+  -1022,
+  -1022,
+  -1022,
+  -1023,
+  -1023,
+  -1023,
+  -1023,
+  -1023,
+  -1023,
+  -1023,
+  -1023,
+  -1023,
+  -1023,
+  -1023,
+  -1023,
+  -1023,
+  -1023,
+  -1023,
+  -1024,
+  -1024,
+  -1024,
+  -1024,
+  -1024,
+  -1024,
+  -1024,
+  -1024,
+  -1024,
+  -1024,
+  -1024,
+  -1024,
+  -1024,
+  -1024,
+  -1024,
+  -1024,
+  -1024,
+  -1024,
+  -1024,
+  -1024,
+  -1024,
+  -1024,
+  -1024,
+  -1024,
+  -1024,
+  -1024,
+  -1024,
+  -1024,
+  -1024,
+  -1024,
+  -1024,
+  -1024,
+  -1024,
+  -1024,
+  -1024,
+  -1024,
+  -1024,
+  -1024,
+  -1024,
+  -1024,
+  -1024,
+  -1023,
+  -1023,
+  -1023,
+  -1023,
+  -1023,
+  -1023,
+  -1023,
+  -1023,
+  -1023,
+  -1023,
+  -1023,
+  -1023,
+  -1023,
+  -1023,
+  -1023,
+  -1022,
+  -1022,
+  -1022,
+  -1022,
+  -1022,
+  -1022,
+  -1022,
+  -1022,
+  -1022,
+  -1022,
+  -1021,
+  -1021,
+  -1021,
+  -1021,
+  -1021,
+  -1021,
+  -1021,
+  -1021,
+  -1020,
+  -1020,
+  -1020,
+  -1020,
+  -1020,
+  -1020,
+  -1020,
+  -1020,
+  -1019,
+  -1019,
+  -1019,
+  -1019,
+  -1019,
+  -1019,
+  -1018,
+  -1018,
+  -1018,
+  -1018,
+  -1018,
+  -1018,
+  -1017,
+  -1017,
+  -1017,
+  -1017,
+  -1017,
+  -1016,
+  -1016,
+  -1016,
+  -1016,
+  -1016,
+  -1016,
+  -1015,
+  -1015,
+  -1015,
+  -1015,
+  -1014,
+  -1014,
+  -1014,
+  -1014,
+  -1014,
+  -1013,
+  -1013,
+  -1013,
+  -1013,
+  -1012,
+  -1012,
+  -1012,
+  -1012,
+  -1011,
+  -1011,
+  -1011,
+  -1011,
+  -1010,
+  -1010,
+  -1010,
+  -1010,
+  -1009,
+  -1009,
+  -1009,
+  -1009,
+  -1008,
+  -1008,
+  -1008,
+  -1008,
+  -1007,
+  -1007,
+  -1007,
+  -1006,
+  -1006,
+  -1006,
+  -1006,
+  -1005,
+  -1005,
+  -1005,
+  -1004,
+  -1004,
+  -1004,
+  -1003,
+  -1003,
+  -1003,
+  -1002,
+  -1002,
+  -1002,
+  -1001,
+  -1001,
+  -1001,
+  -1000,
+  -1000,
+  -1000,
+  -999,
+  -999,
+  -999,
+  -998,
+  -998,
+  -998,
+  -997,
+  -997,
+  -997,
+  -996,
+  -996,
+  -996,
+  -995,
+  -995,
+  -994,
+  -994,
+  -994,
+  -993,
+  -993,
+  -993,
+  -992,
+  -992,
+  -991,
+  -991,
+  -991,
+  -990,
+  -990,
+  -989,
+  -989,
+  -989,
+  -988,
+  -988,
+  -987,
+  -987,
+  -986,
+  -986,
+  -986,
+  -985,
+  -985,
+  -984,
+  -984,
+  -983,
+  -983,
+  -983,
+  -982,
+  -982,
+  -981,
+  -981,
+  -980,
+  -980,
+  -979,
+  -979,
+  -979,
+  -978,
+  -978,
+  -977,
+  -977,
+  -976,
+  -976,
+  -975,
+  -975,
+  -974,
+  -974,
+  -973,
+  -973,
+  -972,
+  -972,
+  -971,
+  -971,
+  -970,
+  -970,
+  -969,
+  -969,
+  -968,
+  -968,
+  -967,
+  -967,
+  -966,
+  -966,
+  -965,
+  -965,
+  -964,
+  -964,
+  -963,
+  -963,
+  -962,
+  -961,
+  -961,
+  -960,
+  -960,
+  -959,
+  -959,
+  -958,
+  -958,
+  -957,
+  -957,
+  -956,
+  -955,
+  -955,
+  -954,
+  -954,
+  -953,
+  -953,
+  -952,
+  -951,
+  -951,
+  -950,
+  -950,
+  -949,
+  -948,
+  -948,
+  -947,
+  -947,
+  -946,
+  -945,
+  -945,
+  -944,
+  -944,
+  -943,
+  -942,
+  -942,
+  -941,
+  -941,
+  -940,
+  -939,
+  -939,
+  -938,
+  -937,
+  -937,
+  -936,
+  -936,
+  -935,
+  -934,
+  -934,
+  -933,
+  -932,
+  -932,
+  -931,
+  -930,
+  -930,
+  -929,
+  -928,
+  -928,
+  -927,
+  -926,
+  -926,
+  -925,
+  -924,
+  -924,
+  -923,
+  -922,
+  -922,
+  -921,
+  -920,
+  -920,
+  -919,
+  -918,
+  -917,
+  -917,
+  -916,
+  -915,
+  -915,
+  -914,
+  -913,
+  -913,
+  -912,
+  -911,
+  -910,
+  -910,
+  -909,
+  -908,
+  -907,
+  -907,
+  -906,
+  -905,
+  -905,
+  -904,
+  -903,
+  -902,
+  -902,
+  -901,
+  -900,
+  -899,
+  -899,
+  -898,
+  -897,
+  -896,
+  -896,
+  -895,
+  -894,
+  -893,
+  -893,
+  -892,
+  -891,
+  -890,
+  -889,
+  -889,
+  -888,
+  -887,
+  -886,
+  -885,
+  -885,
+  -884,
+  -883,
+  -882,
+  -882,
+  -881,
+  -880,
+  -879,
+  -878,
+  -878,
+  -877,
+  -876,
+  -875,
+  -874,
+  -873,
+  -873,
+  -872,
+  -871,
+  -870,
+  -869,
+  -868,
+  -868,
+  -867,
+  -866,
+  -865,
+  -864,
+  -863,
+  -863,
+  -862,
+  -861,
+  -860,
+  -859,
+  -858,
+  -857,
+  -857,
+  -856,
+  -855,
+  -854,
+  -853,
+  -852,
+  -851,
+  -851,
+  -850,
+  -849,
+  -848,
+  -847,
+  -846,
+  -845,
+  -844,
+  -843,
+  -843,
+  -842,
+  -841,
+  -840,
+  -839,
+  -838,
+  -837,
+  -836,
+  -835,
+  -834,
+  -834,
+  -833,
+  -832,
+  -831,
+  -830,
+  -829,
+  -828,
+  -827,
+  -826,
+  -825,
+  -824,
+  -823,
+  -822,
+  -822,
+  -821,
+  -820,
+  -819,
+  -818,
+  -817,
+  -816,
+  -815,
+  -814,
+  -813,
+  -812,
+  -811,
+  -810,
+  -809,
+  -808,
+  -807,
+  -806,
+  -805,
+  -804,
+  -803,
+  -802,
+  -801,
+  -800,
+  -799,
+  -798,
+  -798,
+  -797,
+  -796,
+  -795,
+  -794,
+  -793,
+  -792,
+  -791,
+  -790,
+  -789,
+  -788,
+  -787,
+  -786,
+  -785,
+  -784,
+  -783,
+  -782,
+  -780,
+  -779,
+  -778,
+  -777,
+  -776,
+  -775,
+  -774,
+  -773,
+  -772,
+  -771,
+  -770,
+  -769,
+  -768,
+  -767,
+  -766,
+  -765,
+  -764,
+  -763,
+  -762,
+  -761,
+  -760,
+  -759,
+  -758,
+  -757,
+  -756,
+  -755,
+  -753,
+  -752,
+  -751,
+  -750,
+  -749,
+  -748,
+  -747,
+  -746,
+  -745,
+  -744,
+  -743,
+  -742,
+  -741,
+  -739,
+  -738,
+  -737,
+  -736,
+  -735,
+  -734,
+  -733,
+  -732,
+  -731,
+  -730,
+  -729,
+  -727,
+  -726,
+  -725,
+  -724,
+  -723,
+  -722,
+  -721,
+  -720,
+  -719,
+  -717,
+  -716,
+  -715,
+  -714,
+  -713,
+  -712,
+  -711,
+  -709,
+  -708,
+  -707,
+  -706,
+  -705,
+  -704,
+  -703,
+  -702,
+  -700,
+  -699,
+  -698,
+  -697,
+  -696,
+  -695,
+  -693,
+  -692,
+  -691,
+  -690,
+  -689,
+  -688,
+  -687,
+  -685,
+  -684,
+  -683,
+  -682,
+  -681,
+  -679,
+  -678,
+  -677,
+  -676,
+  -675,
+  -674,
+  -672,
+  -671,
+  -670,
+  -669,
+  -668,
+  -666,
+  -665,
+  -664,
+  -663,
+  -662,
+  -660,
+  -659,
+  -658,
+  -657,
+  -656,
+  -654,
+  -653,
+  -652,
+  -651,
+  -650,
+  -648,
+  -647,
+  -646,
+  -645,
+  -644,
+  -642,
+  -641,
+  -640,
+  -639,
+  -637,
+  -636,
+  -635,
+  -634,
+  -632,
+  -631,
+  -630,
+  -629,
+  -628,
+  -626,
+  -625,
+  -624,
+  -623,
+  -621,
+  -620,
+  -619,
+  -618,
+  -616,
+  -615,
+  -614,
+  -613,
+  -611,
+  -610,
+  -609,
+  -607,
+  -606,
+  -605,
+  -604,
+  -602,
+  -601,
+  -600,
+  -599,
+  -597,
+  -596,
+  -595,
+  -593,
+  -592,
+  -591,
+  -590,
+  -588,
+  -587,
+  -586,
+  -584,
+  -583,
+  -582,
+  -581,
+  -579,
+  -578,
+  -577,
+  -575,
+  -574,
+  -573,
+  -572,
+  -570,
+  -569,
+  -568,
+  -566,
+  -565,
+  -564,
+  -562,
+  -561,
+  -560,
+  -558,
+  -557,
+  -556,
+  -554,
+  -553,
+  -552,
+  -550,
+  -549,
+  -548,
+  -547,
+  -545,
+  -544,
+  -543,
+  -541,
+  -540,
+  -539,
+  -537,
+  -536,
+  -535,
+  -533,
+  -532,
+  -530,
+  -529,
+  -528,
+  -526,
+  -525,
+  -524,
+  -522,
+  -521,
+  -520,
+  -518,
+  -517,
+  -516,
+  -514,
+  -513,
+  -512,
+  -510,
+  -509,
+  -507,
+  -506,
+  -505,
+  -503,
+  -502,
+  -501,
+  -499,
+  -498,
+  -497,
+  -495,
+  -494,
+  -492,
+  -491,
+  -490,
+  -488,
+  -487,
+  -485,
+  -484,
+  -483,
+  -481,
+  -480,
+  -479,
+  -477,
+  -476,
+  -474,
+  -473,
+  -472,
+  -470,
+  -469,
+  -467,
+  -466,
+  -465,
+  -463,
+  -462,
+  -460,
+  -459,
+  -458,
+  -456,
+  -455,
+  -453,
+  -452,
+  -451,
+  -449,
+  -448,
+  -446,
+  -445,
+  -443,
+  -442,
+  -441,
+  -439,
+  -438,
+  -436,
+  -435,
+  -434,
+  -432,
+  -431,
+  -429,
+  -428,
+  -426,
+  -425,
+  -424,
+  -422,
+  -421,
+  -419,
+  -418,
+  -416,
+  -415,
+  -414,
+  -412,
+  -411,
+  -409,
+  -408,
+  -406,
+  -405,
+  -403,
+  -402,
+  -401,
+  -399,
+  -398,
+  -396,
+  -395,
+  -393,
+  -392,
+  -390,
+  -389,
+  -388,
+  -386,
+  -385,
+  -383,
+  -382,
+  -380,
+  -379,
+  -377,
+  -376,
+  -374,
+  -373,
+  -371,
+  -370,
+  -369,
+  -367,
+  -366,
+  -364,
+  -363,
+  -361,
+  -360,
+  -358,
+  -357,
+  -355,
+  -354,
+  -352,
+  -351,
+  -349,
+  -348,
+  -346,
+  -345,
+  -343,
+  -342,
+  -341,
+  -339,
+  -338,
+  -336,
+  -335,
+  -333,
+  -332,
+  -330,
+  -329,
+  -327,
+  -326,
+  -324,
+  -323,
+  -321,
+  -320,
+  -318,
+  -317,
+  -315,
+  -314,
+  -312,
+  -311,
+  -309,
+  -308,
+  -306,
+  -305,
+  -303,
+  -302,
+  -300,
+  -299,
+  -297,
+  -296,
+  -294,
+  -293,
+  -291,
+  -290,
+  -288,
+  -287,
+  -285,
+  -284,
+  -282,
+  -281,
+  -279,
+  -278,
+  -276,
+  -275,
+  -273,
+  -272,
+  -270,
+  -269,
+  -267,
+  -266,
+  -264,
+  -263,
+  -261,
+  -259,
+  -258,
+  -256,
+  -255,
+  -253,
+  -252,
+  -250,
+  -249,
+  -247,
+  -246,
+  -244,
+  -243,
+  -241,
+  -240,
+  -238,
+  -237,
+  -235,
+  -234,
+  -232,
+  -230,
+  -229,
+  -227,
+  -226,
+  -224,
+  -223,
+  -221,
+  -220,
+  -218,
+  -217,
+  -215,
+  -214,
+  -212,
+  -211,
+  -209,
+  -207,
+  -206,
+  -204,
+  -203,
+  -201,
+  -200,
+  -198,
+  -197,
+  -195,
+  -194,
+  -192,
+  -191,
+  -189,
+  -187,
+  -186,
+  -184,
+  -183,
+  -181,
+  -180,
+  -178,
+  -177,
+  -175,
+  -174,
+  -172,
+  -170,
+  -169,
+  -167,
+  -166,
+  -164,
+  -163,
+  -161,
+  -160,
+  -158,
+  -156,
+  -155,
+  -153,
+  -152,
+  -150,
+  -149,
+  -147,
+  -146,
+  -144,
+  -142,
+  -141,
+  -139,
+  -138,
+  -136,
+  -135,
+  -133,
+  -132,
+  -130,
+  -128,
+  -127,
+  -125,
+  -124,
+  -122,
+  -121,
+  -119,
+  -118,
+  -116,
+  -114,
+  -113,
+  -111,
+  -110,
+  -108,
+  -107,
+  -105,
+  -103,
+  -102,
+  -100,
+  -99,
+  -97,
+  -96,
+  -94,
+  -93,
+  -91,
+  -89,
+  -88,
+  -86,
+  -85,
+  -83,
+  -82,
+  -80,
+  -78,
+  -77,
+  -75,
+  -74,
+  -72,
+  -71,
+  -69,
+  -67,
+  -66,
+  -64,
+  -63,
+  -61,
+  -60,
+  -58,
+  -57,
+  -55,
+  -53,
+  -52,
+  -50,
+  -49,
+  -47,
+  -46,
+  -44,
+  -42,
+  -41,
+  -39,
+  -38,
+  -36,
+  -35,
+  -33,
+  -31,
+  -30,
+  -28,
+  -27,
+  -25,
+  -24,
+  -22,
+  -20,
+  -19,
+  -17,
+  -16,
+  -14,
+  -13,
+  -11,
+  -9,
+  -8,
+  -6,
+  -5,
+  -3,
+  -2,
+};
+#ifdef FIXED_MATH
+const fixed::value_t INVCOSINETABLE[4096] = {
+  268435456LL,
+  268435771LL,
+  268436719LL,
+  268438298LL,
+  268440509LL,
+  268443351LL,
+  268446826LL,
+  268450932LL,
+  268455670LL,
+  268461040LL,
+  268467041LL,
+  268473675LL,
+  268480941LL,
+  268488839LL,
+  268497370LL,
+  268506532LL,
+  268516328LL,
+  268526755LL,
+  268537816LL,
+  268549510LL,
+  268561836LL,
+  268574796LL,
+  268588389LL,
+  268602615LL,
+  268617475LL,
+  268632969LL,
+  268649096LL,
+  268665858LL,
+  268683255LL,
+  268701285LL,
+  268719951LL,
+  268739252LL,
+  268759188LL,
+  268779759LL,
+  268800966LL,
+  268822809LL,
+  268845288LL,
+  268868404LL,
+  268892157LL,
+  268916546LL,
+  268941573LL,
+  268967238LL,
+  268993540LL,
+  269020481LL,
+  269048060LL,
+  269076278LL,
+  269105135LL,
+  269134632LL,
+  269164769LL,
+  269195546LL,
+  269226964LL,
+  269259023LL,
+  269291723LL,
+  269325064LL,
+  269359048LL,
+  269393675LL,
+  269428945LL,
+  269464857LL,
+  269501414LL,
+  269538615LL,
+  269576461LL,
+  269614952LL,
+  269654088LL,
+  269693871LL,
+  269734300LL,
+  269775376LL,
+  269817100LL,
+  269859471LL,
+  269902491LL,
+  269946161LL,
+  269990479LL,
+  270035448LL,
+  270081068LL,
+  270127338LL,
+  270174260LL,
+  270221835LL,
+  270270062LL,
+  270318943LL,
+  270368478LL,
+  270418667LL,
+  270469512LL,
+  270521013LL,
+  270573169LL,
+  270625983LL,
+  270679455LL,
+  270733585LL,
+  270788374LL,
+  270843822LL,
+  270899931LL,
+  270956701LL,
+  271014132LL,
+  271072226LL,
+  271130983LL,
+  271190403LL,
+  271250488LL,
+  271311239LL,
+  271372655LL,
+  271434738LL,
+  271497488LL,
+  271560906LL,
+  271624994LL,
+  271689751LL,
+  271755178LL,
+  271821277LL,
+  271888048LL,
+  271955492LL,
+  272023610LL,
+  272092402LL,
+  272161869LL,
+  272232013LL,
+  272302834LL,
+  272374333LL,
+  272446510LL,
+  272519368LL,
+  272592906LL,
+  272667125LL,
+  272742027LL,
+  272817612LL,
+  272893881LL,
+  272970836LL,
+  273048476LL,
+  273126804LL,
+  273205820LL,
+  273285524LL,
+  273365919LL,
+  273447005LL,
+  273528782LL,
+  273611253LL,
+  273694417LL,
+  273778276LL,
+  273862832LL,
+  273948084LL,
+  274034035LL,
+  274120685LL,
+  274208035LL,
+  274296086LL,
+  274384840LL,
+  274474298LL,
+  274564460LL,
+  274655327LL,
+  274746902LL,
+  274839185LL,
+  274932177LL,
+  275025879LL,
+  275120293LL,
+  275215419LL,
+  275311259LL,
+  275407815LL,
+  275505086LL,
+  275603075LL,
+  275701783LL,
+  275801211LL,
+  275901359LL,
+  276002231LL,
+  276103826LL,
+  276206146LL,
+  276309192LL,
+  276412966LL,
+  276517469LL,
+  276622702LL,
+  276728667LL,
+  276835364LL,
+  276942796LL,
+  277050963LL,
+  277159868LL,
+  277269510LL,
+  277379893LL,
+  277491016LL,
+  277602882LL,
+  277715492LL,
+  277828848LL,
+  277942950LL,
+  278057801LL,
+  278173401LL,
+  278289753LL,
+  278406858LL,
+  278524717LL,
+  278643331LL,
+  278762703LL,
+  278882834LL,
+  279003725LL,
+  279125378LL,
+  279247794LL,
+  279370976LL,
+  279494925LL,
+  279619641LL,
+  279745128LL,
+  279871386LL,
+  279998417LL,
+  280126223LL,
+  280254806LL,
+  280384167LL,
+  280514307LL,
+  280645230LL,
+  280776935LL,
+  280909426LL,
+  281042703LL,
+  281176769LL,
+  281311624LL,
+  281447272LL,
+  281583714LL,
+  281720951LL,
+  281858986LL,
+  281997820LL,
+  282137455LL,
+  282277893LL,
+  282419136LL,
+  282561185LL,
+  282704043LL,
+  282847711LL,
+  282992192LL,
+  283137487LL,
+  283283598LL,
+  283430527LL,
+  283578277LL,
+  283726848LL,
+  283876244LL,
+  284026465LL,
+  284177515LL,
+  284329395LL,
+  284482107LL,
+  284635654LL,
+  284790037LL,
+  284945258LL,
+  285101320LL,
+  285258224LL,
+  285415973LL,
+  285574569LL,
+  285734015LL,
+  285894311LL,
+  286055461LL,
+  286217467LL,
+  286380330LL,
+  286544054LL,
+  286708639LL,
+  286874090LL,
+  287040407LL,
+  287207594LL,
+  287375652LL,
+  287544584LL,
+  287714392LL,
+  287885078LL,
+  288056645LL,
+  288229096LL,
+  288402432LL,
+  288576657LL,
+  288751772LL,
+  288927779LL,
+  289104682LL,
+  289282483LL,
+  289461185LL,
+  289640789LL,
+  289821299LL,
+  290002717LL,
+  290185045LL,
+  290368286LL,
+  290552443LL,
+  290737519LL,
+  290923515LL,
+  291110435LL,
+  291298281LL,
+  291487056LL,
+  291676763LL,
+  291867404LL,
+  292058982LL,
+  292251499LL,
+  292444960LL,
+  292639366LL,
+  292834720LL,
+  293031025LL,
+  293228283LL,
+  293426499LL,
+  293625674LL,
+  293825811LL,
+  294026914LL,
+  294228985LL,
+  294432028LL,
+  294636044LL,
+  294841038LL,
+  295047012LL,
+  295253969LL,
+  295461913LL,
+  295670845LL,
+  295880771LL,
+  296091691LL,
+  296303611LL,
+  296516532LL,
+  296730458LL,
+  296945393LL,
+  297161338LL,
+  297378299LL,
+  297596277LL,
+  297815276LL,
+  298035299LL,
+  298256351LL,
+  298478433LL,
+  298701550LL,
+  298925704LL,
+  299150900LL,
+  299377140LL,
+  299604428LL,
+  299832767LL,
+  300062162LL,
+  300292615LL,
+  300524129LL,
+  300756710LL,
+  300990359LL,
+  301225081LL,
+  301460880LL,
+  301697758LL,
+  301935720LL,
+  302174769LL,
+  302414910LL,
+  302656145LL,
+  302898478LL,
+  303141914LL,
+  303386456LL,
+  303632107LL,
+  303878873LL,
+  304126756LL,
+  304375761LL,
+  304625891LL,
+  304877150LL,
+  305129543LL,
+  305383074LL,
+  305637746LL,
+  305893563LL,
+  306150530LL,
+  306408651LL,
+  306667929LL,
+  306928370LL,
+  307189977LL,
+  307452754LL,
+  307716706LL,
+  307981837LL,
+  308248151LL,
+  308515652LL,
+  308784346LL,
+  309054236LL,
+  309325326LL,
+  309597622LL,
+  309871127LL,
+  310145846LL,
+  310421785LL,
+  310698946LL,
+  310977335LL,
+  311256956LL,
+  311537815LL,
+  311819915LL,
+  312103262LL,
+  312387859LL,
+  312673713LL,
+  312960828LL,
+  313249208LL,
+  313538858LL,
+  313829784LL,
+  314121990LL,
+  314415481LL,
+  314710262LL,
+  315006339LL,
+  315303715LL,
+  315602398LL,
+  315902390LL,
+  316203698LL,
+  316506327LL,
+  316810283LL,
+  317115569LL,
+  317422192LL,
+  317730157LL,
+  318039469LL,
+  318350133LL,
+  318662156LL,
+  318975543LL,
+  319290298LL,
+  319606428LL,
+  319923938LL,
+  320242834LL,
+  320563122LL,
+  320884807LL,
+  321207894LL,
+  321532390LL,
+  321858301LL,
+  322185631LL,
+  322514388LL,
+  322844577LL,
+  323176204LL,
+  323509276LL,
+  323843797LL,
+  324179774LL,
+  324517214LL,
+  324856121LL,
+  325196504LL,
+  325538368LL,
+  325881718LL,
+  326226562LL,
+  326572906LL,
+  326920757LL,
+  327270120LL,
+  327621002LL,
+  327973410LL,
+  328327351LL,
+  328682830LL,
+  329039855LL,
+  329398433LL,
+  329758569LL,
+  330120272LL,
+  330483548LL,
+  330848403LL,
+  331214845LL,
+  331582881LL,
+  331952518LL,
+  332323762LL,
+  332696622LL,
+  333071104LL,
+  333447215LL,
+  333824963LL,
+  334204356LL,
+  334585400LL,
+  334968102LL,
+  335352472LL,
+  335738515LL,
+  336126240LL,
+  336515655LL,
+  336906766LL,
+  337299582LL,
+  337694111LL,
+  338090361LL,
+  338488339LL,
+  338888053LL,
+  339289512LL,
+  339692723LL,
+  340097695LL,
+  340504436LL,
+  340912954LL,
+  341323258LL,
+  341735355LL,
+  342149255LL,
+  342564966LL,
+  342982497LL,
+  343401855LL,
+  343823051LL,
+  344246091LL,
+  344670986LL,
+  345097745LL,
+  345526375LL,
+  345956887LL,
+  346389289LL,
+  346823590LL,
+  347259800LL,
+  347697928LL,
+  348137983LL,
+  348579974LL,
+  349023912LL,
+  349469805LL,
+  349917663LL,
+  350367497LL,
+  350819315LL,
+  351273127LL,
+  351728943LL,
+  352186774LL,
+  352646630LL,
+  353108519LL,
+  353572453LL,
+  354038443LL,
+  354506497LL,
+  354976627LL,
+  355448843LL,
+  355923156LL,
+  356399576LL,
+  356878114LL,
+  357358781LL,
+  357841587LL,
+  358326545LL,
+  358813663LL,
+  359302955LL,
+  359794431LL,
+  360288102LL,
+  360783980LL,
+  361282076LL,
+  361782402LL,
+  362284969LL,
+  362789789LL,
+  363296875LL,
+  363806236LL,
+  364317887LL,
+  364831839LL,
+  365348103LL,
+  365866693LL,
+  366387621LL,
+  366910899LL,
+  367436539LL,
+  367964555LL,
+  368494959LL,
+  369027764LL,
+  369562982LL,
+  370100628LL,
+  370640714LL,
+  371183253LL,
+  371728258LL,
+  372275744LL,
+  372825723LL,
+  373378210LL,
+  373933217LL,
+  374490760LL,
+  375050852LL,
+  375613506LL,
+  376178738LL,
+  376746562LL,
+  377316991LL,
+  377890041LL,
+  378465727LL,
+  379044062LL,
+  379625062LL,
+  380208742LL,
+  380795117LL,
+  381384202LL,
+  381976013LL,
+  382570565LL,
+  383167874LL,
+  383767956LL,
+  384370826LL,
+  384976500LL,
+  385584995LL,
+  386196326LL,
+  386810511LL,
+  387427566LL,
+  388047507LL,
+  388670351LL,
+  389296116LL,
+  389924817LL,
+  390556473LL,
+  391191101LL,
+  391828719LL,
+  392469343LL,
+  393112992LL,
+  393759683LL,
+  394409436LL,
+  395062268LL,
+  395718196LL,
+  396377241LL,
+  397039421LL,
+  397704754LL,
+  398373260LL,
+  399044958LL,
+  399719866LL,
+  400398006LL,
+  401079395LL,
+  401764055LL,
+  402452004LL,
+  403143264LL,
+  403837855LL,
+  404535797LL,
+  405237111LL,
+  405941817LL,
+  406649937LL,
+  407361492LL,
+  408076504LL,
+  408794994LL,
+  409516983LL,
+  410242495LL,
+  410971550LL,
+  411704172LL,
+  412440382LL,
+  413180205LL,
+  413923662LL,
+  414670777LL,
+  415421573LL,
+  416176074LL,
+  416934303LL,
+  417696285LL,
+  418462044LL,
+  419231604LL,
+  420004989LL,
+  420782226LL,
+  421563338LL,
+  422348351LL,
+  423137291LL,
+  423930183LL,
+  424727054LL,
+  425527929LL,
+  426332835LL,
+  427141800LL,
+  427954849LL,
+  428772009LL,
+  429593310LL,
+  430418777LL,
+  431248440LL,
+  432082326LL,
+  432920464LL,
+  433762882LL,
+  434609610LL,
+  435460677LL,
+  436316112LL,
+  437175946LL,
+  438040208LL,
+  438908928LL,
+  439782138LL,
+  440659869LL,
+  441542151LL,
+  442429016LL,
+  443320497LL,
+  444216625LL,
+  445117432LL,
+  446022952LL,
+  446933218LL,
+  447848262LL,
+  448768120LL,
+  449692824LL,
+  450622409LL,
+  451556910LL,
+  452496363LL,
+  453440801LL,
+  454390262LL,
+  455344781LL,
+  456304395LL,
+  457269140LL,
+  458239053LL,
+  459214173LL,
+  460194537LL,
+  461180184LL,
+  462171151LL,
+  463167479LL,
+  464169206LL,
+  465176373LL,
+  466189019LL,
+  467207185LL,
+  468230913LL,
+  469260243LL,
+  470295219LL,
+  471335881LL,
+  472382273LL,
+  473434438LL,
+  474492420LL,
+  475556262LL,
+  476626009LL,
+  477701707LL,
+  478783400LL,
+  479871135LL,
+  480964958LL,
+  482064915LL,
+  483171055LL,
+  484283425LL,
+  485402074LL,
+  486527050LL,
+  487658402LL,
+  488796182LL,
+  489940439LL,
+  491091224LL,
+  492248588LL,
+  493412585LL,
+  494583266LL,
+  495760685LL,
+  496944895LL,
+  498135951LL,
+  499333908LL,
+  500538822LL,
+  501750748LL,
+  502969743LL,
+  504195865LL,
+  505429172LL,
+  506669723LL,
+  507917576LL,
+  509172793LL,
+  510435432LL,
+  511705557LL,
+  512983228LL,
+  514268509LL,
+  515561463LL,
+  516862154LL,
+  518170647LL,
+  519487007LL,
+  520811301LL,
+  522143596LL,
+  523483960LL,
+  524832461LL,
+  526189170LL,
+  527554155LL,
+  528927488LL,
+  530309241LL,
+  531699487LL,
+  533098299LL,
+  534505751LL,
+  535921920LL,
+  537346880LL,
+  538780709LL,
+  540223485LL,
+  541675288LL,
+  543136196LL,
+  544606290LL,
+  546085652LL,
+  547574366LL,
+  549072514LL,
+  550580182LL,
+  552097454LL,
+  553624419LL,
+  555161164LL,
+  556707777LL,
+  558264349LL,
+  559830971LL,
+  561407735LL,
+  562994734LL,
+  564592064LL,
+  566199819LL,
+  567818097LL,
+  569446996LL,
+  571086615LL,
+  572737055LL,
+  574398418LL,
+  576070807LL,
+  577754326LL,
+  579449081LL,
+  581155179LL,
+  582872730LL,
+  584601843LL,
+  586342628LL,
+  588095200LL,
+  589859673LL,
+  591636161LL,
+  593424783LL,
+  595225658LL,
+  597038905LL,
+  598864646LL,
+  600703006LL,
+  602554110LL,
+  604418084LL,
+  606295057LL,
+  608185160LL,
+  610088525LL,
+  612005284LL,
+  613935575LL,
+  615879535LL,
+  617837303LL,
+  619809021LL,
+  621794831LL,
+  623794880LL,
+  625809314LL,
+  627838283LL,
+  629881938LL,
+  631940433LL,
+  634013924LL,
+  636102568LL,
+  638206525LL,
+  640325958LL,
+  642461032LL,
+  644611914LL,
+  646778773LL,
+  648961781LL,
+  651161113LL,
+  653376945LL,
+  655609457LL,
+  657858831LL,
+  660125251LL,
+  662408907LL,
+  664709987LL,
+  667028685LL,
+  669365196LL,
+  671719720LL,
+  674092459LL,
+  676483618LL,
+  678893404LL,
+  681322028LL,
+  683769706LL,
+  686236654LL,
+  688723095LL,
+  691229251LL,
+  693755352LL,
+  696301628LL,
+  698868314LL,
+  701455650LL,
+  704063877LL,
+  706693243LL,
+  709343996LL,
+  712016392LL,
+  714710687LL,
+  717427146LL,
+  720166034LL,
+  722927621LL,
+  725712184LL,
+  728520002LL,
+  731351359LL,
+  734206545LL,
+  737085852LL,
+  739989579LL,
+  742918030LL,
+  745871514LL,
+  748850344LL,
+  751854839LL,
+  754885323LL,
+  757942127LL,
+  761025586LL,
+  764136041LL,
+  767273839LL,
+  770439334LL,
+  773632884LL,
+  776854855LL,
+  780105619LL,
+  783385554LL,
+  786695045LL,
+  790034485LL,
+  793404271LL,
+  796804811LL,
+  800236516LL,
+  803699808LL,
+  807195116LL,
+  810722874LL,
+  814283528LL,
+  817877529LL,
+  821505338LL,
+  825167424LL,
+  828864265LL,
+  832596348LL,
+  836364168LL,
+  840168230LL,
+  844009051LL,
+  847887153LL,
+  851803072LL,
+  855757353LL,
+  859750551LL,
+  863783233LL,
+  867855975LL,
+  871969367LL,
+  876124009LL,
+  880320513LL,
+  884559503LL,
+  888841615LL,
+  893167501LL,
+  897537822LL,
+  901953254LL,
+  906414488LL,
+  910922228LL,
+  915477193LL,
+  920080115LL,
+  924731744LL,
+  929432845LL,
+  934184197LL,
+  938986599LL,
+  943840865LL,
+  948747825LL,
+  953708330LL,
+  958723247LL,
+  963793463LL,
+  968919884LL,
+  974103435LL,
+  979345064LL,
+  984645738LL,
+  990006446LL,
+  995428200LL,
+  1000912033LL,
+  1006459003LL,
+  1012070192LL,
+  1017746707LL,
+  1023489680LL,
+  1029300270LL,
+  1035179662LL,
+  1041129071LL,
+  1047149739LL,
+  1053242937LL,
+  1059409969LL,
+  1065652167LL,
+  1071970899LL,
+  1078367564LL,
+  1084843596LL,
+  1091400463LL,
+  1098039673LL,
+  1104762767LL,
+  1111571329LL,
+  1118466981LL,
+  1125451386LL,
+  1132526251LL,
+  1139693326LL,
+  1146954407LL,
+  1154311337LL,
+  1161766007LL,
+  1169320359LL,
+  1176976385LL,
+  1184736132LL,
+  1192601702LL,
+  1200575255LL,
+  1208659009LL,
+  1216855243LL,
+  1225166301LL,
+  1233594590LL,
+  1242142587LL,
+  1250812838LL,
+  1259607963LL,
+  1268530656LL,
+  1277583690LL,
+  1286769919LL,
+  1296092281LL,
+  1305553799LL,
+  1315157590LL,
+  1324906861LL,
+  1334804919LL,
+  1344855171LL,
+  1355061128LL,
+  1365426411LL,
+  1375954753LL,
+  1386650007LL,
+  1397516144LL,
+  1408557268LL,
+  1419777609LL,
+  1431181539LL,
+  1442773573LL,
+  1454558373LL,
+  1466540757LL,
+  1478725708LL,
+  1491118373LL,
+  1503724080LL,
+  1516548336LL,
+  1529596843LL,
+  1542875502LL,
+  1556390422LL,
+  1570147931LL,
+  1584154586LL,
+  1598417180LL,
+  1612942758LL,
+  1627738625LL,
+  1642812357LL,
+  1658171818LL,
+  1673825173LL,
+  1689780897LL,
+  1706047798LL,
+  1722635026LL,
+  1739552098LL,
+  1756808906LL,
+  1774415747LL,
+  1792383334LL,
+  1810722824LL,
+  1829445839LL,
+  1848564489LL,
+  1868091402LL,
+  1888039745LL,
+  1908423262LL,
+  1929256297LL,
+  1950553835LL,
+  1972331532LL,
+  1994605757LL,
+  2017393631LL,
+  2040713071LL,
+  2064582839LL,
+  2089022588LL,
+  2114052919LL,
+  2139695440LL,
+  2165972823LL,
+  2192908874LL,
+  2220528607LL,
+  2248858316LL,
+  2277925662LL,
+  2307759762LL,
+  2338391285LL,
+  2369852560LL,
+  2402177684LL,
+  2435402652LL,
+  2469565484LL,
+  2504706374LL,
+  2540867847LL,
+  2578094926LL,
+  2616435325LL,
+  2655939650LL,
+  2696661620LL,
+  2738658311LL,
+  2781990423LL,
+  2826722574LL,
+  2872923617LL,
+  2920666997LL,
+  2970031136LL,
+  3021099868LL,
+  3073962906LL,
+  3128716374LL,
+  3185463385LL,
+  3244314693LL,
+  3305389406LL,
+  3368815799LL,
+  3434732205LL,
+  3503288024LL,
+  3574644852LL,
+  3648977753LL,
+  3726476687LL,
+  3807348134LL,
+  3891816930LL,
+  3980128345LL,
+  4072550471LL,
+  4169376928LL,
+  4270929985LL,
+  4377564135LL,
+  4489670232LL,
+  4607680271LL,
+  4732072950LL,
+  4863380154LL,
+  5002194557LL,
+  5149178559LL,
+  5305074849LL,
+  5470718954LL,
+  5647054211LL,
+  5835149734LL,
+  6036222102LL,
+  6251661691LL,
+  6483064859LL,
+  6732273556LL,
+  7001424444LL,
+  7293010299LL,
+  7609957418LL,
+  7955724157LL,
+  8334427602LL,
+  8751008260LL,
+  9211446743LL,
+  9723052687LL,
+  10294855643LL,
+  10938142552LL,
+  11667210203LL,
+  12500440184LL,
+  13461869954LL,
+  14583549461LL,
+  15909183177LL,
+  17499957364LL,
+  19444252181LL,
+  21874637861LL,
+  24999439060LL,
+  29165863536LL,
+  34998885257LL,
+  43748452154LL,
+  58331109403LL,
+  87496492532LL,
+  174992779176LL,
+  26843545600000000LL,
+  -174992779176LL,
+  -87496492532LL,
+  -58331109403LL,
+  -43748452154LL,
+  -34998885257LL,
+  -29165863536LL,
+  -24999439060LL,
+  -21874637861LL,
+  -19444252181LL,
+  -17499957364LL,
+  -15909183177LL,
+  -14583549461LL,
+  -13461869954LL,
+  -12500440184LL,
+  -11667210203LL,
+  -10938142552LL,
+  -10294855643LL,
+  -9723052687LL,
+  -9211446743LL,
+  -8751008260LL,
+  -8334427602LL,
+  -7955724157LL,
+  -7609957418LL,
+  -7293010299LL,
+  -7001424444LL,
+  -6732273556LL,
+  -6483064859LL,
+  -6251661691LL,
+  -6036222102LL,
+  -5835149734LL,
+  -5647054211LL,
+  -5470718954LL,
+  -5305074849LL,
+  -5149178559LL,
+  -5002194557LL,
+  -4863380154LL,
+  -4732072950LL,
+  -4607680271LL,
+  -4489670232LL,
+  -4377564135LL,
+  -4270929985LL,
+  -4169376928LL,
+  -4072550471LL,
+  -3980128345LL,
+  -3891816930LL,
+  -3807348134LL,
+  -3726476687LL,
+  -3648977753LL,
+  -3574644852LL,
+  -3503288024LL,
+  -3434732205LL,
+  -3368815799LL,
+  -3305389406LL,
+  -3244314693LL,
+  -3185463385LL,
+  -3128716374LL,
+  -3073962906LL,
+  -3021099868LL,
+  -2970031136LL,
+  -2920666997LL,
+  -2872923617LL,
+  -2826722574LL,
+  -2781990423LL,
+  -2738658311LL,
+  -2696661620LL,
+  -2655939650LL,
+  -2616435325LL,
+  -2578094926LL,
+  -2540867847LL,
+  -2504706374LL,
+  -2469565484LL,
+  -2435402652LL,
+  -2402177684LL,
+  -2369852560LL,
+  -2338391285LL,
+  -2307759762LL,
+  -2277925662LL,
+  -2248858316LL,
+  -2220528607LL,
+  -2192908874LL,
+  -2165972823LL,
+  -2139695440LL,
+  -2114052919LL,
+  -2089022588LL,
+  -2064582839LL,
+  -2040713071LL,
+  -2017393631LL,
+  -1994605757LL,
+  -1972331532LL,
+  -1950553835LL,
+  -1929256297LL,
+  -1908423262LL,
+  -1888039745LL,
+  -1868091402LL,
+  -1848564489LL,
+  -1829445839LL,
+  -1810722824LL,
+  -1792383334LL,
+  -1774415747LL,
+  -1756808906LL,
+  -1739552098LL,
+  -1722635026LL,
+  -1706047798LL,
+  -1689780897LL,
+  -1673825173LL,
+  -1658171818LL,
+  -1642812357LL,
+  -1627738625LL,
+  -1612942758LL,
+  -1598417180LL,
+  -1584154586LL,
+  -1570147931LL,
+  -1556390422LL,
+  -1542875502LL,
+  -1529596843LL,
+  -1516548336LL,
+  -1503724080LL,
+  -1491118373LL,
+  -1478725708LL,
+  -1466540757LL,
+  -1454558373LL,
+  -1442773573LL,
+  -1431181539LL,
+  -1419777609LL,
+  -1408557268LL,
+  -1397516144LL,
+  -1386650007LL,
+  -1375954753LL,
+  -1365426411LL,
+  -1355061128LL,
+  -1344855171LL,
+  -1334804919LL,
+  -1324906861LL,
+  -1315157590LL,
+  -1305553799LL,
+  -1296092281LL,
+  -1286769919LL,
+  -1277583690LL,
+  -1268530656LL,
+  -1259607963LL,
+  -1250812838LL,
+  -1242142587LL,
+  -1233594590LL,
+  -1225166301LL,
+  -1216855243LL,
+  -1208659009LL,
+  -1200575255LL,
+  -1192601702LL,
+  -1184736132LL,
+  -1176976385LL,
+  -1169320359LL,
+  -1161766007LL,
+  -1154311337LL,
+  -1146954407LL,
+  -1139693326LL,
+  -1132526251LL,
+  -1125451386LL,
+  -1118466981LL,
+  -1111571329LL,
+  -1104762767LL,
+  -1098039673LL,
+  -1091400463LL,
+  -1084843596LL,
+  -1078367564LL,
+  -1071970899LL,
+  -1065652167LL,
+  -1059409969LL,
+  -1053242937LL,
+  -1047149739LL,
+  -1041129071LL,
+  -1035179662LL,
+  -1029300270LL,
+  -1023489680LL,
+  -1017746707LL,
+  -1012070192LL,
+  -1006459003LL,
+  -1000912033LL,
+  -995428200LL,
+  -990006446LL,
+  -984645738LL,
+  -979345064LL,
+  -974103435LL,
+  -968919884LL,
+  -963793463LL,
+  -958723247LL,
+  -953708330LL,
+  -948747825LL,
+  -943840865LL,
+  -938986599LL,
+  -934184197LL,
+  -929432845LL,
+  -924731744LL,
+  -920080115LL,
+  -915477193LL,
+  -910922228LL,
+  -906414488LL,
+  -901953254LL,
+  -897537822LL,
+  -893167501LL,
+  -888841615LL,
+  -884559503LL,
+  -880320513LL,
+  -876124009LL,
+  -871969367LL,
+  -867855975LL,
+  -863783233LL,
+  -859750551LL,
+  -855757353LL,
+  -851803072LL,
+  -847887153LL,
+  -844009051LL,
+  -840168230LL,
+  -836364168LL,
+  -832596348LL,
+  -828864265LL,
+  -825167424LL,
+  -821505338LL,
+  -817877529LL,
+  -814283528LL,
+  -810722874LL,
+  -807195116LL,
+  -803699808LL,
+  -800236516LL,
+  -796804811LL,
+  -793404271LL,
+  -790034485LL,
+  -786695045LL,
+  -783385554LL,
+  -780105619LL,
+  -776854855LL,
+  -773632884LL,
+  -770439334LL,
+  -767273839LL,
+  -764136041LL,
+  -761025586LL,
+  -757942127LL,
+  -754885323LL,
+  -751854839LL,
+  -748850344LL,
+  -745871514LL,
+  -742918030LL,
+  -739989579LL,
+  -737085852LL,
+  -734206545LL,
+  -731351359LL,
+  -728520002LL,
+  -725712184LL,
+  -722927621LL,
+  -720166034LL,
+  -717427146LL,
+  -714710687LL,
+  -712016392LL,
+  -709343996LL,
+  -706693243LL,
+  -704063877LL,
+  -701455650LL,
+  -698868314LL,
+  -696301628LL,
+  -693755352LL,
+  -691229251LL,
+  -688723095LL,
+  -686236654LL,
+  -683769706LL,
+  -681322028LL,
+  -678893404LL,
+  -676483618LL,
+  -674092459LL,
+  -671719720LL,
+  -669365196LL,
+  -667028685LL,
+  -664709987LL,
+  -662408907LL,
+  -660125251LL,
+  -657858831LL,
+  -655609457LL,
+  -653376945LL,
+  -651161113LL,
+  -648961781LL,
+  -646778773LL,
+  -644611914LL,
+  -642461032LL,
+  -640325958LL,
+  -638206525LL,
+  -636102568LL,
+  -634013924LL,
+  -631940433LL,
+  -629881938LL,
+  -627838283LL,
+  -625809314LL,
+  -623794880LL,
+  -621794831LL,
+  -619809021LL,
+  -617837303LL,
+  -615879535LL,
+  -613935575LL,
+  -612005284LL,
+  -610088525LL,
+  -608185160LL,
+  -606295057LL,
+  -604418084LL,
+  -602554110LL,
+  -600703006LL,
+  -598864646LL,
+  -597038905LL,
+  -595225658LL,
+  -593424783LL,
+  -591636161LL,
+  -589859673LL,
+  -588095200LL,
+  -586342628LL,
+  -584601843LL,
+  -582872730LL,
+  -581155179LL,
+  -579449081LL,
+  -577754326LL,
+  -576070807LL,
+  -574398418LL,
+  -572737055LL,
+  -571086615LL,
+  -569446996LL,
+  -567818097LL,
+  -566199819LL,
+  -564592064LL,
+  -562994734LL,
+  -561407735LL,
+  -559830971LL,
+  -558264349LL,
+  -556707777LL,
+  -555161164LL,
+  -553624419LL,
+  -552097454LL,
+  -550580182LL,
+  -549072514LL,
+  -547574366LL,
+  -546085652LL,
+  -544606290LL,
+  -543136196LL,
+  -541675288LL,
+  -540223485LL,
+  -538780709LL,
+  -537346880LL,
+  -535921920LL,
+  -534505751LL,
+  -533098299LL,
+  -531699487LL,
+  -530309241LL,
+  -528927488LL,
+  -527554155LL,
+  -526189170LL,
+  -524832461LL,
+  -523483960LL,
+  -522143596LL,
+  -520811301LL,
+  -519487007LL,
+  -518170647LL,
+  -516862154LL,
+  -515561463LL,
+  -514268509LL,
+  -512983228LL,
+  -511705557LL,
+  -510435432LL,
+  -509172793LL,
+  -507917576LL,
+  -506669723LL,
+  -505429172LL,
+  -504195865LL,
+  -502969743LL,
+  -501750748LL,
+  -500538822LL,
+  -499333908LL,
+  -498135951LL,
+  -496944895LL,
+  -495760685LL,
+  -494583266LL,
+  -493412585LL,
+  -492248588LL,
+  -491091224LL,
+  -489940439LL,
+  -488796182LL,
+  -487658402LL,
+  -486527050LL,
+  -485402074LL,
+  -484283425LL,
+  -483171055LL,
+  -482064915LL,
+  -480964958LL,
+  -479871135LL,
+  -478783400LL,
+  -477701707LL,
+  -476626009LL,
+  -475556262LL,
+  -474492420LL,
+  -473434438LL,
+  -472382273LL,
+  -471335881LL,
+  -470295219LL,
+  -469260243LL,
+  -468230913LL,
+  -467207185LL,
+  -466189019LL,
+  -465176373LL,
+  -464169206LL,
+  -463167479LL,
+  -462171151LL,
+  -461180184LL,
+  -460194537LL,
+  -459214173LL,
+  -458239053LL,
+  -457269140LL,
+  -456304395LL,
+  -455344781LL,
+  -454390262LL,
+  -453440801LL,
+  -452496363LL,
+  -451556910LL,
+  -450622409LL,
+  -449692824LL,
+  -448768120LL,
+  -447848262LL,
+  -446933218LL,
+  -446022952LL,
+  -445117432LL,
+  -444216625LL,
+  -443320497LL,
+  -442429016LL,
+  -441542151LL,
+  -440659869LL,
+  -439782138LL,
+  -438908928LL,
+  -438040208LL,
+  -437175946LL,
+  -436316112LL,
+  -435460677LL,
+  -434609610LL,
+  -433762882LL,
+  -432920464LL,
+  -432082326LL,
+  -431248440LL,
+  -430418777LL,
+  -429593310LL,
+  -428772009LL,
+  -427954849LL,
+  -427141800LL,
+  -426332835LL,
+  -425527929LL,
+  -424727054LL,
+  -423930183LL,
+  -423137291LL,
+  -422348351LL,
+  -421563338LL,
+  -420782226LL,
+  -420004989LL,
+  -419231604LL,
+  -418462044LL,
+  -417696285LL,
+  -416934303LL,
+  -416176074LL,
+  -415421573LL,
+  -414670777LL,
+  -413923662LL,
+  -413180205LL,
+  -412440382LL,
+  -411704172LL,
+  -410971550LL,
+  -410242495LL,
+  -409516983LL,
+  -408794994LL,
+  -408076504LL,
+  -407361492LL,
+  -406649937LL,
+  -405941817LL,
+  -405237111LL,
+  -404535797LL,
+  -403837855LL,
+  -403143264LL,
+  -402452004LL,
+  -401764055LL,
+  -401079395LL,
+  -400398006LL,
+  -399719866LL,
+  -399044958LL,
+  -398373260LL,
+  -397704754LL,
+  -397039421LL,
+  -396377241LL,
+  -395718196LL,
+  -395062268LL,
+  -394409436LL,
+  -393759683LL,
+  -393112992LL,
+  -392469343LL,
+  -391828719LL,
+  -391191101LL,
+  -390556473LL,
+  -389924817LL,
+  -389296116LL,
+  -388670351LL,
+  -388047507LL,
+  -387427566LL,
+  -386810511LL,
+  -386196326LL,
+  -385584995LL,
+  -384976500LL,
+  -384370826LL,
+  -383767956LL,
+  -383167874LL,
+  -382570565LL,
+  -381976013LL,
+  -381384202LL,
+  -380795117LL,
+  -380208742LL,
+  -379625062LL,
+  -379044062LL,
+  -378465727LL,
+  -377890041LL,
+  -377316991LL,
+  -376746562LL,
+  -376178738LL,
+  -375613506LL,
+  -375050852LL,
+  -374490760LL,
+  -373933217LL,
+  -373378210LL,
+  -372825723LL,
+  -372275744LL,
+  -371728258LL,
+  -371183253LL,
+  -370640714LL,
+  -370100628LL,
+  -369562982LL,
+  -369027764LL,
+  -368494959LL,
+  -367964555LL,
+  -367436539LL,
+  -366910899LL,
+  -366387621LL,
+  -365866693LL,
+  -365348103LL,
+  -364831839LL,
+  -364317887LL,
+  -363806236LL,
+  -363296875LL,
+  -362789789LL,
+  -362284969LL,
+  -361782402LL,
+  -361282076LL,
+  -360783980LL,
+  -360288102LL,
+  -359794431LL,
+  -359302955LL,
+  -358813663LL,
+  -358326545LL,
+  -357841587LL,
+  -357358781LL,
+  -356878114LL,
+  -356399576LL,
+  -355923156LL,
+  -355448843LL,
+  -354976627LL,
+  -354506497LL,
+  -354038443LL,
+  -353572453LL,
+  -353108519LL,
+  -352646630LL,
+  -352186774LL,
+  -351728943LL,
+  -351273127LL,
+  -350819315LL,
+  -350367497LL,
+  -349917663LL,
+  -349469805LL,
+  -349023912LL,
+  -348579974LL,
+  -348137983LL,
+  -347697928LL,
+  -347259800LL,
+  -346823590LL,
+  -346389289LL,
+  -345956887LL,
+  -345526375LL,
+  -345097745LL,
+  -344670986LL,
+  -344246091LL,
+  -343823051LL,
+  -343401855LL,
+  -342982497LL,
+  -342564966LL,
+  -342149255LL,
+  -341735355LL,
+  -341323258LL,
+  -340912954LL,
+  -340504436LL,
+  -340097695LL,
+  -339692723LL,
+  -339289512LL,
+  -338888053LL,
+  -338488339LL,
+  -338090361LL,
+  -337694111LL,
+  -337299582LL,
+  -336906766LL,
+  -336515655LL,
+  -336126240LL,
+  -335738515LL,
+  -335352472LL,
+  -334968102LL,
+  -334585400LL,
+  -334204356LL,
+  -333824963LL,
+  -333447215LL,
+  -333071104LL,
+  -332696622LL,
+  -332323762LL,
+  -331952518LL,
+  -331582881LL,
+  -331214845LL,
+  -330848403LL,
+  -330483548LL,
+  -330120272LL,
+  -329758569LL,
+  -329398433LL,
+  -329039855LL,
+  -328682830LL,
+  -328327351LL,
+  -327973410LL,
+  -327621002LL,
+  -327270120LL,
+  -326920757LL,
+  -326572906LL,
+  -326226562LL,
+  -325881718LL,
+  -325538368LL,
+  -325196504LL,
+  -324856121LL,
+  -324517214LL,
+  -324179774LL,
+  -323843797LL,
+  -323509276LL,
+  -323176204LL,
+  -322844577LL,
+  -322514388LL,
+  -322185631LL,
+  -321858301LL,
+  -321532390LL,
+  -321207894LL,
+  -320884807LL,
+  -320563122LL,
+  -320242834LL,
+  -319923938LL,
+  -319606428LL,
+  -319290298LL,
+  -318975543LL,
+  -318662156LL,
+  -318350133LL,
+  -318039469LL,
+  -317730157LL,
+  -317422192LL,
+  -317115569LL,
+  -316810283LL,
+  -316506327LL,
+  -316203698LL,
+  -315902390LL,
+  -315602398LL,
+  -315303715LL,
+  -315006339LL,
+  -314710262LL,
+  -314415481LL,
+  -314121990LL,
+  -313829784LL,
+  -313538858LL,
+  -313249208LL,
+  -312960828LL,
+  -312673713LL,
+  -312387859LL,
+  -312103262LL,
+  -311819915LL,
+  -311537815LL,
+  -311256956LL,
+  -310977335LL,
+  -310698946LL,
+  -310421785LL,
+  -310145846LL,
+  -309871127LL,
+  -309597622LL,
+  -309325326LL,
+  -309054236LL,
+  -308784346LL,
+  -308515652LL,
+  -308248151LL,
+  -307981837LL,
+  -307716706LL,
+  -307452754LL,
+  -307189977LL,
+  -306928370LL,
+  -306667929LL,
+  -306408651LL,
+  -306150530LL,
+  -305893563LL,
+  -305637746LL,
+  -305383074LL,
+  -305129543LL,
+  -304877150LL,
+  -304625891LL,
+  -304375761LL,
+  -304126756LL,
+  -303878873LL,
+  -303632107LL,
+  -303386456LL,
+  -303141914LL,
+  -302898478LL,
+  -302656145LL,
+  -302414910LL,
+  -302174769LL,
+  -301935720LL,
+  -301697758LL,
+  -301460880LL,
+  -301225081LL,
+  -300990359LL,
+  -300756710LL,
+  -300524129LL,
+  -300292615LL,
+  -300062162LL,
+  -299832767LL,
+  -299604428LL,
+  -299377140LL,
+  -299150900LL,
+  -298925704LL,
+  -298701550LL,
+  -298478433LL,
+  -298256351LL,
+  -298035299LL,
+  -297815276LL,
+  -297596277LL,
+  -297378299LL,
+  -297161338LL,
+  -296945393LL,
+  -296730458LL,
+  -296516532LL,
+  -296303611LL,
+  -296091691LL,
+  -295880771LL,
+  -295670845LL,
+  -295461913LL,
+  -295253969LL,
+  -295047012LL,
+  -294841038LL,
+  -294636044LL,
+  -294432028LL,
+  -294228985LL,
+  -294026914LL,
+  -293825811LL,
+  -293625674LL,
+  -293426499LL,
+  -293228283LL,
+  -293031025LL,
+  -292834720LL,
+  -292639366LL,
+  -292444960LL,
+  -292251499LL,
+  -292058982LL,
+  -291867404LL,
+  -291676763LL,
+  -291487056LL,
+  -291298281LL,
+  -291110435LL,
+  -290923515LL,
+  -290737519LL,
+  -290552443LL,
+  -290368286LL,
+  -290185045LL,
+  -290002717LL,
+  -289821299LL,
+  -289640789LL,
+  -289461185LL,
+  -289282483LL,
+  -289104682LL,
+  -288927779LL,
+  -288751772LL,
+  -288576657LL,
+  -288402432LL,
+  -288229096LL,
+  -288056645LL,
+  -287885078LL,
+  -287714392LL,
+  -287544584LL,
+  -287375652LL,
+  -287207594LL,
+  -287040407LL,
+  -286874090LL,
+  -286708639LL,
+  -286544054LL,
+  -286380330LL,
+  -286217467LL,
+  -286055461LL,
+  -285894311LL,
+  -285734015LL,
+  -285574569LL,
+  -285415973LL,
+  -285258224LL,
+  -285101320LL,
+  -284945258LL,
+  -284790037LL,
+  -284635654LL,
+  -284482107LL,
+  -284329395LL,
+  -284177515LL,
+  -284026465LL,
+  -283876244LL,
+  -283726848LL,
+  -283578277LL,
+  -283430527LL,
+  -283283598LL,
+  -283137487LL,
+  -282992192LL,
+  -282847711LL,
+  -282704043LL,
+  -282561185LL,
+  -282419136LL,
+  -282277893LL,
+  -282137455LL,
+  -281997820LL,
+  -281858986LL,
+  -281720951LL,
+  -281583714LL,
+  -281447272LL,
+  -281311624LL,
+  -281176769LL,
+  -281042703LL,
+  -280909426LL,
+  -280776935LL,
+  -280645230LL,
+  -280514307LL,
+  -280384167LL,
+  -280254806LL,
+  -280126223LL,
+  -279998417LL,
+  -279871386LL,
+  -279745128LL,
+  -279619641LL,
+  -279494925LL,
+  -279370976LL,
+  -279247794LL,
+  -279125378LL,
+  -279003725LL,
+  -278882834LL,
+  -278762703LL,
+  -278643331LL,
+  -278524717LL,
+  -278406858LL,
+  -278289753LL,
+  -278173401LL,
+  -278057801LL,
+  -277942950LL,
+  -277828848LL,
+  -277715492LL,
+  -277602882LL,
+  -277491016LL,
+  -277379893LL,
+  -277269510LL,
+  -277159868LL,
+  -277050963LL,
+  -276942796LL,
+  -276835364LL,
+  -276728667LL,
+  -276622702LL,
+  -276517469LL,
+  -276412966LL,
+  -276309192LL,
+  -276206146LL,
+  -276103826LL,
+  -276002231LL,
+  -275901359LL,
+  -275801211LL,
+  -275701783LL,
+  -275603075LL,
+  -275505086LL,
+  -275407815LL,
+  -275311259LL,
+  -275215419LL,
+  -275120293LL,
+  -275025879LL,
+  -274932177LL,
+  -274839185LL,
+  -274746902LL,
+  -274655327LL,
+  -274564460LL,
+  -274474298LL,
+  -274384840LL,
+  -274296086LL,
+  -274208035LL,
+  -274120685LL,
+  -274034035LL,
+  -273948084LL,
+  -273862832LL,
+  -273778276LL,
+  -273694417LL,
+  -273611253LL,
+  -273528782LL,
+  -273447005LL,
+  -273365919LL,
+  -273285524LL,
+  -273205820LL,
+  -273126804LL,
+  -273048476LL,
+  -272970836LL,
+  -272893881LL,
+  -272817612LL,
+  -272742027LL,
+  -272667125LL,
+  -272592906LL,
+  -272519368LL,
+  -272446510LL,
+  -272374333LL,
+  -272302834LL,
+  -272232013LL,
+  -272161869LL,
+  -272092402LL,
+  -272023610LL,
+  -271955492LL,
+  -271888048LL,
+  -271821277LL,
+  -271755178LL,
+  -271689751LL,
+  -271624994LL,
+  -271560906LL,
+  -271497488LL,
+  -271434738LL,
+  -271372655LL,
+  -271311239LL,
+  -271250488LL,
+  -271190403LL,
+  -271130983LL,
+  -271072226LL,
+  -271014132LL,
+  -270956701LL,
+  -270899931LL,
+  -270843822LL,
+  -270788374LL,
+  -270733585LL,
+  -270679455LL,
+  -270625983LL,
+  -270573169LL,
+  -270521013LL,
+  -270469512LL,
+  -270418667LL,
+  -270368478LL,
+  -270318943LL,
+  -270270062LL,
+  -270221835LL,
+  -270174260LL,
+  -270127338LL,
+  -270081068LL,
+  -270035448LL,
+  -269990479LL,
+  -269946161LL,
+  -269902491LL,
+  -269859471LL,
+  -269817100LL,
+  -269775376LL,
+  -269734300LL,
+  -269693871LL,
+  -269654088LL,
+  -269614952LL,
+  -269576461LL,
+  -269538615LL,
+  -269501414LL,
+  -269464857LL,
+  -269428945LL,
+  -269393675LL,
+  -269359048LL,
+  -269325064LL,
+  -269291723LL,
+  -269259023LL,
+  -269226964LL,
+  -269195546LL,
+  -269164769LL,
+  -269134632LL,
+  -269105135LL,
+  -269076278LL,
+  -269048060LL,
+  -269020481LL,
+  -268993540LL,
+  -268967238LL,
+  -268941573LL,
+  -268916546LL,
+  -268892157LL,
+  -268868404LL,
+  -268845288LL,
+  -268822809LL,
+  -268800966LL,
+  -268779759LL,
+  -268759188LL,
+  -268739252LL,
+  -268719951LL,
+  -268701285LL,
+  -268683255LL,
+  -268665858LL,
+  -268649096LL,
+  -268632969LL,
+  -268617475LL,
+  -268602615LL,
+  -268588389LL,
+  -268574796LL,
+  -268561836LL,
+  -268549510LL,
+  -268537816LL,
+  -268526755LL,
+  -268516328LL,
+  -268506532LL,
+  -268497370LL,
+  -268488839LL,
+  -268480941LL,
+  -268473675LL,
+  -268467041LL,
+  -268461040LL,
+  -268455670LL,
+  -268450932LL,
+  -268446826LL,
+  -268443351LL,
+  -268440509LL,
+  -268438298LL,
+  -268436719LL,
+  -268435771LL,
+  -268435456LL,
+  -268435771LL,
+  -268436719LL,
+  -268438298LL,
+  -268440509LL,
+  -268443351LL,
+  -268446826LL,
+  -268450932LL,
+  -268455670LL,
+  -268461040LL,
+  -268467041LL,
+  -268473675LL,
+  -268480941LL,
+  -268488839LL,
+  -268497370LL,
+  -268506532LL,
+  -268516328LL,
+  -268526755LL,
+  -268537816LL,
+  -268549510LL,
+  -268561836LL,
+  -268574796LL,
+  -268588389LL,
+  -268602615LL,
+  -268617475LL,
+  -268632969LL,
+  -268649096LL,
+  -268665858LL,
+  -268683255LL,
+  -268701285LL,
+  -268719951LL,
+  -268739252LL,
+  -268759188LL,
+  -268779759LL,
+  -268800966LL,
+  -268822809LL,
+  -268845288LL,
+  -268868404LL,
+  -268892157LL,
+  -268916546LL,
+  -268941573LL,
+  -268967238LL,
+  -268993540LL,
+  -269020481LL,
+  -269048060LL,
+  -269076278LL,
+  -269105135LL,
+  -269134632LL,
+  -269164769LL,
+  -269195546LL,
+  -269226964LL,
+  -269259023LL,
+  -269291723LL,
+  -269325064LL,
+  -269359048LL,
+  -269393675LL,
+  -269428945LL,
+  -269464857LL,
+  -269501414LL,
+  -269538615LL,
+  -269576461LL,
+  -269614952LL,
+  -269654088LL,
+  -269693871LL,
+  -269734300LL,
+  -269775376LL,
+  -269817100LL,
+  -269859471LL,
+  -269902491LL,
+  -269946161LL,
+  -269990479LL,
+  -270035448LL,
+  -270081068LL,
+  -270127338LL,
+  -270174260LL,
+  -270221835LL,
+  -270270062LL,
+  -270318943LL,
+  -270368478LL,
+  -270418667LL,
+  -270469512LL,
+  -270521013LL,
+  -270573169LL,
+  -270625983LL,
+  -270679455LL,
+  -270733585LL,
+  -270788374LL,
+  -270843822LL,
+  -270899931LL,
+  -270956701LL,
+  -271014132LL,
+  -271072226LL,
+  -271130983LL,
+  -271190403LL,
+  -271250488LL,
+  -271311239LL,
+  -271372655LL,
+  -271434738LL,
+  -271497488LL,
+  -271560906LL,
+  -271624994LL,
+  -271689751LL,
+  -271755178LL,
+  -271821277LL,
+  -271888048LL,
+  -271955492LL,
+  -272023610LL,
+  -272092402LL,
+  -272161869LL,
+  -272232013LL,
+  -272302834LL,
+  -272374333LL,
+  -272446510LL,
+  -272519368LL,
+  -272592906LL,
+  -272667125LL,
+  -272742027LL,
+  -272817612LL,
+  -272893881LL,
+  -272970836LL,
+  -273048476LL,
+  -273126804LL,
+  -273205820LL,
+  -273285524LL,
+  -273365919LL,
+  -273447005LL,
+  -273528782LL,
+  -273611253LL,
+  -273694417LL,
+  -273778276LL,
+  -273862832LL,
+  -273948084LL,
+  -274034035LL,
+  -274120685LL,
+  -274208035LL,
+  -274296086LL,
+  -274384840LL,
+  -274474298LL,
+  -274564460LL,
+  -274655327LL,
+  -274746902LL,
+  -274839185LL,
+  -274932177LL,
+  -275025879LL,
+  -275120293LL,
+  -275215419LL,
+  -275311259LL,
+  -275407815LL,
+  -275505086LL,
+  -275603075LL,
+  -275701783LL,
+  -275801211LL,
+  -275901359LL,
+  -276002231LL,
+  -276103826LL,
+  -276206146LL,
+  -276309192LL,
+  -276412966LL,
+  -276517469LL,
+  -276622702LL,
+  -276728667LL,
+  -276835364LL,
+  -276942796LL,
+  -277050963LL,
+  -277159868LL,
+  -277269510LL,
+  -277379893LL,
+  -277491016LL,
+  -277602882LL,
+  -277715492LL,
+  -277828848LL,
+  -277942950LL,
+  -278057801LL,
+  -278173401LL,
+  -278289753LL,
+  -278406858LL,
+  -278524717LL,
+  -278643331LL,
+  -278762703LL,
+  -278882834LL,
+  -279003725LL,
+  -279125378LL,
+  -279247794LL,
+  -279370976LL,
+  -279494925LL,
+  -279619641LL,
+  -279745128LL,
+  -279871386LL,
+  -279998417LL,
+  -280126223LL,
+  -280254806LL,
+  -280384167LL,
+  -280514307LL,
+  -280645230LL,
+  -280776935LL,
+  -280909426LL,
+  -281042703LL,
+  -281176769LL,
+  -281311624LL,
+  -281447272LL,
+  -281583714LL,
+  -281720951LL,
+  -281858986LL,
+  -281997820LL,
+  -282137455LL,
+  -282277893LL,
+  -282419136LL,
+  -282561185LL,
+  -282704043LL,
+  -282847711LL,
+  -282992192LL,
+  -283137487LL,
+  -283283598LL,
+  -283430527LL,
+  -283578277LL,
+  -283726848LL,
+  -283876244LL,
+  -284026465LL,
+  -284177515LL,
+  -284329395LL,
+  -284482107LL,
+  -284635654LL,
+  -284790037LL,
+  -284945258LL,
+  -285101320LL,
+  -285258224LL,
+  -285415973LL,
+  -285574569LL,
+  -285734015LL,
+  -285894311LL,
+  -286055461LL,
+  -286217467LL,
+  -286380330LL,
+  -286544054LL,
+  -286708639LL,
+  -286874090LL,
+  -287040407LL,
+  -287207594LL,
+  -287375652LL,
+  -287544584LL,
+  -287714392LL,
+  -287885078LL,
+  -288056645LL,
+  -288229096LL,
+  -288402432LL,
+  -288576657LL,
+  -288751772LL,
+  -288927779LL,
+  -289104682LL,
+  -289282483LL,
+  -289461185LL,
+  -289640789LL,
+  -289821299LL,
+  -290002717LL,
+  -290185045LL,
+  -290368286LL,
+  -290552443LL,
+  -290737519LL,
+  -290923515LL,
+  -291110435LL,
+  -291298281LL,
+  -291487056LL,
+  -291676763LL,
+  -291867404LL,
+  -292058982LL,
+  -292251499LL,
+  -292444960LL,
+  -292639366LL,
+  -292834720LL,
+  -293031025LL,
+  -293228283LL,
+  -293426499LL,
+  -293625674LL,
+  -293825811LL,
+  -294026914LL,
+  -294228985LL,
+  -294432028LL,
+  -294636044LL,
+  -294841038LL,
+  -295047012LL,
+  -295253969LL,
+  -295461913LL,
+  -295670845LL,
+  -295880771LL,
+  -296091691LL,
+  -296303611LL,
+  -296516532LL,
+  -296730458LL,
+  -296945393LL,
+  -297161338LL,
+  -297378299LL,
+  -297596277LL,
+  -297815276LL,
+  -298035299LL,
+  -298256351LL,
+  -298478433LL,
+  -298701550LL,
+  -298925704LL,
+  -299150900LL,
+  -299377140LL,
+  -299604428LL,
+  -299832767LL,
+  -300062162LL,
+  -300292615LL,
+  -300524129LL,
+  -300756710LL,
+  -300990359LL,
+  -301225081LL,
+  -301460880LL,
+  -301697758LL,
+  -301935720LL,
+  -302174769LL,
+  -302414910LL,
+  -302656145LL,
+  -302898478LL,
+  -303141914LL,
+  -303386456LL,
+  -303632107LL,
+  -303878873LL,
+  -304126756LL,
+  -304375761LL,
+  -304625891LL,
+  -304877150LL,
+  -305129543LL,
+  -305383074LL,
+  -305637746LL,
+  -305893563LL,
+  -306150530LL,
+  -306408651LL,
+  -306667929LL,
+  -306928370LL,
+  -307189977LL,
+  -307452754LL,
+  -307716706LL,
+  -307981837LL,
+  -308248151LL,
+  -308515652LL,
+  -308784346LL,
+  -309054236LL,
+  -309325326LL,
+  -309597622LL,
+  -309871127LL,
+  -310145846LL,
+  -310421785LL,
+  -310698946LL,
+  -310977335LL,
+  -311256956LL,
+  -311537815LL,
+  -311819915LL,
+  -312103262LL,
+  -312387859LL,
+  -312673713LL,
+  -312960828LL,
+  -313249208LL,
+  -313538858LL,
+  -313829784LL,
+  -314121990LL,
+  -314415481LL,
+  -314710262LL,
+  -315006339LL,
+  -315303715LL,
+  -315602398LL,
+  -315902390LL,
+  -316203698LL,
+  -316506327LL,
+  -316810283LL,
+  -317115569LL,
+  -317422192LL,
+  -317730157LL,
+  -318039469LL,
+  -318350133LL,
+  -318662156LL,
+  -318975543LL,
+  -319290298LL,
+  -319606428LL,
+  -319923938LL,
+  -320242834LL,
+  -320563122LL,
+  -320884807LL,
+  -321207894LL,
+  -321532390LL,
+  -321858301LL,
+  -322185631LL,
+  -322514388LL,
+  -322844577LL,
+  -323176204LL,
+  -323509276LL,
+  -323843797LL,
+  -324179774LL,
+  -324517214LL,
+  -324856121LL,
+  -325196504LL,
+  -325538368LL,
+  -325881718LL,
+  -326226562LL,
+  -326572906LL,
+  -326920757LL,
+  -327270120LL,
+  -327621002LL,
+  -327973410LL,
+  -328327351LL,
+  -328682830LL,
+  -329039855LL,
+  -329398433LL,
+  -329758569LL,
+  -330120272LL,
+  -330483548LL,
+  -330848403LL,
+  -331214845LL,
+  -331582881LL,
+  -331952518LL,
+  -332323762LL,
+  -332696622LL,
+  -333071104LL,
+  -333447215LL,
+  -333824963LL,
+  -334204356LL,
+  -334585400LL,
+  -334968102LL,
+  -335352472LL,
+  -335738515LL,
+  -336126240LL,
+  -336515655LL,
+  -336906766LL,
+  -337299582LL,
+  -337694111LL,
+  -338090361LL,
+  -338488339LL,
+  -338888053LL,
+  -339289512LL,
+  -339692723LL,
+  -340097695LL,
+  -340504436LL,
+  -340912954LL,
+  -341323258LL,
+  -341735355LL,
+  -342149255LL,
+  -342564966LL,
+  -342982497LL,
+  -343401855LL,
+  -343823051LL,
+  -344246091LL,
+  -344670986LL,
+  -345097745LL,
+  -345526375LL,
+  -345956887LL,
+  -346389289LL,
+  -346823590LL,
+  -347259800LL,
+  -347697928LL,
+  -348137983LL,
+  -348579974LL,
+  -349023912LL,
+  -349469805LL,
+  -349917663LL,
+  -350367497LL,
+  -350819315LL,
+  -351273127LL,
+  -351728943LL,
+  -352186774LL,
+  -352646630LL,
+  -353108519LL,
+  -353572453LL,
+  -354038443LL,
+  -354506497LL,
+  -354976627LL,
+  -355448843LL,
+  -355923156LL,
+  -356399576LL,
+  -356878114LL,
+  -357358781LL,
+  -357841587LL,
+  -358326545LL,
+  -358813663LL,
+  -359302955LL,
+  -359794431LL,
+  -360288102LL,
+  -360783980LL,
+  -361282076LL,
+  -361782402LL,
+  -362284969LL,
+  -362789789LL,
+  -363296875LL,
+  -363806236LL,
+  -364317887LL,
+  -364831839LL,
+  -365348103LL,
+  -365866693LL,
+  -366387621LL,
+  -366910899LL,
+  -367436539LL,
+  -367964555LL,
+  -368494959LL,
+  -369027764LL,
+  -369562982LL,
+  -370100628LL,
+  -370640714LL,
+  -371183253LL,
+  -371728258LL,
+  -372275744LL,
+  -372825723LL,
+  -373378210LL,
+  -373933217LL,
+  -374490760LL,
+  -375050852LL,
+  -375613506LL,
+  -376178738LL,
+  -376746562LL,
+  -377316991LL,
+  -377890041LL,
+  -378465727LL,
+  -379044062LL,
+  -379625062LL,
+  -380208742LL,
+  -380795117LL,
+  -381384202LL,
+  -381976013LL,
+  -382570565LL,
+  -383167874LL,
+  -383767956LL,
+  -384370826LL,
+  -384976500LL,
+  -385584995LL,
+  -386196326LL,
+  -386810511LL,
+  -387427566LL,
+  -388047507LL,
+  -388670351LL,
+  -389296116LL,
+  -389924817LL,
+  -390556473LL,
+  -391191101LL,
+  -391828719LL,
+  -392469343LL,
+  -393112992LL,
+  -393759683LL,
+  -394409436LL,
+  -395062268LL,
+  -395718196LL,
+  -396377241LL,
+  -397039421LL,
+  -397704754LL,
+  -398373260LL,
+  -399044958LL,
+  -399719866LL,
+  -400398006LL,
+  -401079395LL,
+  -401764055LL,
+  -402452004LL,
+  -403143264LL,
+  -403837855LL,
+  -404535797LL,
+  -405237111LL,
+  -405941817LL,
+  -406649937LL,
+  -407361492LL,
+  -408076504LL,
+  -408794994LL,
+  -409516983LL,
+  -410242495LL,
+  -410971550LL,
+  -411704172LL,
+  -412440382LL,
+  -413180205LL,
+  -413923662LL,
+  -414670777LL,
+  -415421573LL,
+  -416176074LL,
+  -416934303LL,
+  -417696285LL,
+  -418462044LL,
+  -419231604LL,
+  -420004989LL,
+  -420782226LL,
+  -421563338LL,
+  -422348351LL,
+  -423137291LL,
+  -423930183LL,
+  -424727054LL,
+  -425527929LL,
+  -426332835LL,
+  -427141800LL,
+  -427954849LL,
+  -428772009LL,
+  -429593310LL,
+  -430418777LL,
+  -431248440LL,
+  -432082326LL,
+  -432920464LL,
+  -433762882LL,
+  -434609610LL,
+  -435460677LL,
+  -436316112LL,
+  -437175946LL,
+  -438040208LL,
+  -438908928LL,
+  -439782138LL,
+  -440659869LL,
+  -441542151LL,
+  -442429016LL,
+  -443320497LL,
+  -444216625LL,
+  -445117432LL,
+  -446022952LL,
+  -446933218LL,
+  -447848262LL,
+  -448768120LL,
+  -449692824LL,
+  -450622409LL,
+  -451556910LL,
+  -452496363LL,
+  -453440801LL,
+  -454390262LL,
+  -455344781LL,
+  -456304395LL,
+  -457269140LL,
+  -458239053LL,
+  -459214173LL,
+  -460194537LL,
+  -461180184LL,
+  -462171151LL,
+  -463167479LL,
+  -464169206LL,
+  -465176373LL,
+  -466189019LL,
+  -467207185LL,
+  -468230913LL,
+  -469260243LL,
+  -470295219LL,
+  -471335881LL,
+  -472382273LL,
+  -473434438LL,
+  -474492420LL,
+  -475556262LL,
+  -476626009LL,
+  -477701707LL,
+  -478783400LL,
+  -479871135LL,
+  -480964958LL,
+  -482064915LL,
+  -483171055LL,
+  -484283425LL,
+  -485402074LL,
+  -486527050LL,
+  -487658402LL,
+  -488796182LL,
+  -489940439LL,
+  -491091224LL,
+  -492248588LL,
+  -493412585LL,
+  -494583266LL,
+  -495760685LL,
+  -496944895LL,
+  -498135951LL,
+  -499333908LL,
+  -500538822LL,
+  -501750748LL,
+  -502969743LL,
+  -504195865LL,
+  -505429172LL,
+  -506669723LL,
+  -507917576LL,
+  -509172793LL,
+  -510435432LL,
+  -511705557LL,
+  -512983228LL,
+  -514268509LL,
+  -515561463LL,
+  -516862154LL,
+  -518170647LL,
+  -519487007LL,
+  -520811301LL,
+  -522143596LL,
+  -523483960LL,
+  -524832461LL,
+  -526189170LL,
+  -527554155LL,
+  -528927488LL,
+  -530309241LL,
+  -531699487LL,
+  -533098299LL,
+  -534505751LL,
+  -535921920LL,
+  -537346880LL,
+  -538780709LL,
+  -540223485LL,
+  -541675288LL,
+  -543136196LL,
+  -544606290LL,
+  -546085652LL,
+  -547574366LL,
+  -549072514LL,
+  -550580182LL,
+  -552097454LL,
+  -553624419LL,
+  -555161164LL,
+  -556707777LL,
+  -558264349LL,
+  -559830971LL,
+  -561407735LL,
+  -562994734LL,
+  -564592064LL,
+  -566199819LL,
+  -567818097LL,
+  -569446996LL,
+  -571086615LL,
+  -572737055LL,
+  -574398418LL,
+  -576070807LL,
+  -577754326LL,
+  -579449081LL,
+  -581155179LL,
+  -582872730LL,
+  -584601843LL,
+  -586342628LL,
+  -588095200LL,
+  -589859673LL,
+  -591636161LL,
+  -593424783LL,
+  -595225658LL,
+  -597038905LL,
+  -598864646LL,
+  -600703006LL,
+  -602554110LL,
+  -604418084LL,
+  -606295057LL,
+  -608185160LL,
+  -610088525LL,
+  -612005284LL,
+  -613935575LL,
+  -615879535LL,
+  -617837303LL,
+  -619809021LL,
+  -621794831LL,
+  -623794880LL,
+  -625809314LL,
+  -627838283LL,
+  -629881938LL,
+  -631940433LL,
+  -634013924LL,
+  -636102568LL,
+  -638206525LL,
+  -640325958LL,
+  -642461032LL,
+  -644611914LL,
+  -646778773LL,
+  -648961781LL,
+  -651161113LL,
+  -653376945LL,
+  -655609457LL,
+  -657858831LL,
+  -660125251LL,
+  -662408907LL,
+  -664709987LL,
+  -667028685LL,
+  -669365196LL,
+  -671719720LL,
+  -674092459LL,
+  -676483618LL,
+  -678893404LL,
+  -681322028LL,
+  -683769706LL,
+  -686236654LL,
+  -688723095LL,
+  -691229251LL,
+  -693755352LL,
+  -696301628LL,
+  -698868314LL,
+  -701455650LL,
+  -704063877LL,
+  -706693243LL,
+  -709343996LL,
+  -712016392LL,
+  -714710687LL,
+  -717427146LL,
+  -720166034LL,
+  -722927621LL,
+  -725712184LL,
+  -728520002LL,
+  -731351359LL,
+  -734206545LL,
+  -737085852LL,
+  -739989579LL,
+  -742918030LL,
+  -745871514LL,
+  -748850344LL,
+  -751854839LL,
+  -754885323LL,
+  -757942127LL,
+  -761025586LL,
+  -764136041LL,
+  -767273839LL,
+  -770439334LL,
+  -773632884LL,
+  -776854855LL,
+  -780105619LL,
+  -783385554LL,
+  -786695045LL,
+  -790034485LL,
+  -793404271LL,
+  -796804811LL,
+  -800236516LL,
+  -803699808LL,
+  -807195116LL,
+  -810722874LL,
+  -814283528LL,
+  -817877529LL,
+  -821505338LL,
+  -825167424LL,
+  -828864265LL,
+  -832596348LL,
+  -836364168LL,
+  -840168230LL,
+  -844009051LL,
+  -847887153LL,
+  -851803072LL,
+  -855757353LL,
+  -859750551LL,
+  -863783233LL,
+  -867855975LL,
+  -871969367LL,
+  -876124009LL,
+  -880320513LL,
+  -884559503LL,
+  -888841615LL,
+  -893167501LL,
+  -897537822LL,
+  -901953254LL,
+  -906414488LL,
+  -910922228LL,
+  -915477193LL,
+  -920080115LL,
+  -924731744LL,
+  -929432845LL,
+  -934184197LL,
+  -938986599LL,
+  -943840865LL,
+  -948747825LL,
+  -953708330LL,
+  -958723247LL,
+  -963793463LL,
+  -968919884LL,
+  -974103435LL,
+  -979345064LL,
+  -984645738LL,
+  -990006446LL,
+  -995428200LL,
+  -1000912033LL,
+  -1006459003LL,
+  -1012070192LL,
+  -1017746707LL,
+  -1023489680LL,
+  -1029300270LL,
+  -1035179662LL,
+  -1041129071LL,
+  -1047149739LL,
+  -1053242937LL,
+  -1059409969LL,
+  -1065652167LL,
+  -1071970899LL,
+  -1078367564LL,
+  -1084843596LL,
+  -1091400463LL,
+  -1098039673LL,
+  -1104762767LL,
+  -1111571329LL,
+  -1118466981LL,
+  -1125451386LL,
+  -1132526251LL,
+  -1139693326LL,
+  -1146954407LL,
+  -1154311337LL,
+  -1161766007LL,
+  -1169320359LL,
+  -1176976385LL,
+  -1184736132LL,
+  -1192601702LL,
+  -1200575255LL,
+  -1208659009LL,
+  -1216855243LL,
+  -1225166301LL,
+  -1233594590LL,
+  -1242142587LL,
+  -1250812838LL,
+  -1259607963LL,
+  -1268530656LL,
+  -1277583690LL,
+  -1286769919LL,
+  -1296092281LL,
+  -1305553799LL,
+  -1315157590LL,
+  -1324906861LL,
+  -1334804919LL,
+  -1344855171LL,
+  -1355061128LL,
+  -1365426411LL,
+  -1375954753LL,
+  -1386650007LL,
+  -1397516144LL,
+  -1408557268LL,
+  -1419777609LL,
+  -1431181539LL,
+  -1442773573LL,
+  -1454558373LL,
+  -1466540757LL,
+  -1478725708LL,
+  -1491118373LL,
+  -1503724080LL,
+  -1516548336LL,
+  -1529596843LL,
+  -1542875502LL,
+  -1556390422LL,
+  -1570147931LL,
+  -1584154586LL,
+  -1598417180LL,
+  -1612942758LL,
+  -1627738625LL,
+  -1642812357LL,
+  -1658171818LL,
+  -1673825173LL,
+  -1689780897LL,
+  -1706047798LL,
+  -1722635026LL,
+  -1739552098LL,
+  -1756808906LL,
+  -1774415747LL,
+  -1792383334LL,
+  -1810722824LL,
+  -1829445839LL,
+  -1848564489LL,
+  -1868091402LL,
+  -1888039745LL,
+  -1908423262LL,
+  -1929256297LL,
+  -1950553835LL,
+  -1972331532LL,
+  -1994605757LL,
+  -2017393631LL,
+  -2040713071LL,
+  -2064582839LL,
+  -2089022588LL,
+  -2114052919LL,
+  -2139695440LL,
+  -2165972823LL,
+  -2192908874LL,
+  -2220528607LL,
+  -2248858316LL,
+  -2277925662LL,
+  -2307759762LL,
+  -2338391285LL,
+  -2369852560LL,
+  -2402177684LL,
+  -2435402652LL,
+  -2469565484LL,
+  -2504706374LL,
+  -2540867847LL,
+  -2578094926LL,
+  -2616435325LL,
+  -2655939650LL,
+  -2696661620LL,
+  -2738658311LL,
+  -2781990423LL,
+  -2826722574LL,
+  -2872923617LL,
+  -2920666997LL,
+  -2970031136LL,
+  -3021099868LL,
+  -3073962906LL,
+  -3128716374LL,
+  -3185463385LL,
+  -3244314693LL,
+  -3305389406LL,
+  -3368815799LL,
+  -3434732205LL,
+  -3503288024LL,
+  -3574644852LL,
+  -3648977753LL,
+  -3726476687LL,
+  -3807348134LL,
+  -3891816930LL,
+  -3980128345LL,
+  -4072550471LL,
+  -4169376928LL,
+  -4270929985LL,
+  -4377564135LL,
+  -4489670232LL,
+  -4607680271LL,
+  -4732072950LL,
+  -4863380154LL,
+  -5002194557LL,
+  -5149178559LL,
+  -5305074849LL,
+  -5470718954LL,
+  -5647054211LL,
+  -5835149734LL,
+  -6036222102LL,
+  -6251661691LL,
+  -6483064859LL,
+  -6732273556LL,
+  -7001424444LL,
+  -7293010299LL,
+  -7609957418LL,
+  -7955724157LL,
+  -8334427602LL,
+  -8751008260LL,
+  -9211446743LL,
+  -9723052687LL,
+  -10294855643LL,
+  -10938142552LL,
+  -11667210203LL,
+  -12500440184LL,
+  -13461869954LL,
+  -14583549461LL,
+  -15909183177LL,
+  -17499957364LL,
+  -19444252181LL,
+  -21874637861LL,
+  -24999439060LL,
+  -29165863536LL,
+  -34998885257LL,
+  -43748452154LL,
+  -58331109403LL,
+  -87496492532LL,
+  -174992779176LL,
+  -26843545600000000LL,
+  174992779176LL,
+  87496492532LL,
+  58331109403LL,
+  43748452154LL,
+  34998885257LL,
+  29165863536LL,
+  24999439060LL,
+  21874637861LL,
+  19444252181LL,
+  17499957364LL,
+  15909183177LL,
+  14583549461LL,
+  13461869954LL,
+  12500440184LL,
+  11667210203LL,
+  10938142552LL,
+  10294855643LL,
+  9723052687LL,
+  9211446743LL,
+  8751008260LL,
+  8334427602LL,
+  7955724157LL,
+  7609957418LL,
+  7293010299LL,
+  7001424444LL,
+  6732273556LL,
+  6483064859LL,
+  6251661691LL,
+  6036222102LL,
+  5835149734LL,
+  5647054211LL,
+  5470718954LL,
+  5305074849LL,
+  5149178559LL,
+  5002194557LL,
+  4863380154LL,
+  4732072950LL,
+  4607680271LL,
+  4489670232LL,
+  4377564135LL,
+  4270929985LL,
+  4169376928LL,
+  4072550471LL,
+  3980128345LL,
+  3891816930LL,
+  3807348134LL,
+  3726476687LL,
+  3648977753LL,
+  3574644852LL,
+  3503288024LL,
+  3434732205LL,
+  3368815799LL,
+  3305389406LL,
+  3244314693LL,
+  3185463385LL,
+  3128716374LL,
+  3073962906LL,
+  3021099868LL,
+  2970031136LL,
+  2920666997LL,
+  2872923617LL,
+  2826722574LL,
+  2781990423LL,
+  2738658311LL,
+  2696661620LL,
+  2655939650LL,
+  2616435325LL,
+  2578094926LL,
+  2540867847LL,
+  2504706374LL,
+  2469565484LL,
+  2435402652LL,
+  2402177684LL,
+  2369852560LL,
+  2338391285LL,
+  2307759762LL,
+  2277925662LL,
+  2248858316LL,
+  2220528607LL,
+  2192908874LL,
+  2165972823LL,
+  2139695440LL,
+  2114052919LL,
+  2089022588LL,
+  2064582839LL,
+  2040713071LL,
+  2017393631LL,
+  1994605757LL,
+  1972331532LL,
+  1950553835LL,
+  1929256297LL,
+  1908423262LL,
+  1888039745LL,
+  1868091402LL,
+  1848564489LL,
+  1829445839LL,
+  1810722824LL,
+  1792383334LL,
+  1774415747LL,
+  1756808906LL,
+  1739552098LL,
+  1722635026LL,
+  1706047798LL,
+  1689780897LL,
+  1673825173LL,
+  1658171818LL,
+  1642812357LL,
+  1627738625LL,
+  1612942758LL,
+  1598417180LL,
+  1584154586LL,
+  1570147931LL,
+  1556390422LL,
+  1542875502LL,
+  1529596843LL,
+  1516548336LL,
+  1503724080LL,
+  1491118373LL,
+  1478725708LL,
+  1466540757LL,
+  1454558373LL,
+  1442773573LL,
+  1431181539LL,
+  1419777609LL,
+  1408557268LL,
+  1397516144LL,
+  1386650007LL,
+  1375954753LL,
+  1365426411LL,
+  1355061128LL,
+  1344855171LL,
+  1334804919LL,
+  1324906861LL,
+  1315157590LL,
+  1305553799LL,
+  1296092281LL,
+  1286769919LL,
+  1277583690LL,
+  1268530656LL,
+  1259607963LL,
+  1250812838LL,
+  1242142587LL,
+  1233594590LL,
+  1225166301LL,
+  1216855243LL,
+  1208659009LL,
+  1200575255LL,
+  1192601702LL,
+  1184736132LL,
+  1176976385LL,
+  1169320359LL,
+  1161766007LL,
+  1154311337LL,
+  1146954407LL,
+  1139693326LL,
+  1132526251LL,
+  1125451386LL,
+  1118466981LL,
+  1111571329LL,
+  1104762767LL,
+  1098039673LL,
+  1091400463LL,
+  1084843596LL,
+  1078367564LL,
+  1071970899LL,
+  1065652167LL,
+  1059409969LL,
+  1053242937LL,
+  1047149739LL,
+  1041129071LL,
+  1035179662LL,
+  1029300270LL,
+  1023489680LL,
+  1017746707LL,
+  1012070192LL,
+  1006459003LL,
+  1000912033LL,
+  995428200LL,
+  990006446LL,
+  984645738LL,
+  979345064LL,
+  974103435LL,
+  968919884LL,
+  963793463LL,
+  958723247LL,
+  953708330LL,
+  948747825LL,
+  943840865LL,
+  938986599LL,
+  934184197LL,
+  929432845LL,
+  924731744LL,
+  920080115LL,
+  915477193LL,
+  910922228LL,
+  906414488LL,
+  901953254LL,
+  897537822LL,
+  893167501LL,
+  888841615LL,
+  884559503LL,
+  880320513LL,
+  876124009LL,
+  871969367LL,
+  867855975LL,
+  863783233LL,
+  859750551LL,
+  855757353LL,
+  851803072LL,
+  847887153LL,
+  844009051LL,
+  840168230LL,
+  836364168LL,
+  832596348LL,
+  828864265LL,
+  825167424LL,
+  821505338LL,
+  817877529LL,
+  814283528LL,
+  810722874LL,
+  807195116LL,
+  803699808LL,
+  800236516LL,
+  796804811LL,
+  793404271LL,
+  790034485LL,
+  786695045LL,
+  783385554LL,
+  780105619LL,
+  776854855LL,
+  773632884LL,
+  770439334LL,
+  767273839LL,
+  764136041LL,
+  761025586LL,
+  757942127LL,
+  754885323LL,
+  751854839LL,
+  748850344LL,
+  745871514LL,
+  742918030LL,
+  739989579LL,
+  737085852LL,
+  734206545LL,
+  731351359LL,
+  728520002LL,
+  725712184LL,
+  722927621LL,
+  720166034LL,
+  717427146LL,
+  714710687LL,
+  712016392LL,
+  709343996LL,
+  706693243LL,
+  704063877LL,
+  701455650LL,
+  698868314LL,
+  696301628LL,
+  693755352LL,
+  691229251LL,
+  688723095LL,
+  686236654LL,
+  683769706LL,
+  681322028LL,
+  678893404LL,
+  676483618LL,
+  674092459LL,
+  671719720LL,
+  669365196LL,
+  667028685LL,
+  664709987LL,
+  662408907LL,
+  660125251LL,
+  657858831LL,
+  655609457LL,
+  653376945LL,
+  651161113LL,
+  648961781LL,
+  646778773LL,
+  644611914LL,
+  642461032LL,
+  640325958LL,
+  638206525LL,
+  636102568LL,
+  634013924LL,
+  631940433LL,
+  629881938LL,
+  627838283LL,
+  625809314LL,
+  623794880LL,
+  621794831LL,
+  619809021LL,
+  617837303LL,
+  615879535LL,
+  613935575LL,
+  612005284LL,
+  610088525LL,
+  608185160LL,
+  606295057LL,
+  604418084LL,
+  602554110LL,
+  600703006LL,
+  598864646LL,
+  597038905LL,
+  595225658LL,
+  593424783LL,
+  591636161LL,
+  589859673LL,
+  588095200LL,
+  586342628LL,
+  584601843LL,
+  582872730LL,
+  581155179LL,
+  579449081LL,
+  577754326LL,
+  576070807LL,
+  574398418LL,
+  572737055LL,
+  571086615LL,
+  569446996LL,
+  567818097LL,
+  566199819LL,
+  564592064LL,
+  562994734LL,
+  561407735LL,
+  559830971LL,
+  558264349LL,
+  556707777LL,
+  555161164LL,
+  553624419LL,
+  552097454LL,
+  550580182LL,
+  549072514LL,
+  547574366LL,
+  546085652LL,
+  544606290LL,
+  543136196LL,
+  541675288LL,
+  540223485LL,
+  538780709LL,
+  537346880LL,
+  535921920LL,
+  534505751LL,
+  533098299LL,
+  531699487LL,
+  530309241LL,
+  528927488LL,
+  527554155LL,
+  526189170LL,
+  524832461LL,
+  523483960LL,
+  522143596LL,
+  520811301LL,
+  519487007LL,
+  518170647LL,
+  516862154LL,
+  515561463LL,
+  514268509LL,
+  512983228LL,
+  511705557LL,
+  510435432LL,
+  509172793LL,
+  507917576LL,
+  506669723LL,
+  505429172LL,
+  504195865LL,
+  502969743LL,
+  501750748LL,
+  500538822LL,
+  499333908LL,
+  498135951LL,
+  496944895LL,
+  495760685LL,
+  494583266LL,
+  493412585LL,
+  492248588LL,
+  491091224LL,
+  489940439LL,
+  488796182LL,
+  487658402LL,
+  486527050LL,
+  485402074LL,
+  484283425LL,
+  483171055LL,
+  482064915LL,
+  480964958LL,
+  479871135LL,
+  478783400LL,
+  477701707LL,
+  476626009LL,
+  475556262LL,
+  474492420LL,
+  473434438LL,
+  472382273LL,
+  471335881LL,
+  470295219LL,
+  469260243LL,
+  468230913LL,
+  467207185LL,
+  466189019LL,
+  465176373LL,
+  464169206LL,
+  463167479LL,
+  462171151LL,
+  461180184LL,
+  460194537LL,
+  459214173LL,
+  458239053LL,
+  457269140LL,
+  456304395LL,
+  455344781LL,
+  454390262LL,
+  453440801LL,
+  452496363LL,
+  451556910LL,
+  450622409LL,
+  449692824LL,
+  448768120LL,
+  447848262LL,
+  446933218LL,
+  446022952LL,
+  445117432LL,
+  444216625LL,
+  443320497LL,
+  442429016LL,
+  441542151LL,
+  440659869LL,
+  439782138LL,
+  438908928LL,
+  438040208LL,
+  437175946LL,
+  436316112LL,
+  435460677LL,
+  434609610LL,
+  433762882LL,
+  432920464LL,
+  432082326LL,
+  431248440LL,
+  430418777LL,
+  429593310LL,
+  428772009LL,
+  427954849LL,
+  427141800LL,
+  426332835LL,
+  425527929LL,
+  424727054LL,
+  423930183LL,
+  423137291LL,
+  422348351LL,
+  421563338LL,
+  420782226LL,
+  420004989LL,
+  419231604LL,
+  418462044LL,
+  417696285LL,
+  416934303LL,
+  416176074LL,
+  415421573LL,
+  414670777LL,
+  413923662LL,
+  413180205LL,
+  412440382LL,
+  411704172LL,
+  410971550LL,
+  410242495LL,
+  409516983LL,
+  408794994LL,
+  408076504LL,
+  407361492LL,
+  406649937LL,
+  405941817LL,
+  405237111LL,
+  404535797LL,
+  403837855LL,
+  403143264LL,
+  402452004LL,
+  401764055LL,
+  401079395LL,
+  400398006LL,
+  399719866LL,
+  399044958LL,
+  398373260LL,
+  397704754LL,
+  397039421LL,
+  396377241LL,
+  395718196LL,
+  395062268LL,
+  394409436LL,
+  393759683LL,
+  393112992LL,
+  392469343LL,
+  391828719LL,
+  391191101LL,
+  390556473LL,
+  389924817LL,
+  389296116LL,
+  388670351LL,
+  388047507LL,
+  387427566LL,
+  386810511LL,
+  386196326LL,
+  385584995LL,
+  384976500LL,
+  384370826LL,
+  383767956LL,
+  383167874LL,
+  382570565LL,
+  381976013LL,
+  381384202LL,
+  380795117LL,
+  380208742LL,
+  379625062LL,
+  379044062LL,
+  378465727LL,
+  377890041LL,
+  377316991LL,
+  376746562LL,
+  376178738LL,
+  375613506LL,
+  375050852LL,
+  374490760LL,
+  373933217LL,
+  373378210LL,
+  372825723LL,
+  372275744LL,
+  371728258LL,
+  371183253LL,
+  370640714LL,
+  370100628LL,
+  369562982LL,
+  369027764LL,
+  368494959LL,
+  367964555LL,
+  367436539LL,
+  366910899LL,
+  366387621LL,
+  365866693LL,
+  365348103LL,
+  364831839LL,
+  364317887LL,
+  363806236LL,
+  363296875LL,
+  362789789LL,
+  362284969LL,
+  361782402LL,
+  361282076LL,
+  360783980LL,
+  360288102LL,
+  359794431LL,
+  359302955LL,
+  358813663LL,
+  358326545LL,
+  357841587LL,
+  357358781LL,
+  356878114LL,
+  356399576LL,
+  355923156LL,
+  355448843LL,
+  354976627LL,
+  354506497LL,
+  354038443LL,
+  353572453LL,
+  353108519LL,
+  352646630LL,
+  352186774LL,
+  351728943LL,
+  351273127LL,
+  350819315LL,
+  350367497LL,
+  349917663LL,
+  349469805LL,
+  349023912LL,
+  348579974LL,
+  348137983LL,
+  347697928LL,
+  347259800LL,
+  346823590LL,
+  346389289LL,
+  345956887LL,
+  345526375LL,
+  345097745LL,
+  344670986LL,
+  344246091LL,
+  343823051LL,
+  343401855LL,
+  342982497LL,
+  342564966LL,
+  342149255LL,
+  341735355LL,
+  341323258LL,
+  340912954LL,
+  340504436LL,
+  340097695LL,
+  339692723LL,
+  339289512LL,
+  338888053LL,
+  338488339LL,
+  338090361LL,
+  337694111LL,
+  337299582LL,
+  336906766LL,
+  336515655LL,
+  336126240LL,
+  335738515LL,
+  335352472LL,
+  334968102LL,
+  334585400LL,
+  334204356LL,
+  333824963LL,
+  333447215LL,
+  333071104LL,
+  332696622LL,
+  332323762LL,
+  331952518LL,
+  331582881LL,
+  331214845LL,
+  330848403LL,
+  330483548LL,
+  330120272LL,
+  329758569LL,
+  329398433LL,
+  329039855LL,
+  328682830LL,
+  328327351LL,
+  327973410LL,
+  327621002LL,
+  327270120LL,
+  326920757LL,
+  326572906LL,
+  326226562LL,
+  325881718LL,
+  325538368LL,
+  325196504LL,
+  324856121LL,
+  324517214LL,
+  324179774LL,
+  323843797LL,
+  323509276LL,
+  323176204LL,
+  322844577LL,
+  322514388LL,
+  322185631LL,
+  321858301LL,
+  321532390LL,
+  321207894LL,
+  320884807LL,
+  320563122LL,
+  320242834LL,
+  319923938LL,
+  319606428LL,
+  319290298LL,
+  318975543LL,
+  318662156LL,
+  318350133LL,
+  318039469LL,
+  317730157LL,
+  317422192LL,
+  317115569LL,
+  316810283LL,
+  316506327LL,
+  316203698LL,
+  315902390LL,
+  315602398LL,
+  315303715LL,
+  315006339LL,
+  314710262LL,
+  314415481LL,
+  314121990LL,
+  313829784LL,
+  313538858LL,
+  313249208LL,
+  312960828LL,
+  312673713LL,
+  312387859LL,
+  312103262LL,
+  311819915LL,
+  311537815LL,
+  311256956LL,
+  310977335LL,
+  310698946LL,
+  310421785LL,
+  310145846LL,
+  309871127LL,
+  309597622LL,
+  309325326LL,
+  309054236LL,
+  308784346LL,
+  308515652LL,
+  308248151LL,
+  307981837LL,
+  307716706LL,
+  307452754LL,
+  307189977LL,
+  306928370LL,
+  306667929LL,
+  306408651LL,
+  306150530LL,
+  305893563LL,
+  305637746LL,
+  305383074LL,
+  305129543LL,
+  304877150LL,
+  304625891LL,
+  304375761LL,
+  304126756LL,
+  303878873LL,
+  303632107LL,
+  303386456LL,
+  303141914LL,
+  302898478LL,
+  302656145LL,
+  302414910LL,
+  302174769LL,
+  301935720LL,
+  301697758LL,
+  301460880LL,
+  301225081LL,
+  300990359LL,
+  300756710LL,
+  300524129LL,
+  300292615LL,
+  300062162LL,
+  299832767LL,
+  299604428LL,
+  299377140LL,
+  299150900LL,
+  298925704LL,
+  298701550LL,
+  298478433LL,
+  298256351LL,
+  298035299LL,
+  297815276LL,
+  297596277LL,
+  297378299LL,
+  297161338LL,
+  296945393LL,
+  296730458LL,
+  296516532LL,
+  296303611LL,
+  296091691LL,
+  295880771LL,
+  295670845LL,
+  295461913LL,
+  295253969LL,
+  295047012LL,
+  294841038LL,
+  294636044LL,
+  294432028LL,
+  294228985LL,
+  294026914LL,
+  293825811LL,
+  293625674LL,
+  293426499LL,
+  293228283LL,
+  293031025LL,
+  292834720LL,
+  292639366LL,
+  292444960LL,
+  292251499LL,
+  292058982LL,
+  291867404LL,
+  291676763LL,
+  291487056LL,
+  291298281LL,
+  291110435LL,
+  290923515LL,
+  290737519LL,
+  290552443LL,
+  290368286LL,
+  290185045LL,
+  290002717LL,
+  289821299LL,
+  289640789LL,
+  289461185LL,
+  289282483LL,
+  289104682LL,
+  288927779LL,
+  288751772LL,
+  288576657LL,
+  288402432LL,
+  288229096LL,
+  288056645LL,
+  287885078LL,
+  287714392LL,
+  287544584LL,
+  287375652LL,
+  287207594LL,
+  287040407LL,
+  286874090LL,
+  286708639LL,
+  286544054LL,
+  286380330LL,
+  286217467LL,
+  286055461LL,
+  285894311LL,
+  285734015LL,
+  285574569LL,
+  285415973LL,
+  285258224LL,
+  285101320LL,
+  284945258LL,
+  284790037LL,
+  284635654LL,
+  284482107LL,
+  284329395LL,
+  284177515LL,
+  284026465LL,
+  283876244LL,
+  283726848LL,
+  283578277LL,
+  283430527LL,
+  283283598LL,
+  283137487LL,
+  282992192LL,
+  282847711LL,
+  282704043LL,
+  282561185LL,
+  282419136LL,
+  282277893LL,
+  282137455LL,
+  281997820LL,
+  281858986LL,
+  281720951LL,
+  281583714LL,
+  281447272LL,
+  281311624LL,
+  281176769LL,
+  281042703LL,
+  280909426LL,
+  280776935LL,
+  280645230LL,
+  280514307LL,
+  280384167LL,
+  280254806LL,
+  280126223LL,
+  279998417LL,
+  279871386LL,
+  279745128LL,
+  279619641LL,
+  279494925LL,
+  279370976LL,
+  279247794LL,
+  279125378LL,
+  279003725LL,
+  278882834LL,
+  278762703LL,
+  278643331LL,
+  278524717LL,
+  278406858LL,
+  278289753LL,
+  278173401LL,
+  278057801LL,
+  277942950LL,
+  277828848LL,
+  277715492LL,
+  277602882LL,
+  277491016LL,
+  277379893LL,
+  277269510LL,
+  277159868LL,
+  277050963LL,
+  276942796LL,
+  276835364LL,
+  276728667LL,
+  276622702LL,
+  276517469LL,
+  276412966LL,
+  276309192LL,
+  276206146LL,
+  276103826LL,
+  276002231LL,
+  275901359LL,
+  275801211LL,
+  275701783LL,
+  275603075LL,
+  275505086LL,
+  275407815LL,
+  275311259LL,
+  275215419LL,
+  275120293LL,
+  275025879LL,
+  274932177LL,
+  274839185LL,
+  274746902LL,
+  274655327LL,
+  274564460LL,
+  274474298LL,
+  274384840LL,
+  274296086LL,
+  274208035LL,
+  274120685LL,
+  274034035LL,
+  273948084LL,
+  273862832LL,
+  273778276LL,
+  273694417LL,
+  273611253LL,
+  273528782LL,
+  273447005LL,
+  273365919LL,
+  273285524LL,
+  273205820LL,
+  273126804LL,
+  273048476LL,
+  272970836LL,
+  272893881LL,
+  272817612LL,
+  272742027LL,
+  272667125LL,
+  272592906LL,
+  272519368LL,
+  272446510LL,
+  272374333LL,
+  272302834LL,
+  272232013LL,
+  272161869LL,
+  272092402LL,
+  272023610LL,
+  271955492LL,
+  271888048LL,
+  271821277LL,
+  271755178LL,
+  271689751LL,
+  271624994LL,
+  271560906LL,
+  271497488LL,
+  271434738LL,
+  271372655LL,
+  271311239LL,
+  271250488LL,
+  271190403LL,
+  271130983LL,
+  271072226LL,
+  271014132LL,
+  270956701LL,
+  270899931LL,
+  270843822LL,
+  270788374LL,
+  270733585LL,
+  270679455LL,
+  270625983LL,
+  270573169LL,
+  270521013LL,
+  270469512LL,
+  270418667LL,
+  270368478LL,
+  270318943LL,
+  270270062LL,
+  270221835LL,
+  270174260LL,
+  270127338LL,
+  270081068LL,
+  270035448LL,
+  269990479LL,
+  269946161LL,
+  269902491LL,
+  269859471LL,
+  269817100LL,
+  269775376LL,
+  269734300LL,
+  269693871LL,
+  269654088LL,
+  269614952LL,
+  269576461LL,
+  269538615LL,
+  269501414LL,
+  269464857LL,
+  269428945LL,
+  269393675LL,
+  269359048LL,
+  269325064LL,
+  269291723LL,
+  269259023LL,
+  269226964LL,
+  269195546LL,
+  269164769LL,
+  269134632LL,
+  269105135LL,
+  269076278LL,
+  269048060LL,
+  269020481LL,
+  268993540LL,
+  268967238LL,
+  268941573LL,
+  268916546LL,
+  268892157LL,
+  268868404LL,
+  268845288LL,
+  268822809LL,
+  268800966LL,
+  268779759LL,
+  268759188LL,
+  268739252LL,
+  268719951LL,
+  268701285LL,
+  268683255LL,
+  268665858LL,
+  268649096LL,
+  268632969LL,
+  268617475LL,
+  268602615LL,
+  268588389LL,
+  268574796LL,
+  268561836LL,
+  268549510LL,
+  268537816LL,
+  268526755LL,
+  268516328LL,
+  268506532LL,
+  268497370LL,
+  268488839LL,
+  268480941LL,
+  268473675LL,
+  268467041LL,
+  268461040LL,
+  268455670LL,
+  268450932LL,
+  268446826LL,
+  268443351LL,
+  268440509LL,
+  268438298LL,
+  268436719LL,
+  268435771LL,
+#else
+const fixed INVCOSINETABLE[4096] = {
+  fixed(1.00000000000000000000e+00),
+  fixed(1.00000117654968234682e+00),
+  fixed(1.00000470621257209203e+00),
+  fixed(1.00001058903019801605e+00),
+  fixed(1.00001882507177564108e+00),
+  fixed(1.00002941443420945156e+00),
+  fixed(1.00004235724209600278e+00),
+  fixed(1.00005765364772747361e+00),
+  fixed(1.00007530383109544125e+00),
+  fixed(1.00009530799989621030e+00),
+  fixed(1.00011766638953769615e+00),
+  fixed(1.00014237926314475402e+00),
+  fixed(1.00016944691156806080e+00),
+  fixed(1.00019886965339122042e+00),
+  fixed(1.00023064783494120000e+00),
+  fixed(1.00026478183029721158e+00),
+  fixed(1.00030127204130203644e+00),
+  fixed(1.00034011889757334934e+00),
+  fixed(1.00038132285651637510e+00),
+  fixed(1.00042488440333654509e+00),
+  fixed(1.00047080405105370815e+00),
+  fixed(1.00051908234051700752e+00),
+  fixed(1.00056971984041997992e+00),
+  fixed(1.00062271714731787497e+00),
+  fixed(1.00067807488564319840e+00),
+  fixed(1.00073579370772569597e+00),
+  fixed(1.00079587429380922892e+00),
+  fixed(1.00085831735207242410e+00),
+  fixed(1.00092312361864910208e+00),
+  fixed(1.00099029385764870526e+00),
+  fixed(1.00105982886117916841e+00),
+  fixed(1.00113172944936956732e+00),
+  fixed(1.00120599647039254521e+00),
+  fixed(1.00128263080049095812e+00),
+  fixed(1.00136163334400096758e+00),
+  fixed(1.00144300503337979613e+00),
+  fixed(1.00152674682923126248e+00),
+  fixed(1.00161285972033464731e+00),
+  fixed(1.00170134472367222678e+00),
+  fixed(1.00179220288445947062e+00),
+  fixed(1.00188543527617457407e+00),
+  fixed(1.00198104300058998817e+00),
+  fixed(1.00207902718780395013e+00),
+  fixed(1.00217938899627312388e+00),
+  fixed(1.00228212961284612881e+00),
+  fixed(1.00238725025279817871e+00),
+  fixed(1.00249475215986549870e+00),
+  fixed(1.00260463660628218463e+00),
+  fixed(1.00271690489281684044e+00),
+  fixed(1.00283155834880921553e+00),
+  fixed(1.00294859833221083889e+00),
+  fixed(1.00306802622962187854e+00),
+  fixed(1.00318984345633355204e+00),
+  fixed(1.00331405145636720633e+00),
+  fixed(1.00344065170251850461e+00),
+  fixed(1.00356964569639806051e+00),
+  fixed(1.00370103496847584701e+00),
+  fixed(1.00383482107812627149e+00),
+  fixed(1.00397100561367280669e+00),
+  fixed(1.00410959019243439805e+00),
+  fixed(1.00425057646077209306e+00),
+  fixed(1.00439396609413811312e+00),
+  fixed(1.00453976079712337111e+00),
+  fixed(1.00468796230350809751e+00),
+  fixed(1.00483857237631135639e+00),
+  fixed(1.00499159280784411408e+00),
+  fixed(1.00514702541975964323e+00),
+  fixed(1.00530487206310836790e+00),
+  fixed(1.00546513461839071013e+00),
+  fixed(1.00562781499561260112e+00),
+  fixed(1.00579291513434165850e+00),
+  fixed(1.00596043700376358565e+00),
+  fixed(1.00613038260273945923e+00),
+  fixed(1.00630275395986523712e+00),
+  fixed(1.00647755313353015616e+00),
+  fixed(1.00665478221197823849e+00),
+  fixed(1.00683444331336846567e+00),
+  fixed(1.00701653858583806134e+00),
+  fixed(1.00720107020756444172e+00),
+  fixed(1.00738804038683049669e+00),
+  fixed(1.00757745136208853864e+00),
+  fixed(1.00776930540202713793e+00),
+  fixed(1.00796360480563684803e+00),
+  fixed(1.00816035190227926144e+00),
+  fixed(1.00835954905175473328e+00),
+  fixed(1.00856119864437232536e+00),
+  fixed(1.00876530310102063837e+00),
+  fixed(1.00897186487323908821e+00),
+  fixed(1.00918088644329073666e+00),
+  fixed(1.00939237032423534401e+00),
+  fixed(1.00960631906000442015e+00),
+  fixed(1.00982273522547605360e+00),
+  fixed(1.01004162142655129486e+00),
+  fixed(1.01026298030023209407e+00),
+  fixed(1.01048681451469923864e+00),
+  fixed(1.01071312676939184527e+00),
+  fixed(1.01094191979508729595e+00),
+  fixed(1.01117319635398295041e+00),
+  fixed(1.01140695923977852466e+00),
+  fixed(1.01164321127775891362e+00),
+  fixed(1.01188195532487923423e+00),
+  fixed(1.01212319426984942439e+00),
+  fixed(1.01236693103322106246e+00),
+  fixed(1.01261316856747485282e+00),
+  fixed(1.01286190985710833345e+00),
+  fixed(1.01311315791872647019e+00),
+  fixed(1.01336691580113069655e+00),
+  fixed(1.01362318658541217253e+00),
+  fixed(1.01388197338504237877e+00),
+  fixed(1.01414327934596837366e+00),
+  fixed(1.01440710764670671828e+00),
+  fixed(1.01467346149843939962e+00),
+  fixed(1.01494234414511064202e+00),
+  fixed(1.01521375886352438478e+00),
+  fixed(1.01548770896344442427e+00),
+  fixed(1.01576419778769300173e+00),
+  fixed(1.01604322871225272173e+00),
+  fixed(1.01632480514636935887e+00),
+  fixed(1.01660893053265377617e+00),
+  fixed(1.01689560834718761839e+00),
+  fixed(1.01718484209962856113e+00),
+  fixed(1.01747663533331644814e+00),
+  fixed(1.01777099162538187116e+00),
+  fixed(1.01806791458685541585e+00),
+  fixed(1.01836740786277601956e+00),
+  fixed(1.01866947513230421407e+00),
+  fixed(1.01897412010883359201e+00),
+  fixed(1.01928134654010427163e+00),
+  fixed(1.01959115820831835997e+00),
+  fixed(1.01990355893025452794e+00),
+  fixed(1.02021855255738636004e+00),
+  fixed(1.02053614297600026006e+00),
+  fixed(1.02085633410731468906e+00),
+  fixed(1.02117912990760073555e+00),
+  fixed(1.02150453436830446208e+00),
+  fixed(1.02183255151616969592e+00),
+  fixed(1.02216318541336237402e+00),
+  fixed(1.02249644015759577620e+00),
+  fixed(1.02283231988225797870e+00),
+  fixed(1.02317082875653908580e+00),
+  fixed(1.02351197098556090381e+00),
+  fixed(1.02385575081050794743e+00),
+  fixed(1.02420217250875800197e+00),
+  fixed(1.02455124039401623826e+00),
+  fixed(1.02490295881644932763e+00),
+  fixed(1.02525733216282088911e+00),
+  fixed(1.02561436485662826890e+00),
+  fixed(1.02597406135824131823e+00),
+  fixed(1.02633642616504117129e+00),
+  fixed(1.02670146381156235371e+00),
+  fixed(1.02706917886963355890e+00),
+  fixed(1.02743957594852242110e+00),
+  fixed(1.02781265969507917823e+00),
+  fixed(1.02818843479388433160e+00),
+  fixed(1.02856690596739497323e+00),
+  fixed(1.02894807797609466604e+00),
+  fixed(1.02933195561864354595e+00),
+  fixed(1.02971854373202997834e+00),
+  fixed(1.03010784719172354684e+00),
+  fixed(1.03049987091183070653e+00),
+  fixed(1.03089461984524910498e+00),
+  fixed(1.03129209898382634414e+00),
+  fixed(1.03169231335851829812e+00),
+  fixed(1.03209526803954987351e+00),
+  fixed(1.03250096813657599171e+00),
+  fixed(1.03290941879884567989e+00),
+  fixed(1.03332062521536638400e+00),
+  fixed(1.03373459261507050222e+00),
+  fixed(1.03415132626698236251e+00),
+  fixed(1.03457083148038808673e+00),
+  fixed(1.03499311360500700907e+00),
+  fixed(1.03541817803116198426e+00),
+  fixed(1.03584603018995546897e+00),
+  fixed(1.03627667555344316064e+00),
+  fixed(1.03671011963481163320e+00),
+  fixed(1.03714636798855730504e+00),
+  fixed(1.03758542621066562894e+00),
+  fixed(1.03802729993879339077e+00),
+  fixed(1.03847199485245189621e+00),
+  fixed(1.03891951667319171193e+00),
+  fixed(1.03936987116478940507e+00),
+  fixed(1.03982306413343561502e+00),
+  fixed(1.04027910142792512360e+00),
+  fixed(1.04073798893984803549e+00),
+  fixed(1.04119973260378340107e+00),
+  fixed(1.04166433839749350554e+00),
+  fixed(1.04213181234212126647e+00),
+  fixed(1.04260216050238740948e+00),
+  fixed(1.04307538898679164063e+00),
+  fixed(1.04355150394781381884e+00),
+  fixed(1.04403051158211779281e+00),
+  fixed(1.04451241813075612619e+00),
+  fixed(1.04499722987937770924e+00),
+  fixed(1.04548495315843670284e+00),
+  fixed(1.04597559434340237061e+00),
+  fixed(1.04646915985497268586e+00),
+  fixed(1.04696565615928771642e+00),
+  fixed(1.04746508976814678427e+00),
+  fixed(1.04796746723922518107e+00),
+  fixed(1.04847279517629554668e+00),
+  fixed(1.04898108022944791529e+00),
+  fixed(1.04949232909531553481e+00),
+  fixed(1.05000654851729890993e+00),
+  fixed(1.05052374528579339774e+00),
+  fixed(1.05104392623841991217e+00),
+  fixed(1.05156709826025518417e+00),
+  fixed(1.05209326828406535270e+00),
+  fixed(1.05262244329054222014e+00),
+  fixed(1.05315463030853995186e+00),
+  fixed(1.05368983641531466233e+00),
+  fixed(1.05422806873676599970e+00),
+  fixed(1.05476933444768095072e+00),
+  fixed(1.05531364077197920004e+00),
+  fixed(1.05586099498296070998e+00),
+  fixed(1.05641140440355596475e+00),
+  fixed(1.05696487640657776907e+00),
+  fixed(1.05752141841497526720e+00),
+  fixed(1.05808103790209018236e+00),
+  fixed(1.05864374239191572080e+00),
+  fixed(1.05920953945935614193e+00),
+  fixed(1.05977843673049054729e+00),
+  fixed(1.06035044188283800182e+00),
+  fixed(1.06092556264562398738e+00),
+  fixed(1.06150380680005063105e+00),
+  fixed(1.06208518217956826568e+00),
+  fixed(1.06266969667015009904e+00),
+  fixed(1.06325735821056754915e+00),
+  fixed(1.06384817479267024254e+00),
+  fixed(1.06444215446166690064e+00),
+  fixed(1.06503930531640822466e+00),
+  fixed(1.06563963550967355509e+00),
+  fixed(1.06624315324845841957e+00),
+  fixed(1.06684986679426652145e+00),
+  fixed(1.06745978446340195056e+00),
+  fixed(1.06807291462726516862e+00),
+  fixed(1.06868926571265121517e+00),
+  fixed(1.06930884620205057800e+00),
+  fixed(1.06993166463395272814e+00),
+  fixed(1.07055772960315054299e+00),
+  fixed(1.07118704976105116877e+00),
+  fixed(1.07181963381598399643e+00),
+  fixed(1.07245549053351751922e+00),
+  fixed(1.07309462873677241568e+00),
+  fixed(1.07373705730674329217e+00),
+  fixed(1.07438278518261798311e+00),
+  fixed(1.07503182136210417852e+00),
+  fixed(1.07568417490175405327e+00),
+  fixed(1.07633985491729644579e+00),
+  fixed(1.07699887058396792661e+00),
+  fixed(1.07766123113684852974e+00),
+  fixed(1.07832694587120059282e+00),
+  fixed(1.07899602414280959550e+00),
+  fixed(1.07966847536832744048e+00),
+  fixed(1.08034430902562084142e+00),
+  fixed(1.08102353465411971101e+00),
+  fixed(1.08170616185517109997e+00),
+  fixed(1.08239220029239402443e+00),
+  fixed(1.08308165969203895607e+00),
+  fixed(1.08377454984334953281e+00),
+  fixed(1.08447088059892715606e+00),
+  fixed(1.08517066187509936270e+00),
+  fixed(1.08587390365229019551e+00),
+  fixed(1.08658061597539568055e+00),
+  fixed(1.08729080895415997077e+00),
+  fixed(1.08800449276355659656e+00),
+  fixed(1.08872167764417215885e+00),
+  fixed(1.08944237390259401899e+00),
+  fixed(1.09016659191179954291e+00),
+  fixed(1.09089434211155000831e+00),
+  fixed(1.09162563500878895262e+00),
+  fixed(1.09236048117804096513e+00),
+  fixed(1.09309889126181603025e+00),
+  fixed(1.09384087597101764544e+00),
+  fixed(1.09458644608535182741e+00),
+  fixed(1.09533561245374277959e+00),
+  fixed(1.09608838599474989195e+00),
+  fixed(1.09684477769698940364e+00),
+  fixed(1.09760479861955895231e+00),
+  fixed(1.09836845989246612021e+00),
+  fixed(1.09913577271706119909e+00),
+  fixed(1.09990674836647195356e+00),
+  fixed(1.10068139818604393554e+00),
+  fixed(1.10145973359378390732e+00),
+  fixed(1.10224176608080681738e+00),
+  fixed(1.10302750721178610682e+00),
+  fixed(1.10381696862540934490e+00),
+  fixed(1.10461016203483697318e+00),
+  fixed(1.10540709922816438038e+00),
+  fixed(1.10620779206888908419e+00),
+  fixed(1.10701225249638057768e+00),
+  fixed(1.10782049252635572678e+00),
+  fixed(1.10863252425135772050e+00),
+  fixed(1.10944835984123790773e+00),
+  fixed(1.11026801154364362922e+00),
+  fixed(1.11109149168450960232e+00),
+  fixed(1.11191881266855241428e+00),
+  fixed(1.11274998697977123285e+00),
+  fixed(1.11358502718195140346e+00),
+  fixed(1.11442394591917337543e+00),
+  fixed(1.11526675591632451479e+00),
+  fixed(1.11611346997961691230e+00),
+  fixed(1.11696410099710985442e+00),
+  fixed(1.11781866193923495878e+00),
+  fixed(1.11867716585932708284e+00),
+  fixed(1.11953962589416033957e+00),
+  fixed(1.12040605526448810991e+00),
+  fixed(1.12127646727558749618e+00),
+  fixed(1.12215087531780910446e+00),
+  fixed(1.12302929286713082391e+00),
+  fixed(1.12391173348571804524e+00),
+  fixed(1.12479821082248654385e+00),
+  fixed(1.12568873861367202416e+00),
+  fixed(1.12658333068340454908e+00),
+  fixed(1.12748200094428585594e+00),
+  fixed(1.12838476339797555426e+00),
+  fixed(1.12929163213577865577e+00),
+  fixed(1.13020262133924065395e+00),
+  fixed(1.13111774528074660040e+00),
+  fixed(1.13203701832412617634e+00),
+  fixed(1.13296045492526409326e+00),
+  fixed(1.13388806963271537853e+00),
+  fixed(1.13481987708832599004e+00),
+  fixed(1.13575589202786031429e+00),
+  fixed(1.13669612928163110688e+00),
+  fixed(1.13764060377513920308e+00),
+  fixed(1.13858933052971589284e+00),
+  fixed(1.13954232466317151307e+00),
+  fixed(1.14049960139045025720e+00),
+  fixed(1.14146117602429075788e+00),
+  fixed(1.14242706397589266487e+00),
+  fixed(1.14339728075558855203e+00),
+  fixed(1.14437184197352204151e+00),
+  fixed(1.14535076334033281142e+00),
+  fixed(1.14633406066784626631e+00),
+  fixed(1.14732174986977053521e+00),
+  fixed(1.14831384696239902077e+00),
+  fixed(1.14931036806532005379e+00),
+  fixed(1.15031132940213165483e+00),
+  fixed(1.15131674730116406735e+00),
+  fixed(1.15232663819620761991e+00),
+  fixed(1.15334101862724813792e+00),
+  fixed(1.15435990524120790646e+00),
+  fixed(1.15538331479269462676e+00),
+  fixed(1.15641126414475614581e+00),
+  fixed(1.15744377026964162525e+00),
+  fixed(1.15848085024957137001e+00),
+  fixed(1.15952252127751176403e+00),
+  fixed(1.16056880065795842150e+00),
+  fixed(1.16161970580772488937e+00),
+  fixed(1.16267525425674156381e+00),
+  fixed(1.16373546364885793736e+00),
+  fixed(1.16480035174265617037e+00),
+  fixed(1.16586993641226777108e+00),
+  fixed(1.16694423564820204398e+00),
+  fixed(1.16802326755817920123e+00),
+  fixed(1.16910705036797168965e+00),
+  fixed(1.17019560242225462154e+00),
+  fixed(1.17128894218546197870e+00),
+  fixed(1.17238708824265192021e+00),
+  fixed(1.17349005930037963985e+00),
+  fixed(1.17459787418757866106e+00),
+  fixed(1.17571055185645012564e+00),
+  fixed(1.17682811138335940981e+00),
+  fixed(1.17795057196974251035e+00),
+  fixed(1.17907795294301998013e+00),
+  fixed(1.18021027375751885735e+00),
+  fixed(1.18134755399540436471e+00),
+  fixed(1.18248981336761938010e+00),
+  fixed(1.18363707171483301117e+00),
+  fixed(1.18478934900839805167e+00),
+  fixed(1.18594666535131598728e+00),
+  fixed(1.18710904097921465805e+00),
+  fixed(1.18827649626132969551e+00),
+  fixed(1.18944905170150083684e+00),
+  fixed(1.19062672793917290193e+00),
+  fixed(1.19180954575040920496e+00),
+  fixed(1.19299752604891251551e+00),
+  fixed(1.19419068988705778800e+00),
+  fixed(1.19538905845693155250e+00),
+  fixed(1.19659265309138462818e+00),
+  fixed(1.19780149526509260838e+00),
+  fixed(1.19901560659562544942e+00),
+  fixed(1.20023500884453082627e+00),
+  fixed(1.20145972391842414950e+00),
+  fixed(1.20268977387009057267e+00),
+  fixed(1.20392518089959721372e+00),
+  fixed(1.20516596735541625662e+00),
+  fixed(1.20641215573555804497e+00),
+  fixed(1.20766376868871638806e+00),
+  fixed(1.20892082901542252671e+00),
+  fixed(1.21018335966921308788e+00),
+  fixed(1.21145138375780625495e+00),
+  fixed(1.21272492454429192676e+00),
+  fixed(1.21400400544833098060e+00),
+  fixed(1.21528865004736807975e+00),
+  fixed(1.21657888207785513934e+00),
+  fixed(1.21787472543648633838e+00),
+  fixed(1.21917620418144556638e+00),
+  fixed(1.22048334253366719260e+00),
+  fixed(1.22179616487810505099e+00),
+  fixed(1.22311469576501985479e+00),
+  fixed(1.22443895991127349454e+00),
+  fixed(1.22576898220163910125e+00),
+  fixed(1.22710478769012243383e+00),
+  fixed(1.22844640160129792150e+00),
+  fixed(1.22979384933165536431e+00),
+  fixed(1.23114715645096239882e+00),
+  fixed(1.23250634870363806606e+00),
+  fixed(1.23387145201014125639e+00),
+  fixed(1.23524249246837292127e+00),
+  fixed(1.23661949635509094136e+00),
+  fixed(1.23800249012734053800e+00),
+  fixed(1.23939150042389689688e+00),
+  fixed(1.24078655406672466732e+00),
+  fixed(1.24218767806244834162e+00),
+  fixed(1.24359489960384217433e+00),
+  fixed(1.24500824607132964950e+00),
+  fixed(1.24642774503450159962e+00),
+  fixed(1.24785342425364809138e+00),
+  fixed(1.24928531168130563245e+00),
+  fixed(1.25072343546382036550e+00),
+  fixed(1.25216782394292591718e+00),
+  fixed(1.25361850565733878859e+00),
+  fixed(1.25507550934436795664e+00),
+  fixed(1.25653886394154223893e+00),
+  fixed(1.25800859858825186954e+00),
+  fixed(1.25948474262741094698e+00),
+  fixed(1.26096732560713076232e+00),
+  fixed(1.26245637728241577591e+00),
+  fixed(1.26395192761687313876e+00),
+  fixed(1.26545400678444086573e+00),
+  fixed(1.26696264517113377224e+00),
+  fixed(1.26847787337680628639e+00),
+  fixed(1.26999972221693591123e+00),
+  fixed(1.27152822272442045382e+00),
+  fixed(1.27306340615139790273e+00),
+  fixed(1.27460530397108229295e+00),
+  fixed(1.27615394787962133094e+00),
+  fixed(1.27770936979796867483e+00),
+  fixed(1.27927160187378041734e+00),
+  fixed(1.28084067648332777800e+00),
+  fixed(1.28241662623343066763e+00),
+  fixed(1.28399948396341279100e+00),
+  fixed(1.28558928274707318096e+00),
+  fixed(1.28718605589468304551e+00),
+  fixed(1.28878983695499993445e+00),
+  fixed(1.29040065971730455452e+00),
+  fixed(1.29201855821345756858e+00),
+  fixed(1.29364356671998015358e+00),
+  fixed(1.29527571976015343225e+00),
+  fixed(1.29691505210614277388e+00),
+  fixed(1.29856159878114274520e+00),
+  fixed(1.30021539506154470978e+00),
+  fixed(1.30187647647912907445e+00),
+  fixed(1.30354487882327751969e+00),
+  fixed(1.30522063814321231945e+00),
+  fixed(1.30690379075025653322e+00),
+  fixed(1.30859437322011951110e+00),
+  fixed(1.31029242239520726798e+00),
+  fixed(1.31199797538695572818e+00),
+  fixed(1.31371106957819105965e+00),
+  fixed(1.31543174262551332276e+00),
+  fixed(1.31716003246170720864e+00),
+  fixed(1.31889597729817764638e+00),
+  fixed(1.32063961562741227773e+00),
+  fixed(1.32239098622546946693e+00),
+  fixed(1.32415012815449517625e+00),
+  fixed(1.32591708076526404447e+00),
+  fixed(1.32769188369975132957e+00),
+  fixed(1.32947457689373060852e+00),
+  fixed(1.33126520057939967678e+00),
+  fixed(1.33306379528803664591e+00),
+  fixed(1.33487040185268268644e+00),
+  fixed(1.33668506141085696726e+00),
+  fixed(1.33850781540729868446e+00),
+  fixed(1.34033870559674062051e+00),
+  fixed(1.34217777404671245733e+00),
+  fixed(1.34402506314037628599e+00),
+  fixed(1.34588061557939053792e+00),
+  fixed(1.34774447438680944344e+00),
+  fixed(1.34961668291001135600e+00),
+  fixed(1.35149728482366082716e+00),
+  fixed(1.35338632413270332222e+00),
+  fixed(1.35528384517539390863e+00),
+  fixed(1.35718989262635902904e+00),
+  fixed(1.35910451149969224716e+00),
+  fixed(1.36102774715208552081e+00),
+  fixed(1.36295964528599400367e+00),
+  fixed(1.36490025195283903869e+00),
+  fixed(1.36684961355624334800e+00),
+  fixed(1.36880777685530796717e+00),
+  fixed(1.37077478896791915552e+00),
+  fixed(1.37275069737410015946e+00),
+  fixed(1.37473554991939539427e+00),
+  fixed(1.37672939481829526009e+00),
+  fixed(1.37873228065770070394e+00),
+  fixed(1.38074425640042464103e+00),
+  fixed(1.38276537138873689692e+00),
+  fixed(1.38479567534794556494e+00),
+  fixed(1.38683521839002343867e+00),
+  fixed(1.38888405101727285818e+00),
+  fixed(1.39094222412603496508e+00),
+  fixed(1.39300978901044025804e+00),
+  fixed(1.39508679736620244682e+00),
+  fixed(1.39717330129445826969e+00),
+  fixed(1.39926935330564816695e+00),
+  fixed(1.40137500632344580431e+00),
+  fixed(1.40349031368873067294e+00),
+  fixed(1.40561532916360687473e+00),
+  fixed(1.40775010693547186769e+00),
+  fixed(1.40989470162112984220e+00),
+  fixed(1.41204916827095305898e+00),
+  fixed(1.41421356237309492343e+00),
+  fixed(1.41638793985774968931e+00),
+  fixed(1.41857235710146345475e+00),
+  fixed(1.42076687093149800489e+00),
+  fixed(1.42297153863024150589e+00),
+  fixed(1.42518641793967693054e+00),
+  fixed(1.42741156706590022196e+00),
+  fixed(1.42964704468369308010e+00),
+  fixed(1.43189290994114926114e+00),
+  fixed(1.43414922246435949660e+00),
+  fixed(1.43641604236214792678e+00),
+  fixed(1.43869343023086937450e+00),
+  fixed(1.44098144715926079762e+00),
+  fixed(1.44328015473335424801e+00),
+  fixed(1.44558961504144756205e+00),
+  fixed(1.44790989067913411503e+00),
+  fixed(1.45024104475439696849e+00),
+  fixed(1.45258314089276052705e+00),
+  fixed(1.45493624324250836466e+00),
+  fixed(1.45730041647996189091e+00),
+  fixed(1.45967572581482674110e+00),
+  fixed(1.46206223699560022844e+00),
+  fixed(1.46446001631505051677e+00),
+  fixed(1.46686913061575729955e+00),
+  fixed(1.46928964729572530956e+00),
+  fixed(1.47172163431406488598e+00),
+  fixed(1.47416516019674315174e+00),
+  fixed(1.47662029404240646713e+00),
+  fixed(1.47908710552827460383e+00),
+  fixed(1.48156566491611063618e+00),
+  fixed(1.48405604305826055445e+00),
+  fixed(1.48655831140377414634e+00),
+  fixed(1.48907254200459715499e+00),
+  fixed(1.49159880752184381691e+00),
+  fixed(1.49413718123214978029e+00),
+  fixed(1.49668773703410007414e+00),
+  fixed(1.49925054945474389712e+00),
+  fixed(1.50182569365618667767e+00),
+  fixed(1.50441324544226984194e+00),
+  fixed(1.50701328126533296015e+00),
+  fixed(1.50962587823306226831e+00),
+  fixed(1.51225111411542756379e+00),
+  fixed(1.51488906735170658635e+00),
+  fixed(1.51753981705759932730e+00),
+  fixed(1.52020344303243515327e+00),
+  fixed(1.52288002576647074626e+00),
+  fixed(1.52556964644828352284e+00),
+  fixed(1.52827238697225942232e+00),
+  fixed(1.53098832994617817249e+00),
+  fixed(1.53371755869889692114e+00),
+  fixed(1.53646015728813378765e+00),
+  fixed(1.53921621050835333300e+00),
+  fixed(1.54198580389875217200e+00),
+  fixed(1.54476902375135494161e+00),
+  fixed(1.54756595711920819092e+00),
+  fixed(1.55037669182469062257e+00),
+  fixed(1.55320131646792591873e+00),
+  fixed(1.55603992043531014211e+00),
+  fixed(1.55889259390815082540e+00),
+  fixed(1.56175942787142196799e+00),
+  fixed(1.56464051412263227547e+00),
+  fixed(1.56753594528081396930e+00),
+  fixed(1.57044581479563283288e+00),
+  fixed(1.57337021695661394283e+00),
+  fixed(1.57630924690250040499e+00),
+  fixed(1.57926300063072844182e+00),
+  fixed(1.58223157500703592859e+00),
+  fixed(1.58521506777519993747e+00),
+  fixed(1.58821357756690173524e+00),
+  fixed(1.59122720391173322341e+00),
+  fixed(1.59425604724732972173e+00),
+  fixed(1.59730020892964996726e+00),
+  fixed(1.60035979124338822999e+00),
+  fixed(1.60343489741253630854e+00),
+  fixed(1.60652563161108430378e+00),
+  fixed(1.60963209897387127256e+00),
+  fixed(1.61275440560758509534e+00),
+  fixed(1.61589265860191355628e+00),
+  fixed(1.61904696604084974432e+00),
+  fixed(1.62221743701415532790e+00),
+  fixed(1.62540418162898103738e+00),
+  fixed(1.62860731102164968398e+00),
+  fixed(1.63182693736960682251e+00),
+  fixed(1.63506317390353239638e+00),
+  fixed(1.63831613491962890805e+00),
+  fixed(1.64158593579207656710e+00),
+  fixed(1.64487269298566829434e+00),
+  fixed(1.64817652406862191761e+00),
+  fixed(1.65149754772557044724e+00),
+  fixed(1.65483588377074375408e+00),
+  fixed(1.65819165316132965948e+00),
+  fixed(1.66156497801103264500e+00),
+  fixed(1.66495598160381996777e+00),
+  fixed(1.66836478840787072464e+00),
+  fixed(1.67179152408972053756e+00),
+  fixed(1.67523631552861274052e+00),
+  fixed(1.67869929083105362544e+00),
+  fixed(1.68218057934558373745e+00),
+  fixed(1.68568031167775567170e+00),
+  fixed(1.68919861970533524698e+00),
+  fixed(1.69273563659372383583e+00),
+  fixed(1.69629149681160251717e+00),
+  fixed(1.69986633614680826554e+00),
+  fixed(1.70346029172244151084e+00),
+  fixed(1.70707350201321284011e+00),
+  fixed(1.71070610686202662087e+00),
+  fixed(1.71435824749681442469e+00),
+  fixed(1.71803006654761514227e+00),
+  fixed(1.72172170806391000575e+00),
+  fixed(1.72543331753221429459e+00),
+  fixed(1.72916504189393327451e+00),
+  fixed(1.73291702956348547815e+00),
+  fixed(1.73668943044669621401e+00),
+  fixed(1.74048239595946929725e+00),
+  fixed(1.74429607904673922292e+00),
+  fixed(1.74813063420171244111e+00),
+  fixed(1.75198621748539440368e+00),
+  fixed(1.75586298654642170014e+00),
+  fixed(1.75976110064118906884e+00),
+  fixed(1.76368072065428527218e+00),
+  fixed(1.76762200911924671765e+00),
+  fixed(1.77158513023962305155e+00),
+  fixed(1.77557024991037026851e+00),
+  fixed(1.77957753573957355719e+00),
+  fixed(1.78360715707050698775e+00),
+  fixed(1.78765928500403248336e+00),
+  fixed(1.79173409242135006636e+00),
+  fixed(1.79583175400710048919e+00),
+  fixed(1.79995244627283113026e+00),
+  fixed(1.80409634758082804140e+00),
+  fixed(1.80826363816832125231e+00),
+  fixed(1.81245450017207465621e+00),
+  fixed(1.81666911765336180906e+00),
+  fixed(1.82090767662333696819e+00),
+  fixed(1.82517036506881091817e+00),
+  fixed(1.82945737297843535885e+00),
+  fixed(1.83376889236930451510e+00),
+  fixed(1.83810511731398684709e+00),
+  fixed(1.84246624396798375223e+00),
+  fixed(1.84685247059763613109e+00),
+  fixed(1.85126399760847681897e+00),
+  fixed(1.85570102757404553628e+00),
+  fixed(1.86016376526516591383e+00),
+  fixed(1.86465241767970568709e+00),
+  fixed(1.86916719407281495258e+00),
+  fixed(1.87370830598766446862e+00),
+  fixed(1.87827596728668355652e+00),
+  fixed(1.88287039418331625384e+00),
+  fixed(1.88749180527429571974e+00),
+  fixed(1.89214042157245798670e+00),
+  fixed(1.89681646654009217201e+00),
+  fixed(1.90152016612285423847e+00),
+  fixed(1.90625174878423853109e+00),
+  fixed(1.91101144554062751801e+00),
+  fixed(1.91579948999693283618e+00),
+  fixed(1.92061611838282941811e+00),
+  fixed(1.92546156958960601457e+00),
+  fixed(1.93033608520763122485e+00),
+  fixed(1.93523990956446456657e+00),
+  fixed(1.94017328976360836634e+00),
+  fixed(1.94513647572392156526e+00),
+  fixed(1.95012972021970520942e+00),
+  fixed(1.95515327892148360611e+00),
+  fixed(1.96020741043747781518e+00),
+  fixed(1.96529237635579367982e+00),
+  fixed(1.97040844128734993213e+00),
+  fixed(1.97555587290953926782e+00),
+  fixed(1.98073494201065680720e+00),
+  fixed(1.98594592253509327762e+00),
+  fixed(1.99118909162933488410e+00),
+  fixed(1.99646472968875543508e+00),
+  fixed(2.00177312040523958103e+00),
+  fixed(2.00711455081564116298e+00),
+  fixed(2.01248931135110797896e+00),
+  fixed(2.01789769588727407879e+00),
+  fixed(2.02334000179534623243e+00),
+  fixed(2.02881652999410944105e+00),
+  fixed(2.03432758500285704173e+00),
+  fixed(2.03987347499527604811e+00),
+  fixed(2.04545451185429705276e+00),
+  fixed(2.05107101122794643899e+00),
+  fixed(2.05672329258620134596e+00),
+  fixed(2.06241167927888113809e+00),
+  fixed(2.06813649859459713909e+00),
+  fixed(2.07389808182077794996e+00),
+  fixed(2.07969676430479921692e+00),
+  fixed(2.08553288551623250413e+00),
+  fixed(2.09140678911025279518e+00),
+  fixed(2.09731882299221217281e+00),
+  fixed(2.10326933938341698038e+00),
+  fixed(2.10925869488812711694e+00),
+  fixed(2.11528725056181388098e+00),
+  fixed(2.12135537198069412668e+00),
+  fixed(2.12746342931257048647e+00),
+  fixed(2.13361179738900830216e+00),
+  fixed(2.13980085577888656800e+00),
+  fixed(2.14603098886333487627e+00),
+  fixed(2.15230258591210343866e+00),
+  fixed(2.15861604116139194076e+00),
+  fixed(2.16497175389317186855e+00),
+  fixed(2.17137012851602895225e+00),
+  fixed(2.17781157464757013642e+00),
+  fixed(2.18429650719842527451e+00),
+  fixed(2.19082534645788040706e+00),
+  fixed(2.19739851818117148952e+00),
+  fixed(2.20401645367849940982e+00),
+  fixed(2.21067958990577606571e+00),
+  fixed(2.21738836955716411836e+00),
+  fixed(2.22414324115943529137e+00),
+  fixed(2.23094465916821027562e+00),
+  fixed(2.23779308406609844795e+00),
+  fixed(2.24468898246279913167e+00),
+  fixed(2.25163282719720170277e+00),
+  fixed(2.25862509744154227320e+00),
+  fixed(2.26566627880765070202e+00),
+  fixed(2.27275686345533989297e+00),
+  fixed(2.27989735020300843260e+00),
+  fixed(2.28708824464047477676e+00),
+  fixed(2.29433005924412558585e+00),
+  fixed(2.30162331349441551254e+00),
+  fixed(2.30896853399578860788e+00),
+  fixed(2.31636625459906531077e+00),
+  fixed(2.32381701652636651900e+00),
+  fixed(2.33132136849862670047e+00),
+  fixed(2.33887986686576931916e+00),
+  fixed(2.34649307573960097528e+00),
+  fixed(2.35416156712948820839e+00),
+  fixed(2.36188592108090267274e+00),
+  fixed(2.36966672581688397869e+00),
+  fixed(2.37750457788250413316e+00),
+  fixed(2.38540008229240418913e+00),
+  fixed(2.39335385268148703730e+00),
+  fixed(2.40136651145883339709e+00),
+  fixed(2.40943868996493293366e+00),
+  fixed(2.41757102863229844658e+00),
+  fixed(2.42576417714957459637e+00),
+  fixed(2.43401879462920600616e+00),
+  fixed(2.44233554977875666481e+00),
+  fixed(2.45071512107599653874e+00),
+  fixed(2.45915819694782422644e+00),
+  fixed(2.46766547595314200692e+00),
+  fixed(2.47623766696977432034e+00),
+  fixed(2.48487548938554869693e+00),
+  fixed(2.49357967329363283682e+00),
+  fixed(2.50235095969224552448e+00),
+  fixed(2.51119010068885328835e+00),
+  fixed(2.52009785970898203544e+00),
+  fixed(2.52907501170974757798e+00),
+  fixed(2.53812234339823827867e+00),
+  fixed(2.54724065345489059098e+00),
+  fixed(2.55643075276196940493e+00),
+  fixed(2.56569346463730596497e+00),
+  fixed(2.57502962507342392229e+00),
+  fixed(2.58444008298221872266e+00),
+  fixed(2.59392570044531156626e+00),
+  fixed(2.60348735297025779545e+00),
+  fixed(2.61312592975275270746e+00),
+  fixed(2.62284233394501997694e+00),
+  fixed(2.63263748293052701754e+00),
+  fixed(2.64251230860521646449e+00),
+  fixed(2.65246775766544606867e+00),
+  fixed(2.66250479190279598640e+00),
+  fixed(2.67262438850596417694e+00),
+  fixed(2.68282754036992310276e+00),
+  fixed(2.69311525641257221153e+00),
+  fixed(2.70348856189907005287e+00),
+  fixed(2.71394849877408272931e+00),
+  fixed(2.72449612600216184433e+00),
+  fixed(2.73513251991650774286e+00),
+  fixed(2.74585877457632898668e+00),
+  fixed(2.75667600213306318579e+00),
+  fixed(2.76758533320573141268e+00),
+  fixed(2.77858791726565534930e+00),
+  fixed(2.78968492303084847350e+00),
+  fixed(2.80087753887033619193e+00),
+  fixed(2.81216697321872954873e+00),
+  fixed(2.82355445500132207215e+00),
+  fixed(2.83504123407005259594e+00),
+  fixed(2.84662858165063381577e+00),
+  fixed(2.85831779080120940151e+00),
+  fixed(2.87011017688286829141e+00),
+  fixed(2.88200707804236566645e+00),
+  fixed(2.89400985570746360764e+00),
+  fixed(2.90611989509522850028e+00),
+  fixed(2.91833860573371417502e+00),
+  fixed(2.93066742199742558128e+00),
+  fixed(2.94310780365701507577e+00),
+  fixed(2.95566123644362166445e+00),
+  fixed(2.96832923262833237033e+00),
+  fixed(2.98111333161723024432e+00),
+  fixed(2.99401510056253572500e+00),
+  fixed(3.00703613499033206580e+00),
+  fixed(3.02017805944540329577e+00),
+  fixed(3.03344252815375936549e+00),
+  fixed(3.04683122570337516777e+00),
+  fixed(3.06034586774376826668e+00),
+  fixed(3.07398820170499087467e+00),
+  fixed(3.08776000753671064913e+00),
+  fixed(3.10166309846799226335e+00),
+  fixed(3.11569932178849651194e+00),
+  fixed(3.12987055965176930172e+00),
+  fixed(3.14417872990140345735e+00),
+  fixed(3.15862578692077899944e+00),
+  fixed(3.17321372250719813124e+00),
+  fixed(3.18794456677126225586e+00),
+  fixed(3.20282038906228727626e+00),
+  fixed(3.21784329892069065338e+00),
+  fixed(3.23301544705824106529e+00),
+  fixed(3.24833902636715876611e+00),
+  fixed(3.26381627295901788344e+00),
+  fixed(3.27944946723452623871e+00),
+  fixed(3.29524093498522141488e+00),
+  fixed(3.31119304852823903573e+00),
+  fixed(3.32730822787527857898e+00),
+  fixed(3.34358894193699063280e+00),
+  fixed(3.36003770976406679338e+00),
+  fixed(3.37665710182630096625e+00),
+  fixed(3.39344974133101429103e+00),
+  fixed(3.41041830558225056436e+00),
+  fixed(3.42756552738224540278e+00),
+  fixed(3.44489419647666839097e+00),
+  fixed(3.46240716104527157526e+00),
+  fixed(3.48010732923962518015e+00),
+  fixed(3.49799767076965251178e+00),
+  fixed(3.51608121854081234758e+00),
+  fixed(3.53436107034379176639e+00),
+  fixed(3.55284039059873890665e+00),
+  fixed(3.57152241215602872515e+00),
+  fixed(3.59041043815577953779e+00),
+  fixed(3.60950784394830570534e+00),
+  fixed(3.62881807907792275358e+00),
+  fixed(3.64834466933247991705e+00),
+  fixed(3.66809121886121536349e+00),
+  fixed(3.68806141236362439173e+00),
+  fixed(3.70825901735208240950e+00),
+  fixed(3.72868788649118387823e+00),
+  fixed(3.74935196001681569911e+00),
+  fixed(3.77025526823819401301e+00),
+  fixed(3.79140193412615778001e+00),
+  fixed(3.81279617599123810123e+00),
+  fixed(3.83444231025513770916e+00),
+  fixed(3.85634475431948464674e+00),
+  fixed(3.87850802953580542365e+00),
+  fixed(3.90093676428094005004e+00),
+  fixed(3.92363569714233184627e+00),
+  fixed(3.94660968021771196845e+00),
+  fixed(3.96986368253408183904e+00),
+  fixed(3.99340279359099614709e+00),
+  fixed(4.01723222703351279250e+00),
+  fixed(4.04135732446031070708e+00),
+  fixed(4.06578355937286861632e+00),
+  fixed(4.09051654127179720177e+00),
+  fixed(4.11556201990682168912e+00),
+  fixed(4.14092588968710373365e+00),
+  fixed(4.16661419425905066305e+00),
+  fixed(4.19263313125910208612e+00),
+  fixed(4.21898905724927697491e+00),
+  fixed(4.24568849284380256393e+00),
+  fixed(4.27273812803545105510e+00),
+  fixed(4.30014482773080342071e+00),
+  fixed(4.32791563750395802401e+00),
+  fixed(4.35605778957889544500e+00),
+  fixed(4.38457870905111057880e+00),
+  fixed(4.41348602035982384706e+00),
+  fixed(4.44278755402253988649e+00),
+  fixed(4.47249135364448591190e+00),
+  fixed(4.50260568321615028964e+00),
+  fixed(4.53313903471274137758e+00),
+  fixed(4.56410013601032371611e+00),
+  fixed(4.59549795913406367021e+00),
+  fixed(4.62734172885504335682e+00),
+  fixed(4.65964093165285131448e+00),
+  fixed(4.69240532506231211585e+00),
+  fixed(4.72564494742363905289e+00),
+  fixed(4.75937012805655879077e+00),
+  fixed(4.79359149787997740333e+00),
+  fixed(4.82832000050015253123e+00),
+  fixed(4.86356690379172551530e+00),
+  fixed(4.89934381199725255129e+00),
+  fixed(4.93566267837261563045e+00),
+  fixed(4.97253581840718617002e+00),
+  fixed(5.00997592364955135480e+00),
+  fixed(5.04799607617129453274e+00),
+  fixed(5.08660976370354322995e+00),
+  fixed(5.12583089548301096272e+00),
+  fixed(5.16567381884672194303e+00),
+  fixed(5.20615333661691970235e+00),
+  fixed(5.24728472532043799248e+00),
+  fixed(5.28908375428972199472e+00),
+  fixed(5.33156670569553270411e+00),
+  fixed(5.37475039556491474002e+00),
+  fixed(5.41865219584133317454e+00),
+  fixed(5.46329005754787910831e+00),
+  fixed(5.50868253511831706959e+00),
+  fixed(5.55484881196532054304e+00),
+  fixed(5.60180872735988444333e+00),
+  fixed(5.64958280470110185689e+00),
+  fixed(5.69819228126082943930e+00),
+  fixed(5.74765913949386497706e+00),
+  fixed(5.79800614001067327052e+00),
+  fixed(5.84925685631643244022e+00),
+  fixed(5.90143571142792122686e+00),
+  fixed(5.95456801648763089929e+00),
+  fixed(6.00868001150351904727e+00),
+  fixed(6.06379890835198498422e+00),
+  fixed(6.11995293619229840942e+00),
+  fixed(6.17717138945158428243e+00),
+  fixed(6.23548467855190224896e+00),
+  fixed(6.29492438356381800446e+00),
+  fixed(6.35552331098540612686e+00),
+  fixed(6.41731555386129670637e+00),
+  fixed(6.48033655547304121569e+00),
+  fixed(6.54462317685096905961e+00),
+  fixed(6.61021376837760854528e+00),
+  fixed(6.67714824577508547776e+00),
+  fixed(6.74546817079268556938e+00),
+  fixed(6.81521683693743796084e+00),
+  fixed(6.88643936061920491909e+00),
+  fixed(6.95918277811364927032e+00),
+  fixed(7.03349614878078543967e+00),
+  fixed(7.10943066501516085509e+00),
+  fixed(7.18703976944561429008e+00),
+  fixed(7.26637927994823495936e+00),
+  fixed(7.34750752308722709927e+00),
+  fixed(7.43048547665394920614e+00),
+  fixed(7.51537692203634311028e+00),
+  fixed(7.60224860721868278546e+00),
+  fixed(7.69117042128724826000e+00),
+  fixed(7.78221558140061375752e+00),
+  fixed(7.87546083327600499047e+00),
+  fixed(7.97098666634525532260e+00),
+  fixed(8.06887754484825059365e+00),
+  fixed(8.16922215625849545972e+00),
+  fixed(8.27211367857631785228e+00),
+  fixed(8.37765006818316670945e+00),
+  fixed(8.48593437012602258562e+00),
+  fixed(8.59707505289810747229e+00),
+  fixed(8.71118637000189544040e+00),
+  fixed(8.82838875082812712947e+00),
+  fixed(8.94880922366178488403e+00),
+  fixed(9.07258187393871295967e+00),
+  fixed(9.19984834122802475065e+00),
+  fixed(9.33075835881296811181e+00),
+  fixed(9.46547034019205568711e+00),
+  fixed(9.60415201733009560314e+00),
+  fixed(9.74698113606615024196e+00),
+  fixed(9.89414621474028166404e+00),
+  fixed(1.00458473728475805586e+01),
+  fixed(1.02022972373783105127e+01),
+  fixed(1.03637219354762830648e+01),
+  fixed(1.05303621831608165138e+01),
+  fixed(1.07024744811363223818e+01),
+  fixed(1.08803324301826584986e+01),
+  fixed(1.10642281803139628238e+01),
+  fixed(1.12544740298507264242e+01),
+  fixed(1.14514041928149588045e+01),
+  fixed(1.16553767556893088653e+01),
+  fixed(1.18667758476406071111e+01),
+  fixed(1.20860140518797027909e+01),
+  fixed(1.23135350900051179224e+01),
+  fixed(1.25498168160786782721e+01),
+  fixed(1.27953745629456321353e+01),
+  fixed(1.30507648901128536778e+01),
+  fixed(1.33165897905510810517e+01),
+  fixed(1.35935014233472664102e+01),
+  fixed(1.38822074505256498611e+01),
+  fixed(1.41834770699755701173e+01),
+  fixed(1.44981478527698577352e+01),
+  fixed(1.48271335128446057894e+01),
+  fixed(1.51714327608207284470e+01),
+  fixed(1.55321394226567797148e+01),
+  fixed(1.59104540390801751926e+01),
+  fixed(1.63076972049336283987e+01),
+  fixed(1.67253249607281553324e+01),
+  fixed(1.71649466144416429358e+01),
+  fixed(1.76283454533384116303e+01),
+  fixed(1.81175029077594054172e+01),
+  fixed(1.86346268572756841309e+01),
+  fixed(1.91821849320459492105e+01),
+  fixed(1.97629438689658414319e+01),
+  fixed(2.03800162470960657402e+01),
+  fixed(2.10369162686565083220e+01),
+  fixed(2.17376266962191095899e+01),
+  fixed(2.24866796389760459363e+01),
+  fixed(2.32892546503500739163e+01),
+  fixed(2.41512986250744710048e+01),
+  fixed(2.50796733648291407803e+01),
+  fixed(2.60823385596307382173e+01),
+  fixed(2.71685805145689194262e+01),
+  fixed(2.83493005443877450489e+01),
+  fixed(2.96373820211336358454e+01),
+  fixed(3.10481622925618481190e+01),
+  fixed(3.26000461760631097263e+01),
+  fixed(3.43153131875142634044e+01),
+  fixed(3.62211938464148204275e+01),
+  fixed(3.83513258534219474427e+01),
+  fixed(4.07477563344629061248e+01),
+  fixed(4.34637449824901267448e+01),
+  fixed(4.65677685457069756580e+01),
+  fixed(5.01493735411240137978e+01),
+  fixed(5.43279553248964646173e+01),
+  fixed(5.92663257464780741657e+01),
+  fixed(6.51924213952748203837e+01),
+  fixed(7.24354840117273823807e+01),
+  fixed(8.14893762067036675489e+01),
+  fixed(9.31301677975266670728e+01),
+  fixed(1.08651308480013923941e+02),
+  fixed(1.30381007706977641192e+02),
+  fixed(1.62975684384450318021e+02),
+  fixed(2.17300315960418629402e+02),
+  fixed(3.25949834779675256868e+02),
+  fixed(6.51898902567937852837e+02),
+  fixed(1.00000000000000000000e+08),
+  fixed(-6.51898902567989921408e+02),
+  fixed(-3.25949834779688274011e+02),
+  fixed(-2.17300315960424427431e+02),
+  fixed(-1.62975684384453586517e+02),
+  fixed(-1.30381007706979715977e+02),
+  fixed(-1.08651308480015373448e+02),
+  fixed(-9.31301677975277328869e+01),
+  fixed(-8.14893762067044775677e+01),
+  fixed(-7.24354840117280218692e+01),
+  fixed(-6.51924213952753319745e+01),
+  fixed(-5.92663257464785004913e+01),
+  fixed(-5.43279553248968340995e+01),
+  fixed(-5.01493735411243193312e+01),
+  fixed(-4.65677685457072385589e+01),
+  fixed(-4.34637449824903541185e+01),
+  fixed(-4.07477563344631121822e+01),
+  fixed(-3.83513258534221321838e+01),
+  fixed(-3.62211938464149767469e+01),
+  fixed(-3.43153131875144126184e+01),
+  fixed(-3.26000461760632447294e+01),
+  fixed(-3.10481622925619689113e+01),
+  fixed(-2.96373820211337424269e+01),
+  fixed(-2.83493005443878445249e+01),
+  fixed(-2.71685805145690117968e+01),
+  fixed(-2.60823385596308234824e+01),
+  fixed(-2.50796733648292153873e+01),
+  fixed(-2.41512986250745420591e+01),
+  fixed(-2.32892546503501414179e+01),
+  fixed(-2.24866796389761063324e+01),
+  fixed(-2.17376266962191664334e+01),
+  fixed(-2.10369162686565651654e+01),
+  fixed(-2.03800162470961154781e+01),
+  fixed(-1.97629438689658911699e+01),
+  fixed(-1.91821849320459953958e+01),
+  fixed(-1.86346268572757267634e+01),
+  fixed(-1.81175029077594444971e+01),
+  fixed(-1.76283454533384507101e+01),
+  fixed(-1.71649466144416784630e+01),
+  fixed(-1.67253249607281908595e+01),
+  fixed(-1.63076972049336603732e+01),
+  fixed(-1.59104540390802036143e+01),
+  fixed(-1.55321394226568099128e+01),
+  fixed(-1.51714327608207568687e+01),
+  fixed(-1.48271335128446324347e+01),
+  fixed(-1.44981478527698843806e+01),
+  fixed(-1.41834770699755914336e+01),
+  fixed(-1.38822074505256747301e+01),
+  fixed(-1.35935014233472895029e+01),
+  fixed(-1.33165897905511023680e+01),
+  fixed(-1.30507648901128714414e+01),
+  fixed(-1.27953745629456534516e+01),
+  fixed(-1.25498168160786960357e+01),
+  fixed(-1.23135350900051356859e+01),
+  fixed(-1.20860140518797205544e+01),
+  fixed(-1.18667758476406248747e+01),
+  fixed(-1.16553767556893266288e+01),
+  fixed(-1.14514041928149765681e+01),
+  fixed(-1.12544740298507424114e+01),
+  fixed(-1.10642281803139788110e+01),
+  fixed(-1.08803324301826727094e+01),
+  fixed(-1.07024744811363365926e+01),
+  fixed(-1.05303621831608289483e+01),
+  fixed(-1.03637219354762972756e+01),
+  fixed(-1.02022972373783229472e+01),
+  fixed(-1.00458473728475929931e+01),
+  fixed(-9.89414621474029409853e+00),
+  fixed(-9.74698113606616267646e+00),
+  fixed(-9.60415201733010626128e+00),
+  fixed(-9.46547034019206634525e+00),
+  fixed(-9.33075835881297876995e+00),
+  fixed(-9.19984834122803540879e+00),
+  fixed(-9.07258187393872361781e+00),
+  fixed(-8.94880922366179376581e+00),
+  fixed(-8.82838875082813778761e+00),
+  fixed(-8.71118637000190432218e+00),
+  fixed(-8.59707505289811635407e+00),
+  fixed(-8.48593437012603146741e+00),
+  fixed(-8.37765006818317559123e+00),
+  fixed(-8.27211367857632673406e+00),
+  fixed(-8.16922215625850434151e+00),
+  fixed(-8.06887754484825769907e+00),
+  fixed(-7.97098666634526420438e+00),
+  fixed(-7.87546083327601209589e+00),
+  fixed(-7.78221558140061997477e+00),
+  fixed(-7.69117042128725447725e+00),
+  fixed(-7.60224860721869077906e+00),
+  fixed(-7.51537692203635110388e+00),
+  fixed(-7.43048547665395542339e+00),
+  fixed(-7.34750752308723420470e+00),
+  fixed(-7.26637927994824117661e+00),
+  fixed(-7.18703976944561961915e+00),
+  fixed(-7.10943066501516618416e+00),
+  fixed(-7.03349614878079165692e+00),
+  fixed(-6.95918277811365637575e+00),
+  fixed(-6.88643936061921024816e+00),
+  fixed(-6.81521683693744328991e+00),
+  fixed(-6.74546817079269089845e+00),
+  fixed(-6.67714824577508991865e+00),
+  fixed(-6.61021376837761298617e+00),
+  fixed(-6.54462317685097438869e+00),
+  fixed(-6.48033655547304565658e+00),
+  fixed(-6.41731555386130114726e+00),
+  fixed(-6.35552331098541056775e+00),
+  fixed(-6.29492438356382244535e+00),
+  fixed(-6.23548467855190757803e+00),
+  fixed(-6.17717138945158872332e+00),
+  fixed(-6.11995293619230285032e+00),
+  fixed(-6.06379890835199031329e+00),
+  fixed(-6.00868001150352259998e+00),
+  fixed(-5.95456801648763622836e+00),
+  fixed(-5.90143571142792477957e+00),
+  fixed(-5.84925685631643688112e+00),
+  fixed(-5.79800614001067682324e+00),
+  fixed(-5.74765913949386941795e+00),
+  fixed(-5.69819228126083299202e+00),
+  fixed(-5.64958280470110540961e+00),
+  fixed(-5.60180872735988888422e+00),
+  fixed(-5.55484881196532409575e+00),
+  fixed(-5.50868253511832062230e+00),
+  fixed(-5.46329005754788354920e+00),
+  fixed(-5.41865219584133583908e+00),
+  fixed(-5.37475039556491918091e+00),
+  fixed(-5.33156670569553625683e+00),
+  fixed(-5.28908375428972554744e+00),
+  fixed(-5.24728472532044154519e+00),
+  fixed(-5.20615333661692325506e+00),
+  fixed(-5.16567381884672549575e+00),
+  fixed(-5.12583089548301451543e+00),
+  fixed(-5.08660976370354678266e+00),
+  fixed(-5.04799607617129808546e+00),
+  fixed(-5.00997592364955490751e+00),
+  fixed(-4.97253581840718972273e+00),
+  fixed(-4.93566267837261918316e+00),
+  fixed(-4.89934381199725521583e+00),
+  fixed(-4.86356690379172817984e+00),
+  fixed(-4.82832000050015519577e+00),
+  fixed(-4.79359149787998006786e+00),
+  fixed(-4.75937012805656145531e+00),
+  fixed(-4.72564494742364082924e+00),
+  fixed(-4.69240532506231478038e+00),
+  fixed(-4.65964093165285397902e+00),
+  fixed(-4.62734172885504513317e+00),
+  fixed(-4.59549795913406633474e+00),
+  fixed(-4.56410013601032638064e+00),
+  fixed(-4.53313903471274404211e+00),
+  fixed(-4.50260568321615206600e+00),
+  fixed(-4.47249135364448857644e+00),
+  fixed(-4.44278755402254255102e+00),
+  fixed(-4.41348602035982651159e+00),
+  fixed(-4.38457870905111324333e+00),
+  fixed(-4.35605778957889810954e+00),
+  fixed(-4.32791563750396068855e+00),
+  fixed(-4.30014482773080519706e+00),
+  fixed(-4.27273812803545371963e+00),
+  fixed(-4.24568849284380434028e+00),
+  fixed(-4.21898905724927963945e+00),
+  fixed(-4.19263313125910475065e+00),
+  fixed(-4.16661419425905332758e+00),
+  fixed(-4.14092588968710551001e+00),
+  fixed(-4.11556201990682346548e+00),
+  fixed(-4.09051654127179897813e+00),
+  fixed(-4.06578355937287039268e+00),
+  fixed(-4.04135732446031248344e+00),
+  fixed(-4.01723222703351456886e+00),
+  fixed(-3.99340279359099792345e+00),
+  fixed(-3.96986368253408361539e+00),
+  fixed(-3.94660968021771330072e+00),
+  fixed(-3.92363569714233362262e+00),
+  fixed(-3.90093676428094182640e+00),
+  fixed(-3.87850802953580720001e+00),
+  fixed(-3.85634475431948642310e+00),
+  fixed(-3.83444231025513904143e+00),
+  fixed(-3.81279617599123943350e+00),
+  fixed(-3.79140193412615911228e+00),
+  fixed(-3.77025526823819578937e+00),
+  fixed(-3.74935196001681703137e+00),
+  fixed(-3.72868788649118609868e+00),
+  fixed(-3.70825901735208418586e+00),
+  fixed(-3.68806141236362572400e+00),
+  fixed(-3.66809121886121713985e+00),
+  fixed(-3.64834466933248169340e+00),
+  fixed(-3.62881807907792452994e+00),
+  fixed(-3.60950784394830703761e+00),
+  fixed(-3.59041043815578087006e+00),
+  fixed(-3.57152241215603005742e+00),
+  fixed(-3.55284039059874023891e+00),
+  fixed(-3.53436107034379354275e+00),
+  fixed(-3.51608121854081367985e+00),
+  fixed(-3.49799767076965384405e+00),
+  fixed(-3.48010732923962651242e+00),
+  fixed(-3.46240716104527290753e+00),
+  fixed(-3.44489419647667016733e+00),
+  fixed(-3.42756552738224673504e+00),
+  fixed(-3.41041830558225189662e+00),
+  fixed(-3.39344974133101562330e+00),
+  fixed(-3.37665710182630229852e+00),
+  fixed(-3.36003770976406812565e+00),
+  fixed(-3.34358894193699196506e+00),
+  fixed(-3.32730822787527991125e+00),
+  fixed(-3.31119304852823992391e+00),
+  fixed(-3.29524093498522274714e+00),
+  fixed(-3.27944946723452801507e+00),
+  fixed(-3.26381627295901921570e+00),
+  fixed(-3.24833902636715965428e+00),
+  fixed(-3.23301544705824284165e+00),
+  fixed(-3.21784329892069198564e+00),
+  fixed(-3.20282038906228860853e+00),
+  fixed(-3.18794456677126403221e+00),
+  fixed(-3.17321372250719946351e+00),
+  fixed(-3.15862578692077988762e+00),
+  fixed(-3.14417872990140478962e+00),
+  fixed(-3.12987055965177018990e+00),
+  fixed(-3.11569932178849740012e+00),
+  fixed(-3.10166309846799359562e+00),
+  fixed(-3.08776000753671153731e+00),
+  fixed(-3.07398820170499220694e+00),
+  fixed(-3.06034586774377004303e+00),
+  fixed(-3.04683122570337650004e+00),
+  fixed(-3.03344252815376069776e+00),
+  fixed(-3.02017805944540462804e+00),
+  fixed(-3.00703613499033339806e+00),
+  fixed(-2.99401510056253705727e+00),
+  fixed(-2.98111333161723113250e+00),
+  fixed(-2.96832923262833370259e+00),
+  fixed(-2.95566123644362299672e+00),
+  fixed(-2.94310780365701596395e+00),
+  fixed(-2.93066742199742646946e+00),
+  fixed(-2.91833860573371506320e+00),
+  fixed(-2.90611989509522938846e+00),
+  fixed(-2.89400985570746449582e+00),
+  fixed(-2.88200707804236655463e+00),
+  fixed(-2.87011017688286917959e+00),
+  fixed(-2.85831779080121028969e+00),
+  fixed(-2.84662858165063470395e+00),
+  fixed(-2.83504123407005348412e+00),
+  fixed(-2.82355445500132296033e+00),
+  fixed(-2.81216697321873043691e+00),
+  fixed(-2.80087753887033708011e+00),
+  fixed(-2.78968492303084936168e+00),
+  fixed(-2.77858791726565623748e+00),
+  fixed(-2.76758533320573230085e+00),
+  fixed(-2.75667600213306407397e+00),
+  fixed(-2.74585877457632943077e+00),
+  fixed(-2.73513251991650863104e+00),
+  fixed(-2.72449612600216273250e+00),
+  fixed(-2.71394849877408361749e+00),
+  fixed(-2.70348856189907049696e+00),
+  fixed(-2.69311525641257309971e+00),
+  fixed(-2.68282754036992399094e+00),
+  fixed(-2.67262438850596506512e+00),
+  fixed(-2.66250479190279687458e+00),
+  fixed(-2.65246775766544651276e+00),
+  fixed(-2.64251230860521735266e+00),
+  fixed(-2.63263748293052790572e+00),
+  fixed(-2.62284233394502086512e+00),
+  fixed(-2.61312592975275315155e+00),
+  fixed(-2.60348735297025868363e+00),
+  fixed(-2.59392570044531201034e+00),
+  fixed(-2.58444008298221916675e+00),
+  fixed(-2.57502962507342481047e+00),
+  fixed(-2.56569346463730640906e+00),
+  fixed(-2.55643075276197029311e+00),
+  fixed(-2.54724065345489147916e+00),
+  fixed(-2.53812234339823916685e+00),
+  fixed(-2.52907501170974846616e+00),
+  fixed(-2.52009785970898247953e+00),
+  fixed(-2.51119010068885417652e+00),
+  fixed(-2.50235095969224641266e+00),
+  fixed(-2.49357967329363328091e+00),
+  fixed(-2.48487548938554914102e+00),
+  fixed(-2.47623766696977476442e+00),
+  fixed(-2.46766547595314289509e+00),
+  fixed(-2.45915819694782467053e+00),
+  fixed(-2.45071512107599698282e+00),
+  fixed(-2.44233554977875755299e+00),
+  fixed(-2.43401879462920689434e+00),
+  fixed(-2.42576417714957504046e+00),
+  fixed(-2.41757102863229889067e+00),
+  fixed(-2.40943868996493337775e+00),
+  fixed(-2.40136651145883561753e+00),
+  fixed(-2.39335385268148748139e+00),
+  fixed(-2.38540008229240330095e+00),
+  fixed(-2.37750457788250502134e+00),
+  fixed(-2.36966672581688486687e+00),
+  fixed(-2.36188592108090444910e+00),
+  fixed(-2.35416156712948865248e+00),
+  fixed(-2.34649307573960053119e+00),
+  fixed(-2.33887986686577109552e+00),
+  fixed(-2.33132136849862714456e+00),
+  fixed(-2.32381701652636607491e+00),
+  fixed(-2.31636625459906664304e+00),
+  fixed(-2.30896853399578905197e+00),
+  fixed(-2.30162331349441506845e+00),
+  fixed(-2.29433005924412602994e+00),
+  fixed(-2.28708824464047522085e+00),
+  fixed(-2.27989735020301020896e+00),
+  fixed(-2.27275686345534078114e+00),
+  fixed(-2.26566627880765025793e+00),
+  fixed(-2.25862509744154404956e+00),
+  fixed(-2.25163282719720214686e+00),
+  fixed(-2.24468898246279868758e+00),
+  fixed(-2.23779308406610022431e+00),
+  fixed(-2.23094465916821071971e+00),
+  fixed(-2.22414324115943484728e+00),
+  fixed(-2.21738836955716456245e+00),
+  fixed(-2.21067958990577650980e+00),
+  fixed(-2.20401645367850118618e+00),
+  fixed(-2.19739851818117193361e+00),
+  fixed(-2.19082534645787996297e+00),
+  fixed(-2.18429650719842660678e+00),
+  fixed(-2.17781157464757058051e+00),
+  fixed(-2.17137012851602895225e+00),
+  fixed(-2.16497175389317320082e+00),
+  fixed(-2.15861604116139282894e+00),
+  fixed(-2.15230258591210299457e+00),
+  fixed(-2.14603098886333576445e+00),
+  fixed(-2.13980085577888701209e+00),
+  fixed(-2.13361179738900963443e+00),
+  fixed(-2.12746342931257093056e+00),
+  fixed(-2.12135537198069457077e+00),
+  fixed(-2.11528725056181565733e+00),
+  fixed(-2.10925869488812756103e+00),
+  fixed(-2.10326933938341653629e+00),
+  fixed(-2.09731882299221350507e+00),
+  fixed(-2.09140678911025323927e+00),
+  fixed(-2.08553288551623206004e+00),
+  fixed(-2.07969676430479966101e+00),
+  fixed(-2.07389808182077839405e+00),
+  fixed(-2.06813649859459847136e+00),
+  fixed(-2.06241167927888202627e+00),
+  fixed(-2.05672329258620179004e+00),
+  fixed(-2.05107101122794777126e+00),
+  fixed(-2.04545451185429749685e+00),
+  fixed(-2.03987347499527560402e+00),
+  fixed(-2.03432758500285837400e+00),
+  fixed(-2.02881652999410988514e+00),
+  fixed(-2.02334000179534578834e+00),
+  fixed(-2.01789769588727452287e+00),
+  fixed(-2.01248931135110842305e+00),
+  fixed(-2.00711455081564249525e+00),
+  fixed(-2.00177312040524002512e+00),
+  fixed(-1.99646472968875587917e+00),
+  fixed(-1.99118909162933621637e+00),
+  fixed(-1.98594592253509372171e+00),
+  fixed(-1.98073494201065636311e+00),
+  fixed(-1.97555587290954060009e+00),
+  fixed(-1.97040844128735037621e+00),
+  fixed(-1.96529237635579323573e+00),
+  fixed(-1.96020741043747825927e+00),
+  fixed(-1.95515327892148405020e+00),
+  fixed(-1.95012972021970654168e+00),
+  fixed(-1.94513647572392156526e+00),
+  fixed(-1.94017328976360881043e+00),
+  fixed(-1.93523990956446567679e+00),
+  fixed(-1.93033608520763166894e+00),
+  fixed(-1.92546156958960557048e+00),
+  fixed(-1.92061611838283075038e+00),
+  fixed(-1.91579948999693328027e+00),
+  fixed(-1.91101144554062707392e+00),
+  fixed(-1.90625174878423897518e+00),
+  fixed(-1.90152016612285446051e+00),
+  fixed(-1.89681646654009328223e+00),
+  fixed(-1.89214042157245820874e+00),
+  fixed(-1.88749180527429594179e+00),
+  fixed(-1.88287039418331714202e+00),
+  fixed(-1.87827596728668400061e+00),
+  fixed(-1.87370830598766446862e+00),
+  fixed(-1.86916719407281561871e+00),
+  fixed(-1.86465241767970590914e+00),
+  fixed(-1.86016376526516569179e+00),
+  fixed(-1.85570102757404598037e+00),
+  fixed(-1.85126399760847726306e+00),
+  fixed(-1.84685247059763724131e+00),
+  fixed(-1.84246624396798441836e+00),
+  fixed(-1.83810511731398684709e+00),
+  fixed(-1.83376889236930540328e+00),
+  fixed(-1.82945737297843535885e+00),
+  fixed(-1.82517036506881091817e+00),
+  fixed(-1.82090767662333763433e+00),
+  fixed(-1.81666911765336225315e+00),
+  fixed(-1.81245450017207465621e+00),
+  fixed(-1.80826363816832191844e+00),
+  fixed(-1.80409634758082804140e+00),
+  fixed(-1.79995244627283224048e+00),
+  fixed(-1.79583175400710071123e+00),
+  fixed(-1.79173409242135006636e+00),
+  fixed(-1.78765928500403337154e+00),
+  fixed(-1.78360715707050743184e+00),
+  fixed(-1.77957753573957355719e+00),
+  fixed(-1.77557024991037071260e+00),
+  fixed(-1.77158513023962327360e+00),
+  fixed(-1.76762200911924671765e+00),
+  fixed(-1.76368072065428593831e+00),
+  fixed(-1.75976110064118906884e+00),
+  fixed(-1.75586298654642170014e+00),
+  fixed(-1.75198621748539506982e+00),
+  fixed(-1.74813063420171244111e+00),
+  fixed(-1.74429607904674011110e+00),
+  fixed(-1.74048239595946929725e+00),
+  fixed(-1.73668943044669621401e+00),
+  fixed(-1.73291702956348614428e+00),
+  fixed(-1.72916504189393349655e+00),
+  fixed(-1.72543331753221385050e+00),
+  fixed(-1.72172170806391044984e+00),
+  fixed(-1.71803006654761514227e+00),
+  fixed(-1.71435824749681420265e+00),
+  fixed(-1.71070610686202684292e+00),
+  fixed(-1.70707350201321284011e+00),
+  fixed(-1.70346029172244262107e+00),
+  fixed(-1.69986633614680848758e+00),
+  fixed(-1.69629149681160251717e+00),
+  fixed(-1.69273563659372450196e+00),
+  fixed(-1.68919861970533546902e+00),
+  fixed(-1.68568031167775522761e+00),
+  fixed(-1.68218057934558440358e+00),
+  fixed(-1.67869929083105406953e+00),
+  fixed(-1.67523631552861229643e+00),
+  fixed(-1.67179152408972120369e+00),
+  fixed(-1.66836478840787072464e+00),
+  fixed(-1.66495598160382041186e+00),
+  fixed(-1.66156497801103286704e+00),
+  fixed(-1.65819165316132965948e+00),
+  fixed(-1.65483588377074419817e+00),
+  fixed(-1.65149754772557066929e+00),
+  fixed(-1.64817652406862147352e+00),
+  fixed(-1.64487269298566896047e+00),
+  fixed(-1.64158593579207656710e+00),
+  fixed(-1.63831613491962868601e+00),
+  fixed(-1.63506317390353306251e+00),
+  fixed(-1.63182693736960682251e+00),
+  fixed(-1.62860731102165057216e+00),
+  fixed(-1.62540418162898125942e+00),
+  fixed(-1.62221743701415532790e+00),
+  fixed(-1.61904696604085041045e+00),
+  fixed(-1.61589265860191377833e+00),
+  fixed(-1.61275440560758509534e+00),
+  fixed(-1.60963209897387193870e+00),
+  fixed(-1.60652563161108452583e+00),
+  fixed(-1.60343489741253630854e+00),
+  fixed(-1.60035979124338867408e+00),
+  fixed(-1.59730020892964996726e+00),
+  fixed(-1.59425604724733060991e+00),
+  fixed(-1.59122720391173366750e+00),
+  fixed(-1.58821357756690173524e+00),
+  fixed(-1.58521506777520015952e+00),
+  fixed(-1.58223157500703615064e+00),
+  fixed(-1.57926300063072821978e+00),
+  fixed(-1.57630924690250084907e+00),
+  fixed(-1.57337021695661416487e+00),
+  fixed(-1.57044581479563261084e+00),
+  fixed(-1.56753594528081463544e+00),
+  fixed(-1.56464051412263227547e+00),
+  fixed(-1.56175942787142263413e+00),
+  fixed(-1.55889259390815126949e+00),
+  fixed(-1.55603992043531014211e+00),
+  fixed(-1.55320131646792636282e+00),
+  fixed(-1.55037669182469084461e+00),
+  fixed(-1.54756595711920819092e+00),
+  fixed(-1.54476902375135516365e+00),
+  fixed(-1.54198580389875239405e+00),
+  fixed(-1.53921621050835311095e+00),
+  fixed(-1.53646015728813423173e+00),
+  fixed(-1.53371755869889692114e+00),
+  fixed(-1.53098832994617861658e+00),
+  fixed(-1.52827238697225964437e+00),
+  fixed(-1.52556964644828352284e+00),
+  fixed(-1.52288002576647119035e+00),
+  fixed(-1.52020344303243515327e+00),
+  fixed(-1.51753981705759910525e+00),
+  fixed(-1.51488906735170680840e+00),
+  fixed(-1.51225111411542778583e+00),
+  fixed(-1.50962587823306204626e+00),
+  fixed(-1.50701328126533340424e+00),
+  fixed(-1.50441324544226984194e+00),
+  fixed(-1.50182569365618712176e+00),
+  fixed(-1.49925054945474411916e+00),
+  fixed(-1.49668773703410007414e+00),
+  fixed(-1.49413718123215000233e+00),
+  fixed(-1.49159880752184381691e+00),
+  fixed(-1.48907254200459671090e+00),
+  fixed(-1.48655831140377459043e+00),
+  fixed(-1.48405604305826077649e+00),
+  fixed(-1.48156566491611041414e+00),
+  fixed(-1.47908710552827526996e+00),
+  fixed(-1.47662029404240646713e+00),
+  fixed(-1.47416516019674381788e+00),
+  fixed(-1.47172163431406510803e+00),
+  fixed(-1.46928964729572553161e+00),
+  fixed(-1.46686913061575774364e+00),
+  fixed(-1.46446001631505073881e+00),
+  fixed(-1.46206223699560022844e+00),
+  fixed(-1.45967572581482696314e+00),
+  fixed(-1.45730041647996211296e+00),
+  fixed(-1.45493624324250836466e+00),
+  fixed(-1.45258314089276097114e+00),
+  fixed(-1.45024104475439696849e+00),
+  fixed(-1.44790989067913478117e+00),
+  fixed(-1.44558961504144778409e+00),
+  fixed(-1.44328015473335424801e+00),
+  fixed(-1.44098144715926124171e+00),
+  fixed(-1.43869343023086959654e+00),
+  fixed(-1.43641604236214792678e+00),
+  fixed(-1.43414922246435994069e+00),
+  fixed(-1.43189290994114948319e+00),
+  fixed(-1.42964704468369285806e+00),
+  fixed(-1.42741156706590066605e+00),
+  fixed(-1.42518641793967715259e+00),
+  fixed(-1.42297153863024194997e+00),
+  fixed(-1.42076687093149822694e+00),
+  fixed(-1.41857235710146367680e+00),
+  fixed(-1.41638793985774991135e+00),
+  fixed(-1.41421356237309514547e+00),
+  fixed(-1.41204916827095305898e+00),
+  fixed(-1.40989470162113028628e+00),
+  fixed(-1.40775010693547208973e+00),
+  fixed(-1.40561532916360665268e+00),
+  fixed(-1.40349031368873089498e+00),
+  fixed(-1.40137500632344580431e+00),
+  fixed(-1.39926935330564861104e+00),
+  fixed(-1.39717330129445826969e+00),
+  fixed(-1.39508679736620244682e+00),
+  fixed(-1.39300978901044048008e+00),
+  fixed(-1.39094222412603518713e+00),
+  fixed(-1.38888405101727285818e+00),
+  fixed(-1.38683521839002366072e+00),
+  fixed(-1.38479567534794578698e+00),
+  fixed(-1.38276537138873689692e+00),
+  fixed(-1.38074425640042508512e+00),
+  fixed(-1.37873228065770070394e+00),
+  fixed(-1.37672939481829570418e+00),
+  fixed(-1.37473554991939561631e+00),
+  fixed(-1.37275069737410015946e+00),
+  fixed(-1.37077478896791959961e+00),
+  fixed(-1.36880777685530796717e+00),
+  fixed(-1.36684961355624334800e+00),
+  fixed(-1.36490025195283926074e+00),
+  fixed(-1.36295964528599422572e+00),
+  fixed(-1.36102774715208552081e+00),
+  fixed(-1.35910451149969269125e+00),
+  fixed(-1.35718989262635902904e+00),
+  fixed(-1.35528384517539435272e+00),
+  fixed(-1.35338632413270354427e+00),
+  fixed(-1.35149728482366082716e+00),
+  fixed(-1.34961668291001180009e+00),
+  fixed(-1.34774447438680966549e+00),
+  fixed(-1.34588061557939053792e+00),
+  fixed(-1.34402506314037673008e+00),
+  fixed(-1.34217777404671267938e+00),
+  fixed(-1.34033870559674039846e+00),
+  fixed(-1.33850781540729890651e+00),
+  fixed(-1.33668506141085696726e+00),
+  fixed(-1.33487040185268313053e+00),
+  fixed(-1.33306379528803686796e+00),
+  fixed(-1.33126520057939967678e+00),
+  fixed(-1.32947457689373105261e+00),
+  fixed(-1.32769188369975155162e+00),
+  fixed(-1.32591708076526404447e+00),
+  fixed(-1.32415012815449517625e+00),
+  fixed(-1.32239098622546968897e+00),
+  fixed(-1.32063961562741227773e+00),
+  fixed(-1.31889597729817786842e+00),
+  fixed(-1.31716003246170720864e+00),
+  fixed(-1.31543174262551354481e+00),
+  fixed(-1.31371106957819128169e+00),
+  fixed(-1.31199797538695572818e+00),
+  fixed(-1.31029242239520749003e+00),
+  fixed(-1.30859437322011951110e+00),
+  fixed(-1.30690379075025653322e+00),
+  fixed(-1.30522063814321276354e+00),
+  fixed(-1.30354487882327774173e+00),
+  fixed(-1.30187647647912907445e+00),
+  fixed(-1.30021539506154515387e+00),
+  fixed(-1.29856159878114274520e+00),
+  fixed(-1.29691505210614299592e+00),
+  fixed(-1.29527571976015365429e+00),
+  fixed(-1.29364356671998015358e+00),
+  fixed(-1.29201855821345801267e+00),
+  fixed(-1.29040065971730477656e+00),
+  fixed(-1.28878983695499993445e+00),
+  fixed(-1.28718605589468326755e+00),
+  fixed(-1.28558928274707318096e+00),
+  fixed(-1.28399948396341279100e+00),
+  fixed(-1.28241662623343111171e+00),
+  fixed(-1.28084067648332777800e+00),
+  fixed(-1.27927160187378086142e+00),
+  fixed(-1.27770936979796889688e+00),
+  fixed(-1.27615394787962133094e+00),
+  fixed(-1.27460530397108273704e+00),
+  fixed(-1.27306340615139790273e+00),
+  fixed(-1.27152822272442045382e+00),
+  fixed(-1.26999972221693635532e+00),
+  fixed(-1.26847787337680650843e+00),
+  fixed(-1.26696264517113355019e+00),
+  fixed(-1.26545400678444108777e+00),
+  fixed(-1.26395192761687313876e+00),
+  fixed(-1.26245637728241622000e+00),
+  fixed(-1.26096732560713098437e+00),
+  fixed(-1.25948474262741094698e+00),
+  fixed(-1.25800859858825231363e+00),
+  fixed(-1.25653886394154223893e+00),
+  fixed(-1.25507550934436795664e+00),
+  fixed(-1.25361850565733923268e+00),
+  fixed(-1.25216782394292591718e+00),
+  fixed(-1.25072343546382014345e+00),
+  fixed(-1.24928531168130563245e+00),
+  fixed(-1.24785342425364809138e+00),
+  fixed(-1.24642774503450182166e+00),
+  fixed(-1.24500824607132964950e+00),
+  fixed(-1.24359489960384239637e+00),
+  fixed(-1.24218767806244878571e+00),
+  fixed(-1.24078655406672466732e+00),
+  fixed(-1.23939150042389689688e+00),
+  fixed(-1.23800249012734076004e+00),
+  fixed(-1.23661949635509094136e+00),
+  fixed(-1.23524249246837269922e+00),
+  fixed(-1.23387145201014147844e+00),
+  fixed(-1.23250634870363806606e+00),
+  fixed(-1.23114715645096262087e+00),
+  fixed(-1.22979384933165558635e+00),
+  fixed(-1.22844640160129792150e+00),
+  fixed(-1.22710478769012287792e+00),
+  fixed(-1.22576898220163932329e+00),
+  fixed(-1.22443895991127349454e+00),
+  fixed(-1.22311469576502007683e+00),
+  fixed(-1.22179616487810505099e+00),
+  fixed(-1.22048334253366697055e+00),
+  fixed(-1.21917620418144578842e+00),
+  fixed(-1.21787472543648633838e+00),
+  fixed(-1.21657888207785558343e+00),
+  fixed(-1.21528865004736830180e+00),
+  fixed(-1.21400400544833098060e+00),
+  fixed(-1.21272492454429214881e+00),
+  fixed(-1.21145138375780647699e+00),
+  fixed(-1.21018335966921308788e+00),
+  fixed(-1.20892082901542274875e+00),
+  fixed(-1.20766376868871638806e+00),
+  fixed(-1.20641215573555804497e+00),
+  fixed(-1.20516596735541625662e+00),
+  fixed(-1.20392518089959721372e+00),
+  fixed(-1.20268977387009035063e+00),
+  fixed(-1.20145972391842437155e+00),
+  fixed(-1.20023500884453082627e+00),
+  fixed(-1.19901560659562544942e+00),
+  fixed(-1.19780149526509260838e+00),
+  fixed(-1.19659265309138462818e+00),
+  fixed(-1.19538905845693177454e+00),
+  fixed(-1.19419068988705778800e+00),
+  fixed(-1.19299752604891251551e+00),
+  fixed(-1.19180954575040920496e+00),
+  fixed(-1.19062672793917290193e+00),
+  fixed(-1.18944905170150083684e+00),
+  fixed(-1.18827649626132969551e+00),
+  fixed(-1.18710904097921465805e+00),
+  fixed(-1.18594666535131620932e+00),
+  fixed(-1.18478934900839805167e+00),
+  fixed(-1.18363707171483301117e+00),
+  fixed(-1.18248981336761960215e+00),
+  fixed(-1.18134755399540436471e+00),
+  fixed(-1.18021027375751885735e+00),
+  fixed(-1.17907795294302020217e+00),
+  fixed(-1.17795057196974251035e+00),
+  fixed(-1.17682811138335940981e+00),
+  fixed(-1.17571055185645012564e+00),
+  fixed(-1.17459787418757866106e+00),
+  fixed(-1.17349005930037986190e+00),
+  fixed(-1.17238708824265192021e+00),
+  fixed(-1.17128894218546197870e+00),
+  fixed(-1.17019560242225484359e+00),
+  fixed(-1.16910705036797191170e+00),
+  fixed(-1.16802326755817920123e+00),
+  fixed(-1.16694423564820204398e+00),
+  fixed(-1.16586993641226777108e+00),
+  fixed(-1.16480035174265594833e+00),
+  fixed(-1.16373546364885815940e+00),
+  fixed(-1.16267525425674156381e+00),
+  fixed(-1.16161970580772511141e+00),
+  fixed(-1.16056880065795842150e+00),
+  fixed(-1.15952252127751198607e+00),
+  fixed(-1.15848085024957159206e+00),
+  fixed(-1.15744377026964162525e+00),
+  fixed(-1.15641126414475614581e+00),
+  fixed(-1.15538331479269484880e+00),
+  fixed(-1.15435990524120790646e+00),
+  fixed(-1.15334101862724791587e+00),
+  fixed(-1.15232663819620761991e+00),
+  fixed(-1.15131674730116406735e+00),
+  fixed(-1.15031132940213187688e+00),
+  fixed(-1.14931036806532027583e+00),
+  fixed(-1.14831384696239902077e+00),
+  fixed(-1.14732174986977075726e+00),
+  fixed(-1.14633406066784648836e+00),
+  fixed(-1.14535076334033281142e+00),
+  fixed(-1.14437184197352226356e+00),
+  fixed(-1.14339728075558855203e+00),
+  fixed(-1.14242706397589266487e+00),
+  fixed(-1.14146117602429097992e+00),
+  fixed(-1.14049960139045025720e+00),
+  fixed(-1.13954232466317173511e+00),
+  fixed(-1.13858933052971611488e+00),
+  fixed(-1.13764060377513920308e+00),
+  fixed(-1.13669612928163110688e+00),
+  fixed(-1.13575589202786031429e+00),
+  fixed(-1.13481987708832599004e+00),
+  fixed(-1.13388806963271560058e+00),
+  fixed(-1.13296045492526409326e+00),
+  fixed(-1.13203701832412595429e+00),
+  fixed(-1.13111774528074660040e+00),
+  fixed(-1.13020262133924065395e+00),
+  fixed(-1.12929163213577887781e+00),
+  fixed(-1.12838476339797577630e+00),
+  fixed(-1.12748200094428585594e+00),
+  fixed(-1.12658333068340454908e+00),
+  fixed(-1.12568873861367224620e+00),
+  fixed(-1.12479821082248654385e+00),
+  fixed(-1.12391173348571826729e+00),
+  fixed(-1.12302929286713082391e+00),
+  fixed(-1.12215087531780910446e+00),
+  fixed(-1.12127646727558771822e+00),
+  fixed(-1.12040605526448810991e+00),
+  fixed(-1.11953962589416056161e+00),
+  fixed(-1.11867716585932708284e+00),
+  fixed(-1.11781866193923495878e+00),
+  fixed(-1.11696410099711007646e+00),
+  fixed(-1.11611346997961713434e+00),
+  fixed(-1.11526675591632429274e+00),
+  fixed(-1.11442394591917337543e+00),
+  fixed(-1.11358502718195162551e+00),
+  fixed(-1.11274998697977101081e+00),
+  fixed(-1.11191881266855241428e+00),
+  fixed(-1.11109149168450960232e+00),
+  fixed(-1.11026801154364407331e+00),
+  fixed(-1.10944835984123812977e+00),
+  fixed(-1.10863252425135772050e+00),
+  fixed(-1.10782049252635594883e+00),
+  fixed(-1.10701225249638057768e+00),
+  fixed(-1.10620779206888908419e+00),
+  fixed(-1.10540709922816460242e+00),
+  fixed(-1.10461016203483697318e+00),
+  fixed(-1.10381696862540934490e+00),
+  fixed(-1.10302750721178610682e+00),
+  fixed(-1.10224176608080681738e+00),
+  fixed(-1.10145973359378412937e+00),
+  fixed(-1.10068139818604393554e+00),
+  fixed(-1.09990674836647195356e+00),
+  fixed(-1.09913577271706142113e+00),
+  fixed(-1.09836845989246634225e+00),
+  fixed(-1.09760479861955895231e+00),
+  fixed(-1.09684477769698940364e+00),
+  fixed(-1.09608838599474989195e+00),
+  fixed(-1.09533561245374277959e+00),
+  fixed(-1.09458644608535182741e+00),
+  fixed(-1.09384087597101764544e+00),
+  fixed(-1.09309889126181625230e+00),
+  fixed(-1.09236048117804096513e+00),
+  fixed(-1.09162563500878895262e+00),
+  fixed(-1.09089434211155023036e+00),
+  fixed(-1.09016659191179954291e+00),
+  fixed(-1.08944237390259401899e+00),
+  fixed(-1.08872167764417238089e+00),
+  fixed(-1.08800449276355659656e+00),
+  fixed(-1.08729080895415997077e+00),
+  fixed(-1.08658061597539568055e+00),
+  fixed(-1.08587390365229041755e+00),
+  fixed(-1.08517066187509958475e+00),
+  fixed(-1.08447088059892737810e+00),
+  fixed(-1.08377454984334953281e+00),
+  fixed(-1.08308165969203917811e+00),
+  fixed(-1.08239220029239402443e+00),
+  fixed(-1.08170616185517109997e+00),
+  fixed(-1.08102353465411993305e+00),
+  fixed(-1.08034430902562084142e+00),
+  fixed(-1.07966847536832744048e+00),
+  fixed(-1.07899602414280959550e+00),
+  fixed(-1.07832694587120059282e+00),
+  fixed(-1.07766123113684875179e+00),
+  fixed(-1.07699887058396792661e+00),
+  fixed(-1.07633985491729666784e+00),
+  fixed(-1.07568417490175427531e+00),
+  fixed(-1.07503182136210417852e+00),
+  fixed(-1.07438278518261798311e+00),
+  fixed(-1.07373705730674329217e+00),
+  fixed(-1.07309462873677263772e+00),
+  fixed(-1.07245549053351729718e+00),
+  fixed(-1.07181963381598421847e+00),
+  fixed(-1.07118704976105116877e+00),
+  fixed(-1.07055772960315076503e+00),
+  fixed(-1.06993166463395272814e+00),
+  fixed(-1.06930884620205057800e+00),
+  fixed(-1.06868926571265121517e+00),
+  fixed(-1.06807291462726516862e+00),
+  fixed(-1.06745978446340195056e+00),
+  fixed(-1.06684986679426674350e+00),
+  fixed(-1.06624315324845841957e+00),
+  fixed(-1.06563963550967333305e+00),
+  fixed(-1.06503930531640844670e+00),
+  fixed(-1.06444215446166690064e+00),
+  fixed(-1.06384817479267046458e+00),
+  fixed(-1.06325735821056754915e+00),
+  fixed(-1.06266969667015009904e+00),
+  fixed(-1.06208518217956848773e+00),
+  fixed(-1.06150380680005063105e+00),
+  fixed(-1.06092556264562398738e+00),
+  fixed(-1.06035044188283822386e+00),
+  fixed(-1.05977843673049054729e+00),
+  fixed(-1.05920953945935614193e+00),
+  fixed(-1.05864374239191594285e+00),
+  fixed(-1.05808103790209018236e+00),
+  fixed(-1.05752141841497548924e+00),
+  fixed(-1.05696487640657776907e+00),
+  fixed(-1.05641140440355596475e+00),
+  fixed(-1.05586099498296070998e+00),
+  fixed(-1.05531364077197920004e+00),
+  fixed(-1.05476933444768095072e+00),
+  fixed(-1.05422806873676599970e+00),
+  fixed(-1.05368983641531466233e+00),
+  fixed(-1.05315463030853995186e+00),
+  fixed(-1.05262244329054222014e+00),
+  fixed(-1.05209326828406535270e+00),
+  fixed(-1.05156709826025518417e+00),
+  fixed(-1.05104392623841991217e+00),
+  fixed(-1.05052374528579339774e+00),
+  fixed(-1.05000654851729890993e+00),
+  fixed(-1.04949232909531575686e+00),
+  fixed(-1.04898108022944791529e+00),
+  fixed(-1.04847279517629554668e+00),
+  fixed(-1.04796746723922540312e+00),
+  fixed(-1.04746508976814678427e+00),
+  fixed(-1.04696565615928793846e+00),
+  fixed(-1.04646915985497268586e+00),
+  fixed(-1.04597559434340259266e+00),
+  fixed(-1.04548495315843670284e+00),
+  fixed(-1.04499722987937770924e+00),
+  fixed(-1.04451241813075612619e+00),
+  fixed(-1.04403051158211779281e+00),
+  fixed(-1.04355150394781381884e+00),
+  fixed(-1.04307538898679164063e+00),
+  fixed(-1.04260216050238740948e+00),
+  fixed(-1.04213181234212126647e+00),
+  fixed(-1.04166433839749372758e+00),
+  fixed(-1.04119973260378340107e+00),
+  fixed(-1.04073798893984825753e+00),
+  fixed(-1.04027910142792512360e+00),
+  fixed(-1.03982306413343561502e+00),
+  fixed(-1.03936987116478940507e+00),
+  fixed(-1.03891951667319171193e+00),
+  fixed(-1.03847199485245189621e+00),
+  fixed(-1.03802729993879361281e+00),
+  fixed(-1.03758542621066562894e+00),
+  fixed(-1.03714636798855730504e+00),
+  fixed(-1.03671011963481185525e+00),
+  fixed(-1.03627667555344316064e+00),
+  fixed(-1.03584603018995569101e+00),
+  fixed(-1.03541817803116220631e+00),
+  fixed(-1.03499311360500700907e+00),
+  fixed(-1.03457083148038830878e+00),
+  fixed(-1.03415132626698236251e+00),
+  fixed(-1.03373459261507050222e+00),
+  fixed(-1.03332062521536660604e+00),
+  fixed(-1.03290941879884567989e+00),
+  fixed(-1.03250096813657599171e+00),
+  fixed(-1.03209526803954987351e+00),
+  fixed(-1.03169231335851852016e+00),
+  fixed(-1.03129209898382634414e+00),
+  fixed(-1.03089461984524910498e+00),
+  fixed(-1.03049987091183070653e+00),
+  fixed(-1.03010784719172376889e+00),
+  fixed(-1.02971854373202997834e+00),
+  fixed(-1.02933195561864354595e+00),
+  fixed(-1.02894807797609466604e+00),
+  fixed(-1.02856690596739497323e+00),
+  fixed(-1.02818843479388433160e+00),
+  fixed(-1.02781265969507917823e+00),
+  fixed(-1.02743957594852242110e+00),
+  fixed(-1.02706917886963378095e+00),
+  fixed(-1.02670146381156235371e+00),
+  fixed(-1.02633642616504117129e+00),
+  fixed(-1.02597406135824131823e+00),
+  fixed(-1.02561436485662826890e+00),
+  fixed(-1.02525733216282088911e+00),
+  fixed(-1.02490295881644954967e+00),
+  fixed(-1.02455124039401623826e+00),
+  fixed(-1.02420217250875800197e+00),
+  fixed(-1.02385575081050794743e+00),
+  fixed(-1.02351197098556090381e+00),
+  fixed(-1.02317082875653908580e+00),
+  fixed(-1.02283231988225797870e+00),
+  fixed(-1.02249644015759577620e+00),
+  fixed(-1.02216318541336259607e+00),
+  fixed(-1.02183255151616991796e+00),
+  fixed(-1.02150453436830446208e+00),
+  fixed(-1.02117912990760073555e+00),
+  fixed(-1.02085633410731468906e+00),
+  fixed(-1.02053614297600026006e+00),
+  fixed(-1.02021855255738636004e+00),
+  fixed(-1.01990355893025452794e+00),
+  fixed(-1.01959115820831835997e+00),
+  fixed(-1.01928134654010449367e+00),
+  fixed(-1.01897412010883359201e+00),
+  fixed(-1.01866947513230421407e+00),
+  fixed(-1.01836740786277601956e+00),
+  fixed(-1.01806791458685541585e+00),
+  fixed(-1.01777099162538187116e+00),
+  fixed(-1.01747663533331644814e+00),
+  fixed(-1.01718484209962856113e+00),
+  fixed(-1.01689560834718761839e+00),
+  fixed(-1.01660893053265377617e+00),
+  fixed(-1.01632480514636935887e+00),
+  fixed(-1.01604322871225272173e+00),
+  fixed(-1.01576419778769300173e+00),
+  fixed(-1.01548770896344442427e+00),
+  fixed(-1.01521375886352438478e+00),
+  fixed(-1.01494234414511064202e+00),
+  fixed(-1.01467346149843939962e+00),
+  fixed(-1.01440710764670694033e+00),
+  fixed(-1.01414327934596837366e+00),
+  fixed(-1.01388197338504260081e+00),
+  fixed(-1.01362318658541217253e+00),
+  fixed(-1.01336691580113069655e+00),
+  fixed(-1.01311315791872647019e+00),
+  fixed(-1.01286190985710833345e+00),
+  fixed(-1.01261316856747485282e+00),
+  fixed(-1.01236693103322106246e+00),
+  fixed(-1.01212319426984942439e+00),
+  fixed(-1.01188195532487923423e+00),
+  fixed(-1.01164321127775891362e+00),
+  fixed(-1.01140695923977852466e+00),
+  fixed(-1.01117319635398295041e+00),
+  fixed(-1.01094191979508729595e+00),
+  fixed(-1.01071312676939184527e+00),
+  fixed(-1.01048681451469946069e+00),
+  fixed(-1.01026298030023209407e+00),
+  fixed(-1.01004162142655129486e+00),
+  fixed(-1.00982273522547605360e+00),
+  fixed(-1.00960631906000442015e+00),
+  fixed(-1.00939237032423534401e+00),
+  fixed(-1.00918088644329073666e+00),
+  fixed(-1.00897186487323908821e+00),
+  fixed(-1.00876530310102063837e+00),
+  fixed(-1.00856119864437232536e+00),
+  fixed(-1.00835954905175473328e+00),
+  fixed(-1.00816035190227926144e+00),
+  fixed(-1.00796360480563684803e+00),
+  fixed(-1.00776930540202713793e+00),
+  fixed(-1.00757745136208853864e+00),
+  fixed(-1.00738804038683049669e+00),
+  fixed(-1.00720107020756444172e+00),
+  fixed(-1.00701653858583806134e+00),
+  fixed(-1.00683444331336846567e+00),
+  fixed(-1.00665478221197823849e+00),
+  fixed(-1.00647755313353015616e+00),
+  fixed(-1.00630275395986523712e+00),
+  fixed(-1.00613038260273945923e+00),
+  fixed(-1.00596043700376358565e+00),
+  fixed(-1.00579291513434165850e+00),
+  fixed(-1.00562781499561260112e+00),
+  fixed(-1.00546513461839071013e+00),
+  fixed(-1.00530487206310836790e+00),
+  fixed(-1.00514702541975964323e+00),
+  fixed(-1.00499159280784411408e+00),
+  fixed(-1.00483857237631157844e+00),
+  fixed(-1.00468796230350809751e+00),
+  fixed(-1.00453976079712337111e+00),
+  fixed(-1.00439396609413811312e+00),
+  fixed(-1.00425057646077209306e+00),
+  fixed(-1.00410959019243439805e+00),
+  fixed(-1.00397100561367280669e+00),
+  fixed(-1.00383482107812627149e+00),
+  fixed(-1.00370103496847584701e+00),
+  fixed(-1.00356964569639806051e+00),
+  fixed(-1.00344065170251850461e+00),
+  fixed(-1.00331405145636720633e+00),
+  fixed(-1.00318984345633355204e+00),
+  fixed(-1.00306802622962187854e+00),
+  fixed(-1.00294859833221083889e+00),
+  fixed(-1.00283155834880943758e+00),
+  fixed(-1.00271690489281684044e+00),
+  fixed(-1.00260463660628218463e+00),
+  fixed(-1.00249475215986549870e+00),
+  fixed(-1.00238725025279817871e+00),
+  fixed(-1.00228212961284612881e+00),
+  fixed(-1.00217938899627312388e+00),
+  fixed(-1.00207902718780395013e+00),
+  fixed(-1.00198104300058998817e+00),
+  fixed(-1.00188543527617457407e+00),
+  fixed(-1.00179220288445947062e+00),
+  fixed(-1.00170134472367222678e+00),
+  fixed(-1.00161285972033464731e+00),
+  fixed(-1.00152674682923126248e+00),
+  fixed(-1.00144300503337979613e+00),
+  fixed(-1.00136163334400118963e+00),
+  fixed(-1.00128263080049095812e+00),
+  fixed(-1.00120599647039254521e+00),
+  fixed(-1.00113172944936956732e+00),
+  fixed(-1.00105982886117916841e+00),
+  fixed(-1.00099029385764870526e+00),
+  fixed(-1.00092312361864910208e+00),
+  fixed(-1.00085831735207242410e+00),
+  fixed(-1.00079587429380922892e+00),
+  fixed(-1.00073579370772569597e+00),
+  fixed(-1.00067807488564319840e+00),
+  fixed(-1.00062271714731787497e+00),
+  fixed(-1.00056971984041997992e+00),
+  fixed(-1.00051908234051700752e+00),
+  fixed(-1.00047080405105370815e+00),
+  fixed(-1.00042488440333654509e+00),
+  fixed(-1.00038132285651637510e+00),
+  fixed(-1.00034011889757334934e+00),
+  fixed(-1.00030127204130203644e+00),
+  fixed(-1.00026478183029721158e+00),
+  fixed(-1.00023064783494120000e+00),
+  fixed(-1.00019886965339122042e+00),
+  fixed(-1.00016944691156806080e+00),
+  fixed(-1.00014237926314475402e+00),
+  fixed(-1.00011766638953769615e+00),
+  fixed(-1.00009530799989643235e+00),
+  fixed(-1.00007530383109544125e+00),
+  fixed(-1.00005765364772747361e+00),
+  fixed(-1.00004235724209600278e+00),
+  fixed(-1.00002941443420945156e+00),
+  fixed(-1.00001882507177564108e+00),
+  fixed(-1.00001058903019801605e+00),
+  fixed(-1.00000470621257209203e+00),
+  fixed(-1.00000117654968234682e+00),
+  fixed(-1.00000000000000000000e+00),
+  fixed(-1.00000117654968234682e+00),
+  fixed(-1.00000470621257209203e+00),
+  fixed(-1.00001058903019801605e+00),
+  fixed(-1.00001882507177564108e+00),
+  fixed(-1.00002941443420945156e+00),
+  fixed(-1.00004235724209600278e+00),
+  fixed(-1.00005765364772747361e+00),
+  fixed(-1.00007530383109544125e+00),
+  fixed(-1.00009530799989621030e+00),
+  fixed(-1.00011766638953769615e+00),
+  fixed(-1.00014237926314475402e+00),
+  fixed(-1.00016944691156806080e+00),
+  fixed(-1.00019886965339122042e+00),
+  fixed(-1.00023064783494120000e+00),
+  fixed(-1.00026478183029721158e+00),
+  fixed(-1.00030127204130203644e+00),
+  fixed(-1.00034011889757334934e+00),
+  fixed(-1.00038132285651637510e+00),
+  fixed(-1.00042488440333654509e+00),
+  fixed(-1.00047080405105370815e+00),
+  fixed(-1.00051908234051700752e+00),
+  fixed(-1.00056971984041997992e+00),
+  fixed(-1.00062271714731787497e+00),
+  fixed(-1.00067807488564319840e+00),
+  fixed(-1.00073579370772569597e+00),
+  fixed(-1.00079587429380922892e+00),
+  fixed(-1.00085831735207242410e+00),
+  fixed(-1.00092312361864910208e+00),
+  fixed(-1.00099029385764870526e+00),
+  fixed(-1.00105982886117916841e+00),
+  fixed(-1.00113172944936956732e+00),
+  fixed(-1.00120599647039254521e+00),
+  fixed(-1.00128263080049095812e+00),
+  fixed(-1.00136163334400096758e+00),
+  fixed(-1.00144300503337979613e+00),
+  fixed(-1.00152674682923126248e+00),
+  fixed(-1.00161285972033464731e+00),
+  fixed(-1.00170134472367222678e+00),
+  fixed(-1.00179220288445947062e+00),
+  fixed(-1.00188543527617457407e+00),
+  fixed(-1.00198104300058998817e+00),
+  fixed(-1.00207902718780395013e+00),
+  fixed(-1.00217938899627312388e+00),
+  fixed(-1.00228212961284612881e+00),
+  fixed(-1.00238725025279817871e+00),
+  fixed(-1.00249475215986549870e+00),
+  fixed(-1.00260463660628218463e+00),
+  fixed(-1.00271690489281684044e+00),
+  fixed(-1.00283155834880921553e+00),
+  fixed(-1.00294859833221083889e+00),
+  fixed(-1.00306802622962187854e+00),
+  fixed(-1.00318984345633333000e+00),
+  fixed(-1.00331405145636720633e+00),
+  fixed(-1.00344065170251850461e+00),
+  fixed(-1.00356964569639806051e+00),
+  fixed(-1.00370103496847584701e+00),
+  fixed(-1.00383482107812627149e+00),
+  fixed(-1.00397100561367280669e+00),
+  fixed(-1.00410959019243439805e+00),
+  fixed(-1.00425057646077209306e+00),
+  fixed(-1.00439396609413811312e+00),
+  fixed(-1.00453976079712337111e+00),
+  fixed(-1.00468796230350809751e+00),
+  fixed(-1.00483857237631135639e+00),
+  fixed(-1.00499159280784411408e+00),
+  fixed(-1.00514702541975964323e+00),
+  fixed(-1.00530487206310836790e+00),
+  fixed(-1.00546513461839048809e+00),
+  fixed(-1.00562781499561260112e+00),
+  fixed(-1.00579291513434165850e+00),
+  fixed(-1.00596043700376358565e+00),
+  fixed(-1.00613038260273945923e+00),
+  fixed(-1.00630275395986501508e+00),
+  fixed(-1.00647755313353015616e+00),
+  fixed(-1.00665478221197823849e+00),
+  fixed(-1.00683444331336846567e+00),
+  fixed(-1.00701653858583806134e+00),
+  fixed(-1.00720107020756444172e+00),
+  fixed(-1.00738804038683049669e+00),
+  fixed(-1.00757745136208853864e+00),
+  fixed(-1.00776930540202713793e+00),
+  fixed(-1.00796360480563684803e+00),
+  fixed(-1.00816035190227926144e+00),
+  fixed(-1.00835954905175473328e+00),
+  fixed(-1.00856119864437232536e+00),
+  fixed(-1.00876530310102063837e+00),
+  fixed(-1.00897186487323908821e+00),
+  fixed(-1.00918088644329073666e+00),
+  fixed(-1.00939237032423534401e+00),
+  fixed(-1.00960631906000442015e+00),
+  fixed(-1.00982273522547605360e+00),
+  fixed(-1.01004162142655129486e+00),
+  fixed(-1.01026298030023209407e+00),
+  fixed(-1.01048681451469923864e+00),
+  fixed(-1.01071312676939184527e+00),
+  fixed(-1.01094191979508729595e+00),
+  fixed(-1.01117319635398295041e+00),
+  fixed(-1.01140695923977852466e+00),
+  fixed(-1.01164321127775891362e+00),
+  fixed(-1.01188195532487923423e+00),
+  fixed(-1.01212319426984920234e+00),
+  fixed(-1.01236693103322106246e+00),
+  fixed(-1.01261316856747485282e+00),
+  fixed(-1.01286190985710833345e+00),
+  fixed(-1.01311315791872647019e+00),
+  fixed(-1.01336691580113069655e+00),
+  fixed(-1.01362318658541217253e+00),
+  fixed(-1.01388197338504237877e+00),
+  fixed(-1.01414327934596837366e+00),
+  fixed(-1.01440710764670671828e+00),
+  fixed(-1.01467346149843939962e+00),
+  fixed(-1.01494234414511041997e+00),
+  fixed(-1.01521375886352438478e+00),
+  fixed(-1.01548770896344442427e+00),
+  fixed(-1.01576419778769300173e+00),
+  fixed(-1.01604322871225272173e+00),
+  fixed(-1.01632480514636935887e+00),
+  fixed(-1.01660893053265377617e+00),
+  fixed(-1.01689560834718761839e+00),
+  fixed(-1.01718484209962833908e+00),
+  fixed(-1.01747663533331622610e+00),
+  fixed(-1.01777099162538187116e+00),
+  fixed(-1.01806791458685519380e+00),
+  fixed(-1.01836740786277601956e+00),
+  fixed(-1.01866947513230421407e+00),
+  fixed(-1.01897412010883359201e+00),
+  fixed(-1.01928134654010427163e+00),
+  fixed(-1.01959115820831835997e+00),
+  fixed(-1.01990355893025452794e+00),
+  fixed(-1.02021855255738636004e+00),
+  fixed(-1.02053614297600026006e+00),
+  fixed(-1.02085633410731468906e+00),
+  fixed(-1.02117912990760073555e+00),
+  fixed(-1.02150453436830446208e+00),
+  fixed(-1.02183255151616969592e+00),
+  fixed(-1.02216318541336237402e+00),
+  fixed(-1.02249644015759577620e+00),
+  fixed(-1.02283231988225797870e+00),
+  fixed(-1.02317082875653908580e+00),
+  fixed(-1.02351197098556090381e+00),
+  fixed(-1.02385575081050794743e+00),
+  fixed(-1.02420217250875777992e+00),
+  fixed(-1.02455124039401623826e+00),
+  fixed(-1.02490295881644932763e+00),
+  fixed(-1.02525733216282088911e+00),
+  fixed(-1.02561436485662826890e+00),
+  fixed(-1.02597406135824131823e+00),
+  fixed(-1.02633642616504117129e+00),
+  fixed(-1.02670146381156235371e+00),
+  fixed(-1.02706917886963378095e+00),
+  fixed(-1.02743957594852242110e+00),
+  fixed(-1.02781265969507917823e+00),
+  fixed(-1.02818843479388410955e+00),
+  fixed(-1.02856690596739475119e+00),
+  fixed(-1.02894807797609466604e+00),
+  fixed(-1.02933195561864332390e+00),
+  fixed(-1.02971854373202975630e+00),
+  fixed(-1.03010784719172376889e+00),
+  fixed(-1.03049987091183070653e+00),
+  fixed(-1.03089461984524910498e+00),
+  fixed(-1.03129209898382634414e+00),
+  fixed(-1.03169231335851829812e+00),
+  fixed(-1.03209526803954987351e+00),
+  fixed(-1.03250096813657599171e+00),
+  fixed(-1.03290941879884567989e+00),
+  fixed(-1.03332062521536638400e+00),
+  fixed(-1.03373459261507028017e+00),
+  fixed(-1.03415132626698214047e+00),
+  fixed(-1.03457083148038808673e+00),
+  fixed(-1.03499311360500700907e+00),
+  fixed(-1.03541817803116198426e+00),
+  fixed(-1.03584603018995546897e+00),
+  fixed(-1.03627667555344293859e+00),
+  fixed(-1.03671011963481163320e+00),
+  fixed(-1.03714636798855730504e+00),
+  fixed(-1.03758542621066562894e+00),
+  fixed(-1.03802729993879339077e+00),
+  fixed(-1.03847199485245189621e+00),
+  fixed(-1.03891951667319171193e+00),
+  fixed(-1.03936987116478940507e+00),
+  fixed(-1.03982306413343561502e+00),
+  fixed(-1.04027910142792512360e+00),
+  fixed(-1.04073798893984825753e+00),
+  fixed(-1.04119973260378340107e+00),
+  fixed(-1.04166433839749350554e+00),
+  fixed(-1.04213181234212104442e+00),
+  fixed(-1.04260216050238718744e+00),
+  fixed(-1.04307538898679164063e+00),
+  fixed(-1.04355150394781359680e+00),
+  fixed(-1.04403051158211779281e+00),
+  fixed(-1.04451241813075612619e+00),
+  fixed(-1.04499722987937770924e+00),
+  fixed(-1.04548495315843670284e+00),
+  fixed(-1.04597559434340237061e+00),
+  fixed(-1.04646915985497268586e+00),
+  fixed(-1.04696565615928771642e+00),
+  fixed(-1.04746508976814678427e+00),
+  fixed(-1.04796746723922518107e+00),
+  fixed(-1.04847279517629554668e+00),
+  fixed(-1.04898108022944791529e+00),
+  fixed(-1.04949232909531553481e+00),
+  fixed(-1.05000654851729890993e+00),
+  fixed(-1.05052374528579339774e+00),
+  fixed(-1.05104392623841991217e+00),
+  fixed(-1.05156709826025518417e+00),
+  fixed(-1.05209326828406513066e+00),
+  fixed(-1.05262244329054222014e+00),
+  fixed(-1.05315463030853972981e+00),
+  fixed(-1.05368983641531444029e+00),
+  fixed(-1.05422806873676599970e+00),
+  fixed(-1.05476933444768072867e+00),
+  fixed(-1.05531364077197897799e+00),
+  fixed(-1.05586099498296070998e+00),
+  fixed(-1.05641140440355596475e+00),
+  fixed(-1.05696487640657776907e+00),
+  fixed(-1.05752141841497526720e+00),
+  fixed(-1.05808103790209018236e+00),
+  fixed(-1.05864374239191572080e+00),
+  fixed(-1.05920953945935591989e+00),
+  fixed(-1.05977843673049054729e+00),
+  fixed(-1.06035044188283800182e+00),
+  fixed(-1.06092556264562398738e+00),
+  fixed(-1.06150380680005063105e+00),
+  fixed(-1.06208518217956826568e+00),
+  fixed(-1.06266969667014987699e+00),
+  fixed(-1.06325735821056732711e+00),
+  fixed(-1.06384817479267046458e+00),
+  fixed(-1.06444215446166690064e+00),
+  fixed(-1.06503930531640822466e+00),
+  fixed(-1.06563963550967333305e+00),
+  fixed(-1.06624315324845841957e+00),
+  fixed(-1.06684986679426652145e+00),
+  fixed(-1.06745978446340195056e+00),
+  fixed(-1.06807291462726516862e+00),
+  fixed(-1.06868926571265121517e+00),
+  fixed(-1.06930884620205057800e+00),
+  fixed(-1.06993166463395272814e+00),
+  fixed(-1.07055772960315076503e+00),
+  fixed(-1.07118704976105094673e+00),
+  fixed(-1.07181963381598399643e+00),
+  fixed(-1.07245549053351729718e+00),
+  fixed(-1.07309462873677241568e+00),
+  fixed(-1.07373705730674329217e+00),
+  fixed(-1.07438278518261798311e+00),
+  fixed(-1.07503182136210417852e+00),
+  fixed(-1.07568417490175427531e+00),
+  fixed(-1.07633985491729644579e+00),
+  fixed(-1.07699887058396792661e+00),
+  fixed(-1.07766123113684875179e+00),
+  fixed(-1.07832694587120059282e+00),
+  fixed(-1.07899602414280937346e+00),
+  fixed(-1.07966847536832721843e+00),
+  fixed(-1.08034430902562061938e+00),
+  fixed(-1.08102353465411971101e+00),
+  fixed(-1.08170616185517087793e+00),
+  fixed(-1.08239220029239380239e+00),
+  fixed(-1.08308165969203895607e+00),
+  fixed(-1.08377454984334953281e+00),
+  fixed(-1.08447088059892715606e+00),
+  fixed(-1.08517066187509936270e+00),
+  fixed(-1.08587390365229019551e+00),
+  fixed(-1.08658061597539568055e+00),
+  fixed(-1.08729080895415974872e+00),
+  fixed(-1.08800449276355659656e+00),
+  fixed(-1.08872167764417215885e+00),
+  fixed(-1.08944237390259401899e+00),
+  fixed(-1.09016659191179932087e+00),
+  fixed(-1.09089434211155000831e+00),
+  fixed(-1.09162563500878873057e+00),
+  fixed(-1.09236048117804096513e+00),
+  fixed(-1.09309889126181625230e+00),
+  fixed(-1.09384087597101764544e+00),
+  fixed(-1.09458644608535182741e+00),
+  fixed(-1.09533561245374255755e+00),
+  fixed(-1.09608838599474966990e+00),
+  fixed(-1.09684477769698940364e+00),
+  fixed(-1.09760479861955873027e+00),
+  fixed(-1.09836845989246612021e+00),
+  fixed(-1.09913577271706119909e+00),
+  fixed(-1.09990674836647173152e+00),
+  fixed(-1.10068139818604393554e+00),
+  fixed(-1.10145973359378412937e+00),
+  fixed(-1.10224176608080659534e+00),
+  fixed(-1.10302750721178588478e+00),
+  fixed(-1.10381696862540912285e+00),
+  fixed(-1.10461016203483697318e+00),
+  fixed(-1.10540709922816438038e+00),
+  fixed(-1.10620779206888886215e+00),
+  fixed(-1.10701225249638035564e+00),
+  fixed(-1.10782049252635572678e+00),
+  fixed(-1.10863252425135772050e+00),
+  fixed(-1.10944835984123790773e+00),
+  fixed(-1.11026801154364385127e+00),
+  fixed(-1.11109149168450960232e+00),
+  fixed(-1.11191881266855241428e+00),
+  fixed(-1.11274998697977101081e+00),
+  fixed(-1.11358502718195140346e+00),
+  fixed(-1.11442394591917337543e+00),
+  fixed(-1.11526675591632429274e+00),
+  fixed(-1.11611346997961691230e+00),
+  fixed(-1.11696410099711007646e+00),
+  fixed(-1.11781866193923473674e+00),
+  fixed(-1.11867716585932708284e+00),
+  fixed(-1.11953962589416033957e+00),
+  fixed(-1.12040605526448810991e+00),
+  fixed(-1.12127646727558749618e+00),
+  fixed(-1.12215087531780888241e+00),
+  fixed(-1.12302929286713082391e+00),
+  fixed(-1.12391173348571804524e+00),
+  fixed(-1.12479821082248632180e+00),
+  fixed(-1.12568873861367202416e+00),
+  fixed(-1.12658333068340454908e+00),
+  fixed(-1.12748200094428563389e+00),
+  fixed(-1.12838476339797555426e+00),
+  fixed(-1.12929163213577865577e+00),
+  fixed(-1.13020262133924043191e+00),
+  fixed(-1.13111774528074660040e+00),
+  fixed(-1.13203701832412573225e+00),
+  fixed(-1.13296045492526387122e+00),
+  fixed(-1.13388806963271537853e+00),
+  fixed(-1.13481987708832599004e+00),
+  fixed(-1.13575589202786009224e+00),
+  fixed(-1.13669612928163110688e+00),
+  fixed(-1.13764060377513898104e+00),
+  fixed(-1.13858933052971589284e+00),
+  fixed(-1.13954232466317151307e+00),
+  fixed(-1.14049960139045003515e+00),
+  fixed(-1.14146117602429075788e+00),
+  fixed(-1.14242706397589244283e+00),
+  fixed(-1.14339728075558832998e+00),
+  fixed(-1.14437184197352204151e+00),
+  fixed(-1.14535076334033281142e+00),
+  fixed(-1.14633406066784626631e+00),
+  fixed(-1.14732174986977053521e+00),
+  fixed(-1.14831384696239879872e+00),
+  fixed(-1.14931036806532005379e+00),
+  fixed(-1.15031132940213187688e+00),
+  fixed(-1.15131674730116406735e+00),
+  fixed(-1.15232663819620761991e+00),
+  fixed(-1.15334101862724769383e+00),
+  fixed(-1.15435990524120768441e+00),
+  fixed(-1.15538331479269462676e+00),
+  fixed(-1.15641126414475592377e+00),
+  fixed(-1.15744377026964162525e+00),
+  fixed(-1.15848085024957137001e+00),
+  fixed(-1.15952252127751176403e+00),
+  fixed(-1.16056880065795819945e+00),
+  fixed(-1.16161970580772488937e+00),
+  fixed(-1.16267525425674134176e+00),
+  fixed(-1.16373546364885793736e+00),
+  fixed(-1.16480035174265594833e+00),
+  fixed(-1.16586993641226777108e+00),
+  fixed(-1.16694423564820204398e+00),
+  fixed(-1.16802326755817875714e+00),
+  fixed(-1.16910705036797146761e+00),
+  fixed(-1.17019560242225462154e+00),
+  fixed(-1.17128894218546175665e+00),
+  fixed(-1.17238708824265169817e+00),
+  fixed(-1.17349005930037963985e+00),
+  fixed(-1.17459787418757843902e+00),
+  fixed(-1.17571055185645012564e+00),
+  fixed(-1.17682811138335918777e+00),
+  fixed(-1.17795057196974251035e+00),
+  fixed(-1.17907795294301998013e+00),
+  fixed(-1.18021027375751863531e+00),
+  fixed(-1.18134755399540436471e+00),
+  fixed(-1.18248981336761938010e+00),
+  fixed(-1.18363707171483301117e+00),
+  fixed(-1.18478934900839782962e+00),
+  fixed(-1.18594666535131598728e+00),
+  fixed(-1.18710904097921443601e+00),
+  fixed(-1.18827649626132969551e+00),
+  fixed(-1.18944905170150061480e+00),
+  fixed(-1.19062672793917267988e+00),
+  fixed(-1.19180954575040920496e+00),
+  fixed(-1.19299752604891229346e+00),
+  fixed(-1.19419068988705756595e+00),
+  fixed(-1.19538905845693155250e+00),
+  fixed(-1.19659265309138462818e+00),
+  fixed(-1.19780149526509238633e+00),
+  fixed(-1.19901560659562544942e+00),
+  fixed(-1.20023500884453060422e+00),
+  fixed(-1.20145972391842414950e+00),
+  fixed(-1.20268977387009035063e+00),
+  fixed(-1.20392518089959699168e+00),
+  fixed(-1.20516596735541625662e+00),
+  fixed(-1.20641215573555782292e+00),
+  fixed(-1.20766376868871638806e+00),
+  fixed(-1.20892082901542252671e+00),
+  fixed(-1.21018335966921286584e+00),
+  fixed(-1.21145138375780625495e+00),
+  fixed(-1.21272492454429192676e+00),
+  fixed(-1.21400400544833075855e+00),
+  fixed(-1.21528865004736807975e+00),
+  fixed(-1.21657888207785513934e+00),
+  fixed(-1.21787472543648611634e+00),
+  fixed(-1.21917620418144556638e+00),
+  fixed(-1.22048334253366674851e+00),
+  fixed(-1.22179616487810505099e+00),
+  fixed(-1.22311469576501985479e+00),
+  fixed(-1.22443895991127349454e+00),
+  fixed(-1.22576898220163910125e+00),
+  fixed(-1.22710478769012243383e+00),
+  fixed(-1.22844640160129769946e+00),
+  fixed(-1.22979384933165536431e+00),
+  fixed(-1.23114715645096239882e+00),
+  fixed(-1.23250634870363784401e+00),
+  fixed(-1.23387145201014125639e+00),
+  fixed(-1.23524249246837247718e+00),
+  fixed(-1.23661949635509094136e+00),
+  fixed(-1.23800249012734053800e+00),
+  fixed(-1.23939150042389689688e+00),
+  fixed(-1.24078655406672444528e+00),
+  fixed(-1.24218767806244856367e+00),
+  fixed(-1.24359489960384195228e+00),
+  fixed(-1.24500824607132964950e+00),
+  fixed(-1.24642774503450159962e+00),
+  fixed(-1.24785342425364786934e+00),
+  fixed(-1.24928531168130563245e+00),
+  fixed(-1.25072343546381992141e+00),
+  fixed(-1.25216782394292591718e+00),
+  fixed(-1.25361850565733878859e+00),
+  fixed(-1.25507550934436795664e+00),
+  fixed(-1.25653886394154223893e+00),
+  fixed(-1.25800859858825209159e+00),
+  fixed(-1.25948474262741072494e+00),
+  fixed(-1.26096732560713076232e+00),
+  fixed(-1.26245637728241599795e+00),
+  fixed(-1.26395192761687291672e+00),
+  fixed(-1.26545400678444086573e+00),
+  fixed(-1.26696264517113332815e+00),
+  fixed(-1.26847787337680628639e+00),
+  fixed(-1.26999972221693591123e+00),
+  fixed(-1.27152822272442000973e+00),
+  fixed(-1.27306340615139768069e+00),
+  fixed(-1.27460530397108229295e+00),
+  fixed(-1.27615394787962088685e+00),
+  fixed(-1.27770936979796845279e+00),
+  fixed(-1.27927160187378041734e+00),
+  fixed(-1.28084067648332755596e+00),
+  fixed(-1.28241662623343066763e+00),
+  fixed(-1.28399948396341234691e+00),
+  fixed(-1.28558928274707318096e+00),
+  fixed(-1.28718605589468304551e+00),
+  fixed(-1.28878983695499993445e+00),
+  fixed(-1.29040065971730455452e+00),
+  fixed(-1.29201855821345779063e+00),
+  fixed(-1.29364356671997993153e+00),
+  fixed(-1.29527571976015343225e+00),
+  fixed(-1.29691505210614299592e+00),
+  fixed(-1.29856159878114230111e+00),
+  fixed(-1.30021539506154470978e+00),
+  fixed(-1.30187647647912863036e+00),
+  fixed(-1.30354487882327729764e+00),
+  fixed(-1.30522063814321231945e+00),
+  fixed(-1.30690379075025631117e+00),
+  fixed(-1.30859437322011951110e+00),
+  fixed(-1.31029242239520726798e+00),
+  fixed(-1.31199797538695528409e+00),
+  fixed(-1.31371106957819083760e+00),
+  fixed(-1.31543174262551332276e+00),
+  fixed(-1.31716003246170698660e+00),
+  fixed(-1.31889597729817764638e+00),
+  fixed(-1.32063961562741183364e+00),
+  fixed(-1.32239098622546924489e+00),
+  fixed(-1.32415012815449517625e+00),
+  fixed(-1.32591708076526360038e+00),
+  fixed(-1.32769188369975110753e+00),
+  fixed(-1.32947457689373060852e+00),
+  fixed(-1.33126520057939945474e+00),
+  fixed(-1.33306379528803664591e+00),
+  fixed(-1.33487040185268290848e+00),
+  fixed(-1.33668506141085674521e+00),
+  fixed(-1.33850781540729868446e+00),
+  fixed(-1.34033870559674017642e+00),
+  fixed(-1.34217777404671245733e+00),
+  fixed(-1.34402506314037628599e+00),
+  fixed(-1.34588061557939009383e+00),
+  fixed(-1.34774447438680944344e+00),
+  fixed(-1.34961668291001135600e+00),
+  fixed(-1.35149728482366060511e+00),
+  fixed(-1.35338632413270310018e+00),
+  fixed(-1.35528384517539390863e+00),
+  fixed(-1.35718989262635880699e+00),
+  fixed(-1.35910451149969224716e+00),
+  fixed(-1.36102774715208507672e+00),
+  fixed(-1.36295964528599400367e+00),
+  fixed(-1.36490025195283903869e+00),
+  fixed(-1.36684961355624312596e+00),
+  fixed(-1.36880777685530774512e+00),
+  fixed(-1.37077478896791915552e+00),
+  fixed(-1.37275069737409993742e+00),
+  fixed(-1.37473554991939517222e+00),
+  fixed(-1.37672939481829548214e+00),
+  fixed(-1.37873228065770048190e+00),
+  fixed(-1.38074425640042464103e+00),
+  fixed(-1.38276537138873645283e+00),
+  fixed(-1.38479567534794534289e+00),
+  fixed(-1.38683521839002343867e+00),
+  fixed(-1.38888405101727241409e+00),
+  fixed(-1.39094222412603496508e+00),
+  fixed(-1.39300978901044025804e+00),
+  fixed(-1.39508679736620222478e+00),
+  fixed(-1.39717330129445804765e+00),
+  fixed(-1.39926935330564838900e+00),
+  fixed(-1.40137500632344558227e+00),
+  fixed(-1.40349031368873067294e+00),
+  fixed(-1.40561532916360643064e+00),
+  fixed(-1.40775010693547186769e+00),
+  fixed(-1.40989470162112984220e+00),
+  fixed(-1.41204916827095283693e+00),
+  fixed(-1.41421356237309470139e+00),
+  fixed(-1.41638793985774968931e+00),
+  fixed(-1.41857235710146323271e+00),
+  fixed(-1.42076687093149778285e+00),
+  fixed(-1.42297153863024150589e+00),
+  fixed(-1.42518641793967670850e+00),
+  fixed(-1.42741156706590022196e+00),
+  fixed(-1.42964704468369241397e+00),
+  fixed(-1.43189290994114903910e+00),
+  fixed(-1.43414922246435949660e+00),
+  fixed(-1.43641604236214748269e+00),
+  fixed(-1.43869343023086915245e+00),
+  fixed(-1.44098144715926079762e+00),
+  fixed(-1.44328015473335402596e+00),
+  fixed(-1.44558961504144734000e+00),
+  fixed(-1.44790989067913433708e+00),
+  fixed(-1.45024104475439674644e+00),
+  fixed(-1.45258314089276052705e+00),
+  fixed(-1.45493624324250769853e+00),
+  fixed(-1.45730041647996189091e+00),
+  fixed(-1.45967572581482674110e+00),
+  fixed(-1.46206223699560000640e+00),
+  fixed(-1.46446001631505029472e+00),
+  fixed(-1.46686913061575729955e+00),
+  fixed(-1.46928964729572508752e+00),
+  fixed(-1.47172163431406488598e+00),
+  fixed(-1.47416516019674337379e+00),
+  fixed(-1.47662029404240624508e+00),
+  fixed(-1.47908710552827460383e+00),
+  fixed(-1.48156566491611019210e+00),
+  fixed(-1.48405604305826033240e+00),
+  fixed(-1.48655831140377414634e+00),
+  fixed(-1.48907254200459626681e+00),
+  fixed(-1.49159880752184359487e+00),
+  fixed(-1.49413718123214955824e+00),
+  fixed(-1.49668773703409985210e+00),
+  fixed(-1.49925054945474367507e+00),
+  fixed(-1.50182569365618689972e+00),
+  fixed(-1.50441324544226961990e+00),
+  fixed(-1.50701328126533296015e+00),
+  fixed(-1.50962587823306182422e+00),
+  fixed(-1.51225111411542734174e+00),
+  fixed(-1.51488906735170658635e+00),
+  fixed(-1.51753981705759888321e+00),
+  fixed(-1.52020344303243493123e+00),
+  fixed(-1.52288002576647074626e+00),
+  fixed(-1.52556964644828330080e+00),
+  fixed(-1.52827238697225920028e+00),
+  fixed(-1.53098832994617750636e+00),
+  fixed(-1.53371755869889647705e+00),
+  fixed(-1.53646015728813378765e+00),
+  fixed(-1.53921621050835355504e+00),
+  fixed(-1.54198580389875306018e+00),
+  fixed(-1.54476902375135383139e+00),
+  fixed(-1.54756595711920774683e+00),
+  fixed(-1.55037669182469062257e+00),
+  fixed(-1.55320131646792591873e+00),
+  fixed(-1.55603992043531036416e+00),
+  fixed(-1.55889259390814993722e+00),
+  fixed(-1.56175942787142130186e+00),
+  fixed(-1.56464051412263183138e+00),
+  fixed(-1.56753594528081396930e+00),
+  fixed(-1.57044581479563283288e+00),
+  fixed(-1.57337021695661438692e+00),
+  fixed(-1.57630924690249929476e+00),
+  fixed(-1.57926300063072755364e+00),
+  fixed(-1.58223157500703548450e+00),
+  fixed(-1.58521506777519949338e+00),
+  fixed(-1.58821357756690240137e+00),
+  fixed(-1.59122720391173211318e+00),
+  fixed(-1.59425604724732927764e+00),
+  fixed(-1.59730020892964930113e+00),
+  fixed(-1.60035979124338822999e+00),
+  fixed(-1.60343489741253675263e+00),
+  fixed(-1.60652563161108496992e+00),
+  fixed(-1.60963209897387038438e+00),
+  fixed(-1.61275440560758442921e+00),
+  fixed(-1.61589265860191311219e+00),
+  fixed(-1.61904696604084974432e+00),
+  fixed(-1.62221743701415554995e+00),
+  fixed(-1.62540418162897970511e+00),
+  fixed(-1.62860731102164901785e+00),
+  fixed(-1.63182693736960637843e+00),
+  fixed(-1.63506317390353239638e+00),
+  fixed(-1.63831613491962935214e+00),
+  fixed(-1.64158593579207723323e+00),
+  fixed(-1.64487269298566740616e+00),
+  fixed(-1.64817652406862102943e+00),
+  fixed(-1.65149754772557022520e+00),
+  fixed(-1.65483588377074375408e+00),
+  fixed(-1.65819165316133032562e+00),
+  fixed(-1.66156497801103131273e+00),
+  fixed(-1.66495598160381885755e+00),
+  fixed(-1.66836478840787028055e+00),
+  fixed(-1.67179152408972053756e+00),
+  fixed(-1.67523631552861296257e+00),
+  fixed(-1.67869929083105473566e+00),
+  fixed(-1.68218057934558284927e+00),
+  fixed(-1.68568031167775478352e+00),
+  fixed(-1.68919861970533480289e+00),
+  fixed(-1.69273563659372383583e+00),
+  fixed(-1.69629149681160273921e+00),
+  fixed(-1.69986633614680693327e+00),
+  fixed(-1.70346029172244084471e+00),
+  fixed(-1.70707350201321217398e+00),
+  fixed(-1.71070610686202662087e+00),
+  fixed(-1.71435824749681442469e+00),
+  fixed(-1.71803006654761580840e+00),
+  fixed(-1.72172170806390867348e+00),
+  fixed(-1.72543331753221362845e+00),
+  fixed(-1.72916504189393283042e+00),
+  fixed(-1.73291702956348547815e+00),
+  fixed(-1.73668943044669643605e+00),
+  fixed(-1.74048239595946774294e+00),
+  fixed(-1.74429607904673855678e+00),
+  fixed(-1.74813063420171177498e+00),
+  fixed(-1.75198621748539440368e+00),
+  fixed(-1.75586298654642214423e+00),
+  fixed(-1.75976110064118951293e+00),
+  fixed(-1.76368072065428416195e+00),
+  fixed(-1.76762200911924605151e+00),
+  fixed(-1.77158513023962260746e+00),
+  fixed(-1.77557024991037026851e+00),
+  fixed(-1.77957753573957422333e+00),
+  fixed(-1.78360715707050565548e+00),
+  fixed(-1.78765928500403137313e+00),
+  fixed(-1.79173409242134940023e+00),
+  fixed(-1.79583175400710048919e+00),
+  fixed(-1.79995244627283157435e+00),
+  fixed(-1.80409634758082892958e+00),
+  fixed(-1.80826363816832014209e+00),
+  fixed(-1.81245450017207399007e+00),
+  fixed(-1.81666911765336158702e+00),
+  fixed(-1.82090767662333696819e+00),
+  fixed(-1.82517036506881136226e+00),
+  fixed(-1.82945737297843336044e+00),
+  fixed(-1.83376889236930340488e+00),
+  fixed(-1.83810511731398618096e+00),
+  fixed(-1.84246624396798375223e+00),
+  fixed(-1.84685247059763657518e+00),
+  fixed(-1.85126399760847770715e+00),
+  fixed(-1.85570102757404398197e+00),
+  fixed(-1.86016376526516524770e+00),
+  fixed(-1.86465241767970524300e+00),
+  fixed(-1.86916719407281495258e+00),
+  fixed(-1.87370830598766469066e+00),
+  fixed(-1.87827596728668200221e+00),
+  fixed(-1.88287039418331514362e+00),
+  fixed(-1.88749180527429527565e+00),
+  fixed(-1.89214042157245754261e+00),
+  fixed(-1.89681646654009261610e+00),
+  fixed(-1.90152016612285490460e+00),
+  fixed(-1.90625174878423653269e+00),
+  fixed(-1.91101144554062640779e+00),
+  fixed(-1.91579948999693239209e+00),
+  fixed(-1.92061611838282986220e+00),
+  fixed(-1.92546156958960645866e+00),
+  fixed(-1.93033608520762900440e+00),
+  fixed(-1.93523990956446367839e+00),
+  fixed(-1.94017328976360792225e+00),
+  fixed(-1.94513647572392112117e+00),
+  fixed(-1.95012972021970565351e+00),
+  fixed(-1.95515327892148493838e+00),
+  fixed(-1.96020741043747559473e+00),
+  fixed(-1.96529237635579256960e+00),
+  fixed(-1.97040844128734948804e+00),
+  fixed(-1.97555587290953971191e+00),
+  fixed(-1.98073494201065725129e+00),
+  fixed(-1.98594592253509150126e+00),
+  fixed(-1.99118909162933399593e+00),
+  fixed(-1.99646472968875499099e+00),
+  fixed(-2.00177312040523913694e+00),
+  fixed(-2.00711455081564160707e+00),
+  fixed(-2.01248931135110931123e+00),
+  fixed(-2.01789769588727185834e+00),
+  fixed(-2.02334000179534490016e+00),
+  fixed(-2.02881652999410899696e+00),
+  fixed(-2.03432758500285748582e+00),
+  fixed(-2.03987347499527649219e+00),
+  fixed(-2.04545451185429483232e+00),
+  fixed(-2.05107101122794555081e+00),
+  fixed(-2.05672329258620090187e+00),
+  fixed(-2.06241167927888113809e+00),
+  fixed(-2.06813649859459758318e+00),
+  fixed(-2.07389808182077928222e+00),
+  fixed(-2.07969676430479699647e+00),
+  fixed(-2.08553288551623117186e+00),
+  fixed(-2.09140678911025235109e+00),
+  fixed(-2.09731882299221261690e+00),
+  fixed(-2.10326933938341742447e+00),
+  fixed(-2.10925869488812489649e+00),
+  fixed(-2.11528725056181254871e+00),
+  fixed(-2.12135537198069412668e+00),
+  fixed(-2.12746342931257004238e+00),
+  fixed(-2.13361179738900874625e+00),
+  fixed(-2.13980085577888745618e+00),
+  fixed(-2.14603098886333265582e+00),
+  fixed(-2.15230258591210166230e+00),
+  fixed(-2.15861604116139149667e+00),
+  fixed(-2.16497175389317231264e+00),
+  fixed(-2.17137012851602984043e+00),
+  fixed(-2.17781157464756791597e+00),
+  fixed(-2.18429650719842394224e+00),
+  fixed(-2.19082534645787863070e+00),
+  fixed(-2.19739851818117104543e+00),
+  fixed(-2.20401645367850029800e+00),
+  fixed(-2.21067958990577784206e+00),
+  fixed(-2.21738836955716145383e+00),
+  fixed(-2.22414324115943351501e+00),
+  fixed(-2.23094465916820983153e+00),
+  fixed(-2.23779308406609889204e+00),
+  fixed(-2.24468898246279957576e+00),
+  fixed(-2.25163282719719903824e+00),
+  fixed(-2.25862509744154094093e+00),
+  fixed(-2.26566627880764892566e+00),
+  fixed(-2.27275686345533944888e+00),
+  fixed(-2.27989735020300887669e+00),
+  fixed(-2.28708824464047610903e+00),
+  fixed(-2.29433005924412292131e+00),
+  fixed(-2.30162331349441373618e+00),
+  fixed(-2.30896853399578771970e+00),
+  fixed(-2.31636625459906531077e+00),
+  fixed(-2.32381701652636740718e+00),
+  fixed(-2.33132136849862403594e+00),
+  fixed(-2.33887986686576798689e+00),
+  fixed(-2.34649307573959919893e+00),
+  fixed(-2.35416156712948776430e+00),
+  fixed(-2.36188592108090356092e+00),
+  fixed(-2.36966672581688575505e+00),
+  fixed(-2.37750457788250146862e+00),
+  fixed(-2.38540008229240196869e+00),
+  fixed(-2.39335385268148614912e+00),
+  fixed(-2.40136651145883428526e+00),
+  fixed(-2.40943868996493337775e+00),
+  fixed(-2.41757102863229489387e+00),
+  fixed(-2.42576417714957282001e+00),
+  fixed(-2.43401879462920422981e+00),
+  fixed(-2.44233554977875577663e+00),
+  fixed(-2.45071512107599698282e+00),
+  fixed(-2.45915819694782600280e+00),
+  fixed(-2.46766547595313889829e+00),
+  fixed(-2.47623766696977209989e+00),
+  fixed(-2.48487548938554780875e+00),
+  fixed(-2.49357967329363328091e+00),
+  fixed(-2.50235095969224596857e+00),
+  fixed(-2.51119010068884973563e+00),
+  fixed(-2.52009785970897981500e+00),
+  fixed(-2.52907501170974580162e+00),
+  fixed(-2.53812234339823783458e+00),
+  fixed(-2.54724065345489103507e+00),
+  fixed(-2.55643075276197118129e+00),
+  fixed(-2.56569346463730196817e+00),
+  fixed(-2.57502962507342170184e+00),
+  fixed(-2.58444008298221783448e+00),
+  fixed(-2.59392570044531201034e+00),
+  fixed(-2.60348735297025868363e+00),
+  fixed(-2.61312592975274915474e+00),
+  fixed(-2.62284233394501820058e+00),
+  fixed(-2.63263748293052479710e+00),
+  fixed(-2.64251230860521557631e+00),
+  fixed(-2.65246775766544651276e+00),
+  fixed(-2.66250479190279820685e+00),
+  fixed(-2.67262438850596062423e+00),
+  fixed(-2.68282754036992088231e+00),
+  fixed(-2.69311525641257132335e+00),
+  fixed(-2.70348856189907049696e+00),
+  fixed(-2.71394849877408361749e+00),
+  fixed(-2.72449612600216406477e+00),
+  fixed(-2.73513251991650507833e+00),
+  fixed(-2.74585877457632632215e+00),
+  fixed(-2.75667600213306229762e+00),
+  fixed(-2.76758533320573230085e+00),
+  fixed(-2.77858791726565801383e+00),
+  fixed(-2.78968492303084447670e+00),
+  fixed(-2.80087753887033397149e+00),
+  fixed(-2.81216697321872866056e+00),
+  fixed(-2.82355445500132251624e+00),
+  fixed(-2.83504123407005348412e+00),
+  fixed(-2.84662858165063603622e+00),
+  fixed(-2.85831779080120673697e+00),
+  fixed(-2.87011017688286562688e+00),
+  fixed(-2.88200707804236433418e+00),
+  fixed(-2.89400985570746449582e+00),
+  fixed(-2.90611989509523116482e+00),
+  fixed(-2.91833860573370973412e+00),
+  fixed(-2.93066742199742247266e+00),
+  fixed(-2.94310780365701418759e+00),
+  fixed(-2.95566123644362210854e+00),
+  fixed(-2.96832923262833370259e+00),
+  fixed(-2.98111333161723290885e+00),
+  fixed(-2.99401510056253306047e+00),
+  fixed(-3.00703613499032940126e+00),
+  fixed(-3.02017805944540240759e+00),
+  fixed(-3.03344252815375980958e+00),
+  fixed(-3.04683122570337827639e+00),
+  fixed(-3.06034586774376382579e+00),
+  fixed(-3.07398820170498776605e+00),
+  fixed(-3.08776000753670976096e+00),
+  fixed(-3.10166309846799315153e+00),
+  fixed(-3.11569932178849695603e+00),
+  fixed(-3.12987055965177241035e+00),
+  fixed(-3.14417872990140034872e+00),
+  fixed(-3.15862578692077544673e+00),
+  fixed(-3.17321372250719724306e+00),
+  fixed(-3.18794456677126358812e+00),
+  fixed(-3.20282038906229038489e+00),
+  fixed(-3.21784329892068488022e+00),
+  fixed(-3.23301544705823840076e+00),
+  fixed(-3.24833902636715743384e+00),
+  fixed(-3.26381627295901877162e+00),
+  fixed(-3.27944946723452757098e+00),
+  fixed(-3.29524093498522496759e+00),
+  fixed(-3.31119304852823503893e+00),
+  fixed(-3.32730822787527502626e+00),
+  fixed(-3.34358894193698930053e+00),
+  fixed(-3.36003770976406812565e+00),
+  fixed(-3.37665710182630407488e+00),
+  fixed(-3.39344974133100762970e+00),
+  fixed(-3.41041830558224701164e+00),
+  fixed(-3.42756552738224407051e+00),
+  fixed(-3.44489419647666705870e+00),
+  fixed(-3.46240716104527290753e+00),
+  fixed(-3.48010732923962828878e+00),
+  fixed(-3.49799767076964807089e+00),
+  fixed(-3.51608121854080790669e+00),
+  fixed(-3.53436107034379043412e+00),
+  fixed(-3.55284039059874023891e+00),
+  fixed(-3.57152241215603316604e+00),
+  fixed(-3.59041043815577243237e+00),
+  fixed(-3.60950784394830126445e+00),
+  fixed(-3.62881807907792142132e+00),
+  fixed(-3.64834466933247858478e+00),
+  fixed(-3.66809121886121713985e+00),
+  fixed(-3.68806141236362794444e+00),
+  fixed(-3.70825901735207796861e+00),
+  fixed(-3.72868788649117943734e+00),
+  fixed(-3.74935196001681392275e+00),
+  fixed(-3.77025526823819578937e+00),
+  fixed(-3.79140193412616177682e+00),
+  fixed(-3.81279617599122966354e+00),
+  fixed(-3.83444231025513282418e+00),
+  fixed(-3.85634475431948331448e+00),
+  fixed(-3.87850802953580364729e+00),
+  fixed(-3.90093676428094182640e+00),
+  fixed(-3.92363569714233628716e+00),
+  fixed(-3.94660968021770663938e+00),
+  fixed(-3.96986368253407650997e+00),
+  fixed(-3.99340279359099437073e+00),
+  fixed(-4.01723222703351456886e+00),
+  fixed(-4.04135732446031603615e+00),
+  fixed(-4.06578355937285973454e+00),
+  fixed(-4.09051654127179187270e+00),
+  fixed(-4.11556201990681902458e+00),
+  fixed(-4.14092588968710195729e+00),
+  fixed(-4.16661419425905332758e+00),
+  fixed(-4.19263313125910830337e+00),
+  fixed(-4.21898905724927164584e+00),
+  fixed(-4.24568849284379634668e+00),
+  fixed(-4.27273812803544927874e+00),
+  fixed(-4.30014482773080519706e+00),
+  fixed(-4.32791563750396424126e+00),
+  fixed(-4.35605778957888478686e+00),
+  fixed(-4.38457870905110436155e+00),
+  fixed(-4.41348602035982207070e+00),
+  fixed(-4.44278755402253722195e+00),
+  fixed(-4.47249135364448768826e+00),
+  fixed(-4.50260568321615650689e+00),
+  fixed(-4.53313903471273516033e+00),
+  fixed(-4.56410013601031749886e+00),
+  fixed(-4.59549795913406100567e+00),
+  fixed(-4.62734172885504513317e+00),
+  fixed(-4.65964093165285841991e+00),
+  fixed(-4.69240532506229968135e+00),
+  fixed(-4.72564494742363105928e+00),
+  fixed(-4.75937012805655612624e+00),
+  fixed(-4.79359149787997473879e+00),
+  fixed(-4.82832000050015430759e+00),
+  fixed(-4.86356690379173262073e+00),
+  fixed(-4.89934381199724455769e+00),
+  fixed(-4.93566267837260763685e+00),
+  fixed(-4.97253581840718350549e+00),
+  fixed(-5.00997592364955401933e+00),
+  fixed(-5.04799607617130252635e+00),
+  fixed(-5.08660976370352901910e+00),
+  fixed(-5.12583089548300208094e+00),
+  fixed(-5.16567381884671927850e+00),
+  fixed(-5.20615333661691614964e+00),
+  fixed(-5.24728472532044065701e+00),
+  fixed(-5.28908375428973087651e+00),
+  fixed(-5.33156670569552293415e+00),
+  fixed(-5.37475039556490497006e+00),
+  fixed(-5.41865219584132873365e+00),
+  fixed(-5.46329005754788266103e+00),
+  fixed(-5.50868253511832595137e+00),
+  fixed(-5.55484881196530366765e+00),
+  fixed(-5.60180872735987378519e+00),
+  fixed(-5.64958280470109741600e+00),
+  fixed(-5.69819228126082499841e+00),
+  fixed(-5.74765913949386852977e+00),
+  fixed(-5.79800614001068392867e+00),
+  fixed(-5.84925685631642178208e+00),
+  fixed(-5.90143571142790879236e+00),
+  fixed(-5.95456801648762734658e+00),
+  fixed(-6.00868001150352259998e+00),
+  fixed(-6.06379890835199741872e+00),
+  fixed(-6.11995293619227798132e+00),
+  fixed(-6.17717138945157007157e+00),
+  fixed(-6.23548467855189780806e+00),
+  fixed(-6.29492438356381178721e+00),
+  fixed(-6.35552331098540967957e+00),
+  fixed(-6.41731555386131002905e+00),
+  fixed(-6.48033655547302700484e+00),
+  fixed(-6.54462317685095484876e+00),
+  fixed(-6.61021376837760232803e+00),
+  fixed(-6.67714824577508991865e+00),
+  fixed(-6.74546817079269978024e+00),
+  fixed(-6.81521683693741220367e+00),
+  fixed(-6.88643936061918893188e+00),
+  fixed(-6.95918277811364394125e+00),
+  fixed(-7.03349614878077922242e+00),
+  fixed(-7.10943066501516529598e+00),
+  fixed(-7.18703976944562938911e+00),
+  fixed(-7.26637927994821630762e+00),
+  fixed(-7.34750752308720933570e+00),
+  fixed(-7.43048547665394121253e+00),
+  fixed(-7.51537692203634932753e+00),
+  fixed(-7.60224860721870232538e+00),
+  fixed(-7.69117042128721362104e+00),
+  fixed(-7.78221558140059155306e+00),
+  fixed(-7.87546083327599610868e+00),
+  fixed(-7.97098666634524821717e+00),
+  fixed(-8.06887754484825769907e+00),
+  fixed(-8.16922215625851677601e+00),
+  fixed(-8.27211367857629475964e+00),
+  fixed(-8.37765006818314361681e+00),
+  fixed(-8.48593437012601370384e+00),
+  fixed(-8.59707505289811457772e+00),
+  fixed(-8.71118637000191853303e+00),
+  fixed(-8.82838875082808449690e+00),
+  fixed(-8.94880922366175646232e+00),
+  fixed(-9.07258187393870230153e+00),
+  fixed(-9.19984834122801409251e+00),
+  fixed(-9.33075835881297699359e+00),
+  fixed(-9.46547034019208410882e+00),
+  fixed(-9.60415201733006362872e+00),
+  fixed(-9.74698113606612004389e+00),
+  fixed(-9.89414621474027100589e+00),
+  fixed(-1.00458473728475894404e+01),
+  fixed(-1.02022972373783442634e+01),
+  fixed(-1.03637219354762244450e+01),
+  fixed(-1.05303621831607774340e+01),
+  fixed(-1.07024744811363081709e+01),
+  fixed(-1.08803324301826442877e+01),
+  fixed(-1.10642281803139752583e+01),
+  fixed(-1.12544740298507672804e+01),
+  fixed(-1.14514041928149161720e+01),
+  fixed(-1.16553767556892626800e+01),
+  fixed(-1.18667758476405929002e+01),
+  fixed(-1.20860140518797170017e+01),
+  fixed(-1.23135350900051321332e+01),
+  fixed(-1.25498168160785894543e+01),
+  fixed(-1.27953745629455788446e+01),
+  fixed(-1.30507648901128323615e+01),
+  fixed(-1.33165897905510597354e+01),
+  fixed(-1.35935014233472841738e+01),
+  fixed(-1.38822074505257120336e+01),
+  fixed(-1.41834770699754990630e+01),
+  fixed(-1.44981478527697849046e+01),
+  fixed(-1.48271335128445773677e+01),
+  fixed(-1.51714327608207497633e+01),
+  fixed(-1.55321394226568028074e+01),
+  fixed(-1.59104540390800313077e+01),
+  fixed(-1.63076972049335360282e+01),
+  fixed(-1.67253249607281198053e+01),
+  fixed(-1.71649466144416038560e+01),
+  fixed(-1.76283454533384436047e+01),
+  fixed(-1.81175029077595084459e+01),
+  fixed(-1.86346268572755633386e+01),
+  fixed(-1.91821849320458248656e+01),
+  fixed(-1.97629438689657952466e+01),
+  fixed(-2.03800162470961083727e+01),
+  fixed(-2.10369162686565545073e+01),
+  fixed(-2.17376266962188431364e+01),
+  fixed(-2.24866796389758718533e+01),
+  fixed(-2.32892546503500064148e+01),
+  fixed(-2.41512986250743999506e+01),
+  fixed(-2.50796733648292011765e+01),
+  fixed(-2.60823385596309549328e+01),
+  fixed(-2.71685805145686671835e+01),
+  fixed(-2.83493005443874643845e+01),
+  fixed(-2.96373820211335292640e+01),
+  fixed(-3.10481622925619475950e+01),
+  fixed(-3.26000461760632163077e+01),
+  fixed(-3.43153131875135954942e+01),
+  fixed(-3.62211938464143656802e+01),
+  fixed(-3.83513258534217698070e+01),
+  fixed(-4.07477563344627000674e+01),
+  fixed(-4.34637449824903185913e+01),
+  fixed(-4.65677685457076648845e+01),
+  fixed(-5.01493735411231398302e+01),
+  fixed(-5.43279553248954485412e+01),
+  fixed(-5.92663257464776478400e+01),
+  fixed(-6.51924213952752324985e+01),
+  fixed(-7.24354840117278939715e+01),
+  fixed(-8.14893762066999016724e+01),
+  fixed(-9.31301677975236827933e+01),
+  fixed(-1.08651308480012460222e+02),
+  fixed(-1.30381007706975566407e+02),
+  fixed(-1.62975684384452961240e+02),
+  fixed(-2.17300315960433835016e+02),
+  fixed(-3.25949834779638649707e+02),
+  fixed(-6.51898902567791537876e+02),
+  fixed(-1.00000000000000000000e+08),
+  fixed(6.51898902567947629905e+02),
+  fixed(3.25949834779677701135e+02),
+  fixed(2.17300315960451200681e+02),
+  fixed(1.62975684384462709886e+02),
+  fixed(1.30381007706981819183e+02),
+  fixed(1.08651308480016808744e+02),
+  fixed(9.31301677975268660248e+01),
+  fixed(8.14893762067023459394e+01),
+  fixed(7.24354840117298266478e+01),
+  fixed(6.51924213952767956926e+01),
+  fixed(5.92663257464789410278e+01),
+  fixed(5.43279553248965356715e+01),
+  fixed(5.01493735411240635358e+01),
+  fixed(4.65677685457084606924e+01),
+  fixed(4.34637449824910078178e+01),
+  fixed(4.07477563344633111342e+01),
+  fixed(3.83513258534223098195e+01),
+  fixed(3.62211938464148488492e+01),
+  fixed(3.43153131875140289253e+01),
+  fixed(3.26000461760636071062e+01),
+  fixed(3.10481622925623028664e+01),
+  fixed(2.96373820211338490083e+01),
+  fixed(2.83493005443877628124e+01),
+  fixed(2.71685805145689407425e+01),
+  fixed(2.60823385596312036228e+01),
+  fixed(2.50796733648294321029e+01),
+  fixed(2.41512986250746131134e+01),
+  fixed(2.32892546503502053667e+01),
+  fixed(2.24866796389760601471e+01),
+  fixed(2.17376266962190136667e+01),
+  fixed(2.10369162686567179321e+01),
+  fixed(2.03800162470962611394e+01),
+  fixed(1.97629438689659373551e+01),
+  fixed(1.91821849320459598687e+01),
+  fixed(1.86346268572756912363e+01),
+  fixed(1.81175029077596292382e+01),
+  fixed(1.76283454533385572915e+01),
+  fixed(1.71649466144417139901e+01),
+  fixed(1.67253249607282228339e+01),
+  fixed(1.63076972049336319515e+01),
+  fixed(1.59104540390801219019e+01),
+  fixed(1.55321394226568898489e+01),
+  fixed(1.51714327608208368048e+01),
+  fixed(1.48271335128446573037e+01),
+  fixed(1.44981478527698612879e+01),
+  fixed(1.41834770699755718937e+01),
+  fixed(1.38822074505257848642e+01),
+  fixed(1.35935014233473534517e+01),
+  fixed(1.33165897905511236843e+01),
+  fixed(1.30507648901128927577e+01),
+  fixed(1.27953745629456374644e+01),
+  fixed(1.25498168160786462977e+01),
+  fixed(1.23135350900051889766e+01),
+  fixed(1.20860140518797720688e+01),
+  fixed(1.18667758476406426382e+01),
+  fixed(1.16553767556893124180e+01),
+  fixed(1.14514041928149623573e+01),
+  fixed(1.12544740298508134657e+01),
+  fixed(1.10642281803140214436e+01),
+  fixed(1.08803324301826869203e+01),
+  fixed(1.07024744811363508035e+01),
+  fixed(1.05303621831608182902e+01),
+  fixed(1.03637219354762617485e+01),
+  fixed(1.02022972373783815669e+01),
+  fixed(1.00458473728476285203e+01),
+  fixed(9.89414621474030653303e+00),
+  fixed(9.74698113606615379467e+00),
+  fixed(9.60415201733009737950e+00),
+  fixed(9.46547034019211608324e+00),
+  fixed(9.33075835881300896801e+00),
+  fixed(9.19984834122804606693e+00),
+  fixed(9.07258187393873427595e+00),
+  fixed(8.94880922366178666039e+00),
+  fixed(8.82838875082811291861e+00),
+  fixed(8.71118637000194695474e+00),
+  fixed(8.59707505289814122307e+00),
+  fixed(8.48593437012603857283e+00),
+  fixed(8.37765006818316848580e+00),
+  fixed(8.27211367857631962863e+00),
+  fixed(8.16922215625854164500e+00),
+  fixed(8.06887754484828079171e+00),
+  fixed(7.97098666634527130981e+00),
+  fixed(7.87546083327601831314e+00),
+  fixed(7.78221558140061375752e+00),
+  fixed(7.69117042128723671368e+00),
+  fixed(7.60224860721872275349e+00),
+  fixed(7.51537692203636975563e+00),
+  fixed(7.43048547665396341699e+00),
+  fixed(7.34750752308722887562e+00),
+  fixed(7.26637927994823495936e+00),
+  fixed(7.18703976944564804086e+00),
+  fixed(7.10943066501518305955e+00),
+  fixed(7.03349614878079698599e+00),
+  fixed(6.95918277811366170482e+00),
+  fixed(6.88643936061920580727e+00),
+  fixed(6.81521683693742907906e+00),
+  fixed(6.74546817079271665563e+00),
+  fixed(6.67714824577510679404e+00),
+  fixed(6.61021376837761920342e+00),
+  fixed(6.54462317685097083597e+00),
+  fixed(6.48033655547304299205e+00),
+  fixed(6.41731555386132512808e+00),
+  fixed(6.35552331098542566679e+00),
+  fixed(6.29492438356382688625e+00),
+  fixed(6.23548467855191201892e+00),
+  fixed(6.17717138945158428243e+00),
+  fixed(6.11995293619229130400e+00),
+  fixed(6.06379890835201074140e+00),
+  fixed(6.00868001150353592266e+00),
+  fixed(5.95456801648763978108e+00),
+  fixed(5.90143571142792122686e+00),
+  fixed(5.84925685631643421658e+00),
+  fixed(5.79800614001069547498e+00),
+  fixed(5.74765913949388007609e+00),
+  fixed(5.69819228126083654473e+00),
+  fixed(5.64958280470110896232e+00),
+  fixed(5.60180872735988533151e+00),
+  fixed(5.55484881196531432579e+00),
+  fixed(5.50868253511833749769e+00),
+  fixed(5.46329005754789331917e+00),
+  fixed(5.41865219584133939179e+00),
+  fixed(5.37475039556491562820e+00),
+  fixed(5.33156670569553359229e+00),
+  fixed(5.28908375428974064647e+00),
+  fixed(5.24728472532045131516e+00),
+  fixed(5.20615333661692591960e+00),
+  fixed(5.16567381884672904846e+00),
+  fixed(5.12583089548301185090e+00),
+  fixed(5.08660976370353878906e+00),
+  fixed(5.04799607617131229631e+00),
+  fixed(5.00997592364956290112e+00),
+  fixed(4.97253581840719238727e+00),
+  fixed(4.93566267837261563045e+00),
+  fixed(4.89934381199725343947e+00),
+  fixed(4.86356690379174061434e+00),
+  fixed(4.82832000050016318937e+00),
+  fixed(4.79359149787998273240e+00),
+  fixed(4.75937012805656411985e+00),
+  fixed(4.72564494742363905289e+00),
+  fixed(4.69240532506230767495e+00),
+  fixed(4.65964093165286552534e+00),
+  fixed(4.62734172885505312678e+00),
+  fixed(4.59549795913406899928e+00),
+  fixed(4.56410013601032460429e+00),
+  fixed(4.53313903471274226575e+00),
+  fixed(4.50260568321616361231e+00),
+  fixed(4.47249135364449479368e+00),
+  fixed(4.44278755402254432738e+00),
+  fixed(4.41348602035982917613e+00),
+  fixed(4.38457870905111146698e+00),
+  fixed(4.35605778957889189229e+00),
+  fixed(4.32791563750397134669e+00),
+  fixed(4.30014482773081141431e+00),
+  fixed(4.27273812803545549599e+00),
+  fixed(4.24568849284380256393e+00),
+  fixed(4.21898905724927786309e+00),
+  fixed(4.19263313125911452062e+00),
+  fixed(4.16661419425905954483e+00),
+  fixed(4.14092588968710728636e+00),
+  fixed(4.11556201990682524183e+00),
+  fixed(4.09051654127179808995e+00),
+  fixed(4.06578355937286506361e+00),
+  fixed(4.04135732446032136522e+00),
+  fixed(4.01723222703351989793e+00),
+  fixed(3.99340279359099969980e+00),
+  fixed(3.96986368253408183904e+00),
+  fixed(3.94660968021771196845e+00),
+  fixed(3.92363569714234206032e+00),
+  fixed(3.90093676428094671138e+00),
+  fixed(3.87850802953580897636e+00),
+  fixed(3.85634475431948819946e+00),
+  fixed(3.83444231025513815325e+00),
+  fixed(3.81279617599123454852e+00),
+  fixed(3.79140193412616710589e+00),
+  fixed(3.77025526823820067435e+00),
+  fixed(3.74935196001681880773e+00),
+  fixed(3.72868788649118476641e+00),
+  fixed(3.70825901735208240950e+00),
+  fixed(3.68806141236363327351e+00),
+  fixed(3.66809121886122158074e+00),
+  fixed(3.64834466933248302567e+00),
+  fixed(3.62881807907792586221e+00),
+  fixed(3.60950784394830570534e+00),
+  fixed(3.59041043815577687326e+00),
+  fixed(3.57152241215603716284e+00),
+  fixed(3.55284039059874423572e+00),
+  fixed(3.53436107034379531910e+00),
+  fixed(3.51608121854081279167e+00),
+  fixed(3.49799767076965295587e+00),
+  fixed(3.48010732923963317376e+00),
+  fixed(3.46240716104527690433e+00),
+  fixed(3.44489419647667149960e+00),
+  fixed(3.42756552738224806731e+00),
+  fixed(3.41041830558225056436e+00),
+  fixed(3.39344974133101251468e+00),
+  fixed(3.37665710182630851577e+00),
+  fixed(3.36003770976407212245e+00),
+  fixed(3.34358894193699329733e+00),
+  fixed(3.32730822787527857898e+00),
+  fixed(3.31119304852823947982e+00),
+  fixed(3.29524093498522896439e+00),
+  fixed(3.27944946723453112369e+00),
+  fixed(3.26381627295902276842e+00),
+  fixed(3.24833902636716098655e+00),
+  fixed(3.23301544705824150938e+00),
+  fixed(3.21784329892068887702e+00),
+  fixed(3.20282038906229438169e+00),
+  fixed(3.18794456677126714084e+00),
+  fixed(3.17321372250720123986e+00),
+  fixed(3.15862578692077944353e+00),
+  fixed(3.14417872990140434553e+00),
+  fixed(3.12987055965177551897e+00),
+  fixed(3.11569932178850050875e+00),
+  fixed(3.10166309846799626015e+00),
+  fixed(3.08776000753671286958e+00),
+  fixed(3.07398820170499131876e+00),
+  fixed(3.06034586774376693441e+00),
+  fixed(3.04683122570338138502e+00),
+  fixed(3.03344252815376291821e+00),
+  fixed(3.02017805944540551621e+00),
+  fixed(3.00703613499033250989e+00),
+  fixed(2.99401510056253572500e+00),
+  fixed(2.98111333161723557339e+00),
+  fixed(2.96832923262833636713e+00),
+  fixed(2.95566123644362566125e+00),
+  fixed(2.94310780365701685213e+00),
+  fixed(2.93066742199742558128e+00),
+  fixed(2.91833860573371239866e+00),
+  fixed(2.90611989509523427344e+00),
+  fixed(2.89400985570746716036e+00),
+  fixed(2.88200707804236744281e+00),
+  fixed(2.87011017688286829141e+00),
+  fixed(2.85831779080120940151e+00),
+  fixed(2.84662858165063870075e+00),
+  fixed(2.83504123407005614865e+00),
+  fixed(2.82355445500132562486e+00),
+  fixed(2.81216697321873132509e+00),
+  fixed(2.80087753887033619193e+00),
+  fixed(2.78968492303084714123e+00),
+  fixed(2.77858791726566023428e+00),
+  fixed(2.76758533320573496539e+00),
+  fixed(2.75667600213306496215e+00),
+  fixed(2.74585877457632898668e+00),
+  fixed(2.73513251991650774286e+00),
+  fixed(2.72449612600216672931e+00),
+  fixed(2.71394849877408583794e+00),
+  fixed(2.70348856189907316150e+00),
+  fixed(2.69311525641257398789e+00),
+  fixed(2.68282754036992310276e+00),
+  fixed(2.67262438850596284468e+00),
+  fixed(2.66250479190280042729e+00),
+  fixed(2.65246775766544917730e+00),
+  fixed(2.64251230860521824084e+00),
+  fixed(2.63263748293052701754e+00),
+  fixed(2.62284233394502042103e+00),
+  fixed(2.61312592975275137519e+00),
+  fixed(2.60348735297026090407e+00),
+  fixed(2.59392570044531423079e+00),
+  fixed(2.58444008298222005493e+00),
+  fixed(2.57502962507342392229e+00),
+  fixed(2.56569346463730418861e+00),
+  fixed(2.55643075276197340173e+00),
+  fixed(2.54724065345489325551e+00),
+  fixed(2.53812234339823961093e+00),
+  fixed(2.52907501170974802207e+00),
+  fixed(2.52009785970898203544e+00),
+  fixed(2.51119010068885195608e+00),
+  fixed(2.50235095969224818901e+00),
+  fixed(2.49357967329363550135e+00),
+  fixed(2.48487548938555002920e+00),
+  fixed(2.47623766696977432034e+00),
+  fixed(2.46766547595314111874e+00),
+  fixed(2.45915819694782822324e+00),
+  fixed(2.45071512107599920327e+00),
+  fixed(2.44233554977875799707e+00),
+  fixed(2.43401879462920645025e+00),
+  fixed(2.42576417714957504046e+00),
+  fixed(2.41757102863229711431e+00),
+  fixed(2.40943868996493559820e+00),
+  fixed(2.40136651145883606162e+00),
+  fixed(2.39335385268148792548e+00),
+  fixed(2.38540008229240418913e+00),
+  fixed(2.37750457788250324498e+00),
+  fixed(2.36966672581688753141e+00),
+  fixed(2.36188592108090533728e+00),
+  fixed(2.35416156712948954066e+00),
+  fixed(2.34649307573960097528e+00),
+  fixed(2.33887986686576976325e+00),
+  fixed(2.33132136849862581229e+00),
+  fixed(2.32381701652636918354e+00),
+  fixed(2.31636625459906708713e+00),
+  fixed(2.30896853399578949606e+00),
+  fixed(2.30162331349441551254e+00),
+  fixed(2.29433005924412469767e+00),
+  fixed(2.28708824464047788538e+00),
+  fixed(2.27989735020301065305e+00),
+  fixed(2.27275686345534122523e+00),
+  fixed(2.26566627880765070202e+00),
+  fixed(2.25862509744154271729e+00),
+  fixed(2.25163282719720081460e+00),
+  fixed(2.24468898246280135211e+00),
+  fixed(2.23779308406610066839e+00),
+  fixed(2.23094465916821116380e+00),
+  fixed(2.22414324115943529137e+00),
+  fixed(2.21738836955716278609e+00),
+  fixed(2.21067958990577917433e+00),
+  fixed(2.20401645367850163026e+00),
+  fixed(2.19739851818117237769e+00),
+  fixed(2.19082534645788040706e+00),
+  fixed(2.18429650719842527451e+00),
+  fixed(2.17781157464756924824e+00),
+  fixed(2.17137012851603117269e+00),
+  fixed(2.16497175389317364491e+00),
+  fixed(2.15861604116139327303e+00),
+  fixed(2.15230258591210343866e+00),
+  fixed(2.14603098886333443218e+00),
+  fixed(2.13980085577888923254e+00),
+  fixed(2.13361179738901007852e+00),
+  fixed(2.12746342931257137465e+00),
+  fixed(2.12135537198069501486e+00),
+  fixed(2.11528725056181432507e+00),
+  fixed(2.10925869488812578467e+00),
+  fixed(2.10326933938341875674e+00),
+  fixed(2.09731882299221394916e+00),
+  fixed(2.09140678911025368336e+00),
+  fixed(2.08553288551623250413e+00),
+  fixed(2.07969676430479832874e+00),
+  fixed(2.07389808182078061449e+00),
+  fixed(2.06813649859459891545e+00),
+  fixed(2.06241167927888247036e+00),
+  fixed(2.05672329258620223413e+00),
+  fixed(2.05107101122794688308e+00),
+  fixed(2.04545451185429616459e+00),
+  fixed(2.03987347499527782446e+00),
+  fixed(2.03432758500285881809e+00),
+  fixed(2.02881652999411032923e+00),
+  fixed(2.02334000179534623243e+00),
+  fixed(2.01789769588727319061e+00),
+  fixed(2.01248931135111064350e+00),
+  fixed(2.00711455081564293934e+00),
+  fixed(2.00177312040524046921e+00),
+  fixed(1.99646472968875632326e+00),
+  fixed(1.99118909162933488410e+00),
+  fixed(1.98594592253509238944e+00),
+  fixed(1.98073494201065813947e+00),
+  fixed(1.97555587290954104418e+00),
+  fixed(1.97040844128735082030e+00),
+  fixed(1.96529237635579367982e+00),
+  fixed(1.96020741043747692700e+00),
+  fixed(1.95515327892148627065e+00),
+  fixed(1.95012972021970698577e+00),
+  fixed(1.94513647572392200935e+00),
+  fixed(1.94017328976360925452e+00),
+  fixed(1.93523990956446456657e+00),
+  fixed(1.93033608520763033667e+00),
+  fixed(1.92546156958960734684e+00),
+  fixed(1.92061611838283119447e+00),
+  fixed(1.91579948999693372436e+00),
+  fixed(1.91101144554062751801e+00),
+  fixed(1.90625174878423764291e+00),
+  fixed(1.90152016612285623687e+00),
+  fixed(1.89681646654009372632e+00),
+  fixed(1.89214042157245865283e+00),
+  fixed(1.88749180527429638587e+00),
+  fixed(1.88287039418331625384e+00),
+  fixed(1.87827596728668311243e+00),
+  fixed(1.87370830598766602293e+00),
+  fixed(1.86916719407281606280e+00),
+  fixed(1.86465241767970635323e+00),
+  fixed(1.86016376526516591383e+00),
+  fixed(1.85570102757404509219e+00),
+  fixed(1.85126399760847881737e+00),
+  fixed(1.84685247059763768540e+00),
+  fixed(1.84246624396798486245e+00),
+  fixed(1.83810511731398729118e+00),
+  fixed(1.83376889236930451510e+00),
+  fixed(1.82945737297843469271e+00),
+  fixed(1.82517036506881247249e+00),
+  fixed(1.82090767662333807841e+00),
+  fixed(1.81666911765336225315e+00),
+  fixed(1.81245450017207465621e+00),
+  fixed(1.80826363816832080822e+00),
+  fixed(1.80409634758082959571e+00),
+  fixed(1.79995244627283268457e+00),
+  fixed(1.79583175400710115532e+00),
+  fixed(1.79173409242135028840e+00),
+  fixed(1.78765928500403248336e+00),
+  fixed(1.78360715707050632162e+00),
+  fixed(1.77957753573957488946e+00),
+  fixed(1.77557024991037093464e+00),
+  fixed(1.77158513023962371769e+00),
+  fixed(1.76762200911924716173e+00),
+  fixed(1.76368072065428505013e+00),
+  fixed(1.75976110064119062315e+00),
+  fixed(1.75586298654642325445e+00),
+  fixed(1.75198621748539529186e+00),
+  fixed(1.74813063420171266316e+00),
+  fixed(1.74429607904673944496e+00),
+  fixed(1.74048239595946863112e+00),
+  fixed(1.73668943044669754627e+00),
+  fixed(1.73291702956348636633e+00),
+  fixed(1.72916504189393394064e+00),
+  fixed(1.72543331753221429459e+00),
+  fixed(1.72172170806390978370e+00),
+  fixed(1.71803006654761647454e+00),
+  fixed(1.71435824749681531287e+00),
+  fixed(1.71070610686202728701e+00),
+  fixed(1.70707350201321328420e+00),
+  fixed(1.70346029172244151084e+00),
+  fixed(1.69986633614680782145e+00),
+  fixed(1.69629149681160384944e+00),
+  fixed(1.69273563659372472401e+00),
+  fixed(1.68919861970533591311e+00),
+  fixed(1.68568031167775567170e+00),
+  fixed(1.68218057934558373745e+00),
+  fixed(1.67869929083105540180e+00),
+  fixed(1.67523631552861362870e+00),
+  fixed(1.67179152408972142574e+00),
+  fixed(1.66836478840787116873e+00),
+  fixed(1.66495598160381996777e+00),
+  fixed(1.66156497801103197887e+00),
+  fixed(1.65819165316133076971e+00),
+  fixed(1.65483588377074464226e+00),
+  fixed(1.65149754772557111338e+00),
+  fixed(1.64817652406862191761e+00),
+  fixed(1.64487269298566829434e+00),
+  fixed(1.64158593579207812141e+00),
+  fixed(1.63831613491962979623e+00),
+  fixed(1.63506317390353328456e+00),
+  fixed(1.63182693736960726660e+00),
+  fixed(1.62860731102164968398e+00),
+  fixed(1.62540418162898037124e+00),
+  fixed(1.62221743701415643812e+00),
+  fixed(1.61904696604085063250e+00),
+  fixed(1.61589265860191377833e+00),
+  fixed(1.61275440560758531738e+00),
+  fixed(1.60963209897387127256e+00),
+  fixed(1.60652563161108563605e+00),
+  fixed(1.60343489741253764080e+00),
+  fixed(1.60035979124338911816e+00),
+  fixed(1.59730020892965018930e+00),
+  fixed(1.59425604724732972173e+00),
+  fixed(1.59122720391173300136e+00),
+  fixed(1.58821357756690284546e+00),
+  fixed(1.58521506777520038156e+00),
+  fixed(1.58223157500703637268e+00),
+  fixed(1.57926300063072844182e+00),
+  fixed(1.57630924690250018294e+00),
+  fixed(1.57337021695661527509e+00),
+  fixed(1.57044581479563349902e+00),
+  fixed(1.56753594528081485748e+00),
+  fixed(1.56464051412263249752e+00),
+  fixed(1.56175942787142196799e+00),
+  fixed(1.55889259390815060335e+00),
+  fixed(1.55603992043531103029e+00),
+  fixed(1.55320131646792658486e+00),
+  fixed(1.55037669182469106666e+00),
+  fixed(1.54756595711920863501e+00),
+  fixed(1.54476902375135471956e+00),
+  fixed(1.54198580389875350427e+00),
+  fixed(1.53921621050835399913e+00),
+  fixed(1.53646015728813467582e+00),
+  fixed(1.53371755869889692114e+00),
+  fixed(1.53098832994617817249e+00),
+  fixed(1.52827238697225920028e+00),
+  fixed(1.52556964644828441102e+00),
+  fixed(1.52288002576647163444e+00),
+  fixed(1.52020344303243537532e+00),
+  fixed(1.51753981705759932730e+00),
+  fixed(1.51488906735170636431e+00),
+  fixed(1.51225111411542889606e+00),
+  fixed(1.50962587823306315649e+00),
+  fixed(1.50701328126533362628e+00),
+  fixed(1.50441324544227006399e+00),
+  fixed(1.50182569365618667767e+00),
+  fixed(1.49925054945474345303e+00),
+  fixed(1.49668773703410096232e+00),
+  fixed(1.49413718123215022437e+00),
+  fixed(1.49159880752184403896e+00),
+  fixed(1.48907254200459715499e+00),
+  fixed(1.48655831140377414634e+00),
+  fixed(1.48405604305826166467e+00),
+  fixed(1.48156566491611130232e+00),
+  fixed(1.47908710552827549201e+00),
+  fixed(1.47662029404240668917e+00),
+  fixed(1.47416516019674337379e+00),
+  fixed(1.47172163431406466394e+00),
+  fixed(1.46928964729572619774e+00),
+  fixed(1.46686913061575796569e+00),
+  fixed(1.46446001631505073881e+00),
+  fixed(1.46206223699560045048e+00),
+  fixed(1.45967572581482651906e+00),
+  fixed(1.45730041647996300114e+00),
+  fixed(1.45493624324250903079e+00),
+  fixed(1.45258314089276119319e+00),
+  fixed(1.45024104475439719053e+00),
+  fixed(1.44790989067913411503e+00),
+  fixed(1.44558961504144734000e+00),
+  fixed(1.44328015473335513619e+00),
+  fixed(1.44098144715926124171e+00),
+  fixed(1.43869343023086959654e+00),
+  fixed(1.43641604236214837087e+00),
+  fixed(1.43414922246435949660e+00),
+  fixed(1.43189290994115037137e+00),
+  fixed(1.42964704468369374624e+00),
+  fixed(1.42741156706590088810e+00),
+  fixed(1.42518641793967715259e+00),
+  fixed(1.42297153863024150589e+00),
+  fixed(1.42076687093149778285e+00),
+  fixed(1.41857235710146434293e+00),
+  fixed(1.41638793985775013340e+00),
+  fixed(1.41421356237309536752e+00),
+  fixed(1.41204916827095328102e+00),
+  fixed(1.40989470162112984220e+00),
+  fixed(1.40775010693547297791e+00),
+  fixed(1.40561532916360754086e+00),
+  fixed(1.40349031368873089498e+00),
+  fixed(1.40137500632344602636e+00),
+  fixed(1.39926935330564816695e+00),
+  fixed(1.39717330129445782561e+00),
+  fixed(1.39508679736620333500e+00),
+  fixed(1.39300978901044070213e+00),
+  fixed(1.39094222412603540917e+00),
+  fixed(1.38888405101727308022e+00),
+  fixed(1.38683521839002321663e+00),
+  fixed(1.38479567534794645312e+00),
+  fixed(1.38276537138873756305e+00),
+  fixed(1.38074425640042530716e+00),
+  fixed(1.37873228065770092599e+00),
+  fixed(1.37672939481829526009e+00),
+  fixed(1.37473554991939517222e+00),
+  fixed(1.37275069737410082560e+00),
+  fixed(1.37077478896791959961e+00),
+  fixed(1.36880777685530818921e+00),
+  fixed(1.36684961355624357005e+00),
+  fixed(1.36490025195283881665e+00),
+  fixed(1.36295964528599489185e+00),
+  fixed(1.36102774715208618694e+00),
+  fixed(1.35910451149969269125e+00),
+  fixed(1.35718989262635925108e+00),
+  fixed(1.35528384517539390863e+00),
+  fixed(1.35338632413270310018e+00),
+  fixed(1.35149728482366149329e+00),
+  fixed(1.34961668291001180009e+00),
+  fixed(1.34774447438680988753e+00),
+  fixed(1.34588061557939075996e+00),
+  fixed(1.34402506314037628599e+00),
+  fixed(1.34217777404671334551e+00),
+  fixed(1.34033870559674128664e+00),
+  fixed(1.33850781540729912855e+00),
+  fixed(1.33668506141085718930e+00),
+  fixed(1.33487040185268268644e+00),
+  fixed(1.33306379528803642387e+00),
+  fixed(1.33126520057940056496e+00),
+  fixed(1.32947457689373105261e+00),
+  fixed(1.32769188369975177366e+00),
+  fixed(1.32591708076526426652e+00),
+  fixed(1.32415012815449517625e+00),
+  fixed(1.32239098622547035511e+00),
+  fixed(1.32063961562741294387e+00),
+  fixed(1.31889597729817809046e+00),
+  fixed(1.31716003246170743068e+00),
+  fixed(1.31543174262551332276e+00),
+  fixed(1.31371106957819083760e+00),
+  fixed(1.31199797538695617227e+00),
+  fixed(1.31029242239520749003e+00),
+  fixed(1.30859437322011973315e+00),
+  fixed(1.30690379075025653322e+00),
+  fixed(1.30522063814321231945e+00),
+  fixed(1.30354487882327840786e+00),
+  fixed(1.30187647647912951854e+00),
+  fixed(1.30021539506154515387e+00),
+  fixed(1.29856159878114274520e+00),
+  fixed(1.29691505210614277388e+00),
+  fixed(1.29527571976015321020e+00),
+  fixed(1.29364356671998081971e+00),
+  fixed(1.29201855821345823472e+00),
+  fixed(1.29040065971730499861e+00),
+  fixed(1.28878983695500015649e+00),
+  fixed(1.28718605589468304551e+00),
+  fixed(1.28558928274707384709e+00),
+  fixed(1.28399948396341323509e+00),
+  fixed(1.28241662623343111171e+00),
+  fixed(1.28084067648332800005e+00),
+  fixed(1.27927160187378041734e+00),
+  fixed(1.27770936979796845279e+00),
+  fixed(1.27615394787962177503e+00),
+  fixed(1.27460530397108273704e+00),
+  fixed(1.27306340615139790273e+00),
+  fixed(1.27152822272442045382e+00),
+  fixed(1.26999972221693591123e+00),
+  fixed(1.26847787337680717457e+00),
+  fixed(1.26696264517113399428e+00),
+  fixed(1.26545400678444130982e+00),
+  fixed(1.26395192761687336080e+00),
+  fixed(1.26245637728241577591e+00),
+  fixed(1.26096732560713076232e+00),
+  fixed(1.25948474262741139107e+00),
+  fixed(1.25800859858825253568e+00),
+  fixed(1.25653886394154246098e+00),
+  fixed(1.25507550934436817869e+00),
+  fixed(1.25361850565733878859e+00),
+  fixed(1.25216782394292658331e+00),
+  fixed(1.25072343546382058754e+00),
+  fixed(1.24928531168130585449e+00),
+  fixed(1.24785342425364809138e+00),
+  fixed(1.24642774503450159962e+00),
+  fixed(1.24500824607132942745e+00),
+  fixed(1.24359489960384284046e+00),
+  fixed(1.24218767806244878571e+00),
+  fixed(1.24078655406672488937e+00),
+  fixed(1.23939150042389711892e+00),
+  fixed(1.23800249012734053800e+00),
+  fixed(1.23661949635509160750e+00),
+  fixed(1.23524249246837314331e+00),
+  fixed(1.23387145201014147844e+00),
+  fixed(1.23250634870363806606e+00),
+  fixed(1.23114715645096239882e+00),
+  fixed(1.22979384933165536431e+00),
+  fixed(1.22844640160129836559e+00),
+  fixed(1.22710478769012287792e+00),
+  fixed(1.22576898220163932329e+00),
+  fixed(1.22443895991127371659e+00),
+  fixed(1.22311469576501985479e+00),
+  fixed(1.22179616487810571712e+00),
+  fixed(1.22048334253366741464e+00),
+  fixed(1.21917620418144601047e+00),
+  fixed(1.21787472543648656043e+00),
+  fixed(1.21657888207785513934e+00),
+  fixed(1.21528865004736807975e+00),
+  fixed(1.21400400544833142469e+00),
+  fixed(1.21272492454429214881e+00),
+  fixed(1.21145138375780647699e+00),
+  fixed(1.21018335966921308788e+00),
+  fixed(1.20892082901542252671e+00),
+  fixed(1.20766376868871683214e+00),
+  fixed(1.20641215573555848906e+00),
+  fixed(1.20516596735541647867e+00),
+  fixed(1.20392518089959721372e+00),
+  fixed(1.20268977387009057267e+00),
+  fixed(1.20145972391842414950e+00),
+  fixed(1.20023500884453127036e+00),
+  fixed(1.19901560659562567146e+00),
+  fixed(1.19780149526509260838e+00),
+  fixed(1.19659265309138485023e+00),
+  fixed(1.19538905845693155250e+00),
+  fixed(1.19419068988705823209e+00),
+  fixed(1.19299752604891295960e+00),
+  fixed(1.19180954575040942700e+00),
+  fixed(1.19062672793917312397e+00),
+  fixed(1.18944905170150083684e+00),
+  fixed(1.18827649626132969551e+00),
+  fixed(1.18710904097921510214e+00),
+  fixed(1.18594666535131643137e+00),
+  fixed(1.18478934900839805167e+00),
+  fixed(1.18363707171483323322e+00),
+  fixed(1.18248981336761938010e+00),
+  fixed(1.18134755399540480880e+00),
+  fixed(1.18021027375751930144e+00),
+  fixed(1.17907795294302020217e+00),
+  fixed(1.17795057196974273239e+00),
+  fixed(1.17682811138335940981e+00),
+  fixed(1.17571055185645012564e+00),
+  fixed(1.17459787418757910515e+00),
+  fixed(1.17349005930037986190e+00),
+  fixed(1.17238708824265214226e+00),
+  fixed(1.17128894218546220074e+00),
+  fixed(1.17019560242225462154e+00),
+  fixed(1.16910705036797213374e+00),
+  fixed(1.16802326755817942328e+00),
+  fixed(1.16694423564820226602e+00),
+  fixed(1.16586993641226777108e+00),
+  fixed(1.16480035174265617037e+00),
+  fixed(1.16373546364885793736e+00),
+  fixed(1.16267525425674178585e+00),
+  fixed(1.16161970580772511141e+00),
+  fixed(1.16056880065795842150e+00),
+  fixed(1.15952252127751198607e+00),
+  fixed(1.15848085024957137001e+00),
+  fixed(1.15744377026964206934e+00),
+  fixed(1.15641126414475636786e+00),
+  fixed(1.15538331479269507085e+00),
+  fixed(1.15435990524120812850e+00),
+  fixed(1.15334101862724813792e+00),
+  fixed(1.15232663819620761991e+00),
+  fixed(1.15131674730116451144e+00),
+  fixed(1.15031132940213187688e+00),
+  fixed(1.14931036806532027583e+00),
+  fixed(1.14831384696239902077e+00),
+  fixed(1.14732174986977053521e+00),
+  fixed(1.14633406066784671040e+00),
+  fixed(1.14535076334033325551e+00),
+  fixed(1.14437184197352226356e+00),
+  fixed(1.14339728075558855203e+00),
+  fixed(1.14242706397589266487e+00),
+  fixed(1.14146117602429053584e+00),
+  fixed(1.14049960139045047924e+00),
+  fixed(1.13954232466317173511e+00),
+  fixed(1.13858933052971611488e+00),
+  fixed(1.13764060377513942512e+00),
+  fixed(1.13669612928163088483e+00),
+  fixed(1.13575589202786075838e+00),
+  fixed(1.13481987708832643413e+00),
+  fixed(1.13388806963271560058e+00),
+  fixed(1.13296045492526431531e+00),
+  fixed(1.13203701832412617634e+00),
+  fixed(1.13111774528074637836e+00),
+  fixed(1.13020262133924109804e+00),
+  fixed(1.12929163213577909985e+00),
+  fixed(1.12838476339797577630e+00),
+  fixed(1.12748200094428607798e+00),
+  fixed(1.12658333068340454908e+00),
+  fixed(1.12568873861367246825e+00),
+  fixed(1.12479821082248676589e+00),
+  fixed(1.12391173348571826729e+00),
+  fixed(1.12302929286713104595e+00),
+  fixed(1.12215087531780910446e+00),
+  fixed(1.12127646727558749618e+00),
+  fixed(1.12040605526448855400e+00),
+  fixed(1.11953962589416056161e+00),
+  fixed(1.11867716585932708284e+00),
+  fixed(1.11781866193923495878e+00),
+  fixed(1.11696410099710985442e+00),
+  fixed(1.11611346997961735639e+00),
+  fixed(1.11526675591632473683e+00),
+  fixed(1.11442394591917359747e+00),
+  fixed(1.11358502718195162551e+00),
+  fixed(1.11274998697977123285e+00),
+  fixed(1.11191881266855241428e+00),
+  fixed(1.11109149168451004641e+00),
+  fixed(1.11026801154364407331e+00),
+  fixed(1.10944835984123812977e+00),
+  fixed(1.10863252425135772050e+00),
+  fixed(1.10782049252635572678e+00),
+  fixed(1.10701225249638079973e+00),
+  fixed(1.10620779206888930624e+00),
+  fixed(1.10540709922816460242e+00),
+  fixed(1.10461016203483697318e+00),
+  fixed(1.10381696862540934490e+00),
+  fixed(1.10302750721178588478e+00),
+  fixed(1.10224176608080703943e+00),
+  fixed(1.10145973359378412937e+00),
+  fixed(1.10068139818604415758e+00),
+  fixed(1.09990674836647195356e+00),
+  fixed(1.09913577271706119909e+00),
+  fixed(1.09836845989246656430e+00),
+  fixed(1.09760479861955917436e+00),
+  fixed(1.09684477769698962568e+00),
+  fixed(1.09608838599475011399e+00),
+  fixed(1.09533561245374277959e+00),
+  fixed(1.09458644608535160536e+00),
+  fixed(1.09384087597101786749e+00),
+  fixed(1.09309889126181625230e+00),
+  fixed(1.09236048117804096513e+00),
+  fixed(1.09162563500878895262e+00),
+  fixed(1.09089434211155000831e+00),
+  fixed(1.09016659191179976496e+00),
+  fixed(1.08944237390259424103e+00),
+  fixed(1.08872167764417238089e+00),
+  fixed(1.08800449276355659656e+00),
+  fixed(1.08729080895415997077e+00),
+  fixed(1.08658061597539568055e+00),
+  fixed(1.08587390365229063960e+00),
+  fixed(1.08517066187509958475e+00),
+  fixed(1.08447088059892737810e+00),
+  fixed(1.08377454984334975485e+00),
+  fixed(1.08308165969203895607e+00),
+  fixed(1.08239220029239424647e+00),
+  fixed(1.08170616185517109997e+00),
+  fixed(1.08102353465411993305e+00),
+  fixed(1.08034430902562084142e+00),
+  fixed(1.07966847536832744048e+00),
+  fixed(1.07899602414280937346e+00),
+  fixed(1.07832694587120081486e+00),
+  fixed(1.07766123113684875179e+00),
+  fixed(1.07699887058396792661e+00),
+  fixed(1.07633985491729666784e+00),
+  fixed(1.07568417490175405327e+00),
+  fixed(1.07503182136210395647e+00),
+  fixed(1.07438278518261842720e+00),
+  fixed(1.07373705730674329217e+00),
+  fixed(1.07309462873677263772e+00),
+  fixed(1.07245549053351751922e+00),
+  fixed(1.07181963381598399643e+00),
+  fixed(1.07118704976105139082e+00),
+  fixed(1.07055772960315076503e+00),
+  fixed(1.06993166463395272814e+00),
+  fixed(1.06930884620205080004e+00),
+  fixed(1.06868926571265121517e+00),
+  fixed(1.06807291462726494657e+00),
+  fixed(1.06745978446340217261e+00),
+  fixed(1.06684986679426674350e+00),
+  fixed(1.06624315324845841957e+00),
+  fixed(1.06563963550967355509e+00),
+  fixed(1.06503930531640822466e+00),
+  fixed(1.06444215446166734473e+00),
+  fixed(1.06384817479267046458e+00),
+  fixed(1.06325735821056777120e+00),
+  fixed(1.06266969667015009904e+00),
+  fixed(1.06208518217956826568e+00),
+  fixed(1.06150380680005063105e+00),
+  fixed(1.06092556264562420942e+00),
+  fixed(1.06035044188283822386e+00),
+  fixed(1.05977843673049076934e+00),
+  fixed(1.05920953945935614193e+00),
+  fixed(1.05864374239191572080e+00),
+  fixed(1.05808103790209062645e+00),
+  fixed(1.05752141841497548924e+00),
+  fixed(1.05696487640657776907e+00),
+  fixed(1.05641140440355596475e+00),
+  fixed(1.05586099498296070998e+00),
+  fixed(1.05531364077197897799e+00),
+  fixed(1.05476933444768117276e+00),
+  fixed(1.05422806873676599970e+00),
+  fixed(1.05368983641531466233e+00),
+  fixed(1.05315463030853995186e+00),
+  fixed(1.05262244329054199810e+00),
+  fixed(1.05209326828406557475e+00),
+  fixed(1.05156709826025518417e+00),
+  fixed(1.05104392623841991217e+00),
+  fixed(1.05052374528579361979e+00),
+  fixed(1.05000654851729890993e+00),
+  fixed(1.04949232909531553481e+00),
+  fixed(1.04898108022944813733e+00),
+  fixed(1.04847279517629554668e+00),
+  fixed(1.04796746723922540312e+00),
+  fixed(1.04746508976814678427e+00),
+  fixed(1.04696565615928771642e+00),
+  fixed(1.04646915985497290791e+00),
+  fixed(1.04597559434340259266e+00),
+  fixed(1.04548495315843670284e+00),
+  fixed(1.04499722987937770924e+00),
+  fixed(1.04451241813075612619e+00),
+  fixed(1.04403051158211779281e+00),
+  fixed(1.04355150394781404088e+00),
+  fixed(1.04307538898679164063e+00),
+  fixed(1.04260216050238740948e+00),
+  fixed(1.04213181234212126647e+00),
+  fixed(1.04166433839749350554e+00),
+  fixed(1.04119973260378362312e+00),
+  fixed(1.04073798893984825753e+00),
+  fixed(1.04027910142792534565e+00),
+  fixed(1.03982306413343561502e+00),
+  fixed(1.03936987116478940507e+00),
+  fixed(1.03891951667319171193e+00),
+  fixed(1.03847199485245211825e+00),
+  fixed(1.03802729993879361281e+00),
+  fixed(1.03758542621066562894e+00),
+  fixed(1.03714636798855730504e+00),
+  fixed(1.03671011963481163320e+00),
+  fixed(1.03627667555344338268e+00),
+  fixed(1.03584603018995569101e+00),
+  fixed(1.03541817803116220631e+00),
+  fixed(1.03499311360500700907e+00),
+  fixed(1.03457083148038808673e+00),
+  fixed(1.03415132626698214047e+00),
+  fixed(1.03373459261507072426e+00),
+  fixed(1.03332062521536660604e+00),
+  fixed(1.03290941879884567989e+00),
+  fixed(1.03250096813657599171e+00),
+  fixed(1.03209526803954987351e+00),
+  fixed(1.03169231335851852016e+00),
+  fixed(1.03129209898382634414e+00),
+  fixed(1.03089461984524910498e+00),
+  fixed(1.03049987091183070653e+00),
+  fixed(1.03010784719172354684e+00),
+  fixed(1.02971854373202975630e+00),
+  fixed(1.02933195561864354595e+00),
+  fixed(1.02894807797609466604e+00),
+  fixed(1.02856690596739497323e+00),
+  fixed(1.02818843479388433160e+00),
+  fixed(1.02781265969507917823e+00),
+  fixed(1.02743957594852242110e+00),
+  fixed(1.02706917886963378095e+00),
+  fixed(1.02670146381156235371e+00),
+  fixed(1.02633642616504117129e+00),
+  fixed(1.02597406135824131823e+00),
+  fixed(1.02561436485662826890e+00),
+  fixed(1.02525733216282088911e+00),
+  fixed(1.02490295881644954967e+00),
+  fixed(1.02455124039401623826e+00),
+  fixed(1.02420217250875800197e+00),
+  fixed(1.02385575081050794743e+00),
+  fixed(1.02351197098556112586e+00),
+  fixed(1.02317082875653908580e+00),
+  fixed(1.02283231988225797870e+00),
+  fixed(1.02249644015759599824e+00),
+  fixed(1.02216318541336237402e+00),
+  fixed(1.02183255151616969592e+00),
+  fixed(1.02150453436830468412e+00),
+  fixed(1.02117912990760073555e+00),
+  fixed(1.02085633410731468906e+00),
+  fixed(1.02053614297600026006e+00),
+  fixed(1.02021855255738636004e+00),
+  fixed(1.01990355893025452794e+00),
+  fixed(1.01959115820831858201e+00),
+  fixed(1.01928134654010449367e+00),
+  fixed(1.01897412010883359201e+00),
+  fixed(1.01866947513230421407e+00),
+  fixed(1.01836740786277579751e+00),
+  fixed(1.01806791458685541585e+00),
+  fixed(1.01777099162538209320e+00),
+  fixed(1.01747663533331644814e+00),
+  fixed(1.01718484209962856113e+00),
+  fixed(1.01689560834718761839e+00),
+  fixed(1.01660893053265377617e+00),
+  fixed(1.01632480514636935887e+00),
+  fixed(1.01604322871225272173e+00),
+  fixed(1.01576419778769300173e+00),
+  fixed(1.01548770896344442427e+00),
+  fixed(1.01521375886352438478e+00),
+  fixed(1.01494234414511064202e+00),
+  fixed(1.01467346149843962166e+00),
+  fixed(1.01440710764670694033e+00),
+  fixed(1.01414327934596837366e+00),
+  fixed(1.01388197338504237877e+00),
+  fixed(1.01362318658541239458e+00),
+  fixed(1.01336691580113091860e+00),
+  fixed(1.01311315791872647019e+00),
+  fixed(1.01286190985710833345e+00),
+  fixed(1.01261316856747485282e+00),
+  fixed(1.01236693103322106246e+00),
+  fixed(1.01212319426984942439e+00),
+  fixed(1.01188195532487923423e+00),
+  fixed(1.01164321127775891362e+00),
+  fixed(1.01140695923977852466e+00),
+  fixed(1.01117319635398295041e+00),
+  fixed(1.01094191979508729595e+00),
+  fixed(1.01071312676939206732e+00),
+  fixed(1.01048681451469946069e+00),
+  fixed(1.01026298030023209407e+00),
+  fixed(1.01004162142655129486e+00),
+  fixed(1.00982273522547605360e+00),
+  fixed(1.00960631906000464220e+00),
+  fixed(1.00939237032423534401e+00),
+  fixed(1.00918088644329073666e+00),
+  fixed(1.00897186487323908821e+00),
+  fixed(1.00876530310102063837e+00),
+  fixed(1.00856119864437232536e+00),
+  fixed(1.00835954905175495533e+00),
+  fixed(1.00816035190227926144e+00),
+  fixed(1.00796360480563707007e+00),
+  fixed(1.00776930540202713793e+00),
+  fixed(1.00757745136208853864e+00),
+  fixed(1.00738804038683049669e+00),
+  fixed(1.00720107020756444172e+00),
+  fixed(1.00701653858583806134e+00),
+  fixed(1.00683444331336846567e+00),
+  fixed(1.00665478221197823849e+00),
+  fixed(1.00647755313353015616e+00),
+  fixed(1.00630275395986523712e+00),
+  fixed(1.00613038260273945923e+00),
+  fixed(1.00596043700376358565e+00),
+  fixed(1.00579291513434165850e+00),
+  fixed(1.00562781499561260112e+00),
+  fixed(1.00546513461839071013e+00),
+  fixed(1.00530487206310836790e+00),
+  fixed(1.00514702541975964323e+00),
+  fixed(1.00499159280784411408e+00),
+  fixed(1.00483857237631135639e+00),
+  fixed(1.00468796230350809751e+00),
+  fixed(1.00453976079712337111e+00),
+  fixed(1.00439396609413811312e+00),
+  fixed(1.00425057646077209306e+00),
+  fixed(1.00410959019243439805e+00),
+  fixed(1.00397100561367280669e+00),
+  fixed(1.00383482107812649353e+00),
+  fixed(1.00370103496847584701e+00),
+  fixed(1.00356964569639806051e+00),
+  fixed(1.00344065170251850461e+00),
+  fixed(1.00331405145636720633e+00),
+  fixed(1.00318984345633355204e+00),
+  fixed(1.00306802622962210059e+00),
+  fixed(1.00294859833221083889e+00),
+  fixed(1.00283155834880943758e+00),
+  fixed(1.00271690489281684044e+00),
+  fixed(1.00260463660628218463e+00),
+  fixed(1.00249475215986549870e+00),
+  fixed(1.00238725025279817871e+00),
+  fixed(1.00228212961284612881e+00),
+  fixed(1.00217938899627312388e+00),
+  fixed(1.00207902718780395013e+00),
+  fixed(1.00198104300059021021e+00),
+  fixed(1.00188543527617457407e+00),
+  fixed(1.00179220288445947062e+00),
+  fixed(1.00170134472367222678e+00),
+  fixed(1.00161285972033464731e+00),
+  fixed(1.00152674682923126248e+00),
+  fixed(1.00144300503337979613e+00),
+  fixed(1.00136163334400118963e+00),
+  fixed(1.00128263080049095812e+00),
+  fixed(1.00120599647039254521e+00),
+  fixed(1.00113172944936956732e+00),
+  fixed(1.00105982886117916841e+00),
+  fixed(1.00099029385764870526e+00),
+  fixed(1.00092312361864910208e+00),
+  fixed(1.00085831735207242410e+00),
+  fixed(1.00079587429380922892e+00),
+  fixed(1.00073579370772569597e+00),
+  fixed(1.00067807488564342044e+00),
+  fixed(1.00062271714731787497e+00),
+  fixed(1.00056971984041997992e+00),
+  fixed(1.00051908234051700752e+00),
+  fixed(1.00047080405105370815e+00),
+  fixed(1.00042488440333654509e+00),
+  fixed(1.00038132285651637510e+00),
+  fixed(1.00034011889757334934e+00),
+  fixed(1.00030127204130203644e+00),
+  fixed(1.00026478183029721158e+00),
+  fixed(1.00023064783494120000e+00),
+  fixed(1.00019886965339122042e+00),
+  fixed(1.00016944691156806080e+00),
+  fixed(1.00014237926314475402e+00),
+  fixed(1.00011766638953769615e+00),
+  fixed(1.00009530799989621030e+00),
+  fixed(1.00007530383109544125e+00),
+  fixed(1.00005765364772747361e+00),
+  fixed(1.00004235724209600278e+00),
+  fixed(1.00002941443420945156e+00),
+  fixed(1.00001882507177564108e+00),
+  fixed(1.00001058903019801605e+00),
+  fixed(1.00000470621257209203e+00),
+  fixed(1.00000117654968234682e+00),
+#endif
+};
+#define THERMALRECENCY_SIZE 60
+#ifdef FIXED_MATH
+const unsigned THERMALRECENCY[] = {
+  268435456,
+  267542160,
+  265916515,
+  263826051,
+  261371778,
+  258615576,
+  255601784,
+  252364961,
+  248933495,
+  245331534,
+  241580135,
+  237697990,
+  233701914,
+  229607181,
+  225427775,
+  221176567,
+  216865460,
+  212505494,
+  208106934,
+  203679340,
+  199231626,
+  194772108,
+  190308544,
+  185848175,
+  181397750,
+  176963559,
+  172551453,
+  168166873,
+  163814865,
+  159500102,
+  155226903,
+  150999246,
+  146820787,
+  142694874,
+  138624561,
+  134612622,
+  130661563,
+  126773638,
+  122950855,
+  119194994,
+  115507614,
+  111890067,
+  108343506,
+  104868897,
+  101467027,
+  98138515,
+  94883823,
+  91703261,
+  88596998,
+  85565072,
+  82607394,
+  79723760,
+  76913857,
+  74177268,
+  71513485,
+  68921908,
+  66401860,
+  63952585,
+  61573260,
+  59263000,
+#else
+const fixed THERMALRECENCY[60] = {  fixed(1.00000000000000000000e+00),
+  fixed(9.96672216054523274487e-01),
+  fixed(9.90616214681808493481e-01),
+  fixed(9.82828629635954520438e-01),
+  fixed(9.73685749353145002516e-01),
+  fixed(9.63418097794111250032e-01),
+  fixed(9.52190846893950504359e-01),
+  fixed(9.40132743444214158401e-01),
+  fixed(9.27349535694774296246e-01),
+  fixed(9.13931185271228185840e-01),
+  fixed(8.99956135355975406220e-01),
+  fixed(8.85494019453154868060e-01),
+  fixed(8.70607474358073507581e-01),
+  fixed(8.55353405851154602324e-01),
+  fixed(8.39783903441106427401e-01),
+  fixed(8.23946921081774252826e-01),
+  fixed(8.07886796729991196742e-01),
+  fixed(7.91644657897610737329e-01),
+  fixed(7.75258744694439339007e-01),
+  fixed(7.58764671977439242312e-01),
+  fixed(7.42195645789349045529e-01),
+  fixed(7.25582644968842727096e-01),
+  fixed(7.08954575869813363731e-01),
+  fixed(6.92338406069129774778e-01),
+  fixed(6.75759281476658757448e-01),
+  fixed(6.59240630200443766817e-01),
+  fixed(6.42804255740527574758e-01),
+  fixed(6.26470421504670471613e-01),
+  fixed(6.10257928202054156230e-01),
+  fixed(5.94184185338170078872e-01),
+  fixed(5.78265277778126751684e-01),
+  fixed(5.62516028147110991320e-01),
+  fixed(5.46950055681600377788e-01),
+  fixed(5.31579832022864517960e-01),
+  fixed(5.16416734347669215133e-01),
+  fixed(5.01471096154222362173e-01),
+  fixed(4.86752255959971624755e-01),
+  fixed(4.72268604118591783791e-01),
+  fixed(4.58027627923880964467e-01),
+  fixed(4.44035955136351023764e-01),
+  fixed(4.30299396042538251361e-01),
+  fixed(4.16822984136271001976e-01),
+  fixed(4.03611015494365843459e-01),
+  fixed(3.90667086905724547652e-01),
+  fixed(3.77994132801971804980e-01),
+  fixed(3.65594461029116801765e-01),
+  fixed(3.53469787492844078614e-01),
+  fixed(3.41621269704622088081e-01),
+  fixed(3.30049539251602797041e-01),
+  fixed(3.18754733210045548830e-01),
+  fixed(3.07736524519568177549e-01),
+  fixed(2.96994151333752509636e-01),
+  fixed(2.86526445361393711231e-01),
+  fixed(2.76331859211876806892e-01),
+  fixed(2.66408492757710169130e-01),
+  fixed(2.56754118527071806266e-01),
+  fixed(2.47366206139267019726e-01),
+  fixed(2.38241945796217741149e-01),
+  fixed(2.29378270843448556215e-01),
+  fixed(2.20771879414479149650e-01),
+#endif
+};
@@ -46,11 +46,11 @@ namespace ActionInterface {
 void
 XCSoarInterface::ReceiveGPS()
 {
+  ReadBlackboardBasic(device_blackboard->PublishedBasic());
+
   {
     ScopeLock protect(device_blackboard->mutex);
 
-    ReadBlackboardBasic(device_blackboard->Basic());
-
     const NMEAInfo &real = device_blackboard->RealState();
     Private::movement_detected = real.alive && real.gps.real &&
       real.MovementDetected();
@@ -66,10 +66,11 @@ XCSoarInterface::ReceiveGPS()
 void
 XCSoarInterface::ReceiveCalculated()
 {
+  ReadBlackboardCalculated(device_blackboard->PublishedCalculated());
+
   {
     ScopeLock protect(device_blackboard->mutex);
 
-    ReadBlackboardCalculated(device_blackboard->Calculated());
     device_blackboard->ReadComputerSettings(GetComputerSettings());
   }
 
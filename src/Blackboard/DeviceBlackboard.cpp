@@ -46,8 +46,18 @@ DeviceBlackboard::DeviceBlackboard()
 
   real_data = simulator_data = replay_data = gps_info;
 
+  for (auto &i : flarm_stamps) {
+    i.newest.Clear();
+    i.n_traffic = 0;
+  }
+
+  merge_bytes = 0;
+
   simulator.Init(simulator_data);
 
+  published_basic.Write(gps_info);
+  published_calculated.Write(calculated_info);
+
   real_clock.Reset();
   replay_clock.Reset();
 }
@@ -180,6 +190,7 @@ void
 DeviceBlackboard::ReadBlackboard(const DerivedInfo &derived_info)
 {
   calculated_info = derived_info;
+  published_calculated.Write(calculated_info);
 }
 
 /**
@@ -222,21 +233,86 @@ DeviceBlackboard::ScheduleMerge()
   TriggerMergeThread();
 }
 
+/**
+ * The payload is not compared: the parser updates it together with
+ * its #Validity, and comparing it would cost more than copying it.
+ */
+DeviceBlackboard::FlarmStamp
+DeviceBlackboard::GetFlarmStamp(const FlarmData &flarm)
+{
+  FlarmStamp stamp;
+  stamp.newest = flarm.error.available;
+
+  const Validity *validities[] = {
+    &flarm.version.available,
+    &flarm.status.available,
+    &flarm.traffic.new_traffic,
+  };
+
+  for (const Validity *v : validities)
+    if (v->Modified(stamp.newest))
+      stamp.newest = *v;
+
+  for (const auto &traffic : flarm.traffic.list)
+    if (traffic.valid.Modified(stamp.newest))
+      stamp.newest = traffic.valid;
+
+  stamp.n_traffic = flarm.traffic.list.size();
+  return stamp;
+}
+
+gcc_pure
+static unsigned
+GetFlarmSize(const FlarmData &flarm)
+{
+  return sizeof(flarm) - sizeof(flarm.traffic.list) +
+    flarm.traffic.list.size() * sizeof(flarm.traffic.list[0]);
+}
+
 void
 DeviceBlackboard::Merge()
 {
   NMEAInfo &basic = SetBasic();
 
-  real_data.Reset();
+  real_data.ResetExceptFlarm();
+  unsigned n_bytes = 0;
+
+  bool flarm_modified = false;
   for (unsigned i = 0; i < unsigned(NUMDEV); ++i) {
-    if (!per_device_data[i].alive)
-      continue;
+    NMEAInfo &device = per_device_data[i];
+
+    FlarmStamp flarm_stamp;
+    if (device.alive) {
+      device.UpdateClock();
+      device.Expire();
+      real_data.ComplementExceptFlarm(device);
+      n_bytes += sizeof(device) - sizeof(device.flarm);
+
+      flarm_stamp = GetFlarmStamp(device.flarm);
+    } else {
+      flarm_stamp.newest.Clear();
+      flarm_stamp.n_traffic = 0;
+    }
+
+    if (flarm_stamp != flarm_stamps[i]) {
+      flarm_stamps[i] = flarm_stamp;
+      flarm_modified = true;
+    }
+  }
 
-    per_device_data[i].UpdateClock();
-    per_device_data[i].Expire();
-    real_data.Complement(per_device_data[i]);
+  if (flarm_modified) {
+    real_data.flarm.Clear();
+    for (unsigned i = 0; i < unsigned(NUMDEV); ++i) {
+      const NMEAInfo &device = per_device_data[i];
+      if (device.alive) {
+        real_data.flarm.Complement(device.flarm);
+        n_bytes += GetFlarmSize(device.flarm);
+      }
+    }
   }
 
+  merge_bytes.store(n_bytes, std::memory_order_relaxed);
+
   real_clock.Normalise(real_data);
 
   if (replay_data.alive) {
@@ -29,8 +29,11 @@ Copyright_License {
 #include "Device/Simulator.hpp"
 #include "Device/List.hpp"
 #include "Thread/Mutex.hpp"
+#include "Thread/SeqLock.hpp"
 #include "Time/WrapClock.hpp"
+#include "NMEA/Validity.hpp"
 
+#include <atomic>
 #include <cassert>
 
 class AtmosphericPressure;
@@ -71,11 +74,55 @@ class DeviceBlackboard:
    */
   NMEAInfo replay_data;
 
+  /**
+   * Identifies the state of a device's #FlarmData: the newest of its
+   * time stamps and the number of traffic objects.  The parser
+   * updates a time stamp with each modification, so the data has not
+   * changed if both are equal.
+   */
+  struct FlarmStamp {
+    Validity newest;
+    unsigned n_traffic;
+
+    bool operator==(const FlarmStamp &other) const {
+      return newest == other.newest && n_traffic == other.n_traffic;
+    }
+
+    bool operator!=(const FlarmStamp &other) const {
+      return !(*this == other);
+    }
+  };
+
+  /**
+   * The #FlarmStamp of each device as of the last Merge() (cleared
+   * if the device was not alive).  If none of them has changed, the
+   * FLARM part of #real_data is still up to date and Merge() skips
+   * it.
+   */
+  FlarmStamp flarm_stamps[NUMDEV];
+
+  /**
+   * An estimate of the number of bytes of device data which were
+   * merged into #real_data by the last Merge() call: the size of the
+   * non-FLARM attributes of each alive device, plus the occupied part
+   * of the FLARM data if it was merged.  It is atomic because the
+   * user interface reads it without locking the blackboard.
+   */
+  std::atomic<unsigned> merge_bytes;
+
   /**
    * Clock management for #real_data and #replay_data.
    */
   WrapClock real_clock, replay_clock;
 
+  /**
+   * Copies of #gps_info and #calculated_info which can be read
+   * without holding #mutex.  They are updated by PublishBasic() and
+   * ReadBlackboard().
+   */
+  SeqLock<MoreData> published_basic;
+  SeqLock<DerivedInfo> published_calculated;
+
 public:
   Mutex mutex;
 
@@ -85,9 +132,23 @@ public:
   void ReadComputerSettings(const ComputerSettings &settings);
 
 protected:
+  /**
+   * Determine the #FlarmStamp of the given data.
+   */
+  gcc_pure
+  static FlarmStamp GetFlarmStamp(const FlarmData &flarm);
+
   NMEAInfo &SetBasic() { return gps_info; }
   MoreData &SetMoreData() { return gps_info; }
 
+  /**
+   * Make the current #gps_info available to PublishedBasic() readers.
+   * Caller must lock the blackboard.
+   */
+  void PublishBasic() {
+    published_basic.Write(gps_info);
+  }
+
 public:
   const NMEAInfo &RealState(unsigned i) const {
     assert(i < NUMDEV);
@@ -103,8 +164,34 @@ public:
   NMEAInfo &SetReplayState() { return replay_data; }
 
 public:
+  /**
+   * The most recent #gps_info, published by the MergeThread.  Reading
+   * it does not require locking the blackboard.
+   */
+  const SeqLock<MoreData> &PublishedBasic() const {
+    return published_basic;
+  }
+
+  /**
+   * The most recent #calculated_info, published by the
+   * CalculationThread.  Reading it does not require locking the
+   * blackboard.
+   */
+  const SeqLock<DerivedInfo> &PublishedCalculated() const {
+    return published_calculated;
+  }
+
   const NMEAInfo &RealState() const { return real_data; }
 
+  /**
+   * Returns the estimated number of bytes merged by the last Merge()
+   * call.  It is only used for diagnostics.  This method does not
+   * need to lock the blackboard.
+   */
+  unsigned GetMergeBytes() const {
+    return merge_bytes.load(std::memory_order_relaxed);
+  }
+
   /**
    * Is the specified device a FLARM?
    *
@@ -21,6 +21,7 @@ Copyright_License {
 }
 */
 #include "InterfaceBlackboard.hpp"
+#include "Thread/SeqLock.hpp"
 
 void
 InterfaceBlackboard::ReadBlackboardCalculated(const DerivedInfo &derived_info)
@@ -34,6 +35,18 @@ InterfaceBlackboard::ReadBlackboardBasic(const MoreData &nmea_info)
   gps_info = nmea_info;
 }
 
+void
+InterfaceBlackboard::ReadBlackboardCalculated(const SeqLock<DerivedInfo> &derived_info)
+{
+  derived_info.Read(calculated_info);
+}
+
+void
+InterfaceBlackboard::ReadBlackboardBasic(const SeqLock<MoreData> &nmea_info)
+{
+  nmea_info.Read(gps_info);
+}
+
 void
 InterfaceBlackboard::ReadComputerSettings(const ComputerSettings
 					  &settings)
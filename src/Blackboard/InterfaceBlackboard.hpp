@@ -27,11 +27,15 @@ Copyright_License {
 #include "LiveBlackboard.hpp"
 #include "Compiler.h"
 
+template<typename T> class SeqLock;
+
 class InterfaceBlackboard : public LiveBlackboard
 {
 public:
   void ReadBlackboardBasic(const MoreData &nmea_info);
   void ReadBlackboardCalculated(const DerivedInfo &derived_info);
+  void ReadBlackboardBasic(const SeqLock<MoreData> &nmea_info);
+  void ReadBlackboardCalculated(const SeqLock<DerivedInfo> &derived_info);
 
   gcc_const
   SystemSettings &SetSystemSettings() {
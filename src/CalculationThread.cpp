@@ -65,17 +65,15 @@ CalculationThread::Tick()
   const Validity previous_warning =
     glide_computer.Calculated().airspace_warnings.latest;
 
-  bool gps_updated;
-
   // update and transfer master info to glide computer
-  {
-    ScopeLock protect(device_blackboard->mutex);
+  const Validity previous_location =
+    glide_computer.Basic().location_available;
 
-    gps_updated = device_blackboard->Basic().location_available.Modified(glide_computer.Basic().location_available);
+  // Copy data from DeviceBlackboard to GlideComputerBlackboard
+  glide_computer.ReadBlackboard(device_blackboard->PublishedBasic());
 
-    // Copy data from DeviceBlackboard to GlideComputerBlackboard
-    glide_computer.ReadBlackboard(device_blackboard->Basic());
-  }
+  bool gps_updated =
+    glide_computer.Basic().location_available.Modified(previous_location);
 
   bool force;
   {
@@ -23,6 +23,7 @@ Copyright_License {
 */
 
 #include "GlideComputerBlackboard.hpp"
+#include "Thread/SeqLock.hpp"
 
 /**
  * Resets the GlideComputerBlackboard
@@ -80,6 +81,17 @@ GlideComputerBlackboard::ReadBlackboard(const MoreData &nmea_info)
   gps_info = nmea_info;
 }
 
+/**
+ * Retrieves GPS data published by the DeviceBlackboard, without
+ * locking it
+ * @param nmea_info New GPS data
+ */
+void
+GlideComputerBlackboard::ReadBlackboard(const SeqLock<MoreData> &nmea_info)
+{
+  nmea_info.Read(gps_info);
+}
+
 /**
  * Retrieves settings from the DeviceBlackboard
  * @param settings New settings
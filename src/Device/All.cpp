@@ -98,6 +98,13 @@ AllDevicesPutQNH(const AtmosphericPressure &pres,
     i->PutQNH(pres, env);
 }
 
+void
+AllDevicesConsumeSamples()
+{
+  for (DeviceDescriptor *i : device_list)
+    i->ConsumeSamples();
+}
+
 void
 AllDevicesNotifySensorUpdate(const MoreData &basic)
 {
@@ -66,6 +66,13 @@ AllDevicesPutStandbyFrequency(RadioFrequency frequency,
 void
 AllDevicesPutQNH(const AtmosphericPressure &pres, OperationEnvironment &env);
 
+/**
+ * Apply the samples queued by the drivers to the DeviceBlackboard.
+ * Caller must lock the blackboard.
+ */
+void
+AllDevicesConsumeSamples();
+
 void
 AllDevicesNotifySensorUpdate(const MoreData &basic);
 
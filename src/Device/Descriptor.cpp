@@ -27,13 +27,16 @@ Copyright_License {
 #include "Driver/FLARM/Device.hpp"
 #include "Driver/LX/Internal.hpp"
 #include "Device/Util/NMEAWriter.hpp"
+#include "Device/Util/NMEAOutputQueue.hpp"
 #include "Device/Register.hpp"
 #include "Blackboard/DeviceBlackboard.hpp"
 #include "Components.hpp"
 #include "Port/ConfiguredPort.hpp"
 #include "Port/DumpPort.hpp"
 #include "NMEA/Info.hpp"
+#include "NMEA/SentenceKey.hpp"
 #include "Thread/Mutex.hpp"
+#include "Thread/WorkerThread.hpp"
 #include "Util/StringUtil.hpp"
 #include "Logger/NMEALogger.hpp"
 #include "Language/Language.hpp"
@@ -84,6 +87,23 @@ struct ScopeReturnDevice {
   }
 };
 
+/**
+ * Calls DeviceDescriptor::FlushSettings() after Trigger().
+ */
+class DeviceDescriptor::SettingsThread final : public WorkerThread {
+  DeviceDescriptor &device;
+
+public:
+  explicit SettingsThread(DeviceDescriptor &_device)
+    :WorkerThread("DeviceSettings"), device(_device) {}
+
+protected:
+  /* virtual methods from class WorkerThread */
+  virtual void Tick() override {
+    device.FlushSettings();
+  }
+};
+
 class OpenDeviceJob final : public Job {
   DeviceDescriptor &device;
 
@@ -99,7 +119,8 @@ public:
 DeviceDescriptor::DeviceDescriptor(unsigned _index)
   :index(_index),
    open_job(NULL),
-   port(NULL), monitor(NULL), dispatcher(NULL),
+   port(NULL), output_queue(nullptr), settings_thread(nullptr),
+   monitor(NULL), dispatcher(NULL),
    driver(NULL), device(NULL),
 #if defined(ANDROID) || defined(__APPLE__)
    internal_sensors(NULL),
@@ -110,9 +131,10 @@ DeviceDescriptor::DeviceDescriptor(unsigned _index)
    voltage(nullptr),
 #endif
    n_failures(0u),
-   ticker(false), borrowed(false)
+   ticker(false), borrowed(false), writing_settings(false)
 {
   config.Clear();
+  pending_settings.Clear();
 
 #ifdef ANDROID
   for (unsigned i=0; i<sizeof i2cbaro/sizeof i2cbaro[0]; i++)
@@ -250,9 +272,19 @@ DeviceDescriptor::OpenOnPort(DumpPort *_port, OperationEnvironment &env)
   } else
     port->StartRxThread();
 
+  if (IsNMEAOut()) {
+    NMEAOutputQueue *queue = new NMEAOutputQueue(*port);
+    queue->Start();
+
+    const ScopeLock protect(mutex);
+    output_queue = queue;
+  }
+
   EnableNMEA(env);
 
   if (env.IsCancelled()) {
+    DeleteOutputQueue();
+
     /* the caller is responsible for freeing the port on error */
     port = nullptr;
     delete device;
@@ -260,6 +292,18 @@ DeviceDescriptor::OpenOnPort(DumpPort *_port, OperationEnvironment &env)
     return false;
   }
 
+  if (device != nullptr) {
+    SettingsThread *thread = new SettingsThread(*this);
+    thread->Start();
+
+    const ScopeLock protect(mutex);
+    settings_thread = thread;
+
+    /* send the values which were set while the device was opened */
+    if (!pending_settings.IsEmpty())
+      thread->Trigger();
+  }
+
   return true;
 }
 
@@ -488,6 +532,10 @@ DeviceDescriptor::Close()
 
 #endif
 
+  /* the settings thread uses the Device object without holding the
+     mutex; stop it first */
+  DeleteSettingsThread();
+
   /* safely delete the Device object */
   Device *old_device = device;
 
@@ -501,6 +549,8 @@ DeviceDescriptor::Close()
 
   delete old_device;
 
+  DeleteOutputQueue();
+
   Port *old_port = port;
   port = NULL;
   delete old_port;
@@ -640,6 +690,14 @@ DeviceDescriptor::Borrow()
   if (!CanBorrow())
     return false;
 
+  const ScopeLock protect(mutex);
+
+  /* let the settings thread finish the setting it is sending
+     already; it will not begin another one while the device is
+     borrowed */
+  while (writing_settings)
+    settings_cond.Wait(mutex);
+
   borrowed = true;
   return true;
 }
@@ -650,7 +708,16 @@ DeviceDescriptor::Return()
   assert(InMainThread());
   assert(IsBorrowed());
 
-  borrowed = false;
+  {
+    const ScopeLock protect(mutex);
+    borrowed = false;
+
+    /* send the values which were set while the device was
+       borrowed */
+    if (settings_thread != nullptr && !pending_settings.IsEmpty())
+      settings_thread->Trigger();
+  }
+
   assert(!IsOccupied());
 
   /* if the caller has disabled the NMEA while the device was
@@ -704,17 +771,180 @@ DeviceDescriptor::ParseNMEA(const char *line, NMEAInfo &info)
   return false;
 }
 
+void
+DeviceDescriptor::DeleteOutputQueue()
+{
+  NMEAOutputQueue *queue;
+
+  {
+    const ScopeLock protect(mutex);
+    queue = output_queue;
+    output_queue = nullptr;
+  }
+
+  if (queue == nullptr)
+    return;
+
+  queue->Stop();
+  delete queue;
+}
+
+void
+DeviceDescriptor::DeleteSettingsThread()
+{
+  SettingsThread *thread;
+
+  {
+    const ScopeLock protect(mutex);
+    thread = settings_thread;
+    settings_thread = nullptr;
+    pending_settings.Clear();
+  }
+
+  if (thread == nullptr)
+    return;
+
+  /* this waits for the current FlushSettings() call to return */
+  thread->BeginStop();
+  thread->Join();
+  delete thread;
+}
+
+void
+DeviceDescriptor::FlushSettings()
+{
+  PendingSettings settings;
+
+  {
+    const ScopeLock protect(mutex);
+
+    if (borrowed || device == nullptr || pending_settings.IsEmpty())
+      /* Return() triggers the thread again */
+      return;
+
+    settings = pending_settings;
+    pending_settings.Clear();
+    writing_settings = true;
+  }
+
+  /* Close() stops this thread before it deletes the Device, and
+     Borrow() waits for #writing_settings to be cleared; therefore
+     the Device can be used without holding the mutex, which would
+     block the threads calling OnSensorUpdate() while the driver
+     waits for an acknowledgement */
+
+  NullOperationEnvironment env;
+
+  if (settings.mac_cready_available &&
+      !settings_sent.CompareMacCready(settings.mac_cready) &&
+      device->PutMacCready(settings.mac_cready, env)) {
+    ScopeLock protect(device_blackboard->mutex);
+    NMEAInfo &basic = device_blackboard->SetRealState(index);
+    settings_sent.mac_cready = settings.mac_cready;
+    settings_sent.mac_cready_available.Update(basic.clock);
+  }
+
+  if (settings.bugs_available &&
+      !settings_sent.CompareBugs(settings.bugs) &&
+      device->PutBugs(settings.bugs, env)) {
+    ScopeLock protect(device_blackboard->mutex);
+    NMEAInfo &basic = device_blackboard->SetRealState(index);
+    settings_sent.bugs = settings.bugs;
+    settings_sent.bugs_available.Update(basic.clock);
+  }
+
+  if (settings.ballast_available &&
+      !(settings_sent.CompareBallastFraction(settings.ballast_fraction) &&
+        settings_sent.CompareBallastOverload(settings.ballast_overload)) &&
+      device->PutBallast(settings.ballast_fraction,
+                         settings.ballast_overload, env)) {
+    ScopeLock protect(device_blackboard->mutex);
+    NMEAInfo &basic = device_blackboard->SetRealState(index);
+    settings_sent.ballast_fraction = settings.ballast_fraction;
+    settings_sent.ballast_fraction_available.Update(basic.clock);
+    settings_sent.ballast_overload = settings.ballast_overload;
+    settings_sent.ballast_overload_available.Update(basic.clock);
+  }
+
+  if (settings.qnh_available &&
+      !settings_sent.CompareQNH(settings.qnh) &&
+      device->PutQNH(settings.qnh, env)) {
+    ScopeLock protect(device_blackboard->mutex);
+    NMEAInfo &basic = device_blackboard->SetRealState(index);
+    settings_sent.qnh = settings.qnh;
+    settings_sent.qnh_available.Update(basic.clock);
+  }
+
+  /* some drivers leave NMEA mode to send a setting */
+  EnableNMEA(env);
+
+  const ScopeLock protect(mutex);
+  writing_settings = false;
+  settings_cond.Broadcast();
+}
+
+/**
+ * Determine the NMEAOutputQueue key for a forwarded line.  Only
+ * sentences which describe the current state (the position fix, the
+ * altitude) are replaced by newer ones; e.g. each "$PFLAA" describes
+ * a different aircraft, and "$GPGSV" is split into several parts.
+ * "$GNGSA" is sent once per constellation with the same address, so
+ * GSA is never replaced either.
+ */
+gcc_pure
+static uint64_t
+GetForwardKey(const char *line)
+{
+  if (line[0] != '$')
+    return 0;
+
+  const char *address = line + 1;
+  const char *comma = strchr(address, ',');
+  if (comma == nullptr)
+    return 0;
+
+  const size_t length = comma - address;
+  if (length == 5 && address[0] != 'P') {
+    /* skip the talker id, but keep it in the key, because different
+       talkers (e.g. GPS and GLONASS) are different sources */
+    switch (NMEASentenceKey(address + 2, 3)) {
+    case NMEASentenceKey("RMC"):
+    case NMEASentenceKey("GGA"):
+    case NMEASentenceKey("GLL"):
+    case NMEASentenceKey("VTG"):
+      return NMEASentenceKey(address, length);
+    }
+  }
+
+  switch (NMEASentenceKey(address, length)) {
+  case NMEASentenceKey("PGRMZ"):
+    return NMEASentenceKey("PGRMZ");
+  }
+
+  return 0;
+}
+
 void
 DeviceDescriptor::ForwardLine(const char *line)
 {
   /* XXX make this method thread-safe; this method can be called from
      any thread, and if the Port gets closed, bad things happen */
 
-  if (IsNMEAOut() && port != NULL) {
-    Port *p = port;
-    p->Write(line);
-    p->Write("\r\n");
-  }
+  if (output_queue != nullptr)
+    output_queue->Push(line, GetForwardKey(line));
+}
+
+NMEAOutputQueue::Statistics
+DeviceDescriptor::GetOutputStatistics() const
+{
+  const ScopeLock protect(mutex);
+
+  if (output_queue != nullptr)
+    return output_queue->GetStatistics();
+
+  NMEAOutputQueue::Statistics statistics;
+  statistics.Clear();
+  return statistics;
 }
 
 bool
@@ -748,22 +978,18 @@ DeviceDescriptor::PutMacCready(fixed value, OperationEnvironment &env)
 {
   assert(InMainThread());
 
-  if (device == NULL || settings_sent.CompareMacCready(value) ||
-      !config.sync_to_device)
+  if (!config.sync_to_device)
     return true;
 
-  if (!Borrow())
-    /* TODO: postpone until the borrowed device has been returned */
-    return false;
+  const ScopeLock protect(mutex);
+  if (device == nullptr)
+    return true;
 
-  ScopeReturnDevice restore(*this, env);
-  if (!device->PutMacCready(value, env))
-    return false;
+  pending_settings.mac_cready = value;
+  pending_settings.mac_cready_available = true;
 
-  ScopeLock protect(device_blackboard->mutex);
-  NMEAInfo &basic = device_blackboard->SetRealState(index);
-  settings_sent.mac_cready = value;
-  settings_sent.mac_cready_available.Update(basic.clock);
+  if (settings_thread != nullptr)
+    settings_thread->Trigger();
 
   return true;
 }
@@ -773,22 +999,18 @@ DeviceDescriptor::PutBugs(fixed value, OperationEnvironment &env)
 {
   assert(InMainThread());
 
-  if (device == NULL || settings_sent.CompareBugs(value) ||
-      !config.sync_to_device)
+  if (!config.sync_to_device)
     return true;
 
-  if (!Borrow())
-    /* TODO: postpone until the borrowed device has been returned */
-    return false;
+  const ScopeLock protect(mutex);
+  if (device == nullptr)
+    return true;
 
-  ScopeReturnDevice restore(*this, env);
-  if (!device->PutBugs(value, env))
-    return false;
+  pending_settings.bugs = value;
+  pending_settings.bugs_available = true;
 
-  ScopeLock protect(device_blackboard->mutex);
-  NMEAInfo &basic = device_blackboard->SetRealState(index);
-  settings_sent.bugs = value;
-  settings_sent.bugs_available.Update(basic.clock);
+  if (settings_thread != nullptr)
+    settings_thread->Trigger();
 
   return true;
 }
@@ -799,25 +1021,19 @@ DeviceDescriptor::PutBallast(fixed fraction, fixed overload,
 {
   assert(InMainThread());
 
-  if (device == NULL || !config.sync_to_device ||
-      (settings_sent.CompareBallastFraction(fraction) &&
-       settings_sent.CompareBallastOverload(overload)))
+  if (!config.sync_to_device)
     return true;
 
-  if (!Borrow())
-    /* TODO: postpone until the borrowed device has been returned */
-    return false;
+  const ScopeLock protect(mutex);
+  if (device == nullptr)
+    return true;
 
-  ScopeReturnDevice restore(*this, env);
-  if (!device->PutBallast(fraction, overload, env))
-    return false;
+  pending_settings.ballast_fraction = fraction;
+  pending_settings.ballast_overload = overload;
+  pending_settings.ballast_available = true;
 
-  ScopeLock protect(device_blackboard->mutex);
-  NMEAInfo &basic = device_blackboard->SetRealState(index);
-  settings_sent.ballast_fraction = fraction;
-  settings_sent.ballast_fraction_available.Update(basic.clock);
-  settings_sent.ballast_overload = overload;
-  settings_sent.ballast_overload_available.Update(basic.clock);
+  if (settings_thread != nullptr)
+    settings_thread->Trigger();
 
   return true;
 }
@@ -880,22 +1096,18 @@ DeviceDescriptor::PutQNH(const AtmosphericPressure &value,
 {
   assert(InMainThread());
 
-  if (device == NULL || settings_sent.CompareQNH(value) ||
-      !config.sync_to_device)
+  if (!config.sync_to_device)
     return true;
 
-  if (!Borrow())
-    /* TODO: postpone until the borrowed device has been returned */
-    return false;
+  const ScopeLock protect(mutex);
+  if (device == nullptr)
+    return true;
 
-  ScopeReturnDevice restore(*this, env);
-  if (!device->PutQNH(value, env))
-    return false;
+  pending_settings.qnh = value;
+  pending_settings.qnh_available = true;
 
-  ScopeLock protect(device_blackboard->mutex);
-  NMEAInfo &basic = device_blackboard->SetRealState(index);
-  settings_sent.qnh = value;
-  settings_sent.qnh_available.Update(basic.clock);
+  if (settings_thread != nullptr)
+    settings_thread->Trigger();
 
   return true;
 }
@@ -1027,6 +1239,21 @@ DeviceDescriptor::OnSysTicker()
   }
 }
 
+void
+DeviceDescriptor::ConsumeSamples()
+{
+  /* see OnSensorUpdate() */
+  const ScopeLock protect(mutex);
+
+  if (device == nullptr)
+    return;
+
+  NMEAInfo &basic = device_blackboard->SetRealState(index);
+  basic.UpdateClock();
+  if (device->ConsumeSamples(basic))
+    basic.alive.Update(basic.clock);
+}
+
 void
 DeviceDescriptor::OnSensorUpdate(const MoreData &basic)
 {
@@ -1108,6 +1335,13 @@ DeviceDescriptor::LineReceived(const char *line)
   if (dispatcher != NULL)
     dispatcher->LineReceived(line);
 
+  if (device != nullptr && device->QueueSample(line)) {
+    /* queued without locking the blackboard; the MergeThread will
+       apply it in ConsumeSamples() */
+    device_blackboard->ScheduleMerge();
+    return;
+  }
+
   if (ParseLine(line))
     device_blackboard->ScheduleMerge();
 }
@@ -27,6 +27,7 @@ Copyright_License {
 #include "Config.hpp"
 #include "IO/DataHandler.hpp"
 #include "Device/Util/LineSplitter.hpp"
+#include "Device/Util/NMEAOutputQueue.hpp"
 #include "Port/State.hpp"
 #include "Device/Parser.hpp"
 #include "RadioFrequency.hpp"
@@ -35,6 +36,7 @@ Copyright_License {
 #include "Job/Async.hpp"
 #include "Event/Notify.hpp"
 #include "Thread/Mutex.hpp"
+#include "Thread/Cond.hpp"
 #include "Thread/Debug.hpp"
 
 #include <assert.h>
@@ -65,9 +67,16 @@ class DeviceDescriptor final : private Notify, private PortLineSplitter {
   /**
    * This mutex protects modifications of the attribute "device".  If
    * you use the attribute "device" from a thread other than the main
-   * thread, you must hold this mutex.
+   * thread, you must hold this mutex.  It also protects the
+   * attributes "output_queue", "settings_thread", "pending_settings",
+   * "writing_settings" and "borrowed" (for writing).
    */
-  Mutex mutex;
+  mutable Mutex mutex;
+
+  /**
+   * Signalled when #writing_settings becomes false.
+   */
+  Cond settings_cond;
 
   /** the index of this device in the global list */
   const unsigned index;
@@ -97,6 +106,20 @@ class DeviceDescriptor final : private Notify, private PortLineSplitter {
    */
   DumpPort *port;
 
+  /**
+   * Sends the lines passed to ForwardLine() in a separate thread.
+   * Only created for NMEA out ports.
+   */
+  NMEAOutputQueue *output_queue;
+
+  class SettingsThread;
+
+  /**
+   * Sends the #pending_settings to the device.  Only exists while
+   * the port is open and there is a #device.
+   */
+  SettingsThread *settings_thread;
+
   /**
    * A handler that will receive all data, to display it on the
    * screen.  Can be set with SetMonitor().
@@ -173,6 +196,33 @@ class DeviceDescriptor final : private Notify, private PortLineSplitter {
    */
   ExternalSettings settings_received;
 
+  /**
+   * The newest values passed to PutMacCready(), PutBugs(),
+   * PutBallast() and PutQNH() which have not been sent to the device
+   * yet.  A new value replaces a pending one of the same kind, so a
+   * slow device gets only the latest value.
+   */
+  struct PendingSettings {
+    bool mac_cready_available, bugs_available;
+    bool ballast_available, qnh_available;
+
+    fixed mac_cready, bugs;
+    fixed ballast_fraction, ballast_overload;
+    AtmosphericPressure qnh;
+
+    void Clear() {
+      mac_cready_available = bugs_available = false;
+      ballast_available = qnh_available = false;
+    }
+
+    bool IsEmpty() const {
+      return !mac_cready_available && !bugs_available &&
+        !ballast_available && !qnh_available;
+    }
+  };
+
+  PendingSettings pending_settings;
+
   /**
    * Number of port failures since the device was last reset.
    *
@@ -195,12 +245,18 @@ class DeviceDescriptor final : private Notify, private PortLineSplitter {
    * True when somebody has "borrowed" the device.  Link timeouts are
    * disabled meanwhile.
    *
-   * This attribute is only accessed from the main thread.
+   * This attribute is only modified by the main thread.  The
+   * #settings_thread reads it.
    *
    * @see CanBorrow(), Borrow()
    */
   bool borrowed;
 
+  /**
+   * True while the #settings_thread uses the #device.
+   */
+  bool writing_settings;
+
 public:
   DeviceDescriptor(unsigned index);
   ~DeviceDescriptor() {
@@ -398,6 +454,8 @@ public:
   /**
    * "Borrow" the device.  The caller gets exclusive access, e.g. to
    * submit a task declaration.  Call Return() when you are done.
+   * If the #settings_thread is currently sending a setting, this
+   * method waits for it to finish.
    *
    * May only be called from the main thread.
    *
@@ -434,15 +492,32 @@ public:
   }
 
   /**
-   * Write a line to the device's port if it's a NMEA out port.
+   * Write a line to the device's port if it's a NMEA out port.  This
+   * method does not block; the line is queued and may be replaced by
+   * a newer sentence of the same type before it is sent.
    */
   void ForwardLine(const char *line);
 
+  /**
+   * Obtain the counters of the NMEA out queue.  They are all zero if
+   * this is not a NMEA out port.  May be called from any thread.
+   */
+  gcc_pure
+  NMEAOutputQueue::Statistics GetOutputStatistics() const;
+
   bool WriteNMEA(const char *line, OperationEnvironment &env);
 #ifdef _UNICODE
   bool WriteNMEA(const TCHAR *line, OperationEnvironment &env);
 #endif
 
+  /*
+   * PutMacCready(), PutBugs(), PutBallast() and PutQNH() do not
+   * block: they store the value in #pending_settings, and the
+   * #settings_thread sends it (and waits for the acknowledgement).
+   * They always return true.  The other Put*() methods borrow the
+   * device and write synchronously.
+   */
+
   bool PutMacCready(fixed mac_cready, OperationEnvironment &env);
   bool PutBugs(fixed bugs, OperationEnvironment &env);
   bool PutBallast(fixed fraction, fixed overload,
@@ -476,6 +551,12 @@ public:
 
   void OnSysTicker();
 
+  /**
+   * Wrapper for Driver::ConsumeSamples().  Caller must lock the
+   * blackboard.
+   */
+  void ConsumeSamples();
+
   /**
    * Wrapper for Driver::OnSensorUpdate().
    */
@@ -488,6 +569,23 @@ public:
                           const DerivedInfo &calculated);
 
 private:
+  /**
+   * Stop and delete the #output_queue (if any).
+   */
+  void DeleteOutputQueue();
+
+  /**
+   * Stop and delete the #settings_thread (if any), and discard the
+   * #pending_settings.
+   */
+  void DeleteSettingsThread();
+
+  /**
+   * Send the #pending_settings to the device.  Called by the
+   * #settings_thread.
+   */
+  void FlushSettings();
+
   bool ParseLine(const char *line);
 
   /* virtual methods from class Notify */
@@ -43,6 +43,18 @@ AbstractDevice::ParseNMEA(const char *line, struct NMEAInfo &info)
   return false;
 }
 
+bool
+AbstractDevice::QueueSample(const char *line)
+{
+  return false;
+}
+
+bool
+AbstractDevice::ConsumeSamples(NMEAInfo &info)
+{
+  return false;
+}
+
 bool
 AbstractDevice::PutMacCready(fixed MacCready, OperationEnvironment &env)
 {
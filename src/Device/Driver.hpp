@@ -76,6 +76,29 @@ public:
    */
   virtual bool ParseNMEA(const char *line, struct NMEAInfo &info) = 0;
 
+  /**
+   * Offer a line of input to a driver which receives high-rate
+   * sensor samples (e.g. 50 Hz pressure).  Unlike ParseNMEA(), this
+   * is called without holding the DeviceBlackboard mutex, and without
+   * access to the #NMEAInfo.  The driver may queue the sample in a
+   * lock-free buffer; ConsumeSamples() applies all queued samples in
+   * one batch.
+   *
+   * @return true when the line has been queued; if false, it will be
+   * passed to ParseNMEA()
+   */
+  virtual bool QueueSample(const char *line) = 0;
+
+  /**
+   * Apply all samples queued by QueueSample().  This method is
+   * invoked by #MergeThread before each merge, with the
+   * DeviceBlackboard mutex locked.
+   *
+   * @param info destination for sensor values
+   * @return true if at least one sample has been applied
+   */
+  virtual bool ConsumeSamples(struct NMEAInfo &info) = 0;
+
   /**
    * Send the new MacCready value to the device.
    *
@@ -241,6 +264,9 @@ public:
 
   virtual bool ParseNMEA(const char *line, struct NMEAInfo &info) override;
 
+  virtual bool QueueSample(const char *line) override;
+  virtual bool ConsumeSamples(struct NMEAInfo &info) override;
+
   virtual bool PutMacCready(fixed MacCready, OperationEnvironment &env) override;
   virtual bool PutBugs(fixed bugs, OperationEnvironment &env) override;
   virtual bool PutBallast(fixed fraction, fixed overload,
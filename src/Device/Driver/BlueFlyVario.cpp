@@ -25,21 +25,35 @@ Copyright_License {
 #include "Device/Driver.hpp"
 #include "Math/KalmanFilter1d.hpp"
 #include "NMEA/Info.hpp"
+#include "Thread/SPSCRingBuffer.hpp"
 
 #include <stdlib.h>
+#include <string.h>
 
 class BlueFlyDevice : public AbstractDevice {
+  /**
+   * Pressure samples [Pa] received by QueueSample(), waiting for
+   * ConsumeSamples().  The BlueFly sends up to 50 per second; this
+   * buffers 2 seconds.
+   */
+  SPSCRingBuffer<long, 128> pressure_samples;
+
 public:
   BlueFlyDevice();
 
   void LinkTimeout() override;
 
   virtual bool ParseNMEA(const char *line, struct NMEAInfo &info);
+  bool QueueSample(const char *line) override;
+  bool ConsumeSamples(NMEAInfo &info) override;
   
   bool ParseBAT(const char *content, NMEAInfo &info);
   bool ParsePRS(const char *content, NMEAInfo &info);
 private:
   KalmanFilter1d kalman_filter;
+
+  void UpdatePressure(long pascal);
+  void ProvidePressure(NMEAInfo &info) const;
 };
 
 void
@@ -92,6 +106,22 @@ fixed ComputeNoncompVario(const fixed pressure, const fixed d_pressure)
   return fixed(FACTOR * pow(pressure, EXPONENT) * d_pressure);
 }
 
+void
+BlueFlyDevice::UpdatePressure(long pascal)
+{
+  AtmosphericPressure pressure = AtmosphericPressure::Pascal(fixed(pascal));
+
+  kalman_filter.Update(pressure.GetHectoPascal(), fixed(0.25), fixed(0.02));
+}
+
+void
+BlueFlyDevice::ProvidePressure(NMEAInfo &info) const
+{
+  info.ProvideNoncompVario(ComputeNoncompVario(kalman_filter.GetXAbs(),
+                                               kalman_filter.GetXVel()));
+  info.ProvideStaticPressure(AtmosphericPressure::HectoPascal(kalman_filter.GetXAbs()));
+}
+
 bool
 BlueFlyDevice::ParsePRS(const char *content, NMEAInfo &info)
 {
@@ -100,18 +130,48 @@ BlueFlyDevice::ParsePRS(const char *content, NMEAInfo &info)
   char *endptr;
   long value = strtol(content, &endptr, 16);
   if (endptr != content) {
-    AtmosphericPressure pressure = AtmosphericPressure::Pascal(fixed(value));
+    UpdatePressure(value);
+    ProvidePressure(info);
+  }
+
+  return true;
+}
 
-    kalman_filter.Update(pressure.GetHectoPascal(), fixed(0.25), fixed(0.02));
+bool
+BlueFlyDevice::QueueSample(const char *line)
+{
+  if (memcmp(line, "PRS ", 4) != 0)
+    return false;
 
-    info.ProvideNoncompVario(ComputeNoncompVario(kalman_filter.GetXAbs(),
-                                                 kalman_filter.GetXVel()));
-    info.ProvideStaticPressure(AtmosphericPressure::HectoPascal(kalman_filter.GetXAbs()));
-  }
+  const char *content = line + 4;
+  char *endptr;
+  long value = strtol(content, &endptr, 16);
+  if (endptr != content)
+    /* if the MergeThread falls behind, the sample is dropped; the
+       filter will catch up with the next one */
+    pressure_samples.push(value);
 
   return true;
 }
 
+bool
+BlueFlyDevice::ConsumeSamples(NMEAInfo &info)
+{
+  /* feed all samples to the filter, but publish only the final
+     estimate */
+  bool modified = false;
+  long value;
+  while (pressure_samples.shift(value)) {
+    UpdatePressure(value);
+    modified = true;
+  }
+
+  if (modified)
+    ProvidePressure(info);
+
+  return modified;
+}
+
 bool
 BlueFlyDevice::ParseNMEA(const char *line, NMEAInfo &info)
 {
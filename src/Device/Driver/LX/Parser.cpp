@@ -24,6 +24,7 @@ Copyright_License {
 #include "Internal.hpp"
 #include "NMEA/Checksum.hpp"
 #include "NMEA/InputLine.hpp"
+#include "NMEA/SentenceKey.hpp"
 #include "NMEA/Info.hpp"
 #include "Geo/SpeedVector.hpp"
 #include "Units/System.hpp"
@@ -341,17 +342,18 @@ PLXVS(NMEAInputLine &line, NMEAInfo &info)
 bool
 LXDevice::ParseNMEA(const char *String, NMEAInfo &info)
 {
-  if (!VerifyNMEAChecksum(String))
+  const char *asterisk = VerifyNMEAChecksumEnd(String);
+  if (asterisk == nullptr)
     return false;
 
-  NMEAInputLine line(String);
-  char type[16];
-  line.Read(type, 16);
+  NMEAInputLine line(String, asterisk);
+  const size_t type_length = line.Skip();
 
-  if (StringIsEqual(type, "$LXWP0"))
+  switch (NMEASentenceKey(String, type_length)) {
+  case NMEASentenceKey("$LXWP0"):
     return LXWP0(line, info);
 
-  if (StringIsEqual(type, "$LXWP1")) {
+  case NMEASentenceKey("$LXWP1"): {
     /* if in pass-through mode, assume that this line was sent by the
        secondary device */
     DeviceInfo &device_info = mode == Mode::PASS_THROUGH
@@ -384,33 +386,30 @@ LXDevice::ParseNMEA(const char *String, NMEAInfo &info)
     return true;
   }
 
-  if (StringIsEqual(type, "$LXWP2"))
+  case NMEASentenceKey("$LXWP2"):
     return LXWP2(line, info);
 
-  if (StringIsEqual(type, "$LXWP3"))
+  case NMEASentenceKey("$LXWP3"):
     return LXWP3(line, info);
 
-  if (StringIsEqual(type, "$PLXV0")) {
+  case NMEASentenceKey("$PLXV0"):
     is_v7 = true;
     is_colibri = false;
     return PLXV0(line, v7_settings);
-  }
 
-  if (StringIsEqual(type, "$PLXVC")) {
+  case NMEASentenceKey("$PLXVC"):
     is_nano = true;
     is_colibri = false;
     PLXVC(line, info.device, info.secondary_device, nano_settings);
     is_forwarded_nano = info.secondary_device.product.equals("NANO");
     return true;
-  }
 
-  if (StringIsEqual(type, "$PLXVF")) {
+  case NMEASentenceKey("$PLXVF"):
     is_v7 = true;
     is_colibri = false;
     return PLXVF(line, info);
-  }
 
-  if (StringIsEqual(type, "$PLXVS")) {
+  case NMEASentenceKey("$PLXVS"):
     is_v7 = true;
     is_colibri = false;
     return PLXVS(line, info);
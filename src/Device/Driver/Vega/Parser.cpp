@@ -25,6 +25,7 @@ Copyright_License {
 #include "Message.hpp"
 #include "NMEA/Info.hpp"
 #include "NMEA/InputLine.hpp"
+#include "NMEA/SentenceKey.hpp"
 #include "Compiler.h"
 #include "Util/Macros.hpp"
 
@@ -220,32 +221,42 @@ bool
 VegaDevice::ParseNMEA(const char *String, NMEAInfo &info)
 {
   NMEAInputLine line(String);
-  char type[16];
-  line.Read(type, 16);
+  const size_t type_length = line.Skip();
 
-  if (memcmp(type, "$PD", 3) == 0)
+  if (type_length >= 3 && memcmp(String, "$PD", 3) == 0)
     detected = true;
 
-  if (strcmp(type, "$PDSWC") == 0)
+  switch (NMEASentenceKey(String, type_length)) {
+  case NMEASentenceKey("$PDSWC"):
     return PDSWC(line, info, volatile_data);
-  else if (strcmp(type, "$PDAAV") == 0)
+
+  case NMEASentenceKey("$PDAAV"):
     return PDAAV(line, info);
-  else if (strcmp(type, "$PDVSC") == 0)
+
+  case NMEASentenceKey("$PDVSC"):
     return PDVSC(line, info);
-  else if (strcmp(type, "$PDVDV") == 0)
+
+  case NMEASentenceKey("$PDVDV"):
     return PDVDV(line, info);
-  else if (strcmp(type, "$PDVDS") == 0)
+
+  case NMEASentenceKey("$PDVDS"):
     return PDVDS(line, info);
-  else if (strcmp(type, "$PDVVT") == 0)
+
+  case NMEASentenceKey("$PDVVT"):
     return PDVVT(line, info);
-  else if (strcmp(type, "$PDVSD") == 0) {
+
+  case NMEASentenceKey("$PDVSD"): {
     const auto message = line.Rest();
     StaticString<256> buffer;
     buffer.SetASCII(message.begin(), message.end());
     Message::AddMessage(buffer);
     return true;
-  } else if (strcmp(type, "$PDTSM") == 0)
+  }
+
+  case NMEASentenceKey("$PDTSM"):
     return PDTSM(line, info);
-  else
+
+  default:
     return false;
+  }
 }
@@ -29,7 +29,7 @@ Copyright_License {
 #include "NMEA/Info.hpp"
 #include "NMEA/Checksum.hpp"
 #include "NMEA/InputLine.hpp"
-#include "Util/StringUtil.hpp"
+#include "NMEA/SentenceKey.hpp"
 #include "Units/System.hpp"
 #include "Driver/FLARM/StaticParser.hpp"
 
@@ -54,60 +54,59 @@ NMEAParser::ParseLine(const char *string, NMEAInfo &info)
   if (string[0] != '$')
     return false;
 
-  if (!NMEAChecksum(string))
+  const char *asterisk = VerifyNMEAChecksumEnd(string);
+  if (asterisk == nullptr)
     return false;
 
-  NMEAInputLine line(string);
+  NMEAInputLine line(string, asterisk);
 
-  char type[16];
-  line.Read(type, 16);
+  /* the address without the dollar sign */
+  const char *address = string + 1;
+  const size_t address_length = line.Skip() - 1;
 
-  if (IsAlphaASCII(type[1]) && IsAlphaASCII(type[2])) {
-    if (StringIsEqual(type + 3, "GSA"))
+  if (address_length == 5 &&
+      IsAlphaASCII(address[0]) && IsAlphaASCII(address[1])) {
+    /* skip the talker id */
+    switch (NMEASentenceKey(address + 2, 3)) {
+    case NMEASentenceKey("GSA"):
       return GSA(line, info);
 
-    if (StringIsEqual(type + 3, "GLL"))
+    case NMEASentenceKey("GLL"):
       return GLL(line, info);
 
-    if (StringIsEqual(type + 3, "RMC"))
+    case NMEASentenceKey("RMC"):
       return RMC(line, info);
 
-    if (StringIsEqual(type + 3, "GGA"))
+    case NMEASentenceKey("GGA"):
       return GGA(line, info);
+    }
   }
 
-  // if (proprietary sentence) ...
-  if (type[1] == 'P') {
+  switch (NMEASentenceKey(address, address_length)) {
     // Airspeed and vario sentence
-    if (StringIsEqual(type + 1, "PTAS1"))
-      return PTAS1(line, info);
+  case NMEASentenceKey("PTAS1"):
+    return PTAS1(line, info);
 
     // FLARM sentences
-    if (StringIsEqual(type + 1, "PFLAE")) {
-      ParsePFLAE(line, info.flarm.error, info.clock);
-      return true;
-    }
+  case NMEASentenceKey("PFLAE"):
+    ParsePFLAE(line, info.flarm.error, info.clock);
+    return true;
 
-    if (StringIsEqual(type + 1, "PFLAV")) {
-      ParsePFLAV(line, info.flarm.version, info.clock);
-      return true;
-    }
+  case NMEASentenceKey("PFLAV"):
+    ParsePFLAV(line, info.flarm.version, info.clock);
+    return true;
 
-    if (StringIsEqual(type + 1, "PFLAA")) {
-      ParsePFLAA(line, info.flarm.traffic, info.clock);
-      return true;
-    }
+  case NMEASentenceKey("PFLAA"):
+    ParsePFLAA(line, info.flarm.traffic, info.clock);
+    return true;
 
-    if (StringIsEqual(type + 1, "PFLAU")) {
-      ParsePFLAU(line, info.flarm.status, info.clock);
-      return true;
-    }
+  case NMEASentenceKey("PFLAU"):
+    ParsePFLAU(line, info.flarm.status, info.clock);
+    return true;
 
     // Garmin altitude sentence
-    if (StringIsEqual(type + 1, "PGRMZ"))
-      return RMZ(line, info);
-
-    return false;
+  case NMEASentenceKey("PGRMZ"):
+    return RMZ(line, info);
   }
 
   return false;
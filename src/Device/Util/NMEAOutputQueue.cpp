@@ -0,0 +1,136 @@
+/*
+Copyright_License {
+
+  XCSoar Glide Computer - http://www.xcsoar.org/
+  Copyright (C) 2000-2014 The XCSoar Project
+  A detailed list of copyright holders can be found in the file "AUTHORS".
+
+  This program is free software; you can redistribute it and/or
+  modify it under the terms of the GNU General Public License
+  as published by the Free Software Foundation; either version 2
+  of the License, or (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+}
+*/
+
+#include "NMEAOutputQueue.hpp"
+#include "Device/Port/Port.hpp"
+
+#include <algorithm>
+
+#include <string.h>
+
+NMEAOutputQueue::NMEAOutputQueue(Port &_port)
+  :WorkerThread("NMEAOutput", 0, 0, 10),
+   port(_port), remainder_length(0),
+   n_written(0), n_coalesced(0), n_dropped(0), n_writes(0)
+{
+  lines.clear();
+}
+
+bool
+NMEAOutputQueue::Push(const char *line, uint64_t key)
+{
+  const size_t length = strlen(line);
+  if (length > MAX_LENGTH) {
+    ++n_dropped;
+    return false;
+  }
+
+  {
+    const ScopeLock protect(mutex);
+
+    Line *dest = nullptr;
+    if (key != 0) {
+      auto i = std::find_if(lines.begin(), lines.end(),
+                            [key](const Line &l) { return l.key == key; });
+      if (i != lines.end()) {
+        dest = &*i;
+        ++n_coalesced;
+      }
+    }
+
+    if (dest == nullptr) {
+      if (lines.full()) {
+        ++n_dropped;
+        return false;
+      }
+
+      dest = &lines.append();
+      dest->key = key;
+    }
+
+    dest->length = length;
+    memcpy(dest->data, line, length);
+  }
+
+  Trigger();
+  return true;
+}
+
+void
+NMEAOutputQueue::Tick()
+{
+  /* move all pending lines to a local buffer, so Push() does not need
+     to wait for the port; the rest of a partially written line goes
+     first */
+  char buffer[sizeof(remainder) + MAX_LINES * (MAX_LENGTH + 2)];
+  memcpy(buffer, remainder, remainder_length);
+  const bool has_remainder = remainder_length > 0;
+  size_t length = remainder_length;
+  remainder_length = 0;
+
+  {
+    const ScopeLock protect(mutex);
+
+    for (const Line &line : lines) {
+      memcpy(buffer + length, line.data, line.length);
+      length += line.length;
+      buffer[length++] = '\r';
+      buffer[length++] = '\n';
+    }
+
+    lines.clear();
+  }
+
+  size_t position = 0;
+  while (position < length) {
+    size_t nbytes = port.Write(buffer + position, length - position);
+    ++n_writes;
+    if (nbytes == 0)
+      break;
+
+    position += nbytes;
+  }
+
+  n_written += std::count(buffer, buffer + position, '\n');
+  const unsigned n_unsent = std::count(buffer + position, buffer + length,
+                                       '\n');
+
+  const bool torn = position > 0
+    ? buffer[position - 1] != '\n'
+    : has_remainder;
+  if (position == length || !torn) {
+    /* the unsent lines are discarded; newer values will follow */
+    n_dropped += n_unsent;
+    return;
+  }
+
+  /* all unsent lines but the torn one are discarded */
+  n_dropped += n_unsent - 1;
+
+  /* keep the rest of the torn line for the next Tick(), i.e. the
+     next Push() */
+  const char *end = (const char *)memchr(buffer + position, '\n',
+                                         length - position) + 1;
+  remainder_length = end - (buffer + position);
+  memcpy(remainder, buffer + position, remainder_length);
+}
@@ -0,0 +1,172 @@
+/*
+Copyright_License {
+
+  XCSoar Glide Computer - http://www.xcsoar.org/
+  Copyright (C) 2000-2014 The XCSoar Project
+  A detailed list of copyright holders can be found in the file "AUTHORS".
+
+  This program is free software; you can redistribute it and/or
+  modify it under the terms of the GNU General Public License
+  as published by the Free Software Foundation; either version 2
+  of the License, or (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+}
+*/
+
+#ifndef XCSOAR_DEVICE_NMEA_OUTPUT_QUEUE_HPP
+#define XCSOAR_DEVICE_NMEA_OUTPUT_QUEUE_HPP
+
+#include "Thread/WorkerThread.hpp"
+#include "Thread/Mutex.hpp"
+#include "Util/TrivialArray.hpp"
+#include "Compiler.h"
+
+#include <atomic>
+
+#include <stddef.h>
+#include <stdint.h>
+
+class Port;
+
+/**
+ * An asynchronous output queue for a #Port.  Any thread may call
+ * Push() without blocking on the port.  The queue's own thread writes
+ * the pending lines, many of them in one Port::Write() call.
+ *
+ * A pending line may be replaced by a newer one with the same key
+ * (e.g. the next "$GPRMC" while the previous one is still waiting),
+ * if only the newest value is interesting.  If the queue is full, new
+ * lines are dropped.  If the port fails in the middle of a line, the
+ * rest of that line is sent first on the next attempt, so the
+ * receiver never sees a torn line followed by a new one; the lines
+ * after it are discarded.
+ */
+class NMEAOutputQueue final : private WorkerThread {
+  static constexpr unsigned MAX_LINES = 32;
+  static constexpr unsigned MAX_LENGTH = 128;
+
+  struct Line {
+    /**
+     * See Push(); 0 if this line must not be replaced.
+     */
+    uint64_t key;
+
+    unsigned length;
+
+    char data[MAX_LENGTH];
+  };
+
+  Port &port;
+
+  /**
+   * Protects #lines.
+   */
+  Mutex mutex;
+
+  TrivialArray<Line, MAX_LINES> lines;
+
+  /**
+   * The rest of a line which could only be written partially.  Only
+   * used by the queue's thread.
+   */
+  char remainder[MAX_LENGTH + 2];
+  size_t remainder_length;
+
+  std::atomic<unsigned> n_written, n_coalesced, n_dropped, n_writes;
+
+public:
+  /**
+   * A snapshot of the queue's counters.
+   */
+  struct Statistics {
+    /**
+     * The number of lines which have been written to the port.
+     */
+    unsigned written;
+
+    /**
+     * The number of lines which were replaced by a newer line with
+     * the same key before they could be written.
+     */
+    unsigned coalesced;
+
+    /**
+     * The number of lines which were dropped because they were too
+     * long, because the queue was full or because the port failed.
+     */
+    unsigned dropped;
+
+    /**
+     * The number of Port::Write() calls.
+     */
+    unsigned writes;
+
+    void Clear() {
+      written = coalesced = dropped = writes = 0;
+    }
+
+    Statistics &operator+=(const Statistics &other) {
+      written += other.written;
+      coalesced += other.coalesced;
+      dropped += other.dropped;
+      writes += other.writes;
+      return *this;
+    }
+  };
+
+  explicit NMEAOutputQueue(Port &_port);
+
+  /**
+   * Start the thread.  Lines pushed before are kept.
+   */
+  bool Start() {
+    return WorkerThread::Start();
+  }
+
+  /**
+   * Stop the thread; pending lines are discarded.  Must be called
+   * before the destructor.
+   */
+  void Stop() {
+    BeginStop();
+    Join();
+  }
+
+  /**
+   * Queue a line for sending.  The line terminator is appended
+   * automatically.
+   *
+   * @param line the line without the terminator
+   * @param key if not 0, then this line replaces a pending line with
+   * the same key, e.g. the NMEASentenceKey() of the address
+   * @return false if the line was dropped
+   */
+  bool Push(const char *line, uint64_t key=0);
+
+  /**
+   * Obtain the counters.  May be called from any thread.
+   */
+  gcc_pure
+  Statistics GetStatistics() const {
+    Statistics s;
+    s.written = n_written.load(std::memory_order_relaxed);
+    s.coalesced = n_coalesced.load(std::memory_order_relaxed);
+    s.dropped = n_dropped.load(std::memory_order_relaxed);
+    s.writes = n_writes.load(std::memory_order_relaxed);
+    return s;
+  }
+
+private:
+  /* virtual methods from class WorkerThread */
+  virtual void Tick() override;
+};
+
+#endif
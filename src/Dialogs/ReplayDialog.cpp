@@ -24,6 +24,7 @@ Copyright_License {
 #include "ReplayDialog.hpp"
 #include "Dialogs/Message.hpp"
 #include "Dialogs/WidgetDialog.hpp"
+#include "Dialogs/JobDialog.hpp"
 #include "Widget/RowFormWidget.hpp"
 #include "Form/ActionListener.hpp"
 #include "Form/DataField/Listener.hpp"
@@ -33,11 +34,14 @@ Copyright_License {
 #include "Form/DataField/FileReader.hpp"
 #include "Form/DataField/Float.hpp"
 #include "Language/Language.hpp"
+#include "Util/StaticString.hpp"
 
 enum Buttons {
   START,
   STOP,
+  REWIND,
   FAST_FORWARD,
+  FAST_FORWARD_END,
 };
 
 class ReplayControlWidget final
@@ -54,13 +58,18 @@ public:
   void CreateButtons(WidgetDialog &dialog) {
     dialog.AddButton(_("Start"), *this, START);
     dialog.AddButton(_("Stop"), *this, STOP);
+    dialog.AddButton(_T("-10'"), *this, REWIND);
     dialog.AddButton(_T("+10'"), *this, FAST_FORWARD);
+    dialog.AddButton(_T(">|"), *this, FAST_FORWARD_END);
   }
 
 private:
   void OnStopClicked();
   void OnStartClicked();
+  void OnRewindClicked();
+  void FastForward(fixed delta_s);
   void OnFastForwardClicked();
+  void OnFastForwardEndClicked();
 
 public:
   /* virtual methods from class Widget */
@@ -112,6 +121,14 @@ ReplayControlWidget::OnStartClicked()
                    _("Replay"), MB_OK | MB_ICONINFORMATION);
 }
 
+inline void
+ReplayControlWidget::OnRewindClicked()
+{
+  const fixed virtual_time = replay->GetVirtualTime();
+  if (!negative(virtual_time))
+    replay->Seek(virtual_time - fixed(10 * 60));
+}
+
 void
 ReplayControlWidget::OnAction(int id)
 {
@@ -124,16 +141,50 @@ ReplayControlWidget::OnAction(int id)
     OnStopClicked();
     break;
 
+  case REWIND:
+    OnRewindClicked();
+    break;
+
   case FAST_FORWARD:
     OnFastForwardClicked();
     break;
+
+  case FAST_FORWARD_END:
+    OnFastForwardEndClicked();
+    break;
+  }
+}
+
+void
+ReplayControlWidget::FastForward(fixed delta_s)
+{
+  DialogJobRunner runner(UIGlobals::GetMainWindow(), GetLook(),
+                         _("Fast forward"), true);
+
+  unsigned fixes_per_second;
+  if (!replay->FastForward(delta_s, runner, fixes_per_second))
+    return;
+
+  if (negative(delta_s)) {
+    StaticString<64> message;
+    message.Format(_T("%s (%u fixes/s)"), _("Replay finished"),
+                   fixes_per_second);
+    ShowMessageBox(message, _("Replay"), MB_OK | MB_ICONINFORMATION);
   }
 }
 
 inline void
 ReplayControlWidget::OnFastForwardClicked()
 {
-  replay->FastForward(fixed(10 * 60));
+  FastForward(fixed(10 * 60));
+}
+
+inline void
+ReplayControlWidget::OnFastForwardEndClicked()
+{
+  /* replay the rest of the file, e.g. to review the flight in the
+     analysis dialog */
+  FastForward(fixed(-1));
 }
 
 void
@@ -24,6 +24,9 @@ Copyright_License {
 #include "SystemStatusPanel.hpp"
 #include "Logger/Logger.hpp"
 #include "Components.hpp"
+#include "Blackboard/DeviceBlackboard.hpp"
+#include "Device/List.hpp"
+#include "Device/Descriptor.hpp"
 #include "Interface.hpp"
 #include "Language/Language.hpp"
 #include "Hardware/Battery.hpp"
@@ -35,6 +38,9 @@ enum Controls {
   FLARM,
   Logger,
   Battery,
+  Merge,
+  NMEAOut,
+  Publish,
 };
 
 gcc_pure
@@ -104,6 +110,34 @@ SystemStatusPanel::Refresh()
     Temp.AppendFormat(_T("%.0f%%"), (double)basic.battery_level);
 
   SetText(Battery, Temp);
+
+  if (device_blackboard != nullptr) {
+    /* diagnostic: how much device data was merged into the last GPS
+       update; this is an estimate, see DeviceBlackboard::merge_bytes */
+    Temp.Format(_T("%u B"), device_blackboard->GetMergeBytes());
+    SetText(Merge, Temp);
+  }
+
+  /* diagnostic: what happened to the lines forwarded to NMEA out
+     ports */
+  NMEAOutputQueue::Statistics output;
+  output.Clear();
+  for (const DeviceDescriptor *i : device_list)
+    if (i != nullptr)
+      output += i->GetOutputStatistics();
+
+  Temp.Format(_T("%u sent, %u replaced, %u dropped"),
+              output.written, output.coalesced, output.dropped);
+  SetText(NMEAOut, Temp);
+
+  /* diagnostic: how often a lock-free reader of the published
+     blackboard copies collided with the writer */
+  const auto &basic_lock = device_blackboard->PublishedBasic();
+  const auto &calculated_lock = device_blackboard->PublishedCalculated();
+  Temp.Format(_T("%u retries in %u updates"),
+              basic_lock.GetRetryCount() + calculated_lock.GetRetryCount(),
+              basic_lock.GetVersion() + calculated_lock.GetVersion());
+  SetText(Publish, Temp);
 }
 
 void
@@ -115,6 +149,9 @@ SystemStatusPanel::Prepare(ContainerWindow &parent, const PixelRect &rc)
   AddReadOnly(_T("FLARM"));
   AddReadOnly(_("Logger"));
   AddReadOnly(_("Supply voltage"));
+  AddReadOnly(_("Merged data (estimated)"));
+  AddReadOnly(_("NMEA out"));
+  AddReadOnly(_("Blackboard reads"));
 }
 
 void
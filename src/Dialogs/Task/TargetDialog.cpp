@@ -41,6 +41,8 @@ Copyright_License {
 #include "Engine/Task/TaskManager.hpp"
 #include "Engine/Task/Ordered/OrderedTask.hpp"
 #include "Engine/Task/Ordered/Points/AATPoint.hpp"
+#include "Engine/Task/Solvers/TaskTargetSweep.hpp"
+#include "NMEA/Aircraft.hpp"
 #include "Units/Units.hpp"
 #include "Asset.hpp"
 #include "Blackboard/RateLimitedBlackboardListener.hpp"
@@ -215,6 +217,50 @@ LoadRangeAndRadial()
   LoadRadial();
 }
 
+/**
+ * Evaluates the remaining task for a grid of targets in the OZ of
+ * the target point, for the heat map on the map window.
+ */
+static void
+UpdateTargetSweep()
+{
+  /* every 30 degrees, in steps of 20% of the range */
+  static constexpr unsigned N_RADIALS = 12, N_RANGES = 5;
+
+  std::vector<TargetSweepResult> results;
+
+  const auto &basic = CommonInterface::Basic();
+  if (basic.location_available) {
+    RangeAndRadial settings[N_RADIALS * N_RANGES];
+    RangeAndRadial *p = settings;
+    for (unsigned i = 0; i < N_RADIALS; ++i) {
+      const int degrees = -180 + int(i * 360 / N_RADIALS);
+
+      for (unsigned j = 1; j <= N_RANGES; ++j) {
+        /* targets behind the OZ center have a negative range, see
+           AATPoint::GetTargetRangeRadial() */
+        const fixed range = fixed(j) / N_RANGES;
+        *p++ = RangeAndRadial{
+          abs(degrees) > 90 ? -range : range,
+          Angle::Degrees(degrees),
+        };
+      }
+    }
+
+    const AircraftState aircraft =
+      ToAircraftState(basic, CommonInterface::Calculated());
+
+    results.resize(N_RADIALS * N_RANGES);
+
+    ProtectedTaskManager::ExclusiveLease lease(*protected_task_manager);
+    if (!lease->EvaluateTargets(target_point, aircraft,
+                                settings, results.size(), results.data()))
+      results.clear();
+  }
+
+  map->SetTargetSweep(std::move(results));
+}
+
 /**
  * Refreshes UI based on location of target and current task stats
  */
@@ -256,6 +302,11 @@ RefreshCalculator()
   if (!nodisplay)
     LoadRangeAndRadial();
 
+  if (nodisplay)
+    map->SetTargetSweep(std::vector<TargetSweepResult>());
+  else
+    UpdateTargetSweep();
+
   // update outputs
   const auto &calculated = CommonInterface::Calculated();
   const TaskStats &task_stats = calculated.ordered_task_stats;
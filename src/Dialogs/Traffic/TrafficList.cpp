@@ -369,7 +369,7 @@ TrafficListWidget::UpdateList()
   const TCHAR *callsign = filter_widget->GetValueString(CALLSIGN);
   if (!StringIsEmpty(callsign)) {
     FlarmId ids[30];
-    unsigned count = FlarmDetails::FindIdsByCallSign(callsign, ids, 30);
+    unsigned count = FlarmDetails::FindIdsByCallSignPrefix(callsign, ids, 30);
 
     for (unsigned i = 0; i < count; ++i)
       AddItem(ids[i]);
@@ -251,6 +251,90 @@ GlidePolar::UpdateSMin()
   UpdateBestLD();
 }
 
+/**
+ * The lowest airspeed which is considered for a glide with the given
+ * cross wind component.  Below the cross wind speed, the glider
+ * cannot hold its track at all.
+ */
+static fixed
+GetBestGlideSpeedMin(fixed v_min, fixed cross_wind)
+{
+  return std::max(v_min, cross_wind + fixed(1));
+}
+
+/**
+ * Newton iteration for the airspeed which minimises sink rate over
+ * ground speed.  That is the root of
+ * \f[ F(V) = S'(V) V_g(V) - S(V) V_g'(V) \f]
+ * with the ground speed
+ * \f[ V_g(V) = \sqrt{V^2 - W_c^2} - W_h \f]
+ *
+ * F is monotonic wherever the ground speed is positive, so the
+ * iteration converges quickly from any reasonable guess.
+ *
+ * @return the speed (m/s), or a negative value if no speed results in
+ * a positive ground speed
+ */
+gcc_pure
+static fixed
+SolveBestGlideSpeed(const PolarCoefficients &polar,
+                    const fixed head_wind, const fixed cross_wind,
+                    fixed v, const fixed v_min, const fixed v_max,
+                    unsigned iterations)
+{
+  const fixed cross_wind_squared = sqr(cross_wind);
+
+  v = Clamp(v, v_min, v_max);
+
+  for (unsigned i = 0; i < iterations; ++i) {
+    const fixed r = sqrt(sqr(v) - cross_wind_squared);
+    const fixed ground_speed = r - head_wind;
+    if (!positive(ground_speed)) {
+      /* the head wind is too strong: fly faster */
+      if (v >= v_max)
+        return fixed(-1);
+
+      v = std::min(v + fixed(5), v_max);
+      continue;
+    }
+
+    const fixed s = v * (v * polar.a + polar.b) + polar.c;
+    const fixed ds = Double(v * polar.a) + polar.b;
+    const fixed f = ds * ground_speed - s * v / r;
+    const fixed df = Double(polar.a) * ground_speed +
+      s * cross_wind_squared / (r * r * r);
+
+    const fixed next = Clamp(v - f / df, v_min, v_max);
+    const bool done = fabs(next - v) < fixed(0.001);
+    v = next;
+    if (done)
+      break;
+  }
+
+  return sqrt(sqr(v) - cross_wind_squared) > head_wind
+    ? v
+    : fixed(-1);
+}
+
+fixed
+GlidePolar::GetBestGlideSpeed(fixed head_wind, fixed cross_wind) const
+{
+  assert(IsValid());
+  assert(!negative(cross_wind));
+
+  const fixed v_min = GetBestGlideSpeedMin(Vmin, cross_wind);
+  if (v_min >= Vmax)
+    return fixed(-1);
+
+  /* start with the exact solution without cross wind, which is
+     usually only a few iterations away */
+  const fixed s = sqr(head_wind) + (polar.c + polar.b * head_wind) / polar.a;
+  const fixed v = positive(s) ? head_wind + sqrt(s) : Vmax;
+
+  return SolveBestGlideSpeed(polar, head_wind, cross_wind,
+                             v, v_min, Vmax, 8);
+}
+
 bool 
 GlidePolar::IsGlidePossible(const GlideState &task) const
 {
@@ -258,6 +258,21 @@ public:
   gcc_pure
   fixed GetBestGlideRatioSpeed(fixed head_wind) const;
 
+  /**
+   * Calculate the airspeed for the best glide ratio over ground
+   * without MacCready (pure final glide), considering head wind and
+   * cross wind.  This is a Newton iteration which starts at the
+   * closed form solution without cross wind.
+   *
+   * @param head_wind the head wind component (m/s, negative for
+   * tail wind)
+   * @param cross_wind the cross wind component (m/s, not negative)
+   * @return the speed (m/s) or a negative value if the wind is too
+   * strong for a glide solution
+   */
+  gcc_pure
+  fixed GetBestGlideSpeed(fixed head_wind, fixed cross_wind) const;
+
   /**
    * Takeoff speed
    * @return Takeoff speed threshold (m/s)
@@ -406,6 +406,21 @@ MacCready::OptimiseGlide(const GlideState &task, const bool allow_partial) const
 {
   assert(!positive(glide_polar.GetMC()));
 
+  if (positive(cruise_efficiency)) {
+    /* the ground speed is calculated from the airspeed multiplied by
+       the cruise efficiency; dividing the wind by it instead yields
+       the same optimum */
+    const fixed cross_wind_squared =
+      std::max(sqr(task.wind.norm) - sqr(task.head_wind), fixed(0));
+    const fixed v =
+      glide_polar.GetBestGlideSpeed(task.head_wind / cruise_efficiency,
+                                    sqrt(cross_wind_squared)
+                                    / cruise_efficiency);
+    if (positive(v))
+      return SolveGlide(task, v, allow_partial);
+  }
+
+  /* no solution from the Newton iteration: search numerically */
   MacCreadyVopt mc_vopt(task, *this,
                        glide_polar.GetVMin(), glide_polar.GetVMax(),
                        allow_partial);
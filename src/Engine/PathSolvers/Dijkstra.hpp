@@ -27,12 +27,17 @@ Copyright_License {
 #include "Util/ReservablePriorityQueue.hpp"
 #include "Compiler.h"
 
+#include <assert.h>
+
 #define DIJKSTRA_MINMAX_OFFSET 134217727
 
 /**
  * Dijkstra search algorithm.
  * Modifications by John Wharington to track optimal solution
  * @see http://en.giswiki.net/wiki/Dijkstra%27s_algorithm
+ *
+ * @param MapTemplate a class with a nested "Bind" template, which
+ * defines the std::map-like container storing the edges
  */
 template<typename Node, typename MapTemplate>
 class Dijkstra
@@ -56,10 +61,14 @@ private:
   {
     unsigned edge_value;
 
-    edge_iterator iterator;
+    /**
+     * The destination node.  This is not an #edge_iterator, because
+     * inserting into the #EdgeMap may invalidate iterators.
+     */
+    Node node;
 
-    Value(unsigned _edge_value, edge_iterator _iterator)
-      :edge_value(_edge_value), iterator(_iterator) {}
+    Value(unsigned _edge_value, Node _node)
+      :edge_value(_edge_value), node(_node) {}
   };
 
   struct Rank : public std::binary_function<Value, Value, bool> {
@@ -150,14 +159,14 @@ public:
    * @return Node for processing
    */
   Node Pop() {
-    edge_const_iterator cur(q.top().iterator);
-    current_value = cur->second.value;
+    const Node node = q.top().node;
+    current_value = q.top().edge_value;
 
     do {
       q.pop();
-    } while (!q.empty() && q.top().iterator->second.value < q.top().edge_value);
+    } while (!q.empty() && IsObsolete(q.top()));
 
-    return cur->first;
+    return node;
   }
 
   /**
@@ -209,10 +218,21 @@ public:
     q.clear();
 
     for (const auto &i : edges)
-      q.push(Value(i.second.value, i));
+      q.push(Value(i.second.value, i.first));
   }
 
 private:
+  /**
+   * Has a better link to the queue item's node been found after it
+   * was pushed?
+   */
+  gcc_pure
+  bool IsObsolete(const Value &value) const {
+    edge_const_iterator it = edges.find(value.node);
+    assert(it != edges.end());
+    return it->second.value < value.edge_value;
+  }
+
   /**
    * Add node to search queue
    *
@@ -238,7 +258,7 @@ private:
       // -> Don't use this new leg
       return false;
 
-    q.push(Value(edge_value, it));
+    q.push(Value(edge_value, node));
     return true;
   }
 };
@@ -32,6 +32,7 @@ AbstractTask::AbstractTask(TaskType _type,
   :TaskInterface(_type),
    active_task_point(0),
    task_events(NULL),
+   profiler(nullptr),
    task_behaviour(tb),
    force_full_update(true),
    mc_lpf(fixed(8)),
@@ -107,6 +108,8 @@ bool
 AbstractTask::UpdateIdle(const AircraftState &state,
                          const GlidePolar &glide_polar)
 {
+  const ScopeTaskProfile profile(profiler, TaskProfiler::Stage::IDLE);
+
   const bool valid = state.location.IsValid() && glide_polar.IsValid();
 
   if (stats.start.task_started && task_behaviour.calc_cruise_efficiency &&
@@ -243,21 +246,44 @@ AbstractTask::Update(const AircraftState &state,
   stats.active_index = GetActiveTaskPointIndex();
   stats.task_valid = CheckTask();
 
-  const bool full_update = 
-    (state.location.IsValid() && state_last.location.IsValid() &&
-     CheckTransitions(state, state_last)) ||
-    force_full_update;
+  bool full_update;
+  {
+    const ScopeTaskProfile profile(profiler,
+                                   TaskProfiler::Stage::TRANSITIONS);
+    full_update =
+      (state.location.IsValid() && state_last.location.IsValid() &&
+       CheckTransitions(state, state_last)) ||
+      force_full_update;
+  }
   force_full_update = false;
 
-  UpdateStatsDistances(state.location, full_update);
-  UpdateGlideSolutions(state, glide_polar);
-  UpdateStatsTimes(state.time);
+  {
+    const ScopeTaskProfile profile(profiler, TaskProfiler::Stage::DISTANCES);
+    UpdateStatsDistances(state.location, full_update);
+  }
 
-  const bool sample_updated = state.location.IsValid() &&
-    UpdateSample(state, glide_polar, full_update);
+  {
+    const ScopeTaskProfile profile(profiler, TaskProfiler::Stage::GLIDE);
+    UpdateGlideSolutions(state, glide_polar);
+  }
 
-  UpdateStatsSpeeds(state.time);
-  UpdateFlightMode();
+  {
+    const ScopeTaskProfile profile(profiler, TaskProfiler::Stage::STATS);
+    UpdateStatsTimes(state.time);
+  }
+
+  bool sample_updated;
+  {
+    const ScopeTaskProfile profile(profiler, TaskProfiler::Stage::SAMPLE);
+    sample_updated = state.location.IsValid() &&
+      UpdateSample(state, glide_polar, full_update);
+  }
+
+  {
+    const ScopeTaskProfile profile(profiler, TaskProfiler::Stage::STATS);
+    UpdateStatsSpeeds(state.time);
+    UpdateFlightMode();
+  }
 
   assert(!force_full_update);
 
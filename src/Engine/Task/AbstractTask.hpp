@@ -28,6 +28,7 @@
 #include "Computer/TaskStatsComputer.hpp"
 #include "TaskBehaviour.hpp"
 #include "Math/Filter.hpp"
+#include "TaskProfiler.hpp"
 
 class TaskPointConstVisitor;
 class TaskEvents;
@@ -50,6 +51,9 @@ protected:
   /** reference to task events (feedback) */
   TaskEvents *task_events;
 
+  /** optional instrumentation, may be nullptr */
+  TaskProfiler *profiler;
+
   /** settings */
   TaskBehaviour task_behaviour;
 
@@ -92,6 +96,14 @@ public:
     task_events = &_task_events;
   }
 
+  /**
+   * Set the TaskProfiler which measures the stages of Update() and
+   * UpdateIdle().  Pass nullptr to disable it.
+   */
+  void SetProfiler(TaskProfiler *_profiler) {
+    profiler = _profiler;
+  }
+
   /** Reset the task (as if never flown) */
   virtual void Reset();
 
@@ -61,6 +61,10 @@ AnnularSectorZone::GetBoundary() const
 bool
 AnnularSectorZone::IsInSector(const GeoPoint &location) const
 {
+  if (IsCertainlyFartherThan(location, GetRadius()) ||
+      IsCertainlyCloserThan(location, inner_radius))
+    return false;
+
   GeoVector f(GetReference(), location);
 
   return (f.distance <= GetRadius()) &&
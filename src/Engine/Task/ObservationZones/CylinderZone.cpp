@@ -47,6 +47,38 @@ CylinderZone::GetBoundary() const
   return boundary;
 }
 
+OZBoundary
+CylinderZone::GetBoundaryNear(const GeoPoint &location) const
+{
+  OZBoundary boundary;
+
+  /* GetBoundary() has a point every 18 degrees; near the optimum, a
+     leg sum misses at most r*(9 degrees)^2, i.e. 2.5% of the radius,
+     which is not worth another search for small cylinders */
+  if (radius < fixed(1000))
+    return boundary;
+
+  GeoVector vector = GetReference().DistanceBearing(location);
+  if (!positive(vector.distance))
+    return boundary;
+
+  /* fill the gaps to both neighbours with a four times finer
+     resolution, on the arc the given point is on; the neighbours
+     themselves were already searched */
+  const unsigned steps = 4;
+  const Angle delta = Angle::FullCircle() / (20 * steps);
+
+  const Angle bearing = vector.bearing;
+  for (unsigned i = 1; i < steps; ++i) {
+    vector.bearing = bearing - delta * i;
+    boundary.push_front(vector.EndPoint(GetReference()));
+    vector.bearing = bearing + delta * i;
+    boundary.push_front(vector.EndPoint(GetReference()));
+  }
+
+  return boundary;
+}
+
 bool
 CylinderZone::Equals(const ObservationZonePoint &other) const
 {
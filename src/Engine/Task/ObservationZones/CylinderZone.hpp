@@ -47,12 +47,14 @@ protected:
     :ObservationZonePoint(_shape, _can_start_through_top, loc),
      radius(_radius) {
     assert(positive(radius));
+    UpdateBounds(radius);
   }
 
   CylinderZone(const CylinderZone &other, const GeoPoint &reference)
     :ObservationZonePoint((const ObservationZonePoint &)other, reference),
      radius(other.radius) {
     assert(positive(radius));
+    UpdateBounds(radius);
   }
 
 public:
@@ -67,6 +69,7 @@ public:
   CylinderZone(const GeoPoint &loc, const fixed _radius = fixed(10000.0))
     :ObservationZonePoint(Shape::CYLINDER, true, loc), radius(_radius) {
     assert(positive(radius));
+    UpdateBounds(radius);
   }
 
   static CylinderZone *CreateMatCylinderZone(const GeoPoint &loc) {
@@ -81,6 +84,7 @@ public:
   virtual void SetRadius(fixed new_radius) {
     assert(positive(new_radius));
     radius = new_radius;
+    UpdateBounds(radius);
   }
 
   /**
@@ -94,6 +98,12 @@ public:
 
   /* virtual methods from class ObservationZone */
   virtual bool IsInSector(const GeoPoint &location) const override {
+    if (IsCertainlyFartherThan(location, radius))
+      return false;
+
+    if (IsCertainlyCloserThan(location, radius))
+      return true;
+
     return DistanceTo(location) <= radius;
   }
 
@@ -103,6 +113,7 @@ public:
   }
 
   virtual OZBoundary GetBoundary() const override;
+  virtual OZBoundary GetBoundaryNear(const GeoPoint &location) const override;
   virtual fixed ScoreAdjustment() const override;
 
   /* virtual methods from class ObservationZonePoint */
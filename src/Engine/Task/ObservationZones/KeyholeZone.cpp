@@ -55,6 +55,13 @@ KeyholeZone::ScoreAdjustment() const
 bool 
 KeyholeZone::IsInSector(const GeoPoint &location) const
 {
+  if (IsCertainlyCloserThan(location, GetInnerRadius()))
+    return true;
+
+  if (GetInnerRadius() <= GetRadius() &&
+      IsCertainlyFartherThan(location, GetRadius()))
+    return false;
+
   GeoVector f(GetReference(), location);
 
   return f.distance <= GetInnerRadius() ||
@@ -118,6 +118,19 @@ public:
   gcc_pure
   virtual OZBoundary GetBoundary() const = 0;
 
+  /**
+   * Generate additional boundary points close to the specified
+   * point, which was picked from GetBoundary() (e.g. the optimum
+   * found by TaskDijkstra).  This allows refining a search on the
+   * coarse boundary without sampling the whole boundary at a higher
+   * resolution.
+   *
+   * The specified point itself is not included.  The list is empty
+   * if the boundary cannot be refined near that point.
+   */
+  gcc_pure
+  virtual OZBoundary GetBoundaryNear(const GeoPoint &location) const = 0;
+
   /**
    * Distance reduction for scoring when outside this OZ
    * (used because FAI cylinders, for example, have their
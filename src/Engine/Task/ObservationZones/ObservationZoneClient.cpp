@@ -59,6 +59,12 @@ ObservationZoneClient::GetBoundary() const
   return oz_point->GetBoundary();
 }
 
+OZBoundary
+ObservationZoneClient::GetBoundaryNear(const GeoPoint &location) const
+{
+  return oz_point->GetBoundaryNear(location);
+}
+
 bool
 ObservationZoneClient::TransitionConstraint(const GeoPoint &location,
                                             const GeoPoint &last_location) const
@@ -74,6 +74,9 @@ public:
   gcc_pure
   OZBoundary GetBoundary() const;
 
+  gcc_pure
+  OZBoundary GetBoundaryNear(const GeoPoint &location) const;
+
   virtual fixed ScoreAdjustment() const;
 
   void SetLegs(const TaskPoint *previous, const TaskPoint *next);
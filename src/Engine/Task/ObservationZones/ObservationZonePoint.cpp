@@ -21,6 +21,14 @@
  */
 
 #include "ObservationZonePoint.hpp"
+#include "Geo/Constants.hpp"
+
+/**
+ * The flat approximation on the sphere differs from the exact
+ * distance on the WGS84 ellipsoid by less than 1% for the sizes of
+ * observation zones; twice that is used as margin.
+ */
+static constexpr fixed BOUNDS_MARGIN = fixed(1.02);
 
 bool
 ObservationZonePoint::Equals(const ObservationZonePoint &other) const
@@ -29,3 +37,62 @@ ObservationZonePoint::Equals(const ObservationZonePoint &other) const
     GetReference().Equals(other.GetReference());
 }
 
+void
+ObservationZonePoint::UpdateBounds(fixed max_distance)
+{
+  bounds_distance = max_distance;
+
+  const Angle delta = Angle::Radians(max_distance * BOUNDS_MARGIN / REARTH);
+  const Angle latitude = reference.latitude.Absolute();
+
+  bounds_cos_min = latitude + delta < Angle::QuarterCircle()
+    ? (latitude + delta).cos()
+    : fixed(0);
+  bounds_cos_max = latitude > delta
+    ? (latitude - delta).cos()
+    : fixed(1);
+}
+
+bool
+ObservationZonePoint::IsCertainlyFartherThan(const GeoPoint &location,
+                                             fixed distance) const
+{
+  if (distance > bounds_distance || !positive(distance))
+    return false;
+
+  /* all in radians */
+  const fixed limit = distance * BOUNDS_MARGIN / REARTH;
+
+  const fixed dy = (location.latitude - reference.latitude).AbsoluteRadians();
+  if (dy > limit)
+    return true;
+
+  /* the latitude is now within the range covered by bounds_cos_min */
+  const fixed dx = (location.longitude - reference.longitude)
+    .AsDelta().AbsoluteRadians() * bounds_cos_min;
+  if (dx > limit)
+    return true;
+
+  return sqr(dx / limit) + sqr(dy / limit) > fixed(1);
+}
+
+bool
+ObservationZonePoint::IsCertainlyCloserThan(const GeoPoint &location,
+                                            fixed distance) const
+{
+  if (distance > bounds_distance || !positive(distance))
+    return false;
+
+  const fixed limit = distance / (BOUNDS_MARGIN * REARTH);
+
+  const fixed dy = (location.latitude - reference.latitude).AbsoluteRadians();
+  if (dy >= limit)
+    return false;
+
+  const fixed dx = (location.longitude - reference.longitude)
+    .AsDelta().AbsoluteRadians() * bounds_cos_max;
+  if (dx >= limit)
+    return false;
+
+  return sqr(dx / limit) + sqr(dy / limit) < fixed(1);
+}
@@ -34,11 +34,26 @@
 class ObservationZonePoint : public ObservationZone {
   GeoPoint reference;
 
+  /**
+   * The largest distance (m) supported by IsCertainlyFartherThan()
+   * and IsCertainlyCloserThan(), see UpdateBounds().
+   */
+  fixed bounds_distance;
+
+  /**
+   * The range of cos(latitude) of all locations whose latitude
+   * differs from the reference's by no more than #bounds_distance
+   * (with margin).  This is the scale of longitude differences.
+   */
+  fixed bounds_cos_min, bounds_cos_max;
+
 protected:
   ObservationZonePoint(const ObservationZonePoint &other,
                        const GeoPoint &_reference)
     :ObservationZone(other.GetShape(), other.CanStartThroughTop()),
-     reference(_reference) {}
+     reference(_reference),
+     bounds_distance(fixed(0)), bounds_cos_min(fixed(0)),
+     bounds_cos_max(fixed(0)) {}
 
 public:
   /**
@@ -51,7 +66,9 @@ public:
   ObservationZonePoint(Shape _shape, bool _can_start_through_top,
                        const GeoPoint & _location)
     :ObservationZone(_shape, _can_start_through_top),
-     reference(_location) {}
+     reference(_location),
+     bounds_distance(fixed(0)), bounds_cos_min(fixed(0)),
+     bounds_cos_max(fixed(0)) {}
 
   /**
    * Update geometry when previous/next legs are modified.
@@ -105,6 +122,40 @@ protected:
   fixed DistanceTo(const GeoPoint &ref) const {
     return reference.Distance(ref);
   }
+
+  /**
+   * Precompute the data for IsCertainlyFartherThan() and
+   * IsCertainlyCloserThan().  Must be called by the subclass
+   * whenever its size changes.
+   *
+   * @param max_distance the largest distance (m) which will be
+   * passed to these methods, i.e. the outer radius of the OZ
+   */
+  void UpdateBounds(fixed max_distance);
+
+  /**
+   * Cheap conservative test whether the location is farther than
+   * the specified distance from the reference.  This uses a flat
+   * approximation with error margins instead of the exact (and
+   * expensive) DistanceTo().
+   *
+   * @return true if the location is certainly farther, false if it
+   * is closer or if that cannot be decided cheaply
+   */
+  gcc_pure
+  bool IsCertainlyFartherThan(const GeoPoint &location,
+                              fixed distance) const;
+
+  /**
+   * Cheap conservative test whether the location is closer than the
+   * specified distance to the reference.
+   *
+   * @return true if the location is certainly closer, false if it
+   * is farther or if that cannot be decided cheaply
+   */
+  gcc_pure
+  bool IsCertainlyCloserThan(const GeoPoint &location,
+                             fixed distance) const;
 };
 
 #endif
@@ -40,6 +40,21 @@ SectorZone::GetBoundary() const
   return boundary;
 }
 
+OZBoundary
+SectorZone::GetBoundaryNear(const GeoPoint &location) const
+{
+  if (!arc_boundary)
+    return OZBoundary();
+
+  /* the points on the straight edges are not refined; only keep
+     the ones on the arc */
+  OZBoundary boundary = CylinderZone::GetBoundaryNear(location);
+  boundary.remove_if([this](const GeoPoint &p){
+      return !IsAngleInSector(GetReference().Bearing(p));
+    });
+  return boundary;
+}
+
 fixed
 SectorZone::ScoreAdjustment() const
 {
@@ -56,6 +71,9 @@ SectorZone::UpdateSector()
 bool 
 SectorZone::IsInSector(const GeoPoint &location) const
 {
+  if (IsCertainlyFartherThan(location, GetRadius()))
+    return false;
+
   GeoVector f(GetReference(), location);
 
   return f.distance <= GetRadius() && IsAngleInSector(f.bearing);
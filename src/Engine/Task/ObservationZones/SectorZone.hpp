@@ -156,6 +156,7 @@ public:
   /* virtual methods from class ObservationZone */
   virtual bool IsInSector(const GeoPoint &location) const override;
   virtual OZBoundary GetBoundary() const override;
+  virtual OZBoundary GetBoundaryNear(const GeoPoint &location) const override;
   virtual fixed ScoreAdjustment() const override;
 
   /* virtual methods from class ObservationZonePoint */
@@ -35,6 +35,7 @@
 #include "Task/Solvers/TaskMinTarget.hpp"
 #include "Task/Solvers/TaskGlideRequired.hpp"
 #include "Task/Solvers/TaskOptTarget.hpp"
+#include "Task/Solvers/TaskTargetSweep.hpp"
 #include "Task/Visitors/TaskPointVisitor.hpp"
 
 #include "Task/Factory/Create.hpp"
@@ -48,6 +49,7 @@
 #include "Task/PathSolvers/TaskDijkstraMin.hpp"
 #include "Task/PathSolvers/TaskDijkstraMax.hpp"
 #include "Task/ObservationZones/ObservationZoneClient.hpp"
+#include "Task/ObservationZones/Boundary.hpp"
 #include "Task/ObservationZones/CylinderZone.hpp"
 
 /**
@@ -89,10 +91,12 @@ OrderedTask::OrderedTask(const TaskBehaviour &tb)
   :AbstractTask(TaskType::ORDERED, tb),
    taskpoint_start(nullptr),
    taskpoint_finish(nullptr),
+   geometry_valid(false),
    factory_mode(tb.task_type_default),
    active_factory(nullptr),
    ordered_settings(tb.ordered_defaults),
-   dijkstra_min(nullptr), dijkstra_max(nullptr)
+   dijkstra_min(nullptr), dijkstra_max(nullptr),
+   dijkstra_min_refined(nullptr), dijkstra_max_refined(nullptr)
 {
   ClearName();
   active_factory = CreateTaskFactory(factory_mode, *this, task_behaviour);
@@ -107,6 +111,8 @@ OrderedTask::~OrderedTask()
 
   delete dijkstra_min;
   delete dijkstra_max;
+  delete dijkstra_min_refined;
+  delete dijkstra_max_refined;
 }
 
 const TaskFactoryConstraints &
@@ -172,6 +178,7 @@ OrderedTask::UpdateGeometry()
 
   // projection can now be determined
   task_projection.Update();
+  geometry_valid = true;
 
   // update OZ's for items that depend on next-point geometry
   UpdateObservationZones(task_points, task_projection);
@@ -185,6 +192,43 @@ OrderedTask::UpdateGeometry()
   for (const auto tp : optional_start_points)
     tp->UpdateBoundingBox(task_projection);
 
+  UpdateStatsAfterGeometry();
+}
+
+void
+OrderedTask::CopyGeometry(const OrderedTask &other)
+{
+  UpdateStatsGeometry();
+
+  if (!HasStart() || !task_points[0])
+    return;
+
+  if (!other.geometry_valid ||
+      task_points.size() != other.task_points.size() ||
+      optional_start_points.size() != other.optional_start_points.size()) {
+    /* the source geometry is stale, or some points were rejected and
+       this is not an exact copy */
+    UpdateGeometry();
+    return;
+  }
+
+  taskpoint_start->ScanActive(*task_points[active_task_point]);
+
+  task_projection = other.task_projection;
+  geometry_valid = true;
+
+  for (unsigned i = 0, n = task_points.size(); i != n; ++i)
+    task_points[i]->CopyGeometry(*other.task_points[i]);
+
+  for (unsigned i = 0, n = optional_start_points.size(); i != n; ++i)
+    optional_start_points[i]->CopyGeometry(*other.optional_start_points[i]);
+
+  UpdateStatsAfterGeometry();
+}
+
+void
+OrderedTask::UpdateStatsAfterGeometry()
+{
   // update stats so data can be used during task construction
   /// @todo this should only be done if not flying! (currently done with has_entered)
   if (!taskpoint_start->HasEntered()) {
@@ -220,6 +264,46 @@ OrderedTask::ScanLegStartTime()
 
 // DISTANCES
 
+bool
+OrderedTask::RefineSearch(const TaskDijkstra &coarse, TaskDijkstra &fine,
+                          unsigned first, unsigned n)
+{
+  /* the solution of #coarse is read after #fine has been modified */
+  assert(&fine != &coarse);
+
+  if (refined_boundaries.size() < n)
+    refined_boundaries.resize(n);
+
+  bool refined = false;
+
+  fine.SetTaskSize(n);
+  for (unsigned i = 0; i != n; ++i) {
+    const OrderedTaskPoint &tp = *task_points[first + i];
+    const SearchPoint &solution = coarse.GetSolution(i);
+
+    /* the coarse solution goes first, so TaskDijkstra keeps it unless
+       there is a measurable advantage; the other points of the coarse
+       search are not searched again */
+    SearchPointVector &dest = refined_boundaries[i];
+    dest.clear();
+    dest.push_back(solution);
+
+    /* sampled or nominal points are not on the boundary and cannot
+       be refined */
+    if (&coarse.GetBoundary(i) == &tp.GetBoundaryPoints()) {
+      for (const GeoPoint &location :
+             tp.GetBoundaryNear(solution.GetLocation())) {
+        dest.push_back(SearchPoint(location, task_projection));
+        refined = true;
+      }
+    }
+
+    fine.SetBoundary(i, dest);
+  }
+
+  return refined;
+}
+
 inline bool
 OrderedTask::RunDijsktraMin(const GeoPoint &location)
 {
@@ -227,6 +311,8 @@ OrderedTask::RunDijsktraMin(const GeoPoint &location)
   if (task_size < 2)
     return false;
 
+  const ScopeTaskProfile profile(profiler, TaskProfiler::Stage::DIJKSTRA);
+
   if (dijkstra_min == nullptr)
     dijkstra_min = new TaskDijkstraMin();
   TaskDijkstraMin &dijkstra = *dijkstra_min;
@@ -242,8 +328,19 @@ OrderedTask::RunDijsktraMin(const GeoPoint &location)
   if (!dijkstra.DistanceMin(ac))
     return false;
 
+  /* search again near the optimum, with a finer resolution */
+  if (dijkstra_min_refined == nullptr)
+    dijkstra_min_refined = new TaskDijkstraMin();
+  TaskDijkstraMin &fine = *dijkstra_min_refined;
+
+  const TaskDijkstraMin &result =
+    RefineSearch(dijkstra, fine, active_index, task_size - active_index) &&
+    fine.DistanceMin(ac)
+    ? fine
+    : dijkstra;
+
   for (unsigned i = active_index; i != task_size; ++i)
-    SetPointSearchMin(i, dijkstra.GetSolution(i - active_index));
+    SetPointSearchMin(i, result.GetSolution(i - active_index));
 
   return true;
 }
@@ -252,24 +349,11 @@ inline fixed
 OrderedTask::ScanDistanceMin(const GeoPoint &location, bool full)
 {
   if (!full && location.IsValid() && last_min_location.IsValid() &&
-      DistanceIsSignificant(location, last_min_location)) {
-    const TaskWaypoint *active = GetActiveTaskPoint();
-    if (active != nullptr) {
-      const GeoPoint &target = active->GetWaypoint().location;
-      const unsigned last_distance =
-        (unsigned)last_min_location.Distance(target);
-      const unsigned cur_distance =
-        (unsigned)location.Distance(target);
-
-      /* do the full scan only if the distance to the active task
-         point has changed by more than 5%, otherwise we don't expect
-         any relevant changes */
-      if (last_distance < 2000 || cur_distance < 2000 ||
-          last_distance * 20 >= cur_distance * 21 ||
-          cur_distance * 20 >= last_distance * 21)
-        full = true;
-    }
-  }
+      DistanceIsSignificant(location, last_min_location))
+    /* this is cheap: TaskDijkstraMin keeps the distances from the
+       remaining task points to the finish, and only the first leg
+       gets solved again */
+    full = true;
 
   if (full) {
     RunDijsktraMin(location);
@@ -286,6 +370,8 @@ OrderedTask::RunDijsktraMax()
   if (task_size < 2)
     return false;
 
+  const ScopeTaskProfile profile(profiler, TaskProfiler::Stage::DIJKSTRA);
+
   if (dijkstra_max == nullptr)
     dijkstra_max = new TaskDijkstraMax();
   TaskDijkstraMax &dijkstra = *dijkstra_max;
@@ -324,14 +410,25 @@ OrderedTask::RunDijsktraMax()
   if (!dijkstra_max->DistanceMax())
     return false;
 
+  /* search again near the optimum, with a finer resolution; the
+     coarse solution is kept as a fallback */
+  if (dijkstra_max_refined == nullptr)
+    dijkstra_max_refined = new TaskDijkstraMax();
+  TaskDijkstraMax &fine = *dijkstra_max_refined;
+
+  const TaskDijkstraMax &result =
+    RefineSearch(dijkstra, fine, 0, task_size) && fine.DistanceMax()
+    ? fine
+    : dijkstra;
+
   for (unsigned i = 0; i != task_size; ++i) {
-    SearchPoint solution = dijkstra.GetSolution(i);
+    SearchPoint solution = result.GetSolution(i);
 
     if (i == 0 && positive(start_radius)) {
       /* subtract start cylinder radius by finding the intersection
          with the cylinder boundary */
       const GeoPoint &current = taskpoint_start->GetLocation();
-      const GeoPoint &neighbour = dijkstra.GetSolution(i + 1).GetLocation();
+      const GeoPoint &neighbour = result.GetSolution(i + 1).GetLocation();
       GeoPoint gp = current.IntermediatePoint(neighbour, start_radius);
       solution = SearchPoint(gp, task_projection);
     }
@@ -340,7 +437,7 @@ OrderedTask::RunDijsktraMax()
       /* subtract finish cylinder radius by finding the intersection
          with the cylinder boundary */
       const GeoPoint &current = taskpoint_finish->GetLocation();
-      const GeoPoint &neighbour = dijkstra.GetSolution(i - 1).GetLocation();
+      const GeoPoint &neighbour = result.GetSolution(i - 1).GetLocation();
       GeoPoint gp = current.IntermediatePoint(neighbour, finish_radius);
       solution = SearchPoint(gp, task_projection);
     }
@@ -633,6 +730,7 @@ OrderedTask::UpdateIdle(const AircraftState &state,
 
   if (HasStart() && task_behaviour.optimise_targets_range &&
       positive(GetOrderedTaskSettings().aat_min_time)) {
+    const ScopeTaskProfile profile(profiler, TaskProfiler::Stage::TARGETS);
 
     CalcMinTarget(state, glide_polar,
                   GetOrderedTaskSettings().aat_min_time + fixed(task_behaviour.optimise_targets_margin));
@@ -673,6 +771,8 @@ OrderedTask::SetNeighbours(unsigned position)
   OrderedTaskPoint* prev = nullptr;
   OrderedTaskPoint* next = nullptr;
 
+  geometry_valid = false;
+
   if (!task_points[position])
     // nothing to do if this is deleted
     return;
@@ -716,6 +816,26 @@ OrderedTask::GetAATTaskPoint(unsigned TPindex) const
  return nullptr;
 }
 
+bool
+OrderedTask::EvaluateTargets(unsigned index, const AircraftState &state,
+                             const GlidePolar &glide_polar,
+                             const RangeAndRadial *settings, unsigned n,
+                             TargetSweepResult *results)
+{
+  if (!HasStart() || index < active_task_point)
+    return false;
+
+  AATPoint *ap = GetAATTaskPoint(index);
+  if (ap == nullptr)
+    return false;
+
+  TaskTargetSweep sweep(task_points, active_task_point, state,
+                        task_behaviour.glide, glide_polar,
+                        *ap, task_projection, taskpoint_start);
+  sweep.Evaluate(settings, n, results);
+  return true;
+}
+
 bool
 OrderedTask::ScanStartFinish()
 {
@@ -741,6 +861,7 @@ OrderedTask::ScanStartFinish()
 inline void
 OrderedTask::ErasePoint(const unsigned index)
 {
+  geometry_valid = false;
   delete task_points[index];
   task_points.erase(task_points.begin() + index);
 }
@@ -748,6 +869,7 @@ OrderedTask::ErasePoint(const unsigned index)
 inline void
 OrderedTask::EraseOptionalStartPoint(const unsigned index)
 {
+  geometry_valid = false;
   delete optional_start_points[index];
   optional_start_points.erase(optional_start_points.begin() + index);
 }
@@ -814,6 +936,7 @@ OrderedTask::AppendOptionalStart(const OrderedTaskPoint &new_tp)
 {
   optional_start_points.push_back(new_tp.Clone(task_behaviour,
                                                ordered_settings));
+  geometry_valid = false;
   if (task_points.size() > 1)
     SetNeighbours(0);
   return true;
@@ -1271,7 +1394,7 @@ OrderedTask::Clone(const TaskBehaviour &tb) const
     new_task->AppendOptionalStart(*tp);
 
   new_task->active_task_point = active_task_point;
-  new_task->UpdateGeometry();
+  new_task->CopyGeometry(*this);
 
   new_task->SetName(GetName());
 
@@ -1356,7 +1479,8 @@ OrderedTask::Commit(const OrderedTask& that)
     }
   }
 
-  if (modified)
+  if (modified || !geometry_valid)
+    /* the settings may have changed even if all points are equal */
     UpdateGeometry();
     // @todo also re-scan task sample state,
     // potentially resetting task
@@ -1426,6 +1550,8 @@ OrderedTask::SetOrderedTaskSettings(const OrderedTaskSettings& ob)
 void
 OrderedTask::PropagateOrderedTaskSettings()
 {
+  geometry_valid = false;
+
   for (auto tp : task_points)
     tp->SetOrderedTaskSettings(ordered_settings);
 
@@ -1468,6 +1594,7 @@ OrderedTask::RemoveAllPoints()
   taskpoint_start = nullptr;
   taskpoint_finish = nullptr;
   force_full_update = true;
+  geometry_valid = false;
 }
 
 void
@@ -24,6 +24,7 @@
 #define ORDEREDTASK_H
 
 #include "Geo/Flat/TaskProjection.hpp"
+#include "Geo/SearchPointVector.hpp"
 #include "Task/AbstractTask.hpp"
 #include "SmartTaskAdvance.hpp"
 #include "Util/DereferenceIterator.hpp"
@@ -33,16 +34,18 @@
 #include <vector>
 
 class SearchPoint;
-class SearchPointVector;
 class OrderedTaskPoint;
 class StartPoint;
 class FinishPoint;
 class AbstractTaskFactory;
+class TaskDijkstra;
 class TaskDijkstraMin;
 class TaskDijkstraMax;
 struct Waypoint;
 class Waypoints;
 class AATPoint;
+struct RangeAndRadial;
+struct TargetSweepResult;
 class FlatBoundingBox;
 class GeoBounds;
 struct TaskSummary;
@@ -77,6 +80,14 @@ private:
 
   TaskProjection task_projection;
 
+  /**
+   * Is #task_projection (and the OZ geometry of the points) up to
+   * date?  Set by UpdateGeometry(), cleared when points are added,
+   * removed or replaced, or when the settings change.  Only a valid
+   * geometry may be copied by Clone().
+   */
+  bool geometry_valid;
+
   GeoPoint last_min_location;
 
   TaskFactoryType factory_mode;
@@ -86,6 +97,25 @@ private:
   TaskDijkstraMin *dijkstra_min;
   TaskDijkstraMax *dijkstra_max;
 
+  /**
+   * Solves the minimum distance again on the refined boundaries; this
+   * is separate from #dijkstra_min to keep the latter's cache intact.
+   */
+  TaskDijkstraMin *dijkstra_min_refined;
+
+  /**
+   * Solves the maximum distance again on the refined boundaries.
+   * RefineSearch() reads the solution of #dijkstra_max while setting
+   * up this one.
+   */
+  TaskDijkstraMax *dijkstra_max_refined;
+
+  /**
+   * The search points near the TaskDijkstra solution, generated by
+   * RefineSearch().  Indexed by stage.
+   */
+  std::vector<SearchPointVector> refined_boundaries;
+
   StaticString<64> name;
 
 public:
@@ -149,6 +179,11 @@ public:
    * Create a clone of the task.
    * Caller is responsible for destruction.
    *
+   * If the geometry of this task is up to date, the clone shares
+   * the OZ boundaries with this task and takes over its projection
+   * instead of calculating them again.  Otherwise, the clone's
+   * geometry is calculated from scratch.
+   *
    * @param te Task events
    * @param tb Task behaviour
    *
@@ -332,6 +367,23 @@ public:
   */
  AATPoint* GetAATTaskPoint(unsigned index) const;
 
+  /**
+   * Evaluate the remainder of the task for a batch of hypothetical
+   * targets of the specified AATPoint, see TaskTargetSweep.  The
+   * targets are restored afterwards.
+   *
+   * @param index the index of the AATPoint; must not be before the
+   * active task point
+   * @param settings an array of target settings
+   * @param n the number of elements in #settings and #results
+   * @param results receives one result per setting
+   * @return false if there is no such AATPoint
+   */
+  bool EvaluateTargets(unsigned index, const AircraftState &state,
+                       const GlidePolar &glide_polar,
+                       const RangeAndRadial *settings, unsigned n,
+                       TargetSweepResult *results);
+
   /**
    * Check whether the task point with the specified index exists.
    */
@@ -376,6 +428,22 @@ public:
    */
   void UpdateGeometry();
 
+private:
+  /**
+   * Like UpdateGeometry(), but copy the projection and the OZ
+   * geometry from the task this one was cloned from.  Falls back to
+   * UpdateGeometry() if that task's geometry is not valid.
+   */
+  void CopyGeometry(const OrderedTask &other);
+
+  /**
+   * The final part of UpdateGeometry() and CopyGeometry(): update
+   * the distance statistics.
+   */
+  void UpdateStatsAfterGeometry();
+
+public:
+
   /**
    * Convert a GeoBounds into a flat bounding box projected
    * according to the task projection.
@@ -433,6 +501,22 @@ public:
   bool ScanStartFinish();
 
 private:
+  /**
+   * Prepare a second pass after a TaskDijkstra run on the coarse OZ
+   * boundaries: each stage is reduced to its solution point, plus
+   * the finer samples around it (ObservationZone::GetBoundaryNear())
+   * if it was searched on the full boundary of its task point.
+   *
+   * @param coarse the solved TaskDijkstra
+   * @param fine the TaskDijkstra to be set up; must not be the same
+   * object as #coarse
+   * @param first the index of the task point of the first stage
+   * @param n the number of stages
+   * @return true if at least one stage was refined, i.e. if a second
+   * pass is worth it
+   */
+  bool RefineSearch(const TaskDijkstra &coarse, TaskDijkstra &fine,
+                    unsigned first, unsigned n);
 
   /**
    * @return true if a solution was found (and applied)
@@ -70,6 +70,13 @@ OrderedTaskPoint::UpdateOZ(const TaskProjection &projection)
   SampledTaskPoint::UpdateOZ(projection, GetBoundary());
 }
 
+void
+OrderedTaskPoint::CopyGeometry(const OrderedTaskPoint &other)
+{
+  SampledTaskPoint::CopyGeometry(other);
+  flat_bb = other.flat_bb;
+}
+
 bool
 OrderedTaskPoint::ScanActive(const OrderedTaskPoint &atp)
 {
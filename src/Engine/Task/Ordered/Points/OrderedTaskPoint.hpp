@@ -221,6 +221,13 @@ public:
 
   void UpdateOZ(const TaskProjection &projection);
 
+  /**
+   * Copy the results of UpdateOZ() and UpdateBoundingBox() from the
+   * point this one was cloned from.  The caller must ensure that both
+   * points have the same geometry and projection.
+   */
+  void CopyGeometry(const OrderedTaskPoint &other);
+
   /**
    * Update the bounding box in flat projected coordinates
    */
@@ -31,7 +31,7 @@ TaskDijkstra::TaskDijkstra(bool _is_min)
 {
 }
 
-inline unsigned
+unsigned
 TaskDijkstra::GetStageSize(const unsigned stage) const
 {
   assert(stage < num_stages);
@@ -85,7 +85,16 @@ public:
     return GetPoint(ScanTaskPoint(stage, solution[stage]));
   }
 
+  const SearchPointVector &GetBoundary(unsigned stage) const {
+    assert(stage < num_stages);
+
+    return *boundaries[stage];
+  }
+
 protected:
+  gcc_pure
+  unsigned GetStageSize(const unsigned stage) const;
+
   gcc_pure
   const SearchPoint &GetPoint(ScanTaskPoint sp) const;
 
@@ -143,10 +152,6 @@ protected:
     return CalcDistance(s1, GetPoint(s2));
   }
 
-private:
-  gcc_pure
-  unsigned GetStageSize(const unsigned stage) const;
-
 protected:
   /* methods from NavDijkstra */
   virtual void AddEdges(ScanTaskPoint curNode) final;
@@ -21,19 +21,118 @@
 */
 
 #include "TaskDijkstraMin.hpp"
+#include "Geo/SearchPointVector.hpp"
+
+#include <algorithm>
+
+#include <limits.h>
 
 bool
-TaskDijkstraMin::DistanceMin(const SearchPoint &currentLocation)
+TaskDijkstraMin::UpdateStageKey(unsigned stage)
+{
+  const SearchPointVector &boundary = GetBoundary(stage);
+  std::vector<FlatGeoPoint> &key = keys[stage];
+
+  if (key.size() == boundary.size() &&
+      std::equal(boundary.begin(), boundary.end(), key.begin(),
+                 [](const SearchPoint &a, const FlatGeoPoint &b) {
+                   return a.GetFlatLocation() == b;
+                 }))
+    return false;
+
+  key.clear();
+  key.reserve(boundary.size());
+  for (const SearchPoint &i : boundary)
+    key.push_back(i.GetFlatLocation());
+
+  return true;
+}
+
+void
+TaskDijkstraMin::UpdateStage(unsigned stage)
+{
+  const unsigned size = GetStageSize(stage);
+  std::vector<Node> &row = nodes[stage];
+  row.resize(size);
+
+  if (IsFinal(stage)) {
+    for (Node &node : row)
+      node = Node{0, 0};
+    return;
+  }
+
+  const unsigned next_stage = stage + 1;
+  const std::vector<Node> &next_row = nodes[next_stage];
+  const unsigned next_size = next_row.size();
+
+  for (unsigned i = 0; i < size; ++i) {
+    const ScanTaskPoint origin(stage, i);
+    Node best{UINT_MAX, 0};
+
+    for (unsigned j = 0; j < next_size; ++j) {
+      const unsigned distance = next_row[j].distance +
+        CalcDistance(origin, ScanTaskPoint(next_stage, j));
+      if (distance < best.distance)
+        best = Node{distance, j};
+    }
+
+    row[i] = best;
+  }
+}
+
+bool
+TaskDijkstraMin::UpdateDistancesToFinish()
 {
-  dijkstra.Clear();
-  dijkstra.Reserve(256);
+  if (num_stages != cached_stages)
+    cached_stages = 0;
 
-  if (currentLocation.IsValid()) {
-    AddStartEdges(0, currentLocation);
-  } else {
-    AddZeroStartEdges();
+  /* find the last stage whose boundary has changed; this one and all
+     stages before it need to be calculated again */
+  unsigned dirty = 0;
+  for (unsigned stage = num_stages; stage-- > 0;) {
+    if (GetBoundary(stage).empty()) {
+      cached_stages = 0;
+      return false;
+    }
+
+    if (UpdateStageKey(stage) || cached_stages == 0) {
+      if (dirty == 0)
+        dirty = stage + 1;
+    }
   }
 
-  return Run();
+  cached_stages = num_stages;
+
+  for (unsigned stage = dirty; stage-- > 0;)
+    UpdateStage(stage);
+
+  return true;
 }
 
+bool
+TaskDijkstraMin::DistanceMin(const SearchPoint &currentLocation)
+{
+  if (num_stages == 0 || !UpdateDistancesToFinish())
+    return false;
+
+  const std::vector<Node> &first = nodes[0];
+
+  unsigned best_distance = UINT_MAX, best_index = 0;
+  for (unsigned i = 0, n = first.size(); i < n; ++i) {
+    unsigned distance = first[i].distance;
+    if (currentLocation.IsValid())
+      distance += CalcDistance(ScanTaskPoint(0, i), currentLocation);
+
+    if (distance < best_distance) {
+      best_distance = distance;
+      best_index = i;
+    }
+  }
+
+  for (unsigned stage = 0; stage < num_stages; ++stage) {
+    solution[stage] = best_index;
+    best_index = nodes[stage][best_index].next;
+  }
+
+  return true;
+}
@@ -25,13 +25,48 @@
 
 #include "TaskDijkstra.hpp"
 
+#include <vector>
+
 /**
- * Specialisation of TaskDijkstra for minimum distance search
+ * Specialisation of TaskDijkstra for minimum distance search.
+ *
+ * The minimum distance from each search point to the finish depends
+ * only on the task geometry, therefore it is computed backwards,
+ * stage by stage, and kept until the boundaries change.  Only the
+ * first leg from the aircraft's location is evaluated on each call.
  */
 class TaskDijkstraMin final : public TaskDijkstra {
+  struct Node {
+    /**
+     * The minimum distance from this search point to the finish.
+     */
+    unsigned distance;
+
+    /**
+     * The index of the next stage's search point on this path.
+     */
+    unsigned next;
+  };
+
+  /**
+   * The number of stages in #nodes, zero if nothing is cached.
+   */
+  unsigned cached_stages;
+
+  /**
+   * A copy of the flat locations of each stage's boundary as of the
+   * last calculation.  The boundary vectors may be replaced by new
+   * ones at the same address, and the search points of the active
+   * task point may change while flying, therefore the points are
+   * compared, not the vector's address.
+   */
+  std::vector<FlatGeoPoint> keys[MAX_STAGES];
+
+  std::vector<Node> nodes[MAX_STAGES];
+
 public:
   TaskDijkstraMin()
-    :TaskDijkstra(true) {}
+    :TaskDijkstra(true), cached_stages(0) {}
 
   /**
    * Search task points for targets within OZs to produce the
@@ -47,6 +82,29 @@ public:
    * @return True if succeeded
    */
   bool DistanceMin(const SearchPoint &location);
+
+private:
+  /**
+   * Compare the stage's boundary with its copy in #keys, and update
+   * the copy.
+   *
+   * @return true if the boundary has changed
+   */
+  bool UpdateStageKey(unsigned stage);
+
+  /**
+   * Calculate the distances to the finish for the specified stage,
+   * assuming the following stages are up to date.
+   */
+  void UpdateStage(unsigned stage);
+
+  /**
+   * Update the cached distances to the finish of all stages whose
+   * boundaries (or the following ones) have changed.
+   *
+   * @return false if a stage has no search points
+   */
+  bool UpdateDistancesToFinish();
 };
 
 #endif
@@ -24,6 +24,8 @@
 #include "Task/ObservationZones/Boundary.hpp"
 #include "Navigation/Aircraft.hpp"
 
+#include <assert.h>
+
 SampledTaskPoint::SampledTaskPoint(const GeoPoint &location,
                                    const bool b_scored)
   :boundary_scored(b_scored), past(false)
@@ -77,14 +79,39 @@ SampledTaskPoint::UpdateOZ(const TaskProjection &projection,
                            const OZBoundary &_boundary)
 {
   search_max = search_min = nominal_points.front();
-  boundary_points.clear();
 
+  /* never modify the old polygon, it may be shared with a clone */
+  auto *boundary = new SearchPointVector();
   for (const SearchPoint sp : _boundary)
-    boundary_points.push_back(sp);
+    boundary->push_back(sp);
+
+  boundary->Project(projection);
+  boundary_points.reset(boundary);
 
   UpdateProjection(projection);
 }
 
+void
+SampledTaskPoint::CopyGeometry(const SampledTaskPoint &other)
+{
+  assert(nominal_points.front().GetLocation() ==
+         other.nominal_points.front().GetLocation());
+
+  nominal_points = other.nominal_points;
+  search_max = search_min = nominal_points.front();
+  boundary_points = other.boundary_points;
+}
+
+const SearchPointVector &
+SampledTaskPoint::GetBoundaryPoints() const
+{
+  static const SearchPointVector empty;
+
+  return boundary_points != nullptr
+    ? *boundary_points
+    : empty;
+}
+
 // SAMPLES + BOUNDARY
 
 void
@@ -94,7 +121,6 @@ SampledTaskPoint::UpdateProjection(const TaskProjection &projection)
   search_min.Project(projection);
   nominal_points.Project(projection);
   sampled_points.Project(projection);
-  boundary_points.Project(projection);
 }
 
 void
@@ -115,5 +141,5 @@ SampledTaskPoint::GetSearchPoints() const
     // to de-rate the score in some way
     return nominal_points;
 
-  return boundary_points;
+  return GetBoundaryPoints();
 }
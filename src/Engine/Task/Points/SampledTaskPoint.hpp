@@ -26,6 +26,8 @@
 #include "Geo/SearchPointVector.hpp"
 #include "Compiler.h"
 
+#include <memory>
+
 class TaskProjection;
 class OZBoundary;
 struct GeoPoint;
@@ -57,7 +59,14 @@ class SampledTaskPoint {
 
   SearchPointVector nominal_points;
   SearchPointVector sampled_points;
-  SearchPointVector boundary_points;
+
+  /**
+   * The boundary polygon, generated by UpdateOZ().  It is never
+   * modified, only replaced, and may therefore be shared with clones
+   * of this task point (see CopyGeometry()).  nullptr if UpdateOZ()
+   * has not been called yet.
+   */
+  std::shared_ptr<const SearchPointVector> boundary_points;
   SearchPoint search_max;
   SearchPoint search_min;
 
@@ -113,6 +122,13 @@ public:
    */
   void UpdateOZ(const TaskProjection &projection, const OZBoundary &boundary);
 
+  /**
+   * Copy the results of UpdateOZ() from another task point with the
+   * same location and observation zone, instead of generating the
+   * boundary again.  The boundary polygon is shared, not copied.
+   */
+  void CopyGeometry(const SampledTaskPoint &other);
+
 protected:
   /**
    * Update the interior sample polygon.  The caller checks if the
@@ -148,9 +164,8 @@ public:
   /**
    * Retrieve boundary points polygon
    */
-  const SearchPointVector &GetBoundaryPoints() const {
-    return boundary_points;
-  }
+  gcc_pure
+  const SearchPointVector &GetBoundaryPoints() const;
 
   /**
    * Return a #SearchPointVector that contains just the reference
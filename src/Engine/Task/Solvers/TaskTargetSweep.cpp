@@ -0,0 +1,61 @@
+/* Copyright_License {
+
+  XCSoar Glide Computer - http://www.xcsoar.org/
+  Copyright (C) 2000-2014 The XCSoar Project
+  A detailed list of copyright holders can be found in the file "AUTHORS".
+
+  This program is free software; you can redistribute it and/or
+  modify it under the terms of the GNU General Public License
+  as published by the Free Software Foundation; either version 2
+  of the License, or (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+}
+ */
+
+#include "TaskTargetSweep.hpp"
+#include "Task/Ordered/Points/AATPoint.hpp"
+#include "Task/Ordered/Points/StartPoint.hpp"
+
+TaskTargetSweep::TaskTargetSweep(const std::vector<OrderedTaskPoint*>& tps,
+                                 const unsigned activeTaskPoint,
+                                 const AircraftState &_aircraft,
+                                 const GlideSettings &settings,
+                                 const GlidePolar &_gp,
+                                 AATPoint &_tp_current,
+                                 const TaskProjection &_projection,
+                                 StartPoint *_ts)
+  :tm(tps.cbegin(), tps.cend(), activeTaskPoint, settings, _gp,
+      /* ignore the travel to the start point */
+      false),
+   aircraft(_aircraft),
+   tp_start(_ts),
+   tp_current(_tp_current),
+   projection(_projection)
+{
+}
+
+void
+TaskTargetSweep::Evaluate(const RangeAndRadial *settings, unsigned n,
+                          TargetSweepResult *results)
+{
+  tm.target_save();
+
+  for (unsigned i = 0; i < n; ++i) {
+    tp_current.SetTarget(settings[i], projection);
+    tp_start->ScanDistanceRemaining(aircraft.location);
+
+    results[i].location = tp_current.GetTargetLocation();
+    results[i].solution = tm.glide_solution(aircraft);
+  }
+
+  tm.target_restore();
+  tp_start->ScanDistanceRemaining(aircraft.location);
+}
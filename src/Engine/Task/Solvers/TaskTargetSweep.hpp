@@ -0,0 +1,100 @@
+/* Copyright_License {
+
+  XCSoar Glide Computer - http://www.xcsoar.org/
+  Copyright (C) 2000-2014 The XCSoar Project
+  A detailed list of copyright holders can be found in the file "AUTHORS".
+
+  This program is free software; you can redistribute it and/or
+  modify it under the terms of the GNU General Public License
+  as published by the Free Software Foundation; either version 2
+  of the License, or (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+}
+ */
+
+#ifndef TASK_TARGET_SWEEP_HPP
+#define TASK_TARGET_SWEEP_HPP
+
+#include "TaskMacCreadyRemaining.hpp"
+#include "Geo/GeoPoint.hpp"
+
+#include <vector>
+
+struct RangeAndRadial;
+class StartPoint;
+class AATPoint;
+class TaskProjection;
+
+/**
+ * The result of one hypothetical target setting evaluated by
+ * TaskTargetSweep.
+ */
+struct TargetSweepResult {
+  /** The target location of this setting */
+  GeoPoint location;
+
+  /** The solution for the remainder of the task */
+  GlideResult solution;
+};
+
+/**
+ * Evaluate the remainder of the task for a batch of hypothetical
+ * targets of one AATPoint ("what if the target was there?"), for
+ * example to show the time and speed for the whole area in the
+ * target dialog.
+ *
+ * Like the other target solvers, this moves the target while
+ * evaluating, but all targets and distances are restored
+ * afterwards.  The lock of the target is ignored.
+ */
+class TaskTargetSweep {
+  /** Object to calculate remaining task statistics */
+  TaskMacCreadyRemaining tm;
+  /** Observer */
+  const AircraftState &aircraft;
+  /** Start of task */
+  StartPoint *tp_start;
+  /** The AATPoint whose target is moved */
+  AATPoint &tp_current;
+  const TaskProjection &projection;
+
+public:
+  /**
+   * Constructor for ordered task points
+   *
+   * @param tps Vector of ordered task points comprising the task
+   * @param activeTaskPoint Current active task point in sequence
+   * @param _aircraft Current aircraft state
+   * @param _gp Glide polar to copy for calculations
+   * @param _tp_current The AATPoint to be evaluated; must not be
+   * before the active task point
+   * @param _ts StartPoint of task (to initiate scans)
+   */
+  TaskTargetSweep(const std::vector<OrderedTaskPoint*>& tps,
+                  const unsigned activeTaskPoint,
+                  const AircraftState &_aircraft,
+                  const GlideSettings &settings, const GlidePolar &_gp,
+                  AATPoint &_tp_current,
+                  const TaskProjection &projection,
+                  StartPoint *_ts);
+
+  /**
+   * Evaluate the specified target settings.
+   *
+   * @param settings an array of target settings
+   * @param n the number of elements in #settings and #results
+   * @param results receives one result per setting
+   */
+  void Evaluate(const RangeAndRadial *settings, unsigned n,
+                TargetSweepResult *results);
+};
+
+#endif
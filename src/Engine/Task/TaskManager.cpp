@@ -54,6 +54,14 @@ TaskManager::SetTaskEvents(TaskEvents &_task_events)
   abort_task->SetTaskEvents(_task_events);
 }
 
+void
+TaskManager::SetProfiler(TaskProfiler *profiler)
+{
+  ordered_task->SetProfiler(profiler);
+  goto_task->SetProfiler(profiler);
+  abort_task->SetProfiler(profiler);
+}
+
 void
 TaskManager::SetTaskBehaviour(const TaskBehaviour &behaviour)
 {
@@ -515,6 +523,18 @@ TaskManager::TargetLock(const unsigned index, bool do_lock)
   return true;
 }
 
+bool
+TaskManager::EvaluateTargets(const unsigned index, const AircraftState &state,
+                             const RangeAndRadial *settings, unsigned n,
+                             TargetSweepResult *results)
+{
+  if (!CheckOrderedTask())
+    return false;
+
+  return ordered_task->EvaluateTargets(index, state, glide_polar,
+                                       settings, n, results);
+}
+
 OrderedTask *
 TaskManager::Clone(const TaskBehaviour &tb) const
 {
@@ -32,6 +32,7 @@
 
 class AbstractTaskFactory;
 class TaskEvents;
+class TaskProfiler;
 class TaskAdvance;
 class Waypoints;
 class AbstractTask;
@@ -43,6 +44,7 @@ class TaskWaypoint;
 class AbortIntersectionTest;
 struct Waypoint;
 struct RangeAndRadial;
+struct TargetSweepResult;
 
 /**
  *  Main interface exposed to clients for providing access to common types
@@ -85,6 +87,11 @@ public:
 
   void SetTaskEvents(TaskEvents &_task_events);
 
+  /**
+   * Set the TaskProfiler of all tasks, see AbstractTask::SetProfiler().
+   */
+  void SetProfiler(TaskProfiler *profiler);
+
   /**
    * Returns a reference to the OrderedTask instance, even if it is
    * invalid or inactive.
@@ -413,6 +420,17 @@ public:
    */
  bool TargetLock(const unsigned index, bool do_lock);
 
+  /**
+   * Evaluate the remainder of the ordered task for a batch of
+   * hypothetical targets of the specified tp, with the task's glide
+   * polar.  Used by dlgTarget.
+   *
+   * @see OrderedTask::EvaluateTargets()
+   */
+ bool EvaluateTargets(const unsigned index, const AircraftState &state,
+                      const RangeAndRadial *settings, unsigned n,
+                      TargetSweepResult *results);
+
   /** 
    * Copy TaskBehaviour to this task
    * 
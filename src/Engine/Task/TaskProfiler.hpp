@@ -0,0 +1,92 @@
+/* Copyright_License {
+
+  XCSoar Glide Computer - http://www.xcsoar.org/
+  Copyright (C) 2000-2014 The XCSoar Project
+  A detailed list of copyright holders can be found in the file "AUTHORS".
+
+  This program is free software; you can redistribute it and/or
+  modify it under the terms of the GNU General Public License
+  as published by the Free Software Foundation; either version 2
+  of the License, or (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+}
+ */
+
+#ifndef XCSOAR_TASK_PROFILER_HPP
+#define XCSOAR_TASK_PROFILER_HPP
+
+#include <stdint.h>
+
+/**
+ * Class used to measure the stages of the task engine's update,
+ * e.g. in a benchmark.  The task calls Begin() and End() around each
+ * stage; the DIJKSTRA stage is nested within DISTANCES.
+ */
+class TaskProfiler
+{
+public:
+  enum class Stage : uint8_t {
+    /** AbstractTask::CheckTransitions() */
+    TRANSITIONS,
+
+    /** AbstractTask::UpdateStatsDistances() */
+    DISTANCES,
+
+    /** TaskDijkstraMin and TaskDijkstraMax searches */
+    DIJKSTRA,
+
+    /** AbstractTask::UpdateGlideSolutions() */
+    GLIDE,
+
+    /** AbstractTask::UpdateSample() */
+    SAMPLE,
+
+    /** times, speeds and flight mode */
+    STATS,
+
+    /** AbstractTask::UpdateIdle() */
+    IDLE,
+
+    /** OrderedTask: optimisation of the AAT targets */
+    TARGETS,
+
+    COUNT
+  };
+
+  virtual void Begin(Stage stage) = 0;
+  virtual void End(Stage stage) = 0;
+};
+
+/**
+ * Calls TaskProfiler::Begin() now and TaskProfiler::End() at the end
+ * of the scope.  Does nothing if there is no TaskProfiler.
+ */
+class ScopeTaskProfile {
+  TaskProfiler *const profiler;
+  const TaskProfiler::Stage stage;
+
+public:
+  ScopeTaskProfile(TaskProfiler *_profiler, TaskProfiler::Stage _stage)
+    :profiler(_profiler), stage(_stage) {
+    if (profiler != nullptr)
+      profiler->Begin(stage);
+  }
+
+  ~ScopeTaskProfile() {
+    if (profiler != nullptr)
+      profiler->End(stage);
+  }
+
+  ScopeTaskProfile(const ScopeTaskProfile &) = delete;
+  ScopeTaskProfile &operator=(const ScopeTaskProfile &) = delete;
+};
+
+#endif
@@ -24,6 +24,8 @@
 #include "WaypointVisitor.hpp"
 #include "Util/StringUtil.hpp"
 
+#include <algorithm>
+
 // global, used for test harness
 unsigned n_queries = 0;
 
@@ -125,16 +127,20 @@ Waypoints::Waypoints()
 void
 Waypoints::Optimise()
 {
-  if (waypoint_tree.IsEmpty() || waypoint_tree.HaveBounds())
-    /* empty or already optimised */
+  if (waypoint_tree.IsEmpty())
     return;
 
-  task_projection.Update();
+  if (!waypoint_tree.HaveBounds()) {
+    task_projection.Update();
+
+    for (auto &i : waypoint_tree)
+      i.Project(task_projection);
 
-  for (auto &i : waypoint_tree)
-    i.Project(task_projection);
+    waypoint_tree.Optimise();
+  }
 
-  waypoint_tree.Optimise();
+  if (packed_index.IsEmpty())
+    packed_index.Build(waypoint_tree.begin(), waypoint_tree.end());
 }
 
 const Waypoint &
@@ -150,6 +156,8 @@ Waypoints::Append(Waypoint &&wp)
   } else if (IsEmpty())
     task_projection.Reset(wp.location);
 
+  packed_index.Clear();
+
   wp.flags.watched = (wp.file_num == 3);
 
   task_projection.Scan(wp.location);
@@ -163,6 +171,12 @@ Waypoints::Append(Waypoint &&wp)
   return new_wp;
 }
 
+static bool
+AlwaysTrue(const Waypoint &wp)
+{
+  return true;
+}
+
 const Waypoint *
 Waypoints::GetNearest(const GeoPoint &loc, fixed range) const
 {
@@ -172,12 +186,16 @@ Waypoints::GetNearest(const GeoPoint &loc, fixed range) const
   Waypoint bb_target(loc);
   bb_target.Project(task_projection);
   const unsigned mrange = task_projection.ProjectRangeInteger(loc, range);
-  const auto found = waypoint_tree.FindNearest(bb_target, mrange);
 
 #ifdef INSTRUMENT_TASK
   n_queries++;
 #endif
 
+  if (!packed_index.IsEmpty())
+    return packed_index.FindNearestIf(bb_target, mrange,
+                                      AlwaysTrue).first;
+
+  const auto found = waypoint_tree.FindNearest(bb_target, mrange);
   if (found.first == waypoint_tree.end())
     return nullptr;
 
@@ -206,18 +224,88 @@ Waypoints::GetNearestIf(const GeoPoint &loc, fixed range,
   Waypoint bb_target(loc);
   bb_target.Project(task_projection);
   const unsigned mrange = task_projection.ProjectRangeInteger(loc, range);
-  const auto found = waypoint_tree.FindNearestIf(bb_target, mrange, predicate);
 
 #ifdef INSTRUMENT_TASK
   n_queries++;
 #endif
 
+  if (!packed_index.IsEmpty())
+    return packed_index.FindNearestIf(bb_target, mrange,
+                                      predicate).first;
+
+  const auto found = waypoint_tree.FindNearestIf(bb_target, mrange, predicate);
   if (found.first == waypoint_tree.end())
     return nullptr;
 
   return &*found.first;
 }
 
+/**
+ * Collects the waypoints within range from the #QuadTree, for
+ * Waypoints::GetNearestIf() without a packed index.
+ */
+class NearestCollector {
+  const FlatGeoPoint location;
+  bool (*const predicate)(const Waypoint &);
+
+public:
+  std::vector<std::pair<unsigned, const Waypoint *>> found;
+
+  NearestCollector(const FlatGeoPoint &_location,
+                   bool (*_predicate)(const Waypoint &))
+    :location(_location), predicate(_predicate) {}
+
+  void operator()(const Waypoint &wp) {
+    if (predicate(wp))
+      found.push_back(std::make_pair(location.DistanceSquared(wp.flat_location),
+                                     &wp));
+  }
+};
+
+unsigned
+Waypoints::GetNearest(const GeoPoint &loc, fixed range,
+                      const Waypoint **dest, unsigned max) const
+{
+  return GetNearestIf(loc, range, AlwaysTrue, dest, max);
+}
+
+unsigned
+Waypoints::GetNearestIf(const GeoPoint &loc, fixed range,
+                        bool (*predicate)(const Waypoint &),
+                        const Waypoint **dest, unsigned max) const
+{
+  if (IsEmpty())
+    return 0;
+
+  Waypoint bb_target(loc);
+  bb_target.Project(task_projection);
+  const unsigned mrange = task_projection.ProjectRangeInteger(loc, range);
+
+#ifdef INSTRUMENT_TASK
+  n_queries++;
+#endif
+
+  if (!packed_index.IsEmpty())
+    return packed_index.FindNearestIf(bb_target, mrange,
+                                      dest, nullptr, max, predicate);
+
+  NearestCollector collector(bb_target.flat_location, predicate);
+  waypoint_tree.VisitWithinRange(bb_target, mrange, collector);
+
+  const unsigned n = std::min<unsigned>(max, collector.found.size());
+  std::partial_sort(collector.found.begin(), collector.found.begin() + n,
+                    collector.found.end(),
+                    [](const std::pair<unsigned, const Waypoint *> &a,
+                       const std::pair<unsigned, const Waypoint *> &b) {
+                      return a.first < b.first;
+                    });
+
+  for (unsigned i = 0; i < n; ++i)
+    dest[i] = collector.found[i].second;
+
+  return n;
+}
+
 const Waypoint *
 Waypoints::LookupName(const TCHAR *name) const
 {
@@ -287,7 +375,10 @@ Waypoints::VisitWithinRange(const GeoPoint &loc, const fixed range,
 
   WaypointEnvelopeVisitor wve(&visitor);
 
-  waypoint_tree.VisitWithinRange(bb_target, mrange, wve);
+  if (!packed_index.IsEmpty())
+    packed_index.VisitWithinRange(bb_target, mrange, wve);
+  else
+    waypoint_tree.VisitWithinRange(bb_target, mrange, wve);
 
 #ifdef INSTRUMENT_TASK
   n_queries++;
@@ -307,6 +398,7 @@ Waypoints::Clear()
   ++serial;
   home = nullptr;
   name_tree.Clear();
+  packed_index.Clear();
   waypoint_tree.clear();
   next_id = 1;
 }
@@ -321,6 +413,7 @@ Waypoints::Erase(const Waypoint& wp)
   assert(it != waypoint_tree.end());
 
   name_tree.Remove(wp);
+  packed_index.Clear();
   waypoint_tree.erase(it);
   ++serial;
 }
@@ -346,6 +439,7 @@ Waypoints::Replace(const Waypoint &orig, const Waypoint &replacement)
 
   const auto it = waypoint_tree.FindPointer(&orig);
   assert(it != waypoint_tree.end());
+  packed_index.Clear();
   waypoint_tree.Replace(it, new_waypoint);
 
   name_tree.Add(orig);
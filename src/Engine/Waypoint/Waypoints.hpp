@@ -25,6 +25,7 @@
 #include "Util/SliceAllocator.hpp"
 #include "Util/RadixTree.hpp"
 #include "Util/QuadTree.hpp"
+#include "Util/PackedRTree.hpp"
 #include "Util/Serial.hpp"
 #include "Waypoint.hpp"
 #include "Geo/Flat/TaskProjection.hpp"
@@ -58,6 +59,11 @@ class Waypoints {
   typedef QuadTree<Waypoint, WaypointAccessor,
                    SliceAllocator<Waypoint, 512u> > WaypointTree;
 
+  /**
+   * Type of the read-only spatial index built by Optimise()
+   */
+  typedef PackedRTree<Waypoint, WaypointAccessor> WaypointIndex;
+
   class WaypointNameTree : public RadixTree<const Waypoint *> {
   public:
     const Waypoint *Get(const TCHAR *name) const;
@@ -76,6 +82,14 @@ class Waypoints {
   unsigned next_id;
 
   WaypointTree waypoint_tree;
+
+  /**
+   * A packed copy of #waypoint_tree, built by Optimise() and cleared
+   * by all modifications.  Location lookups use it when it is
+   * available, and fall back to #waypoint_tree otherwise.
+   */
+  WaypointIndex packed_index;
+
   WaypointNameTree name_tree;
   TaskProjection task_projection;
 
@@ -327,6 +341,30 @@ public:
   const Waypoint *GetNearestIf(const GeoPoint &loc, fixed range,
                                bool (*predicate)(const Waypoint &)) const;
 
+  /**
+   * Looks up the nearest waypoints to the search location, sorted by
+   * increasing distance.  Performs search according to flat-earth
+   * internal representation, so is approximate.
+   *
+   * @param loc Location from which to search
+   * @param dest An array which receives up to #max waypoints
+   * @param max The maximum number of waypoints to return
+   *
+   * @return The number of waypoints written to #dest
+   */
+  unsigned GetNearest(const GeoPoint &loc, fixed range,
+                      const Waypoint **dest, unsigned max) const;
+
+  /**
+   * Looks up the nearest waypoints to the search location which
+   * match the predicate, sorted by increasing distance.
+   *
+   * @see GetNearest()
+   */
+  unsigned GetNearestIf(const GeoPoint &loc, fixed range,
+                        bool (*predicate)(const Waypoint &),
+                        const Waypoint **dest, unsigned max) const;
+
   /**
    * Access first waypoint in store, for use in iterators.
    *
@@ -26,34 +26,54 @@ Copyright_License {
 #include "NMEA/Info.hpp"
 #include "Geo/GeoVector.hpp"
 
-void
-FlarmComputer::Process(FlarmData &flarm, const FlarmData &last_flarm,
-                       const NMEAInfo &basic)
+#include <algorithm>
+
+FlarmComputer::FlarmComputer()
+  :n_computed(0), n_reused(0)
 {
-  // Cleanup old calculation instances
-  if (basic.time_available)
-    flarm_calculations.CleanUp(basic.time);
+  reference.available = false;
+}
 
-  // if (FLARM data is available)
-  if (!flarm.IsDetected())
-    return;
+bool
+FlarmComputer::Reference::Update(const NMEAInfo &basic)
+{
+  const bool new_time_available = basic.time_available;
+  const bool new_location_available = basic.location_available;
+  const bool new_altitude_available = basic.gps_altitude_available;
+
+  if (available &&
+      new_time_available == time_available &&
+      (!time_available || basic.time == time) &&
+      new_location_available == location_available &&
+      (!location_available || basic.location == location) &&
+      new_altitude_available == altitude_available &&
+      (!altitude_available || basic.gps_altitude == altitude))
+    return true;
 
-  fixed north_to_latitude(0);
-  fixed east_to_longitude(0);
+  available = true;
+  time_available = new_time_available;
+  time = basic.time;
+  location_available = new_location_available;
+  location = basic.location;
+  altitude_available = new_altitude_available;
+  altitude = basic.gps_altitude;
 
-  if (basic.location_available) {
+  north_to_latitude = fixed(0);
+  east_to_longitude = fixed(0);
+
+  if (location_available) {
     // Precalculate relative east and north projection to lat/lon
     // for Location calculations of each target
     constexpr Angle delta_lat = Angle::Degrees(0.01);
     constexpr Angle delta_lon = Angle::Degrees(0.01);
 
-    GeoPoint plat = basic.location;
+    GeoPoint plat = location;
     plat.latitude += delta_lat;
-    GeoPoint plon = basic.location;
+    GeoPoint plon = location;
     plon.longitude += delta_lon;
 
-    fixed dlat = basic.location.Distance(plat);
-    fixed dlon = basic.location.Distance(plon);
+    fixed dlat = location.Distance(plat);
+    fixed dlon = location.Distance(plon);
 
     if (positive(fabs(dlat)) && positive(fabs(dlon))) {
       north_to_latitude = delta_lat.Degrees() / dlat;
@@ -61,99 +81,176 @@ FlarmComputer::Process(FlarmData &flarm, const FlarmData &last_flarm,
     }
   }
 
-  // for each item in traffic
-  for (auto &traffic : flarm.traffic.list) {
-    // if we don't know the target's name yet
-    if (!traffic.HasName()) {
-      // lookup the name of this target's id
-      const TCHAR *fname = FlarmDetails::LookupCallsign(traffic.id);
-      if (fname != NULL)
-        traffic.name = fname;
-    }
+  return false;
+}
 
-    // Calculate distance
-    traffic.distance = SmallHypot(traffic.relative_north,
-                                  traffic.relative_east);
+/**
+ * Was the raw (received) data of the two targets the same?  The
+ * #Validity is updated with each received sentence; the relative
+ * position is compared as well, in case two sentences were received
+ * with the same clock value.
+ */
+gcc_pure
+static bool
+IsSameRawTraffic(const FlarmTraffic &a, const FlarmTraffic &b)
+{
+  return a.id == b.id && a.valid == b.valid &&
+    a.relative_north == b.relative_north &&
+    a.relative_east == b.relative_east &&
+    a.relative_altitude == b.relative_altitude;
+}
 
-    // Calculate Location
-    traffic.location_available = basic.location_available;
-    if (traffic.location_available) {
-      traffic.location.latitude =
-          Angle::Degrees(traffic.relative_north * north_to_latitude) +
-          basic.location.latitude;
+const FlarmTraffic *
+FlarmComputer::FindProcessed(const FlarmTraffic &traffic,
+                             unsigned index) const
+{
+  if (index < processed.size() && processed[index].id == traffic.id)
+    return IsSameRawTraffic(processed[index], traffic)
+      ? &processed[index]
+      : nullptr;
 
-      traffic.location.longitude =
-          Angle::Degrees(traffic.relative_east * east_to_longitude) +
-          basic.location.longitude;
-    }
+  for (const auto &i : processed)
+    if (i.id == traffic.id)
+      return IsSameRawTraffic(i, traffic) ? &i : nullptr;
 
-    // Calculate absolute altitude
-    traffic.altitude_available = basic.gps_altitude_available;
-    if (traffic.altitude_available)
-      traffic.altitude = traffic.relative_altitude + RoughAltitude(basic.gps_altitude);
-
-    // Calculate average climb rate
-    traffic.climb_rate_avg30s_available = traffic.altitude_available;
-    if (traffic.climb_rate_avg30s_available)
-      traffic.climb_rate_avg30s =
-        flarm_calculations.Average30s(traffic.id, basic.time, traffic.altitude);
-
-    // The following calculations are only relevant for targets
-    // where information is missing
-    if (traffic.track_received && traffic.turn_rate_received &&
-        traffic.speed_received && traffic.climb_rate_received)
-      continue;
-
-    // Check if the target has been seen before in the last seconds
-    const FlarmTraffic *last_traffic =
-      last_flarm.traffic.FindTraffic(traffic.id);
-    if (last_traffic == NULL || !last_traffic->valid)
-      continue;
-
-    // Calculate the time difference between now and the last contact
-    fixed dt = traffic.valid.GetTimeDifference(last_traffic->valid);
-    if (positive(dt)) {
-      // Calculate the immediate climb rate
-      if (!traffic.climb_rate_received)
-        traffic.climb_rate =
-          (traffic.relative_altitude - last_traffic->relative_altitude) / dt;
+  return nullptr;
+}
+
+void
+FlarmComputer::Process(FlarmData &flarm, const FlarmData &last_flarm,
+                       const NMEAInfo &basic)
+{
+  // Cleanup old calculation instances
+  if (basic.time_available)
+    flarm_calculations.CleanUp(basic.time);
+
+  // if (FLARM data is available)
+  if (!flarm.IsDetected()) {
+    processed.clear();
+    return;
+  }
+
+  /* if the own position has not changed, the targets which have not
+     been updated can be copied from the previous call */
+  const bool reuse = reference.Update(basic);
+
+  auto &list = flarm.traffic.list;
+  for (unsigned i = 0, n = list.size(); i < n; ++i) {
+    FlarmTraffic &traffic = list[i];
+
+    const FlarmTraffic *previous = reuse
+      ? FindProcessed(traffic, i)
+      : nullptr;
+    if (previous != nullptr) {
+      traffic = *previous;
+      ++n_reused;
     } else {
-      // Since the time difference is zero (or negative)
-      // we can just copy the old values
-      if (!traffic.climb_rate_received)
-        traffic.climb_rate = last_traffic->climb_rate;
+      ProcessTraffic(traffic, last_flarm, basic);
+      ++n_computed;
     }
+  }
 
-    if (positive(dt) &&
-        traffic.location_available &&
-        last_traffic->location_available) {
-      // Calculate the GeoVector between now and the last contact
-      GeoVector vec = last_traffic->location.DistanceBearing(traffic.location);
-
-      if (!traffic.track_received)
-        traffic.track = vec.bearing;
-
-      // Calculate the turn rate
-      if (!traffic.turn_rate_received) {
-        Angle turn_rate = traffic.track - last_traffic->track;
-        traffic.turn_rate =
-          turn_rate.AsDelta().Degrees() / dt;
-      }
-
-      // Calculate the speed [m/s]
-      if (!traffic.speed_received)
-        traffic.speed = vec.distance / dt;
-    } else {
-      // Since the time difference is zero (or negative)
-      // we can just copy the old values
-      if (!traffic.track_received)
-        traffic.track = last_traffic->track;
+  processed.resize(list.size());
+  std::copy(list.begin(), list.end(), processed.begin());
 
-      if (!traffic.turn_rate_received)
-        traffic.turn_rate = last_traffic->turn_rate;
+  flarm.traffic.UpdateGrid();
+}
 
-      if (!traffic.speed_received)
-        traffic.speed = last_traffic->speed;
+void
+FlarmComputer::ProcessTraffic(FlarmTraffic &traffic,
+                              const FlarmData &last_flarm,
+                              const NMEAInfo &basic)
+{
+  // if we don't know the target's name yet
+  if (!traffic.HasName()) {
+    // lookup the name of this target's id
+    const TCHAR *fname = FlarmDetails::LookupCallsign(traffic.id);
+    if (fname != NULL)
+      traffic.name = fname;
+  }
+
+  // Calculate distance
+  traffic.distance = SmallHypot(traffic.relative_north,
+                                traffic.relative_east);
+
+  // Calculate Location
+  traffic.location_available = basic.location_available;
+  if (traffic.location_available) {
+    traffic.location.latitude =
+        Angle::Degrees(traffic.relative_north * reference.north_to_latitude) +
+        basic.location.latitude;
+
+    traffic.location.longitude =
+        Angle::Degrees(traffic.relative_east * reference.east_to_longitude) +
+        basic.location.longitude;
+  }
+
+  // Calculate absolute altitude
+  traffic.altitude_available = basic.gps_altitude_available;
+  if (traffic.altitude_available)
+    traffic.altitude = traffic.relative_altitude + RoughAltitude(basic.gps_altitude);
+
+  // Calculate average climb rate
+  traffic.climb_rate_avg30s_available = traffic.altitude_available;
+  if (traffic.climb_rate_avg30s_available)
+    traffic.climb_rate_avg30s =
+      flarm_calculations.Average30s(traffic.id, basic.time, traffic.altitude);
+
+  // The following calculations are only relevant for targets
+  // where information is missing
+  if (traffic.track_received && traffic.turn_rate_received &&
+      traffic.speed_received && traffic.climb_rate_received)
+    return;
+
+  // Check if the target has been seen before in the last seconds
+  const FlarmTraffic *last_traffic =
+    last_flarm.traffic.FindTraffic(traffic.id);
+  if (last_traffic == NULL || !last_traffic->valid)
+    return;
+
+  // Calculate the time difference between now and the last contact
+  fixed dt = traffic.valid.GetTimeDifference(last_traffic->valid);
+  if (positive(dt)) {
+    // Calculate the immediate climb rate
+    if (!traffic.climb_rate_received)
+      traffic.climb_rate =
+        (traffic.relative_altitude - last_traffic->relative_altitude) / dt;
+  } else {
+    // Since the time difference is zero (or negative)
+    // we can just copy the old values
+    if (!traffic.climb_rate_received)
+      traffic.climb_rate = last_traffic->climb_rate;
+  }
+
+  if (positive(dt) &&
+      traffic.location_available &&
+      last_traffic->location_available) {
+    // Calculate the GeoVector between now and the last contact
+    GeoVector vec = last_traffic->location.DistanceBearing(traffic.location);
+
+    if (!traffic.track_received)
+      traffic.track = vec.bearing;
+
+    // Calculate the turn rate
+    if (!traffic.turn_rate_received) {
+      Angle turn_rate = traffic.track - last_traffic->track;
+      traffic.turn_rate =
+        turn_rate.AsDelta().Degrees() / dt;
     }
+
+    // Calculate the speed [m/s]
+    if (!traffic.speed_received)
+      traffic.speed = vec.distance / dt;
+  } else {
+    // Since the time difference is zero (or negative)
+    // we can just copy the old values
+    if (!traffic.track_received)
+      traffic.track = last_traffic->track;
+
+    if (!traffic.turn_rate_received)
+      traffic.turn_rate = last_traffic->turn_rate;
+
+    if (!traffic.speed_received)
+      traffic.speed = last_traffic->speed;
   }
 }
@@ -25,6 +25,9 @@ Copyright_License {
 #define XCSOAR_FLARM_COMPUTER_HPP
 
 #include "FLARM/FlarmCalculations.hpp"
+#include "FLARM/List.hpp"
+#include "Geo/GeoPoint.hpp"
+#include "Util/TrivialArray.hpp"
 
 struct FlarmData;
 struct NMEAInfo;
@@ -32,13 +35,89 @@ struct NMEAInfo;
 class FlarmComputer {
   FlarmCalculations flarm_calculations;
 
+  /**
+   * The own position which was used by the previous Process() call.
+   * While it does not change, a target which has not been updated
+   * since then can be copied from #processed.
+   */
+  struct Reference {
+    bool available;
+
+    bool time_available, location_available, altitude_available;
+
+    fixed time;
+
+    GeoPoint location;
+
+    fixed altitude;
+
+    /**
+     * Factors for converting the relative position of a target to
+     * latitude/longitude (degrees per metre).
+     */
+    fixed north_to_latitude, east_to_longitude;
+
+    /**
+     * Update from the given #NMEAInfo object.
+     *
+     * @return true if nothing has changed
+     */
+    bool Update(const NMEAInfo &basic);
+  } reference;
+
+  /**
+   * The targets as calculated by the previous Process() call.
+   */
+  TrivialArray<FlarmTraffic, TrafficList::MAX_COUNT> processed;
+
+  /**
+   * Statistics: the number of targets which were calculated and
+   * which were copied from #processed.
+   */
+  unsigned n_computed, n_reused;
+
 public:
+  FlarmComputer();
+
   /**
    * Calculates location, altitude, average climb speed and
-   * looks up the callsign of each target
+   * looks up the callsign of each target.  Only targets which have
+   * been updated (or all of them after a new GPS fix) are
+   * recalculated.
    */
   void Process(FlarmData &flarm, const FlarmData &last_flarm,
                const NMEAInfo &basic);
+
+  /**
+   * Forget the own position of the previous Process() call, so the
+   * next call recalculates all targets.
+   */
+  void Invalidate() {
+    reference.available = false;
+  }
+
+  unsigned GetComputedCount() const {
+    return n_computed;
+  }
+
+  unsigned GetReusedCount() const {
+    return n_reused;
+  }
+
+private:
+  /**
+   * Find the result of the previous Process() call for the given
+   * target, if it has not been updated since then.
+   *
+   * @param index the index of the target in the current list; this
+   * is checked first, because the order rarely changes
+   */
+  gcc_pure
+  const FlarmTraffic *FindProcessed(const FlarmTraffic &traffic,
+                                    unsigned index) const;
+
+  void ProcessTraffic(FlarmTraffic &traffic, const FlarmData &last_flarm,
+                      const NMEAInfo &basic);
 };
 
 #endif
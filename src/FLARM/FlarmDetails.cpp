@@ -74,3 +74,14 @@ FlarmDetails::FindIdsByCallSign(const TCHAR *cn, FlarmId array[],
 
   return traffic_databases->FindIdsByName(cn, array, size);
 }
+
+unsigned
+FlarmDetails::FindIdsByCallSignPrefix(const TCHAR *prefix, FlarmId array[],
+                                      unsigned size)
+{
+  assert(prefix != NULL);
+  assert(!StringIsEmpty(prefix));
+  assert(traffic_databases != nullptr);
+
+  return traffic_databases->FindIdsByNamePrefix(prefix, array, size);
+}
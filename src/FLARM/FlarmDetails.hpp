@@ -69,6 +69,14 @@ namespace FlarmDetails
 
   unsigned
   FindIdsByCallSign(const TCHAR *cn, FlarmId array[], unsigned size);
+
+  /**
+   * Finds the FLARM ids of all callsigns starting with the given
+   * string.
+   */
+  unsigned
+  FindIdsByCallSignPrefix(const TCHAR *prefix, FlarmId array[],
+                          unsigned size);
 }
 
 #endif
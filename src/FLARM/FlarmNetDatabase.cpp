@@ -22,33 +22,221 @@ Copyright_License {
 */
 
 #include "FlarmNetDatabase.hpp"
+#include "IO/FileCache.hpp"
+#include "OS/FileMapping.hpp"
 #include "Util/StringUtil.hpp"
 
+#include <algorithm>
+#include <numeric>
+
 #include <assert.h>
+#include <stdio.h>
+#include <string.h>
+
+struct FlarmNetImageHeader {
+  static constexpr uint32_t VERSION = 0x464c4e01;
+
+  uint32_t version;
+
+  /**
+   * sizeof(TCHAR) of the build which generated the image.
+   */
+  uint32_t tchar_size;
+
+  /**
+   * The number of #FlarmNetRecord objects following the header; the
+   * same number of callsign index entries follows them.
+   */
+  uint32_t n_records;
+
+  /**
+   * The number of TCHARs in the string pool at the end of the image.
+   */
+  uint32_t pool_size;
+};
+
+/**
+ * The position of the callsign in FlarmNetRecord::GetStrings().
+ */
+static constexpr unsigned CALLSIGN_STRING = 5;
+
+FlarmNetDatabase::FlarmNetDatabase()
+  :mapping(nullptr), image(nullptr), image_size(0),
+   records(nullptr), n_records(0), callsign_index(nullptr)
+{
+  static_assert(offsetof(FlarmNetRecord, callsign) ==
+                offsetof(FlarmNetRecord, id) +
+                CALLSIGN_STRING * sizeof(FlarmNetString),
+                "wrong CALLSIGN_STRING");
+}
+
+FlarmNetDatabase::~FlarmNetDatabase()
+{
+  delete mapping;
+}
 
 void
-FlarmNetDatabase::Insert(const FlarmNetRecord &record)
+FlarmNetDatabase::Clear()
 {
-  FlarmId id = record.GetId();
-  if (!id.IsDefined())
-    /* ignore malformed records */
-    return;
+  delete mapping;
+  mapping = nullptr;
+  buffer = AllocatedArray<uint32_t>();
 
-  map.insert(std::make_pair(id, record));
+  image = nullptr;
+  image_size = 0;
+  records = nullptr;
+  n_records = 0;
+  callsign_index = nullptr;
 }
 
-const FlarmNetRecord *
-FlarmNetDatabase::FindFirstRecordByCallSign(const TCHAR *cn) const
+bool
+FlarmNetDatabase::Open(const void *data, size_t size)
+{
+  const char *const base = (const char *)data;
+
+  if (size < sizeof(FlarmNetImageHeader) ||
+      (size_t)base % alignof(FlarmNetImageHeader) != 0)
+    return false;
+
+  const FlarmNetImageHeader &header = *(const FlarmNetImageHeader *)base;
+  if (header.version != FlarmNetImageHeader::VERSION ||
+      header.tchar_size != sizeof(TCHAR) ||
+      header.pool_size == 0)
+    return false;
+
+  const uint64_t n = header.n_records;
+  const uint64_t index_offset = sizeof(header) + n * sizeof(FlarmNetRecord);
+  const uint64_t pool_offset = index_offset + n * sizeof(uint32_t);
+  const uint64_t end = pool_offset + header.pool_size * uint64_t(sizeof(TCHAR));
+
+  /* the in-memory image is padded to a multiple of 4 bytes */
+  if (end > size || size - end >= sizeof(uint32_t))
+    return false;
+
+  const TCHAR *const pool = (const TCHAR *)(base + pool_offset);
+  if (pool[header.pool_size - 1] != _T('\0'))
+    /* the last string is not terminated */
+    return false;
+
+  const FlarmNetRecord *const _records =
+    (const FlarmNetRecord *)(base + sizeof(header));
+  for (unsigned i = 0; i < n; ++i) {
+    if (i > 0 && !(_records[i - 1].flarm_id < _records[i].flarm_id))
+      /* not sorted */
+      return false;
+
+    const FlarmNetString *strings = _records[i].GetStrings();
+    for (unsigned j = 0; j < FlarmNetRecord::N_STRINGS; ++j) {
+      const uint64_t position = ((const char *)&strings[j] - base) +
+        uint64_t(strings[j].GetOffset());
+      if (position < pool_offset || position >= end ||
+          (position - pool_offset) % sizeof(TCHAR) != 0)
+        return false;
+    }
+  }
+
+  const uint32_t *const index = (const uint32_t *)(base + index_offset);
+  for (unsigned i = 0; i < n; ++i)
+    if (index[i] >= n)
+      return false;
+
+  image = data;
+  image_size = end;
+  records = _records;
+  n_records = n;
+  callsign_index = index;
+  return true;
+}
+
+bool
+FlarmNetDatabase::SetImage(AllocatedArray<uint32_t> &&_image)
+{
+  AllocatedArray<uint32_t> tmp(std::move(_image));
+  if (!Open(tmp.begin(), tmp.size() * sizeof(*tmp.begin()))) {
+    Clear();
+    return false;
+  }
+
+  delete mapping;
+  mapping = nullptr;
+
+  /* this moves the buffer pointer, the records stay where they are */
+  buffer = std::move(tmp);
+  return true;
+}
+
+bool
+FlarmNetDatabase::LoadCache(FileCache &cache, const TCHAR *name,
+                            const TCHAR *original_path)
+{
+  size_t offset;
+  FileMapping *new_mapping = cache.Map(name, original_path, offset);
+  if (new_mapping == nullptr)
+    return false;
+
+  if (!Open(new_mapping->at(offset), new_mapping->size() - offset)) {
+    delete new_mapping;
+    cache.Flush(name);
+    return false;
+  }
+
+  delete mapping;
+  mapping = new_mapping;
+  buffer = AllocatedArray<uint32_t>();
+  return true;
+}
+
+bool
+FlarmNetDatabase::SaveCache(FileCache &cache, const TCHAR *name,
+                            const TCHAR *original_path) const
 {
-  for (const auto &i : map) {
-    assert(i.first.IsDefined());
+  if (image == nullptr)
+    return false;
 
-    const FlarmNetRecord &record = i.second;
-    if (StringIsEqual(record.callsign, cn))
-      return &record;
+  FILE *file = cache.Save(name, original_path);
+  if (file == nullptr)
+    return false;
+
+  if (fwrite(image, 1, image_size, file) != image_size) {
+    cache.Cancel(name, file);
+    return false;
   }
 
-  return NULL;
+  return cache.Commit(name, file);
+}
+
+const FlarmNetRecord *
+FlarmNetDatabase::FindRecordById(FlarmId id) const
+{
+  auto i = std::lower_bound(begin(), end(), id,
+                            [](const FlarmNetRecord &record, FlarmId id) {
+                              return record.flarm_id < id;
+                            });
+  return i != end() && i->flarm_id == id
+    ? i
+    : nullptr;
+}
+
+const uint32_t *
+FlarmNetDatabase::LowerBoundCallSign(const TCHAR *cn) const
+{
+  return std::lower_bound(callsign_index, callsign_index + n_records, cn,
+                          [this](uint32_t i, const TCHAR *cn) {
+                            return _tcscmp(records[i].callsign, cn) < 0;
+                          });
+}
+
+const FlarmNetRecord *
+FlarmNetDatabase::FindFirstRecordByCallSign(const TCHAR *cn) const
+{
+  const uint32_t *i = LowerBoundCallSign(cn);
+  if (i == callsign_index + n_records)
+    return nullptr;
+
+  const FlarmNetRecord &record = records[*i];
+  return StringIsEqual(record.callsign, cn)
+    ? &record
+    : nullptr;
 }
 
 unsigned
@@ -58,13 +246,11 @@ FlarmNetDatabase::FindRecordsByCallSign(const TCHAR *cn,
 {
   unsigned count = 0;
 
-  for (const auto &i : map) {
-    assert(i.first.IsDefined());
-
-    const FlarmNetRecord &record = i.second;
-    if (StringIsEqual(record.callsign, cn))
-      array[count++] = &record;
-  }
+  for (const uint32_t *i = LowerBoundCallSign(cn),
+         *end = callsign_index + n_records;
+       i != end && count < size && StringIsEqual(records[*i].callsign, cn);
+       ++i)
+    array[count++] = &records[*i];
 
   return count;
 }
@@ -75,13 +261,144 @@ FlarmNetDatabase::FindIdsByCallSign(const TCHAR *cn, FlarmId array[],
 {
   unsigned count = 0;
 
-  for (const auto &i : map) {
-    assert(i.first.IsDefined());
+  for (const uint32_t *i = LowerBoundCallSign(cn),
+         *end = callsign_index + n_records;
+       i != end && count < size && StringIsEqual(records[*i].callsign, cn);
+       ++i)
+    array[count++] = records[*i].GetId();
 
-    const FlarmNetRecord &record = i.second;
-    if (StringIsEqual(record.callsign, cn))
-      array[count++] = i.first;
-  }
+  return count;
+}
+
+unsigned
+FlarmNetDatabase::FindIdsByCallSignPrefix(const TCHAR *prefix,
+                                          FlarmId array[],
+                                          unsigned size) const
+{
+  unsigned count = 0;
+
+  for (const uint32_t *i = LowerBoundCallSign(prefix),
+         *end = callsign_index + n_records;
+       i != end && count < size &&
+         StringStartsWith(records[*i].callsign, prefix);
+       ++i)
+    array[count++] = records[*i].GetId();
 
   return count;
 }
+
+size_t
+FlarmNetDatabaseBuilder::PoolHash::operator()(uint32_t position) const
+{
+  /* FNV-1a */
+  uint32_t hash = 2166136261u;
+  for (const TCHAR *p = pool.c_str() + position; *p != _T('\0'); ++p)
+    hash = (hash ^ (unsigned)*p) * 16777619u;
+  return hash;
+}
+
+bool
+FlarmNetDatabaseBuilder::PoolEqual::operator()(uint32_t a, uint32_t b) const
+{
+  return StringIsEqual(pool.c_str() + a, pool.c_str() + b);
+}
+
+FlarmNetDatabaseBuilder::FlarmNetDatabaseBuilder()
+  :positions(1024, PoolHash{pool}, PoolEqual{pool})
+{
+  /* make sure the pool is never empty */
+  AddString(_T(""));
+}
+
+uint32_t
+FlarmNetDatabaseBuilder::AddString(const TCHAR *value)
+{
+  /* append the string tentatively, so the set can look it up */
+  const uint32_t position = pool.length();
+  pool.append(value);
+  pool.push_back(_T('\0'));
+
+  auto i = positions.insert(position);
+  if (!i.second)
+    /* it's a duplicate: remove the new copy */
+    pool.resize(position);
+
+  return *i.first;
+}
+
+void
+FlarmNetDatabaseBuilder::Add(FlarmId id,
+                             const TCHAR *const strings[FlarmNetRecord::N_STRINGS])
+{
+  if (!id.IsDefined())
+    /* ignore malformed records */
+    return;
+
+  Record record;
+  record.id = id;
+  for (unsigned i = 0; i < FlarmNetRecord::N_STRINGS; ++i)
+    record.strings[i] = AddString(strings[i]);
+
+  records.push_back(record);
+}
+
+bool
+FlarmNetDatabaseBuilder::Finish(FlarmNetDatabase &database)
+{
+  /* sort by id; of duplicate ids, the first record wins */
+  std::stable_sort(records.begin(), records.end(),
+                   [](const Record &a, const Record &b) {
+                     return a.id < b.id;
+                   });
+  records.erase(std::unique(records.begin(), records.end(),
+                            [](const Record &a, const Record &b) {
+                              return a.id == b.id;
+                            }),
+                records.end());
+
+  const unsigned n = records.size();
+  const size_t records_offset = sizeof(FlarmNetImageHeader);
+  const size_t index_offset = records_offset + n * sizeof(FlarmNetRecord);
+  const size_t pool_offset = index_offset + n * sizeof(uint32_t);
+  const size_t size = pool_offset + pool.length() * sizeof(TCHAR);
+
+  AllocatedArray<uint32_t> image((size + sizeof(uint32_t) - 1)
+                                 / sizeof(uint32_t));
+  char *const base = (char *)image.begin();
+  memset(base, 0, image.size() * sizeof(*image.begin()));
+
+  FlarmNetImageHeader &header = *(FlarmNetImageHeader *)base;
+  header.version = FlarmNetImageHeader::VERSION;
+  header.tchar_size = sizeof(TCHAR);
+  header.n_records = n;
+  header.pool_size = pool.length();
+
+  FlarmNetRecord *const dest = (FlarmNetRecord *)(base + records_offset);
+  for (unsigned i = 0; i < n; ++i) {
+    dest[i].flarm_id = records[i].id;
+
+    FlarmNetString *strings = dest[i].GetStrings();
+    for (unsigned j = 0; j < FlarmNetRecord::N_STRINGS; ++j) {
+      const size_t field = (char *)&strings[j] - base;
+      const size_t value = pool_offset + records[i].strings[j] * sizeof(TCHAR);
+      strings[j].SetOffset(value - field);
+    }
+  }
+
+  uint32_t *const index = (uint32_t *)(base + index_offset);
+  std::iota(index, index + n, 0u);
+  const TCHAR *const p = pool.c_str();
+  std::stable_sort(index, index + n, [this, p](uint32_t a, uint32_t b) {
+      return _tcscmp(p + records[a].strings[CALLSIGN_STRING],
+                     p + records[b].strings[CALLSIGN_STRING]) < 0;
+    });
+
+  memcpy(base + pool_offset, pool.data(), pool.length() * sizeof(TCHAR));
+
+  records.clear();
+  pool.clear();
+  positions.clear();
+  AddString(_T(""));
+
+  return database.SetImage(std::move(image));
+}
@@ -26,28 +26,93 @@ Copyright_License {
 
 #include "FlarmId.hpp"
 #include "FlarmNetRecord.hpp"
+#include "Util/AllocatedArray.hpp"
+#include "Util/NonCopyable.hpp"
+#include "Util/tstring.hpp"
 #include "Compiler.h"
 
-#include <map>
+#include <unordered_set>
+#include <vector>
+
+#include <stddef.h>
+#include <stdint.h>
 #include <tchar.h>
 
+class FileCache;
+class FileMapping;
+
 /**
- * An in-memory representation of the FlarmNet.org database.
+ * A read-only representation of the FlarmNet.org database.
+ *
+ * The records are stored in a compact, position independent image
+ * (see #FlarmNetDatabaseBuilder): a header, the #FlarmNetRecord
+ * array sorted by FLARM id, an index of the records sorted by
+ * callsign and a pool of null-terminated strings.  The image is
+ * either built in memory from the data.fln file or memory-mapped
+ * from the #FileCache, which avoids parsing the file and keeps the
+ * records out of the heap.
  */
-class FlarmNetDatabase {
-  typedef std::map<FlarmId, FlarmNetRecord> RecordMap;
-  RecordMap map;
+class FlarmNetDatabase : private NonCopyable {
+  /**
+   * The cache file containing the image, if it was loaded by
+   * LoadCache().
+   */
+  FileMapping *mapping;
+
+  /**
+   * The image, if it was built in memory.
+   */
+  AllocatedArray<uint32_t> buffer;
+
+  const void *image;
+  size_t image_size;
+
+  const FlarmNetRecord *records;
+  unsigned n_records;
+
+  /**
+   * Record indices, sorted by callsign.
+   */
+  const uint32_t *callsign_index;
 
 public:
+  FlarmNetDatabase();
+  ~FlarmNetDatabase();
+
   bool IsEmpty() const {
-    return map.empty();
+    return n_records == 0;
   }
 
-  void Clear() {
-    map.clear();
+  unsigned GetSize() const {
+    return n_records;
   }
 
-  void Insert(const FlarmNetRecord &record);
+  void Clear();
+
+  /**
+   * Use an image generated by #FlarmNetDatabaseBuilder.
+   *
+   * @return false if the image is malformed (the database is empty
+   * then)
+   */
+  bool SetImage(AllocatedArray<uint32_t> &&image);
+
+  /**
+   * Map the image from the #FileCache.
+   *
+   * @param original_path the path of the data.fln file; the cache is
+   * discarded if that file has been modified
+   * @return false if there is no valid cache (the database is
+   * unmodified then)
+   */
+  bool LoadCache(FileCache &cache, const TCHAR *name,
+                 const TCHAR *original_path);
+
+  /**
+   * Store the image in the #FileCache.
+   */
+  bool SaveCache(FileCache &cache, const TCHAR *name,
+                 const TCHAR *original_path) const;
 
   /**
    * Finds a FLARMNetRecord object based on the given FLARM id
@@ -55,12 +120,7 @@ public:
    * @return FLARMNetRecord object
    */
   gcc_pure
-  const FlarmNetRecord *FindRecordById(FlarmId id) const {
-    auto i = map.find(id);
-    return i != map.end()
-      ? &i->second
-      : NULL;
-  }
+  const FlarmNetRecord *FindRecordById(FlarmId id) const;
 
   /**
    * Finds a FLARMNetRecord object based on the given Callsign
@@ -76,13 +136,97 @@ public:
   unsigned FindIdsByCallSign(const TCHAR *cn, FlarmId array[],
                              unsigned size) const;
 
-  RecordMap::const_iterator begin() const {
-    return map.begin();
+  /**
+   * Finds the ids of all records whose callsign starts with the
+   * given string, ordered by callsign.
+   */
+  unsigned FindIdsByCallSignPrefix(const TCHAR *prefix, FlarmId array[],
+                                   unsigned size) const;
+
+  const FlarmNetRecord *begin() const {
+    return records;
   }
 
-  RecordMap::const_iterator end() const {
-    return map.end();
+  const FlarmNetRecord *end() const {
+    return records + n_records;
   }
+
+private:
+  /**
+   * Check the image and set up the pointers into it.
+   */
+  bool Open(const void *data, size_t size);
+
+  /**
+   * Returns the position of the first callsign index entry which is
+   * not less than the given string.
+   */
+  gcc_pure
+  const uint32_t *LowerBoundCallSign(const TCHAR *cn) const;
+};
+
+/**
+ * Generates an image for #FlarmNetDatabase from the records of a
+ * data.fln file.
+ */
+class FlarmNetDatabaseBuilder : private NonCopyable {
+  struct Record {
+    FlarmId id;
+
+    /**
+     * Positions of the strings in #pool (in characters).
+     */
+    uint32_t strings[FlarmNetRecord::N_STRINGS];
+  };
+
+  std::vector<Record> records;
+
+  tstring pool;
+
+  /**
+   * Hashes the string at the given position of the #pool.
+   */
+  struct PoolHash {
+    const tstring &pool;
+
+    gcc_pure
+    size_t operator()(uint32_t position) const;
+  };
+
+  struct PoolEqual {
+    const tstring &pool;
+
+    gcc_pure
+    bool operator()(uint32_t a, uint32_t b) const;
+  };
+
+  /**
+   * The positions of all strings in the #pool, for deduplication;
+   * many airfields and aircraft types occur very often.  The set
+   * refers to the #pool instead of copying the strings.
+   */
+  std::unordered_set<uint32_t, PoolHash, PoolEqual> positions;
+
+public:
+  FlarmNetDatabaseBuilder();
+
+  /**
+   * Add a record.  Records with an undefined id are ignored; if an
+   * id occurs more than once, the first record wins.
+   *
+   * @param strings the strings in the order of
+   * FlarmNetRecord::GetStrings()
+   */
+  void Add(FlarmId id, const TCHAR *const strings[FlarmNetRecord::N_STRINGS]);
+
+  /**
+   * Generate the image and pass it to the database (replacing its
+   * contents).  This object is empty afterwards.
+   */
+  bool Finish(FlarmNetDatabase &database);
+
+private:
+  uint32_t AddString(const TCHAR *value);
 };
 
 #endif
@@ -24,7 +24,9 @@ Copyright_License {
 #include "FlarmNetReader.hpp"
 #include "FlarmNetRecord.hpp"
 #include "FlarmNetDatabase.hpp"
+#include "FlarmId.hpp"
 #include "Util/StringUtil.hpp"
+#include "Util/StaticString.hpp"
 #include "Util/CharUtil.hpp"
 #include "IO/LineReader.hpp"
 #include "IO/FileLineReader.hpp"
@@ -36,6 +38,34 @@ Copyright_License {
 #include <stdio.h>
 #include <stdlib.h>
 
+constexpr
+static inline size_t
+LatinBufferSize(size_t size)
+{
+#ifdef _UNICODE
+/* with wide characters, the exact size of the FLARMNet database field
+   (plus one for the terminator) is just right, ... */
+  return size;
+#else
+/* ..., but when we convert Latin-1 to UTF-8, we need a little bit
+   more buffer */
+  return size * 3 / 2 + 1;
+#endif
+}
+
+/**
+ * The decoded fields of one line of the FlarmNet.org file.
+ */
+struct FlarmNetFileRecord {
+  StaticString<LatinBufferSize(7)> id;
+  StaticString<LatinBufferSize(22)> pilot;
+  StaticString<LatinBufferSize(22)> airfield;
+  StaticString<LatinBufferSize(22)> plane_type;
+  StaticString<LatinBufferSize(8)> registration;
+  StaticString<LatinBufferSize(4)> callsign;
+  StaticString<LatinBufferSize(8)> frequency;
+};
+
 /**
  * Decodes the FlarmNet.org file and puts the wanted
  * characters into the res pointer
@@ -95,13 +125,12 @@ LoadString(const char *bytes, size_t length, StaticString<size> &dest)
 }
 
 /**
- * Reads next FlarmNet.org file entry and returns the pointer to
- * a new FlarmNetRecord instance or NULL on error.
+ * Decodes one FlarmNet.org file entry.
  *
- * The caller is responsible for deleting the object again!
+ * @return false if the line is malformed
  */
 static bool
-LoadRecord(FlarmNetRecord &record, const char *line)
+LoadRecord(FlarmNetFileRecord &record, const char *line)
 {
   if (strlen(line) < 172)
     return false;
@@ -130,15 +159,24 @@ FlarmNetReader::LoadFile(NLineReader &reader, FlarmNetDatabase &database)
   if (line == NULL)
     return 0;
 
+  FlarmNetDatabaseBuilder builder;
+
   int itemCount = 0;
   while ((line = reader.ReadLine()) != NULL) {
-    FlarmNetRecord record;
+    FlarmNetFileRecord record;
     if (LoadRecord(record, line)) {
-      database.Insert(record);
+      /* in the order of FlarmNetRecord::GetStrings() */
+      const TCHAR *const strings[FlarmNetRecord::N_STRINGS] = {
+        record.id, record.pilot, record.airfield, record.plane_type,
+        record.registration, record.callsign, record.frequency,
+      };
+
+      builder.Add(FlarmId::Parse(record.id, NULL), strings);
       itemCount++;
     }
   }
 
+  builder.Finish(database);
   return itemCount;
 }
 
@@ -24,53 +24,107 @@ Copyright_License {
 #ifndef XCSOAR_FLARM_NET_RECORD_HPP
 #define XCSOAR_FLARM_NET_RECORD_HPP
 
-#include "Util/StaticString.hpp"
-#include "Compiler.h"
-
-class FlarmId;
-
-constexpr
-static inline size_t
-LatinBufferSize(size_t size)
-{
-#ifdef _UNICODE
-/* with wide characters, the exact size of the FLARMNet database field
-   (plus one for the terminator) is just right, ... */
-  return size;
-#else
-/* ..., but when we convert Latin-1 to UTF-8, we need a little bit
-   more buffer */
-  return size * 3 / 2 + 1;
-#endif
-}
+#include "FlarmId.hpp"
+
+#include <type_traits>
+
+#include <stdint.h>
+#include <tchar.h>
+
+/**
+ * A string in a #FlarmNetDatabase image.  It stores the distance
+ * from its own address to the null-terminated string in the image's
+ * string pool; this makes the image position independent, and it
+ * can be used directly from a memory-mapped file.
+ */
+class FlarmNetString {
+  uint32_t offset;
+
+public:
+  FlarmNetString() = default;
+
+  FlarmNetString(const FlarmNetString &) = delete;
+  FlarmNetString &operator=(const FlarmNetString &) = delete;
+
+  void SetOffset(uint32_t _offset) {
+    offset = _offset;
+  }
+
+  uint32_t GetOffset() const {
+    return offset;
+  }
+
+  const TCHAR *c_str() const {
+    return (const TCHAR *)((const char *)this + offset);
+  }
+
+  operator const TCHAR *() const {
+    return c_str();
+  }
+
+  bool empty() const {
+    return *c_str() == _T('\0');
+  }
+};
 
 /**
- * FlarmNet.org file entry
+ * FlarmNet.org file entry.  Objects of this type exist only inside a
+ * #FlarmNetDatabase image; they must not be copied, because their
+ * strings are addressed relative to the object.
  */
 struct FlarmNetRecord {
+  static constexpr unsigned N_STRINGS = 7;
+
+  /**
+   * The parsed FLARM id; the records in the image are sorted by it.
+   */
+  FlarmId flarm_id;
+
   /**< FLARM id 6 bytes */
-  StaticString<LatinBufferSize(7)> id;
+  FlarmNetString id;
 
   /**< Name 15 bytes */
-  StaticString<LatinBufferSize(22)> pilot;
+  FlarmNetString pilot;
 
   /**< Airfield 4 bytes */
-  StaticString<LatinBufferSize(22)> airfield;
+  FlarmNetString airfield;
 
   /**< Aircraft type 1 byte */
-  StaticString<LatinBufferSize(22)> plane_type;
+  FlarmNetString plane_type;
 
   /**< Registration 7 bytes */
-  StaticString<LatinBufferSize(8)> registration;
+  FlarmNetString registration;
 
   /**< Callsign 3 bytes */
-  StaticString<LatinBufferSize(4)> callsign;
+  FlarmNetString callsign;
 
   /**< Radio frequency 6 bytes */
-  StaticString<LatinBufferSize(8)> frequency;
+  FlarmNetString frequency;
 
-  gcc_pure
-  FlarmId GetId() const;
+  FlarmNetRecord() = default;
+
+  FlarmNetRecord(const FlarmNetRecord &) = delete;
+  FlarmNetRecord &operator=(const FlarmNetRecord &) = delete;
+
+  FlarmId GetId() const {
+    return flarm_id;
+  }
+
+  /**
+   * Access the strings in declaration order (#id first).
+   */
+  FlarmNetString *GetStrings() {
+    return &id;
+  }
+
+  const FlarmNetString *GetStrings() const {
+    return &id;
+  }
 };
 
+static_assert(std::is_standard_layout<FlarmNetRecord>::value,
+              "type has no standard layout");
+static_assert(sizeof(FlarmNetRecord) == sizeof(uint32_t) *
+              (1 + FlarmNetRecord::N_STRINGS), "unexpected padding");
+
 #endif
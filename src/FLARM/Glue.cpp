@@ -30,15 +30,32 @@ Copyright_License {
 #include "MergeThread.hpp"
 #include "IO/DataFile.hpp"
 #include "IO/TextWriter.hpp"
+#include "IO/FileCache.hpp"
+#include "LocalPath.hpp"
 #include "Profile/FlarmProfile.hpp"
 #include "LogFile.hpp"
 
+#include <windef.h> /* for MAX_PATH */
+
+static constexpr TCHAR FLARMNET_CACHE_NAME[] = _T("flarmnet");
+
 /**
- * Loads the FLARMnet file
+ * Loads the FLARMnet file.  The parsed database is stored in the
+ * #FileCache, and subsequent calls map it from there instead of
+ * parsing the file again.
  */
 static void
 LoadFLARMnet(FlarmNetDatabase &db)
 {
+  TCHAR path[MAX_PATH];
+  LocalPath(path, _T("data.fln"));
+
+  if (file_cache != nullptr &&
+      db.LoadCache(*file_cache, FLARMNET_CACHE_NAME, path)) {
+    LogFormat("%u FLARMnet ids loaded from cache", db.GetSize());
+    return;
+  }
+
   NLineReader *reader = OpenDataTextFileA(_T("data.fln"));
   if (reader == NULL)
     return;
@@ -46,8 +63,14 @@ LoadFLARMnet(FlarmNetDatabase &db)
   unsigned num_records = FlarmNetReader::LoadFile(*reader, db);
   delete reader;
 
-  if (num_records > 0)
+  if (num_records > 0) {
     LogFormat("%u FLARMnet ids found", num_records);
+
+    /* switch to the mapped cache file, which frees the heap copy */
+    if (file_cache != nullptr &&
+        db.SaveCache(*file_cache, FLARMNET_CACHE_NAME, path))
+      db.LoadCache(*file_cache, FLARMNET_CACHE_NAME, path);
+  }
 }
 
 /**
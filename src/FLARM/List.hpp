@@ -25,9 +25,11 @@ Copyright_License {
 #define XCSOAR_FLARM_TRAFFIC_LIST_HPP
 
 #include "Traffic.hpp"
+#include "TrafficGrid.hpp"
 #include "NMEA/Validity.hpp"
 #include "Util/TrivialArray.hpp"
 
+#include <algorithm>
 #include <type_traits>
 
 /**
@@ -45,9 +47,17 @@ struct TrafficList {
   /** Flarm traffic information */
   TrivialArray<FlarmTraffic, MAX_COUNT> list;
 
+  /**
+   * A spatial hash of the target locations for VisitWithinRange().  It is
+   * rebuilt by UpdateGrid() after the locations have been calculated,
+   * and invalidated by all methods which add or remove targets.
+   */
+  TrafficGrid<MAX_COUNT> grid;
+
   void Clear() {
     new_traffic.Clear();
     list.clear();
+    grid.Clear();
   }
 
   bool IsEmpty() const {
@@ -59,16 +69,51 @@ struct TrafficList {
    * this one.
    */
   void Complement(const TrafficList &add) {
-    if (IsEmpty() && !add.IsEmpty())
-      *this = add;
+    if (IsEmpty() && !add.IsEmpty()) {
+      /* copy only the occupied part of the array; a full copy would
+         move MAX_COUNT objects */
+      new_traffic = add.new_traffic;
+      list.resize(add.list.size());
+      std::copy(add.list.begin(), add.list.end(), list.begin());
+      grid.Clear();
+    }
   }
 
   void Expire(fixed clock) {
     new_traffic.Expire(clock, fixed(60));
 
-    for (unsigned i = list.size(); i-- > 0;)
-      if (!list[i].Refresh(clock))
+    for (unsigned i = list.size(); i-- > 0;) {
+      if (!list[i].Refresh(clock)) {
         list.quick_remove(i);
+        grid.Clear();
+      }
+    }
+  }
+
+  /**
+   * Rebuild the #grid from the current target locations.
+   */
+  void UpdateGrid() {
+    grid.Build(list.begin(), list.size());
+  }
+
+  /**
+   * Invoke f(traffic) for each target with a known location which is
+   * closer than the given range to the given location.  Uses the
+   * #grid if it is valid, and a linear search otherwise.
+   */
+  template<typename F>
+  void VisitWithinRange(const GeoPoint &location, fixed range, F &&f) const {
+    auto check = [this, &location, range, &f](unsigned i) {
+      const FlarmTraffic &traffic = list[i];
+      if (traffic.location_available &&
+          location.Distance(traffic.location) < range)
+        f(traffic);
+    };
+
+    if (!grid.Visit(location, range, check))
+      for (unsigned i = 0, n = list.size(); i < n; ++i)
+        check(i);
   }
 
   unsigned GetActiveTrafficCount() const {
@@ -137,9 +182,11 @@ struct TrafficList {
    * @return the FLARM_TRAFFIC pointer, NULL if the array is full
    */
   FlarmTraffic *AllocateTraffic() {
-    return list.full()
-      ? NULL
-      : &list.append();
+    if (list.full())
+      return NULL;
+
+    grid.Clear();
+    return &list.append();
   }
 
   /**
@@ -22,6 +22,7 @@ Copyright_License {
 */
 
 #include "NameDatabase.hpp"
+#include "Util/StringUtil.hpp"
 
 int
 FlarmNameDatabase::Find(FlarmId id) const
@@ -82,6 +83,22 @@ FlarmNameDatabase::Get(const TCHAR *name, FlarmId *buffer, unsigned max) const
   return n;
 }
 
+unsigned
+FlarmNameDatabase::GetByPrefix(const TCHAR *prefix,
+                               FlarmId *buffer, unsigned max) const
+{
+  assert(prefix != nullptr);
+  assert(buffer != nullptr);
+  assert(max > 0);
+
+  unsigned n = 0;
+  for (unsigned i = 0, size = data.size(); i != size && n != max; ++i)
+    if (StringStartsWith(data[i].name, prefix))
+      buffer[n++] = data[i].id;
+
+  return n;
+}
+
 bool
 FlarmNameDatabase::Set(FlarmId id, const TCHAR *name)
 {
@@ -76,6 +76,15 @@ public:
    */
   unsigned Get(const TCHAR *name, FlarmId *buffer, unsigned max) const;
 
+  /**
+   * Look up all records whose name starts with the specified string.
+   *
+   * @param max the maximum size of the given buffer
+   * @return the number of items copied to the given buffer
+   */
+  unsigned GetByPrefix(const TCHAR *prefix,
+                       FlarmId *buffer, unsigned max) const;
+
   bool Set(FlarmId id, const TCHAR *name);
 
 protected:
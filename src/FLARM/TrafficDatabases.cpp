@@ -73,3 +73,18 @@ TrafficDatabases::FindIdsByName(const TCHAR *name,
 
   return n;
 }
+
+unsigned
+TrafficDatabases::FindIdsByNamePrefix(const TCHAR *prefix,
+                                      FlarmId *buffer, unsigned max) const
+{
+  assert(prefix != nullptr);
+  assert(!StringIsEmpty(prefix));
+  assert(buffer != nullptr);
+
+  unsigned n = flarm_names.GetByPrefix(prefix, buffer, max);
+  if (n < max)
+    n += flarm_net.FindIdsByCallSignPrefix(prefix, buffer + n, max - n);
+
+  return n;
+}
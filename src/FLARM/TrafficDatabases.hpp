@@ -72,6 +72,17 @@ struct TrafficDatabases {
   gcc_nonnull_all
   unsigned FindIdsByName(const TCHAR *name,
                          FlarmId *buffer, unsigned max) const;
+
+  /**
+   * Look up all records whose name starts with the specified string.
+   * The same id may be returned twice if it is in both databases.
+   *
+   * @param max the maximum size of the given buffer
+   * @return the number of items copied to the given buffer
+   */
+  gcc_nonnull_all
+  unsigned FindIdsByNamePrefix(const TCHAR *prefix,
+                               FlarmId *buffer, unsigned max) const;
 };
 
 #endif
@@ -0,0 +1,156 @@
+/*
+Copyright_License {
+
+  XCSoar Glide Computer - http://www.xcsoar.org/
+  Copyright (C) 2000-2014 The XCSoar Project
+  A detailed list of copyright holders can be found in the file "AUTHORS".
+
+  This program is free software; you can redistribute it and/or
+  modify it under the terms of the GNU General Public License
+  as published by the Free Software Foundation; either version 2
+  of the License, or (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+}
+*/
+
+#ifndef XCSOAR_FLARM_TRAFFIC_GRID_HPP
+#define XCSOAR_FLARM_TRAFFIC_GRID_HPP
+
+#include "Traffic.hpp"
+#include "Geo/Math.hpp"
+
+#include <algorithm>
+
+#include <math.h>
+#include <stdint.h>
+
+/**
+ * A spatial hash of the target locations in a #TrafficList.  The
+ * earth is divided into cells of 0.01 degrees; each target is linked
+ * into the bucket of its cell.  A range query only looks at the
+ * buckets of the cells which intersect with the range.
+ *
+ * This is a trivial type, because it is stored in #TrafficList.
+ */
+template<unsigned MAX_ITEMS>
+struct TrafficGrid {
+  static_assert(MAX_ITEMS < 0xff, "too many items");
+
+  static constexpr unsigned N_BUCKETS = 32;
+  static constexpr int CELLS_PER_DEGREE = 100;
+  static constexpr uint8_t NONE = 0xff;
+
+  /**
+   * Is this grid up to date?  If not, the caller must fall back to a
+   * linear search.
+   */
+  bool valid;
+
+  /**
+   * The first item index in each bucket, or #NONE.
+   */
+  uint8_t head[N_BUCKETS];
+
+  /**
+   * The next item index in the same bucket, or #NONE.
+   */
+  uint8_t next[MAX_ITEMS];
+
+  /**
+   * The cell of each item.
+   */
+  int16_t cell_y[MAX_ITEMS], cell_x[MAX_ITEMS];
+
+  void Clear() {
+    valid = false;
+  }
+
+  bool IsValid() const {
+    return valid;
+  }
+
+  /**
+   * Build the grid from the given items.  Items without a location
+   * are not inserted.
+   */
+  void Build(const FlarmTraffic *items, unsigned n) {
+    std::fill_n(head, N_BUCKETS, uint8_t(NONE));
+
+    for (unsigned i = 0; i < n; ++i) {
+      if (!items[i].location_available)
+        continue;
+
+      const int y = ToCell(items[i].location.latitude);
+      const int x = ToCell(items[i].location.longitude);
+      cell_y[i] = y;
+      cell_x[i] = x;
+
+      const unsigned bucket = ToBucket(y, x);
+      next[i] = head[bucket];
+      head[bucket] = i;
+    }
+
+    valid = true;
+  }
+
+  /**
+   * Invoke f(index) for each item which may be within the given range
+   * of the location; the caller must check the distance.
+   *
+   * @return false if the grid cannot answer this query (not valid,
+   * range too large, near the poles or the date line), and the
+   * caller must check all items
+   */
+  template<typename F>
+  bool Visit(const GeoPoint &location, fixed range, F &&f) const {
+    if (!valid)
+      return false;
+
+    const fixed cos_latitude = location.latitude.cos();
+    if (cos_latitude < fixed(0.1))
+      return false;
+
+    const Angle lat_span = EarthDistanceToAngle(range);
+    const Angle lon_span = lat_span / cos_latitude;
+    if ((location.longitude - lon_span).Degrees() < fixed(-180) ||
+        (location.longitude + lon_span).Degrees() > fixed(180))
+      return false;
+
+    const int y_min = ToCell(location.latitude - lat_span);
+    const int y_max = ToCell(location.latitude + lat_span);
+    const int x_min = ToCell(location.longitude - lon_span);
+    const int x_max = ToCell(location.longitude + lon_span);
+
+    /* if there are more cells than buckets, visiting the buckets
+       would not be cheaper than a linear search */
+    if (unsigned(y_max - y_min + 1) * unsigned(x_max - x_min + 1) > N_BUCKETS)
+      return false;
+
+    for (int y = y_min; y <= y_max; ++y)
+      for (int x = x_min; x <= x_max; ++x)
+        for (unsigned i = head[ToBucket(y, x)]; i != NONE; i = next[i])
+          if (cell_y[i] == y && cell_x[i] == x)
+            f(i);
+
+    return true;
+  }
+
+private:
+  static int ToCell(Angle angle) {
+    return (int)floor(angle.Degrees() * CELLS_PER_DEGREE);
+  }
+
+  static unsigned ToBucket(int y, int x) {
+    return (unsigned(y) * 31u + unsigned(x)) % N_BUCKETS;
+  }
+};
+
+#endif
@@ -0,0 +1,109 @@
+/*
+Copyright_License {
+
+  XCSoar Glide Computer - http://www.xcsoar.org/
+  Copyright (C) 2000-2014 The XCSoar Project
+  A detailed list of copyright holders can be found in the file "AUTHORS".
+
+  This program is free software; you can redistribute it and/or
+  modify it under the terms of the GNU General Public License
+  as published by the Free Software Foundation; either version 2
+  of the License, or (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+}
+*/
+
+#include "IGCIndex.hpp"
+#include "IGCParser.hpp"
+#include "IO/LineReader.hpp"
+#include "Time/BrokenTime.hpp"
+
+#include <algorithm>
+
+void
+IGCIndex::Clear()
+{
+  entries.clear();
+  extensions.clear();
+  date = BrokenDate::Invalid();
+}
+
+bool
+IGCIndex::Build(NLineReader &reader)
+{
+  Clear();
+
+  unsigned day_offset = 0, last_second_of_day = 0, last_time = 0;
+
+  while (true) {
+    const long offset = reader.Tell();
+    const char *line = reader.ReadLine();
+    if (line == nullptr)
+      break;
+
+    if (line[0] == 'B') {
+      BrokenTime time;
+      if (!IGCParseTime(line + 1, time))
+        continue;
+
+      const unsigned second_of_day = time.GetSecondOfDay();
+      if (!entries.empty() && last_second_of_day >= 23 * 3600u &&
+          second_of_day < 3600)
+        /* midnight roll-over */
+        day_offset += 24 * 3600u;
+
+      last_second_of_day = second_of_day;
+      last_time = std::max(last_time, day_offset + second_of_day);
+      entries.push_back({last_time, offset});
+    } else if (line[0] == 'H') {
+      if (!date.IsPlausible())
+        IGCParseDateRecord(line, date);
+    } else if (line[0] == 'I') {
+      IGCParseExtensions(line, extensions);
+    }
+  }
+
+  return !entries.empty();
+}
+
+unsigned
+IGCIndex::Find(unsigned time) const
+{
+  auto i = std::lower_bound(entries.begin(), entries.end(), time,
+                            [](const Entry &entry, unsigned time) {
+                              return entry.time < time;
+                            });
+  return std::distance(entries.begin(), i);
+}
+
+unsigned
+IGCIndex::Split(Window *windows, unsigned n) const
+{
+  assert(n > 0);
+
+  const unsigned size = entries.size();
+  if (n > size)
+    n = size;
+
+  for (unsigned i = 0; i < n; ++i) {
+    const unsigned first = size * i / n;
+    const unsigned next = size * (i + 1) / n;
+    assert(next > first);
+
+    Window &w = windows[i];
+    w.begin = entries[first].offset;
+    w.end = next < size ? entries[next].offset : -1;
+    w.start_time = entries[first].time;
+    w.end_time = entries[next - 1].time;
+  }
+
+  return n;
+}
@@ -0,0 +1,160 @@
+/*
+Copyright_License {
+
+  XCSoar Glide Computer - http://www.xcsoar.org/
+  Copyright (C) 2000-2014 The XCSoar Project
+  A detailed list of copyright holders can be found in the file "AUTHORS".
+
+  This program is free software; you can redistribute it and/or
+  modify it under the terms of the GNU General Public License
+  as published by the Free Software Foundation; either version 2
+  of the License, or (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+}
+*/
+
+#ifndef XCSOAR_IGC_INDEX_HPP
+#define XCSOAR_IGC_INDEX_HPP
+
+#include "IGCExtensions.hpp"
+#include "Time/BrokenDate.hpp"
+#include "Compiler.h"
+
+#include <vector>
+
+#include <assert.h>
+
+class NLineReader;
+
+/**
+ * An index of the "B" records in an IGC file, which maps the time of
+ * each fix to the position of its line in the file.  It allows
+ * jumping to an arbitrary time with a binary search, and splitting
+ * the file into time windows which can be read independently.
+ */
+class IGCIndex {
+public:
+  struct Entry {
+    /**
+     * The time of the fix [seconds since midnight of the first
+     * day].  This is monotonic: the midnight roll-over adds 24
+     * hours, and a fix which jumps back in time gets the time of
+     * its predecessor.
+     */
+    unsigned time;
+
+    /**
+     * The position of the "B" record in the file.
+     */
+    long offset;
+  };
+
+  /**
+   * A range of the file which contains a contiguous block of fixes.
+   */
+  struct Window {
+    /**
+     * The position of the first line.
+     */
+    long begin;
+
+    /**
+     * The position after the last line, or -1 for "end of file".
+     */
+    long end;
+
+    unsigned start_time, end_time;
+  };
+
+private:
+  std::vector<Entry> entries;
+
+  /**
+   * The extensions declared by the "I" record.
+   */
+  IGCExtensions extensions;
+
+  /**
+   * The date declared by the "HFDTE" record; may be invalid.
+   */
+  BrokenDate date;
+
+public:
+  IGCIndex() {
+    Clear();
+  }
+
+  void Clear();
+
+  /**
+   * Read all lines from the current position of the specified reader
+   * and index the "B" records.  Afterwards, the reader is at the end
+   * of the file; the caller is responsible for restoring its
+   * position.
+   *
+   * @return true if at least one fix was found
+   */
+  bool Build(NLineReader &reader);
+
+  bool empty() const {
+    return entries.empty();
+  }
+
+  unsigned size() const {
+    return entries.size();
+  }
+
+  const Entry &operator[](unsigned i) const {
+    assert(i < entries.size());
+
+    return entries[i];
+  }
+
+  const IGCExtensions &GetExtensions() const {
+    return extensions;
+  }
+
+  const BrokenDate &GetDate() const {
+    return date;
+  }
+
+  unsigned GetStartTime() const {
+    assert(!empty());
+
+    return entries.front().time;
+  }
+
+  unsigned GetEndTime() const {
+    assert(!empty());
+
+    return entries.back().time;
+  }
+
+  /**
+   * Find the first fix at or after the specified time.
+   *
+   * @return the index of the entry, or size() if all fixes are older
+   */
+  gcc_pure
+  unsigned Find(unsigned time) const;
+
+  /**
+   * Split the flight into time windows with (roughly) the same
+   * number of fixes.
+   *
+   * @param windows an array of at least n elements
+   * @return the number of windows which were filled, which is less
+   * than n if there are less than n fixes
+   */
+  unsigned Split(Window *windows, unsigned n) const;
+};
+
+#endif
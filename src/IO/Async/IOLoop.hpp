@@ -25,6 +25,10 @@ Copyright_License {
 #define XCSOAR_IO_LOOP_HPP
 
 #include "OS/Poll.hpp"
+
+#ifdef __linux__
+#include "OS/EPoll.hpp"
+#endif
 #include "Thread/Mutex.hpp"
 #include "Thread/Cond.hpp"
 #include "FileEventHandler.hpp"
@@ -63,7 +67,13 @@ class IOLoop final {
     }
   };
 
+#ifdef __linux__
+  /* epoll only reports the ready file descriptors, which saves a scan
+     over all ports after each wakeup */
+  EPoll poll;
+#else
   Poll poll;
+#endif
 
   Mutex mutex;
 
@@ -83,6 +93,18 @@ public:
 
   IOLoop():modified(false), running(false) {}
 
+  /**
+   * Was the kernel object needed for waiting created successfully?
+   * If not, the object must not be used.
+   */
+  bool IsDefined() const {
+#ifdef __linux__
+    return poll.IsDefined();
+#else
+    return true;
+#endif
+  }
+
   gcc_pure
   bool IsEmpty() const {
     return files.empty();
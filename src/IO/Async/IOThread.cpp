@@ -32,7 +32,7 @@ IOThread::Start()
 
   quit = false;
 
-  if (!pipe.Create())
+  if (!loop.IsDefined() || !pipe.Create())
     return false;
 
   loop.Add(pipe.GetReadFD(), READ, *this);
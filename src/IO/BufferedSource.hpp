@@ -39,6 +39,17 @@ public:
 protected:
   virtual unsigned Read(T *p, unsigned n) = 0;
 
+  /**
+   * Discard the buffered data.  Call this after the position of the
+   * underlying file has been changed.
+   *
+   * @param _position the new position
+   */
+  void ResetBuffer(long _position) {
+    buffer.Clear();
+    position = _position;
+  }
+
 public:
   virtual typename Source<T>::Range Read() override {
     auto r = buffer.Write();
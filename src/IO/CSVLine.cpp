@@ -41,8 +41,8 @@ CSVLine::CSVLine(const char *line):
 size_t
 CSVLine::Skip()
 {
-  const char* _seperator = strchr(data, ',');
-  if (_seperator != NULL && _seperator < end) {
+  const char* _seperator = (const char *)memchr(data, ',', end - data);
+  if (_seperator != NULL) {
     size_t length = _seperator - data;
     data = _seperator + 1;
     return length;
@@ -39,6 +39,14 @@ protected:
 public:
   CSVLine(const char *line);
 
+  /**
+   * Construct an object for a line whose end is already known.  The
+   * number parsers may still look at the character at @a _end, so
+   * it must not be a digit.
+   */
+  CSVLine(const char *line, const char *_end)
+    :data(line), end(_end) {}
+
   Range<const char *> Rest() const {
     return Range<const char *>(data, end);
   }
@@ -23,6 +23,7 @@ Copyright_License {
 
 #include "FileCache.hpp"
 #include "OS/FileUtil.hpp"
+#include "OS/FileMapping.hpp"
 #include "OS/PathName.hpp"
 #include "Compatibility/path.h"
 #include "Compiler.h"
@@ -191,6 +192,30 @@ FileCache::Load(const TCHAR *name, const TCHAR *original_path)
   return file;
 }
 
+FileMapping *
+FileCache::Map(const TCHAR *name, const TCHAR *original_path,
+               size_t &offset_r)
+{
+  FILE *file = Load(name, original_path);
+  if (file == NULL)
+    return NULL;
+
+  const long offset = ftell(file);
+  fclose(file);
+  if (offset < 0)
+    return NULL;
+
+  TCHAR path[PathBufferSize(name)];
+  FileMapping *mapping = new FileMapping(MakeCachePath(path, name));
+  if (mapping->error() || mapping->size() < (size_t)offset) {
+    delete mapping;
+    return NULL;
+  }
+
+  offset_r = offset;
+  return mapping;
+}
+
 FILE *
 FileCache::Save(const TCHAR *name, const TCHAR *original_path)
 {
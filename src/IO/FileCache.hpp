@@ -27,6 +27,8 @@ Copyright_License {
 #include <stdio.h>
 #include <tchar.h>
 
+class FileMapping;
+
 class FileCache {
   TCHAR *cache_path;
   size_t cache_path_length;
@@ -43,6 +45,17 @@ public:
   void Flush(const TCHAR *name);
   FILE *Load(const TCHAR *name, const TCHAR *original_path);
 
+  /**
+   * Like Load(), but map the cache file into memory.
+   *
+   * @param offset_r on success, receives the position of the cached
+   * data within the mapping
+   * @return a new #FileMapping object (to be freed by the caller) or
+   * nullptr
+   */
+  FileMapping *Map(const TCHAR *name, const TCHAR *original_path,
+                   size_t &offset_r);
+
   FILE *Save(const TCHAR *name, const TCHAR *original_path);
   bool Commit(const TCHAR *name, FILE *file);
   void Cancel(const TCHAR *name, FILE *file);
@@ -60,6 +60,18 @@ public:
     return true;
   }
 
+  /**
+   * Continue reading at the specified position, which should be the
+   * beginning of a line (e.g. a value returned by Tell()).
+   */
+  bool Seek(long offset) {
+    if (!file.Seek(offset))
+      return false;
+
+    splitter.ResetBuffer();
+    return true;
+  }
+
 public:
   /* virtual methods from class NLineReader */
   virtual char *ReadLine() override;
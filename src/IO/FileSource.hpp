@@ -45,7 +45,18 @@ public:
    * Rewind the file to the beginning.
    */
   bool Rewind() {
-    return fd.Rewind();
+    return Seek(0);
+  }
+
+  /**
+   * Continue reading at the specified position.
+   */
+  bool Seek(long offset) {
+    if (!fd.Seek(offset))
+      return false;
+
+    ResetBuffer(offset);
+    return true;
   }
 
 public:
@@ -84,7 +95,18 @@ public:
    * Rewind the file to the beginning.
    */
   bool Rewind() {
-    return ::SetFilePointer(handle, 0, NULL, FILE_BEGIN) == 0;
+    return Seek(0);
+  }
+
+  /**
+   * Continue reading at the specified position.
+   */
+  bool Seek(long offset) {
+    if (::SetFilePointer(handle, offset, NULL, FILE_BEGIN) != (DWORD)offset)
+      return false;
+
+    ResetBuffer(offset);
+    return true;
   }
 
 public:
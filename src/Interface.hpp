@@ -187,6 +187,18 @@ namespace CommonInterface {
     Private::blackboard.ReadBlackboardCalculated(derived_info);
   }
 
+  static inline void ReadBlackboardBasic(const SeqLock<MoreData> &nmea_info) {
+    assert(InMainThread());
+
+    Private::blackboard.ReadBlackboardBasic(nmea_info);
+  }
+
+  static inline void ReadBlackboardCalculated(const SeqLock<DerivedInfo> &derived_info) {
+    assert(InMainThread());
+
+    Private::blackboard.ReadBlackboardCalculated(derived_info);
+  }
+
   static inline void ReadCommonStats(const CommonStats &common_stats) {
     assert(InMainThread());
 
@@ -111,9 +111,8 @@ GlueMapWindow::ExchangeBlackboard()
 {
   /* copy device_blackboard to MapWindow */
 
-  device_blackboard->mutex.Lock();
-  ReadBlackboard(device_blackboard->Basic(), device_blackboard->Calculated());
-  device_blackboard->mutex.Unlock();
+  ReadBlackboard(device_blackboard->PublishedBasic(),
+                 device_blackboard->PublishedCalculated());
 
 #ifndef ENABLE_OPENGL
   next_mutex.Lock();
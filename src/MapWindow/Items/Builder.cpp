@@ -288,15 +288,13 @@ MapItemListBuilder::AddWeatherStations(NOAAStore &store)
 void
 MapItemListBuilder::AddTraffic(const TrafficList &flarm)
 {
-  for (const auto &t : flarm.list) {
-    if (list.full())
-      break;
+  flarm.VisitWithinRange(location, range, [this](const FlarmTraffic &t) {
+      if (list.full())
+        return;
 
-    if (location.Distance(t.location) < range) {
       auto color = FlarmFriends::GetFriendColor(t.id);
       list.append(new TrafficMapItem(t.id, color));
-    }
-  }
+    });
 }
 
 void
@@ -22,6 +22,7 @@ Copyright_License {
 */
 
 #include "MapWindowBlackboard.hpp"
+#include "Thread/SeqLock.hpp"
 
 void
 MapWindowBlackboard::ReadComputerSettings(const ComputerSettings
@@ -45,3 +46,11 @@ MapWindowBlackboard::ReadBlackboard(const MoreData &nmea_info,
   calculated_info = derived_info;
 }
 
+void
+MapWindowBlackboard::ReadBlackboard(const SeqLock<MoreData> &nmea_info,
+                                    const SeqLock<DerivedInfo> &derived_info)
+{
+  nmea_info.Read(gps_info);
+  derived_info.Read(calculated_info);
+}
+
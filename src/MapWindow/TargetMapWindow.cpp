@@ -34,6 +34,7 @@ Copyright_License {
 #include "Engine/Task/Ordered/Points/OrderedTaskPoint.hpp"
 #include "Engine/Task/ObservationZones/ObservationZonePoint.hpp"
 #include "Engine/Task/ObservationZones/CylinderZone.hpp"
+#include "Screen/Layout.hpp"
 
 #ifdef ENABLE_OPENGL
 #include "Screen/OpenGL/Scissor.hpp"
@@ -158,6 +159,43 @@ TargetMapWindow::DrawTask(Canvas &canvas)
   }
 }
 
+void
+TargetMapWindow::DrawTargetSweep(Canvas &canvas)
+{
+  fixed min_time(-1), max_time(-1);
+  for (const auto &i : target_sweep) {
+    if (!i.solution.IsOk())
+      continue;
+
+    const fixed t = i.solution.time_elapsed;
+    if (negative(min_time) || t < min_time)
+      min_time = t;
+    if (t > max_time)
+      max_time = t;
+  }
+
+  if (negative(min_time))
+    return;
+
+  const fixed delta = max_time - min_time;
+  const unsigned radius = Layout::FastScale(3);
+
+  canvas.SelectNullPen();
+
+  for (const auto &i : target_sweep) {
+    RasterPoint pt;
+    if (!i.solution.IsOk() ||
+        !projection.GeoToScreenIfVisible(i.location, pt))
+      continue;
+
+    const uint8_t red = positive(delta)
+      ? uint8_t((i.solution.time_elapsed - min_time) * 255 / delta)
+      : 0;
+    canvas.Select(Brush(Color(red, 255 - red, 0)));
+    canvas.DrawCircle(pt.x, pt.y, radius);
+  }
+}
+
 void
 TargetMapWindow::DrawWaypoints(Canvas &canvas)
 {
@@ -212,6 +250,7 @@ TargetMapWindow::OnPaintBuffer(Canvas &canvas)
 
   // Render task, waypoints
   DrawTask(canvas);
+  DrawTargetSweep(canvas);
   DrawWaypoints(canvas);
 
   // Render the snail trail
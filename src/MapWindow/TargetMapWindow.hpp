@@ -31,8 +31,11 @@ Copyright_License {
 #include "Renderer/BackgroundRenderer.hpp"
 #include "Renderer/WaypointRenderer.hpp"
 #include "Renderer/TrailRenderer.hpp"
+#include "Engine/Task/Solvers/TaskTargetSweep.hpp"
 #include "Compiler.h"
 
+#include <vector>
+
 #ifndef ENABLE_OPENGL
 #include "Screen/BufferCanvas.hpp"
 #endif
@@ -76,6 +79,12 @@ class TargetMapWindow : public BufferWindow {
 
   unsigned target_index;
 
+  /**
+   * The remainder of the task evaluated for a grid of targets in the
+   * OZ, drawn as a heat map.  See SetTargetSweep().
+   */
+  std::vector<TargetSweepResult> target_sweep;
+
   enum DragMode {
     DRAG_NONE,
 
@@ -134,6 +143,16 @@ public:
 
   void SetTarget(unsigned index);
 
+  /**
+   * Show the specified "what if" results as a heat map of the time
+   * remaining, from green (fastest) to red (slowest).  Pass an empty
+   * vector to hide it.
+   */
+  void SetTargetSweep(std::vector<TargetSweepResult> &&_target_sweep) {
+    target_sweep = std::move(_target_sweep);
+    Invalidate();
+  }
+
 private:
   /**
    * Renders the terrain background
@@ -165,6 +184,8 @@ private:
 
   void DrawTask(Canvas &canvas);
 
+  void DrawTargetSweep(Canvas &canvas);
+
 private:
   /**
    * If PanTarget, paints target during drag
@@ -41,6 +41,7 @@ MergeThread::Process()
 {
   assert(!IsDefined() || IsInside());
 
+  AllDevicesConsumeSamples();
   device_blackboard.Merge();
 
   const MoreData &basic = device_blackboard.Basic();
@@ -53,6 +54,8 @@ MergeThread::Process()
 
   flarm_computer.Process(device_blackboard.SetBasic().flarm,
                          last_fix.flarm, basic);
+
+  device_blackboard.PublishBasic();
 }
 
 void
@@ -31,23 +31,43 @@ Copyright_License {
 
 bool
 VerifyNMEAChecksum(const char *p)
+{
+  return VerifyNMEAChecksumEnd(p) != nullptr;
+}
+
+const char *
+VerifyNMEAChecksumEnd(const char *p)
 {
   assert(p != NULL);
 
-  const char *asterisk = strrchr(p, '*');
-  if (asterisk == NULL)
-    return false;
+  /* skip the dollar sign at the beginning (the exclamation mark is
+     used by CAI302 */
+  const char *i = p;
+  if (*i == '$' || *i == '!')
+    ++i;
+
+  /* calculate the checksum and find the last asterisk in one pass */
+  uint8_t checksum = 0, calculated = 0;
+  const char *asterisk = nullptr;
+  for (; *i != 0; ++i) {
+    if (*i == '*') {
+      asterisk = i;
+      calculated = checksum;
+    }
+
+    checksum ^= *i;
+  }
+
+  if (asterisk == nullptr)
+    return nullptr;
 
   const char *checksum_string = asterisk + 1;
   char *endptr;
-  unsigned long ReadCheckSum2 = strtoul(checksum_string, &endptr, 16);
-  if (endptr == checksum_string || *endptr != 0 || ReadCheckSum2 >= 0x100)
-    return false;
-
-  uint8_t ReadCheckSum = (unsigned char)ReadCheckSum2;
-  uint8_t CalcCheckSum = NMEAChecksum(p, asterisk - p);
+  unsigned long received = strtoul(checksum_string, &endptr, 16);
+  if (endptr == checksum_string || *endptr != 0 || received >= 0x100)
+    return nullptr;
 
-  return CalcCheckSum == ReadCheckSum;
+  return received == calculated ? asterisk : nullptr;
 }
 
 void
@@ -87,6 +87,18 @@ gcc_pure
 bool
 VerifyNMEAChecksum(const char *p);
 
+/**
+ * Like VerifyNMEAChecksum(), but scans the string only once and
+ * returns the position of the asterisk, which is the end of the
+ * payload.
+ *
+ * @return a pointer to the asterisk or nullptr if the checksum is
+ * missing or wrong
+ */
+gcc_pure
+const char *
+VerifyNMEAChecksumEnd(const char *p);
+
 /**
  * Caclulates the checksum of the specified string, and appends it at
  * the end, preceded by an asterisk ('*').
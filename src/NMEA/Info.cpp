@@ -139,6 +139,13 @@ NMEAInfo::ProvideIndicatedAirspeed(fixed ias)
 
 void
 NMEAInfo::Reset()
+{
+  ResetExceptFlarm();
+  flarm.Clear();
+}
+
+void
+NMEAInfo::ResetExceptFlarm()
 {
   UpdateClock();
 
@@ -200,7 +207,6 @@ NMEAInfo::Reset()
 
   device.Clear();
   secondary_device.Clear();
-  flarm.Clear();
 }
 
 void
@@ -259,6 +265,16 @@ NMEAInfo::Expire()
 
 void
 NMEAInfo::Complement(const NMEAInfo &add)
+{
+  if (!add.alive)
+    return;
+
+  ComplementExceptFlarm(add);
+  flarm.Complement(add.flarm);
+}
+
+void
+NMEAInfo::ComplementExceptFlarm(const NMEAInfo &add)
 {
   if (!add.alive)
     /* if there is no heartbeat on the other object, there cannot be
@@ -356,6 +372,4 @@ NMEAInfo::Complement(const NMEAInfo &add)
 
   if (!stall_ratio_available && add.stall_ratio_available)
     stall_ratio = add.stall_ratio;
-
-  flarm.Complement(add.flarm);
 }
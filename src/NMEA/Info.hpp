@@ -644,6 +644,11 @@ struct NMEAInfo {
    */
   void Reset();
 
+  /**
+   * Like Reset(), but leave the #flarm attribute alone.
+   */
+  void ResetExceptFlarm();
+
   /**
    * Check the expiry time of the device connection with the wall
    * clock time.  This should be called from a periodic timer.  The
@@ -667,6 +672,11 @@ struct NMEAInfo {
    * outside of the NMEA parser.
    */
   void Complement(const NMEAInfo &add);
+
+  /**
+   * Like Complement(), but leave the #flarm attribute alone.
+   */
+  void ComplementExceptFlarm(const NMEAInfo &add);
 };
 
 static_assert(std::is_trivial<NMEAInfo>::value, "type is not trivial");
@@ -32,6 +32,16 @@ Copyright_License {
 class NMEAInputLine: public CSVLine {
 public:
   NMEAInputLine(const char* line);
+
+  /**
+   * Construct an object for a line whose checksum has already been
+   * verified.
+   *
+   * @param asterisk the end of the payload, as returned by
+   * VerifyNMEAChecksumEnd()
+   */
+  NMEAInputLine(const char *line, const char *asterisk)
+    :CSVLine(line, asterisk) {}
 };
 
 #endif
@@ -0,0 +1,80 @@
+/*
+Copyright_License {
+
+  XCSoar Glide Computer - http://www.xcsoar.org/
+  Copyright (C) 2000-2014 The XCSoar Project
+  A detailed list of copyright holders can be found in the file "AUTHORS".
+
+  This program is free software; you can redistribute it and/or
+  modify it under the terms of the GNU General Public License
+  as published by the Free Software Foundation; either version 2
+  of the License, or (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+}
+*/
+
+#ifndef XCSOAR_NMEA_SENTENCE_KEY_HPP
+#define XCSOAR_NMEA_SENTENCE_KEY_HPP
+
+#include "Compiler.h"
+
+#include <stddef.h>
+#include <stdint.h>
+
+/*
+ * Helpers for dispatching NMEA sentences with a "switch" statement
+ * instead of a chain of string comparisons.  An address of up to 8
+ * characters is packed into an integer; different addresses always
+ * yield different keys, i.e. this is a perfect hash, and the compiler
+ * turns the "switch" into a jump table or a binary search.
+ */
+
+static constexpr size_t MAX_NMEA_SENTENCE_KEY_LENGTH = 8;
+
+constexpr
+static inline uint64_t
+NMEASentenceKeyImpl(const char *p, uint64_t key)
+{
+  return *p == 0
+    ? key
+    : NMEASentenceKeyImpl(p + 1, (key << 8) | (uint8_t)*p);
+}
+
+/**
+ * Calculate the key of a null-terminated address, to be used as a
+ * "case" label.  It must not be longer than
+ * #MAX_NMEA_SENTENCE_KEY_LENGTH.
+ */
+constexpr
+static inline uint64_t
+NMEASentenceKey(const char *p)
+{
+  return NMEASentenceKeyImpl(p, 0);
+}
+
+/**
+ * Calculate the key of an address which is not null-terminated.
+ * Returns 0 (which never matches a literal) if it is too long.
+ */
+gcc_pure
+static inline uint64_t
+NMEASentenceKey(const char *p, size_t length)
+{
+  if (length > MAX_NMEA_SENTENCE_KEY_LENGTH)
+    return 0;
+
+  uint64_t key = 0;
+  for (size_t i = 0; i < length; ++i)
+    key = (key << 8) | (uint8_t)p[i];
+  return key;
+}
+
+#endif
@@ -0,0 +1,210 @@
+/*
+Copyright_License {
+
+  XCSoar Glide Computer - http://www.xcsoar.org/
+  Copyright (C) 2000-2014 The XCSoar Project
+  A detailed list of copyright holders can be found in the file "AUTHORS".
+
+  This program is free software; you can redistribute it and/or
+  modify it under the terms of the GNU General Public License
+  as published by the Free Software Foundation; either version 2
+  of the License, or (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+}
+*/
+
+#ifndef XCSOAR_EPOLL_HPP
+#define XCSOAR_EPOLL_HPP
+
+#include "Compiler.h"
+
+#include <sys/epoll.h>
+#include <poll.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <errno.h>
+#include <assert.h>
+
+/**
+ * A drop-in replacement for class #Poll based on Linux epoll.  The
+ * kernel keeps the set of registered file descriptors, so Wait()
+ * does not need to pass the whole list, and it returns only the
+ * ready file descriptors.
+ *
+ * The registration is level-triggered, like poll(): an event handler
+ * may read only a part of the available data and will be invoked
+ * again.
+ *
+ * It is not thread safe.
+ */
+class EPoll {
+  static constexpr unsigned MAX_EVENTS = 16;
+
+  int fd;
+
+  struct epoll_event events[MAX_EVENTS];
+
+  /**
+   * The number of valid items in #events after Wait().
+   */
+  unsigned n_events;
+
+public:
+  /**
+   * Mask bit for "file is ready for reading".
+   */
+  static constexpr unsigned READ = EPOLLIN;
+
+  /**
+   * Mask bit for "file is ready for writing".
+   */
+  static constexpr unsigned WRITE = EPOLLOUT;
+
+  static_assert(EPOLLIN == POLLIN && EPOLLOUT == POLLOUT &&
+                EPOLLERR == POLLERR && EPOLLHUP == POLLHUP,
+                "epoll and poll masks differ");
+
+  /**
+   * Create the epoll file descriptor.  epoll_create1() and
+   * EPOLL_CLOEXEC are not available in older Android NDKs, therefore
+   * the close-on-exec flag is set with fcntl().  Check IsDefined()
+   * before using the object.
+   */
+  EPoll():fd(epoll_create(MAX_EVENTS)), n_events(0) {
+    if (fd >= 0)
+      fcntl(fd, F_SETFD, FD_CLOEXEC);
+  }
+
+  ~EPoll() {
+    if (fd >= 0)
+      close(fd);
+  }
+
+  EPoll(const EPoll &) = delete;
+  EPoll &operator=(const EPoll &) = delete;
+
+  /**
+   * Was the epoll file descriptor created successfully?
+   */
+  bool IsDefined() const {
+    return fd >= 0;
+  }
+
+  /**
+   * Register a file descriptor.
+   *
+   * @param mask the bit mask of interesting events; may be 0
+   */
+  void SetMask(int _fd, unsigned mask) {
+    assert(IsDefined());
+
+    if (mask == 0)
+      return Remove(_fd);
+
+    struct epoll_event e;
+    e.events = mask;
+    e.data.fd = _fd;
+
+    if (epoll_ctl(fd, EPOLL_CTL_MOD, _fd, &e) < 0 && errno == ENOENT)
+      epoll_ctl(fd, EPOLL_CTL_ADD, _fd, &e);
+  }
+
+  /**
+   * Unregister a file descriptor.  Errors are ignored, because the
+   * kernel has already removed it if it was closed.
+   */
+  void Remove(int _fd) {
+    assert(IsDefined());
+
+    epoll_ctl(fd, EPOLL_CTL_DEL, _fd, nullptr);
+
+    /* don't report stale events for it */
+    for (unsigned i = 0; i < n_events; ++i)
+      if (events[i].data.fd == _fd)
+        events[i].events = 0;
+  }
+
+  /**
+   * Wait for an event on any of the file descriptors.
+   *
+   * @param timeout_ms a timeout in milliseconds; the method will
+   * return successfully if the timeout has expired; -1 means no
+   * timeout (the default)
+   * @return false on error
+   */
+  bool Wait(int timeout_ms=-1) {
+    assert(IsDefined());
+
+    int n = epoll_wait(fd, events, MAX_EVENTS, timeout_ms);
+    if (n < 0) {
+      n_events = 0;
+      return errno == EINTR;
+    }
+
+    n_events = n;
+    return true;
+  }
+
+  /**
+   * This iterator class returns the integer file descriptors which
+   * had an event during the last Wait() call.
+   */
+  class const_iterator {
+    const struct epoll_event *i, *end;
+
+  public:
+    const_iterator(const struct epoll_event *begin,
+                   const struct epoll_event *_end)
+      :i(begin), end(_end) {
+      FindResult();
+    }
+
+    bool operator==(const const_iterator &other) const {
+      return i == other.i;
+    }
+
+    bool operator!=(const const_iterator &other) const {
+      return i != other.i;
+    }
+
+    const_iterator &operator++() {
+      ++i;
+      FindResult();
+      return *this;
+    }
+
+    int operator*() const {
+      return i->data.fd;
+    }
+
+    unsigned GetMask() const {
+      return i->events;
+    }
+
+  protected:
+    void FindResult() {
+      while (i != end && i->events == 0)
+        ++i;
+    }
+  };
+
+  gcc_pure
+  const_iterator begin() const {
+    return const_iterator(events, events + n_events);
+  }
+
+  gcc_pure
+  const_iterator end() const {
+    return const_iterator(events + n_events, events + n_events);
+  }
+};
+
+#endif
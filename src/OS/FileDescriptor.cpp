@@ -200,6 +200,14 @@ FileDescriptor::Rewind()
   return lseek(fd, 0, SEEK_SET) == 0;
 }
 
+bool
+FileDescriptor::Seek(off_t offset)
+{
+  assert(IsDefined());
+
+  return lseek(fd, offset, SEEK_SET) == offset;
+}
+
 off_t
 FileDescriptor::GetSize() const
 {
@@ -159,6 +159,12 @@ public:
    */
   bool Rewind();
 
+  /**
+   * Move the pointer to the specified position (relative to the
+   * beginning of the file).
+   */
+  bool Seek(off_t offset);
+
   /**
    * Returns the size of the file in bytes, or -1 on error.
    */
@@ -67,8 +67,10 @@ FileMapping::FileMapping(const TCHAR *path)
 
   m_data = mmap(NULL, m_size, PROT_READ, MAP_SHARED, fd, 0);
   close(fd);
-  if (m_data == NULL)
+  if (m_data == MAP_FAILED) {
+    m_data = NULL;
     return;
+  }
 
   madvise(m_data, m_size, MADV_WILLNEED);
 #else /* !HAVE_POSIX */
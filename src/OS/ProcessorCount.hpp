@@ -0,0 +1,54 @@
+/*
+Copyright_License {
+
+  XCSoar Glide Computer - http://www.xcsoar.org/
+  Copyright (C) 2000-2014 The XCSoar Project
+  A detailed list of copyright holders can be found in the file "AUTHORS".
+
+  This program is free software; you can redistribute it and/or
+  modify it under the terms of the GNU General Public License
+  as published by the Free Software Foundation; either version 2
+  of the License, or (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+}
+*/
+
+#ifndef XCSOAR_OS_PROCESSOR_COUNT_HPP
+#define XCSOAR_OS_PROCESSOR_COUNT_HPP
+
+#ifdef HAVE_POSIX
+#include <unistd.h>
+#else
+#include <windows.h>
+#endif
+
+/**
+ * Determine the number of processors which are currently online.
+ * Returns 1 if that is unknown.
+ */
+static inline unsigned
+GetProcessorCount()
+{
+#ifdef HAVE_POSIX
+#ifdef _SC_NPROCESSORS_ONLN
+  const long n = sysconf(_SC_NPROCESSORS_ONLN);
+  return n > 0 ? n : 1;
+#else
+  return 1;
+#endif
+#else
+  SYSTEM_INFO info;
+  GetSystemInfo(&info);
+  return info.dwNumberOfProcessors > 0 ? info.dwNumberOfProcessors : 1;
+#endif
+}
+
+#endif
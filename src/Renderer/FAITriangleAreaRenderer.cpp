@@ -23,10 +23,97 @@ Copyright_License {
 
 #include "FAITriangleAreaRenderer.hpp"
 #include "Engine/Task/Shapes/FAITriangleArea.hpp"
+#include "Engine/Task/Shapes/FAITriangleSettings.hpp"
 #include "Geo/GeoPoint.hpp"
 #include "Geo/GeoClip.hpp"
 #include "Projection/WindowProjection.hpp"
 #include "Screen/Canvas.hpp"
+#include "Util/Cache.hpp"
+
+#ifndef ENABLE_OPENGL
+#include "Thread/Mutex.hpp"
+#endif
+
+#include <algorithm>
+
+/**
+ * Identifies one FAI triangle sector polygon.  Generating the polygon
+ * is expensive (trigonometry for each vertex), but the input rarely
+ * changes from one frame to the next.
+ */
+struct FAITriangleAreaKey {
+  GeoPoint pt1, pt2;
+  bool reverse;
+  FAITriangleSettings::Threshold threshold;
+
+  bool operator==(const FAITriangleAreaKey &other) const {
+    return pt1 == other.pt1 && pt2 == other.pt2 &&
+      reverse == other.reverse && threshold == other.threshold;
+  }
+
+  struct Hash {
+    gcc_pure
+    static size_t HashAngle(Angle angle) {
+      return (size_t)(long)(angle.Degrees() * 1000000);
+    }
+
+    gcc_pure
+    size_t operator()(const FAITriangleAreaKey &key) const {
+      return HashAngle(key.pt1.latitude) ^ (HashAngle(key.pt1.longitude) << 1) ^
+        (HashAngle(key.pt2.latitude) << 2) ^ (HashAngle(key.pt2.longitude) << 3) ^
+        (size_t)key.reverse ^ ((size_t)key.threshold << 1);
+    }
+  };
+};
+
+struct FAITriangleArea {
+  unsigned n;
+  GeoPoint points[FAI_TRIANGLE_SECTOR_MAX];
+};
+
+#ifndef ENABLE_OPENGL
+/**
+ * Without OpenGL, this function is called from DrawThread and UI
+ * thread, therefore we need to protect the cache.
+ */
+static Mutex fai_area_cache_mutex;
+#endif
+
+/**
+ * The task editor draws two sectors per leg (up to six), the map
+ * draws two more for the contest.  A task point being moved only
+ * invalidates the sectors of the two adjacent legs.
+ */
+static Cache<FAITriangleAreaKey, FAITriangleArea, 8u,
+             FAITriangleAreaKey::Hash> fai_area_cache;
+
+/**
+ * Look up the sector polygon in the cache, generate it on a miss.
+ *
+ * @return a pointer after the last generated item
+ */
+static GeoPoint *
+GetFAITriangleArea(GeoPoint *dest,
+                   const GeoPoint &pt1, const GeoPoint &pt2,
+                   bool reverse, const FAITriangleSettings &settings)
+{
+  const FAITriangleAreaKey key{pt1, pt2, reverse, settings.threshold};
+
+#ifndef ENABLE_OPENGL
+  const ScopeLock protect(fai_area_cache_mutex);
+#endif
+
+  const FAITriangleArea *cached = fai_area_cache.Get(key);
+  if (cached != nullptr)
+    return std::copy_n(cached->points, cached->n, dest);
+
+  FAITriangleArea area;
+  area.n = GenerateFAITriangleArea(area.points, pt1, pt2,
+                                   reverse, settings) - area.points;
+  fai_area_cache.Put(key, area);
+
+  return std::copy_n(area.points, area.n, dest);
+}
 
 void
 RenderFAISector(Canvas &canvas, const WindowProjection &projection,
@@ -34,8 +121,8 @@ RenderFAISector(Canvas &canvas, const WindowProjection &projection,
                 bool reverse, const FAITriangleSettings &settings)
 {
   GeoPoint geo_points[FAI_TRIANGLE_SECTOR_MAX];
-  GeoPoint *geo_end = GenerateFAITriangleArea(geo_points, pt1, pt2,
-                                              reverse, settings);
+  GeoPoint *geo_end = GetFAITriangleArea(geo_points, pt1, pt2,
+                                         reverse, settings);
 
   GeoPoint clipped[FAI_TRIANGLE_SECTOR_MAX * 3],
     *clipped_end = clipped +
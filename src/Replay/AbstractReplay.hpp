@@ -24,6 +24,8 @@ Copyright_License {
 #ifndef ABSTRACT_REPLAY_HPP
 #define ABSTRACT_REPLAY_HPP
 
+#include "Math/fixed.hpp"
+
 struct NMEAInfo;
 
 class AbstractReplay 
@@ -32,6 +34,18 @@ public:
   virtual ~AbstractReplay() {}
 
   virtual bool Update(NMEAInfo &data) = 0;
+
+  /**
+   * Continue replaying at the first fix at or after the specified
+   * time (the clock of the fixes returned by Update()).  The next
+   * Update() call returns that fix.
+   *
+   * @return false if seeking is not supported by this replay, or if
+   * there is no such fix
+   */
+  virtual bool Seek(fixed time) {
+    return false;
+  }
 };
 
 #endif
@@ -0,0 +1,146 @@
+/*
+Copyright_License {
+
+  XCSoar Glide Computer - http://www.xcsoar.org/
+  Copyright (C) 2000-2014 The XCSoar Project
+  A detailed list of copyright holders can be found in the file "AUTHORS".
+
+  This program is free software; you can redistribute it and/or
+  modify it under the terms of the GNU General Public License
+  as published by the Free Software Foundation; either version 2
+  of the License, or (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+}
+*/
+
+#include "FastReplay.hpp"
+#include "AbstractReplay.hpp"
+#include "IO/LineReader.hpp"
+#include "Computer/GlideComputer.hpp"
+#include "Operation/Operation.hpp"
+#include "Time/PeriodClock.hpp"
+
+/**
+ * The range of the progress bar.
+ */
+static constexpr unsigned PROGRESS_RANGE = 1000;
+
+FastReplay::FastReplay(AbstractReplay &_replay, const NLineReader *_reader,
+                       NMEAInfo &_data,
+                       GlideComputer &_glide_computer,
+                       const ComputerSettings &_settings,
+                       fixed _end_time, unsigned _frame_interval)
+  :replay(_replay), reader(_reader), data(_data),
+   glide_computer(_glide_computer), settings(_settings),
+   end_time(_end_time), frame_interval(_frame_interval),
+   n_fixes(0), duration_ms(0), eof(false)
+{
+  basic.Reset();
+  last_any.Reset();
+  last_fix.Reset();
+}
+
+unsigned
+FastReplay::GetFixesPerSecond() const
+{
+  return duration_ms > 0
+    ? unsigned(uint64_t(n_fixes) * 1000 / duration_ms)
+    : n_fixes;
+}
+
+const DerivedInfo &
+FastReplay::GetCalculated() const
+{
+  return glide_computer.Calculated();
+}
+
+inline void
+FastReplay::Process()
+{
+  /* this is what MergeThread::Process() and
+     CalculationThread::Tick() do, minus the blackboards */
+
+  basic.Reset();
+  (NMEAInfo &)basic = data;
+
+  computer.Fill(basic, settings);
+  computer.Compute(basic, last_any, last_fix, glide_computer.Calculated());
+
+  glide_computer.ReadBlackboard(basic);
+  glide_computer.Expire();
+  if (glide_computer.ProcessGPS())
+    glide_computer.ProcessIdle();
+
+  /* same as in MergeThread::Tick() */
+  last_any = basic;
+  if ((basic.time_available &&
+       (!last_fix.time_available || basic.time != last_fix.time)) ||
+      basic.location_available != last_fix.location_available)
+    last_fix = basic;
+
+  ++n_fixes;
+}
+
+void
+FastReplay::UpdateProgress(OperationEnvironment &env)
+{
+  const long size = reader != nullptr ? reader->GetSize() : -1;
+  const long position = reader != nullptr ? reader->Tell() : -1;
+  if (size > 0 && position >= 0)
+    env.SetProgressPosition(unsigned(uint64_t(position) * PROGRESS_RANGE
+                                     / size));
+}
+
+void
+FastReplay::Run(OperationEnvironment &env)
+{
+  PeriodClock clock, frame_clock;
+  clock.Update();
+  frame_clock.Update();
+
+  n_fixes = 0;
+  eof = false;
+
+  if (reader != nullptr && reader->GetSize() > 0) {
+    env.SetProgressRange(PROGRESS_RANGE);
+    UpdateProgress(env);
+  }
+
+  while (true) {
+    if (data.time_available) {
+      if (!negative(end_time) && data.time >= end_time)
+        break;
+
+      Process();
+
+      /* don't query the clock for every fix */
+      if ((n_fixes & 0x3f) == 0 && frame_clock.Check(frame_interval)) {
+        frame_clock.Update();
+
+        if (env.IsCancelled())
+          break;
+
+        UpdateProgress(env);
+        OnFrame();
+      }
+    }
+
+    if (!replay.Update(data)) {
+      eof = true;
+      break;
+    }
+  }
+
+  duration_ms = clock.Elapsed();
+
+  UpdateProgress(env);
+  OnFrame();
+}
@@ -0,0 +1,160 @@
+/*
+Copyright_License {
+
+  XCSoar Glide Computer - http://www.xcsoar.org/
+  Copyright (C) 2000-2014 The XCSoar Project
+  A detailed list of copyright holders can be found in the file "AUTHORS".
+
+  This program is free software; you can redistribute it and/or
+  modify it under the terms of the GNU General Public License
+  as published by the Free Software Foundation; either version 2
+  of the License, or (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+}
+*/
+
+#ifndef XCSOAR_FAST_REPLAY_HPP
+#define XCSOAR_FAST_REPLAY_HPP
+
+#include "Job/Job.hpp"
+#include "Computer/BasicComputer.hpp"
+#include "Computer/Settings.hpp"
+#include "NMEA/MoreData.hpp"
+#include "Math/fixed.hpp"
+#include "Compiler.h"
+
+class AbstractReplay;
+class NLineReader;
+class GlideComputer;
+struct NMEAInfo;
+struct DerivedInfo;
+
+/**
+ * Feeds the fixes of an #AbstractReplay into a #GlideComputer as
+ * quickly as the computer can consume them.  Unlike the regular
+ * replay, this bypasses the #DeviceBlackboard, the MergeThread and
+ * the CalculationThread, which are paced by the wall clock; the
+ * caller must make sure that nobody else uses the #GlideComputer
+ * meanwhile.
+ *
+ * Every fix is processed (no coalescing), so the flight statistics
+ * and the contest optimiser see the whole flight.  Rendering is up to
+ * the caller: OnFrame() is invoked periodically and may publish the
+ * current state.
+ */
+class FastReplay : public Job {
+  AbstractReplay &replay;
+
+  /**
+   * The file being replayed; used for the progress bar.  May be
+   * nullptr.
+   */
+  const NLineReader *reader;
+
+  /**
+   * The current fix, owned by the caller, because #AbstractReplay
+   * implementations accumulate into it.  Before Run(), this may
+   * contain a pending fix (if #NMEAInfo::time_available is set),
+   * which is processed first; afterwards, it contains the first fix
+   * which was not processed.
+   */
+  NMEAInfo &data;
+
+  GlideComputer &glide_computer;
+
+  const ComputerSettings settings;
+
+  /**
+   * Stop before the first fix at or after this time of day.  If
+   * negative, replay until the end of the file.
+   */
+  const fixed end_time;
+
+  /**
+   * Wall-clock interval between two OnFrame() calls [ms].
+   */
+  const unsigned frame_interval;
+
+  BasicComputer computer;
+
+  MoreData basic, last_any, last_fix;
+
+  unsigned n_fixes;
+
+  unsigned duration_ms;
+
+  bool eof;
+
+public:
+  FastReplay(AbstractReplay &_replay, const NLineReader *_reader,
+             NMEAInfo &_data,
+             GlideComputer &_glide_computer,
+             const ComputerSettings &_settings,
+             fixed _end_time, unsigned _frame_interval=500);
+
+  /**
+   * The number of fixes passed to GlideComputer::ProcessGPS().
+   */
+  unsigned GetFixCount() const {
+    return n_fixes;
+  }
+
+  /**
+   * The wall-clock duration of the last Run() call [ms].
+   */
+  unsigned GetDuration() const {
+    return duration_ms;
+  }
+
+  /**
+   * The throughput of the last Run() call [fixes per second].
+   */
+  gcc_pure
+  unsigned GetFixesPerSecond() const;
+
+  /**
+   * Has the end of the file been reached?
+   */
+  bool IsEOF() const {
+    return eof;
+  }
+
+  /**
+   * The last fix which was processed, with #BasicComputer values.
+   */
+  const MoreData &GetBasic() const {
+    return basic;
+  }
+
+  /**
+   * The results of the #GlideComputer.
+   */
+  gcc_pure
+  const DerivedInfo &GetCalculated() const;
+
+protected:
+  /**
+   * Called periodically from within Run(), after a fix has been
+   * processed.  May be used to publish the current state.
+   */
+  virtual void OnFrame() {}
+
+private:
+  void Process();
+
+  void UpdateProgress(OperationEnvironment &env);
+
+public:
+  /* virtual methods from class Job */
+  virtual void Run(OperationEnvironment &env) override;
+};
+
+#endif
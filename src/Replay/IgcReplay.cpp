@@ -24,13 +24,22 @@
 #include "Replay/IgcReplay.hpp"
 #include "IGC/IGCParser.hpp"
 #include "IGC/IGCFix.hpp"
-#include "IO/LineReader.hpp"
+#include "IO/FileLineReader.hpp"
 #include "NMEA/Info.hpp"
 #include "Units/System.hpp"
 
+#include <assert.h>
+
 IgcReplay::IgcReplay(NLineReader *_reader)
   :AbstractReplay(),
-   reader(_reader)
+   reader(_reader), seekable(nullptr), indexed(false)
+{
+  extensions.clear();
+}
+
+IgcReplay::IgcReplay(FileLineReaderA *_reader)
+  :AbstractReplay(),
+   reader(_reader), seekable(_reader), indexed(false)
 {
   extensions.clear();
 }
@@ -68,6 +77,49 @@ IgcReplay::ReadPoint(IGCFix &fix, NMEAInfo &basic)
   return false;
 }
 
+bool
+IgcReplay::BuildIndex()
+{
+  assert(seekable != nullptr);
+
+  const long position = seekable->Tell();
+
+  bool success = seekable->Rewind() && index.Build(*seekable);
+  if (!seekable->Seek(position))
+    success = false;
+
+  indexed = true;
+  return success;
+}
+
+bool
+IgcReplay::Seek(fixed time)
+{
+  if (seekable == nullptr)
+    return false;
+
+  if (!indexed)
+    BuildIndex();
+
+  if (index.empty())
+    return false;
+
+  unsigned t = positive(time) ? (unsigned)time : 0u;
+
+  /* the clock of the fixes wraps at midnight; map the time to the
+     second day if the flight crosses midnight */
+  constexpr unsigned DAY = 24 * 3600;
+  if (t < index.GetStartTime() && t + DAY <= index.GetEndTime())
+    t += DAY;
+
+  const unsigned i = index.Find(t);
+  if (i >= index.size() || !seekable->Seek(index[i].offset))
+    return false;
+
+  extensions = index.GetExtensions();
+  return true;
+}
+
 bool
 IgcReplay::Update(NMEAInfo &basic)
 {
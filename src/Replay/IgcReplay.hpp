@@ -26,22 +26,43 @@ Copyright_License {
 
 #include "AbstractReplay.hpp"
 #include "IGC/IGCExtensions.hpp"
+#include "IGC/IGCIndex.hpp"
 #include "Compiler.h"
 
 class NLineReader;
+class FileLineReaderA;
 struct IGCFix;
 
 class IgcReplay: public AbstractReplay
 {
   NLineReader *reader;
 
+  /**
+   * The same object as #reader if it supports seeking, nullptr
+   * otherwise.
+   */
+  FileLineReaderA *seekable;
+
   IGCExtensions extensions;
 
+  /**
+   * The time index of the file, built by the first Seek() call.
+   */
+  IGCIndex index;
+
+  bool indexed;
+
 public:
+  /**
+   * Construct a replay which cannot Seek().
+   */
   IgcReplay(NLineReader *reader);
+
+  IgcReplay(FileLineReaderA *reader);
   virtual ~IgcReplay();
 
   virtual bool Update(NMEAInfo &data) override;
+  virtual bool Seek(fixed time) override;
 
 private:
   /**
@@ -57,6 +78,11 @@ private:
    * @return false on end-of-file
    */
   bool ReadPoint(IGCFix &fix, NMEAInfo &basic);
+
+  /**
+   * Build the time index, and restore the reader position afterwards.
+   */
+  bool BuildIndex();
 };
 
 #endif
@@ -25,6 +25,7 @@
 #include "IgcReplay.hpp"
 #include "NmeaReplay.hpp"
 #include "DemoReplayGlue.hpp"
+#include "FastReplay.hpp"
 #include "Util/StringUtil.hpp"
 #include "Util/Clamp.hpp"
 #include "OS/PathName.hpp"
@@ -33,6 +34,11 @@
 #include "Logger/Logger.hpp"
 #include "Components.hpp"
 #include "Interface.hpp"
+#include "CalculationThread.hpp"
+#include "Protection.hpp"
+#include "Computer/GlideComputer.hpp"
+#include "Job/Runner.hpp"
+#include "LogFile.hpp"
 #include "CatmullRomInterpolator.hpp"
 
 #include <assert.h>
@@ -47,6 +53,7 @@ Replay::Stop()
 
   delete replay;
   replay = NULL;
+  reader = nullptr;
 
   delete cli;
   cli = nullptr;
@@ -78,6 +85,7 @@ Replay::Start(const TCHAR *_path)
     }
 
     replay = new IgcReplay(reader);
+    this->reader = reader;
 
     cli = new CatmullRomInterpolator(fixed(0.98));
     cli->Reset();
@@ -90,13 +98,13 @@ Replay::Start(const TCHAR *_path)
 
     replay = new NmeaReplay(reader,
                             CommonInterface::GetSystemSettings().devices[0]);
+    this->reader = reader;
   }
 
   if (logger != NULL)
     logger->ClearBuffer();
 
   virtual_time = fixed(-1);
-  fast_forward = fixed(-1);
   next_data.Reset();
 
   Timer::Schedule(100);
@@ -119,22 +127,14 @@ Replay::Update()
     /* update the virtual time */
     assert(clock.IsDefined());
 
-    if (negative(fast_forward)) {
-      virtual_time += clock.ElapsedUpdate() * time_scale / 1000;
-    } else {
-      clock.Update();
-
-      virtual_time += fixed(1);
-      if (virtual_time >= fast_forward)
-        fast_forward = fixed(-1);
-    }
+    virtual_time += clock.ElapsedUpdate() * time_scale / 1000;
   } else {
     /* if we ever received a valid time from the AbstractReplay, then
        virtual_time must be initialised */
     assert(!next_data.time_available);
   }
 
-  if (cli == nullptr || !negative(fast_forward)) {
+  if (cli == nullptr) {
     if (next_data.time_available && virtual_time < next_data.time)
       /* still not time to use next_data */
       return true;
@@ -219,6 +219,107 @@ Replay::Update()
   return true;
 }
 
+/**
+ * Publishes the state of the #GlideComputer now and then while
+ * fast-forwarding, to let the map follow the flight.
+ */
+class ReplayFastForward final : public FastReplay {
+public:
+  ReplayFastForward(AbstractReplay &_replay, const NLineReader *_reader,
+                    NMEAInfo &_data, GlideComputer &_glide_computer,
+                    const ComputerSettings &_settings, fixed _end_time)
+    :FastReplay(_replay, _reader, _data, _glide_computer, _settings,
+                _end_time) {}
+
+protected:
+  virtual void OnFrame() override {
+    {
+      ScopeLock protect(device_blackboard->mutex);
+      device_blackboard->SetReplayState() = GetBasic();
+      device_blackboard->ReadBlackboard(GetCalculated());
+      device_blackboard->ScheduleMerge();
+    }
+
+    TriggerCalculatedUpdate();
+  }
+};
+
+bool
+Replay::FastForward(fixed delta_s, JobRunner &runner,
+                    unsigned &fixes_per_second_r)
+{
+  if (!IsActive() || negative(virtual_time) ||
+      glide_computer == nullptr || calculation_thread == nullptr)
+    return false;
+
+  if (negative(delta_s) && reader == nullptr)
+    /* the demo never ends */
+    return false;
+
+  const fixed end_time = negative(delta_s)
+    ? fixed(-1)
+    : virtual_time + delta_s;
+
+  Timer::Cancel();
+
+  /* the GlideComputer belongs to the job now */
+  calculation_thread->Suspend();
+
+  ReplayFastForward job(*replay, reader, next_data, *glide_computer,
+                        CommonInterface::GetComputerSettings(), end_time);
+  runner.Run(job);
+
+  calculation_thread->Resume();
+
+  fixes_per_second_r = job.GetFixesPerSecond();
+  LogFormat("Replay fast-forward: %u fixes in %u ms (%u fixes/s)",
+            job.GetFixCount(), job.GetDuration(), fixes_per_second_r);
+
+  if (job.IsEOF()) {
+    Stop();
+    return true;
+  }
+
+  /* continue the regular replay with the first fix which was not
+     processed */
+  ContinueAtNextData();
+  return true;
+}
+
+bool
+Replay::Seek(fixed time)
+{
+  if (!IsActive() || negative(virtual_time) || !replay->Seek(time))
+    return false;
+
+  if (!replay->Update(next_data)) {
+    Stop();
+    return false;
+  }
+
+  ContinueAtNextData();
+  return true;
+}
+
+void
+Replay::ContinueAtNextData()
+{
+  if (next_data.time_available)
+    virtual_time = next_data.time;
+  clock.Update();
+
+  if (cli != nullptr) {
+    cli->Reset();
+
+    if (next_data.time_available)
+      cli->Update(next_data.time, next_data.location,
+                  next_data.gps_altitude,
+                  next_data.pressure_altitude);
+  }
+
+  Timer::Schedule(100);
+}
+
 void
 Replay::OnTimer()
 {
@@ -228,8 +329,6 @@ Replay::OnTimer()
   unsigned schedule;
   if (!positive(time_scale))
     schedule = 1000;
-  else if (!negative(fast_forward))
-    schedule = 100;
   else if (negative(virtual_time) || !next_data.time_available)
     schedule = 500;
   else if (cli != nullptr)
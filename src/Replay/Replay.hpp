@@ -36,6 +36,8 @@ class Logger;
 class ProtectedTaskManager;
 class AbstractReplay;
 class CatmullRomInterpolator;
+class NLineReader;
+class JobRunner;
 
 class Replay final
   : private Timer
@@ -44,6 +46,11 @@ class Replay final
 
   AbstractReplay *replay;
 
+  /**
+   * The file being replayed (owned by #replay); nullptr for the demo.
+   */
+  const NLineReader *reader;
+
   Logger *logger;
   ProtectedTaskManager &task_manager;
 
@@ -55,12 +62,6 @@ class Replay final
    */
   fixed virtual_time;
 
-  /**
-   * If this value is not negative, then we're in fast-forward mode:
-   * replay is going as quickly as possible
-   */
-  fixed fast_forward;
-
   /**
    * Keeps track of the wall-clock time between two Update() calls.
    */
@@ -76,7 +77,7 @@ class Replay final
 
 public:
   Replay(Logger *_logger, ProtectedTaskManager &_task_manager)
-    :time_scale(fixed(1)), replay(nullptr),
+    :time_scale(fixed(1)), replay(nullptr), reader(nullptr),
      logger(_logger), task_manager(_task_manager), cli(nullptr) {
     path[0] = _T('\0');
   }
@@ -109,16 +110,45 @@ public:
   }
 
   /**
-   * Start fast-forwarding the replay by the specified number of
-   * seconds.  This replays the given amount of time from the input
-   * time as quickly as possible.
+   * Fast-forward the replay by the specified number of seconds: the
+   * fixes are passed directly to the #GlideComputer as quickly as it
+   * can consume them (see #FastReplay), while the CalculationThread
+   * is suspended.  The map is redrawn only now and then.  Must be
+   * called from the main thread.
+   *
+   * @param delta_s the amount of input time to be replayed; negative
+   * means until the end of the file (which stops the replay)
+   * @param runner runs the job, e.g. with a progress dialog
+   * @param fixes_per_second_r on success, receives the throughput
+   * @return false if fast-forwarding is not possible
    */
-  void FastForward(fixed delta_s) {
-    if (IsActive() && !negative(virtual_time))
-      fast_forward = virtual_time + delta_s;
+  bool FastForward(fixed delta_s, JobRunner &runner,
+                   unsigned &fixes_per_second_r);
+
+  /**
+   * The time of day according to replay input, or a negative value
+   * if unknown.
+   */
+  fixed GetVirtualTime() const {
+    return virtual_time;
   }
 
+  /**
+   * Jump to the first fix at or after the specified time of day.
+   * This is supported only by IGC replays.  Must be called from the
+   * main thread.
+   *
+   * @return false if seeking is not possible
+   */
+  bool Seek(fixed time);
+
 private:
+  /**
+   * Continue the regular replay with #next_data after the input was
+   * repositioned.
+   */
+  void ContinueAtNextData();
+
   virtual void OnTimer() override;
 };
 
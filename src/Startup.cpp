@@ -347,7 +347,7 @@ Startup()
   LoadConfiguredTopography(*topography, operation);
 
   // Read the waypoint files
-  WaypointGlue::LoadWaypoints(way_points, terrain, operation);
+  WaypointGlue::LoadWaypoints(way_points, terrain, file_cache, operation);
 
   // Read and parse the airfield info file
   WaypointDetails::ReadFileFromProfile(way_points, operation);
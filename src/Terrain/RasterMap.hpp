@@ -58,6 +58,14 @@ public:
     return GetBounds().IsInside(pt);
   }
 
+  /**
+   * Returns the path of the terrain file which was passed to the
+   * constructor, converted to the ANSI code page.
+   */
+  const char *GetPath() const {
+    return path;
+  }
+
   gcc_pure
   GeoPoint GetMapCenter() const {
     return GetBounds().GetCenter();
@@ -65,6 +65,14 @@ public:
     return map.GetSerial();
   }
 
+  /**
+   * Returns the path of the terrain file.  It does not change after
+   * construction, therefore no lease is needed.
+   */
+  const char *GetPath() const {
+    return map.GetPath();
+  }
+
 /** 
  * Load the terrain.  Determines the file to load from profile settings.
  * 
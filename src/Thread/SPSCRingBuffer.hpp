@@ -0,0 +1,128 @@
+/*
+Copyright_License {
+
+  XCSoar Glide Computer - http://www.xcsoar.org/
+  Copyright (C) 2000-2014 The XCSoar Project
+  A detailed list of copyright holders can be found in the file "AUTHORS".
+
+  This program is free software; you can redistribute it and/or
+  modify it under the terms of the GNU General Public License
+  as published by the Free Software Foundation; either version 2
+  of the License, or (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+}
+*/
+
+#ifndef XCSOAR_THREAD_SPSC_RING_BUFFER_HPP
+#define XCSOAR_THREAD_SPSC_RING_BUFFER_HPP
+
+#include <atomic>
+#include <type_traits>
+
+#include <assert.h>
+
+/**
+ * A fixed-size ring buffer which transfers values from one producer
+ * thread to one consumer thread without locking.  It stores up to
+ * "size-1" items (for the full/empty distinction).  When it is full,
+ * push() fails; the producer must not overwrite items the consumer
+ * may be reading.
+ */
+template<class T, unsigned size>
+class SPSCRingBuffer {
+  static_assert(std::is_trivial<T>::value, "type is not trivial");
+  static_assert(size >= 2, "buffer too small");
+
+  T data[size];
+
+  /**
+   * The index of the oldest item; modified only by the consumer.
+   */
+  std::atomic<unsigned> head;
+
+  /**
+   * The index after the newest item; modified only by the producer.
+   */
+  std::atomic<unsigned> tail;
+
+  /**
+   * The number of items rejected by push() because the buffer was
+   * full; modified only by the producer.
+   */
+  std::atomic<unsigned> n_dropped;
+
+  static constexpr unsigned next(unsigned i) {
+    return (i + 1) % size;
+  }
+
+public:
+  SPSCRingBuffer():head(0), tail(0), n_dropped(0) {}
+
+  SPSCRingBuffer(const SPSCRingBuffer &) = delete;
+  SPSCRingBuffer &operator=(const SPSCRingBuffer &) = delete;
+
+  /**
+   * May be called by either thread, but the result may be outdated
+   * immediately.
+   */
+  bool empty() const {
+    return head.load(std::memory_order_relaxed) ==
+      tail.load(std::memory_order_relaxed);
+  }
+
+  unsigned GetDropCount() const {
+    return n_dropped.load(std::memory_order_relaxed);
+  }
+
+  /**
+   * Append an item.  Must be called only by the producer.
+   *
+   * @return false if the buffer is full and the item was discarded
+   */
+  bool push(const T &value) {
+    const unsigned t = tail.load(std::memory_order_relaxed);
+    assert(t < size);
+
+    const unsigned n = next(t);
+    if (n == head.load(std::memory_order_acquire)) {
+      n_dropped.store(n_dropped.load(std::memory_order_relaxed) + 1,
+                      std::memory_order_relaxed);
+      return false;
+    }
+
+    data[t] = value;
+    tail.store(n, std::memory_order_release);
+    return true;
+  }
+
+  /**
+   * Remove the oldest item.  Must be called only by the consumer.
+   *
+   * @return false if the buffer is empty
+   */
+  bool shift(T &value) {
+    const unsigned h = head.load(std::memory_order_relaxed);
+    assert(h < size);
+
+    if (h == tail.load(std::memory_order_acquire))
+      return false;
+
+    value = data[h];
+    head.store(next(h), std::memory_order_release);
+    return true;
+  }
+
+  unsigned capacity() const {
+    return size - 1;
+  }
+};
+
+#endif
@@ -0,0 +1,118 @@
+/*
+Copyright_License {
+
+  XCSoar Glide Computer - http://www.xcsoar.org/
+  Copyright (C) 2000-2014 The XCSoar Project
+  A detailed list of copyright holders can be found in the file "AUTHORS".
+
+  This program is free software; you can redistribute it and/or
+  modify it under the terms of the GNU General Public License
+  as published by the Free Software Foundation; either version 2
+  of the License, or (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+}
+*/
+
+#ifndef XCSOAR_THREAD_SEQ_LOCK_HPP
+#define XCSOAR_THREAD_SEQ_LOCK_HPP
+
+#include <atomic>
+#include <type_traits>
+
+#include <string.h>
+
+#ifdef HAVE_POSIX
+#include <sched.h>
+#elif defined(WIN32)
+#include <windows.h>
+#endif
+
+/**
+ * A copy of a value which can be read by any number of threads
+ * without locking.  The value gets replaced with Write(); writers
+ * must be serialised by the caller (e.g. by holding a #Mutex), but
+ * they never wait for readers.  A reader which overlaps with a writer
+ * copies the value again.
+ *
+ * Only trivial types are allowed, because a reader may copy a
+ * half-written value (which gets discarded).
+ */
+template<typename T>
+class SeqLock {
+  static_assert(std::is_trivial<T>::value, "type is not trivial");
+
+  /**
+   * Odd while a Write() is in progress.
+   */
+  std::atomic<unsigned> sequence;
+
+  T value;
+
+  /**
+   * Statistics: the number of times a reader had to start over
+   * because of a concurrent Write().  It is only modified on that
+   * (rare) path, so uncontended readers never write to shared
+   * memory.
+   */
+  mutable std::atomic<unsigned> n_retries;
+
+public:
+  SeqLock():sequence(0), n_retries(0) {}
+
+  SeqLock(const SeqLock &) = delete;
+  SeqLock &operator=(const SeqLock &) = delete;
+
+  /**
+   * Returns a number which is incremented by each Write().
+   */
+  unsigned GetVersion() const {
+    return sequence.load(std::memory_order_acquire) / 2;
+  }
+
+  void Write(const T &src) {
+    const unsigned s = sequence.load(std::memory_order_relaxed);
+    sequence.store(s + 1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+
+    memcpy((void *)&value, (const void *)&src, sizeof(value));
+
+    sequence.store(s + 2, std::memory_order_release);
+  }
+
+  void Read(T &dest) const {
+    while (true) {
+      const unsigned s = sequence.load(std::memory_order_acquire);
+      if ((s & 1) == 0) {
+        memcpy((void *)&dest, (const void *)&value, sizeof(value));
+
+        std::atomic_thread_fence(std::memory_order_acquire);
+        if (sequence.load(std::memory_order_relaxed) == s)
+          return;
+      }
+
+      n_retries.fetch_add(1, std::memory_order_relaxed);
+
+      /* let the writer finish; this matters on single-core
+         machines */
+#ifdef HAVE_POSIX
+      sched_yield();
+#elif defined(WIN32)
+      Sleep(0);
+#endif
+    }
+  }
+
+  unsigned GetRetryCount() const {
+    return n_retries.load(std::memory_order_relaxed);
+  }
+};
+
+#endif
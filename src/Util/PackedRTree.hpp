@@ -0,0 +1,441 @@
+/*
+Copyright_License {
+
+  XCSoar Glide Computer - http://www.xcsoar.org/
+  Copyright (C) 2000-2014 The XCSoar Project
+  A detailed list of copyright holders can be found in the file "AUTHORS".
+
+  This program is free software; you can redistribute it and/or
+  modify it under the terms of the GNU General Public License
+  as published by the Free Software Foundation; either version 2
+  of the License, or (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+}
+*/
+
+#ifndef XCSOAR_PACKED_RTREE_HPP
+#define XCSOAR_PACKED_RTREE_HPP
+
+#include "Compiler.h"
+
+#include <vector>
+#include <algorithm>
+#include <limits>
+
+#include <assert.h>
+#include <stdint.h>
+
+/**
+ * A read-only R-tree of points which is built in one pass from a
+ * given set of objects.  The objects are sorted along a Hilbert curve
+ * and grouped into nodes of #NODE_SIZE, which keeps spatially close
+ * objects close in memory and makes all nodes of one level a
+ * contiguous array.
+ *
+ * The container stores pointers only; the caller is responsible for
+ * keeping the objects alive and unmodified until the next Build() or
+ * Clear() call.
+ *
+ * The coordinate and distance types are the same as in #QuadTree,
+ * which allows mixing both containers in one lookup.
+ */
+template<typename T, typename Accessor>
+class PackedRTree {
+public:
+  typedef int position_type;
+  typedef unsigned distance_type;
+
+  static constexpr unsigned NODE_SIZE = 16;
+
+  struct Point {
+    position_type x, y;
+
+    Point() = default;
+
+    constexpr
+    Point(position_type _x, position_type _y):x(_x), y(_y) {}
+
+    constexpr
+    distance_type SquareDistanceTo(const Point &other) const {
+      return Square(other.x - x) + Square(other.y - y);
+    }
+  };
+
+  struct Rectangle {
+    position_type left, top, right, bottom;
+
+    void Extend(const Point &p) {
+      left = std::min(left, p.x);
+      top = std::min(top, p.y);
+      right = std::max(right, p.x);
+      bottom = std::max(bottom, p.y);
+    }
+
+    void Extend(const Rectangle &r) {
+      left = std::min(left, r.left);
+      top = std::min(top, r.top);
+      right = std::max(right, r.right);
+      bottom = std::max(bottom, r.bottom);
+    }
+
+    /**
+     * Calculate the square distance from the specified point to the
+     * nearest point of this rectangle.
+     */
+    gcc_pure
+    distance_type SquareDistanceTo(const Point &p) const {
+      const position_type dx = p.x < left
+        ? left - p.x
+        : (p.x > right ? p.x - right : 0);
+      const position_type dy = p.y < top
+        ? top - p.y
+        : (p.y > bottom ? p.y - bottom : 0);
+      return Square(dx) + Square(dy);
+    }
+  };
+
+private:
+  Accessor accessor;
+
+  /**
+   * The positions of all objects in Hilbert order.
+   */
+  std::vector<Point> positions;
+
+  /**
+   * The objects, in the same order as #positions.
+   */
+  std::vector<const T *> items;
+
+  /**
+   * The bounding boxes of all nodes, the leaf level first and the
+   * root last.
+   */
+  std::vector<Rectangle> nodes;
+
+  /**
+   * The index of the first node of each level in #nodes, plus the
+   * total number of nodes at the end.
+   */
+  std::vector<unsigned> levels;
+
+  /**
+   * An entry of the best-first search queue.  Nodes are encoded as
+   * (index << 1 | 1), objects as (index << 1).
+   */
+  struct QueueItem {
+    distance_type square_distance;
+    unsigned index;
+
+    constexpr
+    QueueItem(distance_type _square_distance, unsigned _index)
+      :square_distance(_square_distance), index(_index) {}
+
+    constexpr
+    bool operator<(const QueueItem &other) const {
+      /* reversed for a min-heap */
+      return square_distance > other.square_distance;
+    }
+  };
+
+public:
+  constexpr
+  static distance_type Square(distance_type x) {
+    return x * x;
+  }
+
+  constexpr
+  static distance_type Square(position_type x) {
+    return x * x;
+  }
+
+  bool IsEmpty() const {
+    return items.empty();
+  }
+
+  unsigned size() const {
+    return items.size();
+  }
+
+  void Clear() {
+    positions.clear();
+    items.clear();
+    nodes.clear();
+    levels.clear();
+  }
+
+  /**
+   * Build the tree from the specified range of objects.  The
+   * previous contents are discarded.
+   */
+  template<typename I>
+  void Build(I begin, I end) {
+    Clear();
+
+    Rectangle bounds;
+    bool first = true;
+    for (I i = begin; i != end; ++i) {
+      const Point p = GetPosition(*i);
+      if (first) {
+        bounds.left = bounds.right = p.x;
+        bounds.top = bounds.bottom = p.y;
+        first = false;
+      } else
+        bounds.Extend(p);
+    }
+
+    if (first)
+      return;
+
+    std::vector<std::pair<uint32_t, const T *>> sorted;
+    for (I i = begin; i != end; ++i)
+      sorted.push_back(std::make_pair(GetHilbertIndex(GetPosition(*i), bounds),
+                                      &*i));
+
+    std::sort(sorted.begin(), sorted.end(),
+              [](const std::pair<uint32_t, const T *> &a,
+                 const std::pair<uint32_t, const T *> &b) {
+                return a.first < b.first;
+              });
+
+    positions.reserve(sorted.size());
+    items.reserve(sorted.size());
+    for (const auto &i : sorted) {
+      positions.push_back(GetPosition(*i.second));
+      items.push_back(i.second);
+    }
+
+    /* the leaf level groups the objects */
+    levels.push_back(0);
+    for (unsigned i = 0; i < positions.size(); i += NODE_SIZE) {
+      const unsigned n = std::min<unsigned>(positions.size(), i + NODE_SIZE);
+      Rectangle r;
+      r.left = r.right = positions[i].x;
+      r.top = r.bottom = positions[i].y;
+      for (unsigned j = i + 1; j < n; ++j)
+        r.Extend(positions[j]);
+      nodes.push_back(r);
+    }
+
+    /* each upper level groups the nodes of the level below, until
+       there is only one root node */
+    while (nodes.size() - levels.back() > 1) {
+      const unsigned begin_level = levels.back(), end_level = nodes.size();
+      levels.push_back(end_level);
+
+      for (unsigned i = begin_level; i < end_level; i += NODE_SIZE) {
+        const unsigned n = std::min(end_level, i + NODE_SIZE);
+        Rectangle r = nodes[i];
+        for (unsigned j = i + 1; j < n; ++j)
+          r.Extend(nodes[j]);
+        nodes.push_back(r);
+      }
+    }
+
+    levels.push_back(nodes.size());
+  }
+
+  /**
+   * Find the nearest object within the specified range which matches
+   * the predicate.
+   *
+   * @return the object (or nullptr if there is none) and its square
+   * distance
+   */
+  template<class P>
+  gcc_pure
+  std::pair<const T *, distance_type>
+  FindNearestIf(const Point location, distance_type range,
+                const P &predicate) const {
+    const T *result = nullptr;
+    distance_type square_distance = 0;
+    FindNearestIf(location, range, &result, &square_distance, 1, predicate);
+    return std::make_pair(result, square_distance);
+  }
+
+  /**
+   * Find up to #max objects within the specified range which match
+   * the predicate, sorted by increasing distance.
+   *
+   * @param square_distances an optional array receiving the square
+   * distances of the objects
+   * @return the number of objects written to #dest
+   */
+  template<class P>
+  unsigned FindNearestIf(const Point location, distance_type range,
+                         const T **dest, distance_type *square_distances,
+                         unsigned max, const P &predicate) const {
+    if (IsEmpty() || max == 0)
+      return 0;
+
+    const distance_type square_range = Square(range);
+
+    std::vector<QueueItem> queue;
+    queue.reserve(64);
+    queue.push_back(QueueItem(nodes.back().SquareDistanceTo(location),
+                              ((nodes.size() - 1) << 1) | 1));
+
+    unsigned n = 0;
+    while (!queue.empty()) {
+      const QueueItem current = queue.front();
+      if (current.square_distance > square_range)
+        /* everything else in the queue is even further away */
+        break;
+
+      std::pop_heap(queue.begin(), queue.end());
+      queue.pop_back();
+
+      if ((current.index & 1) == 0) {
+        /* the nearest remaining element is an object; nothing in the
+           queue can be closer */
+        const T &value = *items[current.index >> 1];
+        if (!predicate(value))
+          continue;
+
+        dest[n] = &value;
+        if (square_distances != nullptr)
+          square_distances[n] = current.square_distance;
+        if (++n == max)
+          break;
+
+        continue;
+      }
+
+      const unsigned node = current.index >> 1;
+      const unsigned level = GetLevel(node);
+      const unsigned child_begin = level == 0
+        ? 0
+        : levels[level - 1];
+      const unsigned child_end = level == 0
+        ? positions.size()
+        : levels[level];
+      const unsigned first = child_begin + (node - levels[level]) * NODE_SIZE;
+      const unsigned last = std::min(child_end, first + NODE_SIZE);
+
+      for (unsigned i = first; i < last; ++i) {
+        const QueueItem item = level == 0
+          ? QueueItem(positions[i].SquareDistanceTo(location), i << 1)
+          : QueueItem(nodes[i].SquareDistanceTo(location), (i << 1) | 1);
+        if (item.square_distance > square_range)
+          continue;
+
+        queue.push_back(item);
+        std::push_heap(queue.begin(), queue.end());
+      }
+    }
+
+    return n;
+  }
+
+  template<class P>
+  gcc_pure
+  std::pair<const T *, distance_type>
+  FindNearestIf(const T &value, distance_type range,
+                const P &predicate) const {
+    return FindNearestIf(GetPosition(value), range, predicate);
+  }
+
+  template<class P>
+  unsigned FindNearestIf(const T &value, distance_type range,
+                         const T **dest, distance_type *square_distances,
+                         unsigned max, const P &predicate) const {
+    return FindNearestIf(GetPosition(value), range,
+                         dest, square_distances, max, predicate);
+  }
+
+  /**
+   * Call the visitor for all objects within the specified range.
+   */
+  template<class V>
+  void VisitWithinRange(const Point location, distance_type range,
+                        V &visitor) const {
+    if (!IsEmpty())
+      VisitWithinRange(nodes.size() - 1, levels.size() - 2,
+                       location, Square(range), visitor);
+  }
+
+  template<class V>
+  void VisitWithinRange(const T &value, distance_type range,
+                        V &visitor) const {
+    VisitWithinRange(GetPosition(value), range, visitor);
+  }
+
+private:
+  Point GetPosition(const T &value) const {
+    return Point(accessor.GetX(value), accessor.GetY(value));
+  }
+
+  gcc_pure
+  unsigned GetLevel(unsigned node) const {
+    unsigned level = 0;
+    while (node >= levels[level + 1])
+      ++level;
+    return level;
+  }
+
+  template<class V>
+  void VisitWithinRange(unsigned node, unsigned level, const Point location,
+                        distance_type square_range, V &visitor) const {
+    if (nodes[node].SquareDistanceTo(location) > square_range)
+      return;
+
+    const unsigned child_begin = level == 0
+      ? 0
+      : levels[level - 1];
+    const unsigned child_end = level == 0
+      ? positions.size()
+      : levels[level];
+    const unsigned first = child_begin + (node - levels[level]) * NODE_SIZE;
+    const unsigned last = std::min(child_end, first + NODE_SIZE);
+
+    if (level == 0) {
+      for (unsigned i = first; i < last; ++i)
+        if (positions[i].SquareDistanceTo(location) <= square_range)
+          visitor(*items[i]);
+    } else {
+      for (unsigned i = first; i < last; ++i)
+        VisitWithinRange(i, level - 1, location, square_range, visitor);
+    }
+  }
+
+  /**
+   * Calculate the position of a point on a Hilbert curve which fills
+   * the specified bounds with a 65536x65536 grid.
+   */
+  gcc_const
+  static uint32_t GetHilbertIndex(const Point p, const Rectangle &bounds) {
+    const uint64_t width = int64_t(bounds.right) - bounds.left + 1;
+    const uint64_t height = int64_t(bounds.bottom) - bounds.top + 1;
+    uint32_t x = uint32_t(((int64_t(p.x) - bounds.left) << 16) / width);
+    uint32_t y = uint32_t(((int64_t(p.y) - bounds.top) << 16) / height);
+
+    uint32_t d = 0;
+    for (uint32_t s = 1u << 15; s > 0; s >>= 1) {
+      const uint32_t rx = (x & s) != 0;
+      const uint32_t ry = (y & s) != 0;
+      d += s * s * ((3 * rx) ^ ry);
+
+      /* rotate the quadrant */
+      if (ry == 0) {
+        if (rx == 1) {
+          x = s - 1 - (x & (s - 1));
+          y = s - 1 - (y & (s - 1));
+        }
+
+        std::swap(x, y);
+      }
+    }
+
+    return d;
+  }
+};
+
+#endif
@@ -0,0 +1,232 @@
+/*
+Copyright_License {
+
+  XCSoar Glide Computer - http://www.xcsoar.org/
+  Copyright (C) 2000-2014 The XCSoar Project
+  A detailed list of copyright holders can be found in the file "AUTHORS".
+
+  This program is free software; you can redistribute it and/or
+  modify it under the terms of the GNU General Public License
+  as published by the Free Software Foundation; either version 2
+  of the License, or (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+}
+*/
+
+#include "WaypointCache.hpp"
+#include "Waypoint/Waypoints.hpp"
+#include "Util/AllocatedArray.hpp"
+#include "Compiler.h"
+
+#include <assert.h>
+#include <stdint.h>
+#include <string.h>
+
+struct WaypointCacheHeader {
+#ifdef FIXED_MATH
+  static constexpr uint32_t VERSION = 0x1c;
+#else
+  static constexpr uint32_t VERSION = 0x1d;
+#endif
+
+  uint32_t version;
+
+  /**
+   * The number of #WaypointCacheRecord objects following the header.
+   */
+  uint32_t n_records;
+
+  /**
+   * The number of TCHARs in the string pool following the records.
+   */
+  uint32_t pool_size;
+
+  /**
+   * The number of chars in the terrain path following the header.
+   */
+  uint32_t terrain_path_length;
+
+  uint64_t terrain_size, terrain_mtime;
+};
+
+/**
+ * A string in the pool.
+ */
+struct WaypointCacheString {
+  uint32_t offset, length;
+};
+
+struct WaypointCacheRecord {
+  GeoPoint location;
+  fixed elevation;
+  uint32_t original_id;
+  Runway runway;
+  RadioFrequency radio_frequency;
+  Waypoint::Type type;
+  uint8_t flags;
+  int8_t file_num;
+
+  WaypointCacheString name, comment, details;
+};
+
+enum WaypointCacheFlags : uint8_t {
+  TURN_POINT = 0x1,
+  HOME = 0x2,
+  START_POINT = 0x4,
+  FINISH_POINT = 0x8,
+};
+
+static WaypointCacheString
+AddString(tstring &pool, const tstring &value)
+{
+  WaypointCacheString s;
+  s.offset = pool.length();
+  s.length = value.length();
+  pool.append(value);
+  return s;
+}
+
+gcc_pure
+static bool
+IsValid(const WaypointCacheString s, size_t pool_size)
+{
+  return s.offset <= pool_size && s.length <= pool_size - s.offset;
+}
+
+gcc_pure
+static bool
+IsValid(const WaypointCacheRecord &record, size_t pool_size)
+{
+  return IsValid(record.name, pool_size) &&
+    IsValid(record.comment, pool_size) &&
+    IsValid(record.details, pool_size);
+}
+
+static void
+GetString(tstring &dest, const TCHAR *pool, WaypointCacheString s)
+{
+  dest.assign(pool + s.offset, s.length);
+}
+
+bool
+WaypointCache::Save(FILE *file, const Waypoints &waypoints,
+                    unsigned first_id, unsigned end_id,
+                    const TerrainKey &terrain)
+{
+  assert(file != nullptr);
+  assert(first_id <= end_id);
+
+  AllocatedArray<WaypointCacheRecord> records(end_id - first_id);
+  tstring pool;
+
+  /* the records are written as they are; clear the padding bytes,
+     which would otherwise leak uninitialised memory into the file */
+  memset((void *)records.begin(), 0,
+         records.size() * sizeof(*records.begin()));
+
+  auto *record = records.begin();
+  for (unsigned id = first_id; id < end_id; ++id, ++record) {
+    const Waypoint *wp = waypoints.LookupId(id);
+    if (wp == nullptr)
+      return false;
+
+    /* the "watched" flag is not stored, because
+       Waypoints::Append() derives it from the file number */
+    record->location = wp->location;
+    record->elevation = wp->elevation;
+    record->original_id = wp->original_id;
+    record->runway = wp->runway;
+    record->radio_frequency = wp->radio_frequency;
+    record->type = wp->type;
+    record->flags = (wp->flags.turn_point ? TURN_POINT : 0) |
+      (wp->flags.home ? HOME : 0) |
+      (wp->flags.start_point ? START_POINT : 0) |
+      (wp->flags.finish_point ? FINISH_POINT : 0);
+    record->file_num = wp->file_num;
+    record->name = AddString(pool, wp->name);
+    record->comment = AddString(pool, wp->comment);
+    record->details = AddString(pool, wp->details);
+  }
+
+  WaypointCacheHeader header;
+  memset(&header, 0, sizeof(header));
+  header.version = WaypointCacheHeader::VERSION;
+  header.n_records = records.size();
+  header.pool_size = pool.length();
+  header.terrain_path_length = terrain.path.length();
+  header.terrain_size = terrain.size;
+  header.terrain_mtime = terrain.mtime;
+
+  return fwrite(&header, sizeof(header), 1, file) == 1 &&
+    fwrite(terrain.path.data(), 1, terrain.path.length(),
+           file) == terrain.path.length() &&
+    fwrite(records.begin(), sizeof(*records.begin()),
+           records.size(), file) == records.size() &&
+    fwrite(pool.data(), sizeof(TCHAR), pool.length(),
+           file) == pool.length();
+}
+
+bool
+WaypointCache::Load(FILE *file, Waypoints &waypoints,
+                    const TerrainKey &terrain)
+{
+  assert(file != nullptr);
+
+  WaypointCacheHeader header;
+  if (fread(&header, sizeof(header), 1, file) != 1 ||
+      header.version != WaypointCacheHeader::VERSION ||
+      header.terrain_path_length != terrain.path.length() ||
+      header.terrain_size != terrain.size ||
+      header.terrain_mtime != terrain.mtime)
+    return false;
+
+  AllocatedArray<char> terrain_path(header.terrain_path_length);
+  if (fread(terrain_path.begin(), 1, terrain_path.size(),
+            file) != terrain_path.size() ||
+      terrain.path.compare(0, std::string::npos,
+                           terrain_path.begin(), terrain_path.size()) != 0)
+    return false;
+
+  /* read everything before appending anything, so a truncated file
+     leaves the Waypoints object unmodified */
+  AllocatedArray<WaypointCacheRecord> records(header.n_records);
+  AllocatedArray<TCHAR> pool(header.pool_size);
+  if (fread(records.begin(), sizeof(*records.begin()),
+            records.size(), file) != records.size() ||
+      fread(pool.begin(), sizeof(*pool.begin()),
+            pool.size(), file) != pool.size())
+    return false;
+
+  for (const auto &record : records)
+    if (!IsValid(record, pool.size()))
+      return false;
+
+  for (const auto &record : records) {
+    Waypoint wp(record.location);
+    wp.elevation = record.elevation;
+    wp.original_id = record.original_id;
+    wp.runway = record.runway;
+    wp.radio_frequency = record.radio_frequency;
+    wp.type = record.type;
+    wp.flags.turn_point = (record.flags & TURN_POINT) != 0;
+    wp.flags.home = (record.flags & HOME) != 0;
+    wp.flags.start_point = (record.flags & START_POINT) != 0;
+    wp.flags.finish_point = (record.flags & FINISH_POINT) != 0;
+    wp.file_num = record.file_num;
+    GetString(wp.name, pool.begin(), record.name);
+    GetString(wp.comment, pool.begin(), record.comment);
+    GetString(wp.details, pool.begin(), record.details);
+
+    waypoints.Append(std::move(wp));
+  }
+
+  return true;
+}
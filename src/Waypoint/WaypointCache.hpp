@@ -0,0 +1,86 @@
+/*
+Copyright_License {
+
+  XCSoar Glide Computer - http://www.xcsoar.org/
+  Copyright (C) 2000-2014 The XCSoar Project
+  A detailed list of copyright holders can be found in the file "AUTHORS".
+
+  This program is free software; you can redistribute it and/or
+  modify it under the terms of the GNU General Public License
+  as published by the Free Software Foundation; either version 2
+  of the License, or (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+}
+*/
+
+#ifndef XCSOAR_WAYPOINT_CACHE_HPP
+#define XCSOAR_WAYPOINT_CACHE_HPP
+
+#include <string>
+
+#include <stdint.h>
+#include <stdio.h>
+
+class Waypoints;
+
+/**
+ * A binary snapshot of the waypoints parsed from one waypoint file.
+ * It is stored in the #FileCache, which discards it when the source
+ * file is modified.  Loading it avoids parsing the text file on
+ * start-up.
+ */
+namespace WaypointCache {
+  /**
+   * Identifies the terrain file which was used to fill in missing
+   * elevations.  A cache is only loaded with the same terrain file.
+   */
+  struct TerrainKey {
+    /**
+     * The path of the terrain file; empty if no terrain was
+     * available.
+     */
+    std::string path;
+
+    uint64_t size, mtime;
+
+    TerrainKey():size(0), mtime(0) {}
+
+    TerrainKey(const char *_path, uint64_t _size, uint64_t _mtime)
+      :path(_path), size(_size), mtime(_mtime) {}
+
+    bool operator==(const TerrainKey &other) const {
+      return path == other.path && size == other.size &&
+        mtime == other.mtime;
+    }
+
+    bool operator!=(const TerrainKey &other) const {
+      return !(*this == other);
+    }
+  };
+
+  /**
+   * Save the waypoints with the ids first_id..end_id-1 (in this
+   * order) to the file.
+   *
+   * @param terrain the terrain file which was available to fill
+   * missing elevations
+   */
+  bool Save(FILE *file, const Waypoints &waypoints,
+            unsigned first_id, unsigned end_id, const TerrainKey &terrain);
+
+  /**
+   * Append the waypoints from the file.  Nothing is appended if the
+   * file is invalid or if it was saved with a different terrain file.
+   */
+  bool Load(FILE *file, Waypoints &waypoints, const TerrainKey &terrain);
+}
+
+#endif
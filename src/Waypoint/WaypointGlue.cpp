@@ -32,6 +32,11 @@ Copyright_License {
 #include "Waypoint/WaypointWriter.hpp"
 #include "Operation/Operation.hpp"
 #include "WaypointFileType.hpp"
+#include "WaypointCache.hpp"
+#include "IO/FileCache.hpp"
+#include "OS/FileUtil.hpp"
+#include "Terrain/RasterTerrain.hpp"
+#include "Util/ConvertString.hpp"
 
 #include <windef.h> /* for MAX_PATH */
 
@@ -80,10 +85,90 @@ WaypointGlue::IsWritable()
   return IsWritable(1) || IsWritable(2) || IsWritable(3);
 }
 
+/**
+ * Identify the terrain file which is used to fill in missing
+ * elevations, see WaypointCache::TerrainKey.
+ */
+gcc_pure
+static WaypointCache::TerrainKey
+GetTerrainKey(const RasterTerrain *terrain)
+{
+  if (terrain == nullptr)
+    return WaypointCache::TerrainKey();
+
+  const char *path = terrain->GetPath();
+  const ACPToWideConverter tpath(path);
+  if (!tpath.IsValid())
+    return WaypointCache::TerrainKey(path, 0, 0);
+
+  /* usually, the terrain is a file inside the map archive, which
+     cannot be examined; use the archive's attributes instead (like
+     the #FileCache does) */
+  const TCHAR *file = tpath;
+  TCHAR buffer[MAX_PATH];
+  if (!File::Exists(file))
+    file = DirName(file, buffer);
+
+  return WaypointCache::TerrainKey(path, File::GetSize(file),
+                                   File::GetLastModification(file));
+}
+
+/**
+ * Attempt to load the waypoints of the specified file from the
+ * #FileCache.
+ */
+static bool
+LoadWaypointCache(Waypoints &waypoints, const TCHAR *path,
+                  const TCHAR *cache_name,
+                  const WaypointCache::TerrainKey &terrain,
+                  FileCache &cache)
+{
+  FILE *file = cache.Load(cache_name, path);
+  if (file == nullptr)
+    return false;
+
+  const bool success = WaypointCache::Load(file, waypoints, terrain);
+  fclose(file);
+  return success;
+}
+
+static void
+SaveWaypointCache(const Waypoints &waypoints, unsigned first_id,
+                  const TCHAR *path, const TCHAR *cache_name,
+                  const WaypointCache::TerrainKey &terrain,
+                  FileCache &cache)
+{
+  FILE *file = cache.Save(cache_name, path);
+  if (file == nullptr)
+    return;
+
+  /* Waypoints::Append() assigns consecutive ids, therefore the ids
+     of the waypoints from this file start at first_id */
+  if (WaypointCache::Save(file, waypoints, first_id, waypoints.size() + 1,
+                          terrain))
+    cache.Commit(cache_name, file);
+  else
+    cache.Cancel(cache_name, file);
+}
+
 static bool
 LoadWaypointFile(Waypoints &waypoints, const TCHAR *path, int file_num,
-                 const RasterTerrain *terrain, OperationEnvironment &operation)
+                 const RasterTerrain *terrain,
+                 FileCache *cache, const TCHAR *cache_name,
+                 OperationEnvironment &operation)
 {
+  const WaypointCache::TerrainKey terrain_key = cache != nullptr
+    ? GetTerrainKey(terrain)
+    : WaypointCache::TerrainKey();
+
+  if (cache != nullptr &&
+      LoadWaypointCache(waypoints, path, cache_name, terrain_key, *cache))
+    return true;
+
+  /* this is only correct because LoadWaypoints() begins with an empty
+     Waypoints object, and waypoints are never removed while loading */
+  const unsigned first_id = waypoints.size() + 1;
+
   WaypointReader reader(path, file_num);
   if (reader.Error()) {
     LogFormat(_T("Failed to open waypoint file: %s"), path);
@@ -97,12 +182,17 @@ LoadWaypointFile(Waypoints &waypoints, const TCHAR *path, int file_num,
     return false;
   }
 
+  if (cache != nullptr)
+    SaveWaypointCache(waypoints, first_id, path, cache_name, terrain_key,
+                      *cache);
+
   return true;
 }
 
 bool
 WaypointGlue::LoadWaypoints(Waypoints &way_points,
                             const RasterTerrain *terrain,
+                            FileCache *cache,
                             OperationEnvironment &operation)
 {
   LogFormat("ReadWaypoints");
@@ -117,15 +207,18 @@ WaypointGlue::LoadWaypoints(Waypoints &way_points,
 
   // ### FIRST FILE ###
   if (Profile::GetPath(ProfileKeys::WaypointFile, path))
-    found |= LoadWaypointFile(way_points, path, 1, terrain, operation);
+    found |= LoadWaypointFile(way_points, path, 1, terrain,
+                              cache, _T("waypoints1"), operation);
 
   // ### SECOND FILE ###
   if (Profile::GetPath(ProfileKeys::AdditionalWaypointFile, path))
-    found |= LoadWaypointFile(way_points, path, 2, terrain, operation);
+    found |= LoadWaypointFile(way_points, path, 2, terrain,
+                              cache, _T("waypoints2"), operation);
 
   // ### WATCHED WAYPOINT/THIRD FILE ###
   if (Profile::GetPath(ProfileKeys::WatchedWaypointFile, path))
-    found |= LoadWaypointFile(way_points, path, 3, terrain, operation);
+    found |= LoadWaypointFile(way_points, path, 3, terrain,
+                              cache, _T("waypoints3"), operation);
 
   // ### MAP/FOURTH FILE ###
 
@@ -134,10 +227,12 @@ WaypointGlue::LoadWaypoints(Waypoints &way_points,
     TCHAR *tail = path + _tcslen(path);
 
     _tcscpy(tail, _T("/waypoints.xcw"));
-    found |= LoadWaypointFile(way_points, path, 0, terrain, operation);
+    found |= LoadWaypointFile(way_points, path, 0, terrain,
+                              cache, _T("waypoints_map_xcw"), operation);
 
     _tcscpy(tail, _T("/waypoints.cup"));
-    found |= LoadWaypointFile(way_points, path, 0, terrain, operation);
+    found |= LoadWaypointFile(way_points, path, 0, terrain,
+                              cache, _T("waypoints_map_cup"), operation);
   }
 
   // Optimise the waypoint list after attaching new waypoints
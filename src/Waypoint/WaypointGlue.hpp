@@ -27,6 +27,7 @@ Copyright_License {
 struct Waypoint;
 class Waypoints;
 class RasterTerrain;
+class FileCache;
 class OperationEnvironment;
 struct PlacesOfInterestSettings;
 struct TeamCodeSettings;
@@ -98,9 +99,12 @@ namespace WaypointGlue {
    * specified waypoint list
    * @param way_points The waypoint list to fill
    * @param terrain RasterTerrain (for automatic waypoint height)
+   * @param cache an optional #FileCache which stores a binary copy
+   * of each parsed waypoint file
    */
   bool LoadWaypoints(Waypoints &way_points,
                      const RasterTerrain *terrain,
+                     FileCache *cache,
                      OperationEnvironment &operation);
 
   bool SaveWaypoints(const Waypoints &way_points);
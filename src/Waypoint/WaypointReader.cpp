@@ -30,6 +30,7 @@ Copyright_License {
 #include "WaypointReaderCompeGPS.hpp"
 #include "WaypointFileType.hpp"
 #include "OS/FileUtil.hpp"
+#include "OS/FileMapping.hpp"
 #include "IO/ZipSource.hpp"
 #include "IO/TextFile.hpp"
 #include "Util/StringUtil.hpp"
@@ -40,6 +41,15 @@ WaypointReader::Parse(Waypoints &way_points, OperationEnvironment &operation)
   if (reader == NULL)
     return false;
 
+  if (reader->IsParallel()) {
+    /* fast path: map the file into memory and parse it on all CPUs */
+    FileMapping mapping(path);
+    if (!mapping.error() &&
+        reader->ParseParallel(way_points, (const char *)mapping.data(),
+                              mapping.size(), operation))
+      return true;
+  }
+
   TLineReader *line_reader = OpenTextFile(path, ConvertLineReader::AUTO);
   if (line_reader == nullptr)
     return false;
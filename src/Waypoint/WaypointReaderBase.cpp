@@ -28,6 +28,19 @@ Copyright_License {
 #include "Operation/Operation.hpp"
 #include "IO/LineReader.hpp"
 
+#ifndef _UNICODE
+#include "Waypoint/Waypoints.hpp"
+#include "Thread/Thread.hpp"
+#include "OS/ProcessorCount.hpp"
+#include "Util/ReusableArray.hpp"
+#include "Util/UTF8.hpp"
+
+#include <functional>
+#include <vector>
+
+#include <string.h>
+#endif
+
 #include <assert.h>
 
 WaypointReaderBase::WaypointReaderBase(const int _file_num,
@@ -177,3 +190,304 @@ WaypointReaderBase::Parse(Waypoints &way_points, TLineReader &reader,
       operation.SetProgressPosition(reader.Tell() * 100 / filesize);
   }
 }
+
+#ifndef _UNICODE
+
+/**
+ * Files smaller than this are not split for ParseParallel().
+ */
+static constexpr size_t MIN_CHUNK_SIZE = 64 * 1024;
+
+static bool
+StartsWithBOM(const char *line)
+{
+  return line[0] == (char)0xEF && line[1] == (char)0xBB &&
+    line[2] == (char)0xBF;
+}
+
+/**
+ * Splits a memory range into null-terminated lines, just like
+ * LineSplitter does.
+ */
+class MappedLineReader {
+  const char *p;
+  const char *const end;
+
+  ReusableArray<char> buffer;
+
+public:
+  MappedLineReader(const char *begin, const char *_end)
+    :p(begin), end(_end) {}
+
+  /**
+   * @param start_r receives the position of the line within the
+   * memory range
+   * @return a copy of the line, or nullptr at the end of the range
+   */
+  char *ReadLine(const char *&start_r) {
+    if (p >= end)
+      return nullptr;
+
+    const char *const start = p;
+    const char *eol = (const char *)memchr(p, '\n', end - p);
+    if (eol == nullptr) {
+      p = eol = end;
+    } else {
+      p = eol + 1;
+
+      /* purge trailing carriage return characters */
+      while (eol > start && eol[-1] == '\r')
+        --eol;
+    }
+
+    const size_t length = eol - start;
+    char *line = buffer.get(length + 1);
+    memcpy(line, start, length);
+    line[length] = 0;
+
+    start_r = start;
+    return line;
+  }
+};
+
+/**
+ * One part of a file being parsed by
+ * WaypointReaderBase::ParseParallel().
+ */
+struct WaypointReaderBase::ParallelChunk {
+  const char *begin, *end;
+
+  /**
+   * The first line with an invalid UTF-8 sequence, the first line
+   * starting with a byte order mark and the line which ends the
+   * waypoint section; nullptr if there is none.
+   */
+  const char *invalid_utf8, *bom, *end_marker;
+
+  std::vector<Waypoint> waypoints;
+
+  void Scan(const WaypointReaderBase &reader) {
+    invalid_utf8 = bom = end_marker = nullptr;
+
+    MappedLineReader lines(begin, end);
+    const char *start;
+    const char *line;
+    while ((line = lines.ReadLine(start)) != nullptr) {
+      if (invalid_utf8 == nullptr && !ValidateUTF8(line))
+        invalid_utf8 = start;
+
+      if (bom == nullptr && StartsWithBOM(line))
+        bom = start;
+
+      if (reader.IsEndOfWaypoints(line)) {
+        end_marker = start;
+        break;
+      }
+    }
+  }
+
+  void Parse(const WaypointReaderBase &reader,
+             const char *latin1_begin, const char *stop) {
+    MappedLineReader lines(begin, std::min(end, stop));
+    ReusableArray<char> latin1_buffer;
+
+    const char *start;
+    const char *line;
+    while ((line = lines.ReadLine(start)) != nullptr) {
+      if (start >= latin1_begin) {
+        const size_t buffer_size = strlen(line) * 2 + 1;
+        const char *utf8 = Latin1ToUTF8(line, latin1_buffer.get(buffer_size),
+                                        buffer_size);
+        if (utf8 != nullptr)
+          line = utf8;
+      }
+
+      Waypoint waypoint;
+      if (reader.ParseWaypoint(line, waypoint))
+        waypoints.push_back(std::move(waypoint));
+    }
+  }
+};
+
+class ChunkThread final : public Thread {
+  std::function<void()> function;
+
+public:
+  ChunkThread():Thread("WaypointReader") {}
+
+  bool Start(std::function<void()> &&_function) {
+    function = std::move(_function);
+    return Thread::Start();
+  }
+
+protected:
+  void Run() override {
+    function();
+  }
+};
+
+/**
+ * Call the function for each chunk index, on one thread per chunk.
+ */
+static void
+RunParallel(unsigned n, const std::function<void(unsigned)> &f)
+{
+  ChunkThread *threads = new ChunkThread[n - 1];
+
+  for (unsigned i = 1; i < n; ++i)
+    if (!threads[i - 1].Start([&f, i](){ f(i); }))
+      /* could not create a thread: do it here */
+      f(i);
+
+  f(0);
+
+  for (unsigned i = 1; i < n; ++i)
+    if (threads[i - 1].IsDefined())
+      threads[i - 1].Join();
+
+  delete[] threads;
+}
+
+template<typename F>
+static const char *
+FindFirst(const std::vector<WaypointReaderBase::ParallelChunk> &chunks,
+          F f)
+{
+  for (const auto &chunk : chunks)
+    if (f(chunk) != nullptr)
+      return f(chunk);
+
+  return nullptr;
+}
+
+#endif
+
+bool
+WaypointReaderBase::ParseParallel(Waypoints &way_points,
+                                  const char *data, size_t size,
+                                  OperationEnvironment &operation)
+{
+#ifdef _UNICODE
+  return false;
+#else
+  if (!IsParallel())
+    return false;
+
+  operation.SetProgressRange(100);
+
+  const char *const end = data + size;
+
+  /* the first line is special: it may begin with a byte order mark,
+     and it is passed to ParseLine(), because it may be a header */
+
+  MappedLineReader first_reader(data, end);
+  const char *start;
+  char *first_line = first_reader.ReadLine(start);
+  if (first_line == nullptr)
+    return false;
+
+  const char *body = (const char *)memchr(data, '\n', size);
+  body = body != nullptr ? body + 1 : end;
+
+  bool utf8 = false;
+  if (StartsWithBOM(first_line)) {
+    first_line += 3;
+    utf8 = true;
+  }
+
+  const bool first_valid = ValidateUTF8(first_line);
+
+  /* split the rest of the file into chunks on line boundaries */
+
+  const size_t body_size = end - body;
+  const unsigned n_chunks =
+    std::max(std::min<size_t>(body_size / MIN_CHUNK_SIZE,
+                              GetProcessorCount()),
+             size_t(1));
+
+  std::vector<ParallelChunk> chunks(n_chunks);
+  const char *p = body;
+  for (unsigned i = 0; i < n_chunks; ++i) {
+    chunks[i].begin = p;
+
+    if (i + 1 < n_chunks) {
+      p = std::max(p, body + body_size * (i + 1) / n_chunks);
+      const char *eol = (const char *)memchr(p, '\n', end - p);
+      p = eol != nullptr ? eol + 1 : end;
+    } else
+      p = end;
+
+    chunks[i].end = p;
+  }
+
+  /* first pass: find the character set switch and the end of the
+     waypoint section, which are sequential properties of the file */
+
+  RunParallel(n_chunks, [this, &chunks](unsigned i){
+      chunks[i].Scan(*this);
+    });
+
+  operation.SetProgressPosition(10);
+
+  const char *stop = FindFirst(chunks, [](const ParallelChunk &chunk){
+      return chunk.end_marker;
+    });
+  if (stop == nullptr)
+    stop = end;
+
+  const char *bom = FindFirst(chunks, [](const ParallelChunk &chunk){
+      return chunk.bom;
+    });
+  if (bom != nullptr && bom < stop)
+    /* ConvertLineReader switches the character set on each byte
+       order mark; leave that to the sequential parser */
+    return false;
+
+  const char *invalid_utf8 = first_valid
+    ? FindFirst(chunks, [](const ParallelChunk &chunk){
+        return chunk.invalid_utf8;
+      })
+    : data;
+
+  const char *latin1_begin = end;
+  if (invalid_utf8 != nullptr) {
+    if (utf8)
+      /* ConvertLineReader stops at the first invalid line of a UTF-8
+         file */
+      stop = std::min(stop, invalid_utf8);
+    else
+      latin1_begin = invalid_utf8;
+  }
+
+  /* second pass: parse all waypoint lines */
+
+  RunParallel(n_chunks, [this, &chunks, latin1_begin, stop](unsigned i){
+      chunks[i].Parse(*this, latin1_begin, stop);
+    });
+
+  operation.SetProgressPosition(80);
+
+  /* append the waypoints in file order */
+
+  if (stop > data) {
+    ReusableArray<char> latin1_buffer;
+    if (latin1_begin == data) {
+      const size_t buffer_size = strlen(first_line) * 2 + 1;
+      const char *converted = Latin1ToUTF8(first_line,
+                                           latin1_buffer.get(buffer_size),
+                                           buffer_size);
+      if (converted != nullptr)
+        first_line = const_cast<char *>(converted);
+    }
+
+    ParseLine(first_line, 0, way_points);
+  }
+
+  for (auto &chunk : chunks)
+    for (auto &waypoint : chunk.waypoints)
+      way_points.Append(std::move(waypoint));
+
+  operation.SetProgressPosition(100);
+  return true;
+#endif
+}
@@ -36,6 +36,9 @@ class OperationEnvironment;
 
 class WaypointReaderBase 
 {
+public:
+  struct ParallelChunk;
+
 protected:
   const int file_num;
   const RasterTerrain* terrain;
@@ -57,6 +60,27 @@ public:
   void Parse(Waypoints &way_points, TLineReader &reader,
              OperationEnvironment &operation);
 
+  /**
+   * Can this reader be used with ParseParallel()?
+   */
+  virtual bool IsParallel() const {
+    return false;
+  }
+
+  /**
+   * Parses the contents of a (memory-mapped) waypoint file.  The file
+   * is split into chunks on line boundaries which are parsed on
+   * several threads with ParseWaypoint(), and the results are
+   * appended to the waypoint list in file order.  The character set
+   * is detected just like ConvertLineReader::AUTO does.
+   *
+   * @return false if the reader does not support this or if the file
+   * is unusual and needs to be parsed with Parse(); no waypoint has
+   * been added then
+   */
+  bool ParseParallel(Waypoints &way_points, const char *data, size_t size,
+                     OperationEnvironment &operation);
+
   void SetTerrain(const RasterTerrain* _terrain) {
     terrain = _terrain;
   }
@@ -77,6 +101,26 @@ protected:
   virtual bool ParseLine(const TCHAR* line, unsigned linenum,
                          Waypoints &way_points) = 0;
 
+  /**
+   * Parse a line which is not the first line of the file into a new
+   * waypoint, for ParseParallel().  This must not modify the reader,
+   * because it is called on several threads at a time.
+   *
+   * @return true if a waypoint was parsed, false if the line was
+   * ignored or malformed
+   */
+  virtual bool ParseWaypoint(const TCHAR *line, Waypoint &dest) const {
+    return false;
+  }
+
+  /**
+   * Does this line end the waypoint section of the file?  All
+   * following lines are ignored by ParseParallel().
+   */
+  virtual bool IsEndOfWaypoints(const TCHAR *line) const {
+    return false;
+  }
+
 public:
   // Helper functions
 
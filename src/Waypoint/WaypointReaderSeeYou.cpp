@@ -158,9 +158,42 @@ ParseStyle(const TCHAR* src, Waypoint::Type &type)
   return true;
 }
 
+bool
+WaypointReaderSeeYou::IsEndOfWaypoints(const TCHAR *line) const
+{
+  return StringStartsWith(line, _T("-----Related Tasks-----"));
+}
+
 bool
 WaypointReaderSeeYou::ParseLine(const TCHAR* line, const unsigned linenum,
                               Waypoints &waypoints)
+{
+  if (linenum == 0) {
+    ignore_following = false;
+
+    // Skip first line if it doesn't begin with a quotation character
+    // (usually the field order line)
+    if (line[0] != _T('\"'))
+      return true;
+  }
+
+  // If task marker is reached ignore all following lines
+  if (IsEndOfWaypoints(line))
+    ignore_following = true;
+  if (ignore_following)
+    return true;
+
+  Waypoint new_waypoint;
+  if (!ParseWaypoint(line, new_waypoint))
+    return false;
+
+  waypoints.Append(std::move(new_waypoint));
+  return true;
+}
+
+bool
+WaypointReaderSeeYou::ParseWaypoint(const TCHAR *line,
+                                    Waypoint &new_waypoint) const
 {
   enum {
     iName = 0,
@@ -174,32 +207,18 @@ WaypointReaderSeeYou::ParseLine(const TCHAR* line, const unsigned linenum,
     iDescription = 10,
   };
 
-  if (linenum == 0)
-    ignore_following = false;
-
   // If (end-of-file or comment)
   if (StringIsEmpty(line) ||
       StringStartsWith(line, _T("**")) ||
       StringStartsWith(line, _T("*")))
-    // -> return without error condition
-    return true;
+    // -> ignore the line
+    return false;
 
   TCHAR ctemp[4096];
   if (_tcslen(line) >= ARRAY_SIZE(ctemp))
     /* line too long for buffer */
     return false;
 
-  // Skip first line if it doesn't begin with a quotation character
-  // (usually the field order line)
-  if (linenum == 0 && line[0] != _T('\"'))
-    return true;
-
-  // If task marker is reached ignore all following lines
-  if (_tcsstr(line, _T("-----Related Tasks-----")) == line)
-    ignore_following = true;
-  if (ignore_following)
-    return true;
-
   // Get fields
   const TCHAR *params[20];
   size_t n_params = ExtractParameters(line, ctemp, params,
@@ -211,8 +230,6 @@ WaypointReaderSeeYou::ParseLine(const TCHAR* line, const unsigned linenum,
       iLongitude >= n_params)
     return false;
 
-  Waypoint new_waypoint;
-
   // Latitude (e.g. 5115.900N)
   if (!ParseAngle(params[iLatitude], new_waypoint.location.latitude, true))
     return false;
@@ -281,6 +298,5 @@ WaypointReaderSeeYou::ParseLine(const TCHAR* line, const unsigned linenum,
     new_waypoint.comment = params[iDescription];
   }
 
-  waypoints.Append(std::move(new_waypoint));
   return true;
 }
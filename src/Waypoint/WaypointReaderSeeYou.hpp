@@ -45,6 +45,14 @@ protected:
    */
   bool ParseLine(const TCHAR* line, const unsigned linenum,
                  Waypoints &way_points);
+
+  bool ParseWaypoint(const TCHAR *line, Waypoint &dest) const override;
+  bool IsEndOfWaypoints(const TCHAR *line) const override;
+
+public:
+  bool IsParallel() const override {
+    return true;
+  }
 };
 
 #endif
@@ -1,5 +1,4 @@
-/*
-Copyright_License {
+/* Copyright_License {
 
   XCSoar Glide Computer - http://www.xcsoar.org/
   Copyright (C) 2000-2014 The XCSoar Project
@@ -21,11 +20,23 @@ Copyright_License {
 }
 */
 
-#include "FlarmNetRecord.hpp"
-#include "FlarmId.hpp"
+#ifndef XCSOAR_BENCHMARK_CLOCK_HPP
+#define XCSOAR_BENCHMARK_CLOCK_HPP
 
-FlarmId
-FlarmNetRecord::GetId() const
+#include "OS/Clock.hpp"
+
+#include <stdint.h>
+
+/**
+ * Returns the monotonic clock in microseconds.  MonotonicClockUS() is
+ * declared "pure", which allows the compiler to merge two calls
+ * around a loop of other "pure" calls; the barrier prevents that.
+ */
+static inline uint64_t
+BenchmarkClockUS()
 {
-  return FlarmId::Parse(this->id, NULL);
-};
+  asm volatile("" ::: "memory");
+  return MonotonicClockUS();
+}
+
+#endif
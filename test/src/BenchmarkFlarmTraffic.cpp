@@ -0,0 +1,188 @@
+/* Copyright_License {
+
+  XCSoar Glide Computer - http://www.xcsoar.org/
+  Copyright (C) 2000-2014 The XCSoar Project
+  A detailed list of copyright holders can be found in the file "AUTHORS".
+
+  This program is free software; you can redistribute it and/or
+  modify it under the terms of the GNU General Public License
+  as published by the Free Software Foundation; either version 2
+  of the License, or (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+}
+*/
+
+
+/*
+ * Feed synthetic FLARM traffic through the NMEA parser and
+ * FlarmComputer, the way the MergeThread does, and measure the time
+ * per merge cycle and the time of a TrafficList range query.  The
+ * "$PFLAA" sentences are generated by FLARMEmulator: the targets
+ * circle around the own position, each one reporting once per
+ * second, spread over the merge cycles.
+ */
+
+#include "FLARMEmulator.hpp"
+#include "Device/Port/NullPort.hpp"
+#include "Device/Parser.hpp"
+#include "FLARM/FlarmComputer.hpp"
+#include "NMEA/Info.hpp"
+#include "Operation/Operation.hpp"
+#include "OS/Args.hpp"
+#include "BenchmarkClock.hpp"
+
+#include <stdio.h>
+#include <stdlib.h>
+
+static constexpr unsigned N_SECONDS = 3600;
+
+/**
+ * The MergeThread runs at most every 150 ms.
+ */
+static constexpr unsigned CYCLES_PER_SECOND = 7;
+
+/**
+ * A #Port which passes everything written to it to the NMEA parser.
+ */
+class ParserPort final : public NullPort, PortLineSplitter {
+  NMEAParser parser;
+  NMEAInfo &info;
+
+public:
+  explicit ParserPort(NMEAInfo &_info):info(_info) {}
+
+  virtual size_t Write(const void *data, size_t length) override {
+    PortLineSplitter::DataReceived(data, length);
+    return length;
+  }
+
+protected:
+  virtual void LineReceived(const char *line) override {
+    parser.ParseLine(line, info);
+  }
+};
+
+static FlarmTraffic
+MakeTarget(unsigned i, unsigned second)
+{
+  /* a circle with a radius between 300 m and 5 km, 40 seconds per
+     turn */
+  const fixed radius = fixed(300 + (i * 997) % 4700);
+  const Angle angle = Angle::Degrees(i * 37 + second * 9);
+
+  FlarmTraffic traffic;
+  traffic.Clear();
+
+  char id[16];
+  sprintf(id, "%X", 0xDD0000 + i);
+  traffic.id = FlarmId::Parse(id, nullptr);
+  traffic.alarm_level = FlarmTraffic::AlarmType::NONE;
+  traffic.relative_north = radius * angle.cos();
+  traffic.relative_east = radius * angle.sin();
+  traffic.relative_altitude = fixed(int(i * 31) % 400 - 200);
+  traffic.track = (angle + Angle::QuarterCircle()).AsBearing();
+  traffic.turn_rate = fixed(9);
+  traffic.speed = fixed(25);
+  traffic.climb_rate = fixed(1.5);
+  traffic.type = FlarmTraffic::AircraftType::GLIDER;
+  return traffic;
+}
+
+int
+main(int argc, char **argv)
+{
+  Args args(argc, argv, "[N_TARGETS]");
+  const unsigned n_targets = args.IsEmpty()
+    ? TrafficList::MAX_COUNT
+    : strtoul(args.GetNext(), nullptr, 10);
+  args.ExpectEnd();
+
+  NMEAInfo info;
+  info.Reset();
+
+  ParserPort port(info);
+  NullOperationEnvironment env;
+
+  FLARMEmulator emulator;
+  emulator.port = &port;
+  emulator.env = &env;
+
+  FlarmComputer computer;
+  NMEAInfo basic, last_fix;
+  last_fix.Reset();
+
+  const GeoPoint origin(Angle::Degrees(7.7), Angle::Degrees(51.05));
+
+  uint64_t process_us = 0, grid_ns = 0, linear_ns = 0;
+  unsigned n_cycles = 0, n_found = 0;
+
+  for (unsigned second = 0; second < N_SECONDS; ++second) {
+    for (unsigned cycle = 0; cycle < CYCLES_PER_SECOND; ++cycle) {
+      info.clock = fixed(1 + second) + fixed(cycle) / CYCLES_PER_SECOND;
+
+      if (cycle == 0) {
+        /* a new GPS fix, moving north */
+        info.ProvideTime(fixed(36000 + second));
+        info.location = origin;
+        info.location.latitude += Angle::Degrees(second * 0.0002);
+        info.location_available.Update(info.clock);
+        info.gps_altitude = fixed(1200);
+        info.gps_altitude_available.Update(info.clock);
+      }
+
+      for (unsigned i = cycle; i < n_targets; i += CYCLES_PER_SECOND)
+        emulator.SendPFLAA(MakeTarget(i, second));
+
+      info.flarm.traffic.Expire(info.clock);
+
+      /* this is what MergeThread::Process() does */
+      basic = info;
+
+      uint64_t start = BenchmarkClockUS();
+      computer.Process(basic.flarm, last_fix.flarm, basic);
+      process_us += BenchmarkClockUS() - start;
+
+      if (cycle == 0)
+        last_fix = basic;
+
+      /* a range query, as done by MapItemListBuilder */
+      const TrafficList &traffic = basic.flarm.traffic;
+      const fixed range(1000);
+      auto count = [&n_found](const FlarmTraffic &) { ++n_found; };
+
+      start = BenchmarkClockUS();
+      for (unsigned i = 0; i < 100; ++i)
+        traffic.VisitWithinRange(basic.location, range, count);
+      grid_ns += (BenchmarkClockUS() - start) * 10;
+
+      TrafficList copy = traffic;
+      copy.grid.Clear();
+      start = BenchmarkClockUS();
+      for (unsigned i = 0; i < 100; ++i)
+        copy.VisitWithinRange(basic.location, range, count);
+      linear_ns += (BenchmarkClockUS() - start) * 10;
+
+      ++n_cycles;
+    }
+  }
+
+  printf("%u targets (%u in the list), %u merge cycles\n",
+         n_targets, basic.flarm.traffic.GetActiveTrafficCount(), n_cycles);
+  printf("Process: %.2f us/cycle, %u targets computed, %u reused\n",
+         double(process_us) / n_cycles,
+         computer.GetComputedCount(), computer.GetReusedCount());
+  printf("VisitWithinRange: %.0f ns/query (grid), %.0f ns/query (linear), "
+         "%.1f targets/query\n",
+         double(grid_ns) / n_cycles, double(linear_ns) / n_cycles,
+         double(n_found) / (2 * 100 * n_cycles));
+
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,152 @@
+/* Copyright_License {
+
+  XCSoar Glide Computer - http://www.xcsoar.org/
+  Copyright (C) 2000-2014 The XCSoar Project
+  A detailed list of copyright holders can be found in the file "AUTHORS".
+
+  This program is free software; you can redistribute it and/or
+  modify it under the terms of the GNU General Public License
+  as published by the Free Software Foundation; either version 2
+  of the License, or (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+}
+*/
+
+/*
+ * Measure the CPU usage of the IOThread with many serial ports: N
+ * pseudo-terminals are opened with TTYPort, and the main thread
+ * writes NMEA sentences to each of them (like FeedNMEA does), at a
+ * fixed rate.  Prints the CPU time and the number of context
+ * switches of the whole process.
+ */
+
+#include "Device/Port/TTYPort.hpp"
+#include "IO/Async/GlobalIOThread.hpp"
+#include "IO/DataHandler.hpp"
+#include "OS/Args.hpp"
+#include "OS/Sleep.h"
+#include "BenchmarkClock.hpp"
+
+#include <atomic>
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/time.h>
+#include <sys/resource.h>
+
+static constexpr unsigned MAX_PORTS = 64;
+static constexpr unsigned DURATION_MS = 5000;
+
+/**
+ * The interval between two sentences on each port [ms].
+ */
+static constexpr unsigned INTERVAL_MS = 10;
+
+static const char sentence[] =
+  "$GPRMC,082311,A,5103.5403,N,00741.5742,E,055.3,022.4,230610,000.3,W*6C\n";
+
+class CountingHandler : public DataHandler {
+public:
+  std::atomic<size_t> n_bytes;
+
+  CountingHandler():n_bytes(0) {}
+
+  virtual void DataReceived(const void *data, size_t length) override {
+    n_bytes.fetch_add(length, std::memory_order_relaxed);
+  }
+};
+
+static uint64_t
+ToUS(const struct timeval &tv)
+{
+  return uint64_t(tv.tv_sec) * 1000000 + tv.tv_usec;
+}
+
+int
+main(int argc, char **argv)
+{
+  Args args(argc, argv, "[N_PORTS]");
+  const unsigned n_ports = args.IsEmpty()
+    ? 8
+    : strtoul(args.GetNext(), nullptr, 10);
+  args.ExpectEnd();
+
+  if (n_ports == 0 || n_ports > MAX_PORTS) {
+    fprintf(stderr, "Invalid number of ports\n");
+    return EXIT_FAILURE;
+  }
+
+  InitialiseIOThread();
+
+  CountingHandler handlers[MAX_PORTS];
+  TTYPort *ports[MAX_PORTS];
+  int slaves[MAX_PORTS];
+
+  for (unsigned i = 0; i < n_ports; ++i) {
+    ports[i] = new TTYPort(handlers[i]);
+    const char *slave_path = ports[i]->OpenPseudo();
+    if (slave_path == nullptr || !ports[i]->StartRxThread()) {
+      fprintf(stderr, "Failed to open a pseudo-terminal\n");
+      return EXIT_FAILURE;
+    }
+
+    slaves[i] = open(slave_path, O_WRONLY | O_NOCTTY);
+    if (slaves[i] < 0) {
+      fprintf(stderr, "Failed to open %s\n", slave_path);
+      return EXIT_FAILURE;
+    }
+  }
+
+  struct rusage start_usage, end_usage;
+  getrusage(RUSAGE_SELF, &start_usage);
+  const uint64_t start = BenchmarkClockUS();
+
+  unsigned n_sentences = 0;
+  for (unsigned t = 0; t < DURATION_MS; t += INTERVAL_MS) {
+    for (unsigned i = 0; i < n_ports; ++i)
+      if (write(slaves[i], sentence, sizeof(sentence) - 1) > 0)
+        ++n_sentences;
+
+    Sleep(INTERVAL_MS);
+  }
+
+  /* let the IOThread catch up */
+  Sleep(100);
+
+  const uint64_t end = BenchmarkClockUS();
+  getrusage(RUSAGE_SELF, &end_usage);
+
+  size_t n_bytes = 0;
+  for (unsigned i = 0; i < n_ports; ++i) {
+    n_bytes += handlers[i].n_bytes.load();
+    close(slaves[i]);
+    delete ports[i];
+  }
+
+  DeinitialiseIOThread();
+
+  const uint64_t cpu_us =
+    ToUS(end_usage.ru_utime) - ToUS(start_usage.ru_utime) +
+    ToUS(end_usage.ru_stime) - ToUS(start_usage.ru_stime);
+  const long context_switches =
+    (end_usage.ru_nvcsw - start_usage.ru_nvcsw) +
+    (end_usage.ru_nivcsw - start_usage.ru_nivcsw);
+
+  printf("%u ports: %u sentences, %lu bytes received\n",
+         n_ports, n_sentences, (unsigned long)n_bytes);
+  printf("CPU %.2f%% (%.0f us per sentence), %ld context switches\n",
+         100. * cpu_us / (end - start), double(cpu_us) / n_sentences,
+         context_switches);
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,159 @@
+/* Copyright_License {
+
+  XCSoar Glide Computer - http://www.xcsoar.org/
+  Copyright (C) 2000-2014 The XCSoar Project
+  A detailed list of copyright holders can be found in the file "AUTHORS".
+
+  This program is free software; you can redistribute it and/or
+  modify it under the terms of the GNU General Public License
+  as published by the Free Software Foundation; either version 2
+  of the License, or (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+}
+*/
+
+/*
+ * Measure the NMEA receive path: the input (the built-in sample or
+ * a file in the format accepted by FeedNMEA) is passed in small
+ * chunks to a PortLineSplitter, and each line is dispatched to
+ * NMEAParser::ParseLine(), like DeviceDescriptor does.  Prints the
+ * throughput in sentences per second.
+ */
+
+#include "Device/Util/LineSplitter.hpp"
+#include "Device/Parser.hpp"
+#include "NMEA/Info.hpp"
+#include "NMEA/Checksum.hpp"
+#include "OS/Args.hpp"
+#include "BenchmarkClock.hpp"
+
+#include <algorithm>
+#include <string>
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+/**
+ * Repeat the input until at least this many lines have been fed.
+ */
+static constexpr unsigned MIN_LINES = 500000;
+
+/**
+ * The size of the chunks passed to DataReceived(), similar to what a
+ * serial port delivers.
+ */
+static constexpr size_t CHUNK_SIZE = 64;
+
+static const char *const sample[] = {
+  "$GPRMC,082311,A,5103.5403,N,00741.5742,E,055.3,022.4,230610,000.3,W",
+  "$GPGGA,082311,5103.5403,N,00741.5742,E,1,08,0.9,545.4,M,46.9,M,,",
+  "$GPGSA,A,3,04,05,,09,12,,,24,,,,,2.5,1.3,2.1",
+  "$PGRMZ,1793,f,3",
+  "$PFLAU,3,1,2,1,1,-45,2,-124,755",
+  "$PFLAA,0,-1234,1234,220,2,DD8F12,180,,30,-1.4,1",
+  "$PFLAA,1,100,-150,10,2,DDA85C,123,13,24,1.4,2",
+  "$PFLAA,0,2000,-300,-50,2,DDA85D,45,,28,0.2,1",
+  "$PTAS1,200,200,02426,000",
+  "$LXWP0,Y,222.3,1665.5,1.71,,,,,,239,174,10.1",
+};
+
+class BenchmarkLineSplitter : public PortLineSplitter {
+  NMEAParser parser;
+  NMEAInfo info;
+
+public:
+  unsigned n_lines, n_parsed;
+
+  BenchmarkLineSplitter():n_lines(0), n_parsed(0) {
+    info.Reset();
+    info.clock = fixed(1);
+  }
+
+protected:
+  virtual void LineReceived(const char *line) override {
+    ++n_lines;
+    if (parser.ParseLine(line, info))
+      ++n_parsed;
+  }
+};
+
+static std::string
+MakeSample()
+{
+  std::string result;
+  for (const char *i : sample) {
+    char buffer[256];
+    strcpy(buffer, i);
+    AppendNMEAChecksum(buffer);
+    result.append(buffer);
+    result.append("\r\n");
+  }
+
+  return result;
+}
+
+static bool
+LoadFile(const char *path, std::string &result)
+{
+  FILE *file = fopen(path, "rb");
+  if (file == nullptr)
+    return false;
+
+  char buffer[4096];
+  size_t nbytes;
+  while ((nbytes = fread(buffer, 1, sizeof(buffer), file)) > 0)
+    result.append(buffer, nbytes);
+
+  fclose(file);
+  return true;
+}
+
+int
+main(int argc, char **argv)
+{
+  Args args(argc, argv, "[FILE.nmea]");
+
+  std::string input;
+  if (args.IsEmpty())
+    input = MakeSample();
+  else if (!LoadFile(args.GetNext(), input)) {
+    fprintf(stderr, "Failed to read the input file\n");
+    return EXIT_FAILURE;
+  }
+
+  args.ExpectEnd();
+
+  const unsigned n_lines = std::count(input.begin(), input.end(), '\n');
+  if (n_lines == 0) {
+    fprintf(stderr, "No input\n");
+    return EXIT_FAILURE;
+  }
+
+  const unsigned n_runs = (MIN_LINES + n_lines - 1) / n_lines;
+
+  BenchmarkLineSplitter splitter;
+
+  const uint64_t start = BenchmarkClockUS();
+  for (unsigned i = 0; i < n_runs; ++i)
+    for (size_t position = 0; position < input.length();
+         position += CHUNK_SIZE)
+      splitter.DataReceived(input.data() + position,
+                            std::min(CHUNK_SIZE,
+                                     input.length() - position));
+  const uint64_t end = BenchmarkClockUS();
+
+  const double duration = double(end - start) / 1000000;
+  printf("%u sentences (%u parsed) in %.3f s: %.0f sentences/s\n",
+         splitter.n_lines, splitter.n_parsed, duration,
+         splitter.n_lines / duration);
+  return EXIT_SUCCESS;
+}
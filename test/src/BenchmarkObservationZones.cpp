@@ -0,0 +1,157 @@
+/*
+Copyright_License {
+
+  XCSoar Glide Computer - http://www.xcsoar.org/
+  Copyright (C) 2000-2014 The XCSoar Project
+  A detailed list of copyright holders can be found in the file "AUTHORS".
+
+  This program is free software; you can redistribute it and/or
+  modify it under the terms of the GNU General Public License
+  as published by the Free Software Foundation; either version 2
+  of the License, or (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+}
+
+/*
+ * Measure ObservationZone::IsInSector() for all zone types, on
+ * random locations around the zone, and compare with the cost of
+ * the exact distance calculation.  Also verifies that the cheap
+ * bounding tests never contradict the exact distance.
+ */
+
+#include "Engine/Task/ObservationZones/CylinderZone.hpp"
+#include "Engine/Task/ObservationZones/SectorZone.hpp"
+#include "Engine/Task/ObservationZones/SymmetricSectorZone.hpp"
+#include "Engine/Task/ObservationZones/LineSectorZone.hpp"
+#include "Engine/Task/ObservationZones/KeyholeZone.hpp"
+#include "Engine/Task/ObservationZones/AnnularSectorZone.hpp"
+#include "Geo/GeoVector.hpp"
+#include "BenchmarkClock.hpp"
+#include "Compiler.h"
+
+#include <memory>
+#include <vector>
+
+#include <stdio.h>
+#include <stdlib.h>
+
+static constexpr unsigned N_LOCATIONS = 256 * 1024;
+
+struct NamedZone {
+  const char *name;
+  std::unique_ptr<CylinderZone> zone;
+};
+
+static std::vector<GeoPoint>
+GenerateLocations(const CylinderZone &zone)
+{
+  /* a square three times the radius of the zone */
+  const fixed range = zone.GetRadius() * 3;
+
+  std::vector<GeoPoint> locations;
+  locations.reserve(N_LOCATIONS);
+  for (unsigned i = 0; i < N_LOCATIONS; ++i) {
+    const fixed x = range * (fixed(2) * rand() / RAND_MAX - fixed(1));
+    const fixed y = range * (fixed(2) * rand() / RAND_MAX - fixed(1));
+    const GeoPoint p = GeoVector(x, Angle::QuarterCircle())
+      .EndPoint(zone.GetReference());
+    locations.push_back(GeoVector(y, Angle::Zero()).EndPoint(p));
+  }
+
+  return locations;
+}
+
+static void
+Benchmark(const char *name, const CylinderZone &zone)
+{
+  const std::vector<GeoPoint> locations = GenerateLocations(zone);
+
+  unsigned n_inside = 0;
+  uint64_t start = BenchmarkClockUS();
+  for (const GeoPoint &location : locations)
+    if (zone.IsInSector(location))
+      ++n_inside;
+  const uint64_t in_sector_us = BenchmarkClockUS() - start;
+
+  fixed checksum = fixed(0);
+  start = BenchmarkClockUS();
+  for (const GeoPoint &location : locations)
+    checksum += zone.GetReference().Distance(location);
+  const uint64_t distance_us = BenchmarkClockUS() - start;
+
+  /* the cheap tests decide by distance only; none of them may
+     disagree with the exact distance */
+  const bool is_cylinder =
+    zone.GetShape() == ObservationZone::Shape::CYLINDER ||
+    zone.GetShape() == ObservationZone::Shape::MAT_CYLINDER;
+  unsigned n_errors = 0;
+  for (const GeoPoint &location : locations) {
+    const fixed distance = zone.GetReference().Distance(location);
+    const bool inside = zone.IsInSector(location);
+    if (inside && distance > zone.GetRadius())
+      ++n_errors;
+    else if (!inside && is_cylinder && distance <= zone.GetRadius())
+      ++n_errors;
+  }
+
+  printf("%-20s IsInSector %6.1f ns, Distance %6.1f ns, inside %5.1f%%, "
+         "errors %u (checksum %.0f)\n",
+         name, in_sector_us * 1000. / N_LOCATIONS,
+         distance_us * 1000. / N_LOCATIONS,
+         n_inside * 100. / N_LOCATIONS, n_errors, (double)checksum);
+}
+
+int
+main(gcc_unused int argc, gcc_unused char **argv)
+{
+  const GeoPoint location(Angle::Degrees(7.70722),
+                          Angle::Degrees(51.052));
+  const GeoPoint previous(Angle::Degrees(7.0), Angle::Degrees(51.0));
+  const GeoPoint next(Angle::Degrees(7.8), Angle::Degrees(51.6));
+
+  NamedZone zones[] = {
+    { "cylinder", std::unique_ptr<CylinderZone>(new CylinderZone(location)) },
+    { "mat_cylinder",
+      std::unique_ptr<CylinderZone>(CylinderZone::CreateMatCylinderZone(location)) },
+    { "sector", std::unique_ptr<CylinderZone>(new SectorZone(location)) },
+    { "symmetric_quadrant",
+      std::unique_ptr<CylinderZone>(new SymmetricSectorZone(location)) },
+    { "fai_sector",
+      std::unique_ptr<CylinderZone>(SymmetricSectorZone::CreateFAISectorZone(location)) },
+    { "bga_start",
+      std::unique_ptr<CylinderZone>(SymmetricSectorZone::CreateBGAStartSectorZone(location)) },
+    { "line", std::unique_ptr<CylinderZone>(new LineSectorZone(location)) },
+    { "daec_keyhole",
+      std::unique_ptr<CylinderZone>(KeyholeZone::CreateDAeCKeyholeZone(location)) },
+    { "bga_fixed_course",
+      std::unique_ptr<CylinderZone>(KeyholeZone::CreateBGAFixedCourseZone(location)) },
+    { "bga_enhanced_option",
+      std::unique_ptr<CylinderZone>(KeyholeZone::CreateBGAEnhancedOptionZone(location)) },
+    { "custom_keyhole",
+      std::unique_ptr<CylinderZone>(KeyholeZone::CreateCustomKeyholeZone(location,
+                                                                         fixed(15000),
+                                                                         Angle::Degrees(60))) },
+    { "annular_sector",
+      std::unique_ptr<CylinderZone>(new AnnularSectorZone(location, fixed(20000),
+                                                           Angle::Degrees(30),
+                                                           Angle::Degrees(150),
+                                                           fixed(5000))) },
+  };
+
+  srand(1);
+
+  for (NamedZone &i : zones) {
+    i.zone->SetLegs(&previous, &next);
+    Benchmark(i.name, *i.zone);
+  }
+
+  return 0;
+}
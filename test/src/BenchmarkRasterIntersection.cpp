@@ -0,0 +1,70 @@
+/* Copyright_License {
+
+  XCSoar Glide Computer - http://www.xcsoar.org/
+  Copyright (C) 2000-2014 The XCSoar Project
+  A detailed list of copyright holders can be found in the file "AUTHORS".
+
+  This program is free software; you can redistribute it and/or
+  modify it under the terms of the GNU General Public License
+  as published by the Free Software Foundation; either version 2
+  of the License, or (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+}
+*/
+
+/*
+ * Run RasterTileCache::FirstIntersection() and Intersection() on
+ * random lines over synthetic terrain.
+ */
+
+#include "SyntheticTerrain.hpp"
+#include "Terrain/RasterLocation.hpp"
+#include "Compiler.h"
+
+#include <algorithm>
+
+#include <stdio.h>
+
+int
+main(int argc, char **argv)
+{
+  SyntheticRasterTileCache rtc;
+  rtc.Generate(8, 8, 256, 75);
+
+  unsigned long checksum = 0;
+
+  for (unsigned i = 512 * 1024; i-- > 0;) {
+    const int x0 = rtc.Random() % rtc.GetWidth();
+    const int y0 = rtc.Random() % rtc.GetHeight();
+    const int x1 = rtc.Random() % rtc.GetWidth();
+    const int y1 = rtc.Random() % rtc.GetHeight();
+
+    const int c_diff = abs(x1 - x0) + abs(y1 - y0);
+    if (c_diff == 0)
+      continue;
+
+    const int h_origin = 1500 + rtc.Random() % 1500;
+    const int slope_fact = (2000 << RASTER_SLOPE_FACT) / c_diff;
+
+    RasterLocation location;
+    int h;
+    if (rtc.FirstIntersection(x0, y0, x1, y1, h_origin, h_origin,
+                              slope_fact, 10000, 100,
+                              location, h, false))
+      checksum += location.x + location.y + h;
+
+    location = rtc.Intersection(x0, y0, x1, y1, h_origin, slope_fact);
+    checksum += location.x + location.y;
+  }
+
+  printf("%lu\n", checksum);
+  return 0;
+}
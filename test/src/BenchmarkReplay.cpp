@@ -0,0 +1,125 @@
+/* Copyright_License {
+
+  XCSoar Glide Computer - http://www.xcsoar.org/
+  Copyright (C) 2000-2014 The XCSoar Project
+  A detailed list of copyright holders can be found in the file "AUTHORS".
+
+  This program is free software; you can redistribute it and/or
+  modify it under the terms of the GNU General Public License
+  as published by the Free Software Foundation; either version 2
+  of the License, or (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+}
+*/
+
+
+/*
+ * Replay an IGC file into a GlideComputer with #FastReplay, i.e. as
+ * quickly as the computer can consume the fixes, and print the
+ * throughput.
+ */
+
+#include "Replay/FastReplay.hpp"
+#include "Replay/IgcReplay.hpp"
+#include "ConsoleJobRunner.hpp"
+#include "IO/FileLineReader.hpp"
+#include "Engine/Waypoint/Waypoints.hpp"
+#include "Engine/Airspace/Airspaces.hpp"
+#include "Engine/Task/TaskManager.hpp"
+#include "Computer/GlideComputer.hpp"
+#include "Computer/GlideComputerInterface.hpp"
+#include "Computer/Settings.hpp"
+#include "Task/ProtectedTaskManager.hpp"
+#include "NMEA/Info.hpp"
+#include "OS/Args.hpp"
+
+#include <stdio.h>
+#include <stdlib.h>
+
+/* fake symbols: */
+
+#include "Computer/ConditionMonitor/ConditionMonitors.hpp"
+#include "Input/InputQueue.hpp"
+#include "Logger/Logger.hpp"
+
+void
+ConditionMonitorsUpdate(const NMEAInfo &basic, const DerivedInfo &calculated,
+                        const ComputerSettings &settings)
+{
+}
+
+bool InputEvents::processGlideComputer(unsigned) { return false; }
+
+void Logger::LogStartEvent(const NMEAInfo &gps_info) {}
+void Logger::LogFinishEvent(const NMEAInfo &gps_info) {}
+void Logger::LogPoint(const NMEAInfo &gps_info) {}
+
+/* done with fake symbols. */
+
+int
+main(int argc, char **argv)
+{
+  Args args(argc, argv, "FILE.igc");
+  const char *path = args.ExpectNext();
+  args.ExpectEnd();
+
+  FileLineReaderA *reader = new FileLineReaderA(path);
+  if (reader->error()) {
+    delete reader;
+    fprintf(stderr, "Failed to open %s\n", path);
+    return EXIT_FAILURE;
+  }
+
+  IgcReplay replay(reader);
+
+  ComputerSettings settings;
+  settings.SetDefaults();
+
+  const Waypoints way_points;
+  Airspaces airspace_database;
+
+  TaskBehaviour task_behaviour;
+  task_behaviour.SetDefaults();
+
+  TaskManager task_manager(task_behaviour, way_points);
+  task_manager.SetGlidePolar(settings.polar.glide_polar_task);
+
+  GlideComputerTaskEvents task_events;
+  task_manager.SetTaskEvents(task_events);
+
+  ProtectedTaskManager protected_task_manager(task_manager, settings.task);
+
+  GlideComputer glide_computer(way_points, airspace_database,
+                               protected_task_manager,
+                               task_events);
+  glide_computer.ReadComputerSettings(settings);
+  glide_computer.SetTerrain(nullptr);
+  glide_computer.SetContestIncremental(false);
+  glide_computer.Initialise();
+
+  NMEAInfo data;
+  data.Reset();
+
+  FastReplay job(replay, reader, data, glide_computer, settings, fixed(-1));
+  ConsoleJobRunner runner;
+  runner.Run(job);
+
+  glide_computer.ProcessExhaustive();
+
+  const DerivedInfo &calculated = glide_computer.Calculated();
+  printf("%u fixes in %u ms: %u fixes/s\n",
+         job.GetFixCount(), job.GetDuration(), job.GetFixesPerSecond());
+  printf("flight time %u s, contest distance %.1f km\n",
+         (unsigned)calculated.flight.flight_time,
+         (double)calculated.contest_stats.GetResult(0).distance / 1000);
+
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,215 @@
+/* Copyright_License {
+
+  XCSoar Glide Computer - http://www.xcsoar.org/
+  Copyright (C) 2000-2014 The XCSoar Project
+  A detailed list of copyright holders can be found in the file "AUTHORS".
+
+  This program is free software; you can redistribute it and/or
+  modify it under the terms of the GNU General Public License
+  as published by the Free Software Foundation; either version 2
+  of the License, or (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+}
+*/
+
+/*
+ * Compare the publication of a large structure (like MoreData with
+ * its FLARM traffic list) under a Mutex with a SeqLock: one writer
+ * thread updates the structure continuously, two reader threads
+ * (like DrawThread and CalculationThread) copy it.  Prints the
+ * readers' wait time histogram, and verifies that each copy is
+ * consistent.
+ */
+
+#include "Thread/SeqLock.hpp"
+#include "Thread/Mutex.hpp"
+#include "Thread/Thread.hpp"
+#include "BenchmarkClock.hpp"
+
+#include <atomic>
+
+#include <stdio.h>
+
+static constexpr unsigned DURATION_US = 1000000;
+static constexpr unsigned N_READERS = 2;
+
+/**
+ * Upper bounds of the histogram buckets [us]; the last bucket
+ * collects everything above.
+ */
+static constexpr unsigned BUCKETS[] = { 1, 10, 100, 1000, 10000 };
+static constexpr unsigned N_BUCKETS = sizeof(BUCKETS) / sizeof(BUCKETS[0]) + 1;
+
+struct Payload {
+  unsigned values[4096];
+
+  void Fill(unsigned value) {
+    for (auto &i : values)
+      i = value;
+  }
+
+  bool IsConsistent() const {
+    for (auto i : values)
+      if (i != values[0])
+        return false;
+    return true;
+  }
+};
+
+static Mutex mutex;
+static Payload locked_payload;
+static SeqLock<Payload> published_payload;
+static std::atomic<bool> running;
+
+/**
+ * Simulate some work outside of the lock.
+ */
+static void
+Work(unsigned us)
+{
+  const uint64_t end = BenchmarkClockUS() + us;
+  while (BenchmarkClockUS() < end) {}
+}
+
+class WriterThread final : public Thread {
+  const bool use_seqlock;
+  Payload payload;
+
+public:
+  unsigned n_writes;
+
+  explicit WriterThread(bool _use_seqlock)
+    :use_seqlock(_use_seqlock), n_writes(0) {}
+
+protected:
+  void Run() override {
+    while (running.load(std::memory_order_relaxed)) {
+      ++n_writes;
+
+      {
+        const ScopeLock protect(mutex);
+
+        /* like MergeThread::Process() */
+        Work(5);
+
+        if (use_seqlock) {
+          payload.Fill(n_writes);
+          published_payload.Write(payload);
+        } else
+          locked_payload.Fill(n_writes);
+      }
+
+      Work(10);
+    }
+  }
+};
+
+class ReaderThread final : public Thread {
+  const bool use_seqlock;
+  Payload payload;
+
+public:
+  unsigned n_reads, n_inconsistent;
+  uint64_t total_wait, max_wait;
+  unsigned histogram[N_BUCKETS];
+
+  explicit ReaderThread(bool _use_seqlock)
+    :use_seqlock(_use_seqlock), n_reads(0), n_inconsistent(0),
+     total_wait(0), max_wait(0), histogram() {}
+
+protected:
+  void Run() override {
+    while (running.load(std::memory_order_relaxed)) {
+      const uint64_t start = BenchmarkClockUS();
+
+      if (use_seqlock)
+        published_payload.Read(payload);
+      else {
+        const ScopeLock protect(mutex);
+        payload = locked_payload;
+      }
+
+      const uint64_t wait = BenchmarkClockUS() - start;
+
+      ++n_reads;
+      if (!payload.IsConsistent())
+        ++n_inconsistent;
+
+      total_wait += wait;
+      if (wait > max_wait)
+        max_wait = wait;
+
+      unsigned bucket = 0;
+      while (bucket < N_BUCKETS - 1 && wait >= BUCKETS[bucket])
+        ++bucket;
+      ++histogram[bucket];
+
+      Work(20);
+    }
+  }
+};
+
+static void
+Run(bool use_seqlock)
+{
+  const char *const name = use_seqlock ? "seqlock" : "mutex";
+
+  running = true;
+
+  WriterThread writer(use_seqlock);
+  ReaderThread reader1(use_seqlock), reader2(use_seqlock);
+  ReaderThread *const readers[N_READERS] = { &reader1, &reader2 };
+
+  writer.Start();
+  for (auto *reader : readers)
+    reader->Start();
+
+  Work(DURATION_US);
+  running = false;
+
+  writer.Join();
+  for (auto *reader : readers)
+    reader->Join();
+
+  printf("%s: %u writes\n", name, writer.n_writes);
+
+  for (unsigned r = 0; r < N_READERS; ++r) {
+    const ReaderThread &reader = *readers[r];
+    printf("%s: reader %u: %u reads, %.2f us mean wait, %u us max, "
+           "%u inconsistent\n  histogram:",
+           name, r, reader.n_reads,
+           double(reader.total_wait) / reader.n_reads,
+           unsigned(reader.max_wait), reader.n_inconsistent);
+
+    for (unsigned i = 0; i < N_BUCKETS - 1; ++i)
+      printf(" <%uus:%u", BUCKETS[i], reader.histogram[i]);
+    printf(" >=%uus:%u\n", BUCKETS[N_BUCKETS - 2],
+           reader.histogram[N_BUCKETS - 1]);
+  }
+
+  if (use_seqlock) {
+    unsigned n_reads = 0;
+    for (const auto *reader : readers)
+      n_reads += reader->n_reads;
+
+    printf("%s: %u retries in %u reads, %u versions\n", name,
+           published_payload.GetRetryCount(), n_reads,
+           published_payload.GetVersion());
+  }
+}
+
+int
+main(int argc, char **argv)
+{
+  Run(false);
+  Run(true);
+  return 0;
+}
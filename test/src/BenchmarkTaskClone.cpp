@@ -0,0 +1,164 @@
+/* Copyright_License {
+
+  XCSoar Glide Computer - http://www.xcsoar.org/
+  Copyright (C) 2000-2014 The XCSoar Project
+  A detailed list of copyright holders can be found in the file "AUTHORS".
+
+  This program is free software; you can redistribute it and/or
+  modify it under the terms of the GNU General Public License
+  as published by the Free Software Foundation; either version 2
+  of the License, or (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+}
+*/
+
+/*
+ * Measure OrderedTask::Clone() on the tasks of the test harness:
+ * clones per second, heap allocations per clone and the memory held
+ * by each clone.  The geometry copied by Clone() is compared with
+ * the one calculated by UpdateGeometry().
+ */
+
+#include "harness_task.hpp"
+#include "harness_waypoints.hpp"
+#include "test_debug.hpp"
+#include "BenchmarkClock.hpp"
+#include "Engine/Waypoint/Waypoints.hpp"
+#include "Task/TaskManager.hpp"
+#include "Task/Ordered/OrderedTask.hpp"
+#include "Task/Factory/AbstractTaskFactory.hpp"
+
+#include <new>
+
+#include <stdio.h>
+#include <stdlib.h>
+
+static constexpr unsigned N_RUNS = 2000;
+static constexpr unsigned N_KEEP = 100;
+
+static uint64_t n_allocations;
+static size_t live_bytes, peak_bytes;
+
+/* each allocation is preceded by its size, for the memory
+   statistics */
+union AllocationHeader {
+  size_t size;
+  max_align_t align;
+};
+
+void *
+operator new(size_t size)
+{
+  AllocationHeader *header =
+    (AllocationHeader *)malloc(sizeof(AllocationHeader) + size);
+  if (header == nullptr)
+    abort();
+
+  header->size = size;
+
+  ++n_allocations;
+  live_bytes += size;
+  if (live_bytes > peak_bytes)
+    peak_bytes = live_bytes;
+
+  return header + 1;
+}
+
+void *
+operator new[](size_t size)
+{
+  return operator new(size);
+}
+
+void
+operator delete(void *p) noexcept
+{
+  if (p == nullptr)
+    return;
+
+  AllocationHeader *header = (AllocationHeader *)p - 1;
+  live_bytes -= header->size;
+  free(header);
+}
+
+void
+operator delete[](void *p) noexcept
+{
+  operator delete(p);
+}
+
+static void
+Benchmark(const OrderedTask &task, const TaskBehaviour &task_behaviour,
+          const char *name)
+{
+  uint64_t allocations = n_allocations;
+  const uint64_t start = BenchmarkClockUS();
+  for (unsigned i = 0; i < N_RUNS; ++i)
+    delete task.Clone(task_behaviour);
+  const uint64_t end = BenchmarkClockUS();
+  allocations = n_allocations - allocations;
+
+  /* keep some clones to see how much memory each one holds */
+  OrderedTask *clones[N_KEEP];
+  const size_t before = live_bytes;
+  peak_bytes = live_bytes;
+  for (unsigned i = 0; i < N_KEEP; ++i)
+    clones[i] = task.Clone(task_behaviour);
+  const size_t held = live_bytes - before;
+  const size_t peak = peak_bytes - before;
+  for (unsigned i = 0; i < N_KEEP; ++i)
+    delete clones[i];
+
+  /* the copied geometry must match a fresh calculation */
+  OrderedTask *clone = task.Clone(task_behaviour);
+  const TaskStats copied = clone->GetStats();
+  clone->UpdateGeometry();
+  const TaskStats &calculated = clone->GetStats();
+  const bool geometry_ok =
+    copied.distance_max == calculated.distance_max &&
+    copied.distance_min == calculated.distance_min &&
+    copied.distance_nominal == calculated.distance_nominal;
+  delete clone;
+
+  printf("%s: %u points, %.0f clones/s, %.1f us/clone, "
+         "%.1f allocations/clone, %.0f bytes/clone (peak %.0f), "
+         "geometry %s\n",
+         name, task.TaskSize(),
+         N_RUNS * 1000000. / (end - start),
+         double(end - start) / N_RUNS,
+         double(allocations) / N_RUNS,
+         double(held) / N_KEEP, double(peak) / N_KEEP,
+         geometry_ok ? "ok" : "MISMATCH");
+}
+
+int main(int argc, char **argv)
+{
+  if (!ParseArgs(argc, argv))
+    return 0;
+
+  TaskBehaviour task_behaviour;
+  task_behaviour.SetDefaults();
+
+  Waypoints waypoints;
+  SetupWaypoints(waypoints);
+
+  for (const int test_num : { 0, 1, 2 }) {
+    TaskManager task_manager(task_behaviour, waypoints);
+    if (!test_task(task_manager, waypoints, test_num))
+      continue;
+
+    task_manager.GetFactory().UpdateGeometry();
+    Benchmark(task_manager.GetOrderedTask(), task_behaviour,
+              task_name(test_num));
+  }
+
+  return 0;
+}
@@ -0,0 +1,233 @@
+/* Copyright_License {
+
+  XCSoar Glide Computer - http://www.xcsoar.org/
+  Copyright (C) 2000-2014 The XCSoar Project
+  A detailed list of copyright holders can be found in the file "AUTHORS".
+
+  This program is free software; you can redistribute it and/or
+  modify it under the terms of the GNU General Public License
+  as published by the Free Software Foundation; either version 2
+  of the License, or (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+}
+*/
+
+/*
+ * Run TaskDijkstraMin and TaskDijkstraMax on the tasks flown by
+ * test_aat, using the full OZ boundaries as search points, and
+ * measure OrderedTask::UpdateGeometry(), which includes the refining
+ * second pass.
+ *
+ * To validate the refinement, the coarse solution, the refined one
+ * (coarse solution plus the points near it) and a dense reference
+ * (every boundary point plus the points near it) are compared.
+ */
+
+#include "harness_task.hpp"
+#include "harness_waypoints.hpp"
+#include "test_debug.hpp"
+#include "BenchmarkClock.hpp"
+#include "Engine/Waypoint/Waypoints.hpp"
+#include "Task/Ordered/OrderedTask.hpp"
+#include "Task/Ordered/Points/OrderedTaskPoint.hpp"
+#include "Task/ObservationZones/Boundary.hpp"
+#include "Task/PathSolvers/TaskDijkstraMin.hpp"
+#include "Task/PathSolvers/TaskDijkstraMax.hpp"
+#include "Geo/SearchPointVector.hpp"
+
+#include <vector>
+
+#include <stdio.h>
+
+static constexpr unsigned N_RUNS = 2000;
+
+template<typename T>
+static void
+SetBoundaries(T &dijkstra, const OrderedTask &task)
+{
+  const unsigned task_size = task.TaskSize();
+  dijkstra.SetTaskSize(task_size);
+  for (unsigned i = 0; i != task_size; ++i)
+    dijkstra.SetBoundary(i, task.GetTaskPoint(i).GetBoundaryPoints());
+}
+
+static void
+Benchmark(const OrderedTask &task, const char *name)
+{
+  const unsigned task_size = task.TaskSize();
+
+  unsigned n_points = 0;
+  for (unsigned i = 0; i != task_size; ++i)
+    n_points += task.GetTaskPoint(i).GetBoundaryPoints().size();
+
+  TaskDijkstraMax dijkstra_max;
+  SetBoundaries(dijkstra_max, task);
+
+  long checksum = 0;
+  uint64_t start = BenchmarkClockUS();
+  for (unsigned i = 0; i < N_RUNS; ++i)
+    if (dijkstra_max.DistanceMax())
+      for (unsigned j = 0; j != task_size; ++j)
+        checksum += dijkstra_max.GetSolution(j).GetFlatLocation().longitude;
+  uint64_t end = BenchmarkClockUS();
+  printf("%s: %u points, max: %.2f us/run (checksum %ld)\n",
+         name, n_points, double(end - start) / N_RUNS, checksum);
+
+  TaskDijkstraMin dijkstra_min;
+  SetBoundaries(dijkstra_min, task);
+
+  const SearchPoint location(task.GetTaskPoint(0).GetLocation(),
+                             task.GetTaskProjection());
+
+  checksum = 0;
+  start = BenchmarkClockUS();
+  for (unsigned i = 0; i < N_RUNS; ++i)
+    if (dijkstra_min.DistanceMin(location))
+      for (unsigned j = 0; j != task_size; ++j)
+        checksum += dijkstra_min.GetSolution(j).GetFlatLocation().longitude;
+  end = BenchmarkClockUS();
+  printf("%s: %u points, min: %.2f us/run (checksum %ld)\n",
+         name, n_points, double(end - start) / N_RUNS, checksum);
+}
+
+/**
+ * Returns the specified points plus the ones which
+ * ObservationZone::GetBoundaryNear() generates around each of them.
+ */
+static SearchPointVector
+WithNear(const OrderedTaskPoint &tp, const SearchPointVector &points,
+         const TaskProjection &projection)
+{
+  SearchPointVector result(points);
+  for (const SearchPoint &p : points)
+    for (const GeoPoint &location : tp.GetBoundaryNear(p.GetLocation()))
+      result.push_back(SearchPoint(location, projection));
+  return result;
+}
+
+static bool
+Solve(TaskDijkstraMax &dijkstra, const SearchPoint &)
+{
+  return dijkstra.DistanceMax();
+}
+
+static bool
+Solve(TaskDijkstraMin &dijkstra, const SearchPoint &location)
+{
+  return dijkstra.DistanceMin(location);
+}
+
+/**
+ * Solve the task on the given search points and return the length of
+ * the solution, starting at #origin if that is not nullptr.
+ */
+template<typename T>
+static double
+SolveDistance(T &dijkstra, const std::vector<SearchPointVector> &boundaries,
+              const SearchPoint &location, const GeoPoint *origin)
+{
+  const unsigned task_size = boundaries.size();
+  dijkstra.SetTaskSize(task_size);
+  for (unsigned i = 0; i != task_size; ++i)
+    dijkstra.SetBoundary(i, boundaries[i]);
+
+  if (!Solve(dijkstra, location))
+    return -1;
+
+  double distance = origin != nullptr
+    ? (double)origin->Distance(dijkstra.GetSolution(0).GetLocation())
+    : 0.;
+  for (unsigned i = 1; i != task_size; ++i)
+    distance += (double)dijkstra.GetSolution(i - 1).GetLocation()
+      .Distance(dijkstra.GetSolution(i).GetLocation());
+  return distance;
+}
+
+template<typename T>
+static void
+Validate(const OrderedTask &task, const char *name, const char *what,
+         const GeoPoint *origin)
+{
+  const unsigned task_size = task.TaskSize();
+  const TaskProjection &projection = task.GetTaskProjection();
+  const SearchPoint location(task.GetTaskPoint(0).GetLocation(), projection);
+
+  std::vector<SearchPointVector> coarse(task_size), refined(task_size),
+    dense(task_size);
+  for (unsigned i = 0; i != task_size; ++i) {
+    const OrderedTaskPoint &tp = task.GetTaskPoint(i);
+    coarse[i] = tp.GetBoundaryPoints();
+    dense[i] = WithNear(tp, coarse[i], projection);
+  }
+
+  T dijkstra;
+  const double coarse_distance =
+    SolveDistance(dijkstra, coarse, location, origin);
+  for (unsigned i = 0; i != task_size; ++i) {
+    SearchPointVector solution;
+    solution.push_back(dijkstra.GetSolution(i));
+    refined[i] = WithNear(task.GetTaskPoint(i), solution, projection);
+  }
+
+  const double refined_distance =
+    SolveDistance(dijkstra, refined, location, origin);
+  const double dense_distance =
+    SolveDistance(dijkstra, dense, location, origin);
+
+  printf("%s: %s: coarse %.1f m, refined %+.1f m, dense %+.1f m\n",
+         name, what, coarse_distance,
+         refined_distance - coarse_distance,
+         dense_distance - coarse_distance);
+}
+
+static void
+BenchmarkUpdateGeometry(OrderedTask &task, const char *name)
+{
+  const uint64_t start = BenchmarkClockUS();
+  for (unsigned i = 0; i < N_RUNS; ++i)
+    task.UpdateGeometry();
+  const uint64_t end = BenchmarkClockUS();
+
+  const TaskStats &stats = task.GetStats();
+  printf("%s: UpdateGeometry: %.2f us/run (max %.1f m, min %.1f m)\n",
+         name, double(end - start) / N_RUNS,
+         (double)stats.distance_max, (double)stats.distance_min);
+}
+
+int main(int argc, char **argv)
+{
+  if (!ParseArgs(argc, argv))
+    return 0;
+
+  TaskBehaviour task_behaviour;
+  task_behaviour.SetDefaults();
+
+  Waypoints waypoints;
+  SetupWaypoints(waypoints);
+
+  /* the tasks flown by test_aat */
+  for (const int test_num : { 2, 0 }) {
+    TaskManager task_manager(task_behaviour, waypoints);
+    if (!test_task(task_manager, waypoints, test_num))
+      continue;
+
+    OrderedTask *task = task_manager.Clone(task_behaviour);
+    task->UpdateGeometry();
+    Benchmark(*task, task_name(test_num));
+    Validate<TaskDijkstraMax>(*task, task_name(test_num), "max", nullptr);
+    Validate<TaskDijkstraMin>(*task, task_name(test_num), "min",
+                              &task->GetTaskPoint(0).GetLocation());
+    BenchmarkUpdateGeometry(*task, task_name(test_num));
+    delete task;
+  }
+
+  return 0;
+}
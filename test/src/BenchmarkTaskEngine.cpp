@@ -0,0 +1,287 @@
+/* Copyright_License {
+
+  XCSoar Glide Computer - http://www.xcsoar.org/
+  Copyright (C) 2000-2014 The XCSoar Project
+  A detailed list of copyright holders can be found in the file "AUTHORS".
+
+  This program is free software; you can redistribute it and/or
+  modify it under the terms of the GNU General Public License
+  as published by the Free Software Foundation; either version 2
+  of the License, or (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+}
+*/
+
+/*
+ * Fly a fixed set of tasks with the harness autopilot and measure
+ * TaskManager::Update() and TaskManager::UpdateIdle(), broken down
+ * into the stages reported by TaskProfiler, and the number of heap
+ * allocations.  The results are written to stdout as JSON.
+ */
+
+#include "harness_flight.hpp"
+#include "harness_task.hpp"
+#include "harness_waypoints.hpp"
+#include "test_debug.hpp"
+#include "BenchmarkClock.hpp"
+#include "Replay/TaskAutoPilot.hpp"
+#include "Replay/AircraftSim.hpp"
+#include "Replay/TaskAccessor.hpp"
+#include "Engine/Waypoint/Waypoints.hpp"
+#include "Engine/Task/TaskProfiler.hpp"
+#include "Task/TaskManager.hpp"
+#include "Task/Factory/AbstractTaskFactory.hpp"
+#include "GlideSolvers/GlidePolar.hpp"
+#include "IO/TextWriter.hpp"
+#include "JSON/Writer.hpp"
+#include "Util/Macros.hpp"
+
+#include <new>
+#include <stdlib.h>
+
+static uint64_t n_allocations;
+
+void *
+operator new(size_t size)
+{
+  ++n_allocations;
+
+  void *p = malloc(size);
+  if (p == nullptr)
+    abort();
+
+  return p;
+}
+
+void *
+operator new[](size_t size)
+{
+  return operator new(size);
+}
+
+void
+operator delete(void *p) noexcept
+{
+  free(p);
+}
+
+void
+operator delete[](void *p) noexcept
+{
+  free(p);
+}
+
+struct Counter {
+  uint64_t calls, us, allocations;
+
+  void Add(uint64_t _us, uint64_t _allocations) {
+    ++calls;
+    us += _us;
+    allocations += _allocations;
+  }
+};
+
+static constexpr unsigned N_STAGES = unsigned(TaskProfiler::Stage::COUNT);
+
+static constexpr const char *stage_names[N_STAGES] = {
+  "transitions",
+  "distances",
+  "dijkstra",
+  "glide",
+  "sample",
+  "stats",
+  "idle",
+  "targets",
+};
+
+class BenchmarkProfiler final : public TaskProfiler {
+  uint64_t start_us[N_STAGES], start_allocations[N_STAGES];
+
+public:
+  Counter stages[N_STAGES];
+
+  BenchmarkProfiler():stages() {}
+
+  virtual void Begin(Stage stage) override {
+    const unsigned i = unsigned(stage);
+    start_allocations[i] = n_allocations;
+    start_us[i] = BenchmarkClockUS();
+  }
+
+  virtual void End(Stage stage) override {
+    const uint64_t now = BenchmarkClockUS();
+    const unsigned i = unsigned(stage);
+    stages[i].Add(now - start_us[i], n_allocations - start_allocations[i]);
+  }
+};
+
+struct Scenario {
+  const char *name;
+
+  /** the test_task() number */
+  int test_num;
+};
+
+/* the mixed, FAI triangle and AAT tasks of the test harness */
+static constexpr Scenario scenarios[] = {
+  { "mixed", 0 },
+  { "fai", 1 },
+  { "aat", 2 },
+};
+
+struct Result {
+  unsigned samples;
+  Counter update, update_idle;
+  BenchmarkProfiler profiler;
+
+  Result():samples(0), update(), update_idle() {}
+};
+
+static void
+Fly(const Scenario &scenario, Result &result)
+{
+  /* the autopilot adds random noise */
+  srand(1);
+
+  Waypoints waypoints;
+  SetupWaypoints(waypoints);
+
+  TaskBehaviour task_behaviour;
+  task_behaviour.SetDefaults();
+  task_behaviour.enable_trace = false;
+  task_behaviour.calc_glide_required = false;
+  /* settings of test_flight() */
+  const bool goto_target = scenario.test_num != 1;
+  if (goto_target)
+    task_behaviour.optimise_targets_bearing = false;
+
+  TaskManager task_manager(task_behaviour, waypoints);
+  task_manager.SetGlidePolar(GlidePolar(fixed(2)));
+
+  OrderedTaskSettings settings =
+    task_manager.GetOrderedTask().GetOrderedTaskSettings();
+  settings.aat_min_time = aat_min_time(scenario.test_num);
+  task_manager.SetOrderedTaskSettings(settings);
+
+  test_task(task_manager, waypoints, scenario.test_num);
+  /* test_task() does not calculate the OZ boundaries */
+  task_manager.GetFactory().UpdateGeometry();
+  waypoints.Clear();
+
+  task_manager.SetProfiler(&result.profiler);
+
+  AutopilotParameters parms;
+  parms.goto_target = goto_target;
+
+  TaskAccessor ta(task_manager, fixed(300));
+  TaskAutoPilot autopilot(parms);
+  AircraftSim aircraft;
+
+  autopilot.SetDefaultLocation(GeoPoint(Angle::Degrees(1), Angle::Degrees(0)));
+  autopilot.Start(ta);
+  aircraft.Start(autopilot.location_start, autopilot.location_previous,
+                 parms.start_alt);
+
+  do {
+    autopilot.UpdateState(ta, aircraft.GetState());
+    aircraft.Update(autopilot.heading);
+
+    const AircraftState state = aircraft.GetState();
+    const AircraftState state_last = aircraft.GetLastState();
+
+    uint64_t allocations = n_allocations;
+    uint64_t start = BenchmarkClockUS();
+    task_manager.Update(state, state_last);
+    uint64_t end = BenchmarkClockUS();
+    result.update.Add(end - start, n_allocations - allocations);
+
+    allocations = n_allocations;
+    start = end;
+    task_manager.UpdateIdle(state);
+    task_manager.UpdateAutoMC(state, fixed(0));
+    end = BenchmarkClockUS();
+    result.update_idle.Add(end - start, n_allocations - allocations);
+
+    ++result.samples;
+  } while (autopilot.UpdateAutopilot(ta, aircraft.GetState()));
+
+  task_manager.SetProfiler(nullptr);
+}
+
+static void
+WriteCounter(TextWriter &writer, const Counter &counter, unsigned samples)
+{
+  JSON::ObjectWriter object(writer);
+  object.WriteElement("calls", JSON::WriteLong, (long)counter.calls);
+  object.WriteElement("us", JSON::WriteLong, (long)counter.us);
+  object.BeginElement("us_per_sample");
+  writer.Format("%.3f", double(counter.us) / samples);
+  object.EndElement();
+  object.WriteElement("allocations", JSON::WriteLong,
+                      (long)counter.allocations);
+}
+
+static void
+WriteStages(TextWriter &writer, const BenchmarkProfiler &profiler,
+            unsigned samples)
+{
+  JSON::ObjectWriter object(writer);
+  for (unsigned i = 0; i < N_STAGES; ++i)
+    object.WriteElement(stage_names[i], WriteCounter,
+                        profiler.stages[i], samples);
+}
+
+static void
+WriteScenario(TextWriter &writer, const Scenario &scenario,
+              const Result &result)
+{
+  JSON::ObjectWriter object(writer);
+  object.WriteElement("name", JSON::WriteString, scenario.name);
+  object.WriteElement("samples", JSON::WriteUnsigned, result.samples);
+  object.WriteElement("update", WriteCounter,
+                      result.update, result.samples);
+  object.WriteElement("update_idle", WriteCounter,
+                      result.update_idle, result.samples);
+  object.WriteElement("stages", WriteStages,
+                      result.profiler, result.samples);
+}
+
+int main(int argc, char **argv)
+{
+  if (!ParseArgs(argc, argv))
+    return 0;
+
+  static_assert(ARRAY_SIZE(stage_names) == N_STAGES, "");
+
+  TextWriter writer("/dev/stdout", true);
+
+  {
+    JSON::ObjectWriter root(writer);
+    root.BeginElement("scenarios");
+
+    {
+      JSON::ArrayWriter array(writer);
+      for (const Scenario &scenario : scenarios) {
+        Result result;
+        Fly(scenario, result);
+
+        array.BeginElement();
+        WriteScenario(writer, scenario, result);
+        array.EndElement();
+      }
+    }
+
+    root.EndElement();
+  }
+
+  writer.NewLine();
+  return 0;
+}
@@ -30,20 +30,27 @@ Copyright_License {
 
 DebugReplay::DebugReplay()
   :glide_polar(fixed(1))
+{
+  Reset();
+
+  qnh = AtmosphericPressure::Standard();
+}
+
+DebugReplay::~DebugReplay()
+{
+}
+
+void
+DebugReplay::Reset()
 {
   raw_basic.Reset();
   computed_basic.Reset();
+  last_basic.Reset();
   calculated.Reset();
 
   flying_computer.Reset();
 
   wrap_clock.Reset();
-
-  qnh = AtmosphericPressure::Standard();
-}
-
-DebugReplay::~DebugReplay()
-{
 }
 
 void
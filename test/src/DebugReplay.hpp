@@ -70,6 +70,17 @@ public:
   virtual long Tell() const = 0;
   virtual bool Next() = 0;
 
+  /**
+   * Continue at the first fix at or after the specified time of day.
+   * All calculated values are reset.
+   *
+   * @return false if seeking is not supported by this replay, or if
+   * there is no such fix
+   */
+  virtual bool Seek(fixed time) {
+    return false;
+  }
+
   /* Return a detail level for this fix - only used for skylines */
   virtual int Level() const {
     return 0;
@@ -100,6 +111,11 @@ public:
   }
 
 protected:
+  /**
+   * Clear all parsed and calculated values.
+   */
+  void Reset();
+
   void Compute();
 };
 
@@ -72,6 +72,36 @@ DebugReplayIGC::Next()
   return false;
 }
 
+bool
+DebugReplayIGC::Seek(fixed time)
+{
+  if (!indexed) {
+    const long position = reader->Tell();
+    if (reader->Rewind())
+      index.Build(*reader);
+    reader->Seek(position);
+    indexed = true;
+  }
+
+  const unsigned i = index.Find(positive(time) ? (unsigned)time : 0u);
+  if (i >= index.size() || !reader->Seek(index[i].offset))
+    return false;
+
+  Reset();
+  extensions = index.GetExtensions();
+
+  /* the date is declared only in the header */
+  BrokenDate date = index.GetDate();
+  if (date.IsPlausible()) {
+    for (unsigned day = index[i].time / (24 * 3600); day > 0; --day)
+      date.IncrementDay();
+
+    (BrokenDate &)raw_basic.date_time_utc = date;
+  }
+
+  return true;
+}
+
 void
 DebugReplayIGC::CopyFromFix(const IGCFix &fix)
 {
@@ -26,6 +26,7 @@ Copyright_License {
 
 #include "DebugReplayFile.hpp"
 #include "IGC/IGCExtensions.hpp"
+#include "IGC/IGCIndex.hpp"
 #include "IO/FileLineReader.hpp"
 
 struct IGCFix;
@@ -33,14 +34,22 @@ struct IGCFix;
 class DebugReplayIGC : public DebugReplayFile {
   IGCExtensions extensions;
 
+  /**
+   * The time index of the file, built by the first Seek() call.
+   */
+  IGCIndex index;
+
+  bool indexed;
+
 private:
   DebugReplayIGC(FileLineReaderA *_reader)
-    : DebugReplayFile(_reader) {
+    : DebugReplayFile(_reader), indexed(false) {
     extensions.clear();
   }
 
 public:
   virtual bool Next();
+  virtual bool Seek(fixed time) override;
 
   static DebugReplay* Create(const char *input_file);
 
@@ -22,26 +22,43 @@
 
 #include "FLARM/FlarmNetReader.hpp"
 #include "FLARM/FlarmNetDatabase.hpp"
+#include "FLARM/FlarmNetRecord.hpp"
+#include "IO/FileCache.hpp"
 #include "OS/Args.hpp"
 
+#include <stdio.h>
 #include <stdlib.h>
 
 int main(int argc, char **argv)
 {
-  Args args(argc, argv, "FILE");
+  Args args(argc, argv, "FILE [CACHE_DIR]");
   tstring path = args.ExpectNextT();
+  tstring cache_path;
+  if (!args.IsEmpty())
+    cache_path = args.ExpectNextT();
   args.ExpectEnd();
 
   FlarmNetDatabase database;
-  FlarmNetReader::LoadFile(path.c_str(), database);
 
-  for (auto i = database.begin(), end = database.end(); i != end; ++i) {
-    const FlarmNetRecord &record = i->second;
+  if (!cache_path.empty()) {
+    /* load the compact image from the cache, build it on a miss */
+    FileCache cache(cache_path.c_str());
+    if (database.LoadCache(cache, _T("flarmnet"), path.c_str())) {
+      fprintf(stderr, "Loaded %u records from cache\n", database.GetSize());
+    } else {
+      FlarmNetReader::LoadFile(path.c_str(), database);
+      if (!database.SaveCache(cache, _T("flarmnet"), path.c_str()) ||
+          !database.LoadCache(cache, _T("flarmnet"), path.c_str()))
+        fprintf(stderr, "Failed to write the cache\n");
+      fprintf(stderr, "Parsed %u records\n", database.GetSize());
+    }
+  } else
+    FlarmNetReader::LoadFile(path.c_str(), database);
 
+  for (const FlarmNetRecord &record : database)
     _tprintf(_T("%s\t%s\t%s\t%s\n"),
              record.id.c_str(), record.pilot.c_str(),
              record.registration.c_str(), record.callsign.c_str());
-  }
 
   return EXIT_SUCCESS;
 }
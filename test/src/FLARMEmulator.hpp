@@ -28,6 +28,7 @@ Copyright_License {
 #include "Device/Util/LineSplitter.hpp"
 #include "Device/Driver/FLARM/BinaryProtocol.hpp"
 #include "Device/Util/NMEAWriter.hpp"
+#include "FLARM/Traffic.hpp"
 #include "NMEA/InputLine.hpp"
 #include "NMEA/Checksum.hpp"
 #include "Util/Macros.hpp"
@@ -50,6 +51,28 @@ public:
     handler = this;
   }
 
+  /**
+   * Send a "$PFLAA" sentence describing the given target, like a
+   * FLARM which receives it.  Only the attributes which are part of
+   * the sentence are used.
+   */
+  void SendPFLAA(const FlarmTraffic &traffic) {
+    char id[16];
+    char buffer[128];
+    snprintf(buffer, ARRAY_SIZE(buffer),
+             "PFLAA,%u,%d,%d,%d,2,%s,%d,%.1f,%d,%.1f,%u",
+             (unsigned)traffic.alarm_level,
+             (int)traffic.relative_north, (int)traffic.relative_east,
+             (int)fixed(traffic.relative_altitude),
+             traffic.id.Format(id),
+             (int)Angle(traffic.track).AsBearing().Degrees(),
+             (double)traffic.turn_rate,
+             (int)fixed(traffic.speed),
+             (double)traffic.climb_rate,
+             (unsigned)traffic.type);
+    PortWriteNMEA(*port, buffer, *env);
+  }
+
 private:
   void PFLAC_S(NMEAInputLine &line) {
     char name[64];
@@ -78,6 +78,11 @@ int main(int argc, char **argv)
 
   args.ExpectEnd();
 
+  if (start >= 0)
+    /* skip the beginning of the file without calculating it, if the
+       replay supports that */
+    replay->Seek(fixed(start));
+
   Trace trace(0, Trace::null_time, max_points);
 
   bool takeoff = false;
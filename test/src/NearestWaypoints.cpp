@@ -27,9 +27,11 @@ Copyright_License {
 #include "OS/ConvertPathName.hpp"
 #include "OS/Args.hpp"
 #include "Operation/Operation.hpp"
+#include "BenchmarkClock.hpp"
 
 #include <stdint.h>
 #include <stdio.h>
+#include <stdlib.h>
 #include <tchar.h>
 
 static bool
@@ -98,24 +100,26 @@ IsAirport(const Waypoint &waypoint)
   return waypoint.IsAirport();
 }
 
-static const Waypoint *
-GetNearestWaypoint(const GeoPoint &location, const Waypoints &waypoints,
-                   fixed range, WaypointType type)
+typedef bool (*WaypointPredicate)(const Waypoint &);
+
+static WaypointPredicate
+GetPredicate(WaypointType type)
 {
-  bool (*predicate)(const Waypoint &);
   switch (type) {
   case WaypointType::AIRPORT:
-    predicate = IsAirport;
-    break;
+    return IsAirport;
   case WaypointType::LANDABLE:
-    predicate = IsLandable;
-    break;
+    return IsLandable;
   default:
-    predicate = AlwaysTrue;
-    break;
+    return AlwaysTrue;
   }
+}
 
-  return waypoints.GetNearestIf(location, range, predicate);
+static const Waypoint *
+GetNearestWaypoint(const GeoPoint &location, const Waypoints &waypoints,
+                   fixed range, WaypointType type)
+{
+  return waypoints.GetNearestIf(location, range, GetPredicate(type));
 }
 
 static void
@@ -131,10 +135,80 @@ PrintWaypoint(const Waypoint *waypoint)
               waypoint->name.c_str());
 }
 
+class CountingVisitor : public WaypointVisitor {
+public:
+  unsigned count;
+
+  CountingVisitor():count(0) {}
+
+  virtual void Visit(const Waypoint &wp) override {
+    ++count;
+  }
+};
+
+/**
+ * Run random queries within the bounds of the waypoint file and print
+ * the average duration of each lookup type.
+ */
+static void
+Benchmark(const Waypoints &waypoints, fixed range, WaypointType type,
+          unsigned n_nearest, unsigned n_queries)
+{
+  GeoPoint min = waypoints.begin()->location, max = min;
+  for (const auto &wp : waypoints) {
+    min.latitude = std::min(min.latitude, wp.location.latitude);
+    min.longitude = std::min(min.longitude, wp.location.longitude);
+    max.latitude = std::max(max.latitude, wp.location.latitude);
+    max.longitude = std::max(max.longitude, wp.location.longitude);
+  }
+
+  GeoPoint *locations = new GeoPoint[n_queries];
+  srand(42);
+  for (unsigned i = 0; i < n_queries; ++i) {
+    const fixed x = fixed(rand()) / RAND_MAX, y = fixed(rand()) / RAND_MAX;
+    locations[i].latitude = min.latitude.Fraction(max.latitude, y);
+    locations[i].longitude = min.longitude.Fraction(max.longitude, x);
+  }
+
+  const WaypointPredicate predicate = GetPredicate(type);
+  const Waypoint **nearest = new const Waypoint *[n_nearest];
+  unsigned found = 0;
+
+  uint64_t start = BenchmarkClockUS();
+  for (unsigned i = 0; i < n_queries; ++i)
+    if (waypoints.GetNearestIf(locations[i], range, predicate) != nullptr)
+      ++found;
+  uint64_t end = BenchmarkClockUS();
+  printf("nearest: %.2f us/query, %u found\n",
+         double(end - start) / n_queries, found);
+
+  found = 0;
+  start = BenchmarkClockUS();
+  for (unsigned i = 0; i < n_queries; ++i)
+    found += waypoints.GetNearestIf(locations[i], range, predicate,
+                                    nearest, n_nearest);
+  end = BenchmarkClockUS();
+  printf("%u nearest: %.2f us/query, %u found\n",
+         n_nearest, double(end - start) / n_queries, found);
+
+  CountingVisitor visitor;
+  start = BenchmarkClockUS();
+  for (unsigned i = 0; i < n_queries; ++i)
+    waypoints.VisitWithinRange(locations[i], range, visitor);
+  end = BenchmarkClockUS();
+  printf("within range: %.2f us/query, %u found\n",
+         double(end - start) / n_queries, visitor.count);
+
+  delete[] nearest;
+  delete[] locations;
+}
+
 int main(int argc, char **argv)
 {
   WaypointType type = WaypointType::ALL;
   fixed range = fixed(100000);
+  unsigned n_nearest = 1;
+  unsigned n_benchmark = 0;
 
   Args args(argc, argv,
             "PATH\n\nPATH is expected to be any compatible waypoint file.\n"
@@ -144,7 +218,9 @@ int main(int argc, char **argv)
             "2.12343 34.38432\n"
             "65.18234 -173.48307\n\n"
             "Output is in the format: LAT LON ELEV (in m) NAME\n\ne.g.\n"
-            "50.823055 6.186384 189 Aachen Merzbruc");
+            "50.823055 6.186384 189 Aachen Merzbruc\n\n"
+            "--count=N prints the N nearest waypoints of each location.\n"
+            "--benchmark=N runs N random queries instead of reading stdin.");
 
   const char *arg;
   while ((arg = args.PeekNext()) != NULL && *arg == '-') {
@@ -155,6 +231,10 @@ int main(int argc, char **argv)
       double _range = strtod(value, NULL);
       if (_range > 0)
         range = fixed(_range);
+    } else if ((value = StringAfterPrefix(arg, "--count=")) != NULL) {
+      n_nearest = std::max(1l, strtol(value, NULL, 10));
+    } else if ((value = StringAfterPrefix(arg, "--benchmark=")) != NULL) {
+      n_benchmark = std::max(1l, strtol(value, NULL, 10));
     } else if (StringStartsWith(arg, "--airports-only")) {
       type = WaypointType::AIRPORT;
     } else if (StringStartsWith(arg, "--landables-only")) {
@@ -171,6 +251,14 @@ int main(int argc, char **argv)
   if (!LoadWaypoints(path, waypoints))
     return EXIT_FAILURE;
 
+  if (n_benchmark > 0) {
+    if (!waypoints.IsEmpty())
+      Benchmark(waypoints, range, type, n_nearest, n_benchmark);
+    return EXIT_SUCCESS;
+  }
+
+  const Waypoint **nearest = new const Waypoint *[n_nearest];
+
   char buffer[1024];
   const char *line;
   while ((line = fgets(buffer, sizeof(buffer) - 3, stdin)) != NULL) {
@@ -178,10 +266,22 @@ int main(int argc, char **argv)
     if (!ParseGeopoint(line, location))
       continue;
 
-    const Waypoint *waypoint = GetNearestWaypoint(location, waypoints,
-                                                  range, type);
-    PrintWaypoint(waypoint);
+    if (n_nearest == 1) {
+      const Waypoint *waypoint = GetNearestWaypoint(location, waypoints,
+                                                    range, type);
+      PrintWaypoint(waypoint);
+      continue;
+    }
+
+    const unsigned n = waypoints.GetNearestIf(location, range,
+                                              GetPredicate(type),
+                                              nearest, n_nearest);
+    for (unsigned i = 0; i < n; ++i)
+      PrintWaypoint(nearest[i]);
+    printf("\n");
   }
 
+  delete[] nearest;
+
   return EXIT_SUCCESS;
 }
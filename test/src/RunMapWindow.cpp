@@ -167,7 +167,7 @@ LoadFiles(PlacesOfInterestSettings &poi_settings,
 
   terrain = RasterTerrain::OpenTerrain(NULL, operation);
 
-  WaypointGlue::LoadWaypoints(way_points, terrain, operation);
+  WaypointGlue::LoadWaypoints(way_points, terrain, nullptr, operation);
   WaypointGlue::SetHome(way_points, terrain, poi_settings, team_code_settings,
                         NULL, false);
 
@@ -26,6 +26,9 @@ Copyright_License {
 #include "Engine/Waypoint/WaypointVisitor.hpp"
 #include "OS/Args.hpp"
 #include "Operation/Operation.hpp"
+#include "BenchmarkClock.hpp"
+
+#include <algorithm>
 
 #include <stdio.h>
 #include <tchar.h>
@@ -55,13 +58,21 @@ int main(int argc, char **argv)
   }
 
   NullOperationEnvironment operation;
+  const uint64_t start = BenchmarkClockUS();
   if (!parser.Parse(way_points, operation)) {
     fprintf(stderr, "WayPointParser::Parse() has failed\n");
     return EXIT_FAILURE;
   }
 
+  const uint64_t parsed = BenchmarkClockUS();
   way_points.Optimise();
+  const uint64_t optimised = BenchmarkClockUS();
+
   printf("Size %d\n", way_points.size());
+  printf("Parse time %.3f s (%.0f waypoints/s), optimise time %.3f s\n",
+         (parsed - start) / 1000000.,
+         way_points.size() * 1000000. / std::max(parsed - start, uint64_t(1)),
+         (optimised - parsed) / 1000000.);
 
   DumpVisitor visitor;
   way_points.VisitNamePrefix(_T(""), visitor);
@@ -0,0 +1,104 @@
+/* Copyright_License {
+
+  XCSoar Glide Computer - http://www.xcsoar.org/
+  Copyright (C) 2000-2014 The XCSoar Project
+  A detailed list of copyright holders can be found in the file "AUTHORS".
+
+  This program is free software; you can redistribute it and/or
+  modify it under the terms of the GNU General Public License
+  as published by the Free Software Foundation; either version 2
+  of the License, or (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+}
+*/
+
+#ifndef XCSOAR_SYNTHETIC_TERRAIN_HPP
+#define XCSOAR_SYNTHETIC_TERRAIN_HPP
+
+#include "Terrain/RasterTileCache.hpp"
+
+#include <math.h>
+
+/**
+ * A #RasterTileCache filled with generated terrain, for tests and
+ * benchmarks which shall not depend on a terrain file.  It contains
+ * hills, water and a few invalid patches, and some of its tiles are
+ * "loaded" while the others fall back to the overview.
+ */
+class SyntheticRasterTileCache : public RasterTileCache {
+  unsigned random_state;
+
+public:
+  explicit SyntheticRasterTileCache(unsigned seed=1)
+    :random_state(seed) {}
+
+  unsigned Random() {
+    /* xorshift; good enough and reproducible on all platforms */
+    random_state ^= random_state << 13;
+    random_state ^= random_state >> 17;
+    random_state ^= random_state << 5;
+    return random_state;
+  }
+
+  /**
+   * @param tile_size the width and height of each tile
+   * @param load_percent the percentage of tiles to be loaded
+   */
+  void Generate(unsigned tile_columns, unsigned tile_rows,
+                unsigned tile_size, unsigned load_percent) {
+    const unsigned _width = tile_columns * tile_size;
+    const unsigned _height = tile_rows * tile_size;
+
+    SetSize(_width, _height, tile_size, tile_size, tile_columns, tile_rows);
+
+    short *const o = GetOverview();
+    const unsigned overview_width = _width >> 4;
+    for (unsigned y = 0; y < (_height >> 4); ++y)
+      for (unsigned x = 0; x < overview_width; ++x)
+        o[y * overview_width + x] = Height(x << 4, y << 4);
+
+    for (unsigned row = 0, i = 0; row < tile_rows; ++row) {
+      for (unsigned column = 0; column < tile_columns; ++column, ++i) {
+        const unsigned xstart = column * tile_size;
+        const unsigned ystart = row * tile_size;
+        SetTile(i, xstart, ystart, xstart + tile_size, ystart + tile_size);
+
+        if (Random() % 100 >= load_percent)
+          continue;
+
+        tiles.GetLinear(i).SetRequest();
+        short *const p = GetImageBuffer(i);
+        for (unsigned y = 0; y < tile_size; ++y)
+          for (unsigned x = 0; x < tile_size; ++x)
+            p[y * tile_size + x] = Height(xstart + x, ystart + y);
+        tiles.GetLinear(i).ClearRequest();
+      }
+    }
+
+    SetInitialised(true);
+  }
+
+private:
+  short Height(unsigned x, unsigned y) {
+    const double h = 600 + 500 * sin(x / 41.) * cos(y / 67.)
+      + 300 * sin((x + 2 * y) / 23.) + Random() % 40;
+
+    if (h < 150)
+      return RasterBuffer::TERRAIN_WATER_THRESHOLD;
+
+    if (h > 1370 && Random() % 8 == 0)
+      return RasterBuffer::TERRAIN_INVALID;
+
+    return (short)h;
+  }
+};
+
+#endif
@@ -27,6 +27,8 @@
 #include "Engine/Task/Ordered/Points/StartPoint.hpp"
 #include "Engine/Task/Ordered/Points/FinishPoint.hpp"
 #include "Engine/Task/ObservationZones/CylinderZone.hpp"
+#include "Engine/Task/Solvers/TaskTargetSweep.hpp"
+#include "Engine/Navigation/Aircraft.hpp"
 #include "Geo/Flat/TaskProjection.hpp"
 #include "TestUtil.hpp"
 
@@ -137,15 +139,72 @@ TestAATPoint()
   }
 }
 
+static void
+TestEvaluateTargets()
+{
+  OrderedTask task(task_behaviour);
+  task.Append(StartPoint(new CylinderZone(wp1.location, fixed(500)), wp1,
+                         task_behaviour,
+                         ordered_task_settings.start_constraints));
+  task.Append(AATPoint(new CylinderZone(wp2.location, fixed(10000)), wp2,
+                       task_behaviour));
+  task.Append(FinishPoint(new CylinderZone(wp3.location, fixed(500)), wp3,
+                          task_behaviour,
+                          ordered_task_settings.finish_constraints));
+  task.SetActiveTaskPoint(1);
+  task.UpdateGeometry();
+  ok1(task.CheckTask());
+
+  AircraftState aircraft;
+  aircraft.Reset();
+  aircraft.location = wp1.location;
+  aircraft.altitude = fixed(1000);
+  task.Update(aircraft, aircraft, glide_polar);
+
+  const AATPoint &ap = (const AATPoint &)task.GetPoint(1);
+  const GeoPoint target = ap.GetTargetLocation();
+  const fixed distance = task.GetStats().total.remaining.GetDistance();
+
+  const RangeAndRadial settings[] = {
+    { fixed(0), Angle::Zero() },
+    { fixed(1), Angle::QuarterCircle() },
+    { fixed(0.5), Angle::QuarterCircle() },
+  };
+
+  TargetSweepResult results[3];
+  ok1(!task.EvaluateTargets(0, aircraft, glide_polar, settings, 3, results));
+  ok1(!task.EvaluateTargets(2, aircraft, glide_polar, settings, 3, results));
+  ok1(task.EvaluateTargets(1, aircraft, glide_polar, settings, 3, results));
+
+  ok1(equals(results[0].location, wp2.location));
+  ok1(results[0].solution.IsOk());
+  ok1(results[1].solution.IsOk());
+  ok1(results[2].solution.IsOk());
+
+  /* moving the target sideways makes the task longer */
+  ok1(results[1].solution.vector.distance >
+      results[2].solution.vector.distance);
+  ok1(results[2].solution.vector.distance >
+      results[0].solution.vector.distance);
+  ok1(results[1].solution.time_elapsed > results[2].solution.time_elapsed);
+  ok1(results[2].solution.time_elapsed > results[0].solution.time_elapsed);
+
+  /* the task is unchanged */
+  ok1(equals(ap.GetTargetLocation(), target));
+  task.Update(aircraft, aircraft, glide_polar);
+  ok1(equals(task.GetStats().total.remaining.GetDistance(), distance));
+}
+
 static void
 TestAll()
 {
   TestAATPoint();
+  TestEvaluateTargets();
 }
 
 int main(int argc, char **argv)
 {
-  plan_tests(717);
+  plan_tests(731);
 
   task_behaviour.SetDefaults();
   ordered_task_settings.SetDefaults();
@@ -345,6 +345,23 @@ TestBlueFly()
   ok1(equals(nmea_info.battery_level, 37.0));
 
   delete device;
+
+  /* the same samples, queued and applied in one batch */
+  device = bluefly_driver.CreateOnPort(dummy_config, null);
+  ok1(device != NULL);
+
+  nmea_info.Reset();
+  nmea_info.clock = fixed(1);
+
+  for (unsigned i = 0; i < 6; ++i)
+    ok1(device->QueueSample("PRS 00017CBA"));
+  ok1(!device->QueueSample("BAT 1068"));
+  ok1(device->ConsumeSamples(nmea_info));
+  ok1(nmea_info.static_pressure_available);
+  ok1(equals(nmea_info.static_pressure.GetPascal(), 97466));
+  ok1(!device->ConsumeSamples(nmea_info));
+
+  delete device;
 }
 
 static void
@@ -1435,7 +1452,7 @@ TestFlightList(const struct DeviceRegister &driver)
 
 int main(int argc, char **argv)
 {
-  plan_tests(754);
+  plan_tests(766);
 
   TestGeneric();
   TestTasman();
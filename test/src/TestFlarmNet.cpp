@@ -24,14 +24,118 @@
 #include "FLARM/FlarmNetReader.hpp"
 #include "FLARM/FlarmNetRecord.hpp"
 #include "FLARM/FlarmId.hpp"
+#include "IO/FileCache.hpp"
 #include "TestUtil.hpp"
 
+#include <algorithm>
+
+#include <stdio.h>
+
+static const TCHAR *const path = _T("test/data/flarmnet/data.fln");
+static const TCHAR *const cache_name = _T("flarmnet");
+
+/**
+ * Read the image which was stored in the #FileCache by
+ * FlarmNetDatabase::SaveCache().
+ */
+static bool
+ReadCache(FileCache &cache, AllocatedArray<uint32_t> &image)
+{
+  FILE *file = cache.Load(cache_name, path);
+  if (file == nullptr)
+    return false;
+
+  /* Load() has skipped the header of the cache file */
+  const long offset = ftell(file);
+  fseek(file, 0, SEEK_END);
+  const long size = ftell(file) - offset;
+  fseek(file, offset, SEEK_SET);
+
+  /* the image was stored without its padding */
+  image.ResizeDiscard((size + sizeof(uint32_t) - 1) / sizeof(uint32_t));
+  std::fill(image.begin(), image.end(), 0);
+  const bool success = fread(image.begin(), 1, size, file) == size_t(size);
+  fclose(file);
+  return success;
+}
+
+/**
+ * Replace the cached image with the given (broken) one.
+ */
+static bool
+WriteCache(FileCache &cache, const uint32_t *data, size_t n)
+{
+  FILE *file = cache.Save(cache_name, path);
+  if (file == nullptr)
+    return false;
+
+  if (fwrite(data, sizeof(*data), n, file) != n) {
+    cache.Cancel(cache_name, file);
+    return false;
+  }
+
+  return cache.Commit(cache_name, file);
+}
+
+static void
+TestCache(const FlarmNetDatabase &db)
+{
+  const FlarmId id = FlarmId::Parse("DDA85C", NULL);
+
+  FileCache cache(_T("output/test-flarmnet"));
+  cache.Flush(cache_name);
+
+  FlarmNetDatabase db2;
+  ok1(!db2.LoadCache(cache, cache_name, path));
+  ok1(db.SaveCache(cache, cache_name, path));
+
+  /* re-open the mapped cache */
+  ok1(db2.LoadCache(cache, cache_name, path));
+  ok1(db2.GetSize() == 6);
+  const FlarmNetRecord *record = db2.FindRecordById(id);
+  ok1(record != NULL && _tcscmp(record->pilot, _T("Tobias Bieniek")) == 0);
+  record = db2.FindFirstRecordByCallSign(_T("TH"));
+  ok1(record != NULL && _tcscmp(record->callsign, _T("TH")) == 0);
+
+  AllocatedArray<uint32_t> image;
+  ok1(ReadCache(cache, image) && image.size() > 2);
+
+  /* a truncated image is rejected */
+  AllocatedArray<uint32_t> truncated(image.size() - 1);
+  std::copy(image.begin(), image.begin() + truncated.size(),
+            truncated.begin());
+  FlarmNetDatabase db3;
+  ok1(!db3.SetImage(std::move(truncated)));
+  ok1(db3.IsEmpty());
+
+  /* a corrupt cache file is rejected, discarded and the database
+     keeps its old contents */
+  AllocatedArray<uint32_t> corrupt(image);
+  corrupt[2] = 0xffffff; /* n_records */
+  ok1(WriteCache(cache, corrupt.begin(), corrupt.size()));
+  ok1(!db2.LoadCache(cache, cache_name, path));
+  ok1(db2.GetSize() == 6);
+  ok1(db2.FindRecordById(id) != NULL);
+
+  FILE *file = cache.Load(cache_name, path);
+  ok1(file == nullptr);
+  if (file != nullptr)
+    fclose(file);
+
+  /* the intact image is accepted */
+  ok1(db3.SetImage(std::move(image)));
+  ok1(db3.GetSize() == 6);
+  ok1(db3.FindRecordById(id) != NULL);
+
+  cache.Flush(cache_name);
+}
+
 int main(int argc, char **argv)
 {
-  plan_tests(15);
+  plan_tests(43);
 
   FlarmNetDatabase db;
-  int count = FlarmNetReader::LoadFile(_T("test/data/flarmnet/data.fln"), db);
+  int count = FlarmNetReader::LoadFile(path, db);
   ok1(count == 6);
 
   FlarmId id = FlarmId::Parse("DDA85C", NULL);
@@ -76,5 +180,46 @@ int main(int argc, char **argv)
   ok1(foundDDA85C);
   ok1(foundDDA896);
 
+  /* prefix search is sorted by callsign */
+  ok1(db.FindIdsByCallSignPrefix(_T("T"), ids, 3) == 2);
+  ok1(db.FindIdsByCallSignPrefix(_T("M"), ids, 3) == 1);
+  ok1(ids[0] == FlarmId::Parse("DDA857", NULL));
+  ok1(db.FindIdsByCallSignPrefix(_T("X"), ids, 3) == 0);
+  ok1(db.FindIdsByCallSignPrefix(_T(""), ids, 3) == 3);
+
+  /* records are sorted by id, the file is iterated in that order */
+  unsigned n = 0;
+  FlarmId previous = FlarmId::Undefined();
+  bool sorted = true;
+  for (const FlarmNetRecord &i : db) {
+    if (previous.IsDefined() && !(previous < i.GetId()))
+      sorted = false;
+    previous = i.GetId();
+    ++n;
+  }
+  ok1(n == 6);
+  ok1(sorted);
+
+  /* duplicate ids: the first record wins */
+  FlarmNetDatabaseBuilder builder;
+  const TCHAR *const strings1[FlarmNetRecord::N_STRINGS] = {
+    _T("DDA85C"), _T("A"), _T(""), _T(""), _T(""), _T("AB"), _T(""),
+  };
+  const TCHAR *const strings2[FlarmNetRecord::N_STRINGS] = {
+    _T("DDA85C"), _T("B"), _T(""), _T(""), _T(""), _T("CD"), _T(""),
+  };
+  builder.Add(FlarmId::Parse("DDA85C", NULL), strings1);
+  builder.Add(FlarmId::Parse("DDA85C", NULL), strings2);
+  builder.Add(FlarmId::Undefined(), strings2);
+
+  FlarmNetDatabase db2;
+  ok1(builder.Finish(db2));
+  ok1(db2.GetSize() == 1);
+  record = db2.FindRecordById(id);
+  ok1(record != NULL && _tcscmp(record->pilot, _T("A")) == 0);
+  ok1(db2.FindFirstRecordByCallSign(_T("CD")) == NULL);
+
+  TestCache(db);
+
   return exit_status();
 }
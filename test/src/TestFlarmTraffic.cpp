@@ -0,0 +1,335 @@
+/* Copyright_License {
+
+  XCSoar Glide Computer - http://www.xcsoar.org/
+  Copyright (C) 2000-2014 The XCSoar Project
+  A detailed list of copyright holders can be found in the file "AUTHORS".
+
+  This program is free software; you can redistribute it and/or
+  modify it under the terms of the GNU General Public License
+  as published by the Free Software Foundation; either version 2
+  of the License, or (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+}
+*/
+
+#include "FLARMEmulator.hpp"
+#include "Device/Port/NullPort.hpp"
+#include "Device/Parser.hpp"
+#include "FLARM/FlarmComputer.hpp"
+#include "FLARM/List.hpp"
+#include "NMEA/Info.hpp"
+#include "Operation/Operation.hpp"
+#include "TestUtil.hpp"
+
+#include <stdio.h>
+
+/**
+ * A #Port which passes everything written to it to the NMEA parser.
+ */
+class ParserPort final : public NullPort, PortLineSplitter {
+  NMEAParser parser;
+  NMEAInfo &info;
+
+public:
+  explicit ParserPort(NMEAInfo &_info):info(_info) {}
+
+  virtual size_t Write(const void *data, size_t length) override {
+    PortLineSplitter::DataReceived(data, length);
+    return length;
+  }
+
+protected:
+  virtual void LineReceived(const char *line) override {
+    parser.ParseLine(line, info);
+  }
+};
+
+static FlarmId
+MakeId(unsigned i)
+{
+  char id[16];
+  sprintf(id, "%X", 0xDD0000 + i);
+  return FlarmId::Parse(id, nullptr);
+}
+
+/**
+ * Fill the list with targets scattered around the given location
+ * (within +/- the given number of degrees).  Every 7th target has no
+ * location.
+ */
+static void
+MakeList(TrafficList &traffic, const GeoPoint &center, double spread,
+         unsigned n=TrafficList::MAX_COUNT)
+{
+  traffic.Clear();
+
+  unsigned seed = 42;
+  for (unsigned i = 0; i < n; ++i) {
+    FlarmTraffic &t = *traffic.AllocateTraffic();
+    t.Clear();
+    t.id = MakeId(i);
+
+    seed = seed * 1103515245 + 12345;
+    const double dy = (int((seed >> 8) % 2001) - 1000) * spread / 1000;
+    seed = seed * 1103515245 + 12345;
+    const double dx = (int((seed >> 8) % 2001) - 1000) * spread / 1000;
+
+    t.location_available = i % 7 != 3;
+    t.location.latitude = center.latitude + Angle::Degrees(dy);
+    t.location.longitude =
+      (center.longitude + Angle::Degrees(dx)).AsDelta();
+  }
+
+  traffic.UpdateGrid();
+}
+
+/**
+ * The indices of the targets within range, determined by a linear
+ * scan.
+ */
+static uint32_t
+LinearMask(const TrafficList &traffic, const GeoPoint &location, fixed range)
+{
+  uint32_t mask = 0;
+  for (unsigned i = 0, n = traffic.list.size(); i < n; ++i)
+    if (traffic.list[i].location_available &&
+        location.Distance(traffic.list[i].location) < range)
+      mask |= 1u << i;
+  return mask;
+}
+
+/**
+ * The indices of the targets visited by
+ * TrafficList::VisitWithinRange(); a target visited twice sets all
+ * bits.
+ */
+static uint32_t
+VisitMask(const TrafficList &traffic, const GeoPoint &location, fixed range)
+{
+  uint32_t mask = 0;
+  bool duplicate = false;
+  traffic.VisitWithinRange(location, range,
+                           [&](const FlarmTraffic &t) {
+                             const uint32_t bit =
+                               1u << (&t - traffic.list.begin());
+                             if (mask & bit)
+                               duplicate = true;
+                             mask |= bit;
+                           });
+  return duplicate ? ~uint32_t(0) : mask;
+}
+
+/**
+ * Check whether the grid answers the query and whether
+ * VisitWithinRange() finds the same targets as a linear scan.
+ */
+static void
+CheckRange(const TrafficList &traffic, const GeoPoint &location, fixed range,
+           bool expect_grid)
+{
+  ok1(traffic.grid.Visit(location, range, [](unsigned){}) == expect_grid);
+  ok1(VisitMask(traffic, location, range) ==
+      LinearMask(traffic, location, range));
+}
+
+static void
+TestGrid()
+{
+  TrafficList traffic;
+
+  /* the common case */
+  const GeoPoint center(Angle::Degrees(7.7), Angle::Degrees(51.05));
+  MakeList(traffic, center, 0.02);
+  CheckRange(traffic, center, fixed(500), true);
+  CheckRange(traffic, center, fixed(1000), true);
+  CheckRange(traffic, center, fixed(2000), true);
+  ok1(LinearMask(traffic, center, fixed(2000)) != 0);
+
+  for (unsigned i = 0; i < 5; ++i)
+    CheckRange(traffic, traffic.list[i].location, fixed(1000), true);
+
+  /* too many cells: linear fallback */
+  CheckRange(traffic, center, fixed(20000), false);
+
+  /* targets on both sides of the date line */
+  const GeoPoint date_line(Angle::Degrees(179.999), Angle::Degrees(10));
+  MakeList(traffic, date_line, 0.01);
+  CheckRange(traffic, date_line, fixed(1000), false);
+
+  const uint32_t mask = LinearMask(traffic, date_line, fixed(1000));
+  bool crossed = false;
+  for (unsigned i = 0, n = traffic.list.size(); i < n; ++i)
+    if ((mask & (1u << i)) &&
+        negative(traffic.list[i].location.longitude.Native()))
+      crossed = true;
+  ok1(crossed);
+
+  CheckRange(traffic, GeoPoint(Angle::Degrees(179.98), Angle::Degrees(10)),
+             fixed(1000), true);
+
+  /* near the pole */
+  const GeoPoint pole(Angle::Degrees(0), Angle::Degrees(89.5));
+  MakeList(traffic, pole, 0.02);
+  CheckRange(traffic, pole, fixed(1000), false);
+
+  /* adding a target invalidates the grid */
+  MakeList(traffic, center, 0.02, TrafficList::MAX_COUNT - 1);
+  FlarmTraffic &t = *traffic.AllocateTraffic();
+  t.Clear();
+  t.id = MakeId(100);
+  t.location_available = true;
+  t.location = center;
+  CheckRange(traffic, center, fixed(1000), false);
+
+  traffic.UpdateGrid();
+  CheckRange(traffic, center, fixed(1000), true);
+}
+
+/**
+ * Compare the calculated attributes of two targets.
+ */
+gcc_pure
+static bool
+IsSameTraffic(const FlarmTraffic &a, const FlarmTraffic &b)
+{
+  return a.id == b.id && a.valid == b.valid &&
+    a.location_available == b.location_available &&
+    (!a.location_available || a.location == b.location) &&
+    a.altitude_available == b.altitude_available &&
+    (!a.altitude_available || fixed(a.altitude) == fixed(b.altitude)) &&
+    a.climb_rate_avg30s_available == b.climb_rate_avg30s_available &&
+    (!a.climb_rate_avg30s_available ||
+     a.climb_rate_avg30s == b.climb_rate_avg30s) &&
+    fixed(a.distance) == fixed(b.distance) &&
+    Angle(a.track).Native() == Angle(b.track).Native() &&
+    fixed(a.speed) == fixed(b.speed) &&
+    a.turn_rate == b.turn_rate && a.climb_rate == b.climb_rate &&
+    _tcscmp(a.name.c_str(), b.name.c_str()) == 0;
+}
+
+static FlarmTraffic
+MakeTarget(unsigned i, unsigned second)
+{
+  const fixed radius = fixed(300 + (i * 997) % 4700);
+  const Angle angle = Angle::Degrees(i * 37 + second * 9);
+
+  FlarmTraffic traffic;
+  traffic.Clear();
+  traffic.id = MakeId(i);
+  traffic.alarm_level = FlarmTraffic::AlarmType::NONE;
+  traffic.relative_north = radius * angle.cos();
+  traffic.relative_east = radius * angle.sin();
+  traffic.relative_altitude = fixed(int(i * 31) % 400 - 200);
+  traffic.track = (angle + Angle::QuarterCircle()).AsBearing();
+  traffic.turn_rate = fixed(9);
+  traffic.speed = fixed(25);
+  traffic.climb_rate = fixed(1.5);
+  traffic.type = FlarmTraffic::AircraftType::GLIDER;
+  return traffic;
+}
+
+/**
+ * Feed a synthetic "$PFLAA" sequence to two FlarmComputer instances
+ * the way the MergeThread does; one of them is invalidated before
+ * each cycle, i.e. it recalculates all targets like the
+ * non-incremental implementation did.
+ */
+static void
+TestIncremental()
+{
+  static constexpr unsigned N_SECONDS = 120;
+  static constexpr unsigned CYCLES_PER_SECOND = 7;
+  static constexpr unsigned N_TARGETS = 20;
+
+  NMEAInfo info;
+  info.Reset();
+
+  ParserPort port(info);
+  NullOperationEnvironment env;
+
+  FLARMEmulator emulator;
+  emulator.port = &port;
+  emulator.env = &env;
+
+  FlarmComputer incremental, full;
+  NMEAInfo basic1, basic2, last1, last2;
+  last1.Reset();
+  last2.Reset();
+
+  const GeoPoint origin(Angle::Degrees(7.7), Angle::Degrees(51.05));
+
+  unsigned n_compared = 0, n_different = 0;
+
+  for (unsigned second = 0; second < N_SECONDS; ++second) {
+    for (unsigned cycle = 0; cycle < CYCLES_PER_SECOND; ++cycle) {
+      info.clock = fixed(1 + second) + fixed(cycle) / CYCLES_PER_SECOND;
+
+      /* a new GPS fix each second, with a few gaps */
+      if (cycle == 0 && second % 17 != 5) {
+        info.ProvideTime(fixed(36000 + second));
+        info.location = origin;
+        info.location.latitude += Angle::Degrees(second * 0.0002);
+        info.location_available.Update(info.clock);
+        info.gps_altitude = fixed(1200 + second % 10);
+        info.gps_altitude_available.Update(info.clock);
+      }
+
+      /* some targets disappear for a while, and are re-added at
+         another position of the list */
+      for (unsigned i = cycle; i < N_TARGETS; i += CYCLES_PER_SECOND)
+        if ((second / 5 + i) % 9 != 0)
+          emulator.SendPFLAA(MakeTarget(i, second));
+
+      info.flarm.traffic.Expire(info.clock);
+
+      basic1 = info;
+      incremental.Process(basic1.flarm, last1.flarm, basic1);
+
+      basic2 = info;
+      full.Invalidate();
+      full.Process(basic2.flarm, last2.flarm, basic2);
+
+      if (cycle == 0) {
+        last1 = basic1;
+        last2 = basic2;
+      }
+
+      const TrafficList &list1 = basic1.flarm.traffic;
+      const TrafficList &list2 = basic2.flarm.traffic;
+      if (list1.list.size() != list2.list.size()) {
+        ++n_different;
+        continue;
+      }
+
+      for (unsigned i = 0, n = list1.list.size(); i < n; ++i) {
+        ++n_compared;
+        if (!IsSameTraffic(list1.list[i], list2.list[i]))
+          ++n_different;
+      }
+    }
+  }
+
+  ok1(n_compared > N_SECONDS * CYCLES_PER_SECOND);
+  ok1(n_different == 0);
+  ok1(incremental.GetReusedCount() > 0);
+  ok1(full.GetReusedCount() == 0);
+}
+
+int
+main(int argc, char **argv)
+{
+  plan_tests(34);
+
+  TestGrid();
+  TestIncremental();
+
+  return exit_status();
+}
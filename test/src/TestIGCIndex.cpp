@@ -0,0 +1,240 @@
+/* Copyright_License {
+
+  XCSoar Glide Computer - http://www.xcsoar.org/
+  Copyright (C) 2000-2014 The XCSoar Project
+  A detailed list of copyright holders can be found in the file "AUTHORS".
+
+  This program is free software; you can redistribute it and/or
+  modify it under the terms of the GNU General Public License
+  as published by the Free Software Foundation; either version 2
+  of the License, or (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+}
+*/
+
+
+#include "IGC/IGCIndex.hpp"
+#include "IGC/IGCParser.hpp"
+#include "IO/FileLineReader.hpp"
+#include "Replay/IgcReplay.hpp"
+#include "NMEA/Info.hpp"
+#include "Time/BrokenTime.hpp"
+#include "Util/Macros.hpp"
+#include "TestUtil.hpp"
+
+#include <string.h>
+
+static const char *const igc_path = "test/data/01lz1hq1.igc";
+
+/**
+ * A #NLineReader which reads from an array of strings; the "file
+ * position" is the line number.
+ */
+class ArrayLineReader : public NLineReader {
+  const char *const*lines;
+  unsigned n, i;
+
+  char buffer[256];
+
+public:
+  ArrayLineReader(const char *const*_lines, unsigned _n)
+    :lines(_lines), n(_n), i(0) {}
+
+  virtual char *ReadLine() override {
+    if (i >= n)
+      return nullptr;
+
+    strcpy(buffer, lines[i++]);
+    return buffer;
+  }
+
+  virtual long GetSize() const override {
+    return n;
+  }
+
+  virtual long Tell() const override {
+    return i;
+  }
+};
+
+static void
+TestMidnight()
+{
+  static const char *const lines[] = {
+    "HFDTE010114",
+    "I013638FXA",
+    "B2359580000000N00000000EA0000000000000",
+    "B2359590000000N00000000EA0000000000000",
+    "B0000000000000N00000000EA0000000000000",
+    "B0000010000000N00000000EA0000000000000",
+    /* time warp */
+    "B0000000000000N00000000EA0000000000000",
+    "Bxx",
+    "B0000020000000N00000000EA0000000000000",
+  };
+
+  ArrayLineReader reader(lines, ARRAY_SIZE(lines));
+
+  IGCIndex index;
+  ok1(index.Build(reader));
+  ok1(index.size() == 6);
+  ok1(index.GetDate() == BrokenDate(2014, 1, 1));
+  ok1(index.GetExtensions().size() == 1);
+
+  ok1(index.GetStartTime() == 86398);
+  ok1(index[2].time == 86400);
+  ok1(index[4].time == 86401);
+  ok1(index.GetEndTime() == 86402);
+
+  ok1(index[0].offset == 2);
+  ok1(index[5].offset == 8);
+
+  ok1(index.Find(0) == 0);
+  ok1(index.Find(86399) == 1);
+  ok1(index.Find(86401) == 3);
+  ok1(index.Find(86402) == 5);
+  ok1(index.Find(90000) == index.size());
+
+  IGCIndex::Window windows[10];
+  ok1(index.Split(windows, 4) == 4);
+  ok1(windows[0].begin == 2 && windows[0].end == 3);
+  ok1(windows[3].begin == 6 && windows[3].end == -1);
+  ok1(windows[3].start_time == 86401 && windows[3].end_time == 86402);
+  ok1(index.Split(windows, 10) == 6);
+}
+
+static bool
+ReadTime(const char *line, unsigned &time)
+{
+  BrokenTime bt;
+  if (line[0] != 'B' || !IGCParseTime(line + 1, bt))
+    return false;
+
+  time = bt.GetSecondOfDay();
+  return true;
+}
+
+static void
+TestFile(const IGCIndex &index)
+{
+  ok1(index.size() == 4960);
+  ok1(index.GetStartTime() == 26 * 60 + 5);
+  ok1(index.GetEndTime() == 5 * 3600 + 55 * 60 + 29);
+  ok1(index.GetExtensions().size() == 2);
+  ok1(index.GetDate() == BrokenDate(2010, 1, 21));
+
+  FileLineReaderA reader(igc_path);
+
+  for (unsigned t : { 0u, 1565u, 10000u, 21329u }) {
+    const unsigned i = index.Find(t);
+    const char *line;
+    unsigned time;
+    ok1(i < index.size() && index[i].time >= t &&
+        (i == 0 || index[i - 1].time < t) &&
+        reader.Seek(index[i].offset) &&
+        (line = reader.ReadLine()) != nullptr &&
+        ReadTime(line, time) && time == index[i].time);
+  }
+
+  ok1(index.Find(21330) == index.size());
+}
+
+static void
+TestWindows(const IGCIndex &index)
+{
+  unsigned n_fixes = 0, checksum = 0;
+
+  FileLineReaderA reader(igc_path);
+  const char *line;
+  unsigned time;
+  while ((line = reader.ReadLine()) != nullptr) {
+    if (ReadTime(line, time)) {
+      ++n_fixes;
+      checksum = checksum * 31 + time;
+    }
+  }
+
+  ok1(n_fixes == index.size());
+
+  constexpr unsigned N = 4;
+  IGCIndex::Window windows[N];
+  ok1(index.Split(windows, N) == N);
+
+  /* each window can be read independently, e.g. by a separate
+     thread */
+  unsigned window_fixes = 0, window_checksum = 0;
+  bool contiguous = true;
+  for (unsigned i = 0; i < N; ++i) {
+    const IGCIndex::Window &w = windows[i];
+    if (i + 1 < N && w.end != windows[i + 1].begin)
+      contiguous = false;
+
+    FileLineReaderA window_reader(igc_path);
+    if (!window_reader.Seek(w.begin))
+      continue;
+
+    while ((w.end < 0 || window_reader.Tell() < w.end) &&
+           (line = window_reader.ReadLine()) != nullptr) {
+      if (ReadTime(line, time)) {
+        ++window_fixes;
+        window_checksum = window_checksum * 31 + time;
+      }
+    }
+  }
+
+  ok1(contiguous);
+  ok1(windows[N - 1].end == -1);
+  ok1(window_fixes == n_fixes);
+  ok1(window_checksum == checksum);
+}
+
+static void
+TestReplay()
+{
+  IgcReplay replay(new FileLineReaderA(igc_path));
+
+  NMEAInfo basic;
+  basic.Reset();
+
+  ok1(replay.Update(basic));
+  ok1(replay.Update(basic));
+
+  ok1(replay.Seek(fixed(10000)));
+  ok1(replay.Update(basic));
+  ok1(basic.time >= fixed(10000) && basic.time < fixed(10010));
+
+  /* back to the beginning; the first fixes have no GPS lock and are
+     skipped */
+  ok1(replay.Seek(fixed(0)));
+  ok1(replay.Update(basic));
+  ok1(basic.time == fixed(26 * 60 + 37));
+
+  ok1(!replay.Seek(fixed(22000)));
+  ok1(replay.Update(basic));
+  ok1(basic.time == fixed(26 * 60 + 41));
+}
+
+int main(int argc, char **argv)
+{
+  plan_tests(48);
+
+  TestMidnight();
+
+  FileLineReaderA reader(igc_path);
+  IGCIndex index;
+  ok1(index.Build(reader));
+
+  TestFile(index);
+  TestWindows(index);
+  TestReplay();
+
+  return exit_status();
+}
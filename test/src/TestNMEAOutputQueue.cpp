@@ -0,0 +1,180 @@
+/* Copyright_License {
+
+  XCSoar Glide Computer - http://www.xcsoar.org/
+  Copyright (C) 2000-2014 The XCSoar Project
+  A detailed list of copyright holders can be found in the file "AUTHORS".
+
+  This program is free software; you can redistribute it and/or
+  modify it under the terms of the GNU General Public License
+  as published by the Free Software Foundation; either version 2
+  of the License, or (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+}
+*/
+
+
+#include "Device/Util/NMEAOutputQueue.hpp"
+#include "Device/Port/NullPort.hpp"
+#include "NMEA/SentenceKey.hpp"
+#include "Thread/Mutex.hpp"
+#include "OS/Sleep.h"
+#include "TestUtil.hpp"
+
+#include <algorithm>
+#include <string>
+
+/**
+ * A #Port which records all data written to it, accepting at most
+ * #chunk bytes per call, and failing after #limit bytes.
+ */
+class RecordingPort final : public NullPort {
+  const size_t chunk;
+
+  mutable Mutex mutex;
+  std::string output;
+  size_t limit;
+
+public:
+  explicit RecordingPort(size_t _chunk=4096, size_t _limit=~size_t(0))
+    :chunk(_chunk), limit(_limit) {}
+
+  std::string GetOutput() const {
+    const ScopeLock protect(mutex);
+    return output;
+  }
+
+  unsigned GetLineCount() const {
+    const ScopeLock protect(mutex);
+    return std::count(output.begin(), output.end(), '\n');
+  }
+
+  void SetLimit(size_t _limit) {
+    const ScopeLock protect(mutex);
+    limit = _limit;
+  }
+
+  virtual size_t Write(const void *data, size_t length) override {
+    const ScopeLock protect(mutex);
+
+    length = std::min(length, chunk);
+    length = std::min(length, limit - output.length());
+    output.append((const char *)data, length);
+    return length;
+  }
+};
+
+/**
+ * Wait until the port has received #n lines, or until #length bytes
+ * if #n is 0.
+ */
+static void
+WaitWritten(const RecordingPort &port, unsigned n, size_t length=0)
+{
+  for (unsigned i = 0; i < 500; ++i) {
+    if (n > 0 ? port.GetLineCount() >= n : port.GetOutput().length() >= length)
+      break;
+
+    Sleep(10);
+  }
+}
+
+static void
+TestCoalesce()
+{
+  RecordingPort port;
+  NMEAOutputQueue queue(port);
+
+  constexpr uint64_t rmc = NMEASentenceKey("GPRMC");
+  ok1(queue.Push("$GPRMC,1*00", rmc));
+  ok1(queue.Push("$PFLAA,1*00"));
+  ok1(queue.Push("$PFLAA,2*00"));
+  ok1(queue.Push("$GPRMC,2*00", rmc));
+
+  /* too long */
+  ok1(!queue.Push(std::string(200, 'x').c_str()));
+
+  queue.Start();
+  WaitWritten(port, 3);
+  queue.Stop();
+
+  ok1(port.GetOutput() == "$GPRMC,2*00\r\n$PFLAA,1*00\r\n$PFLAA,2*00\r\n");
+
+  const NMEAOutputQueue::Statistics s = queue.GetStatistics();
+  ok1(s.written == 3);
+  ok1(s.coalesced == 1);
+  ok1(s.dropped == 1);
+  ok1(s.writes == 1);
+}
+
+static void
+TestFull()
+{
+  RecordingPort port(7);
+  NMEAOutputQueue queue(port);
+
+  unsigned n = 0;
+  while (queue.Push("$PFLAU*00"))
+    ++n;
+
+  ok1(n == 32);
+
+  queue.Start();
+  WaitWritten(port, n);
+  queue.Stop();
+
+  ok1(port.GetOutput().length() == n * 11);
+
+  const NMEAOutputQueue::Statistics s = queue.GetStatistics();
+  ok1(s.written == n);
+  ok1(s.coalesced == 0);
+  ok1(s.dropped == 1);
+  ok1(s.writes == (n * 11 + 6) / 7);
+}
+
+static void
+TestTorn()
+{
+  /* the port fails in the middle of the second line */
+  RecordingPort port(4096, 15);
+  NMEAOutputQueue queue(port);
+
+  ok1(queue.Push("$PFLAU,1*00"));
+  ok1(queue.Push("$PFLAU,2*00"));
+  ok1(queue.Push("$PFLAU,3*00"));
+
+  queue.Start();
+  WaitWritten(port, 0, 15);
+
+  /* the rest of the torn line is sent before the next line; the
+     third line was discarded */
+  port.SetLimit(4096);
+  ok1(queue.Push("$PFLAU,4*00"));
+  WaitWritten(port, 3);
+  queue.Stop();
+
+  ok1(port.GetOutput() == "$PFLAU,1*00\r\n$PFLAU,2*00\r\n$PFLAU,4*00\r\n");
+
+  /* the torn line counts as written, not as dropped */
+  const NMEAOutputQueue::Statistics s = queue.GetStatistics();
+  ok1(s.written == 3);
+  ok1(s.dropped == 1);
+}
+
+int main(int argc, char **argv)
+{
+  plan_tests(23);
+
+  TestCoalesce();
+  TestFull();
+  TestTorn();
+
+  return exit_status();
+}
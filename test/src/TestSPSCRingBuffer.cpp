@@ -0,0 +1,101 @@
+/* Copyright_License {
+
+  XCSoar Glide Computer - http://www.xcsoar.org/
+  Copyright (C) 2000-2014 The XCSoar Project
+  A detailed list of copyright holders can be found in the file "AUTHORS".
+
+  This program is free software; you can redistribute it and/or
+  modify it under the terms of the GNU General Public License
+  as published by the Free Software Foundation; either version 2
+  of the License, or (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+}
+*/
+
+#include "Thread/SPSCRingBuffer.hpp"
+#include "Thread/Thread.hpp"
+#include "TestUtil.hpp"
+
+static constexpr unsigned N_ITEMS = 100000;
+
+class ProducerThread : public Thread {
+  SPSCRingBuffer<unsigned, 16> &buffer;
+
+public:
+  explicit ProducerThread(SPSCRingBuffer<unsigned, 16> &_buffer)
+    :buffer(_buffer) {}
+
+protected:
+  virtual void Run() override {
+    for (unsigned i = 0; i < N_ITEMS;)
+      if (buffer.push(i))
+        ++i;
+  }
+};
+
+static void
+TestSingleThread()
+{
+  SPSCRingBuffer<unsigned, 4> buffer;
+  ok1(buffer.empty());
+  ok1(buffer.capacity() == 3);
+
+  unsigned value;
+  ok1(!buffer.shift(value));
+
+  ok1(buffer.push(1));
+  ok1(buffer.push(2));
+  ok1(buffer.push(3));
+  ok1(!buffer.push(4));
+  ok1(buffer.GetDropCount() == 1);
+
+  ok1(buffer.shift(value) && value == 1);
+  ok1(buffer.push(5));
+  ok1(buffer.shift(value) && value == 2);
+  ok1(buffer.shift(value) && value == 3);
+  ok1(buffer.shift(value) && value == 5);
+  ok1(!buffer.shift(value));
+  ok1(buffer.empty());
+}
+
+static void
+TestTwoThreads()
+{
+  SPSCRingBuffer<unsigned, 16> buffer;
+  ProducerThread producer(buffer);
+  ok1(producer.Start());
+
+  /* the consumer must see all items in order */
+  bool in_order = true;
+  unsigned expected = 0;
+  while (expected < N_ITEMS) {
+    unsigned value;
+    if (buffer.shift(value)) {
+      if (value != expected)
+        in_order = false;
+      ++expected;
+    }
+  }
+
+  producer.Join();
+  ok1(in_order);
+  ok1(buffer.empty());
+}
+
+int main(int argc, char **argv)
+{
+  plan_tests(18);
+
+  TestSingleThread();
+  TestTwoThreads();
+
+  return exit_status();
+}
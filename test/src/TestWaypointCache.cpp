@@ -0,0 +1,201 @@
+/* Copyright_License {
+
+  XCSoar Glide Computer - http://www.xcsoar.org/
+  Copyright (C) 2000-2014 The XCSoar Project
+  A detailed list of copyright holders can be found in the file "AUTHORS".
+
+  This program is free software; you can redistribute it and/or
+  modify it under the terms of the GNU General Public License
+  as published by the Free Software Foundation; either version 2
+  of the License, or (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program; if not, write to the Free Software
+  Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.
+}
+*/
+
+#include "Waypoint/WaypointCache.hpp"
+#include "Waypoint/WaypointReader.hpp"
+#include "Engine/Waypoint/Waypoints.hpp"
+#include "Operation/Operation.hpp"
+#include "TestUtil.hpp"
+
+#include <stdio.h>
+
+static bool
+Equals(const RadioFrequency a, const RadioFrequency b)
+{
+  return a.IsDefined()
+    ? b.IsDefined() && a.GetKiloHertz() == b.GetKiloHertz()
+    : !b.IsDefined();
+}
+
+static bool
+Equals(const Runway a, const Runway b)
+{
+  if (a.IsDirectionDefined() != b.IsDirectionDefined() ||
+      a.IsLengthDefined() != b.IsLengthDefined())
+    return false;
+
+  return (!a.IsDirectionDefined() ||
+          a.GetDirectionDegrees() == b.GetDirectionDegrees()) &&
+    (!a.IsLengthDefined() || a.GetLength() == b.GetLength());
+}
+
+static bool
+Equals(const Waypoint &a, const Waypoint &b)
+{
+  return a.id == b.id &&
+    a.original_id == b.original_id &&
+    a.location == b.location &&
+    a.elevation == b.elevation &&
+    Equals(a.runway, b.runway) &&
+    Equals(a.radio_frequency, b.radio_frequency) &&
+    a.type == b.type &&
+    a.flags.turn_point == b.flags.turn_point &&
+    a.flags.home == b.flags.home &&
+    a.flags.start_point == b.flags.start_point &&
+    a.flags.finish_point == b.flags.finish_point &&
+    a.flags.watched == b.flags.watched &&
+    a.file_num == b.file_num &&
+    a.name == b.name &&
+    a.comment == b.comment &&
+    a.details == b.details;
+}
+
+static bool
+Equals(const Waypoints &a, const Waypoints &b)
+{
+  if (a.size() != b.size())
+    return false;
+
+  for (unsigned id = 1; id <= a.size(); ++id) {
+    const Waypoint *wa = a.LookupId(id), *wb = b.LookupId(id);
+    if (wa == nullptr || wb == nullptr || !Equals(*wa, *wb))
+      return false;
+  }
+
+  return true;
+}
+
+static bool
+Parse(Waypoints &waypoints, const TCHAR *path, int file_num)
+{
+  WaypointReader reader(path, file_num);
+  if (reader.Error())
+    return false;
+
+  NullOperationEnvironment operation;
+  return reader.Parse(waypoints, operation);
+}
+
+static void
+TestFile(const TCHAR *path, int file_num)
+{
+  Waypoints original;
+  if (!ok1(Parse(original, path, file_num) && !original.IsEmpty())) {
+    skip(4, 0, "parsing waypoint file failed");
+    return;
+  }
+
+  /* the details are not read by the parsers, but they are cached */
+  Waypoint first = *original.LookupId(1);
+  first.details = _T("Details");
+  original.Replace(*original.LookupId(1), std::move(first));
+  original.Optimise();
+
+  FILE *file = tmpfile();
+  const WaypointCache::TerrainKey terrain("terrain.jp2", 1234, 5678);
+  ok1(WaypointCache::Save(file, original, 1, original.size() + 1, terrain));
+  rewind(file);
+
+  Waypoints loaded;
+  ok1(WaypointCache::Load(file, loaded, terrain));
+  fclose(file);
+
+  loaded.Optimise();
+  ok1(loaded.size() == original.size());
+  ok1(Equals(original, loaded));
+}
+
+static void
+TestRange()
+{
+  Waypoints original;
+  Parse(original, _T("test/data/waypoints.cup"), 1);
+  const unsigned first_id = original.size() + 1;
+  Parse(original, _T("test/data/waypoints.dat"), 2);
+
+  FILE *file = tmpfile();
+  ok1(WaypointCache::Save(file, original, first_id, original.size() + 1,
+                          WaypointCache::TerrainKey()));
+  rewind(file);
+
+  /* loading the second file's cache after the first file must
+     reproduce the original ids */
+  Waypoints loaded;
+  Parse(loaded, _T("test/data/waypoints.cup"), 1);
+  ok1(WaypointCache::Load(file, loaded, WaypointCache::TerrainKey()));
+  fclose(file);
+
+  ok1(Equals(original, loaded));
+}
+
+static void
+TestInvalid()
+{
+  Waypoints original;
+  Parse(original, _T("test/data/waypoints.cup"), 1);
+
+  const WaypointCache::TerrainKey terrain("terrain.jp2", 1234, 5678);
+  FILE *file = tmpfile();
+  WaypointCache::Save(file, original, 1, original.size() + 1, terrain);
+  const long size = ftell(file);
+
+  /* the terrain file must match */
+  Waypoints loaded;
+  rewind(file);
+  ok1(!WaypointCache::Load(file, loaded, WaypointCache::TerrainKey()));
+  rewind(file);
+  ok1(!WaypointCache::Load(file, loaded,
+                           WaypointCache::TerrainKey("terrain.jp2",
+                                                     1234, 5679)));
+  rewind(file);
+  ok1(!WaypointCache::Load(file, loaded,
+                           WaypointCache::TerrainKey("terrain.jp3",
+                                                     1234, 5678)));
+  ok1(loaded.IsEmpty());
+
+  /* a truncated file is rejected as a whole */
+  FILE *truncated = tmpfile();
+  rewind(file);
+  for (long i = 0; i < size - 1; ++i)
+    fputc(fgetc(file), truncated);
+  fclose(file);
+
+  rewind(truncated);
+  ok1(!WaypointCache::Load(truncated, loaded, terrain));
+  ok1(loaded.IsEmpty());
+  fclose(truncated);
+}
+
+int main(int argc, char **argv)
+{
+  plan_tests(4 * 5 + 3 + 6);
+
+  TestFile(_T("test/data/waypoints.cup"), 1);
+  TestFile(_T("test/data/waypoints.dat"), 2);
+  TestFile(_T("test/data/waypoints_ozi.wpt"), 3);
+  TestFile(_T("test/data/waypoints_geo.wpt"), 1);
+
+  TestRange();
+  TestInvalid();
+
+  return exit_status();
+}
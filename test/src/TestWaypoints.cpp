@@ -233,6 +233,28 @@ TestGetNearest(const Waypoints &waypoints, const GeoPoint &center)
   ok1(waypoint->original_id == 6);
 }
 
+static void
+TestGetNearestList(const Waypoints &waypoints, const GeoPoint &center)
+{
+  const Waypoint *dest[8];
+
+  ok1(waypoints.GetNearest(center, fixed(1), dest, 8) == 1);
+  ok1(dest[0]->original_id == 0);
+
+  ok1(waypoints.GetNearest(center, fixed(2500), dest, 8) == 3);
+
+  ok1(waypoints.GetNearest(center, fixed(10000), dest, 8) == 8);
+  bool sorted = true;
+  for (unsigned i = 0; i < 8; ++i)
+    if (dest[i]->original_id != i)
+      sorted = false;
+  ok1(sorted);
+
+  ok1(waypoints.GetNearestIf(center, fixed(30000), OriginalIDAbove5,
+                             dest, 2) == 2);
+  ok1(dest[0]->original_id == 6 && dest[1]->original_id == 7);
+}
+
 static void
 TestIterator(const Waypoints &waypoints)
 {
@@ -300,7 +322,7 @@ main(int argc, char** argv)
   if (!ParseArgs(argc, argv))
     return 0;
 
-  plan_tests(52);
+  plan_tests(86);
 
   Waypoints waypoints;
   GeoPoint center(Angle::Degrees(51.4), Angle::Degrees(7.85));
@@ -316,8 +338,19 @@ main(int argc, char** argv)
   TestNamePrefixVisitor(waypoints);
   TestRangeVisitor(waypoints, center);
   TestGetNearest(waypoints, center);
+  TestGetNearestList(waypoints, center);
   TestIterator(waypoints);
 
+  {
+    /* a modification without Optimise() discards the packed index;
+       the lookups must still work */
+    Waypoints waypoints2;
+    AddSpiralWaypoints(waypoints2, center);
+    waypoints2.Append(Waypoint(*waypoints2.LookupId(151)));
+    TestGetNearest(waypoints2, center);
+    TestGetNearestList(waypoints2, center);
+  }
+
   ok(TestCopy(waypoints), "waypoint copy", 0);
   ok(TestErase(waypoints, 3), "waypoint erase", 0);
   ok(TestReplace(waypoints, 4), "waypoint replace", 0);
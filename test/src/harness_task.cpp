@@ -302,7 +302,7 @@ bool test_task_manip(TaskManager& task_manager,
 
   task_report(task_manager, "# checking task\n");
 
-  fact.UpdateStatsGeometry();
+  fact.UpdateGeometry();
 
   if (task_manager.CheckOrderedTask()) {
     task_manager.Reset();
@@ -343,7 +343,7 @@ bool test_task_type_manip(TaskManager& task_manager,
 
   AbstractTaskFactory &fact = task_manager.GetFactory();
   fact.MutateTPsToTaskType();
-  fact.UpdateStatsGeometry();
+  fact.UpdateGeometry();
 
   test_note("# checking mutated start..\n");
   if (!fact.IsValidStartType(fact.GetType(task_manager.GetOrderedTask().GetTaskPoint(0))))
@@ -476,7 +476,7 @@ bool test_task_mixed(TaskManager& task_manager,
     return false;
   }
 
-  fact.UpdateStatsGeometry();
+  fact.UpdateGeometry();
 
   task_report(task_manager, "# checking task\n");
   if (!fact.Validate()) {
@@ -540,7 +540,7 @@ bool test_task_fai(TaskManager& task_manager,
     delete tp;
   }
 
-  fact.UpdateStatsGeometry();
+  fact.UpdateGeometry();
 
   task_report(task_manager, "# checking task\n");
   if (!fact.Validate()) {
@@ -612,7 +612,7 @@ bool test_task_aat(TaskManager& task_manager,
     delete tp;
   }
 
-  fact.UpdateStatsGeometry();
+  fact.UpdateGeometry();
 
   task_report(task_manager, "# checking task..\n");
   if (!fact.Validate()) {
@@ -675,7 +675,7 @@ test_task_mat(TaskManager &task_manager, const Waypoints &waypoints)
     delete tp;
   }
 
-  fact.UpdateStatsGeometry();
+  fact.UpdateGeometry();
 
   task_report(task_manager, "# checking task..\n");
   if (!fact.Validate()) {
@@ -730,7 +730,7 @@ bool test_task_or(TaskManager& task_manager,
     delete tp;
   }
 
-  fact.UpdateStatsGeometry();
+  fact.UpdateGeometry();
 
   task_report(task_manager, "# checking task..\n");
   if (!fact.Validate()) {
@@ -776,7 +776,7 @@ bool test_task_dash(TaskManager& task_manager,
     delete tp;
   }
 
-  fact.UpdateStatsGeometry();
+  fact.UpdateGeometry();
 
   task_report(task_manager, "# checking task..\n");
   if (!fact.Validate()) {
@@ -822,7 +822,7 @@ bool test_task_fg(TaskManager& task_manager,
     delete tp;
   }
 
-  fact.UpdateStatsGeometry();
+  fact.UpdateGeometry();
 
   task_report(task_manager, "# checking task..\n");
   if (!fact.Validate()) {
@@ -906,7 +906,7 @@ bool test_task_random(TaskManager& task_manager,
     delete tp;
   }
 
-  fact.UpdateStatsGeometry();
+  fact.UpdateGeometry();
 
   task_report(task_manager, "# validating task..\n");
   if (!fact.Validate()) {
@@ -997,7 +997,7 @@ bool test_task_random_RT_AAT_FAI(TaskManager& task_manager,
     delete tp;
   }
 
-  fact.UpdateStatsGeometry();
+  fact.UpdateGeometry();
 
   test_note("# validating task..\n");
   if (!fact.Validate()) {
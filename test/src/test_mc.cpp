@@ -28,9 +28,13 @@
 #include "GlideSolvers/MacCready.hpp"
 #include "Navigation/Aircraft.hpp"
 #include "OS/FileUtil.hpp"
+#include "Math/ZeroFinder.hpp"
+#include "Util/Tolerances.hpp"
+#include "BenchmarkClock.hpp"
 
 #include <stdio.h>
 #include <fstream>
+#include <vector>
 #include <string>
 #include <math.h>
 
@@ -266,15 +270,116 @@ test_cb()
   return true;
 }
 
+/**
+ * The numerical search which MacCready::OptimiseGlide() used before
+ * GlidePolar::GetBestGlideSpeed(), as reference for
+ * test_best_glide_speed().
+ */
+class ReferenceVopt final : public ZeroFinder {
+  const MacCready &mac;
+  const GlideState &task;
+
+public:
+  ReferenceVopt(const MacCready &_mac, const GlidePolar &polar,
+                const GlideState &_task)
+    :ZeroFinder(polar.GetVMin(), polar.GetVMax(),
+                fixed(TOLERANCE_MC_OPT_GLIDE)),
+     mac(_mac), task(_task) {}
+
+  fixed f(const fixed v) {
+    const GlideResult res = mac.SolveGlide(task, v);
+    if (!res.IsOk() || !positive(res.vector.distance))
+      return fixed(1000000);
+
+    return res.height_glide * 1024 / res.vector.distance;
+  }
+
+  GlideResult Solve(const fixed v_init) {
+    return mac.SolveGlide(task, find_min(v_init));
+  }
+};
+
+/**
+ * Compare the Newton based MC=0 glide solution with the numerical
+ * search: print the solves per second of both, and check the maximum
+ * error of the glide height.
+ */
+static bool
+test_best_glide_speed()
+{
+  GlideSettings settings;
+  settings.SetDefaults();
+
+  GlidePolar polar(fixed(0));
+  const MacCready mac(settings, polar);
+
+  static constexpr unsigned N_WIND = 36, N_ANGLE = 36;
+  std::vector<GlideState> tasks;
+  tasks.reserve(N_WIND * N_ANGLE);
+  for (unsigned w = 0; w < N_WIND; ++w) {
+    for (unsigned a = 0; a < N_ANGLE; ++a) {
+      const SpeedVector wind(Angle::Degrees(a * 10), fixed(w));
+      tasks.emplace_back(GeoVector(fixed(10000), Angle::Zero()),
+                         fixed(0), fixed(1000), wind);
+    }
+  }
+
+  const unsigned n = tasks.size();
+  static constexpr unsigned ROUNDS = 20;
+
+  fixed checksum_newton(0);
+  const uint64_t start_newton = BenchmarkClockUS();
+  for (unsigned r = 0; r < ROUNDS; ++r)
+    for (unsigned i = 0; i < n; ++i)
+      checksum_newton += mac.Solve(tasks[i]).height_glide;
+  const uint64_t newton_us = BenchmarkClockUS() - start_newton;
+
+  fixed checksum_reference(0);
+  const uint64_t start_reference = BenchmarkClockUS();
+  for (unsigned r = 0; r < ROUNDS; ++r)
+    for (unsigned i = 0; i < n; ++i)
+      checksum_reference += ReferenceVopt(mac, polar, tasks[i])
+        .Solve(polar.GetVMin()).height_glide;
+  const uint64_t reference_us = BenchmarkClockUS() - start_reference;
+
+  /* relative error of the glide ratio; both searches may fail on
+     excessive wind, which must happen on the same tasks */
+  fixed max_error(0);
+  bool consistent = true;
+  for (unsigned i = 0; i < n; ++i) {
+    const GlideResult a = mac.Solve(tasks[i]);
+    const GlideResult b = ReferenceVopt(mac, polar, tasks[i])
+      .Solve(polar.GetVMin());
+    if (a.IsOk() != b.IsOk()) {
+      consistent = false;
+      continue;
+    }
+
+    if (a.IsOk())
+      max_error = std::max(max_error, fabs(a.height_glide - b.height_glide)
+                           / b.height_glide);
+  }
+
+  printf("# newton: %.0f solves/s, search: %.0f solves/s, "
+         "max glide ratio error %.6f (checksums %.1f %.1f)\n",
+         (double)ROUNDS * n * 1000000. / std::max(newton_us, uint64_t(1)),
+         (double)ROUNDS * n * 1000000. / std::max(reference_us, uint64_t(1)),
+         (double)max_error,
+         (double)checksum_newton, (double)checksum_reference);
+
+  return consistent && max_error < fixed(0.001);
+}
+
 int main() {
 
-  plan_tests(3);
+  plan_tests(4);
 
   Directory::Create(_T("output/results"));
 
   ok(test_mc(),"mc output",0);
   ok(test_stf(),"mc stf",0);
   ok(test_cb(),"cruise bearing",0);
+  ok(test_best_glide_speed(),"best glide speed",0);
 
   return exit_status();
 